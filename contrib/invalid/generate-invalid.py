@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# Copyright (c) 2019 The PIVX developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+'''
+Script to generate the tables of invalid outpoints and serials for invalid.cpp.
+
+This script expects two JSON files in the directory that is passed as an
+argument:
+
+    invalid_outpoints.json
+    invalid_serials.json
+
+The output is two sorted arrays in binary format:
+
+   static const InvalidOutPointSpec pInvalidOutPoints[] = {
+   ...
+   }
+   static const InvalidSerialSpec pInvalidSerials[] = {
+   ...
+   }
+
+These should be pasted into `src/invalid_tables.h`.
+
+invalid.cpp looks the entries up with a binary search, comparing the txids
+and serials with memcmp, so the outpoints are sorted by the raw txid bytes and
+then by output index, and the serials by their raw bytes.
+'''
+
+import json
+import os
+import sys
+
+# Serials are stored as the little endian magnitude, zero padded to this size
+SERIAL_SIZE = 33
+
+def outpoint_key(txid_hex, n):
+    txid = bytes.fromhex(txid_hex)[::-1]
+    assert len(txid) == 32
+    return (txid, n)
+
+def serial_key(serial_hex):
+    value = int(serial_hex, 16)
+    assert value > 0
+    return value.to_bytes(SERIAL_SIZE, 'little')
+
+def fmt_bytes(raw):
+    return ','.join('0x%02x' % b for b in raw)
+
+def main():
+    if len(sys.argv) < 2:
+        print(('Usage: %s <path_to_json_files>' % sys.argv[0]), file=sys.stderr)
+        sys.exit(1)
+    indir = sys.argv[1]
+
+    with open(os.path.join(indir, 'invalid_outpoints.json'), 'r', encoding="utf8") as f:
+        outpoints = sorted(set(outpoint_key(o['txid'], o['n']) for o in json.load(f)))
+    with open(os.path.join(indir, 'invalid_serials.json'), 'r', encoding="utf8") as f:
+        serials = sorted(set(serial_key(s['s']) for s in json.load(f)))
+
+    g = sys.stdout
+    g.write('#ifndef PIVX_INVALID_TABLES_H\n')
+    g.write('#define PIVX_INVALID_TABLES_H\n')
+    g.write('/**\n')
+    g.write(' * Outpoints and zerocoin serials that are banned from the chain\n')
+    g.write(' * AUTOGENERATED by contrib/invalid/generate-invalid.py\n')
+    g.write(' *\n')
+    g.write(' * Outpoints are a 32-byte txid in internal byte order and an output index,\n')
+    g.write(' * sorted by txid bytes then index. Serials are the little endian magnitude\n')
+    g.write(' * padded to %d bytes, sorted by their bytes.\n' % SERIAL_SIZE)
+    g.write(' */\n')
+    g.write('static const InvalidOutPointSpec pInvalidOutPoints[] = {\n')
+    g.write(',\n'.join('    {{%s}, %d}' % (fmt_bytes(txid), n) for (txid, n) in outpoints))
+    g.write('\n};\n\n')
+    g.write('static const InvalidSerialSpec pInvalidSerials[] = {\n')
+    g.write(',\n'.join('    {{%s}}' % fmt_bytes(k) for k in serials))
+    g.write('\n};\n')
+    g.write('#endif // PIVX_INVALID_TABLES_H\n')
+
+if __name__ == '__main__':
+    main()
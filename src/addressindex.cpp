@@ -0,0 +1,474 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "addressindex.h"
+#include "blockreader.h"
+
+#include "chain.h"
+#include "main.h"
+#include "primitives/block.h"
+#include "undo.h"
+#include "util.h"
+
+#include <set>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+CAddressIndexDB* paddressindex = NULL;
+
+//! Number of blocks read ahead by one ThreadAddressIndexSync round
+static const int ADDRESSINDEX_SYNC_BATCH_SIZE = 1000;
+
+CIndexAddress CIndexAddress::FromScript(const CScript& script)
+{
+    CTxDestination dest;
+    if (!ExtractDestination(script, dest))
+        return CIndexAddress();
+    return FromDestination(dest);
+}
+
+CIndexAddress CIndexAddress::FromDestination(const CTxDestination& dest)
+{
+    if (const CKeyID* keyID = boost::get<CKeyID>(&dest))
+        return CIndexAddress(KEY, *keyID);
+    if (const CScriptID* scriptID = boost::get<CScriptID>(&dest))
+        return CIndexAddress(SCRIPT, *scriptID);
+    return CIndexAddress();
+}
+
+CTxDestination CIndexAddress::GetDestination() const
+{
+    switch (type) {
+    case KEY:
+        return CKeyID(hash);
+    case SCRIPT:
+        return CScriptID(hash);
+    default:
+        return CNoDestination();
+    }
+}
+
+CAddressIndexDB::CAddressIndexDB(size_t nCacheSize, bool fMemory, bool fWipe) : CLevelDBWrapper(GetDataDir() / "addressindex", nCacheSize, fMemory, fWipe)
+{
+}
+
+bool CAddressIndexDB::ReadBestBlock(uint256& hashBlock) const
+{
+    if (!Read('B', hashBlock))
+        hashBlock = uint256(0);
+    return true;
+}
+
+bool CAddressIndexDB::ReadAddressDeltas(const CIndexAddress& address, int nStart, int nEnd, std::vector<std::pair<CAddressDeltaKey, CAmount> >& vDeltas)
+{
+    boost::scoped_ptr<leveldb::Iterator> pcursor(NewIterator());
+
+    CDataStream ssKeySet(SER_DISK, CLIENT_VERSION);
+    ssKeySet << std::make_pair('a', CAddressDeltaKey(address, nStart, uint256(0), 0, false));
+    pcursor->Seek(ssKeySet.str());
+
+    for (; pcursor->Valid(); pcursor->Next()) {
+        boost::this_thread::interruption_point();
+        try {
+            leveldb::Slice slKey = pcursor->key();
+            CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
+            char chType;
+            CAddressDeltaKey key;
+            ssKey >> chType;
+            if (chType != 'a')
+                break;
+            ssKey >> key;
+            if (!(key.address == address) || key.nHeight > nEnd)
+                break;
+            leveldb::Slice slValue = pcursor->value();
+            CDataStream ssValue(slValue.data(), slValue.data() + slValue.size(), SER_DISK, CLIENT_VERSION);
+            CAmount nValue;
+            ssValue >> nValue;
+            vDeltas.push_back(std::make_pair(key, nValue));
+        } catch (const std::exception& e) {
+            return error("%s : Deserialize or I/O error - %s", __func__, e.what());
+        }
+    }
+
+    return true;
+}
+
+bool CAddressIndexDB::ReadAddressUnspent(const CIndexAddress& address, std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> >& vUnspent)
+{
+    boost::scoped_ptr<leveldb::Iterator> pcursor(NewIterator());
+
+    CDataStream ssKeySet(SER_DISK, CLIENT_VERSION);
+    ssKeySet << std::make_pair('u', address);
+    pcursor->Seek(ssKeySet.str());
+
+    for (; pcursor->Valid(); pcursor->Next()) {
+        boost::this_thread::interruption_point();
+        try {
+            leveldb::Slice slKey = pcursor->key();
+            CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
+            char chType;
+            CAddressUnspentKey key;
+            ssKey >> chType;
+            if (chType != 'u')
+                break;
+            ssKey >> key;
+            if (!(key.address == address))
+                break;
+            leveldb::Slice slValue = pcursor->value();
+            CDataStream ssValue(slValue.data(), slValue.data() + slValue.size(), SER_DISK, CLIENT_VERSION);
+            CAddressUnspentValue value;
+            ssValue >> value;
+            vUnspent.push_back(std::make_pair(key, value));
+        } catch (const std::exception& e) {
+            return error("%s : Deserialize or I/O error - %s", __func__, e.what());
+        }
+    }
+
+    return true;
+}
+
+bool CAddressIndexDB::ReadSpentIndex(const CSpentIndexKey& key, CSpentIndexValue& value) const
+{
+    return Read(std::make_pair('p', key), value);
+}
+
+/**
+ * Transparent inputs of the block's transactions, with the outputs they spend as
+ * recorded in the undo data. Coinbase and zerocoin spends have no undo entry.
+ */
+template <typename Fn>
+static bool ForEachSpentOutput(const CBlock& block, const CBlockUndo& blockundo, Fn fn)
+{
+    if (blockundo.vtxundo.size() + 1 != block.vtx.size())
+        return error("%s : block and undo data inconsistent", __func__);
+
+    for (unsigned int i = 1; i < block.vtx.size(); i++) {
+        const CTransaction& tx = block.vtx[i];
+        if (tx.HasZerocoinSpendInputs())
+            continue;
+        const CTxUndo& txundo = blockundo.vtxundo[i - 1];
+        if (txundo.vprevout.size() != tx.vin.size())
+            return error("%s : transaction and undo data inconsistent", __func__);
+        for (unsigned int j = 0; j < tx.vin.size(); j++)
+            if (!fn(tx, j, txundo.vprevout[j]))
+                return false;
+    }
+    return true;
+}
+
+bool CAddressIndexDB::ConnectBlock(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex)
+{
+    CLevelDBBatch batch;
+    const int nHeight = pindex->nHeight;
+
+    // The genesis block's outputs never enter the UTXO set
+    if (pindex->pprev) {
+        // Outputs first, so that an output spent in its own block is added before it is removed
+        std::set<uint256> setBlockTxs;
+        for (const CTransaction& tx : block.vtx) {
+            const uint256& txid = tx.GetHash();
+            setBlockTxs.insert(txid);
+            for (unsigned int k = 0; k < tx.vout.size(); k++) {
+                const CTxOut& out = tx.vout[k];
+                CIndexAddress address = CIndexAddress::FromScript(out.scriptPubKey);
+                if (address.IsNull())
+                    continue;
+                batch.Write(std::make_pair('a', CAddressDeltaKey(address, nHeight, txid, k, false)), out.nValue);
+                batch.Write(std::make_pair('u', CAddressUnspentKey(address, txid, k)), CAddressUnspentValue(out.nValue, out.scriptPubKey, nHeight));
+            }
+        }
+
+        bool fSpends = ForEachSpentOutput(block, blockundo, [&](const CTransaction& tx, unsigned int j, const CTxInUndo& undo) {
+            const COutPoint& prevout = tx.vin[j].prevout;
+            CSpentIndexValue spent;
+            spent.txid = tx.GetHash();
+            spent.nInputIndex = j;
+            spent.nHeight = nHeight;
+            spent.nValue = undo.txout.nValue;
+            spent.address = CIndexAddress::FromScript(undo.txout.scriptPubKey);
+
+            // The undo data only has the height of a transaction's last spent output
+            if (undo.nHeight != 0) {
+                spent.nPrevHeight = undo.nHeight;
+            } else if (setBlockTxs.count(prevout.hash)) {
+                spent.nPrevHeight = nHeight;
+            } else if (!spent.address.IsNull()) {
+                CAddressUnspentValue unspent;
+                if (Read(std::make_pair('u', CAddressUnspentKey(spent.address, prevout.hash, prevout.n)), unspent))
+                    spent.nPrevHeight = unspent.nHeight;
+            }
+
+            batch.Write(std::make_pair('p', CSpentIndexKey(prevout.hash, prevout.n)), spent);
+            if (!spent.address.IsNull()) {
+                batch.Write(std::make_pair('a', CAddressDeltaKey(spent.address, nHeight, spent.txid, j, true)), -spent.nValue);
+                batch.Erase(std::make_pair('u', CAddressUnspentKey(spent.address, prevout.hash, prevout.n)));
+            }
+            return true;
+        });
+        if (!fSpends)
+            return false;
+    }
+
+    batch.Write('B', pindex->GetBlockHash());
+    return WriteBatch(batch);
+}
+
+bool CAddressIndexDB::DisconnectBlock(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex)
+{
+    assert(pindex->pprev);
+
+    CLevelDBBatch batch;
+    const int nHeight = pindex->nHeight;
+
+    // Restore the spent outputs first, so that those created in this block are removed again below
+    bool fSpends = ForEachSpentOutput(block, blockundo, [&](const CTransaction& tx, unsigned int j, const CTxInUndo& undo) {
+        const COutPoint& prevout = tx.vin[j].prevout;
+        CSpentIndexValue spent;
+        if (!ReadSpentIndex(CSpentIndexKey(prevout.hash, prevout.n), spent))
+            return error("%s : no spent record for %s:%u", __func__, prevout.hash.GetHex(), prevout.n);
+
+        batch.Erase(std::make_pair('p', CSpentIndexKey(prevout.hash, prevout.n)));
+        if (!spent.address.IsNull()) {
+            batch.Erase(std::make_pair('a', CAddressDeltaKey(spent.address, nHeight, tx.GetHash(), j, true)));
+            batch.Write(std::make_pair('u', CAddressUnspentKey(spent.address, prevout.hash, prevout.n)),
+                CAddressUnspentValue(undo.txout.nValue, undo.txout.scriptPubKey, spent.nPrevHeight));
+        }
+        return true;
+    });
+    if (!fSpends)
+        return false;
+
+    for (const CTransaction& tx : block.vtx) {
+        const uint256& txid = tx.GetHash();
+        for (unsigned int k = 0; k < tx.vout.size(); k++) {
+            CIndexAddress address = CIndexAddress::FromScript(tx.vout[k].scriptPubKey);
+            if (address.IsNull())
+                continue;
+            batch.Erase(std::make_pair('a', CAddressDeltaKey(address, nHeight, txid, k, false)));
+            batch.Erase(std::make_pair('u', CAddressUnspentKey(address, txid, k)));
+        }
+    }
+
+    batch.Write('B', pindex->pprev->GetBlockHash());
+    return WriteBatch(batch);
+}
+
+/** Where the index is at, guarded by cs_addressindex */
+static CCriticalSection cs_addressindex;
+static bool fAddressIndexSynced = false;
+static uint256 hashAddressIndexBest;
+static int nAddressIndexHeight = -1;
+
+static boost::mutex csAddressIndexSync;
+static boost::condition_variable condAddressIndexSync;
+
+static void SetAddressIndexBest(const uint256& hashBlock, int nHeight, bool fSynced)
+{
+    LOCK(cs_addressindex);
+    hashAddressIndexBest = hashBlock;
+    nAddressIndexHeight = nHeight;
+    fAddressIndexSynced = fSynced;
+}
+
+/** Hand the index back to ThreadAddressIndexSync */
+static void SetAddressIndexBehind()
+{
+    {
+        LOCK(cs_addressindex);
+        fAddressIndexSynced = false;
+    }
+    boost::lock_guard<boost::mutex> lock(csAddressIndexSync);
+    condAddressIndexSync.notify_all();
+}
+
+bool IsAddressIndexSynced(int* pnHeight)
+{
+    LOCK(cs_addressindex);
+    if (pnHeight)
+        *pnHeight = nAddressIndexHeight;
+    return fAddressIndexSynced;
+}
+
+bool AddressIndexBlockConnected(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex)
+{
+    if (!paddressindex || fVerifyingBlocks)
+        return true;
+
+    {
+        LOCK(cs_addressindex);
+        if (!fAddressIndexSynced)
+            return true;
+        if (!pindex->pprev || hashAddressIndexBest != pindex->pprev->GetBlockHash()) {
+            fAddressIndexSynced = false;
+            pindex = NULL;
+        }
+    }
+    if (!pindex) {
+        SetAddressIndexBehind();
+        return true;
+    }
+
+    if (!paddressindex->ConnectBlock(block, blockundo, pindex))
+        return false;
+    SetAddressIndexBest(pindex->GetBlockHash(), pindex->nHeight, true);
+    return true;
+}
+
+bool AddressIndexBlockDisconnected(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex)
+{
+    if (!paddressindex || fVerifyingBlocks)
+        return true;
+
+    {
+        LOCK(cs_addressindex);
+        if (!fAddressIndexSynced)
+            return true;
+        if (hashAddressIndexBest != pindex->GetBlockHash()) {
+            fAddressIndexSynced = false;
+            pindex = NULL;
+        }
+    }
+    if (!pindex) {
+        SetAddressIndexBehind();
+        return true;
+    }
+
+    if (!paddressindex->DisconnectBlock(block, blockundo, pindex))
+        return false;
+    SetAddressIndexBest(pindex->pprev->GetBlockHash(), pindex->pprev->nHeight, true);
+    return true;
+}
+
+/** A block of the active chain with its undo data, read by ThreadAddressIndexSync */
+struct CAddressIndexSyncBlock {
+    bool fRead;
+    CBlock block;
+    CBlockUndo blockundo;
+
+    CAddressIndexSyncBlock() : fRead(false) {}
+};
+
+static bool ReadAddressIndexSyncBlock(const CBlockIndex* pindex, CAddressIndexSyncBlock& result)
+{
+    if (!ReadBlockFromDisk(result.block, pindex))
+        return false;
+    if (pindex->pprev) {
+        CDiskBlockPos pos = pindex->GetUndoPos();
+        if (pos.IsNull() || !result.blockundo.ReadFromDisk(pos, pindex->pprev->GetBlockHash()))
+            return error("%s : no undo data for block %s", __func__, pindex->GetBlockHash().GetHex());
+    }
+    result.fRead = true;
+    return true;
+}
+
+/**
+ * One step of ThreadAddressIndexSync, with cs_main held: rewind the index by one
+ * block if it is on a block that left the active chain, or collect the next blocks
+ * to add in vIndex. Returns false once the index is at the tip.
+ */
+static bool AddressIndexNextBlocks(const uint256& hashBest, std::vector<const CBlockIndex*>& vIndex)
+{
+    const CBlockIndex* pindexBest = NULL;
+    if (hashBest != uint256(0)) {
+        BlockMap::const_iterator mi = mapBlockIndex.find(hashBest);
+        if (mi == mapBlockIndex.end())
+            throw std::runtime_error(strprintf("address index is at unknown block %s, restart with -reindex", hashBest.GetHex()));
+        pindexBest = mi->second;
+    }
+
+    if (pindexBest && !chainActive.Contains(pindexBest)) {
+        CAddressIndexSyncBlock result;
+        if (!ReadAddressIndexSyncBlock(pindexBest, result) || !paddressindex->DisconnectBlock(result.block, result.blockundo, pindexBest))
+            throw std::runtime_error(strprintf("failed to remove block %s", hashBest.GetHex()));
+        SetAddressIndexBest(pindexBest->pprev->GetBlockHash(), pindexBest->pprev->nHeight, false);
+        return true;
+    }
+
+    const CBlockIndex* pindexTip = chainActive.Tip();
+    if (pindexTip == pindexBest) {
+        SetAddressIndexBest(hashBest, pindexBest ? pindexBest->nHeight : -1, true);
+        return false;
+    }
+    if (!pindexTip)
+        return false;
+
+    int nHeight = pindexBest ? pindexBest->nHeight + 1 : 0;
+    int nLast = std::min(pindexTip->nHeight, nHeight + ADDRESSINDEX_SYNC_BATCH_SIZE - 1);
+    for (; nHeight <= nLast; nHeight++)
+        vIndex.push_back(chainActive[nHeight]);
+    return true;
+}
+
+void ThreadAddressIndexSync()
+{
+    uint256 hashBest;
+    paddressindex->ReadBestBlock(hashBest);
+    LogPrintf("%s : address index at block %s\n", __func__, hashBest.GetHex());
+
+    const int nThreads = GetRecalculationThreads();
+    int nLogHeight = -1;
+    try {
+        while (true) {
+            boost::this_thread::interruption_point();
+
+            std::vector<const CBlockIndex*> vIndex;
+            bool fBehind;
+            {
+                LOCK(cs_main);
+                paddressindex->ReadBestBlock(hashBest);
+                fBehind = AddressIndexNextBlocks(hashBest, vIndex);
+            }
+
+            if (!fBehind) {
+                if (nLogHeight != -1) {
+                    LogPrintf("%s : address index synced\n", __func__);
+                    nLogHeight = -1;
+                }
+                boost::unique_lock<boost::mutex> lock(csAddressIndexSync);
+                while (IsAddressIndexSynced())
+                    condAddressIndexSync.wait(lock);
+                continue;
+            }
+            if (vIndex.empty())
+                continue;
+
+            // Blocks and undo data on disk never change, so they are read without cs_main
+            std::vector<CAddressIndexSyncBlock> vResults;
+            ParallelReadBlocks(vIndex, vResults, nThreads, [](const CBlockIndex* pindex, CAddressIndexSyncBlock& result) {
+                ReadAddressIndexSyncBlock(pindex, result);
+            });
+
+            // cs_main is only taken to check that each block is still in the chain: the
+            // index is not written by validation until it is synced, so it is written
+            // without the lock. A block disconnected right after the check is removed
+            // again by the next AddressIndexNextBlocks.
+            int nHeight = -1;
+            for (unsigned int i = 0; i < vIndex.size(); i++) {
+                boost::this_thread::interruption_point();
+                const CBlockIndex* pindex = vIndex[i];
+                {
+                    LOCK(cs_main);
+                    // The chain may have moved on while the blocks were read
+                    if (!chainActive.Contains(pindex))
+                        break;
+                }
+                if (!vResults[i].fRead)
+                    throw std::runtime_error(strprintf("failed to read block %s", pindex->GetBlockHash().GetHex()));
+                if (!paddressindex->ConnectBlock(vResults[i].block, vResults[i].blockundo, pindex))
+                    throw std::runtime_error(strprintf("failed to add block %s", pindex->GetBlockHash().GetHex()));
+                SetAddressIndexBest(pindex->GetBlockHash(), pindex->nHeight, false);
+                nHeight = pindex->nHeight;
+            }
+
+            if (nLogHeight == -1 || nHeight >= nLogHeight + 10 * ADDRESSINDEX_SYNC_BATCH_SIZE) {
+                LogPrintf("%s : address index at height %d\n", __func__, nHeight);
+                nLogHeight = nHeight;
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        // Leave the index unsynced, so that queries keep being refused
+        LogPrintf("%s : %s, address index no longer updated\n", __func__, e.what());
+    }
+}
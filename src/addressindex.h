@@ -0,0 +1,236 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef PIVX_ADDRESSINDEX_H
+#define PIVX_ADDRESSINDEX_H
+
+#include "amount.h"
+#include "compat/endian.h"
+#include "leveldbwrapper.h"
+#include "script/script.h"
+#include "script/standard.h"
+#include "serialize.h"
+#include "uint256.h"
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+class CBlock;
+class CBlockIndex;
+class CBlockUndo;
+
+//! -addressindex default
+static const bool DEFAULT_ADDRESSINDEX = false;
+
+/**
+ * Address an output is indexed under: the key hash of a pay-to-pubkey(-hash) or
+ * cold staking (owner) script, or the script hash of a pay-to-script-hash one.
+ */
+struct CIndexAddress {
+    enum Type : uint8_t {
+        NONE = 0,
+        KEY = 1,
+        SCRIPT = 2,
+    };
+
+    uint8_t type;
+    uint160 hash;
+
+    CIndexAddress() : type(NONE) {}
+    CIndexAddress(uint8_t typeIn, const uint160& hashIn) : type(typeIn), hash(hashIn) {}
+
+    static CIndexAddress FromScript(const CScript& script);
+    static CIndexAddress FromDestination(const CTxDestination& dest);
+    CTxDestination GetDestination() const;
+    bool IsNull() const { return type == NONE; }
+
+    friend bool operator==(const CIndexAddress& a, const CIndexAddress& b) { return a.type == b.type && a.hash == b.hash; }
+    friend bool operator<(const CIndexAddress& a, const CIndexAddress& b) { return a.type < b.type || (a.type == b.type && a.hash < b.hash); }
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(type);
+        READWRITE(hash);
+    }
+};
+
+/**
+ * An output received or spent by an address. Heights and indexes are stored big
+ * endian, so that the records of an address are iterated in height order.
+ */
+struct CAddressDeltaKey {
+    CIndexAddress address;
+    int nHeight;
+    uint256 txid;
+    uint32_t nIndex;
+    bool fSpending;
+
+    CAddressDeltaKey() : nHeight(0), nIndex(0), fSpending(false) {}
+    CAddressDeltaKey(const CIndexAddress& addressIn, int nHeightIn, const uint256& txidIn, uint32_t nIndexIn, bool fSpendingIn) : address(addressIn), nHeight(nHeightIn), txid(txidIn), nIndex(nIndexIn), fSpending(fSpendingIn) {}
+
+    unsigned int GetSerializeSize(int nType, int nVersion) const
+    {
+        return 1 + 20 + 4 + 32 + 4 + 1;
+    }
+
+    template <typename Stream>
+    void Serialize(Stream& s, int nType, int nVersion) const
+    {
+        ::Serialize(s, address, nType, nVersion);
+        uint32_t nHeightBE = htobe32(nHeight);
+        WRITEDATA(s, nHeightBE);
+        ::Serialize(s, txid, nType, nVersion);
+        uint32_t nIndexBE = htobe32(nIndex);
+        WRITEDATA(s, nIndexBE);
+        ::Serialize(s, fSpending, nType, nVersion);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s, int nType, int nVersion)
+    {
+        ::Unserialize(s, address, nType, nVersion);
+        uint32_t nHeightBE;
+        READDATA(s, nHeightBE);
+        nHeight = be32toh(nHeightBE);
+        ::Unserialize(s, txid, nType, nVersion);
+        uint32_t nIndexBE;
+        READDATA(s, nIndexBE);
+        nIndex = be32toh(nIndexBE);
+        ::Unserialize(s, fSpending, nType, nVersion);
+    }
+};
+
+/** An unspent output of an address */
+struct CAddressUnspentKey {
+    CIndexAddress address;
+    uint256 txid;
+    uint32_t nIndex;
+
+    CAddressUnspentKey() : nIndex(0) {}
+    CAddressUnspentKey(const CIndexAddress& addressIn, const uint256& txidIn, uint32_t nIndexIn) : address(addressIn), txid(txidIn), nIndex(nIndexIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(address);
+        READWRITE(txid);
+        READWRITE(nIndex);
+    }
+};
+
+struct CAddressUnspentValue {
+    CAmount nValue;
+    CScript script;
+    int nHeight;
+
+    CAddressUnspentValue() : nValue(0), nHeight(0) {}
+    CAddressUnspentValue(CAmount nValueIn, const CScript& scriptIn, int nHeightIn) : nValue(nValueIn), script(scriptIn), nHeight(nHeightIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(nValue);
+        READWRITE(script);
+        READWRITE(nHeight);
+    }
+};
+
+/** A spent output */
+struct CSpentIndexKey {
+    uint256 txid;
+    uint32_t nIndex;
+
+    CSpentIndexKey() : nIndex(0) {}
+    CSpentIndexKey(const uint256& txidIn, uint32_t nIndexIn) : txid(txidIn), nIndex(nIndexIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(txid);
+        READWRITE(nIndex);
+    }
+};
+
+/** The input spending an output, and what the output was */
+struct CSpentIndexValue {
+    uint256 txid;
+    uint32_t nInputIndex;
+    int nHeight;
+    CAmount nValue;
+    CIndexAddress address;
+    //! Height of the spent output, -1 when unknown
+    int nPrevHeight;
+
+    CSpentIndexValue() : nInputIndex(0), nHeight(0), nValue(0), nPrevHeight(-1) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(txid);
+        READWRITE(nInputIndex);
+        READWRITE(nHeight);
+        READWRITE(nValue);
+        READWRITE(address);
+        READWRITE(nPrevHeight);
+    }
+};
+
+/** Address and spent output index database (addressindex/) */
+class CAddressIndexDB : public CLevelDBWrapper
+{
+public:
+    CAddressIndexDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+
+private:
+    CAddressIndexDB(const CAddressIndexDB&);
+    void operator=(const CAddressIndexDB&);
+
+public:
+    /** The block the index is at, null if nothing was indexed yet */
+    bool ReadBestBlock(uint256& hashBlock) const;
+    /** Outputs received and spent by an address in blocks nStart to nEnd, in height order */
+    bool ReadAddressDeltas(const CIndexAddress& address, int nStart, int nEnd, std::vector<std::pair<CAddressDeltaKey, CAmount> >& vDeltas);
+    bool ReadAddressUnspent(const CIndexAddress& address, std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> >& vUnspent);
+    bool ReadSpentIndex(const CSpentIndexKey& key, CSpentIndexValue& value) const;
+
+    /** Add the records of a block whose parent is the best block, and make it the best block */
+    bool ConnectBlock(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex);
+    /** Remove the records of the best block, and make its parent the best block */
+    bool DisconnectBlock(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex);
+};
+
+/** The address index, NULL unless -addressindex is set */
+extern CAddressIndexDB* paddressindex;
+
+/**
+ * Keep the index up to date with a block connected to or disconnected from the
+ * active chain. Only done once the index caught up with the chain; until then
+ * ThreadAddressIndexSync indexes the blocks. Called with cs_main held.
+ */
+bool AddressIndexBlockConnected(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex);
+bool AddressIndexBlockDisconnected(const CBlock& block, const CBlockUndo& blockundo, const CBlockIndex* pindex);
+
+/**
+ * Bring the index up to the active chain: blocks that left the chain are removed,
+ * missing ones are read on several threads and added in height order. Afterwards
+ * the thread waits until the index falls behind again, or it is interrupted.
+ */
+void ThreadAddressIndexSync();
+
+/** Whether the index caught up with the active chain, and the height it is at */
+bool IsAddressIndexSynced(int* pnHeight = NULL);
+
+#endif // PIVX_ADDRESSINDEX_H
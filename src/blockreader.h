@@ -0,0 +1,57 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef PIVX_BLOCKREADER_H
+#define PIVX_BLOCKREADER_H
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+/** Number of threads used to read blocks in parallel when scanning the chain */
+int GetRecalculationThreads();
+
+/**
+ * Read and extract data from a set of blocks on up to nThreads threads. fnRead
+ * fills vResults[i] from vItems[i] and must not take cs_main, as the caller may
+ * already hold it.
+ */
+template <typename Item, typename T, typename ReadFn>
+void ParallelReadBlocks(const std::vector<Item>& vItems, std::vector<T>& vResults, int nThreads, ReadFn fnRead)
+{
+    vResults.assign(vItems.size(), T());
+    std::atomic<size_t> nNext(0);
+    std::exception_ptr pException;
+    std::mutex csException;
+
+    auto worker = [&]() {
+        try {
+            for (size_t i = nNext++; i < vItems.size(); i = nNext++)
+                fnRead(vItems[i], vResults[i]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(csException);
+            if (!pException)
+                pException = std::current_exception();
+            nNext = vItems.size();
+        }
+    };
+
+    if (nThreads > 1 && vItems.size() > 1) {
+        boost::thread_group threadGroup;
+        for (int i = 1; i < nThreads; i++)
+            threadGroup.create_thread(worker);
+        worker();
+        threadGroup.join_all();
+    } else {
+        worker();
+    }
+
+    if (pException)
+        std::rethrow_exception(pException);
+}
+
+#endif // PIVX_BLOCKREADER_H
@@ -0,0 +1,250 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "cachefile.h"
+
+#include "chainparams.h"
+#include "hash.h"
+#include "sync.h"
+
+#include <boost/filesystem.hpp>
+
+/**
+ * Hashes of the chunks of each cache file as the last Write or clean Read of this
+ * process left them on disk, with the file size then. While the size matches, a Write
+ * compares the hashes of the new chunks with these instead of scanning the file.
+ */
+struct CCacheFileDisk {
+    uint64_t nFileSize;
+    std::map<std::string, uint256> mapChunkHashes;
+};
+static std::map<std::string, CCacheFileDisk> mapCacheFileDisk;
+static CCriticalSection cs_cachefiledisk;
+
+/** The remembered chunk hashes of path, or NULL if the file changed since */
+static CCacheFileDisk* GetCacheFileDisk(const boost::filesystem::path& path)
+{
+    AssertLockHeld(cs_cachefiledisk);
+    std::map<std::string, CCacheFileDisk>::iterator it = mapCacheFileDisk.find(path.string());
+    if (it == mapCacheFileDisk.end())
+        return NULL;
+    boost::system::error_code ec;
+    if (boost::filesystem::file_size(path, ec) != it->second.nFileSize || ec) {
+        mapCacheFileDisk.erase(it);
+        return NULL;
+    }
+    return &it->second;
+}
+
+CCacheFile::CCacheFile(const boost::filesystem::path& pathIn, const std::string& strMagicMessageIn) : path(pathIn),
+                                                                                                     strMagicMessage(strMagicMessageIn)
+{
+}
+
+uint256 CCacheFile::GetChunkHash(const std::string& strName, const std::vector<char>& vchChunk) const
+{
+    CHashWriter ss(SER_GETHASH, 0);
+    ss << strName << vchChunk;
+    return ss.GetHash();
+}
+
+CCacheFile::ReadResult CCacheFile::Scan(std::map<std::string, uint256>& mapOnDisk, std::map<std::string, std::vector<char> >* pmapChunks, uint64_t& nLiveBytes, bool& fClean) const
+{
+    fClean = true;
+    nLiveBytes = 0;
+
+    FILE* file = fopen(path.string().c_str(), "rb");
+    CAutoFile filein(file, SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull()) {
+        error("%s : Failed to open file %s", __func__, path.string());
+        return FileError;
+    }
+    const uint64_t nFileSize = boost::filesystem::file_size(path);
+
+    std::string strMagicMessageTmp;
+    unsigned char pchMsgTmp[4];
+    int nVersion;
+    try {
+        // verify the file specific magic message, network magic number and format version
+        filein >> strMagicMessageTmp;
+        if (strMagicMessage != strMagicMessageTmp) {
+            error("%s : Invalid %s magic message", __func__, path.filename().string());
+            return IncorrectMagicMessage;
+        }
+        filein >> FLATDATA(pchMsgTmp);
+        if (memcmp(pchMsgTmp, Params().MessageStart(), sizeof(pchMsgTmp))) {
+            error("%s : Invalid network magic number", __func__);
+            return IncorrectMagicNumber;
+        }
+        filein >> nVersion;
+    } catch (const std::exception& e) {
+        error("%s : Deserialize or I/O error - %s", __func__, e.what());
+        return IncorrectFormat;
+    }
+    if (nVersion != CACHE_FILE_VERSION) {
+        // also the case of the single-blob format written by older versions
+        error("%s : Unknown %s format version %d", __func__, path.filename().string(), nVersion);
+        return IncorrectFormat;
+    }
+
+    std::map<std::string, uint64_t> mapRecordSize;
+    while (ftell(filein.Get()) < (long)nFileSize) {
+        std::string strName;
+        std::vector<char> vchChunk;
+        uint256 hash;
+        try {
+            filein >> strName >> vchChunk >> hash;
+        } catch (const std::exception& e) {
+            // a truncated tail, typically an interrupted append: keep what was read so far
+            error("%s : Truncated record in %s - %s", __func__, path.filename().string(), e.what());
+            fClean = false;
+            break;
+        }
+        if (hash != GetChunkHash(strName, vchChunk)) {
+            error("%s : Checksum mismatch for chunk %s of %s, using its previous copy", __func__, strName, path.filename().string());
+            fClean = false;
+            continue;
+        }
+        mapOnDisk[strName] = hash;
+        mapRecordSize[strName] = vchChunk.size();
+        if (pmapChunks)
+            (*pmapChunks)[strName].swap(vchChunk);
+    }
+
+    for (const auto& it : mapRecordSize)
+        nLiveBytes += it.second;
+
+    return Ok;
+}
+
+bool CCacheFile::WriteRecords(CAutoFile& fileout, const std::vector<std::string>& vNames, const std::map<std::string, uint256>& mapHashes) const
+{
+    try {
+        for (const std::string& strName : vNames)
+            fileout << strName << mapChunks.at(strName) << mapHashes.at(strName);
+        FileCommit(fileout.Get());
+    } catch (const std::exception& e) {
+        return error("%s : Serialize or I/O error - %s", __func__, e.what());
+    }
+    fileout.fclose();
+    return true;
+}
+
+bool CCacheFile::Write()
+{
+    int64_t nStart = GetTimeMillis();
+
+    LOCK(cs_cachefiledisk);
+    CCacheFileDisk* pdisk = GetCacheFileDisk(path);
+    if (!pdisk) {
+        pdisk = &mapCacheFileDisk[path.string()];
+        uint64_t nDiskLiveBytes = 0;
+        bool fClean = false;
+        // an unreadable file is rewritten from scratch, with no chunk in common
+        if (boost::filesystem::exists(path) && Scan(pdisk->mapChunkHashes, NULL, nDiskLiveBytes, fClean) == Ok && fClean) {
+            pdisk->nFileSize = boost::filesystem::file_size(path);
+        } else {
+            pdisk->nFileSize = 0;
+            pdisk->mapChunkHashes.clear();
+        }
+    }
+    bool fAppend = pdisk->nFileSize > 0;
+
+    std::map<std::string, uint256> mapHashes;
+    std::vector<std::string> vDirty;
+    uint64_t nLiveBytes = 0;
+    uint64_t nDirtyBytes = 0;
+    for (const auto& it : mapChunks) {
+        const uint256 hash = GetChunkHash(it.first, it.second);
+        mapHashes[it.first] = hash;
+        nLiveBytes += it.second.size();
+        std::map<std::string, uint256>::const_iterator mi = pdisk->mapChunkHashes.find(it.first);
+        if (mi == pdisk->mapChunkHashes.end() || mi->second != hash) {
+            vDirty.push_back(it.first);
+            nDirtyBytes += it.second.size();
+        }
+    }
+    // chunks which are no longer written can only be dropped by compacting
+    for (const auto& it : pdisk->mapChunkHashes) {
+        if (!mapChunks.count(it.first))
+            fAppend = false;
+    }
+
+    if (fAppend && vDirty.empty()) {
+        LogPrint("masternode", "%s : %s is up to date  %dms\n", __func__, path.filename().string(), GetTimeMillis() - nStart);
+        return true;
+    }
+
+    // compact when the records on disk would be mostly dead
+    if (fAppend && pdisk->nFileSize + nDirtyBytes > 2 * nLiveBytes + 4096)
+        fAppend = false;
+
+    if (fAppend) {
+        CAutoFile fileout(fopen(path.string().c_str(), "ab"), SER_DISK, CLIENT_VERSION);
+        if (fileout.IsNull())
+            return error("%s : Failed to open file %s", __func__, path.string());
+        if (!WriteRecords(fileout, vDirty, mapHashes))
+            return false;
+        LogPrint("masternode", "%s : Appended %u/%u chunks to %s  %dms\n", __func__, vDirty.size(), mapChunks.size(),
+            path.filename().string(), GetTimeMillis() - nStart);
+    } else {
+        // rewrite the whole file next to the old one, then swap them
+        boost::filesystem::path pathNew = path;
+        pathNew += ".new";
+        CAutoFile fileout(fopen(pathNew.string().c_str(), "wb"), SER_DISK, CLIENT_VERSION);
+        if (fileout.IsNull())
+            return error("%s : Failed to open file %s", __func__, pathNew.string());
+        try {
+            fileout << strMagicMessage;                   // cache file specific magic message
+            fileout << FLATDATA(Params().MessageStart()); // network specific magic number
+            fileout << CACHE_FILE_VERSION;
+        } catch (const std::exception& e) {
+            return error("%s : Serialize or I/O error - %s", __func__, e.what());
+        }
+        std::vector<std::string> vNames;
+        for (const auto& it : mapChunks)
+            vNames.push_back(it.first);
+        if (!WriteRecords(fileout, vNames, mapHashes))
+            return false;
+        if (!RenameOver(pathNew, path))
+            return error("%s : Failed to rename %s", __func__, pathNew.string());
+        LogPrint("masternode", "%s : Written %u chunks to %s  %dms\n", __func__, mapChunks.size(), path.filename().string(), GetTimeMillis() - nStart);
+    }
+
+    // the disk now holds exactly the chunks written
+    pdisk->nFileSize = boost::filesystem::file_size(path);
+    pdisk->mapChunkHashes.swap(mapHashes);
+    return true;
+}
+
+CCacheFile::ReadResult CCacheFile::Read(bool fDryRun)
+{
+    int64_t nStart = GetTimeMillis();
+
+    LOCK(cs_cachefiledisk);
+    mapChunks.clear();
+    // a file this process wrote and nobody touched since needs no checking
+    if (fDryRun && GetCacheFileDisk(path))
+        return Ok;
+
+    std::map<std::string, uint256> mapOnDisk;
+    uint64_t nLiveBytes = 0;
+    bool fClean = false;
+    ReadResult result = Scan(mapOnDisk, fDryRun ? NULL : &mapChunks, nLiveBytes, fClean);
+    if (result != Ok) {
+        mapCacheFileDisk.erase(path.string());
+        return result;
+    }
+    LogPrint("masternode", "%s : Read %u chunks (%u bytes) from %s%s  %dms\n", __func__, mapOnDisk.size(), nLiveBytes,
+        path.filename().string(), fClean ? "" : " (with errors)", GetTimeMillis() - nStart);
+
+    if (fClean) {
+        CCacheFileDisk& disk = mapCacheFileDisk[path.string()];
+        disk.nFileSize = boost::filesystem::file_size(path);
+        disk.mapChunkHashes.swap(mapOnDisk);
+    } else {
+        mapCacheFileDisk.erase(path.string());
+    }
+    return Ok;
+}
@@ -0,0 +1,154 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef PIVX_CACHEFILE_H
+#define PIVX_CACHEFILE_H
+
+#include "clientversion.h"
+#include "serialize.h"
+#include "streams.h"
+#include "uint256.h"
+#include "util.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+/** Version of the chunked cache file format */
+static const int CACHE_FILE_VERSION = 1;
+/** Number of chunks a large map of a cache file is split into */
+static const unsigned int CACHE_FILE_BUCKETS = 16;
+
+inline unsigned int CacheFileBucket(const uint256& key) { return key.GetLow64() % CACHE_FILE_BUCKETS; }
+inline unsigned int CacheFileBucket(int key) { return (unsigned int)key % CACHE_FILE_BUCKETS; }
+
+/**
+ * Versioned, chunked cache file (mncache.dat, mnpayments.dat, budget.dat).
+ *
+ * The file starts with a header (magic message, network magic, format version)
+ * followed by records, each holding a named chunk and a hash of its content.
+ * Records are appended: a Write only adds the chunks that changed since the last one
+ * on disk, and the latest intact record of each name wins when reading. A corrupted
+ * record only loses its own chunk. The file is compacted once its dead records
+ * outweigh the live ones.
+ */
+class CCacheFile
+{
+public:
+    enum ReadResult {
+        Ok,
+        FileError,
+        IncorrectMagicMessage,
+        IncorrectMagicNumber,
+        IncorrectFormat
+    };
+
+private:
+    boost::filesystem::path path;
+    std::string strMagicMessage;
+    //! chunk name -> serialized content
+    std::map<std::string, std::vector<char> > mapChunks;
+
+    /**
+     * Read the header and records of the file. Intact records are kept in mapOnDisk
+     * (and their content in pmapChunks if not null). fClean is false if the file must be
+     * rewritten before appending to it (bad or truncated records).
+     */
+    ReadResult Scan(std::map<std::string, uint256>& mapOnDisk, std::map<std::string, std::vector<char> >* pmapChunks, uint64_t& nLiveBytes, bool& fClean) const;
+    bool WriteRecords(CAutoFile& fileout, const std::vector<std::string>& vNames, const std::map<std::string, uint256>& mapHashes) const;
+    uint256 GetChunkHash(const std::string& strName, const std::vector<char>& vchChunk) const;
+
+public:
+    CCacheFile(const boost::filesystem::path& pathIn, const std::string& strMagicMessageIn);
+
+    template <typename T>
+    void AddChunk(const std::string& strName, const T& obj)
+    {
+        CDataStream ss(SER_DISK, CLIENT_VERSION);
+        ss << obj;
+        mapChunks[strName].assign(ss.begin(), ss.end());
+    }
+
+    /** Split a map over CACHE_FILE_BUCKETS chunks, so that updating an entry only dirties its own chunk */
+    template <typename K, typename V>
+    void AddMapChunks(const std::string& strName, const std::map<K, V>& map)
+    {
+        std::vector<std::map<K, V> > vBuckets(CACHE_FILE_BUCKETS);
+        for (const auto& it : map)
+            vBuckets[CacheFileBucket(it.first)].insert(it);
+        for (unsigned int i = 0; i < CACHE_FILE_BUCKETS; i++)
+            AddChunk(strprintf("%s.%u", strName, i), vBuckets[i]);
+    }
+
+    /** Split a vector over CACHE_FILE_BUCKETS chunks by the key getKey returns for each element, like AddMapChunks */
+    template <typename T, typename GetKey>
+    void AddVectorChunks(const std::string& strName, const std::vector<T>& vec, GetKey getKey)
+    {
+        std::vector<std::vector<T> > vBuckets(CACHE_FILE_BUCKETS);
+        for (const T& elem : vec)
+            vBuckets[CacheFileBucket(getKey(elem))].push_back(elem);
+        for (unsigned int i = 0; i < CACHE_FILE_BUCKETS; i++)
+            AddChunk(strprintf("%s.%u", strName, i), vBuckets[i]);
+    }
+
+    /** Deserialize a chunk read from disk. Returns false if it is missing or malformed */
+    template <typename T>
+    bool GetChunk(const std::string& strName, T& obj) const
+    {
+        std::map<std::string, std::vector<char> >::const_iterator it = mapChunks.find(strName);
+        if (it == mapChunks.end())
+            return error("%s : chunk %s missing from %s", __func__, strName, path.filename().string());
+        try {
+            // leave obj untouched if the chunk can't be fully deserialized
+            CDataStream ss(it->second, SER_DISK, CLIENT_VERSION);
+            T objTmp;
+            ss >> objTmp;
+            std::swap(obj, objTmp);
+        } catch (const std::exception& e) {
+            return error("%s : chunk %s of %s has invalid format - %s", __func__, strName, path.filename().string(), e.what());
+        }
+        return true;
+    }
+
+    /** Merge the readable chunks of a map written by AddMapChunks. Returns false if any of them was lost */
+    template <typename K, typename V>
+    bool GetMapChunks(const std::string& strName, std::map<K, V>& map) const
+    {
+        bool fComplete = true;
+        for (unsigned int i = 0; i < CACHE_FILE_BUCKETS; i++) {
+            std::map<K, V> mapBucket;
+            if (!GetChunk(strprintf("%s.%u", strName, i), mapBucket)) {
+                fComplete = false;
+                continue;
+            }
+            map.insert(mapBucket.begin(), mapBucket.end());
+        }
+        return fComplete;
+    }
+
+    /** Append the readable chunks of a vector written by AddVectorChunks. Returns false if any of them was lost */
+    template <typename T>
+    bool GetVectorChunks(const std::string& strName, std::vector<T>& vec) const
+    {
+        bool fComplete = true;
+        for (unsigned int i = 0; i < CACHE_FILE_BUCKETS; i++) {
+            std::vector<T> vBucket;
+            if (!GetChunk(strprintf("%s.%u", strName, i), vBucket)) {
+                fComplete = false;
+                continue;
+            }
+            vec.insert(vec.end(), vBucket.begin(), vBucket.end());
+        }
+        return fComplete;
+    }
+
+    /** Write the added chunks, appending only those whose content differs from the disk */
+    bool Write();
+    /** Load the chunks from disk. With fDryRun the file is only checked, nothing is kept in memory */
+    ReadResult Read(bool fDryRun = false);
+};
+
+#endif // PIVX_CACHEFILE_H
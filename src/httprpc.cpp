@@ -8,6 +8,7 @@
 #include "base58.h"
 #include "chainparams.h"
 #include "httpserver.h"
+#include "rpc/jsonstream.h"
 #include "rpc/protocol.h"
 #include "rpc/server.h"
 #include "random.h"
@@ -59,6 +60,8 @@ private:
 static std::string strRPCUserColonPass;
 /* Stored RPC timer interface (for unregistration) */
 static HTTPRPCTimerInterface* httpRPCTimerInterface = 0;
+/* Maximum number of requests of a batch executed at the same time */
+static int nRPCBatchThreads = 1;
 
 static void JSONErrorReply(HTTPRequest* req, const UniValue& objError, const UniValue& id)
 {
@@ -129,12 +132,20 @@ static bool HTTPReq_JSONRPC(HTTPRequest* req, const std::string &)
 
             UniValue result = tableRPC.execute(jreq.strMethod, jreq.params);
 
-            // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            // Send reply, serialized straight into the reply rather than into one big string
+            req->WriteHeader("Content-Type", "application/json");
+            HTTPReplyStream reply(req, HTTP_OK);
+            CJSONStreamWriter writer([&reply](const std::string& strChunk) { return reply.Write(strChunk); }, HTTP_REPLY_CHUNK_SIZE);
+            JSONRPCReplyStream(writer, result, NullUniValue, jreq.id);
+            writer.Flush();
+            reply.Write("\n");
+            reply.Finish();
+            RecordRPCReplySize(jreq.strMethod, reply.GetSize());
+            return true;
 
         // array of requests
         } else if (valRequest.isArray())
-            strReply = JSONRPCExecBatch(valRequest.get_array());
+            strReply = JSONRPCExecBatch(valRequest.get_array(), QueueHTTPTask, nRPCBatchThreads);
         else
             throw JSONRPCError(RPC_PARSE_ERROR, "Top-level object parse error");
 
@@ -173,6 +184,13 @@ bool StartHTTPRPC()
     if (!InitRPCAuthentication())
         return false;
 
+    // A batch keeps one HTTP worker free for the other requests
+    nRPCBatchThreads = std::max((int)GetArg("-rpcbatchthreads", DEFAULT_RPC_BATCH_THREADS), 1);
+    const int nMaxBatchThreads = std::max((int)GetArg("-rpcthreads", DEFAULT_HTTP_THREADS) - 1, 1);
+    if (nRPCBatchThreads > nMaxBatchThreads) {
+        LogPrintf("HTTP: limiting -rpcbatchthreads to %d, one less than -rpcthreads\n", nMaxBatchThreads);
+        nRPCBatchThreads = nMaxBatchThreads;
+    }
     RegisterHTTPHandler("/", true, HTTPReq_JSONRPC);
 
     assert(EventBase());
@@ -20,7 +20,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <signal.h>
+#include <condition_variable>
 #include <future>
+#include <mutex>
 
 #include <event2/event.h>
 #include <event2/http.h>
@@ -59,6 +61,22 @@ private:
     HTTPRequestHandler func;
 };
 
+/** Work item running an arbitrary task on a worker thread */
+class HTTPTaskItem : public HTTPClosure
+{
+public:
+    HTTPTaskItem(const std::function<void()>& task): task(task)
+    {
+    }
+    void operator()()
+    {
+        task();
+    }
+
+private:
+    std::function<void()> task;
+};
+
 /** Simple work queue for distributing work over multiple threads.
  * Work items are simply callable objects.
  */
@@ -538,12 +556,16 @@ void HTTPEvent::trigger(struct timeval* tv)
         evtimer_add(ev, tv); // trigger after timeval passed
 }
 HTTPRequest::HTTPRequest(struct evhttp_request* req) : req(req),
-                                                       replySent(false)
+                                                       replySent(false),
+                                                       chunkedReply(nullptr)
 {
 }
 HTTPRequest::~HTTPRequest()
 {
-    if (!replySent) {
+    if (chunkedReply) {
+        LogPrintf("%s: Unfinished chunked reply\n", __func__);
+        WriteReplyEnd();
+    } else if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
         WriteReply(HTTP_INTERNAL, "Unhandled request");
@@ -608,6 +630,193 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     req = 0; // transferred back to main thread
 }
 
+/** Progress of a chunked reply, shared by the worker producing it and the http thread sending it */
+struct HTTPChunkedReply
+{
+    std::mutex cs;
+    std::condition_variable cond;
+    //! Bytes queued by the worker
+    size_t nQueued = 0;
+    //! Bytes given to libevent, only used in the http thread
+    size_t nHandedOver = 0;
+    //! Bytes written to the connection
+    size_t nSent = 0;
+    //! The client is gone or stopped reading
+    bool fAborted = false;
+};
+
+/** libevent emptied the output buffer of the connection */
+static void http_chunk_sent_cb(struct evhttp_connection* conn, void* arg)
+{
+    HTTPChunkedReply* reply = (HTTPChunkedReply*)arg;
+    std::lock_guard<std::mutex> lock(reply->cs);
+    reply->nSent = reply->nHandedOver;
+    reply->cond.notify_all();
+}
+
+/** The connection closed in the middle of a chunked reply */
+static void http_chunk_close_cb(struct evhttp_connection* conn, void* arg)
+{
+    HTTPChunkedReply* reply = (HTTPChunkedReply*)arg;
+    std::lock_guard<std::mutex> lock(reply->cs);
+    reply->fAborted = true;
+    reply->cond.notify_all();
+}
+
+void HTTPRequest::WriteReplyStart(int nStatus)
+{
+    assert(!replySent && req && !chunkedReply);
+    HTTPChunkedReply* reply = new HTTPChunkedReply();
+    struct evhttp_request* r = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [r, nStatus, reply]() {
+        evhttp_connection* conn = evhttp_request_get_connection(r);
+        if (conn)
+            evhttp_connection_set_closecb(conn, http_chunk_close_cb, reply);
+        else
+            http_chunk_close_cb(NULL, reply);
+        evhttp_send_reply_start(r, nStatus, NULL);
+    });
+    ev->trigger(0);
+    chunkedReply = reply;
+    replySent = true;
+}
+
+bool HTTPRequest::WriteReplyChunk(const std::string& strChunk)
+{
+    assert(chunkedReply && req);
+    if (strChunk.empty())
+        return true;
+    HTTPChunkedReply* reply = chunkedReply;
+    {
+        std::unique_lock<std::mutex> lock(reply->cs);
+        while (!reply->fAborted && reply->nQueued - reply->nSent > MAX_HTTP_UNSENT_REPLY) {
+            // A client that reads nothing for that long gets the same treatment as an idle connection
+            if (reply->cond.wait_for(lock, std::chrono::seconds(GetArg("-rpcservertimeout", DEFAULT_HTTP_SERVER_TIMEOUT))) == std::cv_status::timeout &&
+                reply->nQueued - reply->nSent > MAX_HTTP_UNSENT_REPLY) {
+                LogPrint("http", "Client stopped reading a chunked reply, dropping the rest of it\n");
+                reply->fAborted = true;
+            }
+        }
+        if (reply->fAborted)
+            return false;
+        reply->nQueued += strChunk.size();
+    }
+
+    struct evbuffer* evb = evbuffer_new();
+    assert(evb);
+    evbuffer_add(evb, strChunk.data(), strChunk.size());
+    struct evhttp_request* r = req;
+    const size_t nSize = strChunk.size();
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [r, evb, reply, nSize]() {
+        reply->nHandedOver += nSize;
+#if LIBEVENT_VERSION_NUMBER >= 0x02010100
+        evhttp_send_reply_chunk_with_cb(r, evb, http_chunk_sent_cb, reply);
+#else
+        // Without a completion callback only the queue between the threads is bounded
+        evhttp_send_reply_chunk(r, evb);
+        http_chunk_sent_cb(NULL, reply);
+#endif
+        evbuffer_free(evb);
+    });
+    ev->trigger(0);
+    return true;
+}
+
+void HTTPRequest::WriteReplyEnd()
+{
+    assert(chunkedReply && req);
+    HTTPChunkedReply* reply = chunkedReply;
+    struct evhttp_request* r = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [r, reply]() {
+        // Once the reply is ended libevent drops our callbacks, it is safe to free their state
+        evhttp_connection* conn = evhttp_request_get_connection(r);
+        if (conn)
+            evhttp_connection_set_closecb(conn, NULL, NULL);
+        evhttp_send_reply_end(r);
+        delete reply;
+    });
+    ev->trigger(0);
+    chunkedReply = nullptr;
+    req = 0; // transferred back to main thread
+}
+
+void HTTPRequest::WriteReplyAbort()
+{
+    assert(chunkedReply && req);
+    HTTPChunkedReply* reply = chunkedReply;
+    struct evhttp_request* r = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [r, reply]() {
+        // Freeing the connection also frees the request
+        evhttp_connection* conn = evhttp_request_get_connection(r);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, NULL, NULL);
+            evhttp_connection_free(conn);
+        }
+        delete reply;
+    });
+    ev->trigger(0);
+    chunkedReply = nullptr;
+    req = 0; // transferred back to main thread
+}
+
+HTTPReplyStream::HTTPReplyStream(HTTPRequest* req, int nStatus) : req(req),
+                                                                  nStatus(nStatus),
+                                                                  fChunked(false),
+                                                                  fFinished(false),
+                                                                  nBytes(0)
+{
+}
+
+HTTPReplyStream::~HTTPReplyStream()
+{
+    if (fChunked && !fFinished)
+        Finish();
+}
+
+bool HTTPReplyStream::Write(const std::string& strData)
+{
+    assert(!fFinished);
+    nBytes += strData.size();
+    // Pieces of a chunk or more are sent as they are, without going through strPending
+    const bool fDirect = strPending.empty() && strData.size() >= HTTP_REPLY_CHUNK_SIZE;
+    if (!fDirect) {
+        strPending += strData;
+        if (strPending.size() < HTTP_REPLY_CHUNK_SIZE)
+            return true;
+    }
+    if (!fChunked) {
+        req->WriteReplyStart(nStatus);
+        fChunked = true;
+    }
+    bool fRet = req->WriteReplyChunk(fDirect ? strData : strPending);
+    strPending.clear();
+    return fRet;
+}
+
+void HTTPReplyStream::Finish()
+{
+    assert(!fFinished);
+    fFinished = true;
+    if (fChunked) {
+        req->WriteReplyChunk(strPending);
+        req->WriteReplyEnd();
+    } else {
+        req->WriteReply(nStatus, strPending);
+    }
+    strPending.clear();
+}
+
+void HTTPReplyStream::Abort()
+{
+    assert(!fFinished);
+    fFinished = true;
+    if (fChunked)
+        req->WriteReplyAbort();
+    else
+        req->WriteReply(HTTP_INTERNAL_SERVER_ERROR);
+    strPending.clear();
+}
+
 CService HTTPRequest::GetPeer()
 {
     evhttp_connection* con = evhttp_request_get_connection(req);
@@ -667,3 +876,14 @@ void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch)
         pathHandlers.erase(i);
     }
 }
+
+bool QueueHTTPTask(const std::function<void()>& task)
+{
+    if (!workQueue)
+        return false;
+    std::unique_ptr<HTTPTaskItem> item(new HTTPTaskItem(task));
+    if (!workQueue->Enqueue(item.get()))
+        return false;
+    item.release(); /* queue took ownership */
+    return true;
+}
@@ -12,11 +12,16 @@
 static const int DEFAULT_HTTP_THREADS=4;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
+/** Maximum size of a chunked reply that may be waiting to be sent to the client */
+static const size_t MAX_HTTP_UNSENT_REPLY = 1024 * 1024;
+/** Size of the pieces of a reply sent with chunked transfer encoding */
+static const size_t HTTP_REPLY_CHUNK_SIZE = 64 * 1024;
 
 struct evhttp_request;
 struct event_base;
 class CService;
 class HTTPRequest;
+struct HTTPChunkedReply;
 
 /** Initialize HTTP server.
  * Call this before RegisterHTTPHandler or EventBase().
@@ -42,6 +47,12 @@ void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPR
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
 
+/** Run a task on one of the HTTP worker threads.
+ * Returns false if the task could not be queued (work queue full or not
+ * created). Queued tasks may still be dropped without running on shutdown.
+ */
+bool QueueHTTPTask(const std::function<void()>& task);
+
 /** Return evhttp event base. This can be used by submodules to
  * queue timers or custom events.
  */
@@ -55,6 +66,8 @@ class HTTPRequest
 private:
     struct evhttp_request* req;
     bool replySent;
+    //! Set while a chunked reply is being sent, owned by the http thread
+    HTTPChunkedReply* chunkedReply;
 
 public:
     HTTPRequest(struct evhttp_request* req);
@@ -110,6 +123,66 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+
+    /**
+     * Start a reply with chunked transfer encoding, for bodies that are sent as they
+     * are produced. Send the body with WriteReplyChunk and finish it with WriteReplyEnd.
+     *
+     * @note Call WriteHeader before this, and never WriteReply afterwards.
+     */
+    void WriteReplyStart(int nStatus);
+
+    /**
+     * Queue a piece of a chunked reply. Blocks while more than MAX_HTTP_UNSENT_REPLY
+     * bytes of the reply wait to be sent, so a slow client can't make us buffer the
+     * whole body. Returns false once the client is gone, further chunks are dropped.
+     */
+    bool WriteReplyChunk(const std::string& strChunk);
+
+    /**
+     * Finish a chunked reply. Like WriteReply, this gives the request back to the
+     * main thread.
+     */
+    void WriteReplyEnd();
+
+    /**
+     * Give up on a chunked reply: the connection is closed without the final
+     * chunk, so the client can tell the body is incomplete. Like WriteReplyEnd,
+     * this gives the request back to the main thread.
+     */
+    void WriteReplyAbort();
+};
+
+/** Body of an HTTP reply written in pieces as it is produced.
+ * The body is collected until it reaches HTTP_REPLY_CHUNK_SIZE: smaller bodies are
+ * sent with a plain WriteReply, larger ones with chunked transfer encoding.
+ */
+class HTTPReplyStream
+{
+private:
+    HTTPRequest* req;
+    int nStatus;
+    std::string strPending;
+    bool fChunked;
+    bool fFinished;
+    size_t nBytes;
+
+public:
+    HTTPReplyStream(HTTPRequest* req, int nStatus);
+    /** Ends a chunked reply left unfinished. A reply not started yet is left to the request. */
+    ~HTTPReplyStream();
+
+    /** Append to the body. Returns false when the client is gone. */
+    bool Write(const std::string& strData);
+    /** Send what is left and complete the reply */
+    void Finish();
+    /**
+     * End the reply as failed instead: if part of it was sent the connection is
+     * closed before its end, otherwise an error status is sent without a body.
+     */
+    void Abort();
+    /** Size of the body written so far */
+    size_t GetSize() const { return nBytes; }
 };
 
 /** Event handler closure.
@@ -16,13 +16,13 @@
 
 #include "zpiv/accumulators.h"
 #include "activemasternode.h"
+#include "addressindex.h"
 #include "addrman.h"
 #include "amount.h"
 #include "checkpoints.h"
 #include "compat/sanity.h"
 #include "httpserver.h"
 #include "httprpc.h"
-#include "invalid.h"
 #include "key.h"
 #include "main.h"
 #include "masternode-budget.h"
@@ -32,6 +32,7 @@
 #include "messagesigner.h"
 #include "miner.h"
 #include "net.h"
+#include "rpc/responsecache.h"
 #include "rpc/server.h"
 #include "script/standard.h"
 #include "scheduler.h"
@@ -79,6 +80,7 @@ CzPIVWallet* zwalletMain = NULL;
 int nWalletBackups = 10;
 #endif
 volatile bool fFeeEstimatesInitialized = false;
+static bool fDumpMempoolLater = false;
 volatile bool fRestartRequested = false; // true: restart false: shutdown
 extern std::list<uint256> listAccCheckpointsNoDB;
 
@@ -219,6 +221,13 @@ void PrepareShutdown()
     // CScheduler/checkqueue threadGroup
     threadGroup.interrupt_all();
     threadGroup.join_all();
+    // No more validation events come from other threads, deliver the queued ones
+    StopValidationInterfaceQueue();
+
+    if (fDumpMempoolLater && GetBoolArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
+        DumpMempool();
+        fDumpMempoolLater = false;
+    }
 
     if (fFeeEstimatesInitialized) {
         boost::filesystem::path est_path = GetDataDir() / FEE_ESTIMATES_FILENAME;
@@ -242,12 +251,16 @@ void PrepareShutdown()
         pcoinsTip = NULL;
         delete pcoinscatcher;
         pcoinscatcher = NULL;
+        delete pcoinsWriter;
+        pcoinsWriter = NULL;
         delete pcoinsdbview;
         pcoinsdbview = NULL;
         delete pblocktree;
         pblocktree = NULL;
         delete zerocoinDB;
         zerocoinDB = NULL;
+        delete paddressindex;
+        paddressindex = NULL;
         delete pSporkDB;
         pSporkDB = NULL;
     }
@@ -406,6 +419,7 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-maxreorg=<n>", strprintf(_("Set the Maximum reorg depth (default: %u)"), Params(CBaseChainParams::MAIN).MaxReorganizationDepth()));
     strUsage += HelpMessageOpt("-maxorphantx=<n>", strprintf(_("Keep at most <n> unconnectable transactions in memory (default: %u)"), DEFAULT_MAX_ORPHAN_TRANSACTIONS));
     strUsage += HelpMessageOpt("-par=<n>", strprintf(_("Set the number of script verification threads (%u to %d, 0 = auto, <0 = leave that many cores free, default: %d)"), -(int)boost::thread::hardware_concurrency(), MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS));
+    strUsage += HelpMessageOpt("-persistmempool", strprintf(_("Whether to save the mempool on shutdown and load on restart (default: %u)"), DEFAULT_PERSIST_MEMPOOL));
 #ifndef WIN32
     strUsage += HelpMessageOpt("-pid=<file>", strprintf(_("Specify pid file (default: %s)"), "pivxd.pid"));
 #endif
@@ -417,6 +431,7 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-sysperms", _("Create new files with system default permissions, instead of umask 077 (only effective with disabled wallet functionality)"));
 #endif
     strUsage += HelpMessageOpt("-txindex", strprintf(_("Maintain a full transaction index, used by the getrawtransaction rpc call (default: %u)"), 0));
+    strUsage += HelpMessageOpt("-addressindex", strprintf(_("Maintain an index of the outputs received and spent by every address, used by the getaddress* and getspentinfo rpc calls. It is built in the background when first enabled (default: %u)"), DEFAULT_ADDRESSINDEX));
     strUsage += HelpMessageOpt("-forcestart", _("Attempt to force blockchain corruption recovery") + " " + _("on startup"));
 
     strUsage += HelpMessageGroup(_("Connection options:"));
@@ -495,6 +510,8 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-zmqpubrawblock=<address>", _("Enable publish raw block in <address>"));
     strUsage += HelpMessageOpt("-zmqpubrawtx=<address>", _("Enable publish raw transaction in <address>"));
     strUsage += HelpMessageOpt("-zmqpubrawtxlock=<address>", _("Enable publish raw transaction (locked via SwiftX) in <address>"));
+    strUsage += HelpMessageOpt("-zmqqueuesize=<n>", strprintf(_("Maximum number of notifications waiting to be published, further ones are dropped (default: %u)"), DEFAULT_ZMQ_QUEUE_SIZE));
+    strUsage += HelpMessageOpt("-zmqqueuemem=<n>", strprintf(_("Maximum memory used by the notifications waiting to be published in MiB, further ones are dropped (default: %u)"), DEFAULT_ZMQ_QUEUE_MEM));
 #endif
 
     strUsage += HelpMessageGroup(_("Debugging/Testing options:"));
@@ -528,6 +545,7 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-logips", strprintf(_("Include IP addresses in debug output (default: %u)"), 0));
     strUsage += HelpMessageOpt("-logtimestamps", strprintf(_("Prepend debug output with timestamp (default: %u)"), 1));
     if (GetBoolArg("-help-debug", false)) {
+        strUsage += HelpMessageOpt("-lockprofiling", strprintf(_("Profile the wait and hold times of every lock site, see getlockcontention (default: %u)"), 0));
         strUsage += HelpMessageOpt("-limitfreerelay=<n>", strprintf(_("Continuously rate-limit free transactions to <n>*1000 bytes per minute (default:%u)"), 15));
         strUsage += HelpMessageOpt("-relaypriority", strprintf(_("Require high priority for relaying free or low-fee transactions (default:%u)"), 1));
         strUsage += HelpMessageOpt("-maxsigcachesize=<n>", strprintf(_("Limit size of signature cache to <n> entries (default: %u)"), 50000));
@@ -606,6 +624,9 @@ std::string HelpMessage(HelpMessageMode mode)
     strUsage += HelpMessageOpt("-rpcport=<port>", strprintf(_("Listen for JSON-RPC connections on <port> (default: %u or testnet: %u)"), 51473, 51475));
     strUsage += HelpMessageOpt("-rpcallowip=<ip>", _("Allow JSON-RPC connections from specified source. Valid for <ip> are a single IP (e.g. 1.2.3.4), a network/netmask (e.g. 1.2.3.4/255.255.255.0) or a network/CIDR (e.g. 1.2.3.4/24). This option can be specified multiple times"));
     strUsage += HelpMessageOpt("-rpcthreads=<n>", strprintf(_("Set the number of threads to service RPC calls (default: %d)"), DEFAULT_HTTP_THREADS));
+    strUsage += HelpMessageOpt("-rpcbatchthreads=<n>", strprintf(_("Execute up to <n> requests of a JSON-RPC batch at the same time on the RPC threads, at most -rpcthreads minus one, 1 to disable (default: %d)"), DEFAULT_RPC_BATCH_THREADS));
+    strUsage += HelpMessageOpt("-rpccachesize=<n>", strprintf(_("Keep up to <n> MiB of block and transaction query results for RPC and REST, 0 to disable (default: %u)"), DEFAULT_RPC_RESPONSE_CACHE_SIZE));
+    strUsage += HelpMessageOpt("-rpcstatsinterval=<n>", strprintf(_("Write the RPC call statistics to the debug log every <n> seconds, 0 to disable (default: %u)"), 0));
     if (GetBoolArg("-help-debug", false)) {
         strUsage += HelpMessageOpt("-rpcworkqueue=<n>", strprintf("Set the depth of the work queue to service RPC calls (default: %d)", DEFAULT_HTTP_WORKQUEUE));
         strUsage += HelpMessageOpt("-rpcservertimeout=<n>", strprintf("Timeout during HTTP requests (default: %d)", DEFAULT_HTTP_SERVER_TIMEOUT));
@@ -722,6 +743,11 @@ void ThreadImport(std::vector<boost::filesystem::path> vImportFiles)
         LogPrintf("Stopping after block import\n");
         StartShutdown();
     }
+
+    if (GetBoolArg("-persistmempool", DEFAULT_PERSIST_MEMPOOL)) {
+        LoadMempool();
+        fDumpMempoolLater = !ShutdownRequested();
+    }
 }
 
 /** Sanity checks
@@ -846,6 +872,7 @@ bool AppInit2()
     fPrintToConsole = GetBoolArg("-printtoconsole", false);
     fLogTimestamps = GetBoolArg("-logtimestamps", true);
     fLogIPs = GetBoolArg("-logips", false);
+    EnableLockProfiling(GetBoolArg("-lockprofiling", false));
 
     if (mapArgs.count("-bind") || mapArgs.count("-whitebind")) {
         // when specifying an explicit binding address, you want to listen on it
@@ -1099,8 +1126,11 @@ bool AppInit2()
 
     LogPrintf("Using %u threads for script verification\n", nScriptCheckThreads);
     if (nScriptCheckThreads) {
-        for (int i = 0; i < nScriptCheckThreads - 1; i++)
+        for (int i = 0; i < nScriptCheckThreads - 1; i++) {
             threadGroup.create_thread(&ThreadScriptCheck);
+            threadGroup.create_thread(&ThreadMempoolScriptCheck);
+            threadGroup.create_thread(&ThreadMessageSigCheck);
+        }
     }
 
     if (mapArgs.count("-sporkkey")) // spork priv key
@@ -1113,6 +1143,9 @@ bool AppInit2()
     CScheduler::Function serviceLoop = boost::bind(&CScheduler::serviceQueue, &scheduler);
     threadGroup.create_thread(boost::bind(&TraceThread<CScheduler::Function>, "scheduler", serviceLoop));
 
+    // Start the thread delivering validation notifications to the wallet and the ZMQ publisher
+    StartValidationInterfaceQueue();
+
     /* Start the RPC server already.  It will be started in "warmup" mode
      * and not really process calls already (but it will signify connections
      * that the server is there and will be ready later).  Warmup mode will
@@ -1122,6 +1155,10 @@ bool AppInit2()
         uiInterface.InitMessage.connect(SetRPCWarmupStatus);
         if (!AppInitServers())
             return InitError(_("Unable to start HTTP server. See debug log for details."));
+        blockResponseCache.SetMaxSize(std::max((int64_t)0, GetArg("-rpccachesize", DEFAULT_RPC_RESPONSE_CACHE_SIZE)) << 20);
+        int64_t nRPCStatsInterval = GetArg("-rpcstatsinterval", 0);
+        if (nRPCStatsInterval > 0)
+            scheduler.scheduleEvery(&LogRPCStats, nRPCStatsInterval);
     }
 
 // ********************************************************* Step 5: Backup wallet and verify wallet database integrity
@@ -1434,9 +1471,17 @@ bool AppInit2()
     if (nBlockTreeDBCache > (1 << 21) && !GetBoolArg("-txindex", true))
         nBlockTreeDBCache = (1 << 21); // block tree db cache shouldn't be larger than 2 MiB
     nTotalCache -= nBlockTreeDBCache;
+    size_t nAddressIndexCache = GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX) ? nTotalCache / 8 : 0;
+    nTotalCache -= nAddressIndexCache;
     size_t nCoinDBCache = nTotalCache / 2; // use half of the remaining cache for coindb cache
     nTotalCache -= nCoinDBCache;
-    nCoinCacheSize = nTotalCache / 300; // coins in memory require around 300 bytes
+    nCoinCacheUsage = nTotalCache;
+    LogPrintf("Cache configuration:\n");
+    LogPrintf("* Using %.1fMiB for block index database\n", nBlockTreeDBCache * (1.0 / 1024 / 1024));
+    LogPrintf("* Using %.1fMiB for chain state database\n", nCoinDBCache * (1.0 / 1024 / 1024));
+    if (nAddressIndexCache)
+        LogPrintf("* Using %.1fMiB for address index database\n", nAddressIndexCache * (1.0 / 1024 / 1024));
+    LogPrintf("* Using %.1fMiB for in-memory UTXO set\n", nCoinCacheUsage * (1.0 / 1024 / 1024));
 
     bool fLoaded = false;
     int64_t nStart = GetTimeMillis();
@@ -1452,24 +1497,35 @@ bool AppInit2()
             try {
                 UnloadBlockIndex();
                 delete pcoinsTip;
-                delete pcoinsdbview;
                 delete pcoinscatcher;
+                delete pcoinsWriter;
+                delete pcoinsdbview;
                 delete pblocktree;
                 delete zerocoinDB;
+                delete paddressindex;
                 delete pSporkDB;
 
                 //PIVX specific: zerocoin and spork DB's
                 zerocoinDB = new CZerocoinDB(0, false, fReindex);
                 pSporkDB = new CSporkDB(0, false, false);
+                paddressindex = nAddressIndexCache ? new CAddressIndexDB(nAddressIndexCache, false, fReindex) : NULL;
 
                 pblocktree = new CBlockTreeDB(nBlockTreeDBCache, false, fReindex);
                 pcoinsdbview = new CCoinsViewDB(nCoinDBCache, false, fReindex);
-                pcoinscatcher = new CCoinsViewErrorCatcher(pcoinsdbview);
+                pcoinsWriter = new CCoinsViewBackgroundWriter(pcoinsdbview);
+                pcoinscatcher = new CCoinsViewErrorCatcher(pcoinsWriter);
                 pcoinsTip = new CCoinsViewCache(pcoinscatcher);
 
                 if (fReindex)
                     pblocktree->WriteReindexing(true);
 
+                // Convert a chainstate still in the per-transaction format (resumes an interrupted upgrade)
+                if (!pcoinsdbview->Upgrade()) {
+                    if (ShutdownRequested()) break;
+                    strLoadError = _("Error upgrading chainstate database");
+                    break;
+                }
+
                 // End loop if shutdown was requested
                 if (ShutdownRequested()) break;
 
@@ -1503,10 +1559,6 @@ bool AppInit2()
                     break;
                 }
 
-                // Populate list of invalid/fraudulent outpoints that are banned from the chain
-                invalid_out::LoadOutpoints();
-                invalid_out::LoadSerials();
-
                 // Drop all information from the zerocoinDB and repopulate
                 if (GetBoolArg("-reindexzerocoin", false)) {
                     if (chainActive.Height() > Params().Zerocoin_StartHeight()) {
@@ -1519,6 +1571,12 @@ bool AppInit2()
                     }
                 }
 
+                // Index the known mints and spends in memory, so lookups of unknown ones skip the zerocoinDB
+                if (!zerocoinDB->LoadFilters()) {
+                    strLoadError = _("Error loading zerocoin database");
+                    break;
+                }
+
                 // Wrapped serials inflation check
                 bool reindexDueWrappedSerials = false;
                 bool reindexZerocoin = false;
@@ -1545,14 +1603,29 @@ bool AppInit2()
                 if (reindexDueWrappedSerials)
                     AddWrappedSerialsInflation();
 
-                // Recalculate money supply for blocks that are impacted by accounting issue after zerocoin activation
+                // Recalculate money supply for blocks that are impacted by accounting issue after zerocoin activation.
+                // A recalculation that was interrupted by a shutdown is resumed where it stopped.
+                int nRecalcZPIVHeight = 0;
+                int nRecalcPIVHeight = 0;
+                pblocktree->ReadInt("recalczpivsupply", nRecalcZPIVHeight);
+                pblocktree->ReadInt("recalcpivsupply", nRecalcPIVHeight);
                 if (GetBoolArg("-reindexmoneysupply", false) || reindexZerocoin) {
                     if (chainHeight > Params().Zerocoin_StartHeight()) {
-                        RecalculateZPIVMinted();
-                        RecalculateZPIVSpent();
+                        nRecalcZPIVHeight = Params().Zerocoin_StartHeight();
+                        pblocktree->WriteInt("recalczpivsupply", nRecalcZPIVHeight);
                     }
                     // Recalculate from the zerocoin activation or from scratch.
-                    RecalculatePIVSupply(reindexZerocoin ? Params().Zerocoin_StartHeight() : 1);
+                    nRecalcPIVHeight = reindexZerocoin ? Params().Zerocoin_StartHeight() : 1;
+                    pblocktree->WriteInt("recalcpivsupply", nRecalcPIVHeight);
+                } else if (nRecalcZPIVHeight > 0 || nRecalcPIVHeight > 0) {
+                    LogPrintf("Resuming money supply recalculation (zPIV from %d, PIV from %d)\n", nRecalcZPIVHeight, nRecalcPIVHeight);
+                }
+                if (nRecalcZPIVHeight > 0 && !RecalculateZPIVSupply(nRecalcZPIVHeight, true))
+                    break;
+                if (nRecalcPIVHeight > 0) {
+                    RecalculatePIVSupply(nRecalcPIVHeight, true);
+                    if (ShutdownRequested())
+                        break;
                 }
 
                 // Check Recalculation result
@@ -1817,6 +1890,11 @@ bool AppInit2()
         for (std::string strFile : mapMultiArgs["-loadblock"])
             vImportFiles.push_back(strFile);
     }
+    // Chainstate flushes from here on are written in the background
+    threadGroup.create_thread(boost::bind(&TraceThread<boost::function<void()> >, "coinswrite",
+        boost::function<void()>(boost::bind(&CCoinsViewBackgroundWriter::ThreadWrite, pcoinsWriter))));
+    if (paddressindex)
+        threadGroup.create_thread(boost::bind(&TraceThread<void (*)()>, "addridx", &ThreadAddressIndexSync));
     threadGroup.create_thread(boost::bind(&ThreadImport, vImportFiles));
     if (chainActive.Tip() == NULL) {
         LogPrintf("Waiting for genesis block to be imported...\n");
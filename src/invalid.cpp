@@ -3,88 +3,64 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "invalid.h"
-#include "invalid_outpoints.json.h"
-#include "invalid_serials.json.h"
 
-namespace invalid_out
-{
-    std::set<CBigNum> setInvalidSerials;
-    std::set<COutPoint> setInvalidOutPoints;
+#include <algorithm>
+#include <string.h>
 
-    UniValue read_json(const std::string& jsondata)
-    {
-        UniValue v;
+struct InvalidOutPointSpec {
+    uint8_t txid[32];
+    uint32_t n;
+};
 
-        if (!v.read(jsondata) || !v.isArray())
-        {
-            return UniValue(UniValue::VARR);
-        }
-        return v.get_array();
-    }
-
-    bool LoadOutpoints()
-    {
-        UniValue v = read_json(LoadInvalidOutPoints());
-
-        if (v.empty())
-            return false;
+struct InvalidSerialSpec {
+    uint8_t serial[33];
+};
 
-        for (unsigned int idx = 0; idx < v.size(); idx++) {
-            const UniValue &val = v[idx];
-            const UniValue &o = val.get_obj();
+#include "invalid_tables.h"
 
-            const UniValue &vTxid = find_value(o, "txid");
-            if (!vTxid.isStr())
-                return false;
-
-            uint256 txid = uint256(vTxid.get_str());
-            if (txid == 0)
-                return false;
-
-            const UniValue &vN = find_value(o, "n");
-            if (!vN.isNum())
-                return false;
-
-            auto n = static_cast<uint32_t>(vN.get_int());
-            COutPoint out(txid, n);
-            setInvalidOutPoints.insert(out);
-        }
-        return true;
+namespace invalid_out
+{
+    bool ContainsOutPoint(const COutPoint& out)
+    {
+        auto cmp = [](const InvalidOutPointSpec& spec, const COutPoint& o) {
+            int c = memcmp(spec.txid, o.hash.begin(), sizeof(spec.txid));
+            return c < 0 || (c == 0 && spec.n < o.n);
+        };
+        const InvalidOutPointSpec* pend = std::end(pInvalidOutPoints);
+        const InvalidOutPointSpec* it = std::lower_bound(std::begin(pInvalidOutPoints), pend, out, cmp);
+        return it != pend && it->n == out.n && memcmp(it->txid, out.hash.begin(), sizeof(it->txid)) == 0;
     }
 
-    bool LoadSerials()
+    bool ContainsSerial(const CBigNum& bnSerial)
     {
-        UniValue v = read_json(LoadInvalidSerials());
-
-        if (v.empty())
+        // The table holds the little endian magnitude, which getvch() returns for
+        // positive numbers with at most an extra zero byte for the sign.
+        if (bnSerial <= 0)
             return false;
-
-        for (unsigned int idx = 0; idx < v.size(); idx++) {
-            const UniValue &val = v[idx];
-            const UniValue &o = val.get_obj();
-
-            const UniValue &vSerial = find_value(o, "s");
-            if (!vSerial.isStr())
-                return false;
-
-            CBigNum bnSerial = 0;
-            bnSerial.SetHex(vSerial.get_str());
-            if (bnSerial == 0)
+        std::vector<unsigned char> vch = bnSerial.getvch();
+        InvalidSerialSpec key = {};
+        if (vch.size() > sizeof(key.serial)) {
+            if (vch.size() > sizeof(key.serial) + 1 || vch.back() != 0)
                 return false;
-            setInvalidSerials.insert(bnSerial);
+            vch.pop_back();
         }
+        std::copy(vch.begin(), vch.end(), key.serial);
 
-        return true;
-    }
-
-    bool ContainsOutPoint(const COutPoint& out)
-    {
-        return static_cast<bool>(setInvalidOutPoints.count(out));
+        auto cmp = [](const InvalidSerialSpec& a, const InvalidSerialSpec& b) {
+            return memcmp(a.serial, b.serial, sizeof(a.serial)) < 0;
+        };
+        return std::binary_search(std::begin(pInvalidSerials), std::end(pInvalidSerials), key, cmp);
     }
 
-    bool ContainsSerial(const CBigNum& bnSerial)
+    std::vector<COutPoint> GetOutPoints()
     {
-        return static_cast<bool>(setInvalidSerials.count(bnSerial));
+        std::vector<COutPoint> vOutPoints;
+        vOutPoints.reserve(std::end(pInvalidOutPoints) - std::begin(pInvalidOutPoints));
+        for (const InvalidOutPointSpec& spec : pInvalidOutPoints) {
+            uint256 txid;
+            memcpy(txid.begin(), spec.txid, sizeof(spec.txid));
+            vOutPoints.emplace_back(txid, spec.n);
+        }
+        return vOutPoints;
     }
 }
-
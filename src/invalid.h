@@ -5,21 +5,16 @@
 #ifndef PIVX_INVALID_H
 #define PIVX_INVALID_H
 
-#endif //PIVX_INVALID_H
-
 #include <libzerocoin/bignum.h>
-#include <univalue/include/univalue.h>
 #include <primitives/transaction.h>
 
+#include <vector>
+
 namespace invalid_out
 {
-    extern std::set<CBigNum> setInvalidSerials;
-    extern std::set<COutPoint> setInvalidOutPoints;
-
-    UniValue read_json(const std::string& jsondata);
-
     bool ContainsOutPoint(const COutPoint& out);
     bool ContainsSerial(const CBigNum& bnSerial);
-    bool LoadOutpoints();
-    bool LoadSerials();
-}
\ No newline at end of file
+    std::vector<COutPoint> GetOutPoints();
+}
+
+#endif //PIVX_INVALID_H
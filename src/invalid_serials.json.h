@@ -1,1192 +0,0 @@
-// Copyright (c) 2018 The PIVX developers
-// Distributed under the MIT software license, see the accompanying
-// file COPYING or http://www.opensource.org/licenses/mit-license.php.
-
-
-
-#ifndef PIVX_INVALID_SERIALS_JSON_H
-#define PIVX_INVALID_SERIALS_JSON_H
-
-#include <string>
-
-std::string LoadInvalidSerials()
-{
-    std::string str = "[\n"
-            "  {\n"
-            "    \"s\": \"c9c868bb56eacfc4f3d829528a0ae812dff26619cd38e6c9a0eea1eacddc84\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"17ab90c682a42d7a3b8bd1da019f6e788e82f25220a1cdaca242f15873ee553\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1aca2f77af39229578b4093855278a20569ae7ea81eeda1263eac8c2cc9fcf7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4f3e09eab1981c715af9ec05d9c13bef831501250dbdd477c429329e837abf1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"62c55983e9c14261f52eb6c22a154ea0e1534a938ce97ab17d5d057bbda7d2d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"7075dcfbbcc32b6a871244635155b4f0a95146d7c0171c4eb5667120ab4d173\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"7395cc3cc468e7e7c81f254fedfcc800089846f3eb34c9ba7846e8464396848\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"7f7006bd50e72da2baaf386ac27e622b9872e696860322c8b8383d86049a9de\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"801ac2f210fc601a7d200c361b79bb35ce195850e37c3e09d21e24d29b34b6c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"92b39170c2f2c05ec3260d39f5c66b068a588680ef3b7b0a2a06b63ee60f46d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"998a1079510f721ffcb2e15edcccf0df6d2d7febc26a1423aef0428967372e4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9bbb102e23ffc1d462f96613ea655f4c4a90040bbf83e01783efe99f8f92eb7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9fc4091d1d955e68118195b8c3f354a635719cc702c62757d47512179f10197\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a4f26c6962f2165ab31d746046ba6fb14eedcce9d40ad49b4d8ec5a59651767\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a5fe1c2dbfd3bcf54275ac8318c1d97892fd018b77d8480c4eda6d54c8f4b0e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"aaa7b123505df20ee582ee5af50c4b10b970e857322eaa5ff344806680e5ab3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e0ad6aca02b6723b3b8d579bb36cea47734d65b20f2209db8a6882cf484beb0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ec29d90e8a354484d995e80b61b87a35064b3c911904d81713bdbf5edb4acf5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f0dd05b9cd83f5da08f4af4acddd6ff40580e2b2056bad1937567a54e883cbb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"115dec262441fda7533074b4bc0158b65bcf9d1a9a8ba5f76106e51700ccc975\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"149341097087dea918d8102f82c3740e1b55030a6a785cc0231fdd4e4d0f03c5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"150f493cf5be73b78252344d27d1c7f2b45d7b3b6302a840d0031b3e1b6d2b78\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15e18c83e0343031d2c69383c01508e763629fc68783b2cb3d470726773c407c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1824f506e590ce050e02a24af12d621684666b88da74a33bfc3ae19d92c0b093\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1a53f51c8a5a941e7c69ef8a7721cd686fc7dd4faabf9b70041c906a4f4833a0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1befaae308e2a712277495fbb40c32c4d8ce9233ca39e01236635ee985971adb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1ca4f1d724d87eb09230dee2a2dc1ca50b2a1669e82ffe933b347c2f227aab47\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1dbdbc8cf8b1f9bd367856162d8a53e379fac2487ae81553d5238c0ddb8c252f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1eac21f759996dd4817aa17821b48e3bbe963ea611ace0861469b2416f42adb7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1ef8dc687ffe2b2a9ad35453df4e383ab66d3f2c12dd8b46ed2a3cbfa7c67fc7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1f2627c45af257b8be9cd97b8fc9e1d7f603df78d83c0599e9e72ba784b378ce\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"206dbc1d0a1f4e180be5a0635e0ea4db27a248e520e1475b44f27d43b1b211d9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"23a277496c18e89fdfa16dd0add57e3d629a9043b44a00a2606bb624e71480cb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"24d23fb6bfb1ee09974afb8ef5dc3490e4dbafe8af94033b88593fbcaf7edccb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"26116f90dd5d5d378ef831b6cb6c8fab730009a7dd41e7508f454e978782faca\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"26e7af28b1c1434bc940931e3b702d3149e33193dcef4004a4b1bbd5a639b605\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"274cd2190936b541d92743221c9ba4c613175f112d52abf91ef2ce53002614f3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2776d35d90167cfec476f435106faa91490c0b9fae26c4a8ecd3a0789942818b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"27d5123ce3c8ab80827632a3a95487cac4e6355bc08ad66c686e48eb182cafbe\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"280114e59e04406a49d399b7dec260836868bd8f0e9aa81c89b5ec23d00bab78\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2809dc8b2f97cc1b96dc2b426bd26d2eff948f4637167268bf235db932c706c2\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"28453be8fbb70c19f9818fdee57b5370cfcfa225dd8416c6535efad9ea0e5c0d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"29353340841fc5e9b613c9365d3dd48fa32bbb6342c19aa3eb6b0e2acf5d4934\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2b294dfe32fe935c5d97f181b0b9bd37c52692aebabbe276c5bdb3e40acd73b5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2b9877df96ce356eeba1a17f40fec1a0fc88c11df47d8cb583f8fe1e32b90772\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2d4640795df9c9b7f31891e3b980763e004781112a9ff39cefa155d394e430dd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2d822bbad09965a6e0dcd790f99ef3c1d32edc70130b7b320efe025107c1112a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2e4d7765d98b3b1b832eda1e22f63c8d98b6f85dff35dca8f0070841d57d10b9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"2fbcfe92669d6a7b7ddef37fb1f26119465972454f291390e0e7baccc80c9b39\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"30adc0e598fbbd407c0c7e0beda7c71b03d94e16b9436a5b44229f9e9943860d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"30c3cfffedc601c0da0d1d7410094db0653bc9c444609709cb82bd790bfea502\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"32b72acb884c9577e9c9f44b22e97b02b6441cf8acdfad80dbb09ccc8d653fa1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"33ebbad0c298933362ae0a386945fd4a87da776173aa2264eb3742804d868e0a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"36326e3d2e11e23f8d26dde51da07c09a2027b86c0dc0aca3d7ba66bc7d996fa\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"36f6249fd8228139e0de2caa33998d1f1f9a90202cc921cc187ad4b2c71f24f7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"37e0a27f70b19335723da1bd545fc3ffe43094ec4df736beafb87f1cb1b8defa\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"384f72cabe2ec5648c34eae679021e0e34579ad9100fe1e9075bd120939671a9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3bb0ee91b2d5346b8050b2e0bb2beab08ea11e53c1b03629e03ffa9f8f785547\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3c52a9a893cd868241b005518faa0813042efbd4e116a4479a628a9a1abdef10\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3d3d24ae893c6ce383c0bf4e8ee8bfd58c3928d5a912c5a98b5d79694529daf5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3e767e84a99fff69dac06f4958b4399754b0d9d60faaff4e79a946b24e4205d3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3ebd51ca9d0bfc09912caf90df75d9c4b89867a4eb993fadb3286a200f9c3b76\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3f6725381d45416203cd50e6b85523cdf813bc7d8d11fd502e01ce984a571dfb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"3fb4c149548816333378015629abcb8c5c286f0ae7ab5c47b08e34b4645c557b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"41838844b681337b2fcbcd1bdfe33fe14e9d6f4b9608de7c60f8f83f951d079f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"448caf70fe54fee7b6057557c54ad653a2684322fbb3c6551c860ad6779785f3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"44b98adcada8f4bd05902aa1e63f4ae45c1f44a39dddbf25c49eba983ab65178\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"45de6b65065e6b14ef821fb37968b57af716ea2f96f60bdc07cc9f0f588c60f7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4671127a7635ce22d403d1a396a7c8565f5ff3656b49913d916dad7e951266f5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"47d36daae743920ea121ec89dd43f0034e84a8e28340ee7d255768879f21be0f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"47eb13447a36b9abee1c1a129e5fa15ebe76bcc737a02f4168bf1ae1921c22ce\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"499524459a9bd481194523d76ad6041c2db1ed80b063d3cccd9b29a07fecaace\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4ae33104e2f8688fcf5917bac70d32ccc89d84b3f40c7ea3475c754087df25cd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4b5ad8a17a06e87a242b85f69f6b65d6ef04264a439fc9d3e1aeffe3acaeefb8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4bb7ce3dc21531bee4d658c41f7e7641d90455d2c5b8d9324512b30e0cf8f8fa\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4cceca269074024d60086a6175172f5235083dd6173c9f8e9fcb26daac5c0010\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4d06a8164d290e101173fcbb054e6a8f4f964bb251f1406cc11b75569d747819\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"4ed88b07f3d519d60ee38549c9688e8b17f18c39bb48aca82bf5643559b1c0cb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5115cd14bbb0b65abc6779eaafb6f3945f6d449e9ec509bc1981a332343e0911\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"516bf9c9afd37f7e397e7e2acbcf7b6671d571e2dd8c9a2d37c9ab9809844e04\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"51ce13819aa5a747572fef35704e8a46227ccf430237c5e68022f43fb1e00c4f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5462f25f65f5a5dd8f8d09c7b1b9093b7e8a63f5b585cad11c40ace5d8288a5b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5586f27ba8cd3b91beec47524782fe61cdd949e5a14f049bec16bb929442f270\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"595c00ad177207c061d35ba757430421c29ac5103f1b31ff57fd682153603b03\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5ae0656fe7b833ec250118f23528ccb95524179b99751fa25b4fdd0e049730be\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5b740b17cad4ca33e59b53ef26f596ecf04d836614e2dce891a7b8a159bca239\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5c879aab4c0fd6de9945a643bbf88ad5d826499c7772c6a3889bc660bdb477ed\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5cdcfeba8c5946a18a6d44a513be441096517730914a3171e36043ecaba37bbb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5d0d85914902094a48cf1514a74bc3e347b00b72f371cbc6a4e25c629f5ef18e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5db8cee927f751865ab4bb90c79843373a2433d44f842ea4eae9e31a4c44a664\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5e16b125f9330714616e3381dfcf513edd784d556211ffe27e85b4b3b34e1e2e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5e60f377c0ddadb7f2e382c131701ccd903d014950452275ccd4452b574f298c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"5e8eb125709680f6699af55cdb2f2fbf56519854ee68d6787db46c53f81b86f5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"603d3c862f457f71e5847a62897fa63dcd8e2db9ec16bce1d38513fcd01ede5e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6151e99e99234ece546b3a1fb3ab050a3b1bde28a2eef3b54d31ac31d5cd8852\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"616e844c5f9ea004f38a8195ca5f3853695895507997ac17ebdd5c842196c416\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6348f92e233d0927958827e65798d6e5f3fc97edfd3a350cb075693bf0ccaf01\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"63a12c7d5c53716dd895e3561960dfbf90e060c3df1ce42f11a7ae5a1a921a7d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"63aabe87ab73828f9a9e099f6706fa04af6570fc70bd6f39fb1b2aeb2a073d6f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"64b4cf57c4c98011d2ab2c3f7adec3950e1162735aabbcf158cfa5dff2d0e6b6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"64f641e2b08ee2655e742ba13a9287a925d021aa6e07e21df07d7e8dfbf377fb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"65557ff0516c0ae27c567cd16f18ce04af1183bf6aca068799c089c0a6264bf0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6571480163823be7a53b57f2053e54b68afb202e3f105e1acdcbe68a5660323f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"662244aca40908699eede8081e5d8a831fb139ebd27c0cd16db636cd49fc52dd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"675eca33353c3ebf08dbe1429245d9711d3caf99d97f7aa671a73cd2e24fa409\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"685aec4107566303f0803eb2c802a32cb4fbf695b73c09850315d977c3f678c1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6bbcd96a09ebb08f4b3433f93a294e802140f5a32983259ff1f16eb16e437fac\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6cd6ff447b8a723eca481a8c7149ace94b8981e7bedf4c275a097e3e28b13845\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6d5289f5b37cfefb5d2fcb204738a4a1418eaa1d70181c00ca71ebdd4d84eeb4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6ea031945b9ae626eaa0768a5745478682abc63cb6b0d3fd30b14b72be4b1eaf\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"6f7e233d3e1d33a5aaa609659c31ba33e4b3645c555c618407702bc7fa1a4853\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"70d0ec8d4c09c35c1bebc165a3ba6e33e9d8cd7c2ea16d6383f7a07b15cb96e6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"725c8f289b804d2e4db2b840b01059e4bb1d856c8c19d616a9c88842cf26f9f0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"72bed6a3a9998190d972ca56a647a4c6ede833ab393ec4a74bef22363fee104a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"72e62055964e78e6ae63f3e3a8daaa08fbee713ad3cc6f59e7a4532b79539505\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"73147455370562f28ad019dedbe5101794faad50b5cff82a2588541041e0adb6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"73ebf3d966af3d028e004ab7caa54ec6c849afb49f3ba994629e1358fb1ea4b3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"75498f3a34ca40023269738d6805c1019b4994cd0d0018e56c831f50634ad98c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"77240e9747f8290558c545ac4b92c3a3e6d08d088b6c6538498f558bc379f625\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"77c007f951781ec6646009c4710c26f43a6bc2c75e48b353bb72df98b80b11b2\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"77fd2e9aeacd7c1871b213443efa6bb72b8ca5be379b6c750fba29a115a9fe19\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"78052fda3fe229733e158f7862dd7506a3ecbaf3071d9b5e68a98f8215b9cc10\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"79d5fb604c31b4416dd42835dbb8169efd489ed7b2571cd3d67948c8b14ddbad\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"7e734f66c5f658296c7767ed5ef4bca128dbba954b1ab75d85ff1fa736c690c8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"80d4460423b6f3cd2b6650f65b991e4d70386fe13a8a3a7d69acfc6ea680aec3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"82906865f4988371335760918cb39913b55d28bbe0c6517ccf6c1336795023f7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"82acfa93d01e96295cf4b30b6338b71a853e8dcbca5c033b5478c9bee8ac6372\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"84e647da5fe6386cf1429db6a3b5086217208a9edadc3910a0f9a22a099e1ef4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"851fe306d60566eeebd2e14bbb3b96d63c0a2bc19e0fca76e91edc52b455df9b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"875213f74d5b29ac443bfebaed0cb0276c0d21158d203a15a9062495b659e57f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"877e1a18dc2818c6e989934ac7785bb21a9d6f292160a4e936d97d9dea1c70d1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"87f4a792f5ded2e4c9bd9ad6901023ba0f7850be46f5fecab814e2f98fcbc937\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"895f69760174853b31478fb13b209f68cdf01619bb1a1c298fa42474a6f46958\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"8c3445af38857b1aac0ba9baace41eddd1bb2fe2b2510c8a84fc6c05390e314c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"8eb300cafc341f8b94e782101e3d4d1d627b2fd79491d67c59c6ced7ebe981d8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"8efc96414420a1b573e8e26a9c74d2c91f95efa95474a9978f936c555b4c6910\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"8eff9382bd058f384065a050f1d3b11c425f4770d2b455fdc20260e349889966\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"8f1e646d9e4a6e3f840e9bf385aa285db59ab5818324af508b08fd1dd32821d3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"8f9981325570929add0679b4c5e12d43c39fa5cfde580f386dead299726b5d10\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"901530f89980abef9bb17b45e52f5ad7d19525a1194c389bebf8c83a7ee768f2\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"90fd5408d8693ad1c6b17b45bd23147eed44d906df97a8b06a8e30c91e35a96a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9155b6c1fa4c4acb6618e32c10b873adbb7d99cd8d8abd50b493ad1076a12e92\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"91bdf0b8cbac56ed4199f15aec8411b5807cab4aea93ff49609a12eae52b20d6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"923c11ca96d6bee39a6c14de3321909eb134337616bcca26d6b5e1f464c53367\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"92c112c43504ad27ae45fd19520c9441194fe9007ab5fb6f768ebcf170e8bec4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"962a2f4f6b85ce22ca8bf0326e43a2991f75cbc8ead7d9a404bf964b24376143\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"96bac7c9fddbeb404f505c392a9f8c0ff085de03756b9e789f6f7629d95c4a48\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"97da82393142a7b7c0037854fe26460b829ba767b65d1fa027a5847be19451de\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"99607a75ff5451beb8c7f1f68a12f7948f43e71f958df270dc13b06656360389\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"99f7f18cee159c64f9a68fb4bb4a6d8d0cd76a504ce0fcd69c3fa1da216cb274\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9ad31ea8df8626855664cd99eeeb77d2fe786167eddc313ac3984aec79013c27\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9b36d1ce6ef2ff08a79b5027561583e222141622521be8b84244161ff70ad0d5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9c03332c6a46f1715067adf0f0bca51b036526af7ae6b8f0431403d739eb2e2b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9cd41db3d347f278e223c54a2433895c4d805753f3f0d1d03af8fa7daf16d07b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9cf99eeb4690b3b4d92d87dafab8cf442e888ccd2896ce508625c86ff65cc6c9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"9e1ca93326c00bab6fe4b21f425928fa3f44d5623c54c9c6dd7ddb08823ad84d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a0737c11c43ccb5ad12869ab78970ab27cb346b39b973888e88c89d1c097c18c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a12cc8b123f03ce76883bae2e925009aa41f948a2670c36826760adcd11a7327\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a16f6aca4f7c26f004c0f0956b746c12e627e9b42cc85c4288390b8b074b01fd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a435f2e742de70066a1819f624f6fdeff5faf36c8ee6ed67173577a9551bf2d4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a956c9e1efac7f1326ec5b8275d8c52162d070cfd578f28a2b5023744acfbd1b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"a9f61da6729a0803acc9181cf667bf75e5e6936f076aedfa73e9918be6ab807c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ab99ca019c5f24e1730c4bac043700332bc6eafefb873557d0b587c2f17f1686\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"aba262178dd5c21f9070f48b078a47d099fb7e319b612ba78e626cbd7b42944a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"acb20da730190d69a0b18d32ea5dd10a23c73d645228223ae6ee13749b24de1d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ad6bf7a1620c0e7affbd3fcd0b090ab226240d603f5276541006c4cc0c7f4afb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"aebdcce0db51b47da1d25e6735fe18fe8882ba76b186dc152ac47ed47c496ea4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b1035d369a22885c8437999e5f2fe3893b62948c420f2b891057dd83eda08b84\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b2ef15f316d151640e03c78e936042e79e95788fe5ad704b16c283ee01a262d7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b34a7dc6efd04a1661b553f11c5852921f9d735696fb9ab83ad4a05698435f17\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b3ecd3f7c2807058647131b2293fdfa6401d39559d61e300d4466be020bc6cb6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b499f298f138aad71fd7e1c8e9e0dc29078e72e550c1d4d762aefd2df119c4ee\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b56bb873e4dfe65bcc577d556e9855acce5259192f44da85f532e326a4021be0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b5a0eef68c172b7550f39f1b28ad55baf276ea73f434131ba8a4b10df80e6419\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b652afc4705436e3b2d7309853ae57a9ff813f903e628a3441972f9f794675f9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b68b1b3e7f319f890245984c59b63b0fe91fcdafff76087531aa676b6fd8d1f2\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b696d3f8b7985d9e5999cdc8888fec2a74d9ca1570bda93b67139f5da2a0f071\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b88649d422a39be2772f51ae7ecd5c9faed47a47c6ad082c26ac3ed119649946\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"b9d78a2580d588439e70445dcce3f80157a2a3f56cd0aff291d4a4d368e02bea\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ba5fbd2fb3505693b01698e772ca4fa6eb7061ad053e92f5bf2010b4d666eb08\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"bc3960393ca02ff2cee222c74a45ab3efe562134fd752b1e07892d728fa6e0ec\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"bd8cb2973fdd456c0a74130a9b03e9eeb726e624e7b5f7d557050947aeef4dfe\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"bda28351a208b39cecb387bb4a8671383933903461fb65ba746e64ddd0ef9e7b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"be1ffd893a3570579f98f31b0ec77e86b9b530553baf149f6bc0a8f48a4b8005\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"be58e559a5db6c755b71d2245204dd7e2ca4b837548b7a3204a56f4b004444fe\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c1ced7a4a739960663a5afb7207eb90c8cf07021455f2da6b8f4fbca890fe358\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c68cc01fcab3f41d17e79886e1f3871827aae3e0f9f4c86bae22e9af2d3c8489\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c72ab51324754a4aa84148862b435fcfc77dac135740c3c6857f7b2fba04b781\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c73e72505fa96c333e42c34f8dd8a63b8df15f9c363adc2f22e6fa9a5615822d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c7745fb347f95e7aca5ef5e962da1191a365ef3bb9613dbd4a71f059daa763cb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c90233f1164b6b7628c9cea9affc2fd0937302e78806054cf0549c25878383dd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"c9b24f371005cbd97852e6bf237d315027d2f898a64c3d2a7fc7c4850dfd591b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ca3a1bb927fa2371ed11d34f6f8033544e191a63650cc7e38638f61097e4b767\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ca8a0048323989a3fc65fa8387c5443c5d219e7ecd9db7341f12fb8983222f6a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"cb697a1ab429e78a1d844d182f9e6ec0e103f015a2390c70efd93d14a5a89e34\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ce1670a1289d044152e94af5df2d25e8ade43f1b28a9b2e4f08731c68b87af57\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"cec76144d5705c4931ae2fea2cbd11e823ec7bda30e696d8f10a723a27f8b826\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"cef94b2fe839ab9ae580b36011f593a2a06dfb33b6fb679f4d24efb0cd83cfca\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d24088d7185f9b38a3a5118cea3f2ebf93359cc75fb85745a328d64e88f17ec4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d378fdd0abe22d97ad485e38af446feaa919815e47ab11a93ebc137c5c945000\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d454060829124c2836669712c1b8764fa59961228addebc3123caa36ab6ea446\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d48604fc398ca7f00a7765218b82e7809b8dd1244d8fc699ce6ab1a904f33b1b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d543a8a442548c4bb9a0665338cb0123548b7b1e773cac2ab269c6fd01037cb1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d54e54678e55df7335c7738fee5ab6b3f7e5e23a1d143ddec4082571ca6d1e3f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d677e14f797545777a27d3a02bff81b103a9d51d1dd031aec986ae888f1ac740\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d6e54940025710938dc0a0e27a6fea0e91d724b3cb031b4061d5474d372d45b7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d708593b4f86158ed425092dcb4970f55fad4cf5cad4b7ff9f2541be99b3018a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d748e8ca3f1f6f580f0d8c2818e2504afe5b66817f08dc73a42d94461aaad46a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d79bceff03753ad739274a12910ec1fbaff32983ac1d2747dbbf2f7efa1eea3a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d7ac89fb49435540e21ccd94be2f389824341ccdc659fe7eebd3e9f9ed491de1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"d7f7234aa24bf8927c4da1b23bf3dfb1a69b5b3a81ff64a4261a8b2b08c82d86\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"db577ee50d71809541ae484647d9e9a5123923102fce9a9bdf8ccb51953e9183\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"dc0f45c955e96db9db8ed14d42bea2a3eb69007e206cc77f98221f1a8e6e7fc8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"dc5a78940a1e58cf2e84bdc13980f1ffdb5c5ae02f3334cfba5baac9ef420f8e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"deaa945e91881718e125e78148a473b6f6d3e9cfa9681ff587ed283ba1869c48\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e1dfe941ddcdf81aa6cd82fc0f668f0eb6594fbf7954d6be4a062072edc8d698\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e25bf17563048d291047a719b474e2f34f61c7f071df223ef6e95e62bc26fe4b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e32e34bc4d7a49a360bc06504cb823e7fe66ec7b96602cc9642d4a4b17f6134f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e5719d3f52d6e7769bf815177dd07d171f6ab83de9511d3a232124c2337a8366\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e7a09d54f7a0ad900a5f625703c4e8690acc2a04b99c156e2b02d38ef0020673\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e93c531b7628c083b56a08c840af4dc573d2dee8d9165a105d49a20e2650edae\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"e9f19a0f921e9822202651af2f7f37a5a62e631ef70c7891621abf53c3347e1a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"eb0a64c565f8132ec46dc8e2ba2d6ee414ff0efd89c48f51fc09cf327c45f802\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ebf8ca2fc6df87460f701444ae57a93c599a8b5b20895a843b4ff5660ffc808a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ec4584a0ed44449c28c8c7206bf1533b51718be121ba054514107fe44880529a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"ec72cffcc838712a4c924c481c6cfcd891082c2de7187f9810cd6ecc256d4ba1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"edba64557765678999db132feab1bfdbc2a6959a2fbdc1596bd8c068526be4ac\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f0ef1f81d95f02116d96e09d3a78993dfd9edcf8c3267aa08751f94987ce539e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f21ee7ef2cf8077b25406e5b827f4f917fdffc9dbe707d39af3f82e15038af9e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f35e17c94aa376a91ceda483580faaac0e04565cec1e614eb62b91bc283ccd9d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f43457611f075cbd573605eac8134831e4e77e48ebcbba02cb97fefa46f388d8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f4997a51767cceb3671cb5eea93ebfc6ae1babc63c2f25f745d91177a0dfe7c6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f4c37b95fd5c9670526c67019d12c591e4105854bd033ea713b9e39d39fc545e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f521ba75510ec4f2106ba57035f7a2cb5fea8210cf67506a8f548c0fb8e68291\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f54dbd1e0b4a59dbd7c90c846b657b84036d0a441d77221ab09c2f4870c57e4b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f55684c39cdde58d24d19e0ef875882f9a98dbfb45f2ec66e609a0ddd380d995\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f591e42168fd258b877702ab721e6e716ad3eedaec6090c47a453dfe8ac82ee0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f681db78f165df5b44093c02e9e0ef903e300818519e14a21251514f70171c07\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f875f636a044accdeb8d644e3d5cd838602adf63c9985c74eca3f708ab874688\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"f8e5201804144ee07997144bcda1dca1978d0dd3035a06b3aadf4142d372da45\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"fa92e8b1cb3fe329810e04b04623913e9b4bcdc6397c6d9b168798f8359e03b0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"faced3f33ddf7f186ed24a5d86420ec26e33292521e7f53035e44575a87ae3fd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"fb9a1f9e46d1548d11244ceaaf99578e33bb45130e1256a716ed4b667636e38c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"fd09a6cad3e383ed0bd4664c3e957c19e15dbefa5e058d8f07cdfdf168c66e0c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"fdfa691e0641d6b20a01f0d87a4ae21b9edd9acbc81fe4596b08e2c339fd58e0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"fe1078385b0c1b32680290409cac68b100401679533d1107f269009dacb877d5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10003d303f592aee977bf6717af8c9603514869adbbbc277f0296dff12e1f1274\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1013863092fdeaca4f0a37d04f5e9184b22dec41682869c63121d85a4ee4060dd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1037f16759b57fbb11b1c50b1aa43970a3d06c83bcfb884c86461e990689369cd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10442ccd845689aab6ed39f76c03ca81fba9edcd53ba59bca3f6117d767d8f7ca\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1052d4ab7ddf7aca700331489e102df007f34e1a15cd3b0bcd69ec2415272b1cd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1059c1b032b74ded61a2a5db305a5390ecf5be78e1eec5be72e4214453450447c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"108fd96ca201b4ddd0e4625ad47cf05b129a56b08d08cb02807263dc43032281a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1099f51e101139ff3cfa5781e1c4d23139f334889eff31e45c148cdbebb77c1e3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10a89cce6f682865511b6321b1b8bdad6273d758ab7ef3fa7b243bc8de5e3adc8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10bc326bd16e618db68b5e215e5575497efb5268b1e87794ca08f89d6eefbd8a6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10c09fa030a52157b1f22225d6c18f4c5539cb459fa75b9abda0ead44b0560e49\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10cb3cd708a8b5ad391c2c3b344f83ece931809329bee774e54e811bceb10f0ce\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10d016981c1ce2fa4c16d7422b64ee68cf72cbbbff687d645d77477d90516284e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"10ed0307d23c74cecbdc13fe86c865ae1e9a1bc00a4e5587a87df3b6435d6da72\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"111d957a96b9b185943fae82451edf1543d6c8fd80a904053436c4dfb185158c6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1120633151aef0e2e93859d6e72e265e4f7239158acba3923eb84fdbcdb70244b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1132b139d73a484867d779280060bd07b921b36e4a5d285da2eb2e233f94633ca\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"113bdbab2e37be79461f94470234ae356fa64401a7a260b3bb853f0a335cc39c8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1152015e35489ab802f175f5669e70b03e988f597921d687b4c3dabac3fdb90e2\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11537bb7ce77cd31d7c118cdf2b02bc5f597b097c467ca93f8fa55e0632d5f5a1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"116e1cc7e07e1edf2a73a96a3f7791f1cc8b63a35bf404dcaf4816cc520a67da1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1182fd93d503e82015d4e8a8753b04dcd63a1d16902e8f8a16e42b8652898f8a0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"118a780d9e74d01ebb220f8c32c0e80d78a0872ff527c43d2089543084d68c28b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1190476762f5b4b3072cbcb90ac2191427408a287d49553306bf8f632adb2cbcd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11a1b725efdba1bbeedfddd2e01ba4a52d00c8a8b2619198cc6b169ff4d15d2e3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11a53504eba6f27819f696f8791f1858fea9a986760cdba6ae801b87b3e2e4aec\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11c253340611b33479cd8f816560ba98bb2f5d8eeca2526a652dba759fa6b939e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11e62754d28f6cfcc4a5cecb73c5a0e94fa719153ada183ba4067e656d4f7dbe4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11eb8a2021d1998efc773f0f7587296670cd9be97ec69142b5eafeebcaa3e20d7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"11f1abbba07ebc0b8e5256201fcf1a546bd811bf811143fe4a70937645299df22\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"121af9a97d33bbf4f1d827c943e5c243c198eb0aac46244cf4326f00a78e25d2e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"122d39ab4161355034ce1ba1ed426196268dd969ab02b7e9a12fcfeb734fcc543\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"126a8a8e584b82131efc8ce73e3e61f225d9f11c54df7abfd7ee3ab45f41a0dd6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1282d0da854fe4d5db2f68bbec1cbe7b9f0286450a85199a082362032a5510391\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"128c0b350381ae3a57390c6bbb398b1ed8b51d01b23bf56e6b88dfbc5fa76750c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"129d442e3b955f050273b1910489ba5d6732a9651864f40a1af8209855e6e4ac0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12a29a6f2f99f60131862b771a0615f113155c3e5a026ab700a4687114c5d4e8e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12a5a2dc9b64822bbd6c487e133eedee3e2b45828024e45c4cbc89f874018c461\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12b057721953d6af7e8aa2e5d543b5e37d52880895e60a8a311d0263eecfe7937\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12b63595e66792085ef63a64e6c726c3f787c9a0a70ee79e0a56bf7d85407f101\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12bad9bb02e23c72980d8f58dbe1337ce2b414dfe5f219c73f3ba884ff808fc5f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12bdb595ddddc9a67f790682967d24abff155e509fd455076a49aaf7898d559c8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12d89e4be9c8b98e37379ed2f1622c13e68927a6efaf336dffa6b572170d8b131\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12e9e91d70669683fe260acec404e200ad6202addb1cb6db37417ef5676875b25\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"12ebb2c84cce4b976817ff46257025354045ce2058874261612c39fa8c25096e9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13095a16690832299237d9ab2e43bf1e68f00e4a30c16af0ad75bac60918681d4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"130edd4b5c9998adf668b5622a603fac02be4ad78edf95e2d388df17ebb4bed50\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"130f766c018b99c0128937c6bf3aa15054a69bdb17f99e93822016e0fcac11042\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"132017790320f998360a09f0c0781de95a915af28698836ef7fb5e904938ab989\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13242ea1b1dd4fbd6ec699e6dc735a2a9c0d46e5f7ce45c1c1763c1b29cad4ace\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"132a22828beb224540a4bef9dfbbbe9054a15d07479a68085c0a6cce546e01ec3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"132bdf039d0c855593330cabe91e16fb725ff6ce34decd818f4b229aef71a0512\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1336eece5114f21db2ce35ad4ab00a583bab586a0e15886cf949c79f1eab625b0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"134ab726ba282583096d1540f1ee8f471b840fc4ee85bf4a4988d7ff7830976dc\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"135a79479749c7c757e75b17f54a5be2d5000434ac618838329fc1c9c64b04b94\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1390981a27731ca00d929a6c5c6cc6980bc454258385f9f9e18d7b1d60efd527f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13a23a77ce8d08bb0583d8d58fdecc7e9e68dce9ccdbbc62580efc162c96b0b18\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13a9f322e20c3186ceb253decd3dbbfa1dc92f6d27ef495fef1582f01ee3ec187\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13becd9ccc8e0ff987895e956e3e862871db012f1c58d4dfb57978e975f04f182\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13ccacb75ab634d17389b7c3228d4d5347fb7b1116438db822e566eec9ad41b26\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13e1d94c5b94fdccda9e13432305d893484dd1a313d7de761aadde39fb68569b9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"13fa9376108c6669fdba82b0d3cb374e55621d2219af65014d0aecb676fe0ccc3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1400b7edc16df9b0267683d2332eabfc788ec8060481b3ea572d5655ae0a7e31d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14032c88e039492583c5966b0357dc50996f2bdefe2a8e9580e8a96501a0d67d8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"140611c8da44b7c6418c58cab68882b182ffefa05c4ac72284c6e9734e29a8089\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"141389c11d3f556741bf5bd84574869c7634dfc69ae1823928984567d9bd87786\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"142963772a2105973c05ee659f4a8dc02364de1821bdc92e3936962750404ac5f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14470b6cfb53e4276e6bab878d835dea481d4d9bd9a48df36707598b06433c8f8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1450cb031bebe3837f2557c90fdaf41f4d5700f7c6d252d51e25922bd58c4e485\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14549d6d358139589ffa78610cb9d86b7c690f2734677e67336a06cc5b663d0ec\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14551d812ad2842e4cc0b0244ef8090073ef107a815fa155c8f8fd2a6b6739ee3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14722a398b977cdb2fbc99b02685b319f984ceb8cc13396d1fd5f8bed5207ae80\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14bbff79f333c719afa6cdab9eb97d7a1c3e0074a59f7315bace562cbd780639b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14e20ee3c90fd0d3eb95bc3c2e83c394e0b3cbc964966b47b90933f93473a8196\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14fdd109e61de9ce2c14cd35e1956b41450617570efa2cb7af652565b1a09f6ca\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"14ff9a2cc3d64af9aeaea25d7efdbd21b2042da80d9387d397b5f0ce389663645\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15232f012cd2c51de7f38108330582362b224d753e9b8b30ec7dfe54eaa57f1c7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1526c8b3f434b806079c8541847deb1d6d70e7876acec447510051f77550fb26e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1549ebc2fbaa1431dd231718779afcb2807116dca9bfcb413cfec67ba5713b852\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"154cac251496e3238777f0617541b76b2b5a1bbde303d1ee75dbfc0c28ad643a4\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"155414fcb6324ec5657b30da31cb33ebaaa7c9d7355d278c8defb261e30859c0a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"156ac11ae6eba9eacbf3d027dc7c3ba6968f462cec9f69627b68a679947ae3c2b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15980ede7a5cb948c3a011c87398739de6cbf7c97c12d8688abe2af29d9c8041f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15bffa903697a38fd22dcf4dcaae0681dfd7f7c8ca36e507a80ad11fc8ca354ab\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15c493e79b166bb2701de55372917edc9ba9a3c5e63512395b679af79fc063be3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15c4c3bbb2a4ba8a9ce5b131d7e76cc1cdd639425e190cffbe8e8a407ea426c39\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15c6b0ca60b9087b112040ec0124d435e509f02369201294eb1ef404273e1f4a6\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15ce6296ac2b6ac0c6afbec81528448445ea3f284ed34893694d115be13252fe3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15d61d93106c6c56129a6ee1271d275d86c9972562828b29a12df0b5f1fa13bc5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15e49fc4145af544354a6ee1249c62f7f884925bbee7422ae917473edbeef7c3d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15ea25efa6792643cf40e55f89d5b8eae5681e6829c67374edb79f035175b0165\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15f0a98f138f2705ecf8f642779272cb61b80f7fff97079478780560f85e4f3a9\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"15f88ba03041cd855286187aabfc4ab9f4c38802b25994424fd9c2519057f063a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1600dbafca24ac6993c3b6fe5deafaf41b45435b58992756d9d75001611a29197\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16376d787d8cbe794588162fefae6bd99ba7a187df9b453a22ba5d96fc4f13416\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1640770026b2204b1dd45cf05b742a7108b8a2ab884481876c655b94e7a161d1b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"165272a719e88c1294df8eb218ac9610c1d9ff41cc539999e4e8bc7a0824e24b1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"166ad22ae6c9a6b3046bd64c316b612952a4833d4a46a6c6f02f9f38af6efd65c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1674499c55b5bb5d6879c028147ed888da7dbb7055bbd76d4c325e4fec2268547\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1681fc6e14ccc3ff6e45a40667b8e92d3997cae1cfcb8ab38ea7e8e1119bb0efa\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"168837a06dc39187a3590c2f3e2b89ee2bd1862d760f862b6692a594497c4a3a8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1694fdb64d78d0ae2de5d20bd7d5fc01b9e69736489c332ee69fa46fbdaa500fe\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16a20c5ec408e0bea70193816b0d6a45ce884a40902cd4bce61df3da24fd0a34e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16a464723b3d6cd266722faa7875bea44c98cd9823773484ead0c0b949716999c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16b69516b9406251cfdda24ebcefc43fada4922174b3143c504641e2d22f4ab20\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16dc0244a3182e4cc5f1ddc78053a25b317b79368aa73b2870f72ccf66151945f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16e7970e991365658f6792daf75c81b9b3f23e13f354d3d664d5c4e0171d445fa\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"16ebc1302bcc2406192b66361f8178713812c36693ba4d640af1f4eafa804d4d0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"171829b1fb0248977f80d8cc2b19a18f090ff40219dc367653e1bbacdf5d5c5a7\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"176a3721a5cf29884b4e1ce4f027be021fdd4bd84e4556c8852366698eb898fee\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"17742c5dedfe021753abe8ae9830ada7680eae024164767f89acfd4b08765534f\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"178e6723a09a53e530101be7890da1b33c6cb37b40a63af55f79bcae79238e959\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"178ef0a4ffb1bdb911e666757942d62d134ffcae6aa3da5a5b548afe21bfc671d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"179feb5df9d5f26db2ea6ffff7700ec0abecb8a1961049c390dd456993bdeb0f0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"17ab89fd9cf5227ec8db2b29997ac25b2c1285a154e2ef05236ed07f0ad391dce\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"17c0a75194897cdef2fc7d133c2a133ff2387072bc063561351aac1f91d034177\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"17e50056f0768a1ce122d0c6aebd2fe89d666e14150eba587373e20a88e5a5e57\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1803bbe2b84176ad59bf93a5b20035de83999c544f489ea493da8c712a25c35aa\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1809725ff5d166387efaac6bda8fb6d92baa1c00ba5d814b661bae37b38fd31ea\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"181397c302fc689c9f266a47eb5e2faa6db21860aac3e5cfefb2caf04c1763f89\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"181e69ad15e7ec448adcd54957683f729a292bf9a5f9e4ed58995405291d397c1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"182b860ac5225ffcd5a4cf021fb3b70ad6956a5ce3e2154841c19264b44bbeeb3\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"182ed972ef95d44e6dee911e7b55070bb8d7b372903108d19cf8af43298c836ec\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1839f57fcdd9a505540cca364e05172aa9a858c454d3f0432687d72c41a0048cc\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"183d7c376ec77b8fa903b0b18e659561084241a650e5282735890aa901092a4c5\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"183e37c3124de770fe78f40951533072b0fde16ca7f9a23398df9e282435ac344\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"185d2f20c8fe9b5540524c47b0b7077a049d8c6fcd589822a4d9281f5ba1e6c19\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"18724325dee1ba1b52c65b72a59871301f2a6f0aa7bad29f0b8bae7f80999febd\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1876774781515872cb1d39e4c3d73885567dc4be924edf393c19930e2fe3e4922\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"187ac6568209670053e0c0bb3ff6d6aa78674ae62141b0cf3e60653d97720bddb\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"189860871a9e649645cd79593d6e8c63f995a6dea0c51a51c2e6f70973060b3bf\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"18ad95acfad235edd986985d727a704ef522b32d9f69271d37deb4c6c4fa920d1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"18aef2b8a0f4ecd0e7aa8fa87d7298c38d437dce970d7dfb89b54a80271a9714e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"18b6ca5c1a77b89c92d8e65e79b6a998754b97d0a4a8b8e9d92a6ec192b0552d8\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"18ba58d92132185e6e96744f0dea7f87ec7a904ec6367f4302b8bb26fa0fe17d1\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"18f1b7fdd147faf77f19b2283ad21d40d27f4bcd6543ba7a4dfdb3eef29c9b62b\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"193d9685837fa0d8ea5dd0b536e96a218c2af309608d14269d5092cd3cdf6575c\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"194775d4b91bb63bc3636bb52b7e67ad06281f8c8661d3dc4ac65be545abe8a54\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1948b1a88ccef85a4cc38361c1a7bc13c28f5ac514517562d49cd3dbef6cf5500\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"194c107ebb53f77ec585468b5ef7d2c923e6a3bf0c83db7bb7158337e7b61369e\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"1964edc29839184e7b6bf41763c9f4ad12e774f9c96e27f4b173adf4a283d56b0\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"196fef76f7d4be54b0648598bb0204c50c2d7454db528b728a6ae07a9aeb72bee\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"19786c3f195403ce37b07461bfc234e54e91d671873e941e1ad1f3935389e8a3a\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"197d6a8809f7fa3158a5b6d5014685f3cf825eb33dc7a313245f93eae23dc023d\"\n"
-            "  },\n"
-            "  {\n"
-            "    \"s\": \"198b62253217000fbab79bfe4bc4189c17c083ccab115866f16bf803946627107\"\n"
-            "  }\n"
-            "]";
-    return str;
-}
-
-#endif //PIVX_INVALID_SERIALS_JSON_H
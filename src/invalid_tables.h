@@ -0,0 +1,2102 @@
+#ifndef PIVX_INVALID_TABLES_H
+#define PIVX_INVALID_TABLES_H
+/**
+ * Outpoints and zerocoin serials that are banned from the chain
+ * AUTOGENERATED by contrib/invalid/generate-invalid.py
+ *
+ * Outpoints are a 32-byte txid in internal byte order and an output index,
+ * sorted by txid bytes then index. Serials are the little endian magnitude
+ * padded to 33 bytes, sorted by their bytes.
+ */
+static const InvalidOutPointSpec pInvalidOutPoints[] = {
+    {{0x00,0x4b,0x33,0x7a,0xbe,0xf9,0xaa,0x4b,0x01,0xe8,0x07,0x0a,0xd9,0xf8,0x31,0xa1,0xb6,0xf8,0x20,0xcd,0x73,0x22,0x2c,0x58,0x52,0x5a,0x3e,0xf8,0xd0,0x9d,0x28,0xd7}, 0},
+    {{0x00,0x4b,0x33,0x7a,0xbe,0xf9,0xaa,0x4b,0x01,0xe8,0x07,0x0a,0xd9,0xf8,0x31,0xa1,0xb6,0xf8,0x20,0xcd,0x73,0x22,0x2c,0x58,0x52,0x5a,0x3e,0xf8,0xd0,0x9d,0x28,0xd7}, 1},
+    {{0x00,0x96,0x81,0xb2,0x6d,0xbd,0xe8,0x94,0xa5,0xde,0xbf,0x5b,0x33,0x31,0x80,0xd3,0x82,0xab,0x5e,0x59,0xb3,0x15,0x39,0x55,0x37,0xc1,0xee,0xd6,0xfe,0xca,0x4e,0xf3}, 0},
+    {{0x00,0x96,0x81,0xb2,0x6d,0xbd,0xe8,0x94,0xa5,0xde,0xbf,0x5b,0x33,0x31,0x80,0xd3,0x82,0xab,0x5e,0x59,0xb3,0x15,0x39,0x55,0x37,0xc1,0xee,0xd6,0xfe,0xca,0x4e,0xf3}, 1},
+    {{0x00,0xa8,0x78,0xef,0xee,0x7a,0x8f,0x63,0x93,0x50,0x18,0x72,0x64,0x6d,0xee,0xf3,0xbf,0x4d,0xeb,0x92,0x41,0x3e,0x97,0xe8,0xcd,0x2e,0xc7,0x3d,0x91,0x91,0x73,0x2a}, 0},
+    {{0x00,0xae,0x76,0x56,0x64,0xae,0xd5,0x14,0x18,0x71,0x9d,0xde,0x59,0x9d,0x24,0x99,0xc7,0x06,0x96,0x8b,0xe8,0x96,0x60,0x13,0x65,0xf9,0x1c,0x51,0x41,0x97,0xdf,0x6b}, 0},
+    {{0x00,0xae,0x76,0x56,0x64,0xae,0xd5,0x14,0x18,0x71,0x9d,0xde,0x59,0x9d,0x24,0x99,0xc7,0x06,0x96,0x8b,0xe8,0x96,0x60,0x13,0x65,0xf9,0x1c,0x51,0x41,0x97,0xdf,0x6b}, 1},
+    {{0x00,0xe2,0xa0,0xda,0xcc,0xed,0x97,0x56,0xad,0x64,0xd1,0x7a,0x13,0xca,0x43,0x51,0xcc,0xd5,0x3c,0x46,0x18,0x87,0xa1,0x20,0x17,0x13,0xec,0xdd,0xe2,0xaf,0xa0,0x86}, 0},
+    {{0x00,0xe2,0xa0,0xda,0xcc,0xed,0x97,0x56,0xad,0x64,0xd1,0x7a,0x13,0xca,0x43,0x51,0xcc,0xd5,0x3c,0x46,0x18,0x87,0xa1,0x20,0x17,0x13,0xec,0xdd,0xe2,0xaf,0xa0,0x86}, 1},
+    {{0x01,0x0c,0xd3,0xd0,0x6f,0x41,0x3c,0xe2,0xf9,0xa9,0x2a,0x2a,0x8e,0x70,0x6b,0x30,0x85,0xe6,0x6f,0x8d,0x97,0x4f,0xaa,0x73,0x35,0xb8,0xf3,0x19,0x16,0xe3,0x3a,0x59}, 0},
+    {{0x01,0x0c,0xd3,0xd0,0x6f,0x41,0x3c,0xe2,0xf9,0xa9,0x2a,0x2a,0x8e,0x70,0x6b,0x30,0x85,0xe6,0x6f,0x8d,0x97,0x4f,0xaa,0x73,0x35,0xb8,0xf3,0x19,0x16,0xe3,0x3a,0x59}, 1},
+    {{0x01,0x2a,0xb4,0x73,0x79,0x60,0x40,0x8f,0x3b,0xa1,0xae,0xf0,0x69,0xc6,0x88,0x01,0x36,0x45,0x97,0xad,0xac,0xa3,0x6c,0xcd,0x37,0xcd,0xb1,0x69,0x70,0x28,0x9b,0xfd}, 0},
+    {{0x01,0x2a,0xb4,0x73,0x79,0x60,0x40,0x8f,0x3b,0xa1,0xae,0xf0,0x69,0xc6,0x88,0x01,0x36,0x45,0x97,0xad,0xac,0xa3,0x6c,0xcd,0x37,0xcd,0xb1,0x69,0x70,0x28,0x9b,0xfd}, 1},
+    {{0x01,0x92,0xc6,0x3c,0xf6,0x29,0x3b,0x9c,0xdb,0x73,0x82,0x85,0x93,0xf0,0x88,0x5b,0x01,0x30,0x32,0xd2,0xd6,0xd3,0x18,0xf8,0x78,0xfe,0xe1,0x26,0xf5,0x5f,0xf2,0xf0}, 0},
+    {{0x01,0x92,0xc6,0x3c,0xf6,0x29,0x3b,0x9c,0xdb,0x73,0x82,0x85,0x93,0xf0,0x88,0x5b,0x01,0x30,0x32,0xd2,0xd6,0xd3,0x18,0xf8,0x78,0xfe,0xe1,0x26,0xf5,0x5f,0xf2,0xf0}, 1},
+    {{0x01,0xe7,0x52,0x13,0x5f,0xe8,0x8e,0x0c,0x35,0x88,0xb1,0x0b,0x75,0x6a,0x66,0x75,0x5b,0x75,0xfc,0xf1,0x26,0x23,0xbb,0xff,0x0b,0xcb,0x66,0x49,0xa3,0x8b,0xf9,0x84}, 0},
+    {{0x01,0xe7,0x52,0x13,0x5f,0xe8,0x8e,0x0c,0x35,0x88,0xb1,0x0b,0x75,0x6a,0x66,0x75,0x5b,0x75,0xfc,0xf1,0x26,0x23,0xbb,0xff,0x0b,0xcb,0x66,0x49,0xa3,0x8b,0xf9,0x84}, 1},
+    {{0x02,0x59,0x81,0xa9,0x42,0x25,0x84,0x97,0x5f,0x0e,0x17,0x94,0x5d,0x5c,0x3f,0x68,0x6d,0x5f,0x08,0xd3,0x2b,0x2e,0xc6,0xb2,0x4c,0xb3,0x5e,0x88,0x8c,0xc8,0x2c,0xde}, 0},
+    {{0x02,0xbc,0x73,0x23,0x35,0x92,0x95,0xd7,0xe5,0x35,0xae,0x3d,0xe9,0xea,0xb2,0x5c,0xb9,0xe6,0x34,0x13,0x1d,0xd1,0xe9,0x71,0xe4,0x35,0x10,0x0d,0xb5,0x47,0x00,0xdf}, 0},
+    {{0x02,0xbc,0x73,0x23,0x35,0x92,0x95,0xd7,0xe5,0x35,0xae,0x3d,0xe9,0xea,0xb2,0x5c,0xb9,0xe6,0x34,0x13,0x1d,0xd1,0xe9,0x71,0xe4,0x35,0x10,0x0d,0xb5,0x47,0x00,0xdf}, 1},
+    {{0x03,0x77,0x28,0xc5,0x0f,0x2a,0xf4,0xa4,0x03,0xdf,0xfc,0x14,0x64,0x3a,0x96,0xf9,0xcd,0x21,0xfd,0x92,0xb6,0x3c,0xfc,0x0c,0x99,0xf9,0xb5,0x0f,0x4d,0xa8,0x7d,0x68}, 0},
+    {{0x03,0xa4,0x19,0xc0,0x63,0x80,0x16,0x4e,0x8c,0x7b,0xec,0x61,0xac,0x5b,0x6c,0xd5,0xec,0xf9,0xe6,0xd8,0xc4,0x55,0x1b,0x2b,0x92,0x10,0x31,0x2a,0x0a,0xcd,0x38,0xfe}, 0},
+    {{0x03,0xa4,0x19,0xc0,0x63,0x80,0x16,0x4e,0x8c,0x7b,0xec,0x61,0xac,0x5b,0x6c,0xd5,0xec,0xf9,0xe6,0xd8,0xc4,0x55,0x1b,0x2b,0x92,0x10,0x31,0x2a,0x0a,0xcd,0x38,0xfe}, 1},
+    {{0x04,0x50,0x93,0x85,0x90,0x23,0x72,0x89,0x2b,0x66,0x8e,0xe1,0x19,0xda,0x99,0xa7,0xa5,0xe0,0x49,0x5e,0x45,0xce,0x46,0xf9,0x2e,0xe7,0x4b,0xbf,0x26,0x6a,0x9b,0x52}, 0},
+    {{0x04,0x50,0x93,0x85,0x90,0x23,0x72,0x89,0x2b,0x66,0x8e,0xe1,0x19,0xda,0x99,0xa7,0xa5,0xe0,0x49,0x5e,0x45,0xce,0x46,0xf9,0x2e,0xe7,0x4b,0xbf,0x26,0x6a,0x9b,0x52}, 1},
+    {{0x05,0x0e,0x08,0x89,0x5e,0xdf,0x59,0xd8,0xbf,0xe3,0xa9,0x13,0x2e,0x64,0x3d,0xd8,0x2b,0x7f,0xc7,0xbe,0x7f,0x48,0x33,0x08,0xe0,0x6b,0xb5,0x8f,0x49,0xbf,0x99,0x92}, 1},
+    {{0x05,0x23,0x6a,0x7e,0x12,0x0f,0xc9,0xe4,0x42,0x8b,0x79,0x77,0x95,0xa5,0xa1,0x9c,0x51,0x67,0x40,0xcb,0x6e,0xe6,0x54,0x46,0x90,0xe8,0x6e,0xa4,0x51,0x0e,0x93,0x2e}, 0},
+    {{0x05,0x65,0x63,0x0f,0x2e,0x94,0x35,0x4e,0xe7,0x19,0xb6,0x19,0x3b,0xc8,0xdd,0xb5,0x58,0xd8,0xa7,0x58,0x63,0x7b,0x7c,0xaa,0x73,0xbf,0xf2,0xbc,0x4b,0xf6,0xff,0x9b}, 0},
+    {{0x05,0x7c,0xc4,0x1b,0xbe,0x2c,0x1d,0xa1,0x1e,0xc9,0xc6,0x33,0x6d,0xe3,0x09,0x9f,0xe6,0xe0,0xab,0xc1,0xb2,0x15,0x75,0x23,0x41,0x3c,0x91,0xdb,0xce,0xdb,0xb7,0x3d}, 0},
+    {{0x05,0x7c,0xc4,0x1b,0xbe,0x2c,0x1d,0xa1,0x1e,0xc9,0xc6,0x33,0x6d,0xe3,0x09,0x9f,0xe6,0xe0,0xab,0xc1,0xb2,0x15,0x75,0x23,0x41,0x3c,0x91,0xdb,0xce,0xdb,0xb7,0x3d}, 1},
+    {{0x05,0xb4,0x69,0x36,0x81,0xc3,0x32,0xda,0x33,0xd8,0xb4,0x51,0x28,0x5d,0xdc,0xf1,0xeb,0xa9,0xfc,0x50,0x32,0x5a,0x1b,0x19,0x4d,0x88,0x57,0xb9,0x11,0x69,0x50,0x53}, 0},
+    {{0x05,0xff,0xe0,0x4c,0x98,0xdc,0xb3,0x96,0x8c,0x62,0xe7,0x2c,0x42,0x9d,0xff,0xfb,0x89,0x1d,0x45,0x5a,0x7f,0xaa,0x2e,0x6a,0x07,0xb2,0xc8,0x2a,0xd7,0xc2,0xa1,0xd8}, 0},
+    {{0x06,0x1d,0x44,0x37,0x42,0x53,0xb0,0x1a,0x4f,0xc0,0x13,0x3d,0xda,0x4e,0x4c,0x39,0x83,0x04,0xfa,0x1e,0x8f,0x45,0xd4,0x34,0xd0,0xc7,0xea,0x9f,0x77,0x7c,0x6e,0xd2}, 0},
+    {{0x06,0x32,0xba,0x8d,0x66,0xc8,0xc5,0xee,0x1a,0x52,0x91,0x8d,0x31,0x87,0x4d,0x30,0x5c,0xdc,0x0a,0x96,0xd0,0x44,0x29,0xf5,0x97,0x7d,0x49,0xb5,0xe8,0xce,0xdd,0xa7}, 0},
+    {{0x06,0x78,0x42,0x97,0x1e,0x1e,0x67,0xdf,0x32,0x37,0x9e,0xb8,0x19,0x4e,0xff,0x26,0x9e,0x26,0xc8,0x50,0x65,0x93,0x33,0x17,0x1f,0xe0,0x3f,0x30,0xb6,0x8a,0xaa,0xb5}, 0},
+    {{0x06,0x78,0x5e,0x1b,0xb4,0xc9,0xe6,0xd9,0xb7,0x57,0x3c,0x5f,0x8b,0x9d,0x7b,0xd1,0xe9,0x37,0x3c,0x07,0x95,0x94,0x73,0x1e,0x5e,0x95,0xbe,0x7d,0xa1,0x8d,0x0a,0xe9}, 0},
+    {{0x06,0x78,0x5e,0x1b,0xb4,0xc9,0xe6,0xd9,0xb7,0x57,0x3c,0x5f,0x8b,0x9d,0x7b,0xd1,0xe9,0x37,0x3c,0x07,0x95,0x94,0x73,0x1e,0x5e,0x95,0xbe,0x7d,0xa1,0x8d,0x0a,0xe9}, 1},
+    {{0x06,0x98,0xcf,0xf9,0xf3,0x48,0x48,0xed,0x37,0x76,0xfe,0x69,0x47,0x8d,0xfa,0x9a,0xc4,0x95,0xcc,0x8f,0x4e,0x0a,0xd5,0xd1,0x67,0x81,0x2f,0xe5,0x80,0x20,0xc4,0x76}, 0},
+    {{0x06,0x98,0xcf,0xf9,0xf3,0x48,0x48,0xed,0x37,0x76,0xfe,0x69,0x47,0x8d,0xfa,0x9a,0xc4,0x95,0xcc,0x8f,0x4e,0x0a,0xd5,0xd1,0x67,0x81,0x2f,0xe5,0x80,0x20,0xc4,0x76}, 1},
+    {{0x06,0xa0,0xd5,0xa7,0x36,0x30,0xa0,0x2a,0xc9,0xb4,0xfb,0x57,0xf7,0x15,0x48,0x7e,0xd2,0x7b,0xb3,0x70,0x4e,0x60,0x86,0x59,0xd5,0xd2,0xda,0x26,0x6c,0x6b,0x60,0x3c}, 0},
+    {{0x06,0xa0,0xd5,0xa7,0x36,0x30,0xa0,0x2a,0xc9,0xb4,0xfb,0x57,0xf7,0x15,0x48,0x7e,0xd2,0x7b,0xb3,0x70,0x4e,0x60,0x86,0x59,0xd5,0xd2,0xda,0x26,0x6c,0x6b,0x60,0x3c}, 1},
+    {{0x07,0x69,0xc6,0x7a,0x6e,0xac,0xe9,0x3d,0x99,0x82,0x17,0x9e,0xe9,0x91,0x8e,0x44,0xc3,0x87,0x36,0xa5,0x51,0xe1,0x72,0xb8,0x79,0x41,0x2b,0xe4,0xfb,0x3e,0x3c,0x35}, 1},
+    {{0x07,0x75,0x54,0xcc,0xac,0xa9,0x9b,0x1c,0x1f,0x3f,0x6d,0x0b,0x66,0x87,0x5e,0x07,0x32,0x1c,0x5e,0xbb,0xf3,0x4a,0x8e,0x4d,0xeb,0xdb,0x0a,0x5f,0x50,0x35,0x7c,0xe8}, 0},
+    {{0x07,0x75,0x54,0xcc,0xac,0xa9,0x9b,0x1c,0x1f,0x3f,0x6d,0x0b,0x66,0x87,0x5e,0x07,0x32,0x1c,0x5e,0xbb,0xf3,0x4a,0x8e,0x4d,0xeb,0xdb,0x0a,0x5f,0x50,0x35,0x7c,0xe8}, 1},
+    {{0x07,0x8f,0xe1,0x67,0x36,0xb4,0xed,0x1f,0x1d,0x6b,0x81,0xc7,0xad,0x6c,0xb4,0xeb,0x23,0xe7,0xef,0xf0,0x9b,0x14,0x6e,0x70,0xa9,0xa7,0xbe,0x1b,0x9f,0x97,0x45,0x9b}, 0},
+    {{0x07,0x8f,0xe1,0x67,0x36,0xb4,0xed,0x1f,0x1d,0x6b,0x81,0xc7,0xad,0x6c,0xb4,0xeb,0x23,0xe7,0xef,0xf0,0x9b,0x14,0x6e,0x70,0xa9,0xa7,0xbe,0x1b,0x9f,0x97,0x45,0x9b}, 1},
+    {{0x07,0xa5,0x42,0xfe,0xf3,0x33,0x41,0x54,0x65,0x64,0x78,0x09,0xe3,0x28,0x9d,0xe3,0x80,0xdf,0x8b,0xda,0x85,0x11,0xf5,0x7e,0x5f,0x3c,0x66,0x87,0xf6,0x19,0xa8,0xa3}, 0},
+    {{0x07,0xa5,0x42,0xfe,0xf3,0x33,0x41,0x54,0x65,0x64,0x78,0x09,0xe3,0x28,0x9d,0xe3,0x80,0xdf,0x8b,0xda,0x85,0x11,0xf5,0x7e,0x5f,0x3c,0x66,0x87,0xf6,0x19,0xa8,0xa3}, 1},
+    {{0x07,0xbf,0x18,0xfd,0x53,0x1d,0xef,0x6f,0x42,0x56,0xa3,0x41,0x64,0x31,0xca,0xc6,0x09,0xe9,0x5a,0x8a,0xa0,0x6a,0xbd,0xa7,0xc9,0x85,0x31,0x70,0x92,0x32,0xa9,0x6e}, 0},
+    {{0x07,0xce,0xbe,0x92,0x15,0x56,0xb2,0x3e,0x5d,0x7b,0xc1,0xc2,0x7e,0xca,0xb2,0x21,0x1e,0x07,0x62,0x49,0x50,0xd0,0x65,0x27,0x30,0x4e,0x52,0xf1,0xf1,0x33,0xed,0x2e}, 0},
+    {{0x07,0xce,0xbe,0x92,0x15,0x56,0xb2,0x3e,0x5d,0x7b,0xc1,0xc2,0x7e,0xca,0xb2,0x21,0x1e,0x07,0x62,0x49,0x50,0xd0,0x65,0x27,0x30,0x4e,0x52,0xf1,0xf1,0x33,0xed,0x2e}, 1},
+    {{0x07,0xd4,0xc7,0xfb,0xd3,0xf2,0xc5,0x23,0xba,0xf7,0x45,0xca,0x41,0x02,0x5e,0x3d,0x4a,0xba,0xd0,0xfd,0x02,0xb7,0x3a,0xb9,0x53,0x39,0x75,0xf2,0x92,0xa1,0x10,0x4e}, 0},
+    {{0x08,0x05,0xea,0xee,0x61,0x08,0x30,0xa9,0xd5,0x04,0x0d,0x9e,0x82,0x3b,0x71,0x80,0xa4,0x16,0xda,0x1c,0x40,0x30,0xc9,0x06,0x59,0x7f,0xd7,0x46,0x31,0x87,0xe4,0xfb}, 0},
+    {{0x08,0x05,0xea,0xee,0x61,0x08,0x30,0xa9,0xd5,0x04,0x0d,0x9e,0x82,0x3b,0x71,0x80,0xa4,0x16,0xda,0x1c,0x40,0x30,0xc9,0x06,0x59,0x7f,0xd7,0x46,0x31,0x87,0xe4,0xfb}, 1},
+    {{0x08,0x0d,0xf4,0x47,0x1f,0x24,0xe2,0x5f,0xc4,0x22,0xbd,0x92,0x5a,0xa9,0x0d,0x41,0xf1,0xfd,0x1b,0x07,0xe7,0x35,0x1c,0x93,0x4f,0x9f,0x4a,0x3d,0x55,0x14,0x22,0xf3}, 0},
+    {{0x08,0xab,0xb5,0x56,0x43,0xf4,0x30,0xd2,0x33,0x29,0xbd,0xe9,0x2f,0xf1,0x7c,0xd6,0x2e,0x4a,0xdb,0x03,0x71,0x8c,0x63,0xf1,0xf7,0x6a,0x19,0x49,0xb0,0x01,0xb6,0x4f}, 0},
+    {{0x08,0xec,0x7e,0xc0,0x46,0x5f,0x4d,0x15,0x9d,0xbb,0x3f,0x79,0x5c,0xc1,0x89,0xd7,0x62,0x46,0x88,0x98,0x87,0x3e,0x55,0xdd,0x00,0x89,0x3e,0x18,0xa1,0x8b,0x20,0x65}, 0},
+    {{0x08,0xec,0x7e,0xc0,0x46,0x5f,0x4d,0x15,0x9d,0xbb,0x3f,0x79,0x5c,0xc1,0x89,0xd7,0x62,0x46,0x88,0x98,0x87,0x3e,0x55,0xdd,0x00,0x89,0x3e,0x18,0xa1,0x8b,0x20,0x65}, 1},
+    {{0x09,0x04,0xab,0x91,0x2f,0xba,0x27,0xb5,0x48,0xc7,0xc7,0x71,0x37,0xa0,0xe1,0xe6,0x4b,0x59,0xac,0x08,0x7b,0xa2,0x3c,0xfc,0x81,0xbf,0xb1,0x46,0x85,0x45,0xf0,0xa6}, 0},
+    {{0x09,0x31,0x97,0x01,0x36,0x99,0x39,0xe1,0xa2,0x08,0x0d,0xf7,0x34,0x5c,0x63,0x3b,0xc6,0x27,0x51,0xec,0xdc,0x3a,0x09,0x97,0x2f,0x98,0xa5,0xb7,0xee,0xd5,0xf7,0x95}, 0},
+    {{0x09,0xb0,0xa6,0x76,0x19,0x68,0xd5,0x27,0xe5,0x50,0x34,0x58,0xb4,0x04,0x45,0x04,0x85,0xc5,0x13,0xb6,0xa3,0x4e,0x46,0x8d,0x1d,0xd1,0x4b,0x03,0x5e,0x27,0xa2,0xca}, 0},
+    {{0x09,0xb0,0xa6,0x76,0x19,0x68,0xd5,0x27,0xe5,0x50,0x34,0x58,0xb4,0x04,0x45,0x04,0x85,0xc5,0x13,0xb6,0xa3,0x4e,0x46,0x8d,0x1d,0xd1,0x4b,0x03,0x5e,0x27,0xa2,0xca}, 1},
+    {{0x09,0xf1,0xe5,0x65,0x54,0x90,0x62,0x92,0x97,0x0c,0xa8,0x0d,0xc2,0x5d,0xaa,0x36,0x84,0x39,0x34,0xab,0x9c,0xe0,0x62,0x5f,0x22,0x9a,0x9d,0x22,0xf6,0x3e,0x2c,0xc2}, 0},
+    {{0x0a,0x07,0x17,0x50,0xe0,0x74,0xa8,0xa1,0x12,0x47,0x4e,0xe2,0x28,0x82,0x41,0xd7,0xde,0x2c,0x0b,0x94,0x12,0x56,0x31,0x34,0xa3,0x18,0xac,0x0f,0x14,0xe5,0x33,0x1a}, 0},
+    {{0x0a,0x0a,0x06,0xc6,0x06,0x89,0xf3,0xb0,0xf2,0xf9,0x00,0xfe,0x06,0x4f,0xdb,0x91,0x2b,0x25,0x49,0xa3,0x84,0x8b,0xdf,0x54,0x49,0x55,0x7a,0x87,0xb5,0xf1,0x92,0xe3}, 0},
+    {{0x0a,0x17,0x63,0xe3,0xd9,0x7e,0x29,0x0d,0x24,0xd1,0xd7,0xc3,0xa7,0x71,0xc8,0x68,0xfb,0x16,0x5d,0x7e,0xeb,0xe3,0x20,0x74,0xfc,0xc2,0xe4,0x07,0xd6,0x02,0x4a,0x43}, 0},
+    {{0x0a,0x56,0xe2,0x50,0xbd,0x45,0x41,0xb6,0x8e,0xd3,0x08,0xb8,0xb6,0xc7,0xf5,0x06,0xe9,0x87,0xed,0x8e,0x1d,0xf2,0xbd,0xd5,0x5d,0x70,0x92,0x62,0x84,0xcb,0xc9,0x5a}, 0},
+    {{0x0a,0x79,0x26,0x54,0xe5,0xa7,0x20,0x41,0x5d,0xe6,0xfb,0x6d,0x30,0xbc,0x92,0x7f,0x98,0xcf,0x1c,0x54,0xc7,0x32,0x03,0xd4,0x22,0x81,0x7c,0x96,0x12,0x23,0x55,0xab}, 0},
+    {{0x0a,0xa7,0x52,0xce,0x93,0x62,0x49,0x77,0x01,0x66,0x1c,0x1c,0x37,0xfe,0x6a,0x21,0x37,0x41,0xd8,0x39,0xbc,0x5e,0x14,0x81,0x7c,0xf1,0x67,0x70,0xd2,0xfd,0x02,0x33}, 0},
+    {{0x0a,0xa7,0x52,0xce,0x93,0x62,0x49,0x77,0x01,0x66,0x1c,0x1c,0x37,0xfe,0x6a,0x21,0x37,0x41,0xd8,0x39,0xbc,0x5e,0x14,0x81,0x7c,0xf1,0x67,0x70,0xd2,0xfd,0x02,0x33}, 1},
+    {{0x0a,0xd7,0x21,0x00,0x60,0xa9,0xd9,0xa6,0x5b,0x07,0x0a,0xe2,0x49,0x33,0xcd,0xc0,0x8e,0x26,0x14,0x18,0xe0,0x8d,0xa3,0x4c,0x8a,0xa6,0x11,0x9f,0x3a,0xea,0x5d,0xcd}, 0},
+    {{0x0a,0xd7,0x21,0x00,0x60,0xa9,0xd9,0xa6,0x5b,0x07,0x0a,0xe2,0x49,0x33,0xcd,0xc0,0x8e,0x26,0x14,0x18,0xe0,0x8d,0xa3,0x4c,0x8a,0xa6,0x11,0x9f,0x3a,0xea,0x5d,0xcd}, 1},
+    {{0x0a,0xdd,0xba,0x23,0x9f,0x10,0xf4,0x62,0x94,0x5c,0x4f,0x96,0x34,0x56,0x84,0xab,0x87,0xba,0x90,0x40,0xa2,0xb6,0xbf,0x13,0xf4,0xbc,0xb6,0x0b,0x8e,0x00,0xa4,0x38}, 0},
+    {{0x0a,0xdd,0xba,0x23,0x9f,0x10,0xf4,0x62,0x94,0x5c,0x4f,0x96,0x34,0x56,0x84,0xab,0x87,0xba,0x90,0x40,0xa2,0xb6,0xbf,0x13,0xf4,0xbc,0xb6,0x0b,0x8e,0x00,0xa4,0x38}, 1},
+    {{0x0b,0x0d,0x7e,0x29,0x75,0xec,0x36,0x46,0x6f,0x8c,0x37,0x3a,0x38,0x70,0x7f,0xdb,0x1b,0x76,0xd5,0xc6,0xbe,0xc1,0x7b,0x96,0x54,0x12,0x82,0xa9,0x8f,0xf7,0xf9,0xa8}, 0},
+    {{0x0b,0x0d,0x7e,0x29,0x75,0xec,0x36,0x46,0x6f,0x8c,0x37,0x3a,0x38,0x70,0x7f,0xdb,0x1b,0x76,0xd5,0xc6,0xbe,0xc1,0x7b,0x96,0x54,0x12,0x82,0xa9,0x8f,0xf7,0xf9,0xa8}, 1},
+    {{0x0b,0x83,0xa0,0x2c,0x4f,0x58,0xea,0x5a,0x22,0x17,0xaf,0x3b,0x12,0xa2,0x14,0x28,0x18,0x36,0xff,0xe7,0xf4,0x07,0xbf,0xaa,0x8d,0x46,0x85,0x3f,0x69,0xe9,0x00,0x2c}, 0},
+    {{0x0b,0x83,0xa0,0x2c,0x4f,0x58,0xea,0x5a,0x22,0x17,0xaf,0x3b,0x12,0xa2,0x14,0x28,0x18,0x36,0xff,0xe7,0xf4,0x07,0xbf,0xaa,0x8d,0x46,0x85,0x3f,0x69,0xe9,0x00,0x2c}, 1},
+    {{0x0b,0x87,0x82,0xf3,0x07,0xf5,0x2f,0xa3,0x48,0xa1,0x13,0x7e,0xdb,0xd4,0x83,0x0b,0x98,0x6d,0x2c,0x54,0x0d,0x82,0xff,0x2a,0x9c,0x1a,0xa5,0x58,0x35,0x99,0x1e,0x5a}, 0},
+    {{0x0b,0x87,0x82,0xf3,0x07,0xf5,0x2f,0xa3,0x48,0xa1,0x13,0x7e,0xdb,0xd4,0x83,0x0b,0x98,0x6d,0x2c,0x54,0x0d,0x82,0xff,0x2a,0x9c,0x1a,0xa5,0x58,0x35,0x99,0x1e,0x5a}, 1},
+    {{0x0c,0x1a,0x51,0x6e,0x4f,0xab,0x1a,0x3d,0x2e,0xc5,0xd8,0xe4,0xf1,0x7b,0x38,0x75,0xb6,0x8c,0xa4,0x99,0x31,0xa2,0xd2,0x00,0x68,0x87,0x05,0xb8,0x3d,0xb1,0xcb,0x5f}, 0},
+    {{0x0c,0x1a,0x51,0x6e,0x4f,0xab,0x1a,0x3d,0x2e,0xc5,0xd8,0xe4,0xf1,0x7b,0x38,0x75,0xb6,0x8c,0xa4,0x99,0x31,0xa2,0xd2,0x00,0x68,0x87,0x05,0xb8,0x3d,0xb1,0xcb,0x5f}, 1},
+    {{0x0c,0x2e,0x4c,0x92,0x42,0x13,0x3c,0xdd,0xcd,0xe3,0x86,0xc5,0x62,0xf7,0x69,0x27,0x48,0x8f,0x79,0xab,0x31,0xe0,0x43,0x29,0xcb,0xeb,0x0a,0xb5,0x1a,0x62,0xc3,0x4a}, 0},
+    {{0x0c,0x2e,0x4c,0x92,0x42,0x13,0x3c,0xdd,0xcd,0xe3,0x86,0xc5,0x62,0xf7,0x69,0x27,0x48,0x8f,0x79,0xab,0x31,0xe0,0x43,0x29,0xcb,0xeb,0x0a,0xb5,0x1a,0x62,0xc3,0x4a}, 1},
+    {{0x0c,0x3a,0x34,0xc0,0xad,0x59,0x15,0x8c,0x8d,0xf6,0x18,0x5b,0x07,0xf6,0x99,0xb6,0xd8,0x4a,0xd2,0x89,0x02,0x9e,0x5a,0xe6,0xa7,0xb9,0xac,0xab,0x84,0xf7,0x12,0x65}, 0},
+    {{0x0c,0x3a,0x34,0xc0,0xad,0x59,0x15,0x8c,0x8d,0xf6,0x18,0x5b,0x07,0xf6,0x99,0xb6,0xd8,0x4a,0xd2,0x89,0x02,0x9e,0x5a,0xe6,0xa7,0xb9,0xac,0xab,0x84,0xf7,0x12,0x65}, 1},
+    {{0x0c,0x5d,0xc8,0x46,0x96,0x53,0xc3,0xaf,0xab,0x59,0x78,0x30,0x01,0xf1,0xd1,0x34,0x00,0xef,0x75,0xd2,0x6c,0x19,0x1a,0xe6,0x35,0xe4,0x17,0x1d,0x45,0x1b,0x24,0x0d}, 0},
+    {{0x0c,0x5d,0xc8,0x46,0x96,0x53,0xc3,0xaf,0xab,0x59,0x78,0x30,0x01,0xf1,0xd1,0x34,0x00,0xef,0x75,0xd2,0x6c,0x19,0x1a,0xe6,0x35,0xe4,0x17,0x1d,0x45,0x1b,0x24,0x0d}, 1},
+    {{0x0c,0xe2,0x0e,0x6e,0x95,0xc9,0x89,0x8e,0xbb,0xfe,0x0a,0x25,0xb2,0x06,0x33,0xe2,0x92,0xd0,0xc5,0x24,0xc2,0x21,0xf1,0x52,0x76,0x58,0x91,0x16,0x40,0x1d,0xdf,0xa6}, 0},
+    {{0x0c,0xe2,0x0e,0x6e,0x95,0xc9,0x89,0x8e,0xbb,0xfe,0x0a,0x25,0xb2,0x06,0x33,0xe2,0x92,0xd0,0xc5,0x24,0xc2,0x21,0xf1,0x52,0x76,0x58,0x91,0x16,0x40,0x1d,0xdf,0xa6}, 1},
+    {{0x0d,0x78,0x0d,0x6a,0xdf,0x39,0xcc,0xa5,0xa3,0xcb,0xcc,0x22,0x5d,0xce,0xc4,0x85,0xa5,0x9f,0x36,0xa2,0xca,0x38,0xb2,0xda,0xb1,0x04,0xd5,0xae,0xda,0xe7,0x01,0x1b}, 0},
+    {{0x0d,0x78,0x0d,0x6a,0xdf,0x39,0xcc,0xa5,0xa3,0xcb,0xcc,0x22,0x5d,0xce,0xc4,0x85,0xa5,0x9f,0x36,0xa2,0xca,0x38,0xb2,0xda,0xb1,0x04,0xd5,0xae,0xda,0xe7,0x01,0x1b}, 1},
+    {{0x0d,0xb3,0x73,0xb7,0x8a,0x62,0x2e,0x50,0x44,0xc7,0x62,0x2a,0xc8,0xaf,0x92,0x90,0x5f,0x92,0x05,0xb4,0x90,0x43,0x13,0xdf,0xbc,0xa0,0x46,0xaa,0xbc,0xbe,0xb0,0x73}, 0},
+    {{0x0d,0xb3,0x73,0xb7,0x8a,0x62,0x2e,0x50,0x44,0xc7,0x62,0x2a,0xc8,0xaf,0x92,0x90,0x5f,0x92,0x05,0xb4,0x90,0x43,0x13,0xdf,0xbc,0xa0,0x46,0xaa,0xbc,0xbe,0xb0,0x73}, 1},
+    {{0x0e,0xc5,0x67,0xfd,0xd9,0x44,0xe9,0x23,0x0c,0x03,0xcb,0x52,0xd2,0x7e,0xa1,0x50,0x93,0x1f,0x1b,0x78,0xd4,0x2a,0xce,0xc7,0xcd,0x80,0xd1,0xa7,0x22,0xdd,0x67,0x33}, 0},
+    {{0x0e,0xdf,0x00,0x5a,0x0a,0x5d,0x35,0x7a,0xf1,0x3e,0xe0,0xe2,0xe4,0x32,0x35,0xca,0xad,0x0d,0x11,0x02,0x83,0xfd,0xb7,0x20,0xdd,0x36,0x4b,0x76,0x57,0x9b,0x8f,0xd3}, 0},
+    {{0x0e,0xdf,0x00,0x5a,0x0a,0x5d,0x35,0x7a,0xf1,0x3e,0xe0,0xe2,0xe4,0x32,0x35,0xca,0xad,0x0d,0x11,0x02,0x83,0xfd,0xb7,0x20,0xdd,0x36,0x4b,0x76,0x57,0x9b,0x8f,0xd3}, 1},
+    {{0x0e,0xfa,0xdc,0x4e,0xd2,0x95,0x75,0x76,0x07,0x26,0x59,0x62,0x18,0xad,0x0f,0x81,0xd7,0x4d,0x51,0x2c,0x2e,0x6d,0xc9,0xc6,0x34,0x23,0xf4,0xee,0x56,0x78,0x71,0x26}, 0},
+    {{0x0e,0xfa,0xdc,0x4e,0xd2,0x95,0x75,0x76,0x07,0x26,0x59,0x62,0x18,0xad,0x0f,0x81,0xd7,0x4d,0x51,0x2c,0x2e,0x6d,0xc9,0xc6,0x34,0x23,0xf4,0xee,0x56,0x78,0x71,0x26}, 1},
+    {{0x0f,0x0f,0xb2,0xc4,0xc4,0xe8,0xbb,0xcf,0x7e,0xcc,0xe3,0x49,0x21,0x33,0x27,0xcb,0xfa,0xcc,0xed,0x4e,0xe5,0x94,0xf5,0x46,0x55,0xce,0xae,0x07,0x7d,0x6a,0x30,0x1d}, 0},
+    {{0x0f,0x0f,0xb2,0xc4,0xc4,0xe8,0xbb,0xcf,0x7e,0xcc,0xe3,0x49,0x21,0x33,0x27,0xcb,0xfa,0xcc,0xed,0x4e,0xe5,0x94,0xf5,0x46,0x55,0xce,0xae,0x07,0x7d,0x6a,0x30,0x1d}, 1},
+    {{0x0f,0x0f,0xfd,0xd0,0x2f,0xd0,0xc4,0x43,0x1c,0x2b,0xb5,0x00,0x28,0x43,0x88,0xc1,0x1f,0xc6,0xb9,0x75,0x8a,0xad,0x97,0x95,0xc6,0xf8,0x2c,0xa6,0xaf,0xa7,0xfe,0x5f}, 0},
+    {{0x0f,0x0f,0xfd,0xd0,0x2f,0xd0,0xc4,0x43,0x1c,0x2b,0xb5,0x00,0x28,0x43,0x88,0xc1,0x1f,0xc6,0xb9,0x75,0x8a,0xad,0x97,0x95,0xc6,0xf8,0x2c,0xa6,0xaf,0xa7,0xfe,0x5f}, 1},
+    {{0x0f,0x6c,0x8f,0x9c,0x64,0x10,0x42,0xf0,0x91,0x0a,0x3a,0x52,0xef,0xce,0x6b,0x64,0x09,0xcd,0xa2,0xcd,0xb0,0x08,0xc2,0x23,0xa8,0x9b,0xf2,0xc7,0x05,0xf9,0x0e,0xc9}, 0},
+    {{0x0f,0x6c,0x8f,0x9c,0x64,0x10,0x42,0xf0,0x91,0x0a,0x3a,0x52,0xef,0xce,0x6b,0x64,0x09,0xcd,0xa2,0xcd,0xb0,0x08,0xc2,0x23,0xa8,0x9b,0xf2,0xc7,0x05,0xf9,0x0e,0xc9}, 1},
+    {{0x0f,0x99,0x00,0x9a,0xf8,0x93,0xd4,0xa3,0xf0,0x05,0xcc,0xf1,0x37,0x47,0xe3,0x01,0x47,0x20,0x2f,0xa3,0x26,0x33,0x6c,0xc8,0xb0,0x44,0x57,0x82,0x94,0x44,0x49,0xdf}, 0},
+    {{0x0f,0x99,0x00,0x9a,0xf8,0x93,0xd4,0xa3,0xf0,0x05,0xcc,0xf1,0x37,0x47,0xe3,0x01,0x47,0x20,0x2f,0xa3,0x26,0x33,0x6c,0xc8,0xb0,0x44,0x57,0x82,0x94,0x44,0x49,0xdf}, 1},
+    {{0x0f,0xa1,0xdf,0xfb,0xf2,0x33,0x82,0xad,0x3e,0x32,0x38,0xa9,0x7f,0xfd,0x0f,0x06,0x03,0xa0,0xc9,0x77,0x1d,0x6b,0xa7,0xcd,0x37,0x87,0x86,0x4a,0x65,0x40,0x1a,0xec}, 0},
+    {{0x0f,0xa1,0xdf,0xfb,0xf2,0x33,0x82,0xad,0x3e,0x32,0x38,0xa9,0x7f,0xfd,0x0f,0x06,0x03,0xa0,0xc9,0x77,0x1d,0x6b,0xa7,0xcd,0x37,0x87,0x86,0x4a,0x65,0x40,0x1a,0xec}, 1},
+    {{0x10,0x49,0xa6,0xce,0x95,0x81,0xe0,0x70,0x8c,0xc4,0xf7,0xd1,0x3e,0x56,0x5a,0xa6,0x0d,0xe2,0xf9,0x1b,0x85,0x1a,0xb1,0x76,0x05,0x95,0x64,0xe1,0x32,0xa4,0x5b,0x90}, 0},
+    {{0x10,0xd5,0x3a,0xf3,0x97,0x98,0xf6,0x52,0xc3,0x57,0x7d,0x49,0xe6,0xcb,0xea,0x2f,0x43,0xe1,0xa0,0xf6,0x4e,0x10,0x41,0xb5,0x5a,0x47,0x92,0xab,0x13,0x3d,0xb0,0x59}, 0},
+    {{0x10,0xd5,0x3a,0xf3,0x97,0x98,0xf6,0x52,0xc3,0x57,0x7d,0x49,0xe6,0xcb,0xea,0x2f,0x43,0xe1,0xa0,0xf6,0x4e,0x10,0x41,0xb5,0x5a,0x47,0x92,0xab,0x13,0x3d,0xb0,0x59}, 1},
+    {{0x11,0x12,0x00,0x0a,0xd8,0x5a,0x7b,0x3c,0xa3,0x9d,0x39,0x0c,0x78,0x1e,0x73,0x0f,0x1c,0x0a,0xe4,0x14,0x55,0xec,0xcf,0xad,0x09,0xda,0x84,0xac,0x14,0xa5,0xb1,0xb4}, 0},
+    {{0x11,0x12,0x00,0x0a,0xd8,0x5a,0x7b,0x3c,0xa3,0x9d,0x39,0x0c,0x78,0x1e,0x73,0x0f,0x1c,0x0a,0xe4,0x14,0x55,0xec,0xcf,0xad,0x09,0xda,0x84,0xac,0x14,0xa5,0xb1,0xb4}, 1},
+    {{0x11,0x20,0xb7,0x6b,0x70,0x27,0xd9,0xec,0x75,0x66,0x89,0xd5,0x3c,0x5e,0xc1,0x33,0xa8,0xab,0xf9,0x32,0x13,0xa4,0xd8,0xe9,0x51,0x7a,0xbb,0xc7,0xca,0x52,0x7e,0xb6}, 0},
+    {{0x11,0x22,0xcb,0xaa,0xe7,0x9e,0x2a,0x34,0xf4,0x5b,0x6c,0x5b,0x82,0x55,0xcb,0x5a,0x78,0x44,0x62,0xe0,0x68,0x91,0xda,0xc5,0xbe,0x1a,0x5e,0xfc,0xc4,0x4a,0x08,0x14}, 0},
+    {{0x11,0x22,0xcb,0xaa,0xe7,0x9e,0x2a,0x34,0xf4,0x5b,0x6c,0x5b,0x82,0x55,0xcb,0x5a,0x78,0x44,0x62,0xe0,0x68,0x91,0xda,0xc5,0xbe,0x1a,0x5e,0xfc,0xc4,0x4a,0x08,0x14}, 1},
+    {{0x11,0x25,0x69,0xb2,0x85,0xea,0xd3,0xcb,0x66,0xdf,0xc7,0x89,0x2e,0x4a,0x82,0x9e,0x42,0xcd,0x07,0x6b,0x2a,0xc9,0x41,0xb0,0x63,0xa1,0x50,0xa9,0x9f,0xc2,0xdd,0xdd}, 0},
+    {{0x11,0x25,0x69,0xb2,0x85,0xea,0xd3,0xcb,0x66,0xdf,0xc7,0x89,0x2e,0x4a,0x82,0x9e,0x42,0xcd,0x07,0x6b,0x2a,0xc9,0x41,0xb0,0x63,0xa1,0x50,0xa9,0x9f,0xc2,0xdd,0xdd}, 1},
+    {{0x11,0x62,0xd5,0x13,0xb7,0x3e,0xd3,0x7a,0xa4,0x29,0x77,0xc9,0x26,0xba,0xf7,0x45,0x0c,0xf7,0x99,0x06,0xb2,0x0b,0xd9,0xd6,0x86,0x37,0x52,0x59,0x25,0xf2,0xfd,0x40}, 0},
+    {{0x11,0xc2,0xff,0xef,0xf4,0x94,0x66,0x97,0x1b,0xd7,0xfe,0x3e,0xfd,0x15,0x43,0xc1,0x1d,0x07,0x22,0xfe,0xb7,0x22,0xcf,0x0a,0x20,0x15,0x42,0xd7,0x6f,0xaf,0x79,0x3f}, 0},
+    {{0x12,0x03,0xda,0x46,0x93,0x41,0x18,0x45,0x7a,0x52,0x27,0x27,0xef,0x6c,0x33,0xe0,0xe6,0x90,0x14,0x2e,0x20,0xe0,0x10,0x0c,0xa9,0x36,0x22,0x09,0x1c,0xa2,0xf1,0x11}, 0},
+    {{0x12,0x03,0xda,0x46,0x93,0x41,0x18,0x45,0x7a,0x52,0x27,0x27,0xef,0x6c,0x33,0xe0,0xe6,0x90,0x14,0x2e,0x20,0xe0,0x10,0x0c,0xa9,0x36,0x22,0x09,0x1c,0xa2,0xf1,0x11}, 1},
+    {{0x12,0x06,0x80,0x07,0x1a,0x9a,0xa8,0xe4,0xea,0x45,0x6c,0x33,0x75,0xaf,0x45,0x9e,0xc9,0x70,0xa8,0x58,0xb3,0xdc,0x57,0xa4,0x29,0xcd,0xb1,0xdd,0x07,0x47,0xfe,0x29}, 0},
+    {{0x12,0x14,0xa6,0xda,0x56,0xfd,0xa5,0x63,0xc5,0x75,0xca,0xd6,0x2c,0x9b,0x8b,0xfe,0x20,0x90,0x82,0x91,0x3c,0xc0,0x78,0x63,0x59,0x68,0x90,0xcb,0x06,0xa4,0xa6,0xf2}, 0},
+    {{0x12,0xe1,0xbf,0xd9,0x3e,0x8d,0x36,0xdc,0xc8,0xea,0xd6,0xab,0xbc,0x02,0x87,0x71,0x1c,0xab,0x37,0x7c,0x52,0x76,0x3c,0x79,0x5e,0x45,0xf1,0x09,0x0b,0xc5,0x7b,0x99}, 0},
+    {{0x12,0xe1,0xbf,0xd9,0x3e,0x8d,0x36,0xdc,0xc8,0xea,0xd6,0xab,0xbc,0x02,0x87,0x71,0x1c,0xab,0x37,0x7c,0x52,0x76,0x3c,0x79,0x5e,0x45,0xf1,0x09,0x0b,0xc5,0x7b,0x99}, 1},
+    {{0x13,0x13,0x63,0x71,0x62,0xbe,0x20,0xfe,0x33,0x07,0xc5,0xdb,0x48,0xf4,0xe8,0x89,0xce,0xb1,0xcb,0x08,0x02,0xf8,0xad,0xd0,0x78,0x03,0xcd,0x2e,0x65,0x08,0x0c,0x2c}, 0},
+    {{0x13,0x13,0x63,0x71,0x62,0xbe,0x20,0xfe,0x33,0x07,0xc5,0xdb,0x48,0xf4,0xe8,0x89,0xce,0xb1,0xcb,0x08,0x02,0xf8,0xad,0xd0,0x78,0x03,0xcd,0x2e,0x65,0x08,0x0c,0x2c}, 1},
+    {{0x13,0xca,0x23,0x30,0xf8,0xfc,0xe1,0x47,0x4b,0xb8,0x38,0xa5,0x4d,0x05,0x61,0x50,0xc5,0x85,0xcb,0x46,0x6f,0xa3,0x6c,0xed,0x1f,0xc1,0x36,0x7c,0xfb,0xa8,0xbd,0xd4}, 0},
+    {{0x13,0xca,0x23,0x30,0xf8,0xfc,0xe1,0x47,0x4b,0xb8,0x38,0xa5,0x4d,0x05,0x61,0x50,0xc5,0x85,0xcb,0x46,0x6f,0xa3,0x6c,0xed,0x1f,0xc1,0x36,0x7c,0xfb,0xa8,0xbd,0xd4}, 1},
+    {{0x13,0xd4,0xa1,0x5b,0x1c,0xeb,0xb3,0xa0,0xdc,0x68,0x7f,0xa7,0xb1,0x79,0x88,0x1a,0xed,0xa3,0xbd,0x38,0x2d,0x43,0x45,0x79,0x2b,0x42,0xf1,0xe4,0x25,0x5d,0x4f,0x5a}, 0},
+    {{0x13,0xd4,0xa1,0x5b,0x1c,0xeb,0xb3,0xa0,0xdc,0x68,0x7f,0xa7,0xb1,0x79,0x88,0x1a,0xed,0xa3,0xbd,0x38,0x2d,0x43,0x45,0x79,0x2b,0x42,0xf1,0xe4,0x25,0x5d,0x4f,0x5a}, 1},
+    {{0x13,0xd6,0x60,0x2e,0xb8,0xf2,0x33,0x6d,0x30,0x7b,0xc9,0x63,0x5e,0x47,0x9a,0x0f,0x35,0x03,0xac,0x09,0x11,0xf6,0x46,0x60,0xa1,0xa4,0x40,0x13,0xb3,0xc1,0xcf,0xf9}, 0},
+    {{0x14,0x28,0xc5,0xb5,0x20,0x8c,0x63,0xfb,0x94,0x34,0x40,0x05,0x99,0xac,0x59,0x78,0x2b,0x3c,0xaa,0xdb,0x76,0xf1,0x49,0xf6,0xbd,0x5a,0xfe,0x5e,0xf0,0xf0,0xee,0xf6}, 0},
+    {{0x14,0x37,0x33,0xc2,0x84,0xe3,0xa9,0xf2,0x91,0x1b,0xfe,0x70,0x7e,0x81,0x94,0x22,0x2e,0x2a,0xa9,0x5a,0x3e,0x85,0x98,0xcb,0xca,0xfb,0xfc,0xd1,0x95,0xf8,0x28,0x37}, 0},
+    {{0x14,0x37,0x33,0xc2,0x84,0xe3,0xa9,0xf2,0x91,0x1b,0xfe,0x70,0x7e,0x81,0x94,0x22,0x2e,0x2a,0xa9,0x5a,0x3e,0x85,0x98,0xcb,0xca,0xfb,0xfc,0xd1,0x95,0xf8,0x28,0x37}, 1},
+    {{0x14,0x9e,0x99,0xbd,0xa9,0xef,0x5d,0xd3,0xb0,0xc9,0x1f,0x68,0x32,0x65,0xde,0xab,0xe2,0xda,0x2d,0x18,0x38,0x32,0x0d,0x94,0x34,0x88,0x2f,0x7a,0xf0,0x90,0xf1,0x2b}, 0},
+    {{0x14,0x9e,0x99,0xbd,0xa9,0xef,0x5d,0xd3,0xb0,0xc9,0x1f,0x68,0x32,0x65,0xde,0xab,0xe2,0xda,0x2d,0x18,0x38,0x32,0x0d,0x94,0x34,0x88,0x2f,0x7a,0xf0,0x90,0xf1,0x2b}, 1},
+    {{0x14,0xfb,0x7c,0xd9,0x28,0x6f,0x48,0xa6,0xe9,0xb7,0x72,0x66,0xf4,0xda,0x2f,0x9a,0xb9,0x46,0x96,0xa1,0xa6,0x13,0xa1,0x00,0x8f,0x4e,0x7e,0x61,0x92,0xdd,0x40,0x86}, 1},
+    {{0x14,0xfb,0x7c,0xd9,0x28,0x6f,0x48,0xa6,0xe9,0xb7,0x72,0x66,0xf4,0xda,0x2f,0x9a,0xb9,0x46,0x96,0xa1,0xa6,0x13,0xa1,0x00,0x8f,0x4e,0x7e,0x61,0x92,0xdd,0x40,0x86}, 2},
+    {{0x15,0x19,0xae,0xb1,0x02,0x07,0xfc,0x67,0x02,0x1c,0x88,0x09,0xc3,0x9d,0xeb,0x61,0xba,0x79,0x0c,0x9e,0xba,0x2c,0x05,0x08,0x3a,0xeb,0x54,0xbc,0x8b,0xb9,0x16,0x62}, 0},
+    {{0x15,0x19,0xae,0xb1,0x02,0x07,0xfc,0x67,0x02,0x1c,0x88,0x09,0xc3,0x9d,0xeb,0x61,0xba,0x79,0x0c,0x9e,0xba,0x2c,0x05,0x08,0x3a,0xeb,0x54,0xbc,0x8b,0xb9,0x16,0x62}, 1},
+    {{0x15,0x20,0x4e,0x5c,0x45,0x83,0xe7,0x38,0x96,0x47,0x4f,0x5b,0x60,0x59,0xcf,0x9d,0x7d,0xba,0xec,0x56,0xcb,0x46,0xb2,0x8f,0xd7,0xfc,0x0e,0x06,0x06,0xc4,0x98,0x78}, 0},
+    {{0x15,0x20,0x4e,0x5c,0x45,0x83,0xe7,0x38,0x96,0x47,0x4f,0x5b,0x60,0x59,0xcf,0x9d,0x7d,0xba,0xec,0x56,0xcb,0x46,0xb2,0x8f,0xd7,0xfc,0x0e,0x06,0x06,0xc4,0x98,0x78}, 1},
+    {{0x15,0x2b,0x28,0xa3,0xcd,0x06,0xf6,0xff,0xa0,0x3c,0x4f,0xe9,0xc4,0xbe,0xb0,0x27,0xb1,0x32,0xd1,0x0b,0x74,0xa1,0xf1,0x96,0xb9,0x9a,0x81,0xc9,0x09,0x58,0xd1,0x3e}, 0},
+    {{0x15,0x2b,0x28,0xa3,0xcd,0x06,0xf6,0xff,0xa0,0x3c,0x4f,0xe9,0xc4,0xbe,0xb0,0x27,0xb1,0x32,0xd1,0x0b,0x74,0xa1,0xf1,0x96,0xb9,0x9a,0x81,0xc9,0x09,0x58,0xd1,0x3e}, 1},
+    {{0x15,0x5e,0x8f,0xd6,0x51,0x31,0x87,0xf8,0x16,0x51,0x6e,0x8d,0xef,0x53,0x10,0x82,0xb7,0x2c,0x10,0x2d,0x76,0xd0,0xd6,0xde,0xed,0x25,0x76,0xee,0x1b,0x3e,0x81,0x52}, 0},
+    {{0x15,0x5e,0x8f,0xd6,0x51,0x31,0x87,0xf8,0x16,0x51,0x6e,0x8d,0xef,0x53,0x10,0x82,0xb7,0x2c,0x10,0x2d,0x76,0xd0,0xd6,0xde,0xed,0x25,0x76,0xee,0x1b,0x3e,0x81,0x52}, 1},
+    {{0x15,0x77,0x0c,0xc7,0xb3,0x74,0xb6,0xbb,0xa2,0xac,0x09,0xf5,0x67,0xb4,0x58,0xa1,0x6c,0x60,0xb2,0x02,0x29,0x40,0x41,0x3b,0x80,0xba,0xf1,0x41,0x86,0x8e,0xe0,0x41}, 0},
+    {{0x15,0x77,0x0c,0xc7,0xb3,0x74,0xb6,0xbb,0xa2,0xac,0x09,0xf5,0x67,0xb4,0x58,0xa1,0x6c,0x60,0xb2,0x02,0x29,0x40,0x41,0x3b,0x80,0xba,0xf1,0x41,0x86,0x8e,0xe0,0x41}, 1},
+    {{0x15,0x78,0xd6,0x0c,0xce,0x0c,0x83,0xdc,0x5a,0x68,0x64,0x85,0xad,0x27,0xcb,0x50,0xee,0x14,0x4a,0xfb,0x64,0x87,0x13,0x3c,0x21,0x59,0x2d,0x1a,0xa1,0x42,0xdb,0x05}, 0},
+    {{0x15,0xc8,0x88,0xc5,0xc2,0x9a,0xbc,0x47,0xbd,0x78,0x8a,0x4f,0x79,0xdf,0xc4,0x71,0xbe,0x39,0x19,0xe6,0x31,0xf8,0x5c,0x7b,0x11,0x16,0xca,0x0e,0xd2,0x73,0xec,0x63}, 0},
+    {{0x16,0x4e,0x9b,0x4c,0x4c,0xc1,0xe2,0x23,0xee,0xad,0xab,0x1c,0xfd,0xc8,0x12,0x43,0x96,0xe7,0xd0,0xbd,0xe0,0xd2,0x4f,0xd2,0x30,0x6c,0x4a,0x71,0xd2,0x30,0xc7,0xc2}, 0},
+    {{0x16,0x4e,0x9b,0x4c,0x4c,0xc1,0xe2,0x23,0xee,0xad,0xab,0x1c,0xfd,0xc8,0x12,0x43,0x96,0xe7,0xd0,0xbd,0xe0,0xd2,0x4f,0xd2,0x30,0x6c,0x4a,0x71,0xd2,0x30,0xc7,0xc2}, 1},
+    {{0x16,0x72,0x1f,0x39,0xa0,0xe2,0xd0,0x05,0xb9,0xa8,0xac,0xb9,0xf4,0xc6,0x4c,0x58,0x10,0x0e,0x10,0x11,0x73,0x66,0x87,0x66,0x37,0xc5,0x65,0x6c,0xe9,0x27,0x76,0xac}, 0},
+    {{0x16,0x72,0x1f,0x39,0xa0,0xe2,0xd0,0x05,0xb9,0xa8,0xac,0xb9,0xf4,0xc6,0x4c,0x58,0x10,0x0e,0x10,0x11,0x73,0x66,0x87,0x66,0x37,0xc5,0x65,0x6c,0xe9,0x27,0x76,0xac}, 1},
+    {{0x16,0xc8,0xed,0x2f,0xec,0x1c,0x84,0x47,0x11,0x72,0x5e,0x93,0x86,0x32,0x4b,0xa7,0xd5,0x04,0x34,0xf6,0xbd,0x3e,0x1b,0x64,0x21,0x59,0xae,0x33,0xad,0xa3,0x04,0xae}, 0},
+    {{0x16,0xee,0x72,0x61,0xf2,0x76,0x2a,0xbb,0x10,0xdd,0x6a,0xdd,0x1a,0xb2,0x39,0xa4,0x70,0xb5,0x38,0xc3,0x37,0xdf,0xb6,0x94,0x87,0xb4,0xa6,0x95,0x25,0x9a,0x84,0x4d}, 0},
+    {{0x16,0xee,0x72,0x61,0xf2,0x76,0x2a,0xbb,0x10,0xdd,0x6a,0xdd,0x1a,0xb2,0x39,0xa4,0x70,0xb5,0x38,0xc3,0x37,0xdf,0xb6,0x94,0x87,0xb4,0xa6,0x95,0x25,0x9a,0x84,0x4d}, 1},
+    {{0x17,0x09,0x7e,0xcb,0x9b,0x0a,0x08,0x60,0x24,0xbe,0x08,0x84,0xe0,0x14,0xed,0xc6,0x7f,0x7d,0x8f,0x62,0x85,0xf1,0x7a,0x8a,0xff,0xa3,0x9f,0x43,0x3e,0x12,0xdb,0xfa}, 0},
+    {{0x17,0x09,0x7e,0xcb,0x9b,0x0a,0x08,0x60,0x24,0xbe,0x08,0x84,0xe0,0x14,0xed,0xc6,0x7f,0x7d,0x8f,0x62,0x85,0xf1,0x7a,0x8a,0xff,0xa3,0x9f,0x43,0x3e,0x12,0xdb,0xfa}, 1},
+    {{0x17,0x4c,0xdb,0xfc,0x51,0xd6,0xd2,0xd0,0xa0,0x24,0xeb,0xf9,0x6d,0xd2,0x9d,0x76,0x63,0xdc,0x4b,0x96,0x16,0x20,0x08,0x67,0xf0,0x47,0x23,0xa4,0x8c,0x01,0xbf,0xec}, 0},
+    {{0x17,0x4c,0xdb,0xfc,0x51,0xd6,0xd2,0xd0,0xa0,0x24,0xeb,0xf9,0x6d,0xd2,0x9d,0x76,0x63,0xdc,0x4b,0x96,0x16,0x20,0x08,0x67,0xf0,0x47,0x23,0xa4,0x8c,0x01,0xbf,0xec}, 1},
+    {{0x17,0x5f,0xc0,0xd1,0x66,0x26,0xa3,0xed,0x12,0xc8,0x02,0xd7,0x4c,0xef,0x57,0x34,0x72,0xfb,0x02,0xfc,0x94,0xac,0xc8,0x5c,0xc9,0xf0,0x36,0xf5,0x30,0x28,0xc5,0xc8}, 0},
+    {{0x17,0x5f,0xc0,0xd1,0x66,0x26,0xa3,0xed,0x12,0xc8,0x02,0xd7,0x4c,0xef,0x57,0x34,0x72,0xfb,0x02,0xfc,0x94,0xac,0xc8,0x5c,0xc9,0xf0,0x36,0xf5,0x30,0x28,0xc5,0xc8}, 1},
+    {{0x17,0x60,0xd8,0xcf,0x29,0x9e,0xe2,0xe2,0xdc,0x61,0xb5,0x4e,0xc9,0x47,0xa5,0xc0,0xce,0x7c,0xe5,0x33,0x54,0x5b,0x7f,0xbd,0xbd,0xdf,0x86,0x7c,0x46,0x65,0x73,0x80}, 0},
+    {{0x17,0x98,0x1b,0x69,0xcb,0xa2,0xb8,0x84,0x0e,0xbf,0xd5,0x0a,0x30,0xcb,0x7b,0xf8,0x45,0xa1,0x0a,0xc5,0xcd,0x25,0x45,0xc8,0x19,0xf1,0xb5,0x7d,0x9c,0xeb,0x08,0xdf}, 0},
+    {{0x17,0xa5,0x12,0x38,0x16,0x40,0x0f,0x7d,0x4a,0x0d,0xc9,0x88,0x56,0x6d,0xf0,0x0f,0x94,0xf2,0x55,0xf5,0x3e,0x8f,0x8b,0x7f,0x31,0x70,0x77,0x33,0x8f,0x8b,0x1b,0x9a}, 0},
+    {{0x18,0xac,0x4e,0xe5,0xb8,0x95,0xdb,0x08,0x59,0x6b,0x8d,0x0a,0xa1,0x58,0xba,0xe7,0xc9,0x5c,0x00,0xab,0x80,0x7f,0x92,0x81,0x0b,0x48,0x9b,0xde,0xc7,0x29,0x78,0x17}, 1},
+    {{0x18,0xac,0x4e,0xe5,0xb8,0x95,0xdb,0x08,0x59,0x6b,0x8d,0x0a,0xa1,0x58,0xba,0xe7,0xc9,0x5c,0x00,0xab,0x80,0x7f,0x92,0x81,0x0b,0x48,0x9b,0xde,0xc7,0x29,0x78,0x17}, 2},
+    {{0x19,0xf0,0xd2,0xa1,0x42,0x07,0x33,0x55,0xc0,0x27,0xbf,0x80,0x78,0x06,0x3c,0xb0,0xf6,0x2e,0xa3,0xe9,0x90,0x8b,0xe5,0x17,0xd3,0x6f,0xac,0x61,0xcd,0x31,0xac,0x04}, 0},
+    {{0x19,0xf0,0xd2,0xa1,0x42,0x07,0x33,0x55,0xc0,0x27,0xbf,0x80,0x78,0x06,0x3c,0xb0,0xf6,0x2e,0xa3,0xe9,0x90,0x8b,0xe5,0x17,0xd3,0x6f,0xac,0x61,0xcd,0x31,0xac,0x04}, 1},
+    {{0x1a,0x5d,0xe0,0x58,0xfe,0xe6,0x48,0xf8,0x56,0xf6,0xfe,0xb9,0xc7,0x15,0x97,0x52,0x1a,0x68,0x34,0xd7,0xb3,0x7a,0xde,0xa8,0xde,0x2e,0x27,0xea,0xf4,0xa7,0x41,0x50}, 0},
+    {{0x1a,0x5d,0xe0,0x58,0xfe,0xe6,0x48,0xf8,0x56,0xf6,0xfe,0xb9,0xc7,0x15,0x97,0x52,0x1a,0x68,0x34,0xd7,0xb3,0x7a,0xde,0xa8,0xde,0x2e,0x27,0xea,0xf4,0xa7,0x41,0x50}, 1},
+    {{0x1a,0x98,0xd8,0x57,0xe6,0xb2,0xfe,0x4c,0xc8,0x56,0x34,0x5a,0xee,0xa2,0xed,0x9b,0xae,0x2f,0x07,0xe2,0x7a,0xbf,0x6e,0x97,0x30,0xeb,0x65,0xaa,0xef,0x18,0x3c,0xdb}, 0},
+    {{0x1a,0xae,0x24,0xca,0x29,0xb5,0x6b,0xed,0xf2,0x85,0xaa,0x8f,0x83,0x9c,0xc8,0x29,0xd0,0xe9,0xce,0xc9,0x40,0xff,0x6c,0x05,0xe0,0x3f,0x83,0x9d,0x77,0xc3,0x3b,0x87}, 0},
+    {{0x1a,0xae,0x24,0xca,0x29,0xb5,0x6b,0xed,0xf2,0x85,0xaa,0x8f,0x83,0x9c,0xc8,0x29,0xd0,0xe9,0xce,0xc9,0x40,0xff,0x6c,0x05,0xe0,0x3f,0x83,0x9d,0x77,0xc3,0x3b,0x87}, 1},
+    {{0x1b,0x0e,0xf5,0x67,0x5f,0xca,0xc1,0x84,0x92,0x61,0xb6,0x7b,0xa7,0x5f,0x5f,0x99,0x35,0xf9,0x92,0x02,0xe6,0x74,0x5f,0xb1,0x8a,0x81,0x76,0xe8,0x31,0xc3,0x00,0xe4}, 0},
+    {{0x1b,0x29,0x70,0xe7,0x62,0xc4,0x00,0xfe,0x56,0x2a,0x20,0x3e,0x54,0xce,0x07,0x84,0xff,0x84,0x1d,0x3e,0x79,0xd8,0xc4,0xb0,0x1f,0x69,0x2e,0x9f,0xb0,0x8e,0x7d,0x23}, 0},
+    {{0x1b,0x56,0xff,0xa4,0x88,0x78,0x7f,0xc0,0xf4,0xb5,0x5d,0x44,0x38,0xd9,0xe6,0xce,0xc9,0x60,0xe2,0x4a,0x5c,0x2a,0x32,0x37,0x9d,0x27,0xef,0x75,0xa7,0x68,0xd5,0x57}, 0},
+    {{0x1b,0x5a,0xf1,0xfb,0x32,0x3d,0x28,0x5b,0x10,0xe5,0x0b,0xef,0xfb,0x25,0xb9,0x5c,0xee,0xb4,0x61,0xb6,0x0f,0x8c,0x24,0x5c,0x46,0x24,0x41,0xa5,0x78,0x31,0x5a,0xad}, 0},
+    {{0x1b,0x5a,0xf1,0xfb,0x32,0x3d,0x28,0x5b,0x10,0xe5,0x0b,0xef,0xfb,0x25,0xb9,0x5c,0xee,0xb4,0x61,0xb6,0x0f,0x8c,0x24,0x5c,0x46,0x24,0x41,0xa5,0x78,0x31,0x5a,0xad}, 1},
+    {{0x1b,0x67,0xea,0xe4,0xd6,0x95,0xfb,0xbf,0x8c,0xf7,0xd3,0xb4,0x98,0xb9,0x04,0xc6,0xc7,0xea,0xe4,0x87,0x5e,0xe1,0x90,0x01,0xe8,0x9a,0xe5,0x4f,0xfb,0xa2,0x96,0x1a}, 0},
+    {{0x1b,0x67,0xea,0xe4,0xd6,0x95,0xfb,0xbf,0x8c,0xf7,0xd3,0xb4,0x98,0xb9,0x04,0xc6,0xc7,0xea,0xe4,0x87,0x5e,0xe1,0x90,0x01,0xe8,0x9a,0xe5,0x4f,0xfb,0xa2,0x96,0x1a}, 1},
+    {{0x1b,0x88,0x64,0x1b,0x22,0xe0,0x58,0xe8,0x52,0x89,0x55,0x7b,0xc2,0xc4,0xec,0xf1,0x3e,0x23,0x1e,0x08,0xbb,0x53,0x40,0x77,0x6e,0x19,0x32,0x8f,0x87,0x9b,0x02,0x74}, 0},
+    {{0x1b,0x89,0x69,0x76,0x66,0xa1,0x2b,0xa6,0x35,0x89,0x41,0xba,0x51,0x69,0x10,0x59,0x57,0x0f,0x2c,0x33,0xf7,0x30,0x2b,0x0c,0xfe,0x5c,0xf0,0xec,0x00,0x68,0xf0,0x6c}, 0},
+    {{0x1b,0x89,0x69,0x76,0x66,0xa1,0x2b,0xa6,0x35,0x89,0x41,0xba,0x51,0x69,0x10,0x59,0x57,0x0f,0x2c,0x33,0xf7,0x30,0x2b,0x0c,0xfe,0x5c,0xf0,0xec,0x00,0x68,0xf0,0x6c}, 1},
+    {{0x1b,0x8b,0x71,0xba,0x48,0x05,0x94,0x02,0xf7,0xf5,0x69,0xf2,0xb7,0x69,0x01,0x21,0xdc,0xd6,0x79,0x16,0x01,0x91,0xd1,0x17,0x9f,0x55,0x43,0xea,0x02,0xbf,0x37,0x75}, 0},
+    {{0x1b,0x8b,0x71,0xba,0x48,0x05,0x94,0x02,0xf7,0xf5,0x69,0xf2,0xb7,0x69,0x01,0x21,0xdc,0xd6,0x79,0x16,0x01,0x91,0xd1,0x17,0x9f,0x55,0x43,0xea,0x02,0xbf,0x37,0x75}, 1},
+    {{0x1b,0x90,0x71,0x72,0x10,0x99,0x45,0xc7,0x84,0x62,0x05,0xb8,0x1d,0xfc,0xdd,0x53,0x8b,0xda,0x7a,0x21,0x33,0x3b,0xf5,0x31,0x18,0xc2,0x6e,0x6a,0xc6,0xcf,0xe8,0x55}, 0},
+    {{0x1b,0x90,0x71,0x72,0x10,0x99,0x45,0xc7,0x84,0x62,0x05,0xb8,0x1d,0xfc,0xdd,0x53,0x8b,0xda,0x7a,0x21,0x33,0x3b,0xf5,0x31,0x18,0xc2,0x6e,0x6a,0xc6,0xcf,0xe8,0x55}, 1},
+    {{0x1b,0xa6,0x87,0x08,0x7a,0xcf,0xcd,0x01,0x6d,0x07,0xf7,0x64,0xfe,0x8f,0xa5,0xed,0xe8,0x2a,0x5e,0x63,0xe9,0xab,0x4d,0x02,0x10,0x76,0x5f,0xcc,0xb6,0xad,0xf4,0x9d}, 0},
+    {{0x1b,0xa6,0x87,0x08,0x7a,0xcf,0xcd,0x01,0x6d,0x07,0xf7,0x64,0xfe,0x8f,0xa5,0xed,0xe8,0x2a,0x5e,0x63,0xe9,0xab,0x4d,0x02,0x10,0x76,0x5f,0xcc,0xb6,0xad,0xf4,0x9d}, 1},
+    {{0x1b,0xb9,0xff,0x9d,0xd9,0x1f,0x67,0xc4,0x87,0x73,0xf6,0xd8,0xb0,0xbd,0x39,0x36,0x6f,0x04,0x58,0x9b,0x1d,0xfa,0xac,0x28,0xe6,0xc0,0x8c,0xaa,0xc0,0x23,0x9d,0x83}, 0},
+    {{0x1b,0xb9,0xff,0x9d,0xd9,0x1f,0x67,0xc4,0x87,0x73,0xf6,0xd8,0xb0,0xbd,0x39,0x36,0x6f,0x04,0x58,0x9b,0x1d,0xfa,0xac,0x28,0xe6,0xc0,0x8c,0xaa,0xc0,0x23,0x9d,0x83}, 1},
+    {{0x1b,0xc3,0xfc,0x1f,0x60,0xed,0x28,0x6e,0x3b,0x21,0xfb,0x05,0xae,0x60,0x21,0xf5,0x26,0xb3,0x3e,0x66,0x11,0xa7,0x94,0xcb,0x90,0x80,0xd7,0xd1,0x7f,0x61,0xd7,0x96}, 0},
+    {{0x1b,0xec,0xdf,0x69,0xd7,0x87,0x8c,0x7e,0x7b,0x23,0x0d,0x4f,0xef,0xa6,0xd6,0x24,0xb9,0x5a,0x16,0x52,0xf3,0x3e,0xdf,0x0a,0x9a,0x53,0x98,0xf0,0x05,0x6f,0xa6,0xbf}, 0},
+    {{0x1b,0xec,0xdf,0x69,0xd7,0x87,0x8c,0x7e,0x7b,0x23,0x0d,0x4f,0xef,0xa6,0xd6,0x24,0xb9,0x5a,0x16,0x52,0xf3,0x3e,0xdf,0x0a,0x9a,0x53,0x98,0xf0,0x05,0x6f,0xa6,0xbf}, 1},
+    {{0x1c,0x0f,0xa1,0xb6,0x6b,0x4f,0x44,0x41,0xe9,0x5f,0xbe,0x4a,0x4c,0xcc,0x05,0x6b,0x1d,0x82,0x8c,0x73,0xba,0xbd,0x7a,0x6d,0x08,0xf1,0xc4,0x6a,0xb8,0xa8,0x4d,0x3f}, 0},
+    {{0x1c,0x4e,0x19,0xb2,0xab,0xb9,0x63,0xa8,0x6e,0xe3,0x49,0xd5,0x1b,0x37,0xad,0x6f,0x2c,0xb3,0xb5,0x54,0x75,0x70,0x35,0x80,0x01,0x04,0xab,0x7b,0x6e,0x8c,0x62,0x06}, 0},
+    {{0x1c,0x4e,0x19,0xb2,0xab,0xb9,0x63,0xa8,0x6e,0xe3,0x49,0xd5,0x1b,0x37,0xad,0x6f,0x2c,0xb3,0xb5,0x54,0x75,0x70,0x35,0x80,0x01,0x04,0xab,0x7b,0x6e,0x8c,0x62,0x06}, 1},
+    {{0x1c,0x63,0x1c,0x51,0x5c,0x61,0x6f,0x9b,0x73,0x26,0xab,0x06,0x0c,0x76,0x79,0xb5,0x90,0x6f,0x92,0xe8,0xa7,0xc8,0xaf,0xab,0x68,0xa3,0x19,0xe4,0x6b,0x1c,0xf8,0x25}, 0},
+    {{0x1c,0x74,0xf1,0xdb,0x1a,0xb4,0x38,0x4f,0xeb,0xff,0xb8,0x95,0xf8,0x5a,0x98,0x28,0xee,0x7b,0x41,0xdb,0x54,0x89,0x10,0xf9,0x1c,0x45,0xb3,0x41,0xda,0x37,0x7f,0x80}, 0},
+    {{0x1c,0x74,0xf1,0xdb,0x1a,0xb4,0x38,0x4f,0xeb,0xff,0xb8,0x95,0xf8,0x5a,0x98,0x28,0xee,0x7b,0x41,0xdb,0x54,0x89,0x10,0xf9,0x1c,0x45,0xb3,0x41,0xda,0x37,0x7f,0x80}, 1},
+    {{0x1c,0x90,0x22,0x7b,0xf3,0xe9,0xd2,0x09,0x0e,0x70,0xa8,0x30,0x31,0x39,0xa3,0x98,0xfb,0xdb,0xd0,0xca,0xeb,0xaf,0x1e,0x4d,0xa7,0xcc,0x15,0x02,0x42,0x25,0xe4,0xfe}, 0},
+    {{0x1c,0x90,0x22,0x7b,0xf3,0xe9,0xd2,0x09,0x0e,0x70,0xa8,0x30,0x31,0x39,0xa3,0x98,0xfb,0xdb,0xd0,0xca,0xeb,0xaf,0x1e,0x4d,0xa7,0xcc,0x15,0x02,0x42,0x25,0xe4,0xfe}, 1},
+    {{0x1c,0xb5,0x84,0xec,0xeb,0xb4,0xe6,0x2c,0xd5,0x78,0xe5,0xa1,0xc5,0x83,0x89,0x39,0xb0,0x42,0x4a,0xfd,0xb4,0xa6,0xbb,0x64,0x4d,0x91,0x9a,0x73,0x5b,0x88,0x2e,0x65}, 0},
+    {{0x1c,0xb5,0x84,0xec,0xeb,0xb4,0xe6,0x2c,0xd5,0x78,0xe5,0xa1,0xc5,0x83,0x89,0x39,0xb0,0x42,0x4a,0xfd,0xb4,0xa6,0xbb,0x64,0x4d,0x91,0x9a,0x73,0x5b,0x88,0x2e,0x65}, 1},
+    {{0x1d,0x81,0x3f,0x37,0xfa,0xd1,0x02,0x7e,0xa9,0x16,0x9d,0x30,0x1e,0x11,0xdc,0xf4,0x58,0x9d,0x58,0x6c,0xae,0x5f,0x6a,0xa1,0x13,0x96,0x01,0x2b,0x96,0xd7,0x20,0x1f}, 0},
+    {{0x1d,0x9a,0xb7,0x0a,0x77,0xa5,0x2d,0xbb,0xc8,0x76,0xdb,0x95,0xd1,0xd5,0xc7,0xd7,0xd5,0x36,0x5b,0x2a,0x19,0x7a,0x71,0x2a,0x61,0xae,0x5c,0xd7,0xc4,0xca,0x22,0x06}, 0},
+    {{0x1d,0xbd,0x8c,0x31,0x27,0x27,0x1a,0x32,0xbd,0x93,0x0f,0x0c,0xd9,0x08,0xc3,0xa0,0xfe,0x0b,0xb7,0xdd,0x42,0x65,0xa9,0xca,0x69,0x8e,0xb1,0xa6,0xfb,0x11,0x8b,0x81}, 0},
+    {{0x1d,0xbd,0x8c,0x31,0x27,0x27,0x1a,0x32,0xbd,0x93,0x0f,0x0c,0xd9,0x08,0xc3,0xa0,0xfe,0x0b,0xb7,0xdd,0x42,0x65,0xa9,0xca,0x69,0x8e,0xb1,0xa6,0xfb,0x11,0x8b,0x81}, 1},
+    {{0x1e,0x21,0xa5,0xa5,0x1f,0x4e,0x8e,0xb6,0x06,0xef,0x20,0x64,0x5c,0xbd,0x64,0x4b,0xf5,0x55,0x71,0xe8,0x7a,0x5e,0x6d,0x3c,0x06,0x84,0x98,0x24,0x5e,0x98,0xf8,0xd9}, 0},
+    {{0x1e,0x4f,0x49,0x38,0x6e,0xf4,0x5d,0x79,0x9f,0x09,0x42,0x4a,0xe5,0xcc,0x45,0xea,0x87,0xcd,0x17,0xaf,0x50,0x78,0xf2,0xfc,0x0d,0x8a,0x27,0x09,0x7f,0xc7,0xc5,0xfb}, 0},
+    {{0x1e,0x66,0x77,0x65,0x84,0x66,0x93,0xd2,0xeb,0x00,0x27,0x9c,0x2b,0xb2,0x51,0xe4,0x76,0xc8,0x07,0xfa,0xbf,0xc3,0xce,0x65,0x40,0xdc,0x10,0x28,0x00,0x99,0x60,0x0a}, 0},
+    {{0x1e,0x66,0x77,0x65,0x84,0x66,0x93,0xd2,0xeb,0x00,0x27,0x9c,0x2b,0xb2,0x51,0xe4,0x76,0xc8,0x07,0xfa,0xbf,0xc3,0xce,0x65,0x40,0xdc,0x10,0x28,0x00,0x99,0x60,0x0a}, 1},
+    {{0x1f,0x46,0xd4,0xf1,0xd9,0xf0,0x65,0xe2,0x0d,0x9e,0xdc,0x4e,0x31,0xb5,0x63,0x3c,0xc2,0x90,0x07,0x74,0xb6,0x5c,0xd3,0x71,0xff,0xf5,0xb2,0xe5,0x59,0x25,0xc4,0xdc}, 0},
+    {{0x1f,0xac,0x79,0x5b,0x6f,0xab,0x4a,0xbd,0x17,0x0f,0x4b,0x18,0xf3,0x54,0xa0,0x9f,0xed,0x9d,0x98,0xbd,0x4e,0x0b,0x25,0x79,0x23,0x80,0xd9,0x89,0xf3,0x97,0xc5,0x9b}, 0},
+    {{0x1f,0xac,0x79,0x5b,0x6f,0xab,0x4a,0xbd,0x17,0x0f,0x4b,0x18,0xf3,0x54,0xa0,0x9f,0xed,0x9d,0x98,0xbd,0x4e,0x0b,0x25,0x79,0x23,0x80,0xd9,0x89,0xf3,0x97,0xc5,0x9b}, 1},
+    {{0x1f,0xf6,0xee,0x92,0x6b,0x13,0xa6,0x40,0x22,0xed,0x9c,0x88,0x4d,0x62,0xcd,0xc9,0xfd,0xaa,0x14,0x37,0x9c,0x53,0xd1,0x20,0xc4,0x30,0x20,0xb9,0xc6,0x0c,0x6f,0xac}, 0},
+    {{0x20,0x09,0x22,0x11,0x1d,0x24,0xc3,0xfc,0xf4,0xa7,0x53,0x49,0xc7,0xa8,0xe6,0x4b,0x11,0x61,0xf9,0xd4,0x21,0xdf,0x36,0xfa,0x4e,0x41,0x40,0x08,0xb1,0x13,0xd3,0x75}, 0},
+    {{0x20,0x09,0x22,0x11,0x1d,0x24,0xc3,0xfc,0xf4,0xa7,0x53,0x49,0xc7,0xa8,0xe6,0x4b,0x11,0x61,0xf9,0xd4,0x21,0xdf,0x36,0xfa,0x4e,0x41,0x40,0x08,0xb1,0x13,0xd3,0x75}, 1},
+    {{0x20,0x72,0x7a,0x1d,0xf9,0x57,0x7f,0x07,0x13,0x62,0x0a,0x59,0x10,0xe9,0xb3,0xc1,0x08,0xf2,0xe3,0xee,0x94,0x19,0x4e,0x07,0xd4,0x9c,0x2f,0x08,0x33,0xbb,0x17,0xd6}, 0},
+    {{0x20,0x72,0x7a,0x1d,0xf9,0x57,0x7f,0x07,0x13,0x62,0x0a,0x59,0x10,0xe9,0xb3,0xc1,0x08,0xf2,0xe3,0xee,0x94,0x19,0x4e,0x07,0xd4,0x9c,0x2f,0x08,0x33,0xbb,0x17,0xd6}, 1},
+    {{0x20,0x79,0x62,0x2e,0xe4,0xa8,0x62,0x1e,0xa3,0x9a,0xe4,0xc6,0x16,0xea,0xaa,0x76,0xfc,0xc5,0xf2,0xf2,0xd2,0xda,0xc6,0xf2,0xc9,0x58,0xb4,0x20,0x4d,0x90,0xfd,0x9b}, 0},
+    {{0x20,0x79,0x62,0x2e,0xe4,0xa8,0x62,0x1e,0xa3,0x9a,0xe4,0xc6,0x16,0xea,0xaa,0x76,0xfc,0xc5,0xf2,0xf2,0xd2,0xda,0xc6,0xf2,0xc9,0x58,0xb4,0x20,0x4d,0x90,0xfd,0x9b}, 1},
+    {{0x20,0x9d,0x49,0xd2,0x03,0x9d,0x92,0x35,0x62,0xf5,0x6b,0xb4,0x09,0x55,0x7e,0x04,0xc9,0xf8,0xc1,0x08,0x14,0x88,0x74,0xea,0x96,0x0d,0xf1,0xcd,0xcd,0x64,0xac,0x5a}, 0},
+    {{0x20,0x9d,0x49,0xd2,0x03,0x9d,0x92,0x35,0x62,0xf5,0x6b,0xb4,0x09,0x55,0x7e,0x04,0xc9,0xf8,0xc1,0x08,0x14,0x88,0x74,0xea,0x96,0x0d,0xf1,0xcd,0xcd,0x64,0xac,0x5a}, 1},
+    {{0x20,0xc3,0x5c,0x92,0x66,0xc2,0xec,0x8f,0x4e,0x12,0x44,0x11,0x1a,0x38,0xde,0xba,0x32,0x1a,0x4d,0x1b,0x11,0x09,0xe0,0xbf,0x75,0x96,0xcd,0x2e,0x85,0x7c,0x4c,0x27}, 0},
+    {{0x20,0xc3,0x5c,0x92,0x66,0xc2,0xec,0x8f,0x4e,0x12,0x44,0x11,0x1a,0x38,0xde,0xba,0x32,0x1a,0x4d,0x1b,0x11,0x09,0xe0,0xbf,0x75,0x96,0xcd,0x2e,0x85,0x7c,0x4c,0x27}, 1},
+    {{0x20,0xf4,0x95,0x5a,0x1c,0x5a,0xa3,0xe2,0x88,0x18,0x59,0x0b,0x14,0xc0,0x04,0xea,0xbc,0x03,0xab,0x52,0xfd,0xf4,0x85,0xb1,0x3f,0x6f,0xbf,0xfc,0x9a,0x21,0x14,0x13}, 0},
+    {{0x20,0xf4,0x95,0x5a,0x1c,0x5a,0xa3,0xe2,0x88,0x18,0x59,0x0b,0x14,0xc0,0x04,0xea,0xbc,0x03,0xab,0x52,0xfd,0xf4,0x85,0xb1,0x3f,0x6f,0xbf,0xfc,0x9a,0x21,0x14,0x13}, 1},
+    {{0x21,0x0c,0xc1,0xa1,0x23,0xb4,0x5a,0x46,0xc1,0xd3,0x84,0x30,0x79,0x93,0x49,0x2f,0x00,0x7d,0xf5,0xe1,0x91,0x2e,0x15,0x90,0xae,0xff,0xf9,0xc6,0x97,0xd1,0x80,0xa9}, 0},
+    {{0x21,0x41,0xa7,0x69,0x64,0xde,0x8e,0x3c,0xfa,0x4b,0x38,0x00,0x86,0xec,0x31,0xd9,0x5f,0xe2,0x27,0xd1,0x03,0x28,0x47,0xd6,0x2b,0x33,0xa7,0xed,0x1f,0x40,0xa1,0x81}, 0},
+    {{0x21,0x41,0xa7,0x69,0x64,0xde,0x8e,0x3c,0xfa,0x4b,0x38,0x00,0x86,0xec,0x31,0xd9,0x5f,0xe2,0x27,0xd1,0x03,0x28,0x47,0xd6,0x2b,0x33,0xa7,0xed,0x1f,0x40,0xa1,0x81}, 1},
+    {{0x21,0x43,0x22,0x3f,0x03,0x49,0x5b,0xa5,0x51,0x2e,0xee,0xe7,0xa4,0x84,0x23,0x31,0x82,0xbf,0x7a,0xfb,0x3e,0x30,0x9a,0xa2,0x0f,0x10,0x2e,0xf4,0xb3,0x71,0x61,0x39}, 0},
+    {{0x21,0x43,0x22,0x3f,0x03,0x49,0x5b,0xa5,0x51,0x2e,0xee,0xe7,0xa4,0x84,0x23,0x31,0x82,0xbf,0x7a,0xfb,0x3e,0x30,0x9a,0xa2,0x0f,0x10,0x2e,0xf4,0xb3,0x71,0x61,0x39}, 1},
+    {{0x21,0xb3,0xbf,0x4c,0x52,0xb0,0xe0,0xcc,0x30,0xbc,0x9b,0xe3,0xd7,0x67,0x2a,0x29,0x2e,0x19,0xf9,0x9d,0x71,0xd4,0x34,0x9a,0xf9,0x66,0x5a,0x7c,0x01,0x1c,0x50,0x08}, 0},
+    {{0x21,0xb3,0xbf,0x4c,0x52,0xb0,0xe0,0xcc,0x30,0xbc,0x9b,0xe3,0xd7,0x67,0x2a,0x29,0x2e,0x19,0xf9,0x9d,0x71,0xd4,0x34,0x9a,0xf9,0x66,0x5a,0x7c,0x01,0x1c,0x50,0x08}, 1},
+    {{0x21,0xc9,0x06,0x17,0xb9,0x03,0x21,0x6f,0x8e,0xc4,0xc3,0xaf,0xda,0x70,0x6c,0xb0,0x23,0x08,0xa4,0x3f,0x18,0x2c,0x20,0x51,0xa0,0xd9,0x7a,0x51,0xa6,0x0d,0x6b,0x25}, 0},
+    {{0x21,0xd5,0xbe,0x33,0x1d,0xa8,0x7a,0xc2,0xb9,0xe3,0xbc,0x17,0x22,0x8b,0x73,0xd3,0x19,0x86,0x32,0x2b,0x65,0x90,0xf3,0x17,0x63,0x53,0x6d,0x1b,0x02,0x59,0xf3,0xdc}, 0},
+    {{0x21,0xd5,0xbe,0x33,0x1d,0xa8,0x7a,0xc2,0xb9,0xe3,0xbc,0x17,0x22,0x8b,0x73,0xd3,0x19,0x86,0x32,0x2b,0x65,0x90,0xf3,0x17,0x63,0x53,0x6d,0x1b,0x02,0x59,0xf3,0xdc}, 1},
+    {{0x21,0xfa,0x7a,0xbd,0x06,0xe7,0xf4,0x8d,0x99,0x1d,0x8f,0xd5,0x55,0x18,0x0e,0xca,0x53,0xd4,0xf6,0xdc,0xe6,0x42,0xcc,0x94,0x13,0x36,0xaa,0xd6,0x2a,0x8b,0xc0,0x28}, 0},
+    {{0x21,0xfa,0x7a,0xbd,0x06,0xe7,0xf4,0x8d,0x99,0x1d,0x8f,0xd5,0x55,0x18,0x0e,0xca,0x53,0xd4,0xf6,0xdc,0xe6,0x42,0xcc,0x94,0x13,0x36,0xaa,0xd6,0x2a,0x8b,0xc0,0x28}, 1},
+    {{0x22,0x50,0x19,0x02,0x92,0x18,0xa0,0xd5,0x40,0xb8,0xd7,0x61,0x11,0xdc,0x93,0xd8,0x95,0x18,0x0f,0xe8,0x48,0xdd,0xce,0xd3,0xc1,0xbb,0xf3,0x51,0x4d,0x67,0x7f,0xda}, 0},
+    {{0x22,0xc5,0xd8,0x50,0xbc,0xd1,0x6b,0xab,0x7d,0xfa,0xc0,0xd8,0x56,0xbb,0xb4,0xc1,0x8e,0x5d,0x36,0x07,0x9f,0x3f,0xa1,0x19,0x6c,0x73,0x96,0x5b,0x2c,0x9b,0x9b,0x19}, 0},
+    {{0x22,0xc5,0xd8,0x50,0xbc,0xd1,0x6b,0xab,0x7d,0xfa,0xc0,0xd8,0x56,0xbb,0xb4,0xc1,0x8e,0x5d,0x36,0x07,0x9f,0x3f,0xa1,0x19,0x6c,0x73,0x96,0x5b,0x2c,0x9b,0x9b,0x19}, 1},
+    {{0x22,0xda,0x0b,0x28,0x83,0x51,0x27,0xdb,0xe6,0x30,0x2e,0xf0,0xb7,0xe8,0x6b,0x56,0x45,0x52,0x41,0x9c,0x10,0xc9,0x7a,0x3d,0x5a,0x05,0xe6,0x31,0xbc,0x5b,0x62,0x45}, 0},
+    {{0x22,0xda,0x0b,0x28,0x83,0x51,0x27,0xdb,0xe6,0x30,0x2e,0xf0,0xb7,0xe8,0x6b,0x56,0x45,0x52,0x41,0x9c,0x10,0xc9,0x7a,0x3d,0x5a,0x05,0xe6,0x31,0xbc,0x5b,0x62,0x45}, 1},
+    {{0x23,0x7b,0x2c,0x79,0xbd,0x35,0xa9,0xd7,0x15,0x98,0xe4,0x57,0x77,0x60,0x1e,0xed,0x27,0xc8,0x9b,0x80,0xc9,0xb6,0x7b,0x8b,0xaf,0x88,0x19,0x26,0xda,0x3b,0x06,0xb1}, 0},
+    {{0x23,0x8e,0xeb,0xe8,0x99,0xbd,0xe5,0x03,0x8d,0x46,0x2c,0x77,0xc4,0x7c,0x86,0x13,0x76,0x5d,0x45,0xe5,0x31,0x42,0x48,0x38,0xb5,0x0e,0x70,0x84,0xf6,0xd2,0x7a,0x01}, 0},
+    {{0x23,0xb9,0x19,0xa2,0x47,0xda,0xe8,0x4f,0x01,0x3a,0x87,0x07,0xde,0x8d,0x80,0xe2,0xf9,0xb5,0x61,0x70,0xe4,0x71,0xe7,0x91,0x0d,0xc1,0x6a,0x90,0x99,0x03,0x22,0x4b}, 0},
+    {{0x23,0xb9,0x19,0xa2,0x47,0xda,0xe8,0x4f,0x01,0x3a,0x87,0x07,0xde,0x8d,0x80,0xe2,0xf9,0xb5,0x61,0x70,0xe4,0x71,0xe7,0x91,0x0d,0xc1,0x6a,0x90,0x99,0x03,0x22,0x4b}, 1},
+    {{0x23,0xf6,0x24,0x90,0x8e,0xbc,0x39,0xd3,0x44,0x23,0x06,0x6d,0xff,0xec,0xac,0xe5,0x18,0x2c,0xac,0xe4,0xbd,0xa3,0xa2,0xca,0x45,0x3e,0x45,0x8d,0x76,0xae,0x1e,0xd6}, 0},
+    {{0x23,0xf6,0x24,0x90,0x8e,0xbc,0x39,0xd3,0x44,0x23,0x06,0x6d,0xff,0xec,0xac,0xe5,0x18,0x2c,0xac,0xe4,0xbd,0xa3,0xa2,0xca,0x45,0x3e,0x45,0x8d,0x76,0xae,0x1e,0xd6}, 1},
+    {{0x24,0x32,0x3c,0xa1,0x84,0x3e,0x90,0x02,0x70,0x49,0xf0,0x66,0xd0,0x24,0x86,0xf1,0x4a,0x79,0x14,0xa4,0x9f,0x95,0x05,0x3b,0x10,0xd7,0x51,0x2d,0xd1,0x89,0x6e,0x8d}, 0},
+    {{0x24,0x32,0x3c,0xa1,0x84,0x3e,0x90,0x02,0x70,0x49,0xf0,0x66,0xd0,0x24,0x86,0xf1,0x4a,0x79,0x14,0xa4,0x9f,0x95,0x05,0x3b,0x10,0xd7,0x51,0x2d,0xd1,0x89,0x6e,0x8d}, 1},
+    {{0x24,0x41,0x02,0x25,0x21,0x49,0xde,0x07,0xc4,0xbe,0xb7,0x2a,0xdf,0x6a,0x06,0xab,0xed,0x5b,0x1c,0x69,0x49,0x11,0x39,0x46,0x08,0x35,0x23,0x9e,0xfb,0xfa,0x2b,0xc5}, 0},
+    {{0x24,0x4a,0xd6,0x40,0xb1,0x46,0xe0,0xb9,0x95,0x7c,0x50,0xcd,0x53,0xe9,0xce,0xbb,0xee,0x5b,0x69,0x6e,0x35,0xe3,0xcf,0x9d,0x4e,0xef,0xff,0x4f,0xf1,0x9b,0x47,0x78}, 0},
+    {{0x24,0x4a,0xd6,0x40,0xb1,0x46,0xe0,0xb9,0x95,0x7c,0x50,0xcd,0x53,0xe9,0xce,0xbb,0xee,0x5b,0x69,0x6e,0x35,0xe3,0xcf,0x9d,0x4e,0xef,0xff,0x4f,0xf1,0x9b,0x47,0x78}, 1},
+    {{0x24,0xfe,0x40,0xa2,0x0e,0xb0,0x31,0xa7,0x8f,0x29,0x6d,0xd5,0x3c,0xdb,0x61,0x9f,0x21,0xc9,0x2f,0x0a,0x84,0x4a,0x94,0x8d,0x73,0xf2,0x35,0x66,0x04,0x6f,0x85,0xa5}, 0},
+    {{0x24,0xfe,0x40,0xa2,0x0e,0xb0,0x31,0xa7,0x8f,0x29,0x6d,0xd5,0x3c,0xdb,0x61,0x9f,0x21,0xc9,0x2f,0x0a,0x84,0x4a,0x94,0x8d,0x73,0xf2,0x35,0x66,0x04,0x6f,0x85,0xa5}, 1},
+    {{0x25,0x4e,0xa0,0xb3,0xf3,0x24,0xce,0x68,0xe7,0x2e,0x9f,0x10,0x2b,0x42,0x95,0xff,0x77,0x23,0xaf,0x56,0xcb,0x64,0x92,0xd0,0xe6,0x9d,0x39,0xe6,0x78,0xe7,0x18,0xbb}, 0},
+    {{0x25,0x4e,0xa0,0xb3,0xf3,0x24,0xce,0x68,0xe7,0x2e,0x9f,0x10,0x2b,0x42,0x95,0xff,0x77,0x23,0xaf,0x56,0xcb,0x64,0x92,0xd0,0xe6,0x9d,0x39,0xe6,0x78,0xe7,0x18,0xbb}, 1},
+    {{0x25,0x9d,0xf8,0x0e,0xe6,0x5c,0xa8,0x9f,0x54,0xf0,0x17,0xa8,0x09,0x6c,0x05,0x0c,0x5c,0xd3,0xdc,0x50,0x1c,0xcc,0x01,0x34,0x61,0xf9,0xb6,0xe2,0xd0,0x57,0x77,0x10}, 0},
+    {{0x25,0xc6,0xc4,0xbc,0x35,0xa5,0xc8,0x0b,0xed,0x8e,0xc8,0xeb,0xd0,0x9e,0xd3,0x8a,0x66,0x98,0x6e,0x57,0x82,0xe6,0x86,0x25,0x3f,0x7e,0x46,0xf5,0x05,0xc3,0xe1,0xa6}, 1},
+    {{0x26,0x7e,0x22,0xf3,0x3e,0xa0,0x1d,0x0a,0xc6,0x90,0x11,0x09,0x8a,0xdd,0x6c,0x72,0x53,0x26,0x10,0x10,0xec,0xf8,0xb6,0xaf,0xb3,0x75,0xf7,0x01,0x6e,0xcf,0x73,0x9b}, 0},
+    {{0x26,0x7e,0x22,0xf3,0x3e,0xa0,0x1d,0x0a,0xc6,0x90,0x11,0x09,0x8a,0xdd,0x6c,0x72,0x53,0x26,0x10,0x10,0xec,0xf8,0xb6,0xaf,0xb3,0x75,0xf7,0x01,0x6e,0xcf,0x73,0x9b}, 1},
+    {{0x27,0x27,0xca,0x42,0x1c,0xa8,0x4f,0x8d,0xa0,0x70,0x51,0x5b,0xed,0x82,0x0a,0x48,0x74,0xd7,0x1f,0x11,0xf1,0x41,0x45,0xf4,0xc9,0xa2,0x3a,0xfd,0xce,0xfd,0x60,0x37}, 0},
+    {{0x27,0x44,0xdc,0x3f,0x78,0x5c,0xd6,0xbf,0xbb,0x66,0xee,0xb3,0x47,0x3e,0x11,0x82,0xa1,0xb1,0x70,0x7b,0xf4,0xad,0x6d,0x2c,0x2d,0xb0,0x7b,0xa7,0x9b,0xc7,0xf4,0x51}, 0},
+    {{0x27,0x44,0xdc,0x3f,0x78,0x5c,0xd6,0xbf,0xbb,0x66,0xee,0xb3,0x47,0x3e,0x11,0x82,0xa1,0xb1,0x70,0x7b,0xf4,0xad,0x6d,0x2c,0x2d,0xb0,0x7b,0xa7,0x9b,0xc7,0xf4,0x51}, 1},
+    {{0x27,0x5b,0xb4,0xe1,0x78,0xc1,0x47,0xbf,0xa4,0x51,0x96,0x10,0x99,0x83,0x82,0x12,0x1c,0xae,0x9a,0x34,0x96,0xe1,0xff,0x0b,0xa0,0x40,0x64,0x0a,0x54,0x49,0xa1,0xd4}, 1},
+    {{0x28,0x21,0x7e,0x0c,0xda,0x60,0x43,0x00,0x28,0xa2,0xfd,0xde,0x1b,0x4b,0xd2,0x21,0x94,0x09,0xc7,0x0f,0xed,0xc4,0xbd,0xb8,0x8e,0x5e,0xee,0xc7,0xb0,0x6c,0x17,0x48}, 0},
+    {{0x28,0x21,0x7e,0x0c,0xda,0x60,0x43,0x00,0x28,0xa2,0xfd,0xde,0x1b,0x4b,0xd2,0x21,0x94,0x09,0xc7,0x0f,0xed,0xc4,0xbd,0xb8,0x8e,0x5e,0xee,0xc7,0xb0,0x6c,0x17,0x48}, 1},
+    {{0x29,0x5d,0xb7,0x4a,0xb3,0x07,0xe9,0x6d,0x76,0xd1,0x39,0xc1,0xa2,0xb8,0xdd,0xe8,0xcb,0x8d,0xda,0xa6,0xdd,0x38,0x86,0x54,0xb3,0x6a,0x5b,0x00,0x27,0xc1,0x4a,0xaf}, 0},
+    {{0x29,0x5d,0xb7,0x4a,0xb3,0x07,0xe9,0x6d,0x76,0xd1,0x39,0xc1,0xa2,0xb8,0xdd,0xe8,0xcb,0x8d,0xda,0xa6,0xdd,0x38,0x86,0x54,0xb3,0x6a,0x5b,0x00,0x27,0xc1,0x4a,0xaf}, 1},
+    {{0x2a,0x03,0xa1,0xad,0x02,0x83,0x2a,0x58,0xac,0x72,0x5b,0xbb,0xa6,0xd4,0x2d,0x9e,0x59,0x5d,0xe7,0x6c,0x05,0xbc,0xc7,0xc0,0xd3,0x13,0x80,0xe5,0x3a,0xd1,0xd8,0x7f}, 0},
+    {{0x2a,0x03,0xa1,0xad,0x02,0x83,0x2a,0x58,0xac,0x72,0x5b,0xbb,0xa6,0xd4,0x2d,0x9e,0x59,0x5d,0xe7,0x6c,0x05,0xbc,0xc7,0xc0,0xd3,0x13,0x80,0xe5,0x3a,0xd1,0xd8,0x7f}, 1},
+    {{0x2a,0x14,0x05,0x5f,0x29,0x45,0xbe,0x4a,0x66,0x7e,0x04,0xb0,0x8a,0xf0,0xc1,0xa7,0x07,0x4f,0x2c,0xd9,0x6c,0xda,0x12,0xef,0x4d,0x9f,0xe6,0xd6,0xf9,0xf1,0xe9,0xc8}, 0},
+    {{0x2a,0x14,0x05,0x5f,0x29,0x45,0xbe,0x4a,0x66,0x7e,0x04,0xb0,0x8a,0xf0,0xc1,0xa7,0x07,0x4f,0x2c,0xd9,0x6c,0xda,0x12,0xef,0x4d,0x9f,0xe6,0xd6,0xf9,0xf1,0xe9,0xc8}, 1},
+    {{0x2a,0x28,0x2d,0x00,0x45,0xe7,0x8c,0x8a,0x26,0x62,0x56,0x96,0x8e,0x60,0x21,0x0d,0x20,0x9d,0xf6,0x55,0xed,0x2d,0x4d,0x5a,0x8e,0xf6,0x20,0x6b,0xde,0xbf,0x52,0x44}, 0},
+    {{0x2a,0x28,0x2d,0x00,0x45,0xe7,0x8c,0x8a,0x26,0x62,0x56,0x96,0x8e,0x60,0x21,0x0d,0x20,0x9d,0xf6,0x55,0xed,0x2d,0x4d,0x5a,0x8e,0xf6,0x20,0x6b,0xde,0xbf,0x52,0x44}, 1},
+    {{0x2a,0x7a,0x27,0xb7,0x6e,0xf0,0x9e,0xb4,0x25,0x53,0xeb,0x0c,0x51,0x81,0x5b,0x0d,0xae,0x60,0xc0,0x53,0xdd,0x49,0x05,0x93,0x42,0xd5,0x44,0xdc,0x62,0x2b,0x53,0x3f}, 0},
+    {{0x2a,0x7a,0x27,0xb7,0x6e,0xf0,0x9e,0xb4,0x25,0x53,0xeb,0x0c,0x51,0x81,0x5b,0x0d,0xae,0x60,0xc0,0x53,0xdd,0x49,0x05,0x93,0x42,0xd5,0x44,0xdc,0x62,0x2b,0x53,0x3f}, 1},
+    {{0x2a,0x81,0xb5,0xb8,0x35,0x08,0xe7,0x2a,0x52,0xc8,0x4b,0xb7,0x13,0x59,0x7b,0x24,0x10,0xf8,0xc9,0xa6,0x13,0x16,0xce,0xc5,0x9f,0xf1,0x5b,0x2e,0xf7,0x46,0xc9,0x9b}, 0},
+    {{0x2a,0x81,0xb5,0xb8,0x35,0x08,0xe7,0x2a,0x52,0xc8,0x4b,0xb7,0x13,0x59,0x7b,0x24,0x10,0xf8,0xc9,0xa6,0x13,0x16,0xce,0xc5,0x9f,0xf1,0x5b,0x2e,0xf7,0x46,0xc9,0x9b}, 1},
+    {{0x2b,0x9f,0x8c,0xdd,0x79,0xe7,0xa5,0x90,0x65,0xcc,0x99,0x21,0x4c,0x1e,0xcc,0x62,0x84,0x87,0xfc,0xf9,0x1f,0x79,0xc1,0x46,0xda,0xa7,0x70,0x96,0xb6,0x93,0x30,0xa0}, 0},
+    {{0x2b,0x9f,0x8c,0xdd,0x79,0xe7,0xa5,0x90,0x65,0xcc,0x99,0x21,0x4c,0x1e,0xcc,0x62,0x84,0x87,0xfc,0xf9,0x1f,0x79,0xc1,0x46,0xda,0xa7,0x70,0x96,0xb6,0x93,0x30,0xa0}, 1},
+    {{0x2b,0xda,0xce,0x46,0x38,0xef,0xbb,0x07,0x65,0xbc,0x8d,0xa0,0x96,0xfa,0xd7,0x8b,0x8e,0x29,0x52,0x42,0xfc,0x7c,0x21,0xa1,0x31,0xd0,0xaa,0xfd,0x16,0x1c,0x49,0x5c}, 0},
+    {{0x2b,0xda,0xce,0x46,0x38,0xef,0xbb,0x07,0x65,0xbc,0x8d,0xa0,0x96,0xfa,0xd7,0x8b,0x8e,0x29,0x52,0x42,0xfc,0x7c,0x21,0xa1,0x31,0xd0,0xaa,0xfd,0x16,0x1c,0x49,0x5c}, 1},
+    {{0x2b,0xe1,0x27,0x97,0x61,0x84,0x5a,0xbe,0x9f,0xf6,0x9e,0x07,0x45,0x2f,0x6d,0x2f,0xbd,0x37,0xcb,0x45,0xc1,0xd8,0xb4,0x90,0x66,0x57,0x6d,0xc7,0x5d,0x12,0x13,0xa8}, 0},
+    {{0x2b,0xe1,0x27,0x97,0x61,0x84,0x5a,0xbe,0x9f,0xf6,0x9e,0x07,0x45,0x2f,0x6d,0x2f,0xbd,0x37,0xcb,0x45,0xc1,0xd8,0xb4,0x90,0x66,0x57,0x6d,0xc7,0x5d,0x12,0x13,0xa8}, 1},
+    {{0x2b,0xfc,0x92,0xc1,0xe1,0x6a,0xe6,0x58,0xe4,0x60,0x8e,0xaf,0x43,0x8b,0x51,0x08,0x8b,0x8f,0x3d,0x30,0x44,0x0e,0xbd,0x82,0x27,0x03,0xb7,0xa9,0x4a,0xd4,0x49,0x9b}, 0},
+    {{0x2c,0x01,0x47,0x4e,0x6e,0xe0,0x6f,0xf9,0x26,0x72,0xbd,0xd8,0xd8,0x37,0xee,0xef,0xfc,0x9a,0xe5,0x8a,0x6a,0xc0,0xf4,0x1e,0x7c,0x45,0xb8,0x67,0x6b,0x42,0x10,0xa9}, 0},
+    {{0x2c,0x2b,0x80,0x0d,0x69,0xc8,0x8a,0x3d,0xed,0xf8,0x7d,0x57,0x7d,0x62,0x27,0xb5,0xc0,0xec,0xf8,0xca,0xdb,0x8e,0x2b,0xaf,0x4f,0x81,0x5a,0xc9,0xc9,0x24,0x33,0xb8}, 0},
+    {{0x2c,0x45,0xa1,0x23,0x26,0x68,0x48,0xa8,0xee,0x39,0xe8,0x13,0x34,0x1a,0x91,0xee,0x71,0xe5,0xe8,0x01,0x61,0x80,0x78,0xfa,0xc4,0x9d,0xed,0x9f,0xf3,0xc3,0x0c,0xf5}, 0},
+    {{0x2c,0x45,0xa1,0x23,0x26,0x68,0x48,0xa8,0xee,0x39,0xe8,0x13,0x34,0x1a,0x91,0xee,0x71,0xe5,0xe8,0x01,0x61,0x80,0x78,0xfa,0xc4,0x9d,0xed,0x9f,0xf3,0xc3,0x0c,0xf5}, 1},
+    {{0x2c,0x85,0x7e,0xf0,0x1d,0xac,0x56,0x21,0xef,0x10,0x4c,0x96,0x00,0xd7,0x4c,0x71,0x5e,0x9c,0x6f,0xad,0x69,0x9d,0xd0,0xbe,0x0c,0xd8,0x8a,0x0d,0x71,0xfd,0xa0,0xf5}, 0},
+    {{0x2d,0x24,0x67,0x4c,0x09,0x27,0x50,0xb1,0x1b,0x60,0xed,0x70,0xae,0xff,0x57,0xdc,0xd0,0x6b,0x05,0x28,0x7b,0x77,0xaf,0x29,0x4a,0xcc,0x95,0x4b,0x1c,0x7f,0xf5,0xf6}, 1},
+    {{0x2d,0x24,0x67,0x4c,0x09,0x27,0x50,0xb1,0x1b,0x60,0xed,0x70,0xae,0xff,0x57,0xdc,0xd0,0x6b,0x05,0x28,0x7b,0x77,0xaf,0x29,0x4a,0xcc,0x95,0x4b,0x1c,0x7f,0xf5,0xf6}, 2},
+    {{0x2d,0x5f,0xa5,0xac,0x24,0x8d,0x6f,0x05,0x6b,0xad,0xc3,0xaf,0x67,0x8e,0x9a,0x55,0x83,0x90,0xf2,0x15,0x10,0xe7,0xe3,0x23,0x2e,0xea,0x65,0xa8,0x2c,0x5b,0x02,0xe5}, 0},
+    {{0x2d,0x92,0x88,0xb7,0x6f,0x9e,0x48,0xa7,0x8f,0xa1,0x2e,0x2a,0xda,0x73,0xd1,0x8d,0xf0,0xcc,0x8a,0x65,0xc6,0x39,0x6a,0x6d,0xad,0x7c,0xa1,0x0d,0xc8,0xb4,0x6c,0x78}, 0},
+    {{0x2d,0x92,0x88,0xb7,0x6f,0x9e,0x48,0xa7,0x8f,0xa1,0x2e,0x2a,0xda,0x73,0xd1,0x8d,0xf0,0xcc,0x8a,0x65,0xc6,0x39,0x6a,0x6d,0xad,0x7c,0xa1,0x0d,0xc8,0xb4,0x6c,0x78}, 1},
+    {{0x2e,0x0e,0xea,0x1c,0x96,0x47,0xaf,0x7e,0xf4,0xa7,0xe0,0x96,0xa6,0xbc,0x60,0xe9,0xf0,0xe6,0x93,0xce,0xab,0x46,0xbe,0x92,0x62,0xba,0x95,0xa8,0xf2,0xca,0xc5,0x42}, 0},
+    {{0x2e,0x0e,0xea,0x1c,0x96,0x47,0xaf,0x7e,0xf4,0xa7,0xe0,0x96,0xa6,0xbc,0x60,0xe9,0xf0,0xe6,0x93,0xce,0xab,0x46,0xbe,0x92,0x62,0xba,0x95,0xa8,0xf2,0xca,0xc5,0x42}, 1},
+    {{0x2e,0x3e,0x59,0x37,0xe9,0x0e,0xc5,0x74,0x7d,0x47,0xee,0xa0,0x69,0x59,0x4a,0xea,0x18,0xfe,0xae,0x99,0x98,0x0b,0x4d,0xa5,0x8d,0x4a,0xfe,0x07,0xe5,0xd5,0x66,0xb7}, 0},
+    {{0x2e,0x3e,0x59,0x37,0xe9,0x0e,0xc5,0x74,0x7d,0x47,0xee,0xa0,0x69,0x59,0x4a,0xea,0x18,0xfe,0xae,0x99,0x98,0x0b,0x4d,0xa5,0x8d,0x4a,0xfe,0x07,0xe5,0xd5,0x66,0xb7}, 1},
+    {{0x2e,0x99,0xa5,0xaa,0x93,0xea,0xd2,0x21,0x50,0x1f,0x74,0x8c,0xda,0x9f,0xb6,0x88,0xf6,0x53,0xcf,0x54,0x8e,0xcd,0x00,0x5e,0xdc,0x69,0x91,0x02,0xf2,0x6f,0xf6,0x43}, 0},
+    {{0x2e,0x99,0xa5,0xaa,0x93,0xea,0xd2,0x21,0x50,0x1f,0x74,0x8c,0xda,0x9f,0xb6,0x88,0xf6,0x53,0xcf,0x54,0x8e,0xcd,0x00,0x5e,0xdc,0x69,0x91,0x02,0xf2,0x6f,0xf6,0x43}, 1},
+    {{0x2e,0xcd,0x84,0x36,0x51,0x8d,0x86,0x83,0x3a,0xd9,0x83,0x2d,0xb7,0x42,0x06,0x86,0x8b,0x19,0x50,0x0c,0x05,0x02,0xe7,0xb1,0xd2,0x79,0x38,0x26,0x53,0xca,0xdd,0x4c}, 0},
+    {{0x2e,0xcd,0x84,0x36,0x51,0x8d,0x86,0x83,0x3a,0xd9,0x83,0x2d,0xb7,0x42,0x06,0x86,0x8b,0x19,0x50,0x0c,0x05,0x02,0xe7,0xb1,0xd2,0x79,0x38,0x26,0x53,0xca,0xdd,0x4c}, 1},
+    {{0x2e,0xe9,0x97,0x2d,0xf8,0x15,0x15,0x21,0x2c,0xa8,0x62,0xa7,0xc9,0xdd,0x35,0xff,0xe2,0xcc,0x54,0xff,0x27,0xeb,0xee,0x96,0x67,0x67,0x1e,0xe2,0x01,0x41,0xd3,0x7b}, 0},
+    {{0x2e,0xe9,0x97,0x2d,0xf8,0x15,0x15,0x21,0x2c,0xa8,0x62,0xa7,0xc9,0xdd,0x35,0xff,0xe2,0xcc,0x54,0xff,0x27,0xeb,0xee,0x96,0x67,0x67,0x1e,0xe2,0x01,0x41,0xd3,0x7b}, 1},
+    {{0x2e,0xf6,0xeb,0x2f,0x48,0xa5,0xb2,0xa7,0xa4,0x9e,0xd9,0xc3,0x16,0xd3,0x4d,0x17,0x56,0x43,0x0e,0x04,0x18,0xef,0x5e,0x4a,0x1f,0xa2,0xce,0xa2,0x25,0x69,0x48,0x23}, 0},
+    {{0x2f,0x65,0xe9,0x8f,0x28,0xe8,0x84,0xb4,0xde,0x03,0xc4,0x87,0x64,0x08,0xcb,0xef,0x75,0x00,0x1b,0xcb,0x8c,0xa4,0x66,0x82,0xc4,0x6c,0xed,0xa9,0x18,0x27,0x76,0x39}, 0},
+    {{0x2f,0x7f,0x55,0xf9,0x14,0xb1,0x91,0x97,0x04,0xb1,0x5a,0xd8,0x48,0xc8,0xf4,0xe2,0x08,0x59,0xec,0x94,0x10,0x5c,0x4b,0x7e,0xe5,0x5e,0x08,0xee,0x0b,0x11,0x87,0xb7}, 0},
+    {{0x2f,0x7f,0x55,0xf9,0x14,0xb1,0x91,0x97,0x04,0xb1,0x5a,0xd8,0x48,0xc8,0xf4,0xe2,0x08,0x59,0xec,0x94,0x10,0x5c,0x4b,0x7e,0xe5,0x5e,0x08,0xee,0x0b,0x11,0x87,0xb7}, 1},
+    {{0x30,0x29,0xf2,0x18,0xab,0xbe,0x20,0xec,0xc2,0xa4,0x9d,0x41,0x1d,0x0b,0x28,0xd5,0x20,0x4a,0x3f,0xb9,0xe2,0xb7,0x26,0x9b,0x69,0xe1,0xf3,0x36,0x8b,0xe0,0xbd,0x0e}, 0},
+    {{0x30,0x29,0xf2,0x18,0xab,0xbe,0x20,0xec,0xc2,0xa4,0x9d,0x41,0x1d,0x0b,0x28,0xd5,0x20,0x4a,0x3f,0xb9,0xe2,0xb7,0x26,0x9b,0x69,0xe1,0xf3,0x36,0x8b,0xe0,0xbd,0x0e}, 1},
+    {{0x30,0x75,0x10,0xdc,0x33,0x7c,0x08,0xe9,0xe9,0x17,0xde,0x38,0x16,0x0f,0x39,0xf6,0x51,0xf5,0x41,0xca,0x50,0xe4,0x6b,0xb9,0x73,0x57,0xd0,0x85,0x41,0xc8,0x5b,0xb4}, 0},
+    {{0x30,0x88,0xf8,0xec,0x79,0xab,0x5e,0xc1,0x06,0x07,0x9d,0xcb,0x5f,0x07,0xbf,0x41,0xd2,0x47,0x8f,0x92,0xc8,0x6e,0x51,0xed,0xc9,0x1c,0x88,0x20,0x00,0x76,0xaf,0x3b}, 0},
+    {{0x30,0xd6,0xd0,0x2a,0xdc,0xb6,0x24,0xd2,0xb8,0x34,0xc5,0x5d,0x93,0x21,0xf7,0xb3,0xb9,0xfd,0x8a,0xae,0x76,0x18,0x08,0x30,0x89,0xe6,0xd5,0x91,0xc8,0xa9,0x14,0x95}, 0},
+    {{0x30,0xd6,0xd0,0x2a,0xdc,0xb6,0x24,0xd2,0xb8,0x34,0xc5,0x5d,0x93,0x21,0xf7,0xb3,0xb9,0xfd,0x8a,0xae,0x76,0x18,0x08,0x30,0x89,0xe6,0xd5,0x91,0xc8,0xa9,0x14,0x95}, 1},
+    {{0x31,0x0c,0x38,0xbd,0x8f,0x21,0x5c,0x77,0x0b,0x38,0xab,0x2e,0x2f,0xc3,0x88,0xc0,0x0a,0xb1,0xf2,0xd9,0x29,0xb0,0xfc,0x03,0x3e,0xd8,0x86,0x39,0x7c,0xd0,0x79,0xe5}, 0},
+    {{0x31,0x0c,0x38,0xbd,0x8f,0x21,0x5c,0x77,0x0b,0x38,0xab,0x2e,0x2f,0xc3,0x88,0xc0,0x0a,0xb1,0xf2,0xd9,0x29,0xb0,0xfc,0x03,0x3e,0xd8,0x86,0x39,0x7c,0xd0,0x79,0xe5}, 1},
+    {{0x31,0x11,0x3a,0x6e,0x8d,0x38,0x0e,0xf4,0x86,0x2f,0x30,0x34,0xe2,0x76,0x70,0x9d,0x4b,0x02,0xf1,0x9c,0x99,0xd2,0x14,0xee,0xdc,0x8e,0x80,0x7d,0xd7,0xaa,0x96,0x68}, 0},
+    {{0x31,0x11,0x3a,0x6e,0x8d,0x38,0x0e,0xf4,0x86,0x2f,0x30,0x34,0xe2,0x76,0x70,0x9d,0x4b,0x02,0xf1,0x9c,0x99,0xd2,0x14,0xee,0xdc,0x8e,0x80,0x7d,0xd7,0xaa,0x96,0x68}, 1},
+    {{0x31,0x6a,0x0b,0xd9,0x4f,0x87,0x77,0x2c,0x35,0xa3,0x59,0x4c,0x63,0x67,0x68,0xf2,0xce,0x56,0xa6,0x13,0x71,0xf5,0xfc,0x4b,0xb8,0x40,0x65,0x74,0x31,0x73,0xdd,0x75}, 0},
+    {{0x31,0x6a,0x0b,0xd9,0x4f,0x87,0x77,0x2c,0x35,0xa3,0x59,0x4c,0x63,0x67,0x68,0xf2,0xce,0x56,0xa6,0x13,0x71,0xf5,0xfc,0x4b,0xb8,0x40,0x65,0x74,0x31,0x73,0xdd,0x75}, 1},
+    {{0x31,0x9d,0xa0,0x8f,0x0c,0x26,0x1e,0x5a,0xda,0x2e,0x0c,0x55,0x64,0x02,0x32,0xff,0x67,0xc1,0xe9,0x32,0x0f,0x92,0xf7,0x35,0xd3,0xda,0x68,0xcd,0xf7,0x0f,0xa3,0xa5}, 0},
+    {{0x31,0xc9,0x26,0xca,0x0f,0x0d,0xb2,0x35,0x5e,0x19,0x1c,0x9d,0xf7,0x06,0x17,0x6d,0xcf,0xce,0xb7,0xe4,0x38,0xa4,0x6e,0xc5,0x8a,0xdc,0xa9,0x37,0x12,0xf8,0x1e,0xef}, 0},
+    {{0x32,0x58,0x82,0x6f,0x33,0x9b,0xf6,0x5f,0xa6,0x95,0xd8,0xc7,0xe3,0xdb,0x5f,0xf8,0x01,0x0b,0xe6,0x85,0xe3,0x18,0x65,0x01,0x02,0x07,0xc3,0x71,0xd2,0x16,0xb2,0x9e}, 0},
+    {{0x32,0xda,0x40,0xe0,0x4f,0x27,0x73,0xcb,0x0e,0x67,0x45,0x3f,0x53,0xec,0xf9,0xb1,0x23,0x5e,0xbe,0x97,0x15,0xcf,0xce,0x4d,0xcd,0x74,0x68,0x78,0x70,0x16,0xe9,0xe2}, 0},
+    {{0x32,0xda,0x40,0xe0,0x4f,0x27,0x73,0xcb,0x0e,0x67,0x45,0x3f,0x53,0xec,0xf9,0xb1,0x23,0x5e,0xbe,0x97,0x15,0xcf,0xce,0x4d,0xcd,0x74,0x68,0x78,0x70,0x16,0xe9,0xe2}, 1},
+    {{0x33,0x93,0x27,0x32,0xc3,0x84,0xa9,0xb5,0x75,0x95,0xd3,0x5d,0xab,0xd6,0x40,0x60,0x2b,0x45,0xfd,0x55,0xe2,0x71,0x73,0x8d,0xe5,0xcc,0x7e,0x69,0xdf,0xc0,0xd0,0x1c}, 0},
+    {{0x33,0x93,0x27,0x32,0xc3,0x84,0xa9,0xb5,0x75,0x95,0xd3,0x5d,0xab,0xd6,0x40,0x60,0x2b,0x45,0xfd,0x55,0xe2,0x71,0x73,0x8d,0xe5,0xcc,0x7e,0x69,0xdf,0xc0,0xd0,0x1c}, 1},
+    {{0x33,0xc0,0x0d,0x8c,0xfe,0x65,0xa2,0x68,0x8f,0x88,0x34,0x2f,0x0a,0x7c,0x22,0x92,0x6d,0xdd,0x52,0x43,0x1e,0x99,0xd7,0xe9,0x58,0x9e,0x1f,0x47,0x8e,0x22,0x55,0xe1}, 0},
+    {{0x33,0xc0,0x0d,0x8c,0xfe,0x65,0xa2,0x68,0x8f,0x88,0x34,0x2f,0x0a,0x7c,0x22,0x92,0x6d,0xdd,0x52,0x43,0x1e,0x99,0xd7,0xe9,0x58,0x9e,0x1f,0x47,0x8e,0x22,0x55,0xe1}, 1},
+    {{0x33,0xe4,0x8f,0xb5,0xed,0x7b,0x61,0x5f,0x8d,0xb7,0x7e,0x62,0xec,0xcb,0xe0,0x5c,0xb7,0x2d,0x1b,0xf4,0x22,0x87,0x81,0x94,0x2f,0xe4,0x6b,0xc9,0xce,0x47,0x28,0xdf}, 0},
+    {{0x33,0xe4,0x8f,0xb5,0xed,0x7b,0x61,0x5f,0x8d,0xb7,0x7e,0x62,0xec,0xcb,0xe0,0x5c,0xb7,0x2d,0x1b,0xf4,0x22,0x87,0x81,0x94,0x2f,0xe4,0x6b,0xc9,0xce,0x47,0x28,0xdf}, 1},
+    {{0x33,0xf8,0xf8,0x6e,0x06,0x7e,0xe9,0x9d,0x3e,0xc9,0xff,0x95,0x90,0xc1,0x98,0x46,0xb7,0xb1,0x00,0x38,0x9a,0xaa,0x03,0x7c,0x1a,0xb5,0x63,0xb6,0xbe,0x32,0x18,0x12}, 0},
+    {{0x33,0xff,0xad,0x69,0xdf,0x5a,0xe0,0x95,0xd6,0x06,0xdd,0x76,0x16,0x37,0x97,0x1e,0x88,0x89,0xe2,0x98,0x74,0x26,0x05,0x07,0x5f,0xed,0x23,0xe0,0x92,0x12,0x80,0x5f}, 0},
+    {{0x34,0x63,0xfd,0xa1,0xab,0xf6,0x69,0xc1,0xad,0xbc,0xf4,0xd0,0x43,0xfe,0xb2,0x7a,0xa6,0x17,0x35,0x4d,0x6d,0xa8,0x4e,0x00,0x34,0xcf,0x5f,0xf1,0x9b,0x4a,0x39,0xeb}, 0},
+    {{0x34,0x63,0xfd,0xa1,0xab,0xf6,0x69,0xc1,0xad,0xbc,0xf4,0xd0,0x43,0xfe,0xb2,0x7a,0xa6,0x17,0x35,0x4d,0x6d,0xa8,0x4e,0x00,0x34,0xcf,0x5f,0xf1,0x9b,0x4a,0x39,0xeb}, 1},
+    {{0x35,0x0e,0x13,0x26,0xf7,0xb6,0x23,0x99,0x33,0x34,0xa5,0xe1,0xa4,0x81,0x91,0x7c,0x89,0x1a,0xe2,0xd5,0x85,0xde,0x20,0xfe,0x2b,0x06,0xfa,0x01,0x97,0xa1,0x12,0x08}, 0},
+    {{0x35,0xba,0x1b,0x65,0x9e,0xe7,0xad,0xe4,0xeb,0x5b,0x1e,0x34,0xe9,0xac,0xaa,0x96,0xeb,0xc8,0x89,0xcf,0x2f,0xb4,0x13,0xc2,0xf8,0x76,0xac,0xd5,0x38,0x6a,0x8e,0x4e}, 0},
+    {{0x35,0xba,0x1b,0x65,0x9e,0xe7,0xad,0xe4,0xeb,0x5b,0x1e,0x34,0xe9,0xac,0xaa,0x96,0xeb,0xc8,0x89,0xcf,0x2f,0xb4,0x13,0xc2,0xf8,0x76,0xac,0xd5,0x38,0x6a,0x8e,0x4e}, 1},
+    {{0x35,0xe8,0xa6,0x12,0xce,0xa3,0x92,0x2a,0x06,0xd0,0x6f,0x47,0x66,0xd4,0xb7,0xeb,0x02,0x17,0x53,0xc3,0x02,0x2b,0x7d,0xa4,0x81,0x16,0x9b,0x58,0xb5,0x71,0x15,0x9c}, 0},
+    {{0x36,0x1f,0x48,0x1e,0xfe,0xfe,0x76,0x76,0xac,0x7f,0x93,0xa2,0x42,0x59,0x23,0x42,0xd7,0x6a,0xa0,0x48,0x81,0x35,0x7e,0x2f,0x4a,0x4b,0x4f,0xd5,0x9d,0xb2,0x29,0xd1}, 0},
+    {{0x36,0x1f,0x48,0x1e,0xfe,0xfe,0x76,0x76,0xac,0x7f,0x93,0xa2,0x42,0x59,0x23,0x42,0xd7,0x6a,0xa0,0x48,0x81,0x35,0x7e,0x2f,0x4a,0x4b,0x4f,0xd5,0x9d,0xb2,0x29,0xd1}, 1},
+    {{0x36,0x41,0x46,0x26,0x8e,0x18,0xef,0x61,0x77,0x1d,0x70,0xd8,0xe7,0x48,0x54,0x65,0x05,0x79,0xf8,0xf4,0x68,0x0f,0xce,0xbc,0xe3,0x73,0x60,0xf4,0xab,0xbb,0xce,0xaa}, 0},
+    {{0x36,0xb3,0xa9,0xff,0x82,0xea,0x85,0x6a,0xf4,0x06,0xbb,0x4d,0xd3,0x7b,0x32,0xdb,0x0a,0x0a,0x7d,0xdc,0x87,0x3e,0xa5,0x10,0x23,0x2a,0x0e,0x48,0x9d,0x68,0x4d,0x6a}, 0},
+    {{0x36,0xb3,0xa9,0xff,0x82,0xea,0x85,0x6a,0xf4,0x06,0xbb,0x4d,0xd3,0x7b,0x32,0xdb,0x0a,0x0a,0x7d,0xdc,0x87,0x3e,0xa5,0x10,0x23,0x2a,0x0e,0x48,0x9d,0x68,0x4d,0x6a}, 1},
+    {{0x36,0xcf,0x3d,0xd5,0x94,0x74,0x41,0xdc,0x0d,0x0c,0x74,0x41,0xbb,0xd7,0xc5,0x2b,0x96,0xb6,0xd4,0x5c,0xb9,0xd6,0xbf,0xcc,0x51,0x70,0x6d,0xe2,0x99,0x9e,0xd8,0xb3}, 0},
+    {{0x36,0xcf,0x3d,0xd5,0x94,0x74,0x41,0xdc,0x0d,0x0c,0x74,0x41,0xbb,0xd7,0xc5,0x2b,0x96,0xb6,0xd4,0x5c,0xb9,0xd6,0xbf,0xcc,0x51,0x70,0x6d,0xe2,0x99,0x9e,0xd8,0xb3}, 1},
+    {{0x36,0xf0,0x27,0x44,0x1b,0xc1,0x34,0x5d,0xe6,0xb4,0xd8,0x18,0x26,0xa4,0x9f,0x87,0xe5,0xdf,0x03,0x0c,0x0e,0x16,0x12,0x70,0x6b,0xb1,0x64,0x9b,0xd7,0x79,0x40,0x58}, 0},
+    {{0x36,0xf0,0x27,0x44,0x1b,0xc1,0x34,0x5d,0xe6,0xb4,0xd8,0x18,0x26,0xa4,0x9f,0x87,0xe5,0xdf,0x03,0x0c,0x0e,0x16,0x12,0x70,0x6b,0xb1,0x64,0x9b,0xd7,0x79,0x40,0x58}, 1},
+    {{0x37,0xde,0xa3,0xea,0xe1,0xa7,0xf7,0xd3,0x1e,0xdf,0x51,0x90,0x63,0x80,0x0e,0xf7,0xb1,0xf0,0xf0,0xf5,0x3c,0x1d,0x3a,0xc2,0x08,0x87,0x7e,0x1e,0x5e,0x7c,0xa2,0xf5}, 0},
+    {{0x37,0xde,0xa3,0xea,0xe1,0xa7,0xf7,0xd3,0x1e,0xdf,0x51,0x90,0x63,0x80,0x0e,0xf7,0xb1,0xf0,0xf0,0xf5,0x3c,0x1d,0x3a,0xc2,0x08,0x87,0x7e,0x1e,0x5e,0x7c,0xa2,0xf5}, 1},
+    {{0x38,0x2b,0x2c,0xe1,0xc4,0xa8,0x54,0xf3,0xbc,0x4b,0x2f,0x97,0x0a,0x41,0x90,0x70,0xc7,0x69,0x7d,0x5c,0xc7,0xca,0x65,0x12,0x05,0x36,0x4d,0x92,0x8f,0x86,0x40,0xf3}, 0},
+    {{0x38,0x2b,0x2c,0xe1,0xc4,0xa8,0x54,0xf3,0xbc,0x4b,0x2f,0x97,0x0a,0x41,0x90,0x70,0xc7,0x69,0x7d,0x5c,0xc7,0xca,0x65,0x12,0x05,0x36,0x4d,0x92,0x8f,0x86,0x40,0xf3}, 1},
+    {{0x38,0x98,0x92,0xe9,0x00,0x1b,0xd0,0x9c,0x0d,0xaf,0x4e,0x65,0xa3,0xd5,0x38,0x92,0x64,0x37,0xb5,0xf0,0x91,0x3a,0xd6,0xcb,0x18,0x9b,0x5e,0x7b,0x62,0x75,0xf7,0x14}, 0},
+    {{0x38,0xb6,0x26,0x5a,0x10,0xe3,0xa4,0x68,0x1f,0xfa,0xf2,0xe4,0x31,0x03,0xee,0xd3,0xd2,0xd7,0x18,0x81,0xea,0x78,0xe0,0xca,0x0d,0xfc,0x50,0xc5,0x0a,0xa2,0x0d,0x1d}, 0},
+    {{0x38,0xb6,0x26,0x5a,0x10,0xe3,0xa4,0x68,0x1f,0xfa,0xf2,0xe4,0x31,0x03,0xee,0xd3,0xd2,0xd7,0x18,0x81,0xea,0x78,0xe0,0xca,0x0d,0xfc,0x50,0xc5,0x0a,0xa2,0x0d,0x1d}, 1},
+    {{0x38,0xd0,0xf2,0x90,0x98,0xd3,0x67,0x1b,0x0e,0x4c,0xd3,0xde,0xb7,0x61,0x56,0x15,0xea,0xba,0x0b,0xaf,0xbc,0x4f,0xc0,0xba,0xb7,0xe2,0x3f,0x84,0x7d,0x3d,0xd8,0xcd}, 0},
+    {{0x38,0xee,0x01,0x52,0x65,0x05,0x76,0x2a,0xc6,0x9a,0x23,0xb3,0xd0,0x2d,0x41,0x64,0x12,0xc0,0x32,0x12,0x19,0xc1,0x52,0x76,0x3f,0xdc,0xca,0x91,0x15,0x33,0x48,0x48}, 0},
+    {{0x3a,0x2f,0xde,0xa9,0xaa,0xab,0x7a,0x2d,0x6c,0x1b,0x53,0xbb,0xa4,0xdd,0x59,0x4f,0x50,0xba,0x9f,0xb7,0x10,0xd0,0xbe,0x6b,0xa8,0x83,0x51,0xc6,0x39,0xba,0x41,0x48}, 0},
+    {{0x3a,0x2f,0xde,0xa9,0xaa,0xab,0x7a,0x2d,0x6c,0x1b,0x53,0xbb,0xa4,0xdd,0x59,0x4f,0x50,0xba,0x9f,0xb7,0x10,0xd0,0xbe,0x6b,0xa8,0x83,0x51,0xc6,0x39,0xba,0x41,0x48}, 1},
+    {{0x3a,0x4d,0x9b,0xbc,0x69,0x0b,0xb8,0xdd,0x96,0xb9,0x91,0x67,0x06,0x53,0xd1,0x60,0x39,0xcd,0x62,0x07,0x64,0x9e,0xd2,0x69,0x3d,0x5c,0x1d,0xc0,0x75,0x01,0xd3,0x50}, 0},
+    {{0x3a,0x4d,0x9b,0xbc,0x69,0x0b,0xb8,0xdd,0x96,0xb9,0x91,0x67,0x06,0x53,0xd1,0x60,0x39,0xcd,0x62,0x07,0x64,0x9e,0xd2,0x69,0x3d,0x5c,0x1d,0xc0,0x75,0x01,0xd3,0x50}, 1},
+    {{0x3a,0x7f,0x88,0xe3,0xfb,0x4d,0x4d,0xa8,0x74,0x56,0xe5,0x4f,0x34,0x32,0x44,0x37,0xf6,0x19,0x23,0xce,0x5f,0xdb,0x58,0x16,0xfb,0xab,0x5f,0x98,0x9d,0x62,0x4f,0xcd}, 0},
+    {{0x3a,0x7f,0x88,0xe3,0xfb,0x4d,0x4d,0xa8,0x74,0x56,0xe5,0x4f,0x34,0x32,0x44,0x37,0xf6,0x19,0x23,0xce,0x5f,0xdb,0x58,0x16,0xfb,0xab,0x5f,0x98,0x9d,0x62,0x4f,0xcd}, 1},
+    {{0x3a,0x87,0x88,0x25,0xa9,0x7e,0x27,0xf2,0x30,0xc7,0xc1,0x58,0xde,0xba,0xe1,0x8b,0x47,0xc8,0xea,0xca,0x5b,0x2d,0x41,0xe7,0x0e,0x02,0x61,0xe1,0xdc,0x0b,0x59,0xd9}, 0},
+    {{0x3a,0x87,0x88,0x25,0xa9,0x7e,0x27,0xf2,0x30,0xc7,0xc1,0x58,0xde,0xba,0xe1,0x8b,0x47,0xc8,0xea,0xca,0x5b,0x2d,0x41,0xe7,0x0e,0x02,0x61,0xe1,0xdc,0x0b,0x59,0xd9}, 1},
+    {{0x3a,0xb9,0x79,0x38,0x8d,0x12,0x4a,0x74,0xf5,0x91,0x66,0x3d,0xbf,0x7e,0x82,0xf5,0x7a,0xae,0xe7,0x54,0x1a,0xd8,0xe0,0x35,0x86,0x71,0x87,0xf5,0x0e,0x18,0xf0,0x73}, 0},
+    {{0x3b,0x06,0x33,0xac,0x4c,0xa0,0x3d,0xcd,0x83,0x92,0xa1,0xc0,0xe8,0x7a,0xb0,0x10,0x01,0x5a,0x37,0x96,0x19,0x7a,0x2b,0x37,0x4a,0x9d,0xd6,0xad,0xa1,0xed,0x63,0xae}, 0},
+    {{0x3b,0x06,0x33,0xac,0x4c,0xa0,0x3d,0xcd,0x83,0x92,0xa1,0xc0,0xe8,0x7a,0xb0,0x10,0x01,0x5a,0x37,0x96,0x19,0x7a,0x2b,0x37,0x4a,0x9d,0xd6,0xad,0xa1,0xed,0x63,0xae}, 1},
+    {{0x3b,0x0d,0xf7,0x5e,0x1f,0x5a,0x39,0xe0,0xdb,0x99,0xae,0xda,0xc6,0xc2,0xf5,0x53,0x5c,0x5c,0x9f,0x19,0xbc,0xbf,0xc9,0xd1,0x9f,0x16,0x78,0x28,0x24,0x45,0xcc,0x6e}, 0},
+    {{0x3b,0x0f,0xb8,0x30,0x7c,0xfa,0x79,0xf9,0x45,0xac,0x56,0x51,0x0f,0x31,0x1c,0xf9,0xaf,0x1e,0xbd,0x56,0xa0,0xa2,0x15,0x2c,0xf9,0x6e,0x0e,0xd7,0x0b,0xf7,0xea,0x35}, 0},
+    {{0x3b,0x0f,0xb8,0x30,0x7c,0xfa,0x79,0xf9,0x45,0xac,0x56,0x51,0x0f,0x31,0x1c,0xf9,0xaf,0x1e,0xbd,0x56,0xa0,0xa2,0x15,0x2c,0xf9,0x6e,0x0e,0xd7,0x0b,0xf7,0xea,0x35}, 1},
+    {{0x3b,0x68,0x55,0xd7,0x65,0x86,0xb6,0x4a,0x83,0xe2,0x94,0x32,0xd7,0x32,0x91,0xc7,0x7c,0x8e,0xd7,0x42,0x51,0x38,0x1d,0xf2,0x2d,0x2f,0x43,0x6b,0xf3,0x87,0x30,0x4e}, 0},
+    {{0x3b,0x68,0x55,0xd7,0x65,0x86,0xb6,0x4a,0x83,0xe2,0x94,0x32,0xd7,0x32,0x91,0xc7,0x7c,0x8e,0xd7,0x42,0x51,0x38,0x1d,0xf2,0x2d,0x2f,0x43,0x6b,0xf3,0x87,0x30,0x4e}, 1},
+    {{0x3b,0xa4,0x88,0xae,0x0f,0x09,0x7a,0xcf,0x4f,0x96,0x2b,0xe6,0x86,0x81,0xcb,0xeb,0x88,0x8b,0xd2,0xc2,0xf0,0x98,0x62,0x78,0x6b,0xb2,0x50,0xd6,0x05,0x07,0xa3,0x55}, 0},
+    {{0x3b,0xa4,0x88,0xae,0x0f,0x09,0x7a,0xcf,0x4f,0x96,0x2b,0xe6,0x86,0x81,0xcb,0xeb,0x88,0x8b,0xd2,0xc2,0xf0,0x98,0x62,0x78,0x6b,0xb2,0x50,0xd6,0x05,0x07,0xa3,0x55}, 1},
+    {{0x3b,0xad,0x67,0x49,0x5a,0x01,0x33,0x51,0xe1,0xba,0x58,0x43,0x1a,0xda,0x86,0x4d,0x88,0x54,0x80,0x5b,0xe4,0x0b,0xf4,0xd3,0xef,0x0c,0xeb,0xc9,0x4f,0x7a,0x9c,0x3b}, 0},
+    {{0x3b,0xe0,0xe5,0x2b,0x80,0x60,0x9e,0xfd,0x8f,0x8e,0x4b,0x19,0x05,0x55,0x1b,0xfb,0x0d,0xfd,0x8c,0xd3,0x63,0xaf,0x79,0xd1,0x09,0x65,0xed,0xf0,0x85,0xff,0x22,0x4f}, 0},
+    {{0x3b,0xe0,0xe5,0x2b,0x80,0x60,0x9e,0xfd,0x8f,0x8e,0x4b,0x19,0x05,0x55,0x1b,0xfb,0x0d,0xfd,0x8c,0xd3,0x63,0xaf,0x79,0xd1,0x09,0x65,0xed,0xf0,0x85,0xff,0x22,0x4f}, 1},
+    {{0x3c,0x46,0x5a,0xad,0x0e,0xbe,0x22,0xc6,0x4a,0x2c,0x46,0x75,0xc0,0x40,0x81,0xe8,0x63,0x58,0xf5,0xd8,0x67,0xf4,0x10,0xf2,0xf7,0xc6,0x54,0x8a,0xb5,0xad,0xd7,0xd5}, 0},
+    {{0x3c,0x77,0x2c,0x00,0x77,0x4f,0x46,0xf5,0x55,0x5a,0x21,0xfa,0x43,0x86,0x02,0xeb,0x71,0x48,0x92,0x2e,0x57,0x5e,0x60,0x4c,0x4e,0x1f,0xc9,0x11,0x66,0x44,0x89,0x04}, 0},
+    {{0x3c,0x77,0x2c,0x00,0x77,0x4f,0x46,0xf5,0x55,0x5a,0x21,0xfa,0x43,0x86,0x02,0xeb,0x71,0x48,0x92,0x2e,0x57,0x5e,0x60,0x4c,0x4e,0x1f,0xc9,0x11,0x66,0x44,0x89,0x04}, 1},
+    {{0x3c,0xd1,0x59,0xd1,0x7e,0x2d,0x8b,0x31,0x30,0xbb,0x6e,0x7b,0xfb,0x20,0x0b,0xca,0x01,0x9a,0x9c,0x08,0xf3,0xec,0xab,0x4b,0xfb,0x2c,0xed,0x9f,0x7c,0xe3,0xbf,0xe0}, 0},
+    {{0x3c,0xd1,0x59,0xd1,0x7e,0x2d,0x8b,0x31,0x30,0xbb,0x6e,0x7b,0xfb,0x20,0x0b,0xca,0x01,0x9a,0x9c,0x08,0xf3,0xec,0xab,0x4b,0xfb,0x2c,0xed,0x9f,0x7c,0xe3,0xbf,0xe0}, 1},
+    {{0x3c,0xf4,0xf1,0xb6,0x28,0x40,0xac,0x04,0x10,0xc5,0x03,0xaa,0x31,0xad,0x16,0xf6,0x64,0xbf,0x52,0x54,0x11,0xe6,0x6d,0x78,0xd0,0x4d,0xc2,0xb4,0x45,0x84,0x67,0x24}, 0},
+    {{0x3c,0xf4,0xf1,0xb6,0x28,0x40,0xac,0x04,0x10,0xc5,0x03,0xaa,0x31,0xad,0x16,0xf6,0x64,0xbf,0x52,0x54,0x11,0xe6,0x6d,0x78,0xd0,0x4d,0xc2,0xb4,0x45,0x84,0x67,0x24}, 1},
+    {{0x3d,0x69,0x20,0x40,0x26,0x93,0x22,0xb5,0xee,0x9c,0x9c,0x64,0x2a,0x52,0xfe,0x25,0x73,0x0c,0x8b,0x3d,0x72,0x5b,0x7d,0x71,0xf7,0xed,0x4a,0xbb,0x35,0xf8,0xbf,0xda}, 0},
+    {{0x3d,0xb9,0x1e,0xcf,0xce,0xd9,0xd5,0x05,0x7b,0x8d,0xc8,0xb3,0x58,0x6f,0x0f,0x3c,0x72,0x09,0x4f,0x8d,0xb7,0xd7,0xfc,0xf7,0xe8,0xb4,0x8f,0xb2,0xbb,0x73,0x99,0x76}, 0},
+    {{0x3d,0xb9,0x1e,0xcf,0xce,0xd9,0xd5,0x05,0x7b,0x8d,0xc8,0xb3,0x58,0x6f,0x0f,0x3c,0x72,0x09,0x4f,0x8d,0xb7,0xd7,0xfc,0xf7,0xe8,0xb4,0x8f,0xb2,0xbb,0x73,0x99,0x76}, 1},
+    {{0x3d,0xfa,0x52,0xf5,0xdd,0xc7,0x60,0x1a,0xf3,0x2b,0x4f,0xa8,0xe1,0xc0,0x32,0x79,0xb0,0xbd,0x54,0x0a,0x41,0x71,0x2d,0xed,0x0d,0x34,0xf7,0xf1,0x5a,0x64,0x1e,0xca}, 0},
+    {{0x3d,0xfa,0xeb,0xd8,0x10,0x4e,0xd6,0x8d,0x06,0x3a,0x90,0x33,0xe1,0x48,0xf5,0xd2,0x1a,0x37,0x25,0xe8,0x43,0x87,0x06,0x88,0x1e,0x7f,0x91,0x68,0xd9,0x2c,0x95,0xff}, 1},
+    {{0x3e,0x5d,0x26,0x83,0x3a,0xf4,0xa6,0x61,0x28,0xc8,0x74,0x3c,0x48,0xdc,0xa2,0xc2,0x82,0x18,0xdc,0x38,0x83,0xec,0xe7,0x0a,0x7a,0x70,0x3e,0xfa,0xa8,0xa9,0x41,0xa2}, 0},
+    {{0x3e,0xb0,0xf5,0x6d,0x60,0xeb,0x4a,0xeb,0x2f,0xff,0x8d,0x53,0xef,0xd3,0x5f,0xd8,0xff,0x06,0x27,0xad,0x46,0x56,0xba,0xd7,0x9d,0xbb,0xca,0x10,0xa5,0x71,0xab,0xeb}, 0},
+    {{0x3f,0x27,0x7a,0x9b,0x91,0xf9,0x8f,0x89,0xcc,0xff,0xe8,0x4c,0x64,0x7d,0x89,0xb7,0x2a,0x94,0xc9,0x65,0xc1,0xe8,0x31,0x33,0xbc,0x94,0x31,0x15,0x1c,0x96,0xd8,0xb5}, 0},
+    {{0x3f,0x65,0x67,0x1c,0x9d,0xb3,0x4f,0x09,0xce,0x72,0xf1,0xb1,0x04,0xee,0xbd,0x68,0xc6,0xe6,0xc9,0x90,0x85,0x85,0x34,0x24,0xbb,0xea,0x30,0xf9,0x8d,0xbb,0xdb,0x50}, 0},
+    {{0x3f,0x65,0x67,0x1c,0x9d,0xb3,0x4f,0x09,0xce,0x72,0xf1,0xb1,0x04,0xee,0xbd,0x68,0xc6,0xe6,0xc9,0x90,0x85,0x85,0x34,0x24,0xbb,0xea,0x30,0xf9,0x8d,0xbb,0xdb,0x50}, 1},
+    {{0x3f,0x6f,0x80,0xe2,0x86,0xde,0xbb,0x4b,0x7e,0xfa,0x68,0xd2,0x11,0xbb,0x57,0xbc,0x32,0x96,0xd7,0xec,0xfc,0x33,0x30,0x07,0x5e,0x15,0xa8,0x34,0xe8,0xe9,0xfe,0x5a}, 0},
+    {{0x3f,0xa6,0x31,0x93,0x84,0x01,0xe1,0x45,0x43,0x48,0xf5,0xfd,0x28,0x60,0xbd,0x69,0xcb,0xb3,0x8d,0x5d,0xe6,0xd6,0xdb,0xbe,0x32,0x1b,0x90,0x87,0xe9,0x70,0x1a,0x08}, 0},
+    {{0x3f,0xa6,0x31,0x93,0x84,0x01,0xe1,0x45,0x43,0x48,0xf5,0xfd,0x28,0x60,0xbd,0x69,0xcb,0xb3,0x8d,0x5d,0xe6,0xd6,0xdb,0xbe,0x32,0x1b,0x90,0x87,0xe9,0x70,0x1a,0x08}, 1},
+    {{0x3f,0xb8,0x1c,0x2a,0x6b,0xe7,0x43,0x67,0x83,0xfb,0xfe,0x54,0x66,0x15,0x25,0xa1,0x43,0x22,0x2b,0x5e,0x58,0x99,0xa0,0xbf,0xd9,0xbf,0x1c,0xd1,0xc0,0xbc,0xa4,0x68}, 0},
+    {{0x3f,0xb8,0x1c,0x2a,0x6b,0xe7,0x43,0x67,0x83,0xfb,0xfe,0x54,0x66,0x15,0x25,0xa1,0x43,0x22,0x2b,0x5e,0x58,0x99,0xa0,0xbf,0xd9,0xbf,0x1c,0xd1,0xc0,0xbc,0xa4,0x68}, 1},
+    {{0x3f,0xd9,0x6e,0x4b,0x30,0x1f,0xcc,0x8e,0x59,0x34,0x61,0x53,0x84,0x71,0xd3,0x7c,0xc2,0x9c,0xa4,0x50,0x60,0x47,0x08,0x3d,0x33,0x0e,0xd3,0x78,0x43,0xe3,0x63,0x92}, 0},
+    {{0x3f,0xd9,0x6e,0x4b,0x30,0x1f,0xcc,0x8e,0x59,0x34,0x61,0x53,0x84,0x71,0xd3,0x7c,0xc2,0x9c,0xa4,0x50,0x60,0x47,0x08,0x3d,0x33,0x0e,0xd3,0x78,0x43,0xe3,0x63,0x92}, 1},
+    {{0x40,0x15,0x7c,0x05,0x03,0x66,0x94,0xaa,0x50,0x9a,0x36,0x7c,0xea,0x66,0x33,0x57,0x85,0x2c,0xaf,0x9c,0xeb,0xcf,0x27,0x63,0x5b,0x46,0xfc,0xbd,0x23,0xb4,0x24,0xb2}, 0},
+    {{0x40,0x15,0x7c,0x05,0x03,0x66,0x94,0xaa,0x50,0x9a,0x36,0x7c,0xea,0x66,0x33,0x57,0x85,0x2c,0xaf,0x9c,0xeb,0xcf,0x27,0x63,0x5b,0x46,0xfc,0xbd,0x23,0xb4,0x24,0xb2}, 1},
+    {{0x40,0x29,0xef,0xc5,0xdd,0xeb,0x99,0x7e,0x22,0x6c,0xc2,0xa7,0xfd,0xb4,0x5c,0x92,0x0f,0xf3,0x50,0xd0,0x6b,0xd9,0x1c,0x87,0xa1,0x6e,0xae,0x93,0x0a,0x6c,0x5b,0xf7}, 0},
+    {{0x40,0xb2,0x0a,0x0e,0x77,0x13,0x73,0x35,0x30,0x21,0x32,0x14,0x85,0xb2,0xc0,0x01,0x58,0xd9,0x65,0x09,0xe0,0xd5,0x94,0x92,0xb4,0x3c,0xc5,0x23,0xa3,0x4d,0xb8,0x1c}, 0},
+    {{0x40,0xb2,0x0a,0x0e,0x77,0x13,0x73,0x35,0x30,0x21,0x32,0x14,0x85,0xb2,0xc0,0x01,0x58,0xd9,0x65,0x09,0xe0,0xd5,0x94,0x92,0xb4,0x3c,0xc5,0x23,0xa3,0x4d,0xb8,0x1c}, 1},
+    {{0x40,0xc6,0x3f,0xdd,0xda,0xad,0xc5,0x92,0xd5,0xc9,0xf1,0x86,0x1a,0x08,0xbe,0xa2,0x0e,0x1b,0x66,0x79,0xdd,0x86,0x4f,0x44,0x5f,0xd7,0xf5,0xeb,0x2e,0xe1,0xa1,0x52}, 0},
+    {{0x40,0xc6,0x3f,0xdd,0xda,0xad,0xc5,0x92,0xd5,0xc9,0xf1,0x86,0x1a,0x08,0xbe,0xa2,0x0e,0x1b,0x66,0x79,0xdd,0x86,0x4f,0x44,0x5f,0xd7,0xf5,0xeb,0x2e,0xe1,0xa1,0x52}, 1},
+    {{0x40,0xd9,0xcf,0x5b,0x14,0x5a,0xc8,0xc4,0x75,0x2f,0xe6,0x1a,0x9c,0x05,0x87,0x75,0xb1,0xc9,0xd5,0x3d,0x67,0xa3,0x2b,0xbc,0x89,0x49,0x91,0xd3,0x1d,0x3a,0x49,0x9d}, 0},
+    {{0x41,0x1d,0x4f,0x66,0x05,0xd3,0x1f,0x96,0x7f,0xec,0x3b,0x2f,0x08,0x2e,0xbf,0x1c,0xd6,0x34,0x6b,0xba,0x17,0x7a,0xf6,0xe9,0x4b,0x11,0x52,0x8b,0x93,0x27,0x94,0x9d}, 0},
+    {{0x41,0x46,0x9c,0xf5,0xb9,0x9f,0xbc,0xb6,0x8a,0xc7,0x00,0x49,0x51,0x33,0xe3,0x30,0x59,0x1a,0xf2,0xaa,0xe6,0x5e,0xa0,0xd9,0x2d,0x3a,0x7b,0x44,0x3b,0x51,0x04,0xfb}, 0},
+    {{0x41,0x46,0x9c,0xf5,0xb9,0x9f,0xbc,0xb6,0x8a,0xc7,0x00,0x49,0x51,0x33,0xe3,0x30,0x59,0x1a,0xf2,0xaa,0xe6,0x5e,0xa0,0xd9,0x2d,0x3a,0x7b,0x44,0x3b,0x51,0x04,0xfb}, 1},
+    {{0x41,0x8a,0x26,0x77,0x0e,0x9a,0xda,0xd7,0x7a,0x9f,0x96,0xa2,0x51,0xef,0xb0,0x51,0x0f,0x0f,0x21,0x39,0xf5,0xc0,0x1a,0x43,0x1c,0x64,0x0a,0x68,0x41,0x49,0xc2,0x57}, 0},
+    {{0x41,0xb9,0xbd,0xa6,0x8d,0xb0,0xaa,0xaa,0x03,0x35,0x51,0x3f,0xd0,0xd1,0x36,0x6b,0xe5,0xbc,0x8d,0x33,0xa8,0x21,0x70,0xfa,0xbe,0x47,0x23,0x69,0x3d,0x3a,0x52,0xeb}, 0},
+    {{0x41,0xb9,0xbd,0xa6,0x8d,0xb0,0xaa,0xaa,0x03,0x35,0x51,0x3f,0xd0,0xd1,0x36,0x6b,0xe5,0xbc,0x8d,0x33,0xa8,0x21,0x70,0xfa,0xbe,0x47,0x23,0x69,0x3d,0x3a,0x52,0xeb}, 1},
+    {{0x42,0xb4,0x1a,0x77,0xcd,0x94,0xfd,0x31,0x10,0xfb,0xe0,0x5c,0x15,0x61,0xde,0x7a,0x75,0x67,0x3e,0xd2,0xca,0xd4,0x59,0x9e,0xcc,0x1a,0x88,0xfd,0xf2,0x78,0xc0,0xfc}, 0},
+    {{0x42,0xb4,0x1a,0x77,0xcd,0x94,0xfd,0x31,0x10,0xfb,0xe0,0x5c,0x15,0x61,0xde,0x7a,0x75,0x67,0x3e,0xd2,0xca,0xd4,0x59,0x9e,0xcc,0x1a,0x88,0xfd,0xf2,0x78,0xc0,0xfc}, 1},
+    {{0x42,0xfc,0x9f,0x3b,0x61,0xfc,0x75,0xe7,0x76,0x92,0x90,0x7f,0x9a,0x26,0x74,0x44,0x00,0xa3,0x38,0xb2,0x7e,0x1c,0xcf,0xbb,0x1c,0x0b,0xa6,0xab,0xb7,0xc5,0x04,0xa6}, 0},
+    {{0x43,0x34,0x05,0x57,0xd8,0xe0,0xc4,0xf0,0xf9,0x1a,0xd9,0x25,0x8c,0x62,0x4d,0xef,0xf3,0x2d,0x7f,0x63,0xed,0x74,0x09,0xc0,0xa3,0xec,0x64,0x01,0x16,0xc1,0x3b,0x35}, 0},
+    {{0x43,0x34,0x05,0x57,0xd8,0xe0,0xc4,0xf0,0xf9,0x1a,0xd9,0x25,0x8c,0x62,0x4d,0xef,0xf3,0x2d,0x7f,0x63,0xed,0x74,0x09,0xc0,0xa3,0xec,0x64,0x01,0x16,0xc1,0x3b,0x35}, 1},
+    {{0x43,0x4f,0x84,0x13,0xbb,0x79,0xb8,0xf8,0xdf,0x36,0x19,0x4a,0x4e,0xcf,0x73,0x5e,0xc5,0xe2,0x8f,0xfe,0x76,0xbd,0x9a,0xc2,0xc9,0x61,0x39,0xc5,0xc5,0x31,0xda,0x19}, 0},
+    {{0x43,0x4f,0x84,0x13,0xbb,0x79,0xb8,0xf8,0xdf,0x36,0x19,0x4a,0x4e,0xcf,0x73,0x5e,0xc5,0xe2,0x8f,0xfe,0x76,0xbd,0x9a,0xc2,0xc9,0x61,0x39,0xc5,0xc5,0x31,0xda,0x19}, 1},
+    {{0x43,0x99,0x23,0x6e,0x27,0x63,0x6e,0x00,0x4f,0x84,0xc3,0x73,0xed,0x30,0x1e,0x07,0xdf,0x93,0xdb,0x98,0xe1,0xd9,0xd0,0xfb,0x82,0x05,0xc5,0x30,0xd3,0x51,0x77,0x83}, 0},
+    {{0x43,0xd4,0xfb,0xd4,0xbf,0xec,0xac,0x00,0x47,0xac,0x71,0x66,0x7a,0x2b,0xf5,0x11,0x70,0x1c,0xb6,0xb9,0xdb,0xd9,0x45,0xe3,0xd7,0x8c,0x8c,0x77,0xfe,0xa3,0x7f,0xdc}, 0},
+    {{0x43,0xd8,0xd4,0x2b,0xc8,0x9d,0x9b,0x5d,0x5f,0xe5,0x67,0x2e,0x09,0x30,0xb1,0x31,0xf5,0xd3,0x68,0x2f,0x26,0x88,0x79,0xf6,0x91,0x44,0x5c,0xea,0xd7,0xcd,0x72,0x23}, 0},
+    {{0x43,0xf6,0x76,0x48,0x21,0xad,0x27,0xb6,0x58,0xaa,0x8e,0xfd,0x73,0x38,0x93,0x9f,0xa9,0x33,0x1b,0x55,0x4d,0x2d,0xd2,0xbe,0x7e,0x8b,0x5b,0xac,0x6a,0xb4,0x80,0x89}, 0},
+    {{0x43,0xf6,0x76,0x48,0x21,0xad,0x27,0xb6,0x58,0xaa,0x8e,0xfd,0x73,0x38,0x93,0x9f,0xa9,0x33,0x1b,0x55,0x4d,0x2d,0xd2,0xbe,0x7e,0x8b,0x5b,0xac,0x6a,0xb4,0x80,0x89}, 1},
+    {{0x44,0x46,0x07,0xae,0x90,0x00,0x24,0x0d,0xf0,0xe2,0x24,0x05,0x0a,0x0c,0x5e,0x34,0x06,0xbb,0x93,0x05,0x8e,0x5f,0xf0,0x9c,0x5d,0x12,0x66,0x6e,0x1f,0x1e,0x27,0xf3}, 0},
+    {{0x44,0x46,0x07,0xae,0x90,0x00,0x24,0x0d,0xf0,0xe2,0x24,0x05,0x0a,0x0c,0x5e,0x34,0x06,0xbb,0x93,0x05,0x8e,0x5f,0xf0,0x9c,0x5d,0x12,0x66,0x6e,0x1f,0x1e,0x27,0xf3}, 1},
+    {{0x44,0x61,0xca,0x46,0xc4,0xfb,0x28,0xe0,0xf4,0x1e,0x00,0x34,0xdb,0x0c,0x01,0xbb,0x3f,0x37,0xc7,0xdc,0x3b,0x88,0x5b,0xe4,0xf0,0xaf,0x4a,0xb5,0x12,0x7e,0xb7,0x13}, 0},
+    {{0x44,0xaa,0xde,0x70,0xd6,0xd7,0x64,0x6f,0xf4,0xc8,0x2c,0xec,0x42,0x48,0xd5,0xb7,0xad,0xdc,0x8a,0x04,0x6f,0x59,0xb9,0xee,0x19,0x9e,0xef,0xb4,0x27,0x70,0x8f,0x94}, 0},
+    {{0x44,0xaa,0xde,0x70,0xd6,0xd7,0x64,0x6f,0xf4,0xc8,0x2c,0xec,0x42,0x48,0xd5,0xb7,0xad,0xdc,0x8a,0x04,0x6f,0x59,0xb9,0xee,0x19,0x9e,0xef,0xb4,0x27,0x70,0x8f,0x94}, 1},
+    {{0x44,0xbc,0xb2,0x73,0xf8,0xc4,0x6a,0x9c,0x54,0xb5,0xcf,0x8d,0xaf,0xd2,0x38,0x79,0xe0,0xa3,0x46,0x9a,0x5d,0xed,0xcb,0xe4,0xc4,0x12,0x0e,0x21,0xb8,0xf3,0x67,0x0a}, 0},
+    {{0x44,0xc5,0xcf,0x8e,0xac,0x5e,0x10,0xf5,0x18,0xfd,0x51,0x17,0x62,0x5d,0x92,0x4f,0x25,0xc0,0xee,0x64,0x63,0x84,0x08,0x4e,0x10,0xf9,0xd7,0x5e,0x2a,0xe0,0x27,0x3a}, 0},
+    {{0x44,0xc5,0xcf,0x8e,0xac,0x5e,0x10,0xf5,0x18,0xfd,0x51,0x17,0x62,0x5d,0x92,0x4f,0x25,0xc0,0xee,0x64,0x63,0x84,0x08,0x4e,0x10,0xf9,0xd7,0x5e,0x2a,0xe0,0x27,0x3a}, 1},
+    {{0x44,0xdf,0x21,0x2a,0xe9,0x85,0xf1,0xa8,0x42,0x4a,0xff,0xe1,0xd2,0x70,0xbf,0x5d,0x77,0x90,0x38,0x88,0xa2,0x9c,0x4e,0xee,0x6f,0x2c,0x24,0x30,0x31,0xa4,0x50,0xd5}, 0},
+    {{0x44,0xdf,0x21,0x2a,0xe9,0x85,0xf1,0xa8,0x42,0x4a,0xff,0xe1,0xd2,0x70,0xbf,0x5d,0x77,0x90,0x38,0x88,0xa2,0x9c,0x4e,0xee,0x6f,0x2c,0x24,0x30,0x31,0xa4,0x50,0xd5}, 1},
+    {{0x45,0xaa,0xe4,0x6d,0x39,0x66,0xe0,0x68,0x05,0xc0,0x3e,0xf0,0x03,0x41,0xd7,0xab,0x58,0xdb,0x8d,0xe5,0x2d,0x25,0xc3,0xb9,0x3a,0x78,0x08,0x2c,0x99,0xf7,0x4d,0x1e}, 0},
+    {{0x45,0xaa,0xe4,0x6d,0x39,0x66,0xe0,0x68,0x05,0xc0,0x3e,0xf0,0x03,0x41,0xd7,0xab,0x58,0xdb,0x8d,0xe5,0x2d,0x25,0xc3,0xb9,0x3a,0x78,0x08,0x2c,0x99,0xf7,0x4d,0x1e}, 1},
+    {{0x46,0x0d,0x5c,0xcc,0x27,0x45,0xfe,0xe0,0x5e,0x4c,0x6c,0xf2,0x4d,0x99,0x8f,0x57,0xb9,0xce,0xe5,0x9e,0x66,0x38,0x3d,0x98,0xe0,0x0f,0x4f,0xdb,0x5b,0xde,0xdc,0x29}, 0},
+    {{0x46,0x0d,0x5c,0xcc,0x27,0x45,0xfe,0xe0,0x5e,0x4c,0x6c,0xf2,0x4d,0x99,0x8f,0x57,0xb9,0xce,0xe5,0x9e,0x66,0x38,0x3d,0x98,0xe0,0x0f,0x4f,0xdb,0x5b,0xde,0xdc,0x29}, 1},
+    {{0x46,0x27,0xb5,0xb4,0xf0,0xc8,0x87,0x47,0x5d,0x4b,0xd8,0x68,0xf6,0x12,0xef,0xed,0x72,0x58,0x1d,0xae,0x8a,0x7b,0x76,0x4d,0xd3,0x8b,0x1e,0x01,0xa5,0xa0,0x57,0x03}, 0},
+    {{0x46,0x27,0xb5,0xb4,0xf0,0xc8,0x87,0x47,0x5d,0x4b,0xd8,0x68,0xf6,0x12,0xef,0xed,0x72,0x58,0x1d,0xae,0x8a,0x7b,0x76,0x4d,0xd3,0x8b,0x1e,0x01,0xa5,0xa0,0x57,0x03}, 1},
+    {{0x46,0x2b,0x99,0x47,0xc4,0xc3,0xe3,0x8e,0xa9,0x43,0xf8,0x6d,0x48,0x75,0x48,0x65,0xe7,0x7b,0xde,0xd0,0xf6,0xba,0xa7,0xb5,0x23,0x1c,0xa5,0x74,0xa1,0x15,0x81,0x22}, 0},
+    {{0x46,0x2b,0x99,0x47,0xc4,0xc3,0xe3,0x8e,0xa9,0x43,0xf8,0x6d,0x48,0x75,0x48,0x65,0xe7,0x7b,0xde,0xd0,0xf6,0xba,0xa7,0xb5,0x23,0x1c,0xa5,0x74,0xa1,0x15,0x81,0x22}, 1},
+    {{0x46,0x44,0x48,0x4e,0x72,0xec,0x2e,0xe3,0xd1,0xdd,0x7c,0x20,0xad,0x9c,0x9b,0x3f,0x39,0xd8,0x17,0x64,0x76,0xeb,0x1c,0xd1,0x47,0x91,0xa5,0xe5,0xc0,0x52,0x98,0xa8}, 0},
+    {{0x46,0x44,0x48,0x4e,0x72,0xec,0x2e,0xe3,0xd1,0xdd,0x7c,0x20,0xad,0x9c,0x9b,0x3f,0x39,0xd8,0x17,0x64,0x76,0xeb,0x1c,0xd1,0x47,0x91,0xa5,0xe5,0xc0,0x52,0x98,0xa8}, 1},
+    {{0x46,0x91,0x49,0xe4,0x6d,0x5e,0x3e,0xe0,0x86,0xfa,0x5b,0x6a,0xdf,0x9a,0xeb,0x3c,0xaf,0x66,0x38,0x71,0x80,0xf3,0x28,0x68,0x4a,0x7b,0x55,0x75,0x2f,0xcd,0x02,0x9f}, 0},
+    {{0x46,0xfe,0x88,0x5a,0x5e,0x29,0xad,0x4f,0xaf,0xf7,0x80,0x09,0xce,0xb1,0x6f,0xc4,0x17,0xbc,0x2c,0x4a,0xc2,0xe6,0xd4,0x4f,0x35,0xe3,0xd0,0xb5,0xf8,0xac,0xc9,0xab}, 0},
+    {{0x46,0xfe,0x88,0x5a,0x5e,0x29,0xad,0x4f,0xaf,0xf7,0x80,0x09,0xce,0xb1,0x6f,0xc4,0x17,0xbc,0x2c,0x4a,0xc2,0xe6,0xd4,0x4f,0x35,0xe3,0xd0,0xb5,0xf8,0xac,0xc9,0xab}, 1},
+    {{0x47,0x21,0x44,0xb4,0xde,0xfb,0x5e,0x3e,0x03,0x1c,0xc5,0xae,0xd1,0x01,0x9a,0x16,0x7b,0x2d,0x72,0x3b,0x6b,0x1a,0x8e,0xea,0xe3,0x4d,0xf0,0x96,0x39,0x69,0x51,0x7a}, 0},
+    {{0x47,0x21,0x44,0xb4,0xde,0xfb,0x5e,0x3e,0x03,0x1c,0xc5,0xae,0xd1,0x01,0x9a,0x16,0x7b,0x2d,0x72,0x3b,0x6b,0x1a,0x8e,0xea,0xe3,0x4d,0xf0,0x96,0x39,0x69,0x51,0x7a}, 1},
+    {{0x47,0x60,0x25,0x24,0xfb,0x3b,0x46,0x72,0x4f,0x26,0xbf,0x8c,0xbe,0x1b,0x06,0x1c,0x60,0xfe,0xc4,0x4b,0x4b,0x43,0xd9,0xe5,0x3b,0xe1,0xad,0x1b,0x58,0x5b,0xc2,0xf1}, 0},
+    {{0x47,0xdb,0xfa,0x20,0xbb,0x6f,0x16,0xc8,0x37,0x0a,0x21,0x70,0xef,0xcf,0xdc,0xab,0xfb,0x33,0xa6,0x21,0xac,0x45,0x84,0x43,0xdb,0x0d,0x71,0xc5,0x6c,0x9d,0xcd,0xab}, 0},
+    {{0x47,0xea,0x80,0xc8,0xac,0x15,0xa6,0xca,0x3e,0xc4,0x67,0x96,0xd4,0x41,0x72,0x35,0x6b,0x7b,0x94,0xc8,0xfb,0x53,0x1b,0x12,0x2b,0x11,0xc8,0x91,0x90,0x1c,0x5d,0x3c}, 0},
+    {{0x48,0xf3,0x9b,0xda,0x21,0xf1,0x6a,0x20,0xee,0xf5,0xdb,0x6a,0x56,0xba,0x85,0x68,0xe8,0x7e,0xfc,0x8c,0x08,0x71,0x03,0x5c,0x83,0xcb,0xec,0x31,0x02,0x24,0x93,0x09}, 0},
+    {{0x48,0xf3,0x9b,0xda,0x21,0xf1,0x6a,0x20,0xee,0xf5,0xdb,0x6a,0x56,0xba,0x85,0x68,0xe8,0x7e,0xfc,0x8c,0x08,0x71,0x03,0x5c,0x83,0xcb,0xec,0x31,0x02,0x24,0x93,0x09}, 1},
+    {{0x49,0x05,0x39,0x14,0x17,0xf9,0x5f,0x7b,0xa3,0xbf,0x8c,0xd2,0xb1,0x82,0x58,0x1c,0xa8,0x09,0x88,0xbf,0xea,0x41,0x2c,0xac,0x4a,0xdb,0xe1,0x09,0x39,0x48,0x8d,0xf7}, 0},
+    {{0x49,0x05,0x39,0x14,0x17,0xf9,0x5f,0x7b,0xa3,0xbf,0x8c,0xd2,0xb1,0x82,0x58,0x1c,0xa8,0x09,0x88,0xbf,0xea,0x41,0x2c,0xac,0x4a,0xdb,0xe1,0x09,0x39,0x48,0x8d,0xf7}, 1},
+    {{0x49,0x10,0x98,0x9d,0x2b,0x9d,0x06,0x0e,0x43,0xd1,0x16,0xae,0x9b,0x84,0x92,0x0d,0x56,0x8e,0x48,0x45,0xc9,0xa9,0xea,0xa4,0x72,0x4d,0x33,0x3e,0x15,0x54,0x7a,0x4e}, 0},
+    {{0x49,0x30,0x75,0x4c,0x2d,0x5b,0x0b,0xa2,0x2b,0x08,0x53,0x9b,0x7c,0x5b,0xcb,0x44,0x43,0xb2,0xf4,0xeb,0x90,0xe3,0xc2,0x71,0x74,0xcd,0x91,0xc4,0x20,0x19,0x0f,0x7e}, 0},
+    {{0x49,0x30,0x75,0x4c,0x2d,0x5b,0x0b,0xa2,0x2b,0x08,0x53,0x9b,0x7c,0x5b,0xcb,0x44,0x43,0xb2,0xf4,0xeb,0x90,0xe3,0xc2,0x71,0x74,0xcd,0x91,0xc4,0x20,0x19,0x0f,0x7e}, 1},
+    {{0x49,0xc9,0xff,0x8b,0xe3,0x81,0x74,0x47,0x85,0x5f,0xee,0xca,0xf2,0xb6,0x9c,0x6f,0xa2,0x98,0x1b,0x21,0x2f,0x1d,0x50,0x3e,0x91,0x94,0x42,0x1c,0x8d,0x0e,0xcd,0xfb}, 0},
+    {{0x49,0xc9,0xff,0x8b,0xe3,0x81,0x74,0x47,0x85,0x5f,0xee,0xca,0xf2,0xb6,0x9c,0x6f,0xa2,0x98,0x1b,0x21,0x2f,0x1d,0x50,0x3e,0x91,0x94,0x42,0x1c,0x8d,0x0e,0xcd,0xfb}, 1},
+    {{0x49,0xd5,0xd7,0xcb,0x6e,0x61,0x84,0xe5,0xc2,0xf2,0x35,0x09,0x4c,0x80,0xf6,0xec,0x24,0x95,0xb7,0x28,0x97,0xa6,0xfc,0xdf,0x0d,0x26,0xf1,0x5f,0x85,0x83,0xbf,0xe2}, 0},
+    {{0x49,0xd5,0xd7,0xcb,0x6e,0x61,0x84,0xe5,0xc2,0xf2,0x35,0x09,0x4c,0x80,0xf6,0xec,0x24,0x95,0xb7,0x28,0x97,0xa6,0xfc,0xdf,0x0d,0x26,0xf1,0x5f,0x85,0x83,0xbf,0xe2}, 1},
+    {{0x49,0xe9,0x82,0x55,0xc0,0x81,0xb3,0x43,0x39,0xce,0x11,0x2e,0x44,0x49,0x81,0x64,0x1f,0x36,0x51,0xb6,0x98,0x6a,0xaa,0x2e,0x87,0xc9,0x24,0xac,0x73,0x60,0xc1,0xbd}, 0},
+    {{0x4a,0x75,0xf0,0x3d,0xaa,0xa1,0x66,0x7f,0x36,0xa2,0x87,0x5d,0x02,0x0a,0x5d,0x1b,0x85,0x2e,0x30,0xf5,0xe1,0x4b,0xfd,0xc7,0x5c,0x50,0xd1,0x70,0x31,0xbe,0x85,0x3a}, 0},
+    {{0x4a,0x75,0xf0,0x3d,0xaa,0xa1,0x66,0x7f,0x36,0xa2,0x87,0x5d,0x02,0x0a,0x5d,0x1b,0x85,0x2e,0x30,0xf5,0xe1,0x4b,0xfd,0xc7,0x5c,0x50,0xd1,0x70,0x31,0xbe,0x85,0x3a}, 1},
+    {{0x4a,0xb6,0xfe,0x52,0xc3,0xf7,0xc6,0x05,0xd4,0xde,0x07,0x65,0xa5,0x9f,0x4d,0x88,0xa0,0xaf,0xe0,0x6c,0x17,0x8c,0x3f,0x9a,0xc7,0xbc,0x38,0xc3,0x2f,0x11,0xb4,0x97}, 0},
+    {{0x4a,0xb6,0xfe,0x52,0xc3,0xf7,0xc6,0x05,0xd4,0xde,0x07,0x65,0xa5,0x9f,0x4d,0x88,0xa0,0xaf,0xe0,0x6c,0x17,0x8c,0x3f,0x9a,0xc7,0xbc,0x38,0xc3,0x2f,0x11,0xb4,0x97}, 1},
+    {{0x4a,0xe7,0xc2,0x3a,0x03,0x2a,0x22,0x30,0x6b,0x59,0x3b,0xd9,0x1e,0x6a,0x3e,0x69,0x61,0x03,0xb4,0xe0,0x49,0xee,0xfe,0x3a,0x71,0xea,0x82,0xa8,0x92,0xbb,0x03,0x95}, 0},
+    {{0x4a,0xe7,0xc2,0x3a,0x03,0x2a,0x22,0x30,0x6b,0x59,0x3b,0xd9,0x1e,0x6a,0x3e,0x69,0x61,0x03,0xb4,0xe0,0x49,0xee,0xfe,0x3a,0x71,0xea,0x82,0xa8,0x92,0xbb,0x03,0x95}, 1},
+    {{0x4a,0xf7,0xe6,0x99,0xaa,0x26,0x3c,0xe8,0x5a,0x59,0xbf,0x6b,0x81,0x3a,0x91,0x81,0x81,0x7c,0x8c,0xeb,0x19,0x70,0x77,0x59,0xf6,0x64,0xbb,0xb8,0x3f,0x90,0xd8,0x9b}, 0},
+    {{0x4a,0xfd,0x0a,0xe5,0xa1,0x28,0x23,0x50,0x58,0x8d,0x9d,0xcb,0xd0,0xad,0xb1,0x40,0x12,0x08,0x1d,0xfa,0x73,0xf4,0x42,0xce,0x4e,0x7b,0x0c,0x6a,0x29,0x86,0x77,0x79}, 0},
+    {{0x4a,0xfd,0x0a,0xe5,0xa1,0x28,0x23,0x50,0x58,0x8d,0x9d,0xcb,0xd0,0xad,0xb1,0x40,0x12,0x08,0x1d,0xfa,0x73,0xf4,0x42,0xce,0x4e,0x7b,0x0c,0x6a,0x29,0x86,0x77,0x79}, 1},
+    {{0x4b,0x86,0x4f,0x8d,0xad,0x3d,0xa2,0x5a,0xc1,0x84,0x53,0x57,0x84,0xca,0x19,0x4e,0x50,0x37,0x8a,0x5c,0xcf,0x5b,0x1e,0xd3,0xce,0x3a,0xda,0xe0,0x15,0x5c,0xc0,0x6f}, 0},
+    {{0x4b,0x8f,0xd8,0x3d,0x77,0xd2,0xe8,0xba,0x31,0x43,0x4f,0x10,0x92,0x72,0xbc,0x03,0x51,0x28,0x3c,0x1a,0x23,0x55,0x1c,0xba,0x1b,0x94,0x27,0x87,0xb2,0x14,0x87,0x60}, 0},
+    {{0x4b,0x8f,0xd8,0x3d,0x77,0xd2,0xe8,0xba,0x31,0x43,0x4f,0x10,0x92,0x72,0xbc,0x03,0x51,0x28,0x3c,0x1a,0x23,0x55,0x1c,0xba,0x1b,0x94,0x27,0x87,0xb2,0x14,0x87,0x60}, 1},
+    {{0x4b,0xb2,0x18,0xe3,0x95,0x76,0xdd,0xe5,0x37,0x04,0x61,0x85,0xf1,0x1f,0xac,0xc4,0x7c,0x98,0xc9,0xfc,0xb2,0x4a,0x04,0x91,0x7a,0xb6,0x57,0xa9,0x85,0x79,0xf6,0xe6}, 0},
+    {{0x4b,0xb2,0x18,0xe3,0x95,0x76,0xdd,0xe5,0x37,0x04,0x61,0x85,0xf1,0x1f,0xac,0xc4,0x7c,0x98,0xc9,0xfc,0xb2,0x4a,0x04,0x91,0x7a,0xb6,0x57,0xa9,0x85,0x79,0xf6,0xe6}, 1},
+    {{0x4c,0x04,0xa4,0x95,0xa5,0xd0,0xe7,0x29,0xd9,0x41,0x96,0x90,0x8c,0x6b,0x58,0x76,0x3f,0x3d,0xee,0xb7,0x73,0xbf,0x58,0x4c,0x30,0xe1,0x41,0x8e,0xf7,0x38,0x83,0xe3}, 0},
+    {{0x4c,0x04,0xa4,0x95,0xa5,0xd0,0xe7,0x29,0xd9,0x41,0x96,0x90,0x8c,0x6b,0x58,0x76,0x3f,0x3d,0xee,0xb7,0x73,0xbf,0x58,0x4c,0x30,0xe1,0x41,0x8e,0xf7,0x38,0x83,0xe3}, 1},
+    {{0x4c,0x4f,0x3c,0xea,0x11,0x75,0xa7,0xd8,0x15,0x23,0xb6,0x75,0xe2,0x92,0x62,0x25,0x8e,0x31,0x3e,0x0c,0xe3,0x7b,0xbc,0x16,0x56,0x51,0x75,0xad,0x63,0x4a,0xaf,0x25}, 0},
+    {{0x4c,0x6b,0x58,0x06,0x6d,0x30,0xcf,0x98,0x4a,0xee,0x06,0xb0,0x7c,0x67,0xf4,0x61,0x27,0xe3,0x9b,0xab,0x9a,0xde,0x78,0x97,0xb7,0x9f,0x35,0xfd,0x11,0x4f,0x69,0xbf}, 0},
+    {{0x4c,0x6b,0x58,0x06,0x6d,0x30,0xcf,0x98,0x4a,0xee,0x06,0xb0,0x7c,0x67,0xf4,0x61,0x27,0xe3,0x9b,0xab,0x9a,0xde,0x78,0x97,0xb7,0x9f,0x35,0xfd,0x11,0x4f,0x69,0xbf}, 1},
+    {{0x4c,0x73,0xee,0x87,0x5f,0xff,0xb4,0x44,0xf2,0x56,0xf6,0x44,0x06,0x4a,0x9f,0x04,0x46,0xbd,0x29,0xd6,0x72,0x11,0xf6,0xa8,0x83,0xb1,0x4e,0x9c,0xda,0x0c,0x05,0xa0}, 0},
+    {{0x4c,0x8e,0x0e,0x4c,0x13,0x09,0x10,0x05,0x80,0x83,0xfb,0x9b,0x91,0x8e,0xf7,0x03,0x66,0x3b,0xe5,0x56,0x17,0x30,0x0a,0x1c,0x62,0xb7,0x8f,0x1c,0x7e,0x21,0xb7,0xfd}, 0},
+    {{0x4c,0x8e,0x0e,0x4c,0x13,0x09,0x10,0x05,0x80,0x83,0xfb,0x9b,0x91,0x8e,0xf7,0x03,0x66,0x3b,0xe5,0x56,0x17,0x30,0x0a,0x1c,0x62,0xb7,0x8f,0x1c,0x7e,0x21,0xb7,0xfd}, 1},
+    {{0x4c,0xbf,0x3d,0xe9,0x88,0x6b,0xeb,0x2b,0xc2,0x04,0x8c,0x41,0x4e,0xc9,0x53,0x08,0xec,0xc2,0xc5,0x1f,0x93,0x26,0xa0,0x3a,0x05,0x61,0xbf,0x04,0x90,0x1a,0x9f,0xea}, 0},
+    {{0x4c,0xbf,0x3d,0xe9,0x88,0x6b,0xeb,0x2b,0xc2,0x04,0x8c,0x41,0x4e,0xc9,0x53,0x08,0xec,0xc2,0xc5,0x1f,0x93,0x26,0xa0,0x3a,0x05,0x61,0xbf,0x04,0x90,0x1a,0x9f,0xea}, 1},
+    {{0x4c,0xd2,0x5b,0x7d,0x83,0x1f,0x7c,0xb9,0x95,0x01,0x4a,0xa7,0xb8,0xdb,0x2b,0x6c,0xb3,0x90,0x51,0x7b,0xb0,0xde,0x48,0x8d,0x28,0xcc,0x0a,0x58,0x2d,0x40,0xba,0xe2}, 0},
+    {{0x4c,0xf2,0x65,0x1b,0xd3,0x39,0x9f,0xd6,0x70,0xb6,0x6d,0xad,0x48,0x98,0x90,0x6a,0x0d,0x80,0x92,0x33,0xd4,0x10,0x73,0x4d,0xfa,0x17,0x97,0x73,0xae,0x8c,0xbd,0xbe}, 0},
+    {{0x4c,0xf2,0x65,0x1b,0xd3,0x39,0x9f,0xd6,0x70,0xb6,0x6d,0xad,0x48,0x98,0x90,0x6a,0x0d,0x80,0x92,0x33,0xd4,0x10,0x73,0x4d,0xfa,0x17,0x97,0x73,0xae,0x8c,0xbd,0xbe}, 1},
+    {{0x4c,0xf3,0xc5,0x37,0x2d,0x08,0xaf,0xec,0xf6,0xf4,0xaa,0x26,0x6b,0xb5,0x59,0xb1,0xa7,0x4e,0xcf,0x39,0x06,0x03,0x33,0xb3,0x39,0x71,0x3b,0xd7,0x06,0x1c,0xf9,0x2a}, 0},
+    {{0x4c,0xf3,0xc5,0x37,0x2d,0x08,0xaf,0xec,0xf6,0xf4,0xaa,0x26,0x6b,0xb5,0x59,0xb1,0xa7,0x4e,0xcf,0x39,0x06,0x03,0x33,0xb3,0x39,0x71,0x3b,0xd7,0x06,0x1c,0xf9,0x2a}, 1},
+    {{0x4d,0x73,0x53,0x52,0x75,0x02,0x3c,0x39,0xed,0xe8,0x59,0x5f,0x7e,0x25,0x46,0x61,0xe6,0x9e,0xa9,0x8b,0x38,0xf3,0x57,0x77,0xaf,0x2c,0x94,0xc9,0xb2,0x44,0x50,0x94}, 0},
+    {{0x4d,0x73,0x53,0x52,0x75,0x02,0x3c,0x39,0xed,0xe8,0x59,0x5f,0x7e,0x25,0x46,0x61,0xe6,0x9e,0xa9,0x8b,0x38,0xf3,0x57,0x77,0xaf,0x2c,0x94,0xc9,0xb2,0x44,0x50,0x94}, 1},
+    {{0x4d,0xca,0xf6,0x9e,0xfb,0x6e,0x22,0x29,0xa8,0xca,0x6e,0xc4,0xcf,0x13,0x00,0x45,0xeb,0x50,0xa0,0x54,0x7c,0x45,0x1b,0xf5,0x68,0xc5,0xea,0x13,0xb0,0x3e,0x58,0xf3}, 0},
+    {{0x4d,0xca,0xf6,0x9e,0xfb,0x6e,0x22,0x29,0xa8,0xca,0x6e,0xc4,0xcf,0x13,0x00,0x45,0xeb,0x50,0xa0,0x54,0x7c,0x45,0x1b,0xf5,0x68,0xc5,0xea,0x13,0xb0,0x3e,0x58,0xf3}, 1},
+    {{0x4d,0xfb,0xed,0xf7,0x28,0x28,0x79,0xa0,0xe0,0xab,0xa6,0xed,0x7d,0xdb,0xc3,0xc7,0xd5,0x51,0x56,0xf5,0x15,0xfd,0x22,0x23,0x50,0x3c,0x46,0x22,0x96,0x59,0x09,0xdd}, 0},
+    {{0x4d,0xfb,0xed,0xf7,0x28,0x28,0x79,0xa0,0xe0,0xab,0xa6,0xed,0x7d,0xdb,0xc3,0xc7,0xd5,0x51,0x56,0xf5,0x15,0xfd,0x22,0x23,0x50,0x3c,0x46,0x22,0x96,0x59,0x09,0xdd}, 1},
+    {{0x4e,0x51,0xa0,0x53,0x77,0x24,0x00,0x61,0xff,0xe1,0x96,0x3c,0x25,0x6a,0x1b,0xf6,0xa7,0x12,0x09,0x1a,0x87,0xa3,0x6a,0x28,0x3c,0x50,0x38,0x7b,0xc2,0xd5,0x2f,0xe9}, 0},
+    {{0x4e,0x5e,0xe7,0x3e,0x5b,0x9b,0xad,0x0e,0x6f,0x73,0x96,0xe8,0x6c,0x26,0xff,0x82,0xd5,0x72,0x0d,0x70,0xd0,0xb2,0x3c,0xef,0x29,0x03,0x04,0x67,0x6e,0xfe,0x96,0xa0}, 0},
+    {{0x4e,0x61,0x1a,0xb2,0x6c,0x53,0x9e,0xe6,0x01,0xb7,0xf6,0xa4,0x71,0xd4,0x68,0x6a,0xf4,0x8b,0x35,0x22,0xb6,0xf3,0x01,0x9e,0x95,0xf9,0x03,0x5d,0x46,0x70,0x99,0xe1}, 0},
+    {{0x4e,0x9c,0x25,0xed,0x7a,0x9e,0x7f,0x8e,0xaf,0x10,0x4a,0x10,0xe3,0x77,0xa0,0x04,0x40,0xf7,0xfd,0xad,0x45,0xfb,0x62,0x00,0xa3,0xd5,0x2d,0x2c,0xba,0xd9,0xbb,0xe8}, 0},
+    {{0x4e,0x9c,0x25,0xed,0x7a,0x9e,0x7f,0x8e,0xaf,0x10,0x4a,0x10,0xe3,0x77,0xa0,0x04,0x40,0xf7,0xfd,0xad,0x45,0xfb,0x62,0x00,0xa3,0xd5,0x2d,0x2c,0xba,0xd9,0xbb,0xe8}, 1},
+    {{0x4e,0xd4,0x8f,0x0b,0xf4,0x15,0x0c,0x38,0xd4,0xcb,0xa8,0xfa,0x1d,0x40,0x1d,0x2e,0x76,0x75,0x66,0x22,0x3c,0xf6,0x28,0x3c,0xa9,0xb5,0x24,0x88,0x3c,0xfb,0x2d,0x1b}, 0},
+    {{0x4e,0xd4,0x8f,0x0b,0xf4,0x15,0x0c,0x38,0xd4,0xcb,0xa8,0xfa,0x1d,0x40,0x1d,0x2e,0x76,0x75,0x66,0x22,0x3c,0xf6,0x28,0x3c,0xa9,0xb5,0x24,0x88,0x3c,0xfb,0x2d,0x1b}, 1},
+    {{0x4e,0xe0,0xed,0x4f,0x63,0x47,0xd3,0x6d,0x4e,0x61,0xcf,0xc6,0x52,0x2c,0xcb,0xed,0x4e,0xfa,0x27,0x4d,0x6b,0x8f,0x40,0xf4,0xc3,0x9a,0xab,0xe5,0x00,0x00,0xee,0x90}, 0},
+    {{0x4e,0xe0,0xed,0x4f,0x63,0x47,0xd3,0x6d,0x4e,0x61,0xcf,0xc6,0x52,0x2c,0xcb,0xed,0x4e,0xfa,0x27,0x4d,0x6b,0x8f,0x40,0xf4,0xc3,0x9a,0xab,0xe5,0x00,0x00,0xee,0x90}, 1},
+    {{0x4f,0x33,0x99,0xa4,0x14,0x29,0x8c,0xfd,0xce,0x09,0xcd,0x97,0x07,0x3a,0x23,0xa0,0xf8,0xae,0x00,0x75,0x56,0xf1,0x84,0x5d,0x26,0x64,0x30,0x62,0xbb,0xfb,0xa8,0x63}, 0},
+    {{0x4f,0x75,0x70,0x38,0x45,0x15,0x10,0x6b,0xb3,0xf2,0x3e,0x99,0x10,0x14,0x98,0x99,0x75,0xf1,0xc2,0xa7,0x6d,0xc9,0x8a,0x91,0x64,0x61,0x9f,0x16,0x4b,0x21,0x64,0x3e}, 0},
+    {{0x4f,0x93,0x74,0xab,0xc6,0x5b,0x31,0x46,0x64,0x55,0xad,0xa7,0x7e,0x81,0xe2,0xfb,0x52,0x50,0xd0,0xca,0x65,0x0b,0x6c,0x54,0xb3,0xaa,0xc4,0xff,0x5f,0x5a,0x1b,0x49}, 0},
+    {{0x4f,0xcc,0x77,0x4a,0x01,0x94,0xc8,0x34,0x76,0xba,0xff,0xab,0x3f,0xfa,0xb4,0x66,0x9c,0xc3,0xc1,0x7b,0x34,0x8e,0xf7,0xee,0x1e,0xa1,0x30,0x09,0x86,0xb9,0x5a,0x43}, 0},
+    {{0x4f,0xcc,0x77,0x4a,0x01,0x94,0xc8,0x34,0x76,0xba,0xff,0xab,0x3f,0xfa,0xb4,0x66,0x9c,0xc3,0xc1,0x7b,0x34,0x8e,0xf7,0xee,0x1e,0xa1,0x30,0x09,0x86,0xb9,0x5a,0x43}, 1},
+    {{0x50,0x10,0x84,0x2b,0xae,0xf0,0xfb,0x39,0xf5,0xa4,0x95,0x7d,0xf1,0x8d,0x69,0x52,0xd5,0x5a,0xaf,0x3d,0x77,0xd5,0xd8,0x9d,0xd1,0xe9,0x60,0x9a,0x83,0xe5,0xb8,0xc1}, 0},
+    {{0x50,0x10,0x84,0x2b,0xae,0xf0,0xfb,0x39,0xf5,0xa4,0x95,0x7d,0xf1,0x8d,0x69,0x52,0xd5,0x5a,0xaf,0x3d,0x77,0xd5,0xd8,0x9d,0xd1,0xe9,0x60,0x9a,0x83,0xe5,0xb8,0xc1}, 1},
+    {{0x50,0x6f,0x4c,0x43,0xdc,0x44,0xf1,0xe0,0x84,0xfe,0x5b,0x5a,0xf0,0xd4,0x55,0xf2,0x7f,0xf6,0xaa,0xd2,0x58,0x52,0xa4,0x0d,0x8b,0xea,0xb5,0x3f,0x73,0x92,0xef,0x31}, 0},
+    {{0x50,0x6f,0x4c,0x43,0xdc,0x44,0xf1,0xe0,0x84,0xfe,0x5b,0x5a,0xf0,0xd4,0x55,0xf2,0x7f,0xf6,0xaa,0xd2,0x58,0x52,0xa4,0x0d,0x8b,0xea,0xb5,0x3f,0x73,0x92,0xef,0x31}, 1},
+    {{0x50,0x8d,0x77,0x79,0x57,0xf5,0x4a,0xf0,0xe6,0x31,0xc0,0x17,0xe9,0x4c,0x65,0x3a,0x8e,0x48,0x60,0x6d,0x31,0x77,0xd9,0x53,0x0d,0xf8,0x5f,0x7c,0x5f,0x07,0xa6,0xdc}, 0},
+    {{0x50,0x8d,0x77,0x79,0x57,0xf5,0x4a,0xf0,0xe6,0x31,0xc0,0x17,0xe9,0x4c,0x65,0x3a,0x8e,0x48,0x60,0x6d,0x31,0x77,0xd9,0x53,0x0d,0xf8,0x5f,0x7c,0x5f,0x07,0xa6,0xdc}, 1},
+    {{0x50,0xb8,0xa5,0xc0,0x37,0xb5,0x0e,0x7e,0xfb,0x2f,0x49,0x6c,0x96,0x07,0xdd,0xed,0x50,0x26,0xeb,0xed,0x87,0x37,0x7b,0xd2,0x7f,0x43,0xe3,0x37,0x47,0x16,0xf7,0xff}, 0},
+    {{0x50,0xb8,0xa5,0xc0,0x37,0xb5,0x0e,0x7e,0xfb,0x2f,0x49,0x6c,0x96,0x07,0xdd,0xed,0x50,0x26,0xeb,0xed,0x87,0x37,0x7b,0xd2,0x7f,0x43,0xe3,0x37,0x47,0x16,0xf7,0xff}, 1},
+    {{0x51,0x47,0xe5,0x9f,0xc0,0x4c,0x66,0xeb,0x61,0xa2,0xd9,0x0f,0x17,0x0d,0xfd,0x9e,0xd1,0xef,0x59,0x83,0xc2,0xfd,0x0e,0xc7,0xb0,0xc1,0x13,0x3b,0x04,0x93,0x75,0x81}, 0},
+    {{0x51,0x47,0xe5,0x9f,0xc0,0x4c,0x66,0xeb,0x61,0xa2,0xd9,0x0f,0x17,0x0d,0xfd,0x9e,0xd1,0xef,0x59,0x83,0xc2,0xfd,0x0e,0xc7,0xb0,0xc1,0x13,0x3b,0x04,0x93,0x75,0x81}, 1},
+    {{0x51,0x88,0x1e,0xf0,0xc3,0xe7,0x14,0xd0,0xb2,0xff,0x4c,0x83,0x36,0xe0,0xbd,0xd2,0xdf,0xf6,0xe3,0x9a,0x98,0x6b,0x1b,0x6e,0x2f,0xef,0x4d,0xf3,0xc9,0xd0,0x94,0x26}, 0},
+    {{0x51,0x88,0x1e,0xf0,0xc3,0xe7,0x14,0xd0,0xb2,0xff,0x4c,0x83,0x36,0xe0,0xbd,0xd2,0xdf,0xf6,0xe3,0x9a,0x98,0x6b,0x1b,0x6e,0x2f,0xef,0x4d,0xf3,0xc9,0xd0,0x94,0x26}, 1},
+    {{0x51,0xb3,0x04,0xfa,0xc3,0xc3,0xed,0xad,0x6c,0x64,0x91,0xae,0x82,0x34,0xc1,0x88,0xd7,0xd1,0x80,0xea,0xa8,0x5d,0xdf,0x3f,0x6c,0xd7,0xb9,0x72,0x4d,0x2a,0xab,0xb7}, 0},
+    {{0x51,0xb3,0x04,0xfa,0xc3,0xc3,0xed,0xad,0x6c,0x64,0x91,0xae,0x82,0x34,0xc1,0x88,0xd7,0xd1,0x80,0xea,0xa8,0x5d,0xdf,0x3f,0x6c,0xd7,0xb9,0x72,0x4d,0x2a,0xab,0xb7}, 1},
+    {{0x52,0x08,0x38,0x85,0x47,0xc8,0x87,0xef,0x35,0xc6,0xf2,0x6a,0xe0,0x19,0x5a,0x69,0x2d,0x64,0x83,0xf2,0x27,0x53,0x62,0xb5,0x8c,0x5c,0x93,0xb7,0xc1,0x81,0xde,0xb2}, 0},
+    {{0x52,0x08,0x38,0x85,0x47,0xc8,0x87,0xef,0x35,0xc6,0xf2,0x6a,0xe0,0x19,0x5a,0x69,0x2d,0x64,0x83,0xf2,0x27,0x53,0x62,0xb5,0x8c,0x5c,0x93,0xb7,0xc1,0x81,0xde,0xb2}, 1},
+    {{0x52,0x8a,0x0f,0xb8,0xbd,0xd5,0xfd,0xe8,0x9c,0xa3,0x97,0xa9,0xe3,0x4c,0xb9,0x25,0xf1,0x5e,0x16,0xbb,0xbf,0x36,0x3b,0x90,0xfc,0xe9,0x81,0x9b,0xa6,0x07,0x06,0xa9}, 0},
+    {{0x53,0x3d,0x32,0x2e,0xc7,0x6b,0xc6,0x41,0xe9,0xa6,0x8d,0x7d,0xa2,0xfa,0x61,0x22,0xde,0x64,0x7e,0x2a,0xcf,0xf6,0x62,0xe0,0x1e,0xff,0x24,0x93,0x61,0xc8,0x81,0x7d}, 0},
+    {{0x53,0x40,0x00,0x43,0x4a,0x7b,0xa9,0xad,0x5b,0x22,0x2c,0x1a,0x0e,0x0e,0x18,0xee,0xfc,0x90,0xae,0x75,0xd2,0x69,0xdf,0xba,0xa7,0x29,0x9a,0xd1,0x20,0xdf,0x6b,0xfc}, 0},
+    {{0x53,0x40,0x00,0x43,0x4a,0x7b,0xa9,0xad,0x5b,0x22,0x2c,0x1a,0x0e,0x0e,0x18,0xee,0xfc,0x90,0xae,0x75,0xd2,0x69,0xdf,0xba,0xa7,0x29,0x9a,0xd1,0x20,0xdf,0x6b,0xfc}, 1},
+    {{0x53,0xf4,0x57,0x86,0x10,0x8d,0x6c,0x8a,0x97,0xdf,0x01,0x09,0xf1,0x91,0xce,0x14,0xaf,0xa4,0xfe,0xc1,0x13,0xdb,0x71,0xc2,0x94,0x4d,0x82,0x8b,0xdc,0x6f,0x34,0x8b}, 0},
+    {{0x54,0x52,0xbf,0x55,0xbd,0x55,0x95,0xbd,0x91,0xff,0xf6,0xa4,0x17,0xcb,0xa0,0x73,0xb0,0xc0,0x4b,0x55,0x21,0xf7,0xc7,0x7f,0xe7,0x69,0x7d,0xf5,0xba,0x1c,0x66,0x05}, 0},
+    {{0x54,0x66,0x3c,0xde,0xa3,0x65,0xbf,0x64,0x56,0xbc,0x6e,0x0d,0xf2,0xf9,0xc2,0x74,0x75,0x14,0x96,0xff,0xf1,0x0e,0xed,0x5e,0xb0,0xf2,0x6d,0x32,0x10,0xbf,0x37,0x66}, 0},
+    {{0x54,0x6a,0xf9,0x0f,0x68,0xd6,0x66,0x48,0x3c,0x71,0xef,0x94,0x1e,0x9c,0xfa,0x10,0x77,0x57,0x75,0xa9,0x83,0x8d,0x60,0x90,0x6e,0x84,0xf2,0x29,0xfe,0x78,0x8b,0xfe}, 1},
+    {{0x54,0x6e,0x34,0x58,0x1b,0x0b,0xe0,0xdb,0x74,0x61,0x19,0xcd,0x80,0xcb,0xa8,0x4f,0xb4,0x67,0x5a,0xf7,0x2d,0x2b,0x0c,0xb3,0x7d,0x74,0xdf,0xd7,0xbf,0xa7,0x78,0x74}, 0},
+    {{0x54,0x6e,0x34,0x58,0x1b,0x0b,0xe0,0xdb,0x74,0x61,0x19,0xcd,0x80,0xcb,0xa8,0x4f,0xb4,0x67,0x5a,0xf7,0x2d,0x2b,0x0c,0xb3,0x7d,0x74,0xdf,0xd7,0xbf,0xa7,0x78,0x74}, 1},
+    {{0x54,0x72,0x78,0xdb,0x08,0x09,0xf1,0x71,0x2d,0xe9,0xb5,0xe8,0xb9,0x86,0x82,0x8b,0xb7,0x42,0xee,0x38,0x90,0xea,0x4c,0xd9,0x4e,0x75,0x13,0x3e,0x0c,0x74,0xe0,0xc0}, 0},
+    {{0x55,0x31,0x93,0xbb,0x63,0x9b,0xee,0x51,0x62,0x5f,0xc8,0xa9,0x9a,0x97,0xec,0xbc,0xa6,0x56,0xa3,0x88,0x86,0x20,0xf5,0xa0,0xda,0xa2,0x03,0xcf,0xa7,0x55,0x91,0xda}, 0},
+    {{0x55,0x31,0x93,0xbb,0x63,0x9b,0xee,0x51,0x62,0x5f,0xc8,0xa9,0x9a,0x97,0xec,0xbc,0xa6,0x56,0xa3,0x88,0x86,0x20,0xf5,0xa0,0xda,0xa2,0x03,0xcf,0xa7,0x55,0x91,0xda}, 1},
+    {{0x55,0x3b,0x41,0xfd,0x20,0xf9,0x0a,0x05,0x9d,0x25,0xbc,0x60,0x29,0x17,0xa5,0xca,0x59,0x01,0xe2,0xf0,0x91,0xd4,0x01,0x9a,0xe9,0x51,0xcb,0xc6,0xfd,0xd2,0xd4,0xd4}, 0},
+    {{0x55,0x3b,0x41,0xfd,0x20,0xf9,0x0a,0x05,0x9d,0x25,0xbc,0x60,0x29,0x17,0xa5,0xca,0x59,0x01,0xe2,0xf0,0x91,0xd4,0x01,0x9a,0xe9,0x51,0xcb,0xc6,0xfd,0xd2,0xd4,0xd4}, 1},
+    {{0x55,0x52,0xbd,0xd9,0xb9,0x4e,0x18,0xa9,0x43,0x0b,0x98,0x44,0x45,0xa2,0x9d,0xa3,0x63,0x4f,0x5d,0xf9,0x87,0xcb,0x04,0xe3,0x86,0x99,0x65,0x2c,0xc5,0xcc,0x0a,0x75}, 0},
+    {{0x55,0x52,0xbd,0xd9,0xb9,0x4e,0x18,0xa9,0x43,0x0b,0x98,0x44,0x45,0xa2,0x9d,0xa3,0x63,0x4f,0x5d,0xf9,0x87,0xcb,0x04,0xe3,0x86,0x99,0x65,0x2c,0xc5,0xcc,0x0a,0x75}, 1},
+    {{0x56,0x3d,0x9d,0x7e,0xce,0xc7,0x01,0xea,0xa7,0x75,0xdb,0x86,0x3a,0x10,0x15,0x96,0x78,0xc2,0xbd,0x01,0x6d,0x5f,0xe0,0x91,0x15,0x97,0xd8,0x04,0xa6,0x89,0x68,0xec}, 0},
+    {{0x56,0x6a,0xf8,0x85,0x5b,0x5a,0x0b,0xb4,0x06,0x34,0x11,0x78,0x15,0xc2,0xc5,0x43,0x70,0x76,0xd6,0x47,0xf4,0x77,0x6c,0xef,0x5d,0x82,0x39,0xaf,0x1a,0xbe,0x77,0x2a}, 0},
+    {{0x56,0x6a,0xf8,0x85,0x5b,0x5a,0x0b,0xb4,0x06,0x34,0x11,0x78,0x15,0xc2,0xc5,0x43,0x70,0x76,0xd6,0x47,0xf4,0x77,0x6c,0xef,0x5d,0x82,0x39,0xaf,0x1a,0xbe,0x77,0x2a}, 1},
+    {{0x56,0x88,0x7e,0x76,0xd8,0x56,0x7c,0x6e,0x6d,0x4d,0x9d,0x93,0x70,0xab,0x6b,0xc3,0xc7,0x21,0x86,0xbc,0x05,0x82,0x7a,0xc3,0xb8,0x50,0xbb,0x6b,0x05,0xfd,0xca,0xff}, 0},
+    {{0x56,0x88,0x7e,0x76,0xd8,0x56,0x7c,0x6e,0x6d,0x4d,0x9d,0x93,0x70,0xab,0x6b,0xc3,0xc7,0x21,0x86,0xbc,0x05,0x82,0x7a,0xc3,0xb8,0x50,0xbb,0x6b,0x05,0xfd,0xca,0xff}, 1},
+    {{0x56,0xc7,0x98,0xc4,0xb6,0x22,0xc9,0xf6,0x30,0x22,0xac,0x94,0xf9,0x1e,0xa8,0xe8,0x52,0x44,0x56,0xba,0xcb,0xc6,0x8c,0xff,0xbb,0x52,0xc5,0x93,0x78,0x61,0xdc,0x92}, 0},
+    {{0x56,0xc7,0x98,0xc4,0xb6,0x22,0xc9,0xf6,0x30,0x22,0xac,0x94,0xf9,0x1e,0xa8,0xe8,0x52,0x44,0x56,0xba,0xcb,0xc6,0x8c,0xff,0xbb,0x52,0xc5,0x93,0x78,0x61,0xdc,0x92}, 1},
+    {{0x57,0x09,0xb7,0xcc,0x3e,0xcc,0xe1,0x4a,0xab,0xf4,0x20,0x70,0x84,0x01,0xac,0x48,0xf0,0x76,0xb2,0xbd,0xfc,0x8d,0xbc,0xf4,0x22,0x04,0x10,0x22,0xf0,0xd8,0x47,0xcf}, 0},
+    {{0x57,0x09,0xb7,0xcc,0x3e,0xcc,0xe1,0x4a,0xab,0xf4,0x20,0x70,0x84,0x01,0xac,0x48,0xf0,0x76,0xb2,0xbd,0xfc,0x8d,0xbc,0xf4,0x22,0x04,0x10,0x22,0xf0,0xd8,0x47,0xcf}, 1},
+    {{0x57,0x34,0x29,0x12,0xab,0x92,0x1c,0xe0,0xa7,0x7b,0x2d,0x83,0xb6,0xb6,0x01,0xc5,0x02,0x95,0x6d,0xc4,0xd2,0x0a,0x22,0x33,0xbf,0xcf,0xfa,0xc0,0xff,0xaf,0x44,0xfa}, 0},
+    {{0x57,0x68,0x15,0x2f,0x32,0xc3,0x20,0x08,0x04,0x8f,0x46,0xdf,0xa3,0x5b,0xc1,0x3c,0xca,0x99,0x8c,0xe9,0xd0,0x87,0x48,0x7f,0xf9,0xcd,0xe9,0x8c,0x48,0x1d,0xde,0xe9}, 0},
+    {{0x57,0x93,0x59,0x02,0xd8,0x86,0x72,0xff,0xfb,0x09,0x04,0xb2,0xca,0xd3,0x4d,0xe2,0x65,0x06,0x64,0xd7,0x7a,0xf4,0xd3,0xa9,0xd4,0x7c,0xe8,0xac,0xba,0x2e,0xb8,0xf1}, 0},
+    {{0x57,0xde,0xde,0x04,0x02,0x99,0x3a,0x3d,0x36,0x83,0x21,0x78,0xeb,0x24,0xb5,0xb7,0xe8,0xfd,0x93,0x1e,0x02,0x67,0x85,0x02,0x92,0xf1,0x2b,0xaf,0x13,0x5c,0x9b,0xd5}, 0},
+    {{0x57,0xde,0xde,0x04,0x02,0x99,0x3a,0x3d,0x36,0x83,0x21,0x78,0xeb,0x24,0xb5,0xb7,0xe8,0xfd,0x93,0x1e,0x02,0x67,0x85,0x02,0x92,0xf1,0x2b,0xaf,0x13,0x5c,0x9b,0xd5}, 1},
+    {{0x58,0xc7,0xc6,0xc5,0xab,0xcf,0xef,0xfb,0x31,0x7e,0x57,0x0f,0x46,0x4b,0x89,0xf8,0xf2,0x0a,0x09,0x48,0x75,0xb0,0x1c,0x80,0x18,0x47,0xc9,0x18,0xc3,0x00,0x1a,0xbd}, 0},
+    {{0x58,0xc7,0xc6,0xc5,0xab,0xcf,0xef,0xfb,0x31,0x7e,0x57,0x0f,0x46,0x4b,0x89,0xf8,0xf2,0x0a,0x09,0x48,0x75,0xb0,0x1c,0x80,0x18,0x47,0xc9,0x18,0xc3,0x00,0x1a,0xbd}, 1},
+    {{0x58,0xd2,0x15,0x80,0xfe,0x4e,0xf9,0xac,0x28,0xfb,0x5f,0x14,0x93,0xf5,0xaf,0x4f,0x4d,0xdf,0xa3,0xbb,0x68,0xb3,0x8d,0x28,0x12,0xe1,0xde,0x5e,0x5a,0x5c,0xea,0x43}, 0},
+    {{0x58,0xd2,0x15,0x80,0xfe,0x4e,0xf9,0xac,0x28,0xfb,0x5f,0x14,0x93,0xf5,0xaf,0x4f,0x4d,0xdf,0xa3,0xbb,0x68,0xb3,0x8d,0x28,0x12,0xe1,0xde,0x5e,0x5a,0x5c,0xea,0x43}, 1},
+    {{0x59,0x1d,0x9b,0x54,0x6f,0xc2,0x2d,0xe7,0x62,0xa0,0xd7,0x51,0x0e,0x4b,0x91,0x64,0xaa,0x0f,0x2f,0x61,0xd2,0x4b,0x3b,0xf6,0x9a,0x52,0xd9,0xf1,0x2e,0x7d,0x45,0x3b}, 0},
+    {{0x59,0x29,0x51,0x45,0x2e,0x51,0x22,0x61,0x0d,0x68,0xd0,0x02,0x24,0x92,0x11,0x79,0x74,0xce,0x4b,0xb1,0x0f,0xdb,0x8b,0x9e,0x83,0x57,0x17,0xb7,0x2f,0xe8,0x21,0xee}, 0},
+    {{0x59,0x54,0x02,0x31,0xbc,0x20,0xc2,0xea,0xf6,0xa6,0x0a,0x28,0x6a,0xd9,0x6f,0x70,0x15,0x6a,0xce,0x06,0x52,0xe1,0x1b,0x71,0x1e,0x79,0xdf,0xec,0x3e,0x9b,0xd1,0xbd}, 0},
+    {{0x59,0x54,0x02,0x31,0xbc,0x20,0xc2,0xea,0xf6,0xa6,0x0a,0x28,0x6a,0xd9,0x6f,0x70,0x15,0x6a,0xce,0x06,0x52,0xe1,0x1b,0x71,0x1e,0x79,0xdf,0xec,0x3e,0x9b,0xd1,0xbd}, 1},
+    {{0x59,0x99,0x84,0x7e,0xd3,0x3a,0xb3,0xa1,0x52,0x2f,0x2d,0xa8,0x03,0x45,0x86,0x7c,0x1e,0x45,0x01,0xcf,0x70,0x98,0x88,0xb6,0xa6,0x8f,0xd7,0x03,0x06,0xc6,0x1a,0xde}, 0},
+    {{0x59,0x99,0x84,0x7e,0xd3,0x3a,0xb3,0xa1,0x52,0x2f,0x2d,0xa8,0x03,0x45,0x86,0x7c,0x1e,0x45,0x01,0xcf,0x70,0x98,0x88,0xb6,0xa6,0x8f,0xd7,0x03,0x06,0xc6,0x1a,0xde}, 1},
+    {{0x59,0xd5,0xdf,0xef,0xce,0xba,0x89,0x77,0x5b,0x85,0x2f,0xcb,0xf2,0x7f,0x57,0x08,0x14,0xe2,0x12,0xd6,0x93,0x5d,0x49,0x49,0x5b,0x34,0x58,0xc7,0x4a,0x18,0x28,0x52}, 0},
+    {{0x59,0xd5,0xdf,0xef,0xce,0xba,0x89,0x77,0x5b,0x85,0x2f,0xcb,0xf2,0x7f,0x57,0x08,0x14,0xe2,0x12,0xd6,0x93,0x5d,0x49,0x49,0x5b,0x34,0x58,0xc7,0x4a,0x18,0x28,0x52}, 1},
+    {{0x59,0xea,0x3a,0x8a,0xeb,0x99,0xaa,0x0f,0x81,0xc7,0xe6,0xe0,0xe5,0x51,0x77,0x7c,0x58,0xf3,0xc9,0x36,0x64,0xd1,0x17,0x2a,0xa0,0x3d,0x3a,0x63,0x86,0x54,0x4a,0xda}, 0},
+    {{0x59,0xea,0x3a,0x8a,0xeb,0x99,0xaa,0x0f,0x81,0xc7,0xe6,0xe0,0xe5,0x51,0x77,0x7c,0x58,0xf3,0xc9,0x36,0x64,0xd1,0x17,0x2a,0xa0,0x3d,0x3a,0x63,0x86,0x54,0x4a,0xda}, 1},
+    {{0x5a,0x22,0xff,0x6c,0x20,0x8f,0xba,0xd8,0x87,0x09,0xc4,0xb9,0x4c,0xdb,0x28,0xe9,0x2f,0x7d,0x5b,0xcb,0x27,0xcd,0xf5,0x1c,0x4e,0xf5,0xf5,0x2a,0x0a,0xd2,0x91,0x00}, 0},
+    {{0x5a,0x22,0xff,0x6c,0x20,0x8f,0xba,0xd8,0x87,0x09,0xc4,0xb9,0x4c,0xdb,0x28,0xe9,0x2f,0x7d,0x5b,0xcb,0x27,0xcd,0xf5,0x1c,0x4e,0xf5,0xf5,0x2a,0x0a,0xd2,0x91,0x00}, 1},
+    {{0x5a,0x33,0x85,0xdb,0x20,0x34,0xd3,0x6e,0x62,0x16,0xb9,0xe8,0x0e,0x28,0x68,0x43,0xed,0x10,0x94,0xc5,0xf2,0x83,0x59,0x6e,0xf2,0x30,0xe4,0x1d,0xb3,0x37,0xd9,0xee}, 0},
+    {{0x5a,0x44,0x62,0xdf,0x9b,0x12,0x22,0xd0,0xc5,0x52,0xb6,0x99,0x48,0x3b,0x28,0x3e,0x9d,0x0b,0xfb,0x98,0x2f,0x41,0xe8,0xf7,0xe1,0xc2,0xa9,0xcb,0x68,0x84,0xf9,0xfa}, 0},
+    {{0x5a,0x44,0x62,0xdf,0x9b,0x12,0x22,0xd0,0xc5,0x52,0xb6,0x99,0x48,0x3b,0x28,0x3e,0x9d,0x0b,0xfb,0x98,0x2f,0x41,0xe8,0xf7,0xe1,0xc2,0xa9,0xcb,0x68,0x84,0xf9,0xfa}, 1},
+    {{0x5a,0x8a,0xbd,0x8f,0xc5,0xa3,0x16,0xc7,0x3e,0xa4,0xf9,0x92,0x75,0xa0,0x1e,0xe6,0x10,0xf6,0x86,0xc9,0xb1,0x5a,0x48,0xdd,0xea,0x00,0xd5,0x65,0x06,0xa7,0x6b,0x87}, 0},
+    {{0x5b,0x1c,0x17,0x23,0x26,0xf0,0xd8,0xc1,0xf0,0xc2,0x9f,0xf7,0x30,0x08,0x62,0x68,0xa3,0x91,0x3e,0x5c,0xf8,0xae,0x52,0x63,0x9e,0x54,0x66,0x0e,0xb1,0xf8,0x10,0xb8}, 0},
+    {{0x5b,0x1c,0x17,0x23,0x26,0xf0,0xd8,0xc1,0xf0,0xc2,0x9f,0xf7,0x30,0x08,0x62,0x68,0xa3,0x91,0x3e,0x5c,0xf8,0xae,0x52,0x63,0x9e,0x54,0x66,0x0e,0xb1,0xf8,0x10,0xb8}, 1},
+    {{0x5b,0x32,0x26,0x74,0x6f,0xd5,0x95,0x7c,0x17,0x9d,0xee,0xd8,0x5a,0x6d,0xa6,0x39,0x3e,0x2a,0x8c,0x29,0xb2,0xe6,0x5d,0xa8,0x22,0xdf,0x50,0x3c,0x50,0xaa,0xec,0xee}, 0},
+    {{0x5b,0x32,0x26,0x74,0x6f,0xd5,0x95,0x7c,0x17,0x9d,0xee,0xd8,0x5a,0x6d,0xa6,0x39,0x3e,0x2a,0x8c,0x29,0xb2,0xe6,0x5d,0xa8,0x22,0xdf,0x50,0x3c,0x50,0xaa,0xec,0xee}, 1},
+    {{0x5b,0x7f,0x7c,0xa6,0x8d,0x05,0x07,0x20,0x48,0xe0,0x53,0xef,0xd3,0xd7,0x70,0x72,0x9c,0x10,0x07,0x08,0xae,0x8f,0x40,0x04,0xd8,0xf3,0xdc,0x20,0x1e,0x7f,0x05,0x67}, 0},
+    {{0x5b,0x7f,0x7c,0xa6,0x8d,0x05,0x07,0x20,0x48,0xe0,0x53,0xef,0xd3,0xd7,0x70,0x72,0x9c,0x10,0x07,0x08,0xae,0x8f,0x40,0x04,0xd8,0xf3,0xdc,0x20,0x1e,0x7f,0x05,0x67}, 1},
+    {{0x5b,0xe0,0x06,0x8f,0xf2,0xfa,0xed,0x6d,0x82,0xaa,0x09,0xe8,0x05,0xe0,0x72,0x8b,0x0f,0xab,0x87,0x05,0xfc,0x86,0x2a,0x3c,0x06,0x75,0xab,0xb8,0x06,0x78,0x3b,0x2e}, 0},
+    {{0x5b,0xe0,0x06,0x8f,0xf2,0xfa,0xed,0x6d,0x82,0xaa,0x09,0xe8,0x05,0xe0,0x72,0x8b,0x0f,0xab,0x87,0x05,0xfc,0x86,0x2a,0x3c,0x06,0x75,0xab,0xb8,0x06,0x78,0x3b,0x2e}, 1},
+    {{0x5c,0x78,0x40,0x25,0x74,0x41,0x36,0xbc,0xff,0x5c,0xff,0x77,0xc4,0x2a,0xf4,0x2a,0x61,0xde,0x01,0x06,0x3b,0x21,0x99,0x0a,0x19,0x14,0xc5,0x34,0xcb,0xd3,0xd1,0xc6}, 0},
+    {{0x5c,0x84,0xed,0x0d,0x71,0x5e,0x24,0xf5,0x4c,0x5f,0xca,0x45,0xa9,0x1f,0x4f,0xeb,0x7b,0xf8,0x25,0xdc,0x56,0xda,0xa8,0x01,0x61,0xaa,0x0a,0x96,0xe9,0x01,0xcb,0x6e}, 0},
+    {{0x5c,0x84,0xed,0x0d,0x71,0x5e,0x24,0xf5,0x4c,0x5f,0xca,0x45,0xa9,0x1f,0x4f,0xeb,0x7b,0xf8,0x25,0xdc,0x56,0xda,0xa8,0x01,0x61,0xaa,0x0a,0x96,0xe9,0x01,0xcb,0x6e}, 1},
+    {{0x5c,0xb4,0x81,0x6c,0x2f,0xf8,0xf6,0xf5,0x88,0xb2,0x43,0x82,0x06,0x21,0x0b,0x07,0xbe,0xf7,0x72,0x70,0xb3,0x67,0x77,0xdd,0x3a,0x3a,0x28,0xe2,0xac,0x05,0xdf,0x71}, 0},
+    {{0x5c,0xb4,0x81,0x6c,0x2f,0xf8,0xf6,0xf5,0x88,0xb2,0x43,0x82,0x06,0x21,0x0b,0x07,0xbe,0xf7,0x72,0x70,0xb3,0x67,0x77,0xdd,0x3a,0x3a,0x28,0xe2,0xac,0x05,0xdf,0x71}, 1},
+    {{0x5d,0x6b,0x00,0x16,0x42,0x67,0x1f,0x1d,0x92,0x46,0x53,0x98,0x66,0xe1,0xe2,0xa0,0xf0,0xe5,0xe5,0xc0,0xd4,0x3e,0x8a,0x65,0xe8,0x7e,0x64,0xab,0xbb,0xda,0x07,0x2b}, 0},
+    {{0x5d,0x6b,0x00,0x16,0x42,0x67,0x1f,0x1d,0x92,0x46,0x53,0x98,0x66,0xe1,0xe2,0xa0,0xf0,0xe5,0xe5,0xc0,0xd4,0x3e,0x8a,0x65,0xe8,0x7e,0x64,0xab,0xbb,0xda,0x07,0x2b}, 1},
+    {{0x5d,0x8d,0x9c,0xe1,0x7e,0x36,0xdd,0x6f,0x3c,0x82,0x7c,0xe3,0x68,0x2b,0x27,0x59,0xd7,0x19,0xa1,0xd8,0x9b,0x1f,0xb3,0xdf,0xf0,0xdb,0x06,0x69,0xf0,0xbb,0x54,0x58}, 0},
+    {{0x5d,0xec,0xd5,0x99,0xcc,0x8e,0xb5,0xde,0xc6,0x8d,0xf6,0x43,0x5a,0x74,0xe9,0x41,0x2b,0x8d,0xc1,0x34,0x04,0xf2,0x19,0x64,0xbc,0x61,0x0a,0x2e,0x34,0xd2,0x8f,0x88}, 0},
+    {{0x5d,0xf0,0xcd,0xc3,0x7a,0x8d,0x9f,0x58,0xb4,0x03,0xc0,0x49,0xf5,0x27,0x7d,0x76,0xc5,0x64,0xb7,0x6d,0x4b,0xde,0x8e,0x5a,0xa0,0xd5,0x12,0x5d,0x99,0x22,0x65,0xc3}, 0},
+    {{0x5d,0xf0,0xcd,0xc3,0x7a,0x8d,0x9f,0x58,0xb4,0x03,0xc0,0x49,0xf5,0x27,0x7d,0x76,0xc5,0x64,0xb7,0x6d,0x4b,0xde,0x8e,0x5a,0xa0,0xd5,0x12,0x5d,0x99,0x22,0x65,0xc3}, 1},
+    {{0x5d,0xf6,0x27,0xe2,0xa8,0x7f,0xec,0x7f,0xe7,0xd6,0x9e,0x3c,0x99,0xe1,0x78,0x7e,0x6e,0xcd,0xfb,0x83,0x29,0xa6,0xf9,0xa0,0xf4,0x2f,0x4c,0x3b,0xc8,0xde,0xe1,0x6b}, 0},
+    {{0x5d,0xf6,0x27,0xe2,0xa8,0x7f,0xec,0x7f,0xe7,0xd6,0x9e,0x3c,0x99,0xe1,0x78,0x7e,0x6e,0xcd,0xfb,0x83,0x29,0xa6,0xf9,0xa0,0xf4,0x2f,0x4c,0x3b,0xc8,0xde,0xe1,0x6b}, 1},
+    {{0x5e,0x39,0xd7,0x16,0x6d,0xaf,0x13,0xf0,0x2a,0x3e,0xd6,0x00,0x0e,0x82,0x4e,0x83,0xf7,0xd6,0x19,0x0d,0xcc,0xd9,0xa0,0xaa,0x3a,0x5e,0xbe,0xb9,0x6d,0x49,0x91,0xf8}, 0},
+    {{0x5e,0x4a,0x82,0xdf,0x64,0xf2,0x12,0x5c,0x5e,0x3f,0x5c,0xc8,0x89,0x2b,0x69,0xb6,0x90,0x2c,0xaf,0x9a,0xde,0x55,0xca,0xc8,0x36,0x18,0xc1,0x77,0xcf,0x67,0x48,0x5a}, 0},
+    {{0x5e,0x4a,0x82,0xdf,0x64,0xf2,0x12,0x5c,0x5e,0x3f,0x5c,0xc8,0x89,0x2b,0x69,0xb6,0x90,0x2c,0xaf,0x9a,0xde,0x55,0xca,0xc8,0x36,0x18,0xc1,0x77,0xcf,0x67,0x48,0x5a}, 1},
+    {{0x5e,0xf4,0xd9,0x9b,0x16,0x0d,0x3c,0x4e,0x89,0xba,0x97,0x3d,0x38,0xcc,0x50,0xab,0x21,0x4e,0xa3,0xe2,0x61,0xa1,0x21,0x6f,0x8c,0x7f,0xef,0xe8,0xf9,0xbd,0xe5,0x44}, 0},
+    {{0x5e,0xf4,0xd9,0x9b,0x16,0x0d,0x3c,0x4e,0x89,0xba,0x97,0x3d,0x38,0xcc,0x50,0xab,0x21,0x4e,0xa3,0xe2,0x61,0xa1,0x21,0x6f,0x8c,0x7f,0xef,0xe8,0xf9,0xbd,0xe5,0x44}, 1},
+    {{0x5e,0xfd,0xad,0x5f,0xe1,0xc0,0x90,0x8e,0xd0,0xa9,0x43,0x1d,0x72,0x2b,0x1e,0x36,0x8b,0x96,0x3e,0xb4,0x1f,0x3e,0xa3,0x88,0xe4,0x37,0xa1,0x14,0x9d,0xc9,0x96,0xa6}, 0},
+    {{0x5e,0xfd,0xad,0x5f,0xe1,0xc0,0x90,0x8e,0xd0,0xa9,0x43,0x1d,0x72,0x2b,0x1e,0x36,0x8b,0x96,0x3e,0xb4,0x1f,0x3e,0xa3,0x88,0xe4,0x37,0xa1,0x14,0x9d,0xc9,0x96,0xa6}, 1},
+    {{0x5f,0x02,0x83,0xc2,0x02,0x1c,0xd4,0xcb,0x71,0x5a,0x30,0x73,0x95,0x95,0x20,0xb3,0x17,0x6a,0x4a,0xfd,0x26,0xcf,0xf9,0x9e,0x6b,0xf9,0x2a,0x7b,0x67,0x55,0xdc,0x88}, 0},
+    {{0x5f,0x02,0x83,0xc2,0x02,0x1c,0xd4,0xcb,0x71,0x5a,0x30,0x73,0x95,0x95,0x20,0xb3,0x17,0x6a,0x4a,0xfd,0x26,0xcf,0xf9,0x9e,0x6b,0xf9,0x2a,0x7b,0x67,0x55,0xdc,0x88}, 1},
+    {{0x5f,0x59,0x5c,0x95,0xbc,0x3c,0x4f,0xe1,0xdc,0x8b,0xee,0x25,0x36,0x3d,0xf1,0x60,0x78,0xf4,0x74,0x54,0x2a,0xd9,0xf8,0x56,0x8b,0x6d,0xe5,0xe2,0xf2,0x6f,0x1f,0x9d}, 0},
+    {{0x5f,0xba,0x57,0xff,0x37,0xdf,0x05,0x7d,0xf5,0xb1,0x89,0x2d,0x8b,0xe2,0xd0,0x8b,0x98,0xf5,0x0f,0xad,0x70,0x4d,0xa3,0x9c,0x3f,0xc9,0x54,0x73,0x99,0x6a,0x03,0x0f}, 0},
+    {{0x60,0xbe,0x53,0x82,0x33,0xa6,0xd3,0x8e,0x95,0xb0,0x7d,0x08,0x74,0xfa,0xf1,0x3f,0x14,0xe0,0xee,0xc2,0x30,0xa6,0x95,0x51,0x3c,0x30,0x68,0xfe,0x42,0xb1,0x48,0x16}, 0},
+    {{0x60,0xc6,0x34,0xb6,0x64,0x86,0xfe,0x0d,0x3b,0x2d,0x7e,0xbe,0x23,0x6c,0x49,0x99,0x60,0xcc,0xc8,0x3e,0x83,0x5f,0x1c,0xf2,0x69,0xd4,0x78,0xa9,0x4d,0x49,0xcb,0xa4}, 0},
+    {{0x60,0xc6,0x34,0xb6,0x64,0x86,0xfe,0x0d,0x3b,0x2d,0x7e,0xbe,0x23,0x6c,0x49,0x99,0x60,0xcc,0xc8,0x3e,0x83,0x5f,0x1c,0xf2,0x69,0xd4,0x78,0xa9,0x4d,0x49,0xcb,0xa4}, 1},
+    {{0x60,0xda,0xb8,0x41,0x3c,0xde,0xce,0x4f,0xd5,0x59,0xec,0x2b,0x75,0x21,0x43,0x61,0x61,0xc0,0x25,0xb8,0x87,0x13,0xef,0x85,0xbd,0xce,0x62,0xc2,0x23,0x00,0xcd,0x80}, 0},
+    {{0x60,0xda,0xb8,0x41,0x3c,0xde,0xce,0x4f,0xd5,0x59,0xec,0x2b,0x75,0x21,0x43,0x61,0x61,0xc0,0x25,0xb8,0x87,0x13,0xef,0x85,0xbd,0xce,0x62,0xc2,0x23,0x00,0xcd,0x80}, 1},
+    {{0x60,0xe7,0x01,0xba,0xd1,0x48,0xc4,0xef,0x54,0x5e,0x0d,0x6e,0x68,0x94,0x0b,0x78,0x08,0xe1,0xb8,0xf2,0x10,0xf4,0xb5,0x44,0x73,0xca,0xb1,0x80,0xdf,0x15,0xea,0x94}, 0},
+    {{0x60,0xe7,0x01,0xba,0xd1,0x48,0xc4,0xef,0x54,0x5e,0x0d,0x6e,0x68,0x94,0x0b,0x78,0x08,0xe1,0xb8,0xf2,0x10,0xf4,0xb5,0x44,0x73,0xca,0xb1,0x80,0xdf,0x15,0xea,0x94}, 1},
+    {{0x60,0xf0,0x4a,0x46,0xe1,0xa2,0x7c,0x17,0xd0,0x86,0x2b,0xe1,0x7a,0x21,0x26,0xa6,0x4f,0x16,0x89,0x15,0xcf,0x39,0xa1,0x90,0xad,0x57,0x6b,0x46,0x46,0x91,0x6c,0x25}, 0},
+    {{0x60,0xf0,0x4a,0x46,0xe1,0xa2,0x7c,0x17,0xd0,0x86,0x2b,0xe1,0x7a,0x21,0x26,0xa6,0x4f,0x16,0x89,0x15,0xcf,0x39,0xa1,0x90,0xad,0x57,0x6b,0x46,0x46,0x91,0x6c,0x25}, 1},
+    {{0x61,0x24,0x8d,0xce,0x81,0x2a,0x44,0xbd,0x6a,0x18,0x3e,0x5d,0xd5,0x06,0x2f,0xa1,0x91,0xb5,0x68,0xac,0x52,0x8f,0x9d,0x51,0xc5,0xb2,0xef,0xd8,0xab,0x4a,0xc0,0x99}, 0},
+    {{0x61,0x24,0x8d,0xce,0x81,0x2a,0x44,0xbd,0x6a,0x18,0x3e,0x5d,0xd5,0x06,0x2f,0xa1,0x91,0xb5,0x68,0xac,0x52,0x8f,0x9d,0x51,0xc5,0xb2,0xef,0xd8,0xab,0x4a,0xc0,0x99}, 1},
+    {{0x61,0x3e,0x2f,0x3d,0xdd,0xa4,0x91,0x29,0x0a,0x86,0x0e,0xa2,0x6d,0xe2,0x98,0xeb,0xa1,0x50,0xaa,0xae,0xfa,0x37,0xff,0x8b,0xc0,0xdf,0xe1,0x48,0x3c,0x11,0xd0,0x01}, 0},
+    {{0x61,0x47,0x4d,0xb4,0x3a,0xa1,0x5f,0x51,0xd5,0x69,0x40,0x3a,0x84,0x08,0xf3,0x6f,0x75,0x11,0x51,0xb2,0x82,0xb3,0xfa,0xf7,0xab,0xc6,0x52,0x5b,0xbd,0xb0,0xfd,0x2b}, 0},
+    {{0x61,0x47,0x4d,0xb4,0x3a,0xa1,0x5f,0x51,0xd5,0x69,0x40,0x3a,0x84,0x08,0xf3,0x6f,0x75,0x11,0x51,0xb2,0x82,0xb3,0xfa,0xf7,0xab,0xc6,0x52,0x5b,0xbd,0xb0,0xfd,0x2b}, 1},
+    {{0x61,0x99,0x48,0x7e,0xe3,0x6a,0x15,0x64,0xcc,0x1a,0x27,0xad,0x78,0xa2,0xa4,0x2e,0x2c,0xd2,0xe6,0x1a,0x03,0xff,0x31,0x39,0x25,0x74,0x5a,0x1e,0x21,0x80,0x81,0xcf}, 0},
+    {{0x61,0x99,0x48,0x7e,0xe3,0x6a,0x15,0x64,0xcc,0x1a,0x27,0xad,0x78,0xa2,0xa4,0x2e,0x2c,0xd2,0xe6,0x1a,0x03,0xff,0x31,0x39,0x25,0x74,0x5a,0x1e,0x21,0x80,0x81,0xcf}, 1},
+    {{0x62,0x53,0xac,0x5b,0xde,0x51,0x09,0xea,0xee,0x14,0x34,0xc7,0xeb,0x1e,0x0f,0xa9,0x15,0xd0,0xb1,0x30,0xa4,0x79,0xf9,0xc5,0x2b,0x8e,0x9d,0x78,0xd7,0xcc,0x54,0x8c}, 0},
+    {{0x62,0xc5,0x81,0x3d,0x3f,0x93,0xbc,0xac,0xb2,0x1d,0xa6,0xdc,0xc0,0xe5,0x37,0x32,0xdb,0xab,0x41,0xf9,0x5f,0x1d,0x6c,0xbe,0x00,0x66,0x00,0x3f,0x13,0x42,0x9c,0x67}, 0},
+    {{0x63,0xaa,0x1c,0xad,0x55,0xc4,0xb3,0x49,0xf8,0x7e,0xe2,0xae,0xe3,0x6d,0x14,0xa3,0xe4,0xb2,0x1c,0x39,0xc6,0x76,0xe5,0x16,0x66,0x76,0x51,0x66,0x70,0xd9,0x12,0x74}, 0},
+    {{0x63,0xaa,0x1c,0xad,0x55,0xc4,0xb3,0x49,0xf8,0x7e,0xe2,0xae,0xe3,0x6d,0x14,0xa3,0xe4,0xb2,0x1c,0x39,0xc6,0x76,0xe5,0x16,0x66,0x76,0x51,0x66,0x70,0xd9,0x12,0x74}, 1},
+    {{0x63,0xeb,0x5f,0x0a,0x2f,0xba,0xeb,0x5c,0x3f,0x7a,0x29,0x57,0xc3,0x49,0x57,0xa9,0x38,0x70,0xd9,0xb6,0xbe,0xb1,0x58,0xb0,0xc8,0x04,0x00,0xcc,0xba,0x52,0xc4,0xc1}, 0},
+    {{0x63,0xeb,0x5f,0x0a,0x2f,0xba,0xeb,0x5c,0x3f,0x7a,0x29,0x57,0xc3,0x49,0x57,0xa9,0x38,0x70,0xd9,0xb6,0xbe,0xb1,0x58,0xb0,0xc8,0x04,0x00,0xcc,0xba,0x52,0xc4,0xc1}, 1},
+    {{0x64,0x25,0x1a,0xf2,0x01,0xcd,0xa0,0x87,0x4e,0x7d,0x93,0x62,0xd8,0xfc,0x56,0x3d,0x9a,0x3f,0xb2,0x7e,0x80,0x69,0xbc,0x84,0x5e,0x4c,0xe2,0xe4,0x37,0xd2,0x11,0xc8}, 0},
+    {{0x64,0x5c,0xc5,0xa8,0xda,0x81,0x80,0x69,0x89,0x3a,0x69,0x80,0x99,0x02,0xb5,0x92,0x30,0x93,0xe9,0x19,0x7a,0xdb,0x22,0x5b,0x92,0x79,0xf9,0x06,0xda,0x76,0xb7,0x38}, 0},
+    {{0x64,0x5c,0xc5,0xa8,0xda,0x81,0x80,0x69,0x89,0x3a,0x69,0x80,0x99,0x02,0xb5,0x92,0x30,0x93,0xe9,0x19,0x7a,0xdb,0x22,0x5b,0x92,0x79,0xf9,0x06,0xda,0x76,0xb7,0x38}, 1},
+    {{0x64,0x70,0xf4,0x68,0x68,0x5b,0xff,0x1b,0xca,0x3b,0xb2,0x51,0x9d,0x32,0x23,0xbe,0x49,0x72,0x33,0x93,0xe4,0x51,0xd9,0x6b,0x17,0x6a,0x43,0x47,0xbe,0xe9,0xc7,0x80}, 0},
+    {{0x64,0x8f,0xce,0x35,0x2c,0x53,0x31,0xc1,0xa5,0xbe,0xae,0xd3,0x1c,0x6f,0xf6,0x26,0xf0,0x3d,0x1a,0x56,0x6c,0x2f,0xe0,0xae,0x8c,0x05,0xdb,0xce,0xd9,0xcf,0xf2,0x1b}, 0},
+    {{0x64,0xbe,0x9d,0x6d,0x26,0x77,0xbd,0xd3,0xe3,0xa7,0x49,0xca,0x27,0xd4,0x42,0x09,0x0b,0x13,0x75,0x6e,0x8d,0xb5,0x7d,0xc3,0xe3,0x9e,0x79,0xe5,0x26,0xbe,0x06,0xbc}, 0},
+    {{0x65,0x21,0xd2,0x21,0x0c,0xd0,0x8e,0x42,0x5a,0xe4,0xfc,0x4a,0x01,0x25,0xe3,0x44,0x89,0x58,0x64,0x95,0xdd,0x8e,0x0e,0x56,0x3b,0xac,0x2f,0xa6,0xc3,0xaf,0x6d,0xb4}, 0},
+    {{0x65,0x21,0xd2,0x21,0x0c,0xd0,0x8e,0x42,0x5a,0xe4,0xfc,0x4a,0x01,0x25,0xe3,0x44,0x89,0x58,0x64,0x95,0xdd,0x8e,0x0e,0x56,0x3b,0xac,0x2f,0xa6,0xc3,0xaf,0x6d,0xb4}, 1},
+    {{0x65,0x7b,0x81,0xf7,0xca,0x0f,0xeb,0xc8,0x85,0xb2,0xbb,0x90,0x7b,0xa0,0xcb,0x3c,0x56,0x59,0x49,0x31,0xbe,0x98,0xca,0x86,0x23,0x62,0xbd,0x6d,0x4d,0x77,0x0f,0x63}, 0},
+    {{0x65,0xa1,0x35,0xa3,0x8d,0x6c,0x56,0xed,0x5d,0x62,0xa8,0x74,0x70,0xe9,0x78,0x26,0x77,0x6f,0xab,0x0a,0x9b,0xb5,0xac,0x6b,0x1d,0xe8,0xdd,0x67,0xa0,0x09,0x2b,0xb6}, 0},
+    {{0x65,0xa1,0x35,0xa3,0x8d,0x6c,0x56,0xed,0x5d,0x62,0xa8,0x74,0x70,0xe9,0x78,0x26,0x77,0x6f,0xab,0x0a,0x9b,0xb5,0xac,0x6b,0x1d,0xe8,0xdd,0x67,0xa0,0x09,0x2b,0xb6}, 1},
+    {{0x66,0x6c,0x60,0xfa,0x1c,0x32,0xd3,0x94,0xc0,0xde,0xbd,0x30,0xe8,0x10,0xfe,0x6c,0x75,0x6e,0x55,0x36,0xe6,0x78,0x9a,0xbc,0x04,0x67,0x6a,0xa2,0x77,0x27,0x7a,0xb8}, 0},
+    {{0x66,0x7c,0xe8,0x78,0x28,0xc9,0xe1,0x98,0x3e,0x2b,0x51,0xcf,0x01,0x92,0x41,0x6d,0x21,0x48,0xa8,0x68,0x9f,0x6b,0x83,0x04,0x2d,0x72,0x84,0xe3,0x23,0x4f,0xd4,0x1e}, 0},
+    {{0x66,0x7c,0xe8,0x78,0x28,0xc9,0xe1,0x98,0x3e,0x2b,0x51,0xcf,0x01,0x92,0x41,0x6d,0x21,0x48,0xa8,0x68,0x9f,0x6b,0x83,0x04,0x2d,0x72,0x84,0xe3,0x23,0x4f,0xd4,0x1e}, 1},
+    {{0x66,0x95,0x4f,0xb5,0xee,0xee,0xcc,0xc9,0x0e,0x76,0xa5,0xbd,0x7c,0x82,0x78,0x09,0x99,0x74,0x29,0x58,0x29,0xca,0x7b,0x74,0xf6,0x4d,0xf0,0xbf,0xd8,0x74,0x38,0x93}, 0},
+    {{0x66,0x95,0x4f,0xb5,0xee,0xee,0xcc,0xc9,0x0e,0x76,0xa5,0xbd,0x7c,0x82,0x78,0x09,0x99,0x74,0x29,0x58,0x29,0xca,0x7b,0x74,0xf6,0x4d,0xf0,0xbf,0xd8,0x74,0x38,0x93}, 1},
+    {{0x66,0xe8,0xb9,0x03,0x3a,0xea,0xbf,0x5a,0x33,0xe7,0x93,0x96,0xbd,0x25,0x48,0xb3,0x3f,0x12,0xc0,0x4c,0xb1,0xd1,0x5b,0x6d,0xa6,0xc3,0x61,0x13,0x61,0xa2,0x83,0x61}, 0},
+    {{0x66,0xe8,0xb9,0x03,0x3a,0xea,0xbf,0x5a,0x33,0xe7,0x93,0x96,0xbd,0x25,0x48,0xb3,0x3f,0x12,0xc0,0x4c,0xb1,0xd1,0x5b,0x6d,0xa6,0xc3,0x61,0x13,0x61,0xa2,0x83,0x61}, 1},
+    {{0x67,0x63,0x08,0xc6,0x1a,0x29,0x0e,0x6a,0x5e,0xce,0x17,0x06,0xb2,0x9d,0xc8,0xd9,0x2f,0x70,0x43,0x57,0x36,0xf6,0x24,0x13,0x76,0x11,0xa1,0x90,0x40,0xce,0x87,0x84}, 0},
+    {{0x67,0x63,0x08,0xc6,0x1a,0x29,0x0e,0x6a,0x5e,0xce,0x17,0x06,0xb2,0x9d,0xc8,0xd9,0x2f,0x70,0x43,0x57,0x36,0xf6,0x24,0x13,0x76,0x11,0xa1,0x90,0x40,0xce,0x87,0x84}, 1},
+    {{0x67,0x86,0x2f,0xb3,0xc0,0xaf,0x85,0x94,0x22,0x6e,0x2d,0xf6,0xbf,0x7e,0xa3,0xc0,0xcc,0x88,0xbe,0xcb,0x5f,0x3d,0xec,0x63,0xf7,0xa5,0xcf,0xb5,0xcf,0x59,0x8c,0xf6}, 0},
+    {{0x67,0x86,0x2f,0xb3,0xc0,0xaf,0x85,0x94,0x22,0x6e,0x2d,0xf6,0xbf,0x7e,0xa3,0xc0,0xcc,0x88,0xbe,0xcb,0x5f,0x3d,0xec,0x63,0xf7,0xa5,0xcf,0xb5,0xcf,0x59,0x8c,0xf6}, 1},
+    {{0x67,0x9a,0x22,0xba,0x26,0xea,0x90,0xc1,0x14,0x43,0x6e,0x00,0xc1,0x2a,0x96,0x4d,0xf1,0xc5,0xe9,0xc3,0xdc,0xce,0xd1,0x95,0x08,0x52,0xe9,0x4e,0xd9,0xbe,0x55,0xe3}, 0},
+    {{0x67,0x9a,0x22,0xba,0x26,0xea,0x90,0xc1,0x14,0x43,0x6e,0x00,0xc1,0x2a,0x96,0x4d,0xf1,0xc5,0xe9,0xc3,0xdc,0xce,0xd1,0x95,0x08,0x52,0xe9,0x4e,0xd9,0xbe,0x55,0xe3}, 1},
+    {{0x67,0xa0,0xcb,0x4d,0xdf,0x11,0x62,0x65,0x26,0xc1,0x96,0x2b,0x05,0xcc,0xfe,0x05,0x9c,0xd0,0xf2,0xce,0x49,0x61,0xf6,0xfc,0x41,0x51,0x1a,0x8b,0x3f,0x39,0x7d,0xe5}, 0},
+    {{0x67,0xa0,0xcb,0x4d,0xdf,0x11,0x62,0x65,0x26,0xc1,0x96,0x2b,0x05,0xcc,0xfe,0x05,0x9c,0xd0,0xf2,0xce,0x49,0x61,0xf6,0xfc,0x41,0x51,0x1a,0x8b,0x3f,0x39,0x7d,0xe5}, 1},
+    {{0x67,0xac,0x7e,0xb2,0xee,0xf9,0xe1,0xb2,0x67,0xd7,0x73,0x42,0x1a,0x20,0x15,0x3f,0x16,0x70,0x5d,0x98,0x06,0xfb,0x83,0x10,0xa7,0x17,0x3d,0xa4,0xea,0x3e,0xe9,0x8f}, 0},
+    {{0x68,0x47,0xd4,0x3a,0x77,0x56,0x74,0x55,0xc3,0x15,0x73,0x76,0xbd,0xbe,0x46,0xaf,0xd5,0x8d,0xf3,0xe7,0xea,0xc8,0xc0,0xc3,0x64,0xc9,0x28,0xf9,0x35,0xf8,0xf6,0xfd}, 0},
+    {{0x68,0xf8,0x9c,0x42,0xbb,0x78,0xb9,0xab,0x01,0xab,0xee,0xb2,0xfa,0xed,0xfa,0x99,0x96,0x86,0xf7,0x47,0xe3,0xc9,0x18,0x76,0xeb,0x9c,0x2e,0x82,0x86,0x46,0x6d,0x6f}, 0},
+    {{0x69,0x83,0x07,0xfd,0x5c,0x5e,0x04,0x5d,0x51,0x6b,0xbe,0xa0,0xbe,0x58,0xad,0x5c,0x37,0xf7,0x3e,0x9f,0xd4,0xad,0x8a,0x70,0x2c,0x52,0x0f,0x53,0x09,0x00,0xd6,0x89}, 0},
+    {{0x69,0x88,0x84,0xf3,0xb3,0x24,0x17,0x8e,0xba,0xff,0x08,0x43,0xb6,0xe7,0x4b,0xf7,0x4b,0x6b,0x86,0x8b,0xdb,0x09,0xc5,0x1f,0x6f,0x39,0xaf,0x95,0xf1,0x49,0x31,0xd9}, 0},
+    {{0x69,0x88,0x84,0xf3,0xb3,0x24,0x17,0x8e,0xba,0xff,0x08,0x43,0xb6,0xe7,0x4b,0xf7,0x4b,0x6b,0x86,0x8b,0xdb,0x09,0xc5,0x1f,0x6f,0x39,0xaf,0x95,0xf1,0x49,0x31,0xd9}, 1},
+    {{0x69,0xc6,0xda,0xe1,0x0e,0x2f,0xeb,0x0e,0xfe,0x5f,0x58,0xa3,0x11,0xe1,0xda,0x8e,0x01,0x5e,0xb0,0x87,0x85,0xbd,0x3c,0xaf,0xa4,0x2f,0x22,0x5e,0x4d,0x03,0xd6,0x6b}, 0},
+    {{0x69,0xd5,0xb9,0xe9,0x4e,0xea,0x74,0xb8,0x42,0x3b,0x24,0xb8,0x57,0xc7,0x33,0x37,0x52,0xeb,0x0f,0x10,0xea,0xb5,0x05,0x66,0x1a,0xef,0xfe,0x8e,0xa6,0x8b,0x06,0x44}, 0},
+    {{0x69,0xd6,0x12,0x9b,0x10,0xe9,0x3f,0x8c,0xed,0x88,0xc1,0x04,0xc2,0xe4,0x5f,0x3b,0xa6,0x47,0x79,0x39,0x93,0xcf,0xc8,0xa0,0x53,0x56,0x5e,0x68,0xa8,0x52,0x6f,0xfa}, 0},
+    {{0x69,0xd6,0x12,0x9b,0x10,0xe9,0x3f,0x8c,0xed,0x88,0xc1,0x04,0xc2,0xe4,0x5f,0x3b,0xa6,0x47,0x79,0x39,0x93,0xcf,0xc8,0xa0,0x53,0x56,0x5e,0x68,0xa8,0x52,0x6f,0xfa}, 1},
+    {{0x6a,0x03,0x88,0x35,0x35,0x97,0xc8,0xf9,0x28,0xbb,0xcd,0x25,0xa4,0x05,0x74,0x89,0xdb,0xc5,0xd3,0x3b,0xd0,0x78,0x11,0xd0,0xe2,0x59,0xa9,0x79,0xaf,0xbf,0x87,0xa3}, 0},
+    {{0x6a,0x46,0x3e,0x82,0x5f,0xe0,0x41,0x10,0x96,0x2a,0x53,0xbc,0x37,0xf9,0x4e,0x0b,0x4b,0x23,0x4c,0x61,0x43,0x2b,0x91,0x58,0x11,0xe2,0xff,0x61,0xbc,0xd2,0xad,0xc4}, 0},
+    {{0x6a,0x66,0x9c,0x93,0x6a,0xc6,0xa4,0x54,0xd9,0xd2,0x46,0xfa,0x5c,0x3f,0x04,0x72,0x7a,0x1c,0xc0,0x70,0x79,0x70,0xaa,0x0d,0xbf,0x6b,0x42,0x13,0x84,0x2c,0xe8,0x2a}, 0},
+    {{0x6a,0x66,0x9c,0x93,0x6a,0xc6,0xa4,0x54,0xd9,0xd2,0x46,0xfa,0x5c,0x3f,0x04,0x72,0x7a,0x1c,0xc0,0x70,0x79,0x70,0xaa,0x0d,0xbf,0x6b,0x42,0x13,0x84,0x2c,0xe8,0x2a}, 1},
+    {{0x6a,0xf6,0x4a,0x17,0x66,0xcc,0x5f,0x40,0x26,0xc4,0x2e,0xfa,0x7c,0x17,0x39,0x7b,0x21,0xc4,0x68,0xff,0x82,0xb3,0xfd,0xc7,0x4e,0x94,0xea,0x95,0x6a,0xfb,0xc6,0xf4}, 0},
+    {{0x6a,0xf6,0x4a,0x17,0x66,0xcc,0x5f,0x40,0x26,0xc4,0x2e,0xfa,0x7c,0x17,0x39,0x7b,0x21,0xc4,0x68,0xff,0x82,0xb3,0xfd,0xc7,0x4e,0x94,0xea,0x95,0x6a,0xfb,0xc6,0xf4}, 1},
+    {{0x6b,0x0f,0x95,0x10,0x9b,0xbb,0x90,0xdd,0x32,0x08,0x0e,0x20,0x45,0x3c,0x95,0xa7,0x40,0x7b,0x4f,0x37,0x24,0x1e,0x23,0xa2,0x61,0xd6,0x02,0x5c,0x39,0x31,0xa8,0x38}, 0},
+    {{0x6b,0x0f,0x95,0x10,0x9b,0xbb,0x90,0xdd,0x32,0x08,0x0e,0x20,0x45,0x3c,0x95,0xa7,0x40,0x7b,0x4f,0x37,0x24,0x1e,0x23,0xa2,0x61,0xd6,0x02,0x5c,0x39,0x31,0xa8,0x38}, 1},
+    {{0x6b,0x79,0x1c,0x78,0x9b,0xb9,0x86,0x58,0x29,0xca,0x89,0x27,0xac,0x96,0x6c,0x2c,0x40,0x05,0xfb,0x30,0x1c,0x2f,0x02,0xb9,0x82,0x4d,0xcf,0x92,0x46,0x92,0x7c,0x56}, 0},
+    {{0x6b,0x79,0x1c,0x78,0x9b,0xb9,0x86,0x58,0x29,0xca,0x89,0x27,0xac,0x96,0x6c,0x2c,0x40,0x05,0xfb,0x30,0x1c,0x2f,0x02,0xb9,0x82,0x4d,0xcf,0x92,0x46,0x92,0x7c,0x56}, 1},
+    {{0x6c,0x19,0x77,0x42,0x20,0xb2,0xd2,0x27,0x40,0x9f,0xac,0xf2,0x84,0x41,0x82,0xba,0x79,0x3a,0xe4,0x19,0x6a,0x6e,0x61,0xc8,0x27,0x8f,0x87,0xa1,0x51,0xd7,0xfe,0x42}, 0},
+    {{0x6c,0x19,0x77,0x42,0x20,0xb2,0xd2,0x27,0x40,0x9f,0xac,0xf2,0x84,0x41,0x82,0xba,0x79,0x3a,0xe4,0x19,0x6a,0x6e,0x61,0xc8,0x27,0x8f,0x87,0xa1,0x51,0xd7,0xfe,0x42}, 1},
+    {{0x6c,0x36,0x19,0x09,0xe3,0x68,0x50,0xf6,0xab,0x29,0xfb,0x34,0xd6,0xde,0x99,0x5d,0x21,0x11,0xdc,0x46,0xfb,0x72,0xe6,0xb3,0x57,0xeb,0x97,0x70,0xad,0x0c,0xe5,0x43}, 0},
+    {{0x6c,0x36,0x19,0x09,0xe3,0x68,0x50,0xf6,0xab,0x29,0xfb,0x34,0xd6,0xde,0x99,0x5d,0x21,0x11,0xdc,0x46,0xfb,0x72,0xe6,0xb3,0x57,0xeb,0x97,0x70,0xad,0x0c,0xe5,0x43}, 1},
+    {{0x6c,0x55,0x4b,0x6c,0x3a,0xc3,0x0e,0x3e,0x6e,0x04,0x54,0xc9,0x92,0x74,0xd0,0xdb,0xa8,0xa9,0x5c,0xe6,0xe4,0x63,0x97,0x5b,0x13,0x6c,0x37,0x0a,0x2b,0xad,0xb9,0x22}, 0},
+    {{0x6c,0x55,0x4b,0x6c,0x3a,0xc3,0x0e,0x3e,0x6e,0x04,0x54,0xc9,0x92,0x74,0xd0,0xdb,0xa8,0xa9,0x5c,0xe6,0xe4,0x63,0x97,0x5b,0x13,0x6c,0x37,0x0a,0x2b,0xad,0xb9,0x22}, 1},
+    {{0x6c,0xa3,0x28,0xcf,0x79,0x9f,0xe3,0x75,0x80,0x07,0x6b,0x05,0x7b,0xa9,0x49,0x4c,0x20,0xa1,0x8d,0xe0,0x58,0xff,0x86,0x9a,0xaf,0x38,0xe5,0xaa,0xf6,0x7d,0xea,0xf2}, 0},
+    {{0x6c,0xa3,0x28,0xcf,0x79,0x9f,0xe3,0x75,0x80,0x07,0x6b,0x05,0x7b,0xa9,0x49,0x4c,0x20,0xa1,0x8d,0xe0,0x58,0xff,0x86,0x9a,0xaf,0x38,0xe5,0xaa,0xf6,0x7d,0xea,0xf2}, 1},
+    {{0x6c,0xc3,0xe2,0x14,0x92,0xa7,0x9b,0x42,0x92,0xf9,0x83,0x67,0xf0,0xc1,0xf7,0xbb,0xdb,0x22,0x10,0x05,0x31,0x14,0x05,0x92,0x5c,0x6f,0x76,0xdf,0xc0,0xc9,0xe5,0x3f}, 0},
+    {{0x6c,0xc3,0xe2,0x14,0x92,0xa7,0x9b,0x42,0x92,0xf9,0x83,0x67,0xf0,0xc1,0xf7,0xbb,0xdb,0x22,0x10,0x05,0x31,0x14,0x05,0x92,0x5c,0x6f,0x76,0xdf,0xc0,0xc9,0xe5,0x3f}, 1},
+    {{0x6d,0x72,0x7c,0x4f,0xc2,0x8c,0x0b,0x1d,0xb6,0xa4,0x69,0x6c,0x14,0x43,0xfd,0x8b,0x79,0x59,0xe9,0xf3,0x27,0x73,0x83,0x8a,0x33,0x1e,0x96,0xb1,0x5d,0xc3,0x55,0x3b}, 0},
+    {{0x6d,0x72,0x7c,0x4f,0xc2,0x8c,0x0b,0x1d,0xb6,0xa4,0x69,0x6c,0x14,0x43,0xfd,0x8b,0x79,0x59,0xe9,0xf3,0x27,0x73,0x83,0x8a,0x33,0x1e,0x96,0xb1,0x5d,0xc3,0x55,0x3b}, 1},
+    {{0x6d,0x79,0xd0,0x66,0xc1,0xac,0xa3,0xed,0x83,0xec,0x08,0x37,0xaa,0x91,0x84,0x6d,0xd5,0x4d,0x38,0xe1,0x19,0x53,0x1f,0x83,0xa1,0xeb,0x25,0xb0,0x39,0x23,0x53,0x6b}, 0},
+    {{0x6d,0x79,0xd0,0x66,0xc1,0xac,0xa3,0xed,0x83,0xec,0x08,0x37,0xaa,0x91,0x84,0x6d,0xd5,0x4d,0x38,0xe1,0x19,0x53,0x1f,0x83,0xa1,0xeb,0x25,0xb0,0x39,0x23,0x53,0x6b}, 1},
+    {{0x6d,0xc8,0x12,0x60,0x3d,0x12,0xb4,0x0a,0x3b,0x34,0xc2,0x60,0x69,0x32,0x91,0xe6,0x7f,0xbb,0xb4,0xbe,0x6b,0xa0,0x6d,0xc6,0x7e,0x67,0xfd,0xa1,0x15,0x34,0xa8,0x10}, 0},
+    {{0x6d,0xc8,0x12,0x60,0x3d,0x12,0xb4,0x0a,0x3b,0x34,0xc2,0x60,0x69,0x32,0x91,0xe6,0x7f,0xbb,0xb4,0xbe,0x6b,0xa0,0x6d,0xc6,0x7e,0x67,0xfd,0xa1,0x15,0x34,0xa8,0x10}, 1},
+    {{0x6d,0xe0,0x9f,0x7e,0xbc,0xba,0x98,0x5e,0xd2,0xf4,0xae,0x37,0x83,0x8c,0xd7,0x51,0x09,0xca,0x47,0x33,0x89,0x25,0x49,0x1c,0xa9,0x68,0x76,0x40,0xfe,0xf6,0x65,0x89}, 0},
+    {{0x6d,0xe0,0x9f,0x7e,0xbc,0xba,0x98,0x5e,0xd2,0xf4,0xae,0x37,0x83,0x8c,0xd7,0x51,0x09,0xca,0x47,0x33,0x89,0x25,0x49,0x1c,0xa9,0x68,0x76,0x40,0xfe,0xf6,0x65,0x89}, 1},
+    {{0x6e,0x46,0x52,0x3e,0xb0,0x3e,0x7e,0xe0,0x68,0xc3,0xcd,0x21,0xc9,0xa5,0xa1,0xfc,0xc9,0xff,0x37,0xae,0x73,0x9c,0x65,0xb5,0x98,0xf9,0x80,0xac,0xc5,0xdf,0x23,0x88}, 0},
+    {{0x6e,0x61,0x68,0x20,0x85,0x64,0x39,0xf3,0xb0,0xb1,0x1a,0x6c,0x21,0x6e,0x70,0x17,0x63,0xca,0xc6,0xb4,0xd4,0x83,0xab,0x9f,0xda,0x94,0x12,0xaa,0xc5,0x29,0x77,0xf7}, 0},
+    {{0x6e,0xa9,0x3f,0xbe,0xd4,0xc4,0xeb,0xa0,0xf3,0x3b,0xfa,0x28,0x18,0x6b,0xd1,0xf0,0x4d,0xa4,0x72,0xb8,0xb2,0xf0,0xa3,0x45,0xd6,0xfc,0xba,0x13,0xd1,0xe2,0x93,0x34}, 0},
+    {{0x6e,0xdd,0x05,0x2f,0xb3,0xdc,0x84,0xe2,0xc5,0x59,0xc5,0x80,0x8c,0x29,0x3f,0xaa,0x32,0xb7,0xe3,0x18,0x8c,0x46,0xcb,0xf0,0x5b,0x59,0xd1,0x79,0x84,0x11,0x89,0xcf}, 1},
+    {{0x6e,0xdd,0x05,0x2f,0xb3,0xdc,0x84,0xe2,0xc5,0x59,0xc5,0x80,0x8c,0x29,0x3f,0xaa,0x32,0xb7,0xe3,0x18,0x8c,0x46,0xcb,0xf0,0x5b,0x59,0xd1,0x79,0x84,0x11,0x89,0xcf}, 2},
+    {{0x6f,0x6e,0x71,0x51,0x4b,0x3d,0x98,0x78,0x56,0xc7,0x61,0x21,0x9f,0x0b,0x65,0x47,0x53,0xee,0x3b,0x61,0x02,0xcc,0x9a,0xcc,0x0c,0xe5,0x5e,0x37,0x52,0x0a,0x71,0x90}, 0},
+    {{0x6f,0x77,0xdb,0xed,0x92,0x48,0xbf,0xa6,0x4a,0x19,0x90,0xf5,0x60,0x2d,0x3a,0xf5,0x56,0x7d,0xd3,0xbd,0x40,0xf5,0x38,0x34,0xc1,0x82,0x38,0xfe,0x64,0xce,0xef,0xd3}, 0},
+    {{0x6f,0x77,0xdb,0xed,0x92,0x48,0xbf,0xa6,0x4a,0x19,0x90,0xf5,0x60,0x2d,0x3a,0xf5,0x56,0x7d,0xd3,0xbd,0x40,0xf5,0x38,0x34,0xc1,0x82,0x38,0xfe,0x64,0xce,0xef,0xd3}, 1},
+    {{0x6f,0x7b,0xec,0x56,0x8f,0x03,0xbf,0x9f,0x80,0xcd,0xec,0x24,0xc3,0x20,0xcc,0xc8,0xe9,0x04,0x45,0x43,0xed,0x4e,0xc7,0x19,0x82,0xdd,0x5b,0x86,0x7c,0xc3,0x22,0x67}, 0},
+    {{0x6f,0x89,0x5e,0x6b,0x0d,0x5f,0x62,0x28,0x45,0xe6,0xe3,0x95,0xef,0x89,0x4e,0xbc,0xad,0x69,0xd6,0x3d,0x52,0x86,0xb5,0x78,0xa1,0xd8,0x25,0xe3,0xeb,0xfb,0xb0,0x2a}, 0},
+    {{0x6f,0xf1,0x42,0x19,0x8d,0xb3,0x09,0x5b,0xeb,0x53,0x90,0xee,0x12,0x99,0x53,0x40,0xfe,0xe1,0xab,0x0c,0xd9,0xe5,0xa1,0xb7,0x39,0xb7,0x1c,0x6e,0x8a,0xd2,0x36,0xde}, 0},
+    {{0x6f,0xf1,0x42,0x19,0x8d,0xb3,0x09,0x5b,0xeb,0x53,0x90,0xee,0x12,0x99,0x53,0x40,0xfe,0xe1,0xab,0x0c,0xd9,0xe5,0xa1,0xb7,0x39,0xb7,0x1c,0x6e,0x8a,0xd2,0x36,0xde}, 1},
+    {{0x6f,0xfe,0x62,0x56,0x84,0xd2,0x07,0x63,0x7c,0xce,0x83,0xc3,0xde,0x42,0x9b,0x78,0x00,0x81,0x7d,0x5a,0x76,0xcc,0x10,0x3d,0xed,0x4e,0x8c,0xe2,0x0b,0x58,0xa1,0xd3}, 0},
+    {{0x70,0x73,0x8d,0xda,0x50,0xc8,0x53,0x40,0x24,0x29,0x3b,0x7e,0x73,0x8f,0xe9,0xf6,0xae,0xc6,0xc4,0xe4,0x1d,0x57,0x3f,0xdd,0x7c,0x52,0x4e,0xd5,0x63,0x1d,0x76,0x86}, 0},
+    {{0x70,0x73,0x8d,0xda,0x50,0xc8,0x53,0x40,0x24,0x29,0x3b,0x7e,0x73,0x8f,0xe9,0xf6,0xae,0xc6,0xc4,0xe4,0x1d,0x57,0x3f,0xdd,0x7c,0x52,0x4e,0xd5,0x63,0x1d,0x76,0x86}, 1},
+    {{0x70,0x8f,0x41,0xa7,0x61,0x5e,0x1a,0xf7,0x41,0x64,0xfd,0x0c,0x48,0x21,0x29,0x4d,0xc4,0x19,0xb9,0x8b,0xf6,0xe9,0x17,0x0d,0x6d,0xdf,0x7b,0x1f,0xb2,0xf4,0x34,0xfe}, 0},
+    {{0x70,0x8f,0x41,0xa7,0x61,0x5e,0x1a,0xf7,0x41,0x64,0xfd,0x0c,0x48,0x21,0x29,0x4d,0xc4,0x19,0xb9,0x8b,0xf6,0xe9,0x17,0x0d,0x6d,0xdf,0x7b,0x1f,0xb2,0xf4,0x34,0xfe}, 1},
+    {{0x70,0xaf,0x6f,0xf5,0x9c,0x62,0x78,0xe0,0xc6,0xa6,0x6a,0x5d,0x29,0x6e,0xa7,0xe1,0x16,0x5e,0x05,0x66,0xfa,0x4a,0xdb,0xe1,0x72,0x73,0xc5,0x98,0x3c,0xbe,0xc7,0x92}, 0},
+    {{0x70,0xaf,0x6f,0xf5,0x9c,0x62,0x78,0xe0,0xc6,0xa6,0x6a,0x5d,0x29,0x6e,0xa7,0xe1,0x16,0x5e,0x05,0x66,0xfa,0x4a,0xdb,0xe1,0x72,0x73,0xc5,0x98,0x3c,0xbe,0xc7,0x92}, 1},
+    {{0x71,0x00,0xa6,0x18,0x17,0x44,0x1b,0x83,0x11,0xef,0xed,0xe5,0x55,0xc6,0x9b,0x68,0x09,0x65,0x36,0x2b,0x4a,0x90,0x93,0x81,0x15,0x4b,0x6d,0x6b,0xb7,0xb5,0x7d,0x9b}, 0},
+    {{0x71,0x75,0x03,0xfd,0x45,0x8c,0x2b,0xb0,0x0b,0x35,0xaa,0xea,0xed,0x45,0x08,0x15,0x88,0x5f,0x1a,0xf6,0x4b,0xfa,0x79,0xc7,0x60,0x7c,0x40,0x60,0x3c,0x4c,0x37,0x8f}, 0},
+    {{0x71,0x7a,0x23,0x8d,0x9e,0x32,0x54,0xda,0x3a,0x80,0x36,0xae,0xee,0x50,0x27,0x8e,0xd1,0x7e,0x59,0xd1,0x0a,0xfd,0x50,0xa5,0xec,0x5a,0x45,0x8b,0xe3,0xca,0xd6,0xb1}, 0},
+    {{0x72,0x56,0xf1,0x8e,0xbe,0x63,0xd8,0x07,0x01,0xf4,0x2d,0x98,0xbc,0xb1,0x4c,0x81,0x2e,0xaa,0x48,0x18,0xc9,0x91,0x57,0xe8,0xc3,0xc1,0x97,0xd3,0x27,0xe4,0xe6,0x46}, 0},
+    {{0x72,0x90,0x53,0x9c,0x43,0xbf,0x95,0xf6,0x3f,0x43,0x5e,0xba,0xc1,0x30,0x1c,0xfa,0x7a,0x89,0x1f,0x46,0x9d,0x47,0xad,0x59,0x19,0x4e,0x20,0x35,0xa5,0x3b,0x55,0xfd}, 0},
+    {{0x72,0x90,0x53,0x9c,0x43,0xbf,0x95,0xf6,0x3f,0x43,0x5e,0xba,0xc1,0x30,0x1c,0xfa,0x7a,0x89,0x1f,0x46,0x9d,0x47,0xad,0x59,0x19,0x4e,0x20,0x35,0xa5,0x3b,0x55,0xfd}, 1},
+    {{0x72,0x99,0x36,0x30,0x7b,0x89,0x90,0x62,0x76,0x48,0x94,0x8b,0x7b,0xf9,0x67,0xe8,0xc2,0x89,0xda,0x52,0xb0,0xd4,0x2b,0x86,0xe3,0xc6,0x98,0xd3,0xb7,0x54,0x5f,0xe3}, 0},
+    {{0x72,0x9c,0xa2,0x59,0x90,0x9c,0xa3,0x68,0xcd,0xef,0x63,0xa5,0x75,0x60,0x4e,0x31,0xfd,0xcb,0xde,0x35,0x0a,0x06,0xb2,0x09,0x92,0x05,0x41,0xc6,0xb9,0x7c,0x79,0x77}, 0},
+    {{0x72,0xaa,0xc0,0xac,0x6d,0xe2,0x6a,0x88,0x3d,0x7a,0x81,0x79,0xe8,0x56,0xee,0x52,0xb3,0x1e,0x9d,0x9e,0x7c,0x99,0x88,0x59,0x81,0xe2,0xf5,0xa4,0x6d,0xc6,0x42,0x53}, 0},
+    {{0x72,0xb0,0xda,0x7b,0xf9,0x56,0xd9,0xa4,0x3d,0x88,0x09,0xe0,0xf3,0x94,0x6f,0xf3,0x42,0x35,0xc0,0x3c,0x63,0x8c,0x80,0xd1,0xdc,0xb8,0x2a,0x96,0xed,0x4c,0xef,0xe8}, 0},
+    {{0x72,0xf5,0x2e,0x1d,0x9e,0xc0,0xee,0x0a,0x8e,0x44,0x91,0x22,0x57,0xfa,0x2f,0x14,0x50,0x8b,0x77,0x15,0x2c,0xea,0xae,0x77,0x81,0x16,0x75,0x59,0xa6,0x51,0x97,0xc8}, 0},
+    {{0x72,0xf5,0x2e,0x1d,0x9e,0xc0,0xee,0x0a,0x8e,0x44,0x91,0x22,0x57,0xfa,0x2f,0x14,0x50,0x8b,0x77,0x15,0x2c,0xea,0xae,0x77,0x81,0x16,0x75,0x59,0xa6,0x51,0x97,0xc8}, 1},
+    {{0x72,0xf5,0x7c,0xcb,0x5b,0x07,0x05,0x2f,0xce,0x00,0x31,0x89,0x93,0x94,0xb7,0x22,0xbb,0x83,0x4f,0x5a,0xf1,0xf3,0xa0,0x09,0xe2,0x58,0xd1,0x6c,0x5c,0xad,0x2f,0x9b}, 0},
+    {{0x72,0xf5,0x7c,0xcb,0x5b,0x07,0x05,0x2f,0xce,0x00,0x31,0x89,0x93,0x94,0xb7,0x22,0xbb,0x83,0x4f,0x5a,0xf1,0xf3,0xa0,0x09,0xe2,0x58,0xd1,0x6c,0x5c,0xad,0x2f,0x9b}, 1},
+    {{0x73,0x16,0x0d,0xe0,0x4a,0x02,0xae,0xde,0x93,0xc0,0x4d,0x63,0xf5,0xc7,0x78,0x47,0x13,0xea,0x1b,0xf4,0xf7,0x5c,0xa0,0x8d,0x61,0xfa,0xf8,0x36,0xa2,0xf0,0x85,0xb9}, 0},
+    {{0x73,0x1f,0x6a,0x64,0xaf,0x8a,0x00,0x0e,0xee,0xcf,0x27,0x2e,0x1b,0x4e,0x3b,0x1d,0xd1,0x98,0x1e,0xe6,0xf5,0x3e,0x74,0x64,0xbc,0x23,0x94,0x3a,0xfb,0x88,0xd3,0xee}, 0},
+    {{0x73,0x1f,0x6a,0x64,0xaf,0x8a,0x00,0x0e,0xee,0xcf,0x27,0x2e,0x1b,0x4e,0x3b,0x1d,0xd1,0x98,0x1e,0xe6,0xf5,0x3e,0x74,0x64,0xbc,0x23,0x94,0x3a,0xfb,0x88,0xd3,0xee}, 1},
+    {{0x73,0x6f,0x8f,0x28,0xe6,0x10,0x48,0x22,0x86,0x57,0x80,0x5b,0xeb,0x9d,0x23,0x53,0xe4,0x95,0xec,0xc5,0xe3,0x78,0xc3,0xdd,0x53,0x5e,0x39,0x48,0x35,0x7b,0x4d,0x81}, 0},
+    {{0x73,0x7b,0x64,0xe8,0x53,0x81,0x5f,0x1c,0x0d,0xdb,0xe3,0x21,0xcc,0xb2,0xac,0x89,0x49,0xa6,0x12,0x07,0x06,0x64,0x69,0x82,0x70,0x9e,0xfc,0xb4,0x10,0xeb,0x94,0xca}, 0},
+    {{0x73,0x7b,0x64,0xe8,0x53,0x81,0x5f,0x1c,0x0d,0xdb,0xe3,0x21,0xcc,0xb2,0xac,0x89,0x49,0xa6,0x12,0x07,0x06,0x64,0x69,0x82,0x70,0x9e,0xfc,0xb4,0x10,0xeb,0x94,0xca}, 1},
+    {{0x73,0x8c,0x1d,0xb6,0x31,0x00,0x38,0xae,0x7e,0xaa,0xe9,0x7f,0x8b,0x25,0x20,0x25,0x77,0x3a,0x6a,0xf6,0x77,0xf5,0x1f,0xff,0x2f,0x07,0x25,0x51,0x81,0xa8,0x96,0xc5}, 0},
+    {{0x73,0x8c,0x1d,0xb6,0x31,0x00,0x38,0xae,0x7e,0xaa,0xe9,0x7f,0x8b,0x25,0x20,0x25,0x77,0x3a,0x6a,0xf6,0x77,0xf5,0x1f,0xff,0x2f,0x07,0x25,0x51,0x81,0xa8,0x96,0xc5}, 1},
+    {{0x74,0x0a,0x81,0x2c,0x02,0x52,0x4f,0x59,0x03,0x8f,0xb4,0x6a,0xaf,0xb7,0x6a,0xfd,0xf3,0x88,0xe7,0x4b,0xda,0x40,0x1d,0x92,0xbd,0x6b,0xac,0x1f,0x61,0xa1,0x64,0x66}, 0},
+    {{0x74,0x0a,0x81,0x2c,0x02,0x52,0x4f,0x59,0x03,0x8f,0xb4,0x6a,0xaf,0xb7,0x6a,0xfd,0xf3,0x88,0xe7,0x4b,0xda,0x40,0x1d,0x92,0xbd,0x6b,0xac,0x1f,0x61,0xa1,0x64,0x66}, 1},
+    {{0x74,0x5e,0xd4,0xdb,0xc1,0x91,0x12,0x06,0x4a,0xc2,0xdf,0x08,0x4f,0x2d,0xfe,0x19,0x91,0x55,0x3c,0x1b,0x9a,0xa7,0x91,0xde,0x47,0x9d,0x25,0xd3,0x47,0x56,0xda,0xce}, 0},
+    {{0x74,0x5e,0xd4,0xdb,0xc1,0x91,0x12,0x06,0x4a,0xc2,0xdf,0x08,0x4f,0x2d,0xfe,0x19,0x91,0x55,0x3c,0x1b,0x9a,0xa7,0x91,0xde,0x47,0x9d,0x25,0xd3,0x47,0x56,0xda,0xce}, 1},
+    {{0x74,0xbe,0xda,0x42,0x03,0xf2,0x88,0xbc,0x38,0xae,0x52,0x15,0x80,0xf3,0xeb,0x93,0x89,0x02,0x59,0x48,0x75,0x05,0x53,0x89,0x33,0xde,0xf9,0xc8,0xae,0x6d,0xd1,0x9a}, 0},
+    {{0x75,0x13,0xb6,0x17,0x35,0x65,0x6b,0xd0,0x9e,0x58,0x6e,0x91,0xa3,0xf2,0xfd,0x44,0x7a,0xbc,0x6a,0x0a,0x0c,0x33,0xbd,0x4f,0xc2,0x9c,0x6f,0xa9,0xa3,0x86,0xe7,0xb4}, 0},
+    {{0x75,0x40,0xee,0x2f,0xdd,0x4d,0xda,0x26,0x21,0x13,0xdf,0x73,0x58,0xa9,0x96,0x73,0x3c,0xda,0x3f,0xcc,0xd8,0x39,0x76,0x26,0x39,0x27,0x14,0x1c,0x0c,0x4a,0x24,0xc7}, 0},
+    {{0x75,0x64,0xa7,0xa7,0x8e,0x70,0x69,0x95,0x33,0xa2,0x68,0x67,0x0f,0x7c,0x0d,0xfa,0xe4,0x12,0x46,0x55,0x44,0xd8,0x13,0x9f,0x38,0x30,0x90,0xb9,0xa7,0xc0,0x59,0x3a}, 0},
+    {{0x75,0x88,0x0a,0x83,0x09,0x9c,0x43,0xaa,0x15,0x8e,0x15,0x39,0x37,0x31,0x1c,0x26,0xfd,0x26,0x50,0x83,0x45,0x41,0x8a,0x2e,0xb9,0x79,0x68,0x19,0x66,0x9f,0xb8,0xcb}, 0},
+    {{0x75,0x88,0x0a,0x83,0x09,0x9c,0x43,0xaa,0x15,0x8e,0x15,0x39,0x37,0x31,0x1c,0x26,0xfd,0x26,0x50,0x83,0x45,0x41,0x8a,0x2e,0xb9,0x79,0x68,0x19,0x66,0x9f,0xb8,0xcb}, 1},
+    {{0x75,0xaa,0x07,0xcd,0x7c,0xb5,0x4b,0xd8,0x1e,0x99,0x26,0x43,0x00,0x79,0x0b,0x4d,0x0c,0xa9,0xf2,0x1e,0xc5,0x64,0xd4,0xa2,0xc3,0xf8,0xda,0xc4,0xe0,0x9f,0xae,0x07}, 0},
+    {{0x75,0xaa,0x07,0xcd,0x7c,0xb5,0x4b,0xd8,0x1e,0x99,0x26,0x43,0x00,0x79,0x0b,0x4d,0x0c,0xa9,0xf2,0x1e,0xc5,0x64,0xd4,0xa2,0xc3,0xf8,0xda,0xc4,0xe0,0x9f,0xae,0x07}, 1},
+    {{0x75,0xdb,0x22,0xba,0x17,0xd0,0xe9,0x87,0x74,0xe9,0xf8,0x14,0x95,0x84,0xf6,0xcc,0xa1,0x34,0x15,0xa7,0x80,0xfa,0xef,0xbf,0x44,0x8a,0x6a,0x62,0x24,0x14,0x5a,0x54}, 0},
+    {{0x76,0x2b,0x67,0xde,0xb8,0x7e,0xe4,0xb2,0x0b,0xa7,0x61,0x05,0x2a,0x9a,0xf2,0x94,0xbe,0xfc,0xd9,0x19,0x90,0x04,0x0e,0xb4,0x8f,0xb0,0x7f,0x53,0xcb,0x50,0x74,0x51}, 0},
+    {{0x76,0x2b,0x67,0xde,0xb8,0x7e,0xe4,0xb2,0x0b,0xa7,0x61,0x05,0x2a,0x9a,0xf2,0x94,0xbe,0xfc,0xd9,0x19,0x90,0x04,0x0e,0xb4,0x8f,0xb0,0x7f,0x53,0xcb,0x50,0x74,0x51}, 1},
+    {{0x76,0x2d,0x62,0x2e,0xe5,0x43,0xbc,0xa2,0x36,0xed,0x1e,0x59,0x7d,0x10,0xb7,0xa0,0xf7,0x04,0x67,0x54,0x5a,0xcb,0xbc,0x24,0x30,0x9b,0xb1,0xb6,0x2e,0xb8,0x49,0x76}, 0},
+    {{0x76,0x52,0x18,0x18,0xe1,0xc5,0x2d,0x23,0xb4,0xb1,0x1d,0x03,0x7f,0xd3,0xc4,0x86,0x67,0x25,0xd5,0x84,0x8a,0xe6,0x30,0xb5,0x33,0xc5,0xe6,0xcc,0x2c,0x23,0x3d,0x7f}, 0},
+    {{0x76,0xd1,0x82,0xc9,0x85,0x3c,0xab,0xbe,0xfe,0x52,0xe6,0xf1,0xbf,0x71,0xb4,0x6f,0xae,0xf8,0x02,0x03,0x60,0x2c,0x97,0x0b,0x34,0x43,0xc7,0x0f,0xc5,0xaf,0xce,0x8f}, 0},
+    {{0x76,0xd1,0x82,0xc9,0x85,0x3c,0xab,0xbe,0xfe,0x52,0xe6,0xf1,0xbf,0x71,0xb4,0x6f,0xae,0xf8,0x02,0x03,0x60,0x2c,0x97,0x0b,0x34,0x43,0xc7,0x0f,0xc5,0xaf,0xce,0x8f}, 1},
+    {{0x77,0x28,0xdd,0x69,0x1d,0xd6,0x4c,0x52,0xc6,0xd6,0xce,0x73,0x93,0xa4,0xd3,0xa4,0x93,0x0b,0x04,0x9d,0x48,0xe1,0x39,0x1a,0x7c,0x33,0x76,0x5b,0xac,0x1a,0x90,0x65}, 0},
+    {{0x77,0x28,0xdd,0x69,0x1d,0xd6,0x4c,0x52,0xc6,0xd6,0xce,0x73,0x93,0xa4,0xd3,0xa4,0x93,0x0b,0x04,0x9d,0x48,0xe1,0x39,0x1a,0x7c,0x33,0x76,0x5b,0xac,0x1a,0x90,0x65}, 1},
+    {{0x77,0x8b,0x90,0x30,0xeb,0x3e,0x81,0x6b,0xbd,0x1a,0x52,0x92,0x4f,0x92,0x64,0xc8,0x9b,0x79,0x3c,0x0d,0x1c,0x77,0x04,0x54,0x75,0x83,0xbe,0x28,0x09,0x61,0xf8,0xf4}, 0},
+    {{0x77,0xbe,0x6f,0xf8,0xf4,0x2f,0xc1,0x5b,0x88,0x74,0xf3,0xf3,0x60,0x3f,0xfa,0x0f,0xcf,0x79,0xe0,0x36,0x23,0x79,0x17,0x45,0xc9,0x14,0x94,0x51,0x32,0xd5,0xb8,0x87}, 0},
+    {{0x77,0xd3,0xf9,0x64,0x91,0xe0,0xb5,0x88,0x96,0x39,0x3d,0x41,0x5f,0x6c,0xb6,0xd9,0x2e,0xad,0xbe,0xbe,0xfb,0x61,0xf5,0xe8,0x2b,0x2e,0xc4,0x19,0xd4,0x31,0x37,0x5f}, 0},
+    {{0x77,0xdc,0xfb,0x93,0x25,0x83,0x36,0x25,0x70,0x57,0x9a,0xce,0x22,0x52,0x72,0x96,0x33,0xc0,0x71,0xfe,0x66,0x74,0x4f,0xbe,0x99,0x66,0x5f,0x56,0xc3,0x17,0x38,0xb3}, 0},
+    {{0x77,0xdc,0xfb,0x93,0x25,0x83,0x36,0x25,0x70,0x57,0x9a,0xce,0x22,0x52,0x72,0x96,0x33,0xc0,0x71,0xfe,0x66,0x74,0x4f,0xbe,0x99,0x66,0x5f,0x56,0xc3,0x17,0x38,0xb3}, 1},
+    {{0x78,0x25,0x95,0x35,0xd5,0xd0,0xd4,0xb3,0xfa,0xda,0x1f,0xce,0xdd,0x23,0x51,0x34,0xa7,0x71,0x29,0x75,0xb3,0x0c,0x0e,0x8b,0xb1,0xe3,0x7c,0x96,0x72,0x0f,0x83,0xfd}, 0},
+    {{0x78,0x25,0x95,0x35,0xd5,0xd0,0xd4,0xb3,0xfa,0xda,0x1f,0xce,0xdd,0x23,0x51,0x34,0xa7,0x71,0x29,0x75,0xb3,0x0c,0x0e,0x8b,0xb1,0xe3,0x7c,0x96,0x72,0x0f,0x83,0xfd}, 1},
+    {{0x78,0x28,0x24,0xc8,0x1a,0xb7,0x7e,0x86,0xc1,0x10,0xca,0xa5,0x93,0x0b,0xf4,0xb8,0x07,0xdb,0x91,0x17,0x68,0xb5,0xce,0xa7,0x37,0x37,0x69,0xef,0x04,0xaa,0xc9,0x6e}, 0},
+    {{0x78,0x28,0x24,0xc8,0x1a,0xb7,0x7e,0x86,0xc1,0x10,0xca,0xa5,0x93,0x0b,0xf4,0xb8,0x07,0xdb,0x91,0x17,0x68,0xb5,0xce,0xa7,0x37,0x37,0x69,0xef,0x04,0xaa,0xc9,0x6e}, 1},
+    {{0x78,0x40,0x37,0x19,0x84,0x6f,0x4e,0xfd,0xec,0x4e,0xe5,0x0e,0x56,0x0d,0xee,0x39,0xa8,0x1d,0x5c,0xdd,0x9b,0x1b,0x2d,0x45,0x80,0xa9,0xb0,0x4e,0xc7,0x5c,0x15,0x90}, 0},
+    {{0x78,0x6f,0xf0,0xff,0xa4,0x69,0xc1,0x52,0x0f,0xd1,0xc1,0x53,0xc8,0x74,0xfa,0xe7,0xd5,0x3c,0x92,0x3a,0xe4,0x13,0x4e,0x68,0xe5,0x22,0x9b,0x40,0xce,0xf8,0x93,0xf7}, 0},
+    {{0x78,0xaf,0xab,0x45,0x85,0xe4,0x5d,0x6e,0xd3,0xcf,0x33,0xb1,0x0b,0x28,0x3e,0x17,0xab,0x0a,0x83,0xa5,0x09,0xc1,0x5f,0xcb,0x1e,0xea,0x0d,0x16,0x90,0xbe,0x95,0xb0}, 0},
+    {{0x79,0x0a,0x71,0x96,0xac,0x2c,0x95,0x93,0x55,0x0a,0xdc,0x9f,0x70,0x27,0xd4,0xf0,0xd1,0x04,0xdf,0x6c,0x46,0xda,0xde,0x11,0x89,0x5f,0x13,0x67,0x5f,0x12,0x21,0xa2}, 0},
+    {{0x79,0x0a,0x71,0x96,0xac,0x2c,0x95,0x93,0x55,0x0a,0xdc,0x9f,0x70,0x27,0xd4,0xf0,0xd1,0x04,0xdf,0x6c,0x46,0xda,0xde,0x11,0x89,0x5f,0x13,0x67,0x5f,0x12,0x21,0xa2}, 1},
+    {{0x79,0x2f,0x5d,0x4e,0xf9,0x63,0x6f,0xeb,0xb4,0x6d,0x87,0x56,0xd2,0xd9,0x06,0x61,0xae,0x45,0x1a,0x37,0x08,0xa0,0xb9,0x35,0xa8,0x63,0x96,0x10,0x3f,0x9a,0x6b,0x8e}, 0},
+    {{0x79,0x37,0x1d,0xe3,0xa5,0xe7,0x05,0xad,0xd1,0x4a,0x39,0xee,0x3d,0x23,0x39,0x8f,0x49,0xc0,0x6c,0x43,0x96,0x3d,0xc3,0xc6,0xa1,0x86,0x14,0xd8,0x02,0xbf,0x8a,0x10}, 0},
+    {{0x79,0xcc,0x91,0x08,0xc1,0x2c,0x23,0xf1,0x97,0x7c,0x2d,0x13,0x10,0xec,0xba,0xdf,0x16,0x26,0x9f,0x08,0x89,0x2d,0xfb,0x06,0xcd,0xa2,0x6a,0xd6,0x68,0x55,0x29,0x2a}, 0},
+    {{0x79,0xda,0xd0,0xc0,0x63,0x56,0x31,0x2c,0xbe,0x36,0x8c,0x9d,0xe6,0xea,0x6d,0x99,0x75,0xfc,0xf0,0x23,0x87,0x32,0x79,0x8e,0xdc,0xd3,0x1f,0xdf,0xff,0xb1,0xc8,0xcb}, 0},
+    {{0x79,0xda,0xd0,0xc0,0x63,0x56,0x31,0x2c,0xbe,0x36,0x8c,0x9d,0xe6,0xea,0x6d,0x99,0x75,0xfc,0xf0,0x23,0x87,0x32,0x79,0x8e,0xdc,0xd3,0x1f,0xdf,0xff,0xb1,0xc8,0xcb}, 1},
+    {{0x7a,0x21,0xca,0x65,0x74,0x9c,0x32,0xeb,0xa7,0x12,0x71,0xd0,0xbe,0x8c,0x38,0x61,0x8c,0xf2,0x8c,0x6a,0x92,0xa9,0x82,0xcd,0x31,0xb0,0x29,0xb7,0x82,0xf4,0x0a,0x61}, 0},
+    {{0x7a,0xac,0x80,0x7f,0xfe,0x6b,0xf1,0x71,0x64,0x21,0x17,0x02,0xa0,0xd5,0xf4,0x06,0x58,0x5b,0xde,0x74,0xf4,0x29,0x93,0x4f,0x4c,0x0b,0xd1,0x4f,0x81,0x2b,0xa9,0x30}, 0},
+    {{0x7a,0xac,0x80,0x7f,0xfe,0x6b,0xf1,0x71,0x64,0x21,0x17,0x02,0xa0,0xd5,0xf4,0x06,0x58,0x5b,0xde,0x74,0xf4,0x29,0x93,0x4f,0x4c,0x0b,0xd1,0x4f,0x81,0x2b,0xa9,0x30}, 1},
+    {{0x7a,0xb6,0xea,0x36,0xb6,0x71,0x66,0xcc,0x67,0x5d,0x9a,0x88,0xc9,0x47,0x19,0x0d,0x49,0xb6,0x33,0x35,0x7e,0xa7,0xdc,0x47,0x41,0x93,0xe5,0x16,0x1d,0x73,0x9b,0x76}, 0},
+    {{0x7a,0xb6,0xea,0x36,0xb6,0x71,0x66,0xcc,0x67,0x5d,0x9a,0x88,0xc9,0x47,0x19,0x0d,0x49,0xb6,0x33,0x35,0x7e,0xa7,0xdc,0x47,0x41,0x93,0xe5,0x16,0x1d,0x73,0x9b,0x76}, 1},
+    {{0x7a,0xde,0x58,0x8b,0x08,0x50,0x97,0xa1,0xa8,0x98,0x69,0xaa,0x0b,0x1a,0x39,0xfb,0x34,0x17,0x3a,0xc9,0x8a,0x4b,0x9b,0x6e,0x6c,0x8b,0x9c,0x9b,0xd2,0xc1,0x5e,0x94}, 0},
+    {{0x7a,0xde,0x58,0x8b,0x08,0x50,0x97,0xa1,0xa8,0x98,0x69,0xaa,0x0b,0x1a,0x39,0xfb,0x34,0x17,0x3a,0xc9,0x8a,0x4b,0x9b,0x6e,0x6c,0x8b,0x9c,0x9b,0xd2,0xc1,0x5e,0x94}, 1},
+    {{0x7a,0xed,0x5b,0x4d,0x05,0x48,0x69,0xc4,0x9f,0x14,0x1e,0xef,0xe4,0x91,0xb8,0xde,0xf8,0x23,0xe2,0x0c,0xf5,0xe4,0xd8,0xea,0xf4,0xa8,0xf5,0xed,0x60,0xcd,0x08,0x56}, 0},
+    {{0x7a,0xee,0xa6,0x97,0x61,0x45,0xd5,0x28,0x82,0xec,0xc1,0xda,0x11,0x83,0xd8,0x56,0x96,0xba,0x57,0x67,0xa3,0x00,0x6b,0xa7,0x63,0x70,0x11,0xae,0x83,0xb8,0x6d,0xaf}, 0},
+    {{0x7b,0xbc,0x50,0x87,0x14,0x83,0x6e,0xc5,0xcc,0x55,0xf4,0xe1,0x03,0x73,0x84,0xfb,0xcf,0x5d,0xf1,0x46,0x37,0x9e,0x49,0x7b,0xfb,0xe4,0x76,0xb1,0xb2,0x8d,0xb5,0x5b}, 0},
+    {{0x7b,0xea,0x4e,0x9b,0xc5,0xf3,0xa0,0x2d,0x9f,0xc0,0x92,0x39,0x3b,0x78,0x06,0x5a,0xf1,0x5d,0x0f,0x86,0x9e,0x03,0x86,0xf8,0x96,0xa7,0x9a,0xbf,0x19,0x76,0xd9,0xb8}, 0},
+    {{0x7c,0x2e,0xe4,0x25,0x0d,0x3c,0x36,0x6e,0xf3,0xe8,0x4a,0x3f,0x3c,0xd4,0x65,0xfe,0x33,0x4b,0x6b,0xfd,0xee,0xea,0x48,0x04,0x0e,0xdd,0x28,0x04,0x4f,0x64,0x2e,0x65}, 0},
+    {{0x7c,0x83,0xda,0x66,0x2b,0x05,0x4b,0x62,0x9e,0x9b,0xed,0x2f,0xf0,0xd8,0xee,0xae,0xcb,0x78,0xb2,0xb5,0xc6,0xcb,0x1c,0x98,0x7d,0xeb,0xed,0x76,0xd1,0x5c,0xc6,0x81}, 0},
+    {{0x7c,0xf6,0x7e,0x00,0x0c,0xa3,0xe2,0x70,0xde,0x1c,0xd5,0x22,0x73,0x0f,0x6a,0x21,0xa6,0x99,0x7b,0xab,0xaf,0x52,0x99,0x95,0x56,0xbe,0x66,0x00,0x73,0xc3,0x61,0x60}, 0},
+    {{0x7d,0x02,0x6d,0x18,0x27,0x62,0x18,0xc9,0x0c,0x94,0x48,0x4c,0x46,0xae,0x7c,0x02,0x64,0xc9,0xbe,0x32,0xb6,0x26,0x1d,0xdd,0x4a,0x60,0x50,0x91,0x8b,0xba,0x9e,0xf8}, 0},
+    {{0x7d,0x02,0x6d,0x18,0x27,0x62,0x18,0xc9,0x0c,0x94,0x48,0x4c,0x46,0xae,0x7c,0x02,0x64,0xc9,0xbe,0x32,0xb6,0x26,0x1d,0xdd,0x4a,0x60,0x50,0x91,0x8b,0xba,0x9e,0xf8}, 1},
+    {{0x7d,0x7b,0x91,0x97,0x0f,0x1a,0xb3,0x96,0x54,0x45,0xdc,0x33,0xbb,0x77,0x0d,0x8b,0x41,0x33,0xe2,0x0b,0xac,0xc4,0x08,0x81,0x46,0x34,0xd0,0x9b,0xd7,0xca,0x3e,0x57}, 0},
+    {{0x7d,0x7b,0x91,0x97,0x0f,0x1a,0xb3,0x96,0x54,0x45,0xdc,0x33,0xbb,0x77,0x0d,0x8b,0x41,0x33,0xe2,0x0b,0xac,0xc4,0x08,0x81,0x46,0x34,0xd0,0x9b,0xd7,0xca,0x3e,0x57}, 1},
+    {{0x7d,0x9f,0x3e,0xa5,0x2f,0x15,0xc2,0xa3,0x6c,0x91,0x06,0x4d,0xb1,0x2a,0xdb,0x35,0x65,0xa3,0x8c,0x4f,0x82,0x21,0x62,0x9d,0x01,0xf7,0xbf,0xb6,0xc0,0x62,0x63,0x8b}, 0},
+    {{0x7d,0xac,0x78,0x9b,0x6a,0x0a,0x0a,0x5c,0x75,0x38,0xc0,0xae,0xaf,0x77,0x10,0x66,0x29,0x93,0xf5,0x76,0xe7,0x73,0x15,0xc4,0xfc,0x09,0x1c,0x3f,0x84,0xaf,0x3d,0xcb}, 0},
+    {{0x7e,0x0c,0x0f,0xa5,0xa5,0x4b,0xe8,0x82,0xe9,0xbb,0x52,0xf0,0xe8,0x3b,0x46,0xaf,0x84,0x09,0xb8,0x00,0x59,0x34,0x25,0x67,0xc9,0x17,0xe8,0xa5,0x53,0xf8,0x85,0x5d}, 1},
+    {{0x7e,0xb5,0x47,0x03,0x64,0xd8,0x78,0x12,0x5f,0xda,0xdd,0x1b,0x43,0x94,0xf8,0xfc,0x1c,0xf1,0xa3,0xba,0xbf,0x97,0xb6,0xe3,0x7b,0xd0,0xa5,0xd1,0x74,0x3b,0x33,0xc4}, 0},
+    {{0x7e,0xbb,0xff,0xb8,0x40,0xeb,0xa6,0xb5,0x1b,0xce,0x04,0x7b,0x02,0xdd,0xdf,0x64,0x07,0x4f,0xa5,0x7d,0x50,0x7e,0xae,0x34,0x40,0x7d,0x88,0x88,0x6f,0x42,0x0d,0xcb}, 0},
+    {{0x7e,0xbb,0xff,0xb8,0x40,0xeb,0xa6,0xb5,0x1b,0xce,0x04,0x7b,0x02,0xdd,0xdf,0x64,0x07,0x4f,0xa5,0x7d,0x50,0x7e,0xae,0x34,0x40,0x7d,0x88,0x88,0x6f,0x42,0x0d,0xcb}, 1},
+    {{0x7e,0xe2,0x63,0x77,0xdd,0xc5,0xfd,0x98,0xe6,0x2f,0x36,0x22,0x01,0x89,0x16,0x02,0x43,0xc4,0xf7,0xd8,0xd7,0xd8,0x7b,0xfe,0x88,0x65,0x36,0x93,0xe8,0xc1,0xc2,0xce}, 0},
+    {{0x7e,0xe2,0x63,0x77,0xdd,0xc5,0xfd,0x98,0xe6,0x2f,0x36,0x22,0x01,0x89,0x16,0x02,0x43,0xc4,0xf7,0xd8,0xd7,0xd8,0x7b,0xfe,0x88,0x65,0x36,0x93,0xe8,0xc1,0xc2,0xce}, 1},
+    {{0x7e,0xf9,0x87,0x28,0x7e,0x4a,0x85,0x4c,0xd2,0x56,0x6d,0xaa,0xca,0xbf,0x05,0x5e,0x50,0x67,0x8b,0x8f,0x39,0x4b,0x65,0x6b,0xd2,0x8f,0x07,0x55,0x2c,0xa5,0x1f,0xaa}, 0},
+    {{0x7e,0xf9,0x87,0x28,0x7e,0x4a,0x85,0x4c,0xd2,0x56,0x6d,0xaa,0xca,0xbf,0x05,0x5e,0x50,0x67,0x8b,0x8f,0x39,0x4b,0x65,0x6b,0xd2,0x8f,0x07,0x55,0x2c,0xa5,0x1f,0xaa}, 1},
+    {{0x7e,0xfc,0x64,0x98,0x80,0xe2,0x9e,0xff,0xdf,0xcf,0xcc,0x51,0xd3,0x86,0xa8,0x8e,0x87,0xef,0xaa,0x29,0xd6,0x86,0xa1,0x5d,0xc3,0x72,0xbe,0xa2,0xd6,0x8c,0x05,0xbd}, 0},
+    {{0x7e,0xfc,0x64,0x98,0x80,0xe2,0x9e,0xff,0xdf,0xcf,0xcc,0x51,0xd3,0x86,0xa8,0x8e,0x87,0xef,0xaa,0x29,0xd6,0x86,0xa1,0x5d,0xc3,0x72,0xbe,0xa2,0xd6,0x8c,0x05,0xbd}, 1},
+    {{0x7f,0x2d,0xe0,0xbd,0xb6,0xd9,0xa4,0x0d,0xdd,0x16,0x1f,0x0d,0xe7,0x8b,0xe4,0x2e,0xb7,0xf9,0xe9,0xf1,0xd1,0x4f,0x65,0xf5,0xef,0xb2,0x57,0xf9,0x9b,0xb8,0xfe,0x43}, 0},
+    {{0x7f,0x2d,0xe0,0xbd,0xb6,0xd9,0xa4,0x0d,0xdd,0x16,0x1f,0x0d,0xe7,0x8b,0xe4,0x2e,0xb7,0xf9,0xe9,0xf1,0xd1,0x4f,0x65,0xf5,0xef,0xb2,0x57,0xf9,0x9b,0xb8,0xfe,0x43}, 1},
+    {{0x7f,0xe9,0x27,0x92,0x7c,0x24,0x4f,0xee,0x7c,0xb4,0x8d,0x0b,0xbc,0xb8,0x0c,0x43,0x09,0xf0,0x86,0x75,0x31,0xa4,0xa0,0x9b,0x9c,0xad,0xe1,0x63,0x36,0x5e,0x93,0x95}, 0},
+    {{0x80,0x80,0x32,0x19,0x16,0xba,0x9d,0x1b,0x51,0x40,0x63,0xce,0xd7,0xff,0xe5,0x84,0xe0,0x3c,0x74,0x24,0xba,0xd1,0xb2,0x0f,0xb5,0xf9,0xad,0x53,0xe5,0xfc,0x9d,0x56}, 0},
+    {{0x80,0xf4,0x38,0x72,0xb3,0xfd,0x02,0xb5,0x46,0x48,0x41,0x4e,0x2f,0xd3,0xf3,0xb9,0xcb,0xfe,0xc1,0xa6,0x8d,0x0f,0xfc,0x94,0x3e,0xa0,0x95,0x7f,0x80,0x7d,0x8a,0xc8}, 0},
+    {{0x80,0xf4,0x38,0x72,0xb3,0xfd,0x02,0xb5,0x46,0x48,0x41,0x4e,0x2f,0xd3,0xf3,0xb9,0xcb,0xfe,0xc1,0xa6,0x8d,0x0f,0xfc,0x94,0x3e,0xa0,0x95,0x7f,0x80,0x7d,0x8a,0xc8}, 1},
+    {{0x81,0x04,0x0a,0x58,0xf9,0x78,0x31,0x14,0xe9,0x07,0x1e,0x6c,0x7d,0x99,0xa4,0xe6,0xbf,0xd9,0x7d,0xcd,0xe4,0xf8,0x00,0x93,0xbc,0xba,0xd2,0x92,0x10,0x05,0xfa,0xbd}, 0},
+    {{0x81,0x04,0x0a,0x58,0xf9,0x78,0x31,0x14,0xe9,0x07,0x1e,0x6c,0x7d,0x99,0xa4,0xe6,0xbf,0xd9,0x7d,0xcd,0xe4,0xf8,0x00,0x93,0xbc,0xba,0xd2,0x92,0x10,0x05,0xfa,0xbd}, 1},
+    {{0x81,0x20,0xc9,0xcc,0xcb,0x78,0x73,0x4b,0x18,0xa4,0x7e,0xad,0xb9,0x7b,0xd5,0xb6,0xaf,0x20,0x98,0x9e,0x07,0x0e,0x57,0xa9,0x97,0xf4,0xfd,0xba,0xff,0x61,0xea,0x35}, 0},
+    {{0x81,0x20,0xc9,0xcc,0xcb,0x78,0x73,0x4b,0x18,0xa4,0x7e,0xad,0xb9,0x7b,0xd5,0xb6,0xaf,0x20,0x98,0x9e,0x07,0x0e,0x57,0xa9,0x97,0xf4,0xfd,0xba,0xff,0x61,0xea,0x35}, 1},
+    {{0x81,0x23,0x53,0xbd,0x61,0x01,0x38,0xc4,0x2e,0x20,0x1c,0xfe,0xb9,0x8c,0x2b,0x8c,0xb3,0xf7,0x51,0x71,0x52,0x26,0xc8,0xa5,0x50,0x68,0x74,0x70,0xe7,0x7d,0x9c,0xcd}, 0},
+    {{0x81,0x23,0x53,0xbd,0x61,0x01,0x38,0xc4,0x2e,0x20,0x1c,0xfe,0xb9,0x8c,0x2b,0x8c,0xb3,0xf7,0x51,0x71,0x52,0x26,0xc8,0xa5,0x50,0x68,0x74,0x70,0xe7,0x7d,0x9c,0xcd}, 1},
+    {{0x81,0x2e,0x31,0x5f,0xfb,0x23,0x58,0x10,0x1c,0x37,0x81,0x37,0x1f,0xa6,0x63,0x38,0xf7,0x77,0x07,0xb5,0xf4,0xcb,0xff,0x48,0x05,0xd0,0x6a,0x2e,0x40,0x02,0x8a,0x70}, 0},
+    {{0x81,0x2e,0x31,0x5f,0xfb,0x23,0x58,0x10,0x1c,0x37,0x81,0x37,0x1f,0xa6,0x63,0x38,0xf7,0x77,0x07,0xb5,0xf4,0xcb,0xff,0x48,0x05,0xd0,0x6a,0x2e,0x40,0x02,0x8a,0x70}, 1},
+    {{0x81,0x56,0x83,0x15,0x7c,0x10,0xdb,0x67,0x20,0x6f,0x85,0xb9,0xfb,0xc6,0xc9,0xc8,0x62,0xad,0xc0,0xe6,0x55,0x5f,0x17,0x8f,0x4e,0x27,0x34,0xa7,0x06,0x06,0x39,0xc1}, 0},
+    {{0x81,0x56,0x83,0x15,0x7c,0x10,0xdb,0x67,0x20,0x6f,0x85,0xb9,0xfb,0xc6,0xc9,0xc8,0x62,0xad,0xc0,0xe6,0x55,0x5f,0x17,0x8f,0x4e,0x27,0x34,0xa7,0x06,0x06,0x39,0xc1}, 1},
+    {{0x81,0x6d,0x54,0x30,0x57,0x00,0xe2,0x76,0x15,0x3e,0xc1,0x04,0xb4,0x28,0x11,0xe6,0x77,0xc7,0x2e,0x50,0x45,0x60,0x7c,0x8a,0xbe,0x4b,0x5c,0xf7,0x0b,0x35,0x0e,0xd4}, 0},
+    {{0x81,0x6d,0x54,0x30,0x57,0x00,0xe2,0x76,0x15,0x3e,0xc1,0x04,0xb4,0x28,0x11,0xe6,0x77,0xc7,0x2e,0x50,0x45,0x60,0x7c,0x8a,0xbe,0x4b,0x5c,0xf7,0x0b,0x35,0x0e,0xd4}, 1},
+    {{0x81,0xda,0x54,0xd3,0x5a,0x13,0x98,0xc8,0xc6,0x7e,0x52,0xef,0xde,0x42,0x77,0xd2,0x8e,0xac,0x5a,0x2d,0x07,0xc3,0x17,0xe1,0xe6,0xb1,0xb5,0xca,0x96,0x9b,0x64,0x6f}, 0},
+    {{0x81,0xda,0x54,0xd3,0x5a,0x13,0x98,0xc8,0xc6,0x7e,0x52,0xef,0xde,0x42,0x77,0xd2,0x8e,0xac,0x5a,0x2d,0x07,0xc3,0x17,0xe1,0xe6,0xb1,0xb5,0xca,0x96,0x9b,0x64,0x6f}, 1},
+    {{0x81,0xe5,0xaa,0x05,0x92,0x4f,0xb2,0xaf,0x29,0x6d,0x68,0x5f,0x5b,0x64,0xa7,0x68,0x2c,0xbc,0xe0,0x83,0x93,0x17,0xd3,0xfc,0x02,0x46,0x05,0xeb,0xc1,0xf7,0xfb,0x4c}, 0},
+    {{0x82,0x12,0x98,0xeb,0xd8,0x5b,0xa6,0xa6,0x2b,0xcb,0xe2,0xf3,0x04,0x21,0xd8,0x69,0x33,0xe3,0xaf,0x51,0x9b,0xd9,0xc0,0x95,0x81,0x01,0x98,0x3a,0x6d,0x50,0x0c,0x2f}, 0},
+    {{0x82,0x74,0xb9,0x56,0xe9,0x81,0x32,0x0b,0x1b,0xf1,0x8b,0xd9,0xa1,0xe2,0x6e,0xc8,0x15,0xef,0x4e,0x5a,0xb3,0x60,0x5e,0xfc,0x00,0xca,0xe5,0xc5,0x40,0x8e,0x39,0x1d}, 0},
+    {{0x82,0x74,0xb9,0x56,0xe9,0x81,0x32,0x0b,0x1b,0xf1,0x8b,0xd9,0xa1,0xe2,0x6e,0xc8,0x15,0xef,0x4e,0x5a,0xb3,0x60,0x5e,0xfc,0x00,0xca,0xe5,0xc5,0x40,0x8e,0x39,0x1d}, 1},
+    {{0x82,0x8b,0xad,0x42,0x2f,0x32,0x17,0x8e,0xa3,0x1b,0x13,0x2c,0x1b,0xa3,0x2a,0xac,0xb8,0xcd,0xb8,0x0a,0x9f,0x0d,0x5b,0xb0,0xf3,0x6b,0x11,0x55,0x74,0x31,0x3f,0x0d}, 0},
+    {{0x82,0x8b,0xad,0x42,0x2f,0x32,0x17,0x8e,0xa3,0x1b,0x13,0x2c,0x1b,0xa3,0x2a,0xac,0xb8,0xcd,0xb8,0x0a,0x9f,0x0d,0x5b,0xb0,0xf3,0x6b,0x11,0x55,0x74,0x31,0x3f,0x0d}, 1},
+    {{0x82,0x8f,0x2a,0xcb,0x7e,0xfa,0x65,0x39,0xd2,0x15,0xc2,0xdd,0x7d,0x2a,0x59,0x30,0x2d,0x9f,0x6f,0xbf,0xe3,0xd0,0x72,0x59,0x75,0xd3,0xb7,0xf4,0x6f,0x2d,0x64,0x50}, 0},
+    {{0x82,0x9a,0xc6,0xdf,0xa1,0x0d,0xb3,0x3a,0x95,0xcb,0xdc,0x04,0x1c,0x09,0xac,0xe7,0x59,0x77,0xc7,0xc4,0x8f,0xae,0x38,0xbd,0xa3,0x42,0x9a,0xc8,0x22,0x5b,0x5f,0x58}, 0},
+    {{0x82,0xe6,0xc2,0xf7,0x78,0xee,0x8d,0xaa,0x6c,0x51,0x15,0x64,0xea,0xb6,0xd2,0xf9,0x3a,0x9d,0x86,0xb7,0xc2,0x11,0xa5,0x23,0xeb,0xe9,0x90,0x43,0xbd,0xb0,0x5a,0x42}, 0},
+    {{0x82,0xe6,0xc2,0xf7,0x78,0xee,0x8d,0xaa,0x6c,0x51,0x15,0x64,0xea,0xb6,0xd2,0xf9,0x3a,0x9d,0x86,0xb7,0xc2,0x11,0xa5,0x23,0xeb,0xe9,0x90,0x43,0xbd,0xb0,0x5a,0x42}, 1},
+    {{0x83,0x44,0xf1,0x2b,0xb0,0x8b,0x3f,0x46,0x3f,0x38,0xa4,0xee,0xd9,0xdc,0x37,0x5c,0x12,0x3e,0xa4,0xe1,0xb4,0x07,0x80,0x4a,0x99,0x8d,0x3a,0xb7,0xe8,0xd5,0x6a,0xf4}, 0},
+    {{0x83,0x44,0xf1,0x2b,0xb0,0x8b,0x3f,0x46,0x3f,0x38,0xa4,0xee,0xd9,0xdc,0x37,0x5c,0x12,0x3e,0xa4,0xe1,0xb4,0x07,0x80,0x4a,0x99,0x8d,0x3a,0xb7,0xe8,0xd5,0x6a,0xf4}, 1},
+    {{0x83,0x9d,0x8c,0x2d,0x4b,0x0b,0xb7,0xa3,0x1b,0x9c,0xc6,0x1a,0x53,0x42,0xce,0xb0,0xb8,0xf9,0x39,0x70,0xeb,0x32,0xfa,0x18,0x7f,0x72,0x57,0x00,0x0e,0xe0,0xfa,0xdf}, 0},
+    {{0x83,0x9d,0x8c,0x2d,0x4b,0x0b,0xb7,0xa3,0x1b,0x9c,0xc6,0x1a,0x53,0x42,0xce,0xb0,0xb8,0xf9,0x39,0x70,0xeb,0x32,0xfa,0x18,0x7f,0x72,0x57,0x00,0x0e,0xe0,0xfa,0xdf}, 1},
+    {{0x83,0xbe,0x77,0x17,0x1b,0x10,0xb2,0x91,0x27,0x36,0x96,0x24,0x9f,0x88,0x9a,0xff,0x96,0x97,0x4b,0x86,0x85,0x7f,0x6e,0x80,0xfd,0xf4,0xd3,0x8b,0x5f,0x68,0xba,0x24}, 0},
+    {{0x83,0xbe,0x77,0x17,0x1b,0x10,0xb2,0x91,0x27,0x36,0x96,0x24,0x9f,0x88,0x9a,0xff,0x96,0x97,0x4b,0x86,0x85,0x7f,0x6e,0x80,0xfd,0xf4,0xd3,0x8b,0x5f,0x68,0xba,0x24}, 1},
+    {{0x83,0xc4,0x8d,0xd3,0xd8,0xfc,0x4c,0x07,0x55,0x3f,0x39,0x75,0xd7,0x80,0xb4,0x2b,0xe2,0xe0,0x3d,0x41,0x20,0xb7,0xfb,0x94,0x2c,0x38,0xe0,0x7e,0xb1,0x5b,0x38,0x83}, 0},
+    {{0x83,0xc4,0x8d,0xd3,0xd8,0xfc,0x4c,0x07,0x55,0x3f,0x39,0x75,0xd7,0x80,0xb4,0x2b,0xe2,0xe0,0x3d,0x41,0x20,0xb7,0xfb,0x94,0x2c,0x38,0xe0,0x7e,0xb1,0x5b,0x38,0x83}, 1},
+    {{0x83,0xc7,0x9d,0xad,0x99,0xdb,0x60,0xeb,0xc6,0x57,0x37,0xe9,0x24,0x51,0xee,0x37,0xe8,0x7b,0x85,0x3f,0xad,0x0d,0xe5,0x4d,0x89,0x17,0x3e,0x19,0x73,0x9c,0xe9,0xce}, 0},
+    {{0x83,0xe9,0x49,0xee,0x62,0xea,0x2e,0xe9,0xc7,0x56,0xd9,0xce,0x1f,0xde,0xdc,0x2e,0x8e,0x61,0x69,0xe6,0x56,0xc1,0xe0,0xed,0xc5,0x4d,0x88,0xfc,0xaf,0x71,0x96,0xb4}, 0},
+    {{0x83,0xe9,0x49,0xee,0x62,0xea,0x2e,0xe9,0xc7,0x56,0xd9,0xce,0x1f,0xde,0xdc,0x2e,0x8e,0x61,0x69,0xe6,0x56,0xc1,0xe0,0xed,0xc5,0x4d,0x88,0xfc,0xaf,0x71,0x96,0xb4}, 1},
+    {{0x84,0x07,0x79,0x27,0x48,0x84,0x49,0x3e,0x70,0x85,0x7d,0x54,0xa5,0xe6,0x5c,0x87,0x71,0x71,0xd9,0xcd,0xac,0x98,0xb6,0x08,0x9f,0xbe,0x19,0x87,0xa1,0x8a,0x7d,0x79}, 0},
+    {{0x84,0x07,0x79,0x27,0x48,0x84,0x49,0x3e,0x70,0x85,0x7d,0x54,0xa5,0xe6,0x5c,0x87,0x71,0x71,0xd9,0xcd,0xac,0x98,0xb6,0x08,0x9f,0xbe,0x19,0x87,0xa1,0x8a,0x7d,0x79}, 1},
+    {{0x84,0x4d,0x81,0x94,0x0b,0xc4,0x0a,0xb7,0x39,0xe5,0xb4,0x30,0xed,0xe7,0xd3,0xc7,0xd5,0xcd,0x35,0x82,0x62,0x8a,0xf6,0x27,0x11,0x9d,0xed,0x1f,0x1b,0x42,0xba,0xc6}, 0},
+    {{0x84,0x4d,0x81,0x94,0x0b,0xc4,0x0a,0xb7,0x39,0xe5,0xb4,0x30,0xed,0xe7,0xd3,0xc7,0xd5,0xcd,0x35,0x82,0x62,0x8a,0xf6,0x27,0x11,0x9d,0xed,0x1f,0x1b,0x42,0xba,0xc6}, 1},
+    {{0x84,0xb7,0x3c,0xb6,0x4f,0xcf,0x0b,0x96,0xa5,0x78,0x0a,0x1b,0x21,0x9b,0xc5,0x94,0x5d,0x48,0x51,0x4b,0x83,0x48,0x44,0x69,0xe7,0x5b,0xa0,0x17,0x98,0x06,0xee,0x47}, 0},
+    {{0x85,0x23,0xd7,0x33,0x0b,0xda,0x83,0x5e,0xa9,0x2e,0x3f,0x75,0x46,0x61,0x5f,0xa0,0x62,0x69,0x60,0x5a,0x9a,0x24,0x86,0xfb,0x6b,0x9b,0x97,0xf2,0xc0,0x62,0xcb,0x9b}, 0},
+    {{0x85,0x23,0xd7,0x33,0x0b,0xda,0x83,0x5e,0xa9,0x2e,0x3f,0x75,0x46,0x61,0x5f,0xa0,0x62,0x69,0x60,0x5a,0x9a,0x24,0x86,0xfb,0x6b,0x9b,0x97,0xf2,0xc0,0x62,0xcb,0x9b}, 1},
+    {{0x85,0x6a,0x53,0xc3,0xc9,0x6c,0xaf,0xcd,0xc2,0x55,0xf7,0x7b,0xf7,0xf2,0x8c,0x35,0x75,0x94,0x66,0xce,0x2e,0x27,0x90,0xc2,0x31,0x69,0x58,0x04,0x8c,0xed,0x08,0x9a}, 0},
+    {{0x85,0x79,0x44,0x1a,0xde,0x2b,0xd8,0xac,0xfb,0x8a,0xb6,0xb0,0xa8,0x8e,0xb7,0x37,0xb7,0x8b,0x0a,0x08,0xda,0x77,0xed,0xe6,0xde,0x03,0xea,0x1e,0xbd,0x5d,0x7b,0xcb}, 0},
+    {{0x85,0x7a,0xa3,0x26,0x4a,0xec,0x69,0xc3,0x85,0xfe,0x8e,0x54,0xf9,0x47,0x85,0x75,0x32,0x12,0xcb,0x26,0x40,0xaf,0x3e,0xfe,0x18,0xe3,0x17,0x42,0x72,0x99,0xcc,0xbb}, 0},
+    {{0x85,0x7a,0xa3,0x26,0x4a,0xec,0x69,0xc3,0x85,0xfe,0x8e,0x54,0xf9,0x47,0x85,0x75,0x32,0x12,0xcb,0x26,0x40,0xaf,0x3e,0xfe,0x18,0xe3,0x17,0x42,0x72,0x99,0xcc,0xbb}, 1},
+    {{0x85,0x89,0x0f,0x72,0x8b,0x91,0xf1,0xff,0x6b,0x99,0x3a,0xcc,0x80,0x23,0xbe,0xeb,0x77,0xb1,0xa3,0x5e,0x18,0x16,0xc6,0x77,0x01,0x15,0x81,0xe6,0x3d,0x5d,0x36,0xa1}, 0},
+    {{0x86,0x23,0x8d,0xf1,0x1b,0x50,0x3a,0xf6,0x76,0x16,0x34,0xa7,0x4d,0x80,0x9b,0x80,0x1e,0x01,0xdd,0xed,0x97,0x2c,0x8e,0x04,0xac,0x4f,0x57,0xd4,0xb6,0xe7,0x4b,0x31}, 0},
+    {{0x86,0x23,0x8d,0xf1,0x1b,0x50,0x3a,0xf6,0x76,0x16,0x34,0xa7,0x4d,0x80,0x9b,0x80,0x1e,0x01,0xdd,0xed,0x97,0x2c,0x8e,0x04,0xac,0x4f,0x57,0xd4,0xb6,0xe7,0x4b,0x31}, 1},
+    {{0x86,0x48,0x69,0x72,0x50,0xff,0xf5,0x13,0x83,0xc3,0xfc,0xa2,0x46,0xd1,0x3d,0x26,0xd8,0x55,0x7a,0x5b,0xc5,0xed,0x70,0x16,0xd3,0xe8,0x00,0xc3,0xc8,0x78,0x2c,0x2f}, 0},
+    {{0x86,0x48,0x69,0x72,0x50,0xff,0xf5,0x13,0x83,0xc3,0xfc,0xa2,0x46,0xd1,0x3d,0x26,0xd8,0x55,0x7a,0x5b,0xc5,0xed,0x70,0x16,0xd3,0xe8,0x00,0xc3,0xc8,0x78,0x2c,0x2f}, 1},
+    {{0x87,0x08,0xc6,0xba,0x95,0x31,0x21,0x3f,0x7f,0x3a,0x64,0x32,0x56,0x43,0x44,0x06,0x6f,0xcd,0x8c,0x00,0xdc,0x40,0x1b,0x12,0xbe,0x63,0xe2,0x74,0x23,0x89,0x88,0x38}, 0},
+    {{0x88,0xa5,0x9c,0xc5,0xca,0x7d,0xa8,0x18,0xbe,0x0c,0xb2,0x50,0x4e,0xab,0xb1,0x8e,0xdc,0xe5,0x77,0x4a,0x88,0x9b,0xa0,0xa8,0xc9,0xfd,0xcd,0xf8,0x83,0x62,0xcd,0xb3}, 0},
+    {{0x88,0xa5,0x9c,0xc5,0xca,0x7d,0xa8,0x18,0xbe,0x0c,0xb2,0x50,0x4e,0xab,0xb1,0x8e,0xdc,0xe5,0x77,0x4a,0x88,0x9b,0xa0,0xa8,0xc9,0xfd,0xcd,0xf8,0x83,0x62,0xcd,0xb3}, 1},
+    {{0x89,0x26,0x31,0xd8,0x45,0xe8,0x48,0x0b,0xfe,0x11,0x2d,0xa0,0x89,0x45,0xb1,0xcd,0xc5,0x41,0xc9,0x55,0x32,0x8a,0xf1,0x26,0x30,0x61,0xbb,0x09,0xc8,0x7a,0xd2,0x16}, 0},
+    {{0x89,0x2c,0xb6,0x0d,0xbc,0x98,0x17,0xd4,0x02,0x2f,0x56,0x1f,0xf5,0xe9,0x5d,0x22,0xdc,0x88,0xca,0xde,0x5e,0xee,0x1f,0x28,0xd8,0x81,0xb4,0xab,0x38,0x3f,0x3e,0x5b}, 0},
+    {{0x89,0x2c,0xb6,0x0d,0xbc,0x98,0x17,0xd4,0x02,0x2f,0x56,0x1f,0xf5,0xe9,0x5d,0x22,0xdc,0x88,0xca,0xde,0x5e,0xee,0x1f,0x28,0xd8,0x81,0xb4,0xab,0x38,0x3f,0x3e,0x5b}, 1},
+    {{0x8a,0x3e,0x49,0x09,0x1a,0x0d,0x6f,0xf0,0x8c,0x31,0xf7,0x54,0x80,0x17,0xd7,0xbf,0xef,0xb4,0x77,0x44,0x88,0x08,0xf0,0x6e,0x4d,0x8d,0xe5,0x06,0x8d,0x8a,0xe8,0x86}, 0},
+    {{0x8a,0x4b,0x25,0xf9,0xda,0xab,0xb5,0xee,0x01,0x82,0x98,0xee,0x9e,0x7f,0x9b,0x2f,0x3d,0x28,0xf4,0x3d,0xd4,0x8c,0x61,0xfe,0x22,0x9c,0x7d,0xee,0x90,0xa1,0xd3,0xb6}, 0},
+    {{0x8a,0x4b,0x25,0xf9,0xda,0xab,0xb5,0xee,0x01,0x82,0x98,0xee,0x9e,0x7f,0x9b,0x2f,0x3d,0x28,0xf4,0x3d,0xd4,0x8c,0x61,0xfe,0x22,0x9c,0x7d,0xee,0x90,0xa1,0xd3,0xb6}, 1},
+    {{0x8a,0xd1,0x3e,0xac,0x44,0x21,0xb7,0x20,0x61,0x5b,0x49,0x27,0x58,0xdd,0x74,0x66,0x5f,0xa6,0x9a,0x94,0xfd,0xcc,0xf2,0x12,0x0f,0x2f,0xdc,0x20,0xd8,0x0e,0xc7,0xdb}, 0},
+    {{0x8a,0xd1,0x3e,0xac,0x44,0x21,0xb7,0x20,0x61,0x5b,0x49,0x27,0x58,0xdd,0x74,0x66,0x5f,0xa6,0x9a,0x94,0xfd,0xcc,0xf2,0x12,0x0f,0x2f,0xdc,0x20,0xd8,0x0e,0xc7,0xdb}, 1},
+    {{0x8b,0x7b,0x41,0xa2,0x47,0x17,0x9a,0xf6,0x46,0xa8,0x55,0x95,0xa9,0xb1,0xb2,0x2f,0x66,0x5d,0xee,0x32,0x52,0x34,0x40,0x7b,0x11,0xaa,0x55,0x59,0x39,0x5f,0xf6,0xe2}, 0},
+    {{0x8b,0x7b,0x41,0xa2,0x47,0x17,0x9a,0xf6,0x46,0xa8,0x55,0x95,0xa9,0xb1,0xb2,0x2f,0x66,0x5d,0xee,0x32,0x52,0x34,0x40,0x7b,0x11,0xaa,0x55,0x59,0x39,0x5f,0xf6,0xe2}, 1},
+    {{0x8b,0x9d,0xb4,0xdd,0xbf,0xef,0xc5,0xc6,0x18,0x2a,0xba,0xd9,0xd0,0x07,0x7c,0x14,0x5c,0x64,0x70,0xbf,0x8c,0xbc,0x8f,0x4f,0x28,0xb0,0x4c,0xf1,0xbf,0x16,0x2d,0xfe}, 0},
+    {{0x8b,0x9d,0xb4,0xdd,0xbf,0xef,0xc5,0xc6,0x18,0x2a,0xba,0xd9,0xd0,0x07,0x7c,0x14,0x5c,0x64,0x70,0xbf,0x8c,0xbc,0x8f,0x4f,0x28,0xb0,0x4c,0xf1,0xbf,0x16,0x2d,0xfe}, 1},
+    {{0x8c,0x22,0x1f,0xac,0x62,0x81,0x4e,0x05,0x80,0xa8,0x5e,0xa9,0xef,0x9c,0xf1,0x53,0xb9,0x40,0x55,0x63,0xd6,0x0b,0xff,0x25,0x2d,0x49,0x58,0xb0,0xa5,0x87,0x02,0xce}, 0},
+    {{0x8c,0x29,0xc3,0x64,0xfd,0x18,0xf2,0x09,0x44,0xcd,0x97,0xc9,0x32,0xde,0x53,0xe7,0xf4,0x87,0xcc,0xa5,0x91,0x96,0xc1,0x92,0xa0,0xbd,0x06,0xd5,0x5d,0x66,0x95,0x6b}, 0},
+    {{0x8c,0x29,0xc3,0x64,0xfd,0x18,0xf2,0x09,0x44,0xcd,0x97,0xc9,0x32,0xde,0x53,0xe7,0xf4,0x87,0xcc,0xa5,0x91,0x96,0xc1,0x92,0xa0,0xbd,0x06,0xd5,0x5d,0x66,0x95,0x6b}, 1},
+    {{0x8c,0x3b,0xed,0x3a,0x17,0xb8,0x8d,0x41,0xe9,0x69,0x17,0x0b,0x5d,0x9e,0x52,0x8a,0x4b,0x6e,0x16,0x38,0x8c,0x8e,0xe6,0xb5,0x02,0x55,0x84,0x2d,0x80,0xd4,0x3a,0x26}, 0},
+    {{0x8c,0x3b,0xed,0x3a,0x17,0xb8,0x8d,0x41,0xe9,0x69,0x17,0x0b,0x5d,0x9e,0x52,0x8a,0x4b,0x6e,0x16,0x38,0x8c,0x8e,0xe6,0xb5,0x02,0x55,0x84,0x2d,0x80,0xd4,0x3a,0x26}, 1},
+    {{0x8c,0xfb,0x67,0xfd,0xc2,0x17,0x8d,0xa1,0x2b,0x25,0xe0,0x05,0x66,0xb5,0xce,0x3b,0x78,0x59,0x2d,0x3f,0xef,0xa4,0x10,0x0f,0x35,0xaf,0x41,0x9b,0xd4,0x43,0xc4,0xc6}, 0},
+    {{0x8c,0xfb,0x67,0xfd,0xc2,0x17,0x8d,0xa1,0x2b,0x25,0xe0,0x05,0x66,0xb5,0xce,0x3b,0x78,0x59,0x2d,0x3f,0xef,0xa4,0x10,0x0f,0x35,0xaf,0x41,0x9b,0xd4,0x43,0xc4,0xc6}, 1},
+    {{0x8d,0x0d,0x1f,0x67,0x40,0x53,0x7d,0x12,0xb9,0x5a,0x89,0xdd,0x77,0x86,0xc6,0xfd,0x39,0x96,0x0f,0x48,0x22,0x5f,0x09,0xc7,0xd9,0x87,0xa5,0x7a,0x52,0x91,0xde,0xdd}, 0},
+    {{0x8d,0x0d,0x1f,0x67,0x40,0x53,0x7d,0x12,0xb9,0x5a,0x89,0xdd,0x77,0x86,0xc6,0xfd,0x39,0x96,0x0f,0x48,0x22,0x5f,0x09,0xc7,0xd9,0x87,0xa5,0x7a,0x52,0x91,0xde,0xdd}, 1},
+    {{0x8d,0x4a,0xba,0xf3,0xdb,0x07,0xee,0xa1,0x26,0x62,0x59,0x63,0xb9,0x32,0x25,0x30,0xfe,0x07,0x62,0x9f,0x80,0xa4,0x42,0x2f,0xac,0x69,0x6c,0x11,0xea,0x71,0xd7,0x0d}, 0},
+    {{0x8d,0x4a,0xba,0xf3,0xdb,0x07,0xee,0xa1,0x26,0x62,0x59,0x63,0xb9,0x32,0x25,0x30,0xfe,0x07,0x62,0x9f,0x80,0xa4,0x42,0x2f,0xac,0x69,0x6c,0x11,0xea,0x71,0xd7,0x0d}, 1},
+    {{0x8d,0xbc,0xf6,0xcf,0x12,0x1b,0x7e,0x3e,0xe4,0x47,0x84,0xff,0x6f,0x54,0x59,0x8e,0xb8,0x82,0xb4,0xc2,0xde,0xfa,0xa4,0x75,0xb8,0x8e,0x01,0xa5,0xc3,0xe1,0x85,0xe2}, 0},
+    {{0x8d,0xc3,0xe5,0x9a,0xe1,0x6e,0x02,0x63,0xb7,0x29,0x1e,0x73,0x01,0xbb,0x3a,0xa6,0x45,0x3d,0xa5,0x0e,0x52,0x46,0x30,0x71,0x91,0xad,0x4f,0x9a,0x4b,0xca,0xd9,0x5f}, 0},
+    {{0x8d,0xc3,0xe5,0x9a,0xe1,0x6e,0x02,0x63,0xb7,0x29,0x1e,0x73,0x01,0xbb,0x3a,0xa6,0x45,0x3d,0xa5,0x0e,0x52,0x46,0x30,0x71,0x91,0xad,0x4f,0x9a,0x4b,0xca,0xd9,0x5f}, 1},
+    {{0x8d,0xc3,0xec,0x02,0xfd,0xcc,0x7a,0xcc,0x5f,0x52,0x6d,0x11,0x2a,0xac,0x64,0xc7,0xf8,0x3b,0xd7,0xae,0xab,0xad,0xb7,0xf8,0x4d,0x07,0x08,0xd1,0x8a,0x83,0xf2,0x11}, 0},
+    {{0x8e,0x43,0xc3,0x80,0xad,0x3b,0xf8,0x29,0x58,0x4e,0x67,0xf7,0x6a,0x62,0xba,0x46,0x79,0x1b,0x36,0x7e,0x51,0x57,0x30,0x27,0x05,0xc1,0xae,0x93,0x03,0xa5,0x5b,0x58}, 0},
+    {{0x8e,0x55,0xeb,0x77,0x54,0x18,0x03,0x16,0x00,0x8d,0xce,0x1a,0x1e,0xc4,0x56,0x5e,0x78,0xfb,0x99,0xf9,0xa5,0x2c,0xcf,0x11,0x03,0x4c,0x32,0x91,0x6d,0x2b,0x1b,0xa0}, 0},
+    {{0x8e,0x55,0xeb,0x77,0x54,0x18,0x03,0x16,0x00,0x8d,0xce,0x1a,0x1e,0xc4,0x56,0x5e,0x78,0xfb,0x99,0xf9,0xa5,0x2c,0xcf,0x11,0x03,0x4c,0x32,0x91,0x6d,0x2b,0x1b,0xa0}, 1},
+    {{0x8e,0xab,0xaa,0x1e,0x12,0x08,0x18,0x8b,0x88,0x4f,0x87,0x5c,0xfd,0xc5,0xa9,0x3e,0x3c,0xb7,0x35,0xad,0xa4,0x51,0xc8,0x79,0x94,0xfa,0x52,0xe8,0x68,0x12,0xf0,0x40}, 0},
+    {{0x8e,0xcb,0x1f,0x5d,0xca,0xb6,0x2b,0x51,0x7b,0x01,0xd7,0x94,0x05,0x17,0x08,0x1a,0xef,0x7b,0xde,0x96,0xe4,0xef,0x98,0x08,0x47,0x5b,0x07,0xb5,0xd3,0x41,0x2c,0xfa}, 0},
+    {{0x8e,0xcb,0x1f,0x5d,0xca,0xb6,0x2b,0x51,0x7b,0x01,0xd7,0x94,0x05,0x17,0x08,0x1a,0xef,0x7b,0xde,0x96,0xe4,0xef,0x98,0x08,0x47,0x5b,0x07,0xb5,0xd3,0x41,0x2c,0xfa}, 1},
+    {{0x8f,0x00,0xcd,0xd4,0x9b,0x60,0xb4,0x93,0xa0,0x99,0x1f,0xe0,0x5d,0x73,0xaf,0x8b,0x8a,0x94,0x4e,0xe4,0x65,0x87,0x33,0x50,0xed,0x25,0xff,0x62,0x1e,0x65,0xf6,0x15}, 0},
+    {{0x8f,0x33,0x51,0x3d,0x37,0x8f,0x04,0xf2,0xc3,0x9c,0xe3,0xa3,0x1e,0xce,0x9f,0xb0,0x6c,0x57,0x66,0x78,0x2e,0x15,0x30,0x67,0x0b,0x9b,0xda,0xdb,0x2f,0xd6,0x64,0x1c}, 0},
+    {{0x8f,0x33,0x51,0x3d,0x37,0x8f,0x04,0xf2,0xc3,0x9c,0xe3,0xa3,0x1e,0xce,0x9f,0xb0,0x6c,0x57,0x66,0x78,0x2e,0x15,0x30,0x67,0x0b,0x9b,0xda,0xdb,0x2f,0xd6,0x64,0x1c}, 1},
+    {{0x8f,0x50,0xd4,0x2e,0x11,0xe1,0x18,0x29,0x39,0x21,0x3f,0x9f,0x08,0x85,0xec,0xf1,0x2f,0x81,0xbb,0x0a,0x74,0x23,0x8b,0x76,0x1d,0x28,0xd5,0xa3,0xdd,0x77,0x43,0xdb}, 0},
+    {{0x8f,0x50,0xd4,0x2e,0x11,0xe1,0x18,0x29,0x39,0x21,0x3f,0x9f,0x08,0x85,0xec,0xf1,0x2f,0x81,0xbb,0x0a,0x74,0x23,0x8b,0x76,0x1d,0x28,0xd5,0xa3,0xdd,0x77,0x43,0xdb}, 1},
+    {{0x8f,0x8b,0x2e,0x83,0x4b,0x40,0x87,0xae,0x90,0x01,0xb3,0xe4,0x89,0x22,0x9b,0x5d,0xd2,0x3c,0x42,0xac,0xa2,0xaa,0x73,0x59,0x1a,0xa8,0x74,0xe3,0xe4,0x7c,0x97,0x4e}, 0},
+    {{0x8f,0x92,0x10,0x30,0xbe,0x10,0x67,0x0d,0xd7,0x83,0x04,0x6a,0x20,0x13,0x6c,0xf5,0x45,0xc4,0xdd,0x49,0x19,0x28,0x19,0x66,0x8d,0xc6,0x78,0xd9,0xb2,0xf0,0x54,0xdb}, 0},
+    {{0x8f,0x92,0x10,0x30,0xbe,0x10,0x67,0x0d,0xd7,0x83,0x04,0x6a,0x20,0x13,0x6c,0xf5,0x45,0xc4,0xdd,0x49,0x19,0x28,0x19,0x66,0x8d,0xc6,0x78,0xd9,0xb2,0xf0,0x54,0xdb}, 1},
+    {{0x90,0x1d,0x5e,0xcd,0x02,0x41,0xfc,0x76,0xbe,0x6e,0x3b,0xaf,0x82,0xf1,0xd1,0x89,0xaa,0xfa,0xc7,0x5d,0xab,0xbc,0x9c,0xc3,0x3b,0x16,0x94,0x17,0xcc,0xb9,0x74,0xb7}, 0},
+    {{0x90,0x1d,0x5e,0xcd,0x02,0x41,0xfc,0x76,0xbe,0x6e,0x3b,0xaf,0x82,0xf1,0xd1,0x89,0xaa,0xfa,0xc7,0x5d,0xab,0xbc,0x9c,0xc3,0x3b,0x16,0x94,0x17,0xcc,0xb9,0x74,0xb7}, 1},
+    {{0x90,0x99,0xd6,0xc3,0x46,0x68,0x6f,0xf9,0x74,0x25,0xcc,0x61,0xd5,0x7e,0x51,0xe9,0x0a,0x2c,0xe2,0xeb,0x6b,0x3a,0x21,0x06,0x25,0xd8,0xad,0xe2,0xe2,0xae,0x2c,0x1e}, 0},
+    {{0x90,0xf9,0x1a,0x55,0x55,0x69,0xb0,0x3f,0xf3,0xdf,0xbb,0x95,0xbe,0xb1,0xfb,0x3c,0x1d,0xd9,0x9a,0xd5,0x1e,0x8b,0x11,0x60,0xee,0x71,0xbd,0xe1,0x8f,0x91,0xde,0xd7}, 0},
+    {{0x90,0xf9,0x1a,0x55,0x55,0x69,0xb0,0x3f,0xf3,0xdf,0xbb,0x95,0xbe,0xb1,0xfb,0x3c,0x1d,0xd9,0x9a,0xd5,0x1e,0x8b,0x11,0x60,0xee,0x71,0xbd,0xe1,0x8f,0x91,0xde,0xd7}, 1},
+    {{0x91,0x3f,0xdb,0x71,0x39,0x71,0x89,0x0f,0x73,0x98,0xb1,0xce,0x08,0xe3,0x8f,0xe7,0xbf,0x29,0x43,0x71,0x40,0x50,0x21,0x45,0xd8,0x4b,0x99,0x1f,0xc3,0xd6,0x2b,0x58}, 0},
+    {{0x91,0x3f,0xdb,0x71,0x39,0x71,0x89,0x0f,0x73,0x98,0xb1,0xce,0x08,0xe3,0x8f,0xe7,0xbf,0x29,0x43,0x71,0x40,0x50,0x21,0x45,0xd8,0x4b,0x99,0x1f,0xc3,0xd6,0x2b,0x58}, 1},
+    {{0x91,0x9f,0x50,0x54,0xab,0x22,0xae,0x85,0x03,0x9b,0xf4,0xc8,0xbf,0xfb,0xc5,0x21,0x2b,0xbb,0x6a,0x9f,0x30,0x08,0x52,0xb5,0xf7,0x21,0xb9,0x06,0x90,0x89,0x2d,0x7f}, 0},
+    {{0x91,0xb8,0x09,0x45,0x34,0xad,0xa4,0xda,0x2d,0xb4,0x66,0x97,0xcd,0x4c,0x85,0xfb,0x9c,0xcf,0xbd,0xc3,0x79,0x25,0x9e,0x40,0x3c,0xda,0x10,0x93,0x09,0x08,0x1a,0x07}, 0},
+    {{0x91,0xc6,0xfc,0x44,0xc0,0xfb,0x54,0x55,0x1d,0x94,0x67,0xc1,0x40,0xfe,0xed,0x90,0x7d,0x2c,0x3c,0x83,0x7f,0x51,0x45,0x72,0xe8,0xbc,0xc6,0x67,0x10,0x36,0x78,0x98}, 0},
+    {{0x91,0xc6,0xfc,0x44,0xc0,0xfb,0x54,0x55,0x1d,0x94,0x67,0xc1,0x40,0xfe,0xed,0x90,0x7d,0x2c,0x3c,0x83,0x7f,0x51,0x45,0x72,0xe8,0xbc,0xc6,0x67,0x10,0x36,0x78,0x98}, 1},
+    {{0x92,0x4e,0x08,0x58,0x99,0x24,0x96,0x6f,0x1b,0x12,0x17,0xd8,0x6b,0x10,0xc1,0x9c,0x6f,0xe0,0xd2,0x64,0x31,0x5f,0x9d,0x3e,0x44,0x1a,0x9b,0x1d,0xdf,0x6f,0xea,0xdd}, 0},
+    {{0x92,0x4e,0x08,0x58,0x99,0x24,0x96,0x6f,0x1b,0x12,0x17,0xd8,0x6b,0x10,0xc1,0x9c,0x6f,0xe0,0xd2,0x64,0x31,0x5f,0x9d,0x3e,0x44,0x1a,0x9b,0x1d,0xdf,0x6f,0xea,0xdd}, 1},
+    {{0x92,0xd1,0x26,0x43,0x4e,0x30,0x6f,0xda,0x4e,0x9c,0x15,0xf6,0x33,0xb9,0x49,0x79,0x92,0x5b,0xd0,0xe1,0x84,0x6f,0xa5,0x9f,0x1d,0xa5,0x45,0x96,0x5d,0x11,0x88,0x0b}, 0},
+    {{0x92,0xef,0x22,0xdb,0xdc,0xaa,0x19,0x4b,0xf4,0xfc,0xf8,0xe3,0x83,0x47,0x7f,0x52,0x74,0x04,0xe5,0xdc,0x6d,0x26,0x32,0x72,0xa0,0x16,0xeb,0x2b,0x50,0x67,0x00,0xac}, 0},
+    {{0x92,0xef,0x22,0xdb,0xdc,0xaa,0x19,0x4b,0xf4,0xfc,0xf8,0xe3,0x83,0x47,0x7f,0x52,0x74,0x04,0xe5,0xdc,0x6d,0x26,0x32,0x72,0xa0,0x16,0xeb,0x2b,0x50,0x67,0x00,0xac}, 1},
+    {{0x93,0x52,0x24,0xdd,0xed,0x21,0xcf,0x21,0xd7,0x86,0xa6,0x88,0x93,0x71,0x87,0x20,0x95,0x3b,0x37,0xd5,0x74,0xfc,0xdb,0xe9,0x44,0x60,0xae,0x17,0xff,0xf9,0xd2,0xfb}, 0},
+    {{0x93,0x9e,0xad,0x82,0xb7,0x7f,0x88,0xac,0xb7,0xa5,0xec,0x41,0x13,0x41,0x1c,0x19,0xd2,0x99,0x48,0x20,0x72,0xe5,0x24,0x1c,0x2b,0xb0,0x2b,0xf0,0x59,0xa5,0xb1,0xd3}, 0},
+    {{0x94,0x25,0x97,0xf2,0x87,0x3d,0x90,0xf3,0xf1,0xfe,0xe8,0xe3,0xa3,0x0a,0xf5,0x01,0xf4,0xd1,0x32,0xbe,0xc8,0xd7,0x4b,0x35,0xa5,0xfe,0x8e,0x07,0xe0,0x1b,0x1d,0xd2}, 0},
+    {{0x94,0x25,0x97,0xf2,0x87,0x3d,0x90,0xf3,0xf1,0xfe,0xe8,0xe3,0xa3,0x0a,0xf5,0x01,0xf4,0xd1,0x32,0xbe,0xc8,0xd7,0x4b,0x35,0xa5,0xfe,0x8e,0x07,0xe0,0x1b,0x1d,0xd2}, 1},
+    {{0x94,0x40,0x54,0x82,0x43,0x32,0xe2,0x4d,0x6c,0xb5,0x75,0x20,0xd5,0xe0,0x25,0x91,0xdb,0xb5,0x1e,0xe3,0xf1,0x41,0xf7,0x48,0x76,0xad,0x4e,0xa3,0x88,0x20,0x0a,0xa5}, 0},
+    {{0x94,0x40,0x54,0x82,0x43,0x32,0xe2,0x4d,0x6c,0xb5,0x75,0x20,0xd5,0xe0,0x25,0x91,0xdb,0xb5,0x1e,0xe3,0xf1,0x41,0xf7,0x48,0x76,0xad,0x4e,0xa3,0x88,0x20,0x0a,0xa5}, 1},
+    {{0x94,0x6d,0x9c,0xb0,0xb4,0x0d,0x04,0x0a,0xb9,0x7e,0xff,0x95,0x1f,0xff,0x3e,0x26,0x65,0xdc,0x28,0x26,0x5c,0x37,0xfc,0x7c,0x0b,0x10,0x6f,0x5e,0x91,0x37,0x19,0x28}, 0},
+    {{0x94,0x73,0xfa,0xad,0xba,0x9b,0x22,0x0a,0xe2,0xec,0xdc,0xae,0x22,0xc5,0x3b,0xac,0xc9,0xb1,0xf4,0x2e,0xef,0x12,0x4e,0x57,0x6d,0xd7,0x1c,0x8f,0x25,0xb2,0x7f,0xb6}, 0},
+    {{0x94,0x8c,0x72,0x5d,0xc9,0x55,0xdd,0xa7,0x88,0xe7,0xfd,0x0e,0x09,0x87,0xa2,0x85,0xc2,0x5c,0xf9,0x7a,0xee,0x94,0x0d,0x45,0x1a,0x5a,0xf5,0xbe,0xf6,0x15,0x8c,0x23}, 1},
+    {{0x94,0x8c,0x72,0x5d,0xc9,0x55,0xdd,0xa7,0x88,0xe7,0xfd,0x0e,0x09,0x87,0xa2,0x85,0xc2,0x5c,0xf9,0x7a,0xee,0x94,0x0d,0x45,0x1a,0x5a,0xf5,0xbe,0xf6,0x15,0x8c,0x23}, 2},
+    {{0x94,0x98,0xa6,0x1a,0xb9,0x13,0x20,0x5b,0x6c,0x16,0x0b,0x8c,0x8c,0x39,0xd8,0xf8,0xbb,0x72,0x4c,0xa7,0xe0,0xf5,0xf3,0x26,0x5c,0xc0,0xa1,0x88,0x58,0xb4,0x4b,0xfd}, 0},
+    {{0x94,0x98,0xa6,0x1a,0xb9,0x13,0x20,0x5b,0x6c,0x16,0x0b,0x8c,0x8c,0x39,0xd8,0xf8,0xbb,0x72,0x4c,0xa7,0xe0,0xf5,0xf3,0x26,0x5c,0xc0,0xa1,0x88,0x58,0xb4,0x4b,0xfd}, 1},
+    {{0x94,0xac,0x13,0x28,0x1c,0x30,0xa1,0xe3,0xb0,0x09,0x85,0x1f,0x34,0xa8,0x44,0xd2,0x66,0xec,0xf1,0x4c,0x5d,0x50,0x8b,0x06,0x1d,0x54,0xc5,0xcc,0x26,0x19,0x91,0x86}, 0},
+    {{0x94,0xac,0x13,0x28,0x1c,0x30,0xa1,0xe3,0xb0,0x09,0x85,0x1f,0x34,0xa8,0x44,0xd2,0x66,0xec,0xf1,0x4c,0x5d,0x50,0x8b,0x06,0x1d,0x54,0xc5,0xcc,0x26,0x19,0x91,0x86}, 1},
+    {{0x94,0xca,0x3b,0x5d,0x91,0xb4,0x9f,0xe3,0xad,0x2f,0xa6,0x60,0x2f,0x81,0x2f,0xd2,0xb0,0x7d,0x02,0xb5,0x90,0xf8,0x7f,0xf6,0xb0,0x37,0x42,0x1a,0x36,0x32,0xf6,0xe0}, 0},
+    {{0x94,0xca,0x3b,0x5d,0x91,0xb4,0x9f,0xe3,0xad,0x2f,0xa6,0x60,0x2f,0x81,0x2f,0xd2,0xb0,0x7d,0x02,0xb5,0x90,0xf8,0x7f,0xf6,0xb0,0x37,0x42,0x1a,0x36,0x32,0xf6,0xe0}, 1},
+    {{0x94,0xdf,0x3e,0x0f,0x90,0x1d,0x9d,0x9e,0x44,0x46,0x64,0xfd,0x59,0x49,0x14,0x26,0xc3,0xf2,0xe7,0x42,0x9b,0x18,0x17,0x64,0x33,0xd5,0xd7,0x36,0xca,0x2b,0xed,0xa8}, 0},
+    {{0x94,0xdf,0x3e,0x0f,0x90,0x1d,0x9d,0x9e,0x44,0x46,0x64,0xfd,0x59,0x49,0x14,0x26,0xc3,0xf2,0xe7,0x42,0x9b,0x18,0x17,0x64,0x33,0xd5,0xd7,0x36,0xca,0x2b,0xed,0xa8}, 1},
+    {{0x94,0xf6,0x6c,0xaa,0x17,0x4d,0x18,0xf3,0x95,0x84,0x7e,0xe6,0x71,0xdd,0x35,0xc9,0x89,0xc1,0x3e,0x0b,0xd5,0xff,0x53,0x63,0xa3,0xe6,0x70,0x3d,0x5a,0x64,0x9c,0x9e}, 0},
+    {{0x95,0x03,0xc1,0x44,0xab,0x9b,0x76,0x2c,0x40,0x88,0x6c,0x2f,0xbc,0xf9,0x13,0xf8,0xe6,0x0b,0x03,0x4a,0xd3,0x3d,0xf5,0x77,0x39,0xf4,0xb5,0x94,0x52,0x66,0x7e,0x21}, 0},
+    {{0x95,0x03,0xc1,0x44,0xab,0x9b,0x76,0x2c,0x40,0x88,0x6c,0x2f,0xbc,0xf9,0x13,0xf8,0xe6,0x0b,0x03,0x4a,0xd3,0x3d,0xf5,0x77,0x39,0xf4,0xb5,0x94,0x52,0x66,0x7e,0x21}, 1},
+    {{0x95,0x59,0xab,0x75,0x99,0xce,0xc8,0xc4,0xc6,0xa2,0xc2,0xfa,0xf9,0xa2,0xdb,0xbf,0x87,0xe0,0xef,0x6b,0x02,0x57,0xb3,0xe5,0x89,0x1a,0x33,0x3a,0xa7,0x3b,0xbd,0x99}, 0},
+    {{0x95,0x59,0xab,0x75,0x99,0xce,0xc8,0xc4,0xc6,0xa2,0xc2,0xfa,0xf9,0xa2,0xdb,0xbf,0x87,0xe0,0xef,0x6b,0x02,0x57,0xb3,0xe5,0x89,0x1a,0x33,0x3a,0xa7,0x3b,0xbd,0x99}, 1},
+    {{0x95,0xcd,0x87,0xc7,0xc9,0xe7,0xab,0x32,0x06,0x1a,0xb2,0x9e,0x6a,0x51,0xf3,0x60,0x86,0x2e,0x4a,0x27,0x60,0x05,0x62,0x90,0xe5,0xd7,0x11,0x8a,0xec,0x86,0x6d,0xd7}, 0},
+    {{0x95,0xcd,0x87,0xc7,0xc9,0xe7,0xab,0x32,0x06,0x1a,0xb2,0x9e,0x6a,0x51,0xf3,0x60,0x86,0x2e,0x4a,0x27,0x60,0x05,0x62,0x90,0xe5,0xd7,0x11,0x8a,0xec,0x86,0x6d,0xd7}, 1},
+    {{0x95,0xee,0x8c,0xde,0xca,0x7f,0x47,0x9c,0x4b,0xcb,0xcf,0x23,0xcb,0x04,0x79,0xf9,0x04,0x75,0xee,0x51,0x84,0xec,0xff,0x83,0xde,0x5f,0xbe,0x8c,0x53,0x5e,0x50,0x9f}, 0},
+    {{0x95,0xee,0x8c,0xde,0xca,0x7f,0x47,0x9c,0x4b,0xcb,0xcf,0x23,0xcb,0x04,0x79,0xf9,0x04,0x75,0xee,0x51,0x84,0xec,0xff,0x83,0xde,0x5f,0xbe,0x8c,0x53,0x5e,0x50,0x9f}, 1},
+    {{0x96,0x22,0x0e,0x04,0x8e,0x7d,0xed,0xca,0xe7,0x85,0x02,0xfb,0xd8,0x18,0xd6,0x51,0x3e,0xd5,0x9b,0x5a,0xc2,0x66,0xb6,0x04,0x5c,0xe5,0x40,0x45,0x00,0x14,0x6e,0xb5}, 0},
+    {{0x96,0x22,0x0e,0x04,0x8e,0x7d,0xed,0xca,0xe7,0x85,0x02,0xfb,0xd8,0x18,0xd6,0x51,0x3e,0xd5,0x9b,0x5a,0xc2,0x66,0xb6,0x04,0x5c,0xe5,0x40,0x45,0x00,0x14,0x6e,0xb5}, 1},
+    {{0x96,0x82,0x19,0x56,0xcb,0x7c,0xaa,0xb0,0x1e,0x8a,0x04,0x0d,0x14,0x63,0x81,0xc0,0xa3,0xd3,0x1f,0x9b,0x12,0xe4,0x6e,0x68,0x99,0xaf,0x07,0xb2,0x89,0x81,0x9c,0x25}, 0},
+    {{0x96,0xf4,0x5c,0xe7,0xb1,0x4e,0x37,0xef,0xb4,0xa9,0xd7,0xd1,0x8d,0xb6,0x44,0xd1,0x4a,0x5b,0x37,0x3f,0x89,0x71,0x5d,0x1d,0x12,0x9d,0xe2,0x97,0x6e,0xb2,0x61,0x86}, 0},
+    {{0x97,0x7a,0xe9,0x7a,0xdf,0x5c,0xf7,0xb4,0x8a,0xc5,0xc7,0xfe,0x61,0x45,0xa3,0xa3,0x48,0xf4,0xbc,0x27,0x58,0xf8,0xd1,0x94,0x84,0x5c,0x2a,0xe3,0x42,0x4d,0xa2,0xa6}, 0},
+    {{0x97,0x7a,0xe9,0x7a,0xdf,0x5c,0xf7,0xb4,0x8a,0xc5,0xc7,0xfe,0x61,0x45,0xa3,0xa3,0x48,0xf4,0xbc,0x27,0x58,0xf8,0xd1,0x94,0x84,0x5c,0x2a,0xe3,0x42,0x4d,0xa2,0xa6}, 1},
+    {{0x97,0xc6,0x13,0x64,0x41,0x6e,0x91,0xa2,0x2d,0xad,0x6d,0x7f,0x49,0xd4,0x83,0x25,0x96,0x67,0x1c,0x32,0xe2,0x04,0xdd,0x27,0xd8,0xe1,0xf8,0x0c,0xcd,0x97,0xc6,0xfc}, 0},
+    {{0x97,0xc6,0x13,0x64,0x41,0x6e,0x91,0xa2,0x2d,0xad,0x6d,0x7f,0x49,0xd4,0x83,0x25,0x96,0x67,0x1c,0x32,0xe2,0x04,0xdd,0x27,0xd8,0xe1,0xf8,0x0c,0xcd,0x97,0xc6,0xfc}, 1},
+    {{0x97,0xc6,0xbe,0xff,0xeb,0xa9,0xa0,0x80,0x5a,0xf2,0xb7,0x5e,0x18,0x3b,0x68,0x0d,0xde,0xb7,0x11,0x7d,0x7d,0x31,0x08,0x0c,0x6d,0x72,0x84,0xbe,0xa4,0xe8,0x50,0x87}, 0},
+    {{0x97,0xc6,0xbe,0xff,0xeb,0xa9,0xa0,0x80,0x5a,0xf2,0xb7,0x5e,0x18,0x3b,0x68,0x0d,0xde,0xb7,0x11,0x7d,0x7d,0x31,0x08,0x0c,0x6d,0x72,0x84,0xbe,0xa4,0xe8,0x50,0x87}, 1},
+    {{0x97,0xe3,0x92,0xae,0x91,0xd2,0x85,0x19,0xb3,0x89,0xe5,0xbb,0x46,0x8b,0x49,0xc6,0x3e,0xc6,0x68,0x14,0x67,0xcd,0x9b,0x33,0x1a,0x44,0xbe,0x82,0x0a,0x06,0x2c,0x63}, 0},
+    {{0x97,0xee,0x96,0x5c,0x60,0x89,0x6d,0x9c,0x1e,0x70,0x20,0xf1,0x13,0x13,0xdb,0x1b,0xbb,0x91,0xd9,0x18,0x33,0xb5,0x06,0x47,0xa3,0x01,0x9a,0xca,0xc3,0x10,0x09,0x1a}, 0},
+    {{0x98,0x09,0x60,0xe1,0x22,0x62,0x9b,0x5e,0xa4,0xce,0x5b,0x1d,0x7c,0x6a,0x70,0x43,0x77,0xfe,0x85,0x3b,0x3d,0x41,0x69,0x8d,0xb5,0xb1,0xc4,0xfd,0x37,0x4f,0x9f,0xc6}, 0},
+    {{0x98,0x09,0x60,0xe1,0x22,0x62,0x9b,0x5e,0xa4,0xce,0x5b,0x1d,0x7c,0x6a,0x70,0x43,0x77,0xfe,0x85,0x3b,0x3d,0x41,0x69,0x8d,0xb5,0xb1,0xc4,0xfd,0x37,0x4f,0x9f,0xc6}, 1},
+    {{0x98,0x0a,0x3e,0x58,0x7b,0x2f,0x8d,0x14,0xe7,0x9b,0x1c,0xbf,0x2b,0xd5,0xc7,0xe8,0x8e,0x75,0xcb,0x62,0x0e,0x94,0xa5,0xe1,0x16,0x82,0xc8,0x0e,0xb0,0xd9,0xb4,0xf2}, 0},
+    {{0x98,0x0a,0x3e,0x58,0x7b,0x2f,0x8d,0x14,0xe7,0x9b,0x1c,0xbf,0x2b,0xd5,0xc7,0xe8,0x8e,0x75,0xcb,0x62,0x0e,0x94,0xa5,0xe1,0x16,0x82,0xc8,0x0e,0xb0,0xd9,0xb4,0xf2}, 1},
+    {{0x98,0x0f,0x24,0xe7,0xb4,0x28,0x21,0x3b,0x77,0xfe,0x56,0xc0,0x56,0x86,0xa0,0xf9,0xdf,0xff,0x29,0xe0,0x7f,0x04,0x53,0x56,0xc6,0xcb,0xdd,0x20,0xfe,0xed,0xa5,0x33}, 0},
+    {{0x98,0x0f,0x24,0xe7,0xb4,0x28,0x21,0x3b,0x77,0xfe,0x56,0xc0,0x56,0x86,0xa0,0xf9,0xdf,0xff,0x29,0xe0,0x7f,0x04,0x53,0x56,0xc6,0xcb,0xdd,0x20,0xfe,0xed,0xa5,0x33}, 1},
+    {{0x98,0x64,0xb6,0x19,0x27,0xe6,0x73,0x4d,0x95,0x42,0x57,0xf9,0x7e,0x3a,0x81,0x90,0x4e,0x2f,0x9d,0x69,0x8d,0xcd,0x9b,0x43,0x97,0x22,0xae,0x4b,0x42,0x29,0x4b,0x81}, 0},
+    {{0x98,0x64,0xb6,0x19,0x27,0xe6,0x73,0x4d,0x95,0x42,0x57,0xf9,0x7e,0x3a,0x81,0x90,0x4e,0x2f,0x9d,0x69,0x8d,0xcd,0x9b,0x43,0x97,0x22,0xae,0x4b,0x42,0x29,0x4b,0x81}, 1},
+    {{0x98,0xba,0xa6,0x3a,0x0f,0xc3,0xa5,0xb8,0xa1,0x72,0x6d,0x5d,0xa3,0x49,0x73,0x0a,0xb5,0x5b,0x3b,0xb2,0x52,0x6e,0x80,0x5c,0xe0,0xd6,0x2e,0x33,0x52,0xe3,0x08,0xd3}, 0},
+    {{0x98,0xba,0xa6,0x3a,0x0f,0xc3,0xa5,0xb8,0xa1,0x72,0x6d,0x5d,0xa3,0x49,0x73,0x0a,0xb5,0x5b,0x3b,0xb2,0x52,0x6e,0x80,0x5c,0xe0,0xd6,0x2e,0x33,0x52,0xe3,0x08,0xd3}, 1},
+    {{0x98,0xe7,0xd5,0x04,0x21,0xb2,0x28,0x16,0x38,0xef,0x83,0xfe,0xa7,0x30,0x2b,0xd6,0x1a,0x82,0x91,0x2f,0xe3,0x8c,0xcc,0x62,0x35,0x02,0xab,0xc9,0xa1,0xae,0x6f,0xf6}, 0},
+    {{0x98,0xe7,0xd5,0x04,0x21,0xb2,0x28,0x16,0x38,0xef,0x83,0xfe,0xa7,0x30,0x2b,0xd6,0x1a,0x82,0x91,0x2f,0xe3,0x8c,0xcc,0x62,0x35,0x02,0xab,0xc9,0xa1,0xae,0x6f,0xf6}, 1},
+    {{0x99,0x0e,0xef,0x23,0xd9,0xbe,0x90,0xaa,0xd3,0xe6,0xa1,0xf3,0x4b,0xbd,0xdb,0xa5,0x37,0xa4,0xfc,0x53,0x98,0xe3,0xb9,0xe7,0xb9,0x99,0x6e,0x39,0x5e,0x1e,0x8e,0x15}, 0},
+    {{0x99,0x0e,0xef,0x23,0xd9,0xbe,0x90,0xaa,0xd3,0xe6,0xa1,0xf3,0x4b,0xbd,0xdb,0xa5,0x37,0xa4,0xfc,0x53,0x98,0xe3,0xb9,0xe7,0xb9,0x99,0x6e,0x39,0x5e,0x1e,0x8e,0x15}, 1},
+    {{0x9a,0x04,0xf5,0xd6,0xef,0xe2,0xa5,0xf7,0x0a,0xc7,0xfd,0x0c,0x6d,0x8c,0xc5,0x61,0xb8,0x06,0x73,0xaf,0x0b,0x17,0x18,0x68,0xb8,0xe8,0x0a,0x91,0xc1,0x07,0xa7,0x3b}, 0},
+    {{0x9a,0x04,0xf5,0xd6,0xef,0xe2,0xa5,0xf7,0x0a,0xc7,0xfd,0x0c,0x6d,0x8c,0xc5,0x61,0xb8,0x06,0x73,0xaf,0x0b,0x17,0x18,0x68,0xb8,0xe8,0x0a,0x91,0xc1,0x07,0xa7,0x3b}, 1},
+    {{0x9a,0x3d,0x26,0x4c,0xd3,0xb2,0x3d,0x75,0x78,0xfc,0x81,0xef,0x5a,0x53,0x9d,0xdf,0x9c,0x6f,0x93,0xe3,0x9b,0x98,0x7d,0x01,0x95,0x3b,0xbc,0x84,0x16,0x3c,0x3d,0xb5}, 0},
+    {{0x9a,0x4b,0xc8,0xcf,0xda,0x5a,0xce,0x03,0x0e,0x64,0x74,0x7b,0xe0,0xdc,0x5d,0xb2,0x31,0xae,0x08,0xa9,0xdc,0xb1,0xdd,0xfb,0xd7,0x27,0x28,0xa0,0xe8,0x0d,0x10,0x42}, 0},
+    {{0x9a,0x4b,0xc8,0xcf,0xda,0x5a,0xce,0x03,0x0e,0x64,0x74,0x7b,0xe0,0xdc,0x5d,0xb2,0x31,0xae,0x08,0xa9,0xdc,0xb1,0xdd,0xfb,0xd7,0x27,0x28,0xa0,0xe8,0x0d,0x10,0x42}, 1},
+    {{0x9a,0x51,0x25,0xb0,0x37,0x4b,0x32,0xf3,0x2f,0x9a,0x53,0x89,0x6e,0x07,0x7e,0x86,0x1f,0x83,0xaf,0xe5,0xec,0x31,0x71,0x49,0x12,0x09,0xbf,0x12,0xbb,0xd3,0x3f,0x35}, 0},
+    {{0x9a,0x51,0x25,0xb0,0x37,0x4b,0x32,0xf3,0x2f,0x9a,0x53,0x89,0x6e,0x07,0x7e,0x86,0x1f,0x83,0xaf,0xe5,0xec,0x31,0x71,0x49,0x12,0x09,0xbf,0x12,0xbb,0xd3,0x3f,0x35}, 1},
+    {{0x9a,0x57,0xa3,0x35,0x45,0x67,0x61,0xf8,0x29,0x19,0x0c,0xea,0xe8,0x33,0x38,0x9a,0x64,0xe8,0xff,0xf3,0xa0,0x9b,0x55,0xa2,0x30,0xe3,0xec,0xc3,0x1a,0xbf,0xe3,0x4a}, 0},
+    {{0x9a,0x86,0xf2,0x0c,0x69,0xf9,0x61,0x40,0x49,0x82,0x33,0xe4,0x6b,0x17,0x38,0x6c,0xfb,0x29,0x12,0xda,0xf6,0xed,0x1a,0x58,0x1e,0xac,0x31,0x0f,0xde,0xbd,0xa5,0x1b}, 0},
+    {{0x9a,0x86,0xf2,0x0c,0x69,0xf9,0x61,0x40,0x49,0x82,0x33,0xe4,0x6b,0x17,0x38,0x6c,0xfb,0x29,0x12,0xda,0xf6,0xed,0x1a,0x58,0x1e,0xac,0x31,0x0f,0xde,0xbd,0xa5,0x1b}, 1},
+    {{0x9a,0xa7,0xa9,0xe8,0x6a,0x9c,0x08,0xf5,0x61,0x01,0x9b,0xe6,0xeb,0x02,0xd7,0x10,0x9b,0x1e,0xbe,0x40,0x1b,0x7b,0x25,0x22,0x86,0x93,0x30,0xe2,0xee,0x16,0x36,0x7f}, 0},
+    {{0x9a,0xa7,0xa9,0xe8,0x6a,0x9c,0x08,0xf5,0x61,0x01,0x9b,0xe6,0xeb,0x02,0xd7,0x10,0x9b,0x1e,0xbe,0x40,0x1b,0x7b,0x25,0x22,0x86,0x93,0x30,0xe2,0xee,0x16,0x36,0x7f}, 1},
+    {{0x9a,0xfc,0x5b,0x1a,0x1a,0x66,0x9e,0xb6,0x52,0x3c,0xca,0xde,0x81,0x94,0x3a,0xec,0x42,0xe3,0x2f,0x34,0xdc,0xb3,0x84,0x09,0x2c,0x3e,0xee,0xfe,0x6c,0xb9,0x33,0x44}, 0},
+    {{0x9a,0xfc,0x5b,0x1a,0x1a,0x66,0x9e,0xb6,0x52,0x3c,0xca,0xde,0x81,0x94,0x3a,0xec,0x42,0xe3,0x2f,0x34,0xdc,0xb3,0x84,0x09,0x2c,0x3e,0xee,0xfe,0x6c,0xb9,0x33,0x44}, 1},
+    {{0x9b,0x15,0x93,0x42,0x65,0x2a,0x63,0x95,0x3e,0xdb,0x01,0xe2,0x7e,0xbd,0x28,0x69,0x31,0x5a,0x50,0x85,0xff,0x10,0xe1,0xac,0x70,0x04,0x3f,0x80,0x6d,0x98,0x3d,0xf2}, 0},
+    {{0x9b,0x15,0x93,0x42,0x65,0x2a,0x63,0x95,0x3e,0xdb,0x01,0xe2,0x7e,0xbd,0x28,0x69,0x31,0x5a,0x50,0x85,0xff,0x10,0xe1,0xac,0x70,0x04,0x3f,0x80,0x6d,0x98,0x3d,0xf2}, 1},
+    {{0x9b,0x66,0x16,0xa1,0x33,0x90,0x14,0x2b,0xa6,0x11,0x1b,0x31,0x31,0xd7,0x97,0x31,0x58,0xc4,0xbc,0x5a,0xe9,0x7d,0xbe,0x8a,0x58,0xf8,0x5d,0x31,0xa4,0x3a,0x5d,0xb5}, 0},
+    {{0x9b,0xc5,0xdf,0x24,0x61,0x50,0xfe,0x02,0xc3,0x4d,0x8a,0xaa,0x1d,0x8e,0x13,0xdb,0x88,0x0b,0xb0,0x35,0x37,0xed,0xa9,0xe1,0xa6,0xdf,0x59,0xd9,0x35,0x13,0xab,0x50}, 0},
+    {{0x9b,0xc5,0xdf,0x24,0x61,0x50,0xfe,0x02,0xc3,0x4d,0x8a,0xaa,0x1d,0x8e,0x13,0xdb,0x88,0x0b,0xb0,0x35,0x37,0xed,0xa9,0xe1,0xa6,0xdf,0x59,0xd9,0x35,0x13,0xab,0x50}, 1},
+    {{0x9b,0xed,0x16,0x02,0xfe,0x8b,0x1c,0xe6,0xe6,0x3b,0x74,0x36,0x85,0x79,0xf2,0x70,0x01,0x89,0x27,0xd1,0xb3,0xf7,0x22,0x89,0x6a,0xb2,0xeb,0x20,0xcf,0x78,0x99,0xa7}, 0},
+    {{0x9b,0xfe,0x95,0xfa,0xb3,0xee,0x0f,0x0e,0xed,0x78,0xe5,0x46,0x1a,0x12,0x00,0x5d,0x01,0x70,0x40,0x93,0x28,0xe6,0x49,0x68,0xf8,0x9c,0x67,0x62,0x2a,0xd1,0xda,0xbc}, 0},
+    {{0x9b,0xfe,0x95,0xfa,0xb3,0xee,0x0f,0x0e,0xed,0x78,0xe5,0x46,0x1a,0x12,0x00,0x5d,0x01,0x70,0x40,0x93,0x28,0xe6,0x49,0x68,0xf8,0x9c,0x67,0x62,0x2a,0xd1,0xda,0xbc}, 1},
+    {{0x9b,0xfe,0xe3,0x0a,0x77,0x9a,0xa0,0x74,0xc6,0x70,0xee,0xdb,0x92,0x5a,0x43,0xaf,0x74,0x28,0xf2,0x76,0x58,0x2f,0xa3,0xe1,0x6b,0xa0,0x18,0x9d,0x4b,0x86,0x9e,0xe8}, 0},
+    {{0x9b,0xfe,0xe3,0x0a,0x77,0x9a,0xa0,0x74,0xc6,0x70,0xee,0xdb,0x92,0x5a,0x43,0xaf,0x74,0x28,0xf2,0x76,0x58,0x2f,0xa3,0xe1,0x6b,0xa0,0x18,0x9d,0x4b,0x86,0x9e,0xe8}, 1},
+    {{0x9c,0x40,0x81,0x1a,0x3f,0x12,0xcf,0x16,0x0b,0xce,0xe5,0x67,0x39,0xc8,0x8c,0xcc,0xeb,0x79,0x06,0xd5,0x6d,0x35,0x72,0x3c,0x1f,0xdc,0xe8,0x68,0xa2,0xdd,0xea,0x7e}, 0},
+    {{0x9c,0x40,0x81,0x1a,0x3f,0x12,0xcf,0x16,0x0b,0xce,0xe5,0x67,0x39,0xc8,0x8c,0xcc,0xeb,0x79,0x06,0xd5,0x6d,0x35,0x72,0x3c,0x1f,0xdc,0xe8,0x68,0xa2,0xdd,0xea,0x7e}, 1},
+    {{0x9c,0x89,0x30,0xe9,0x81,0x47,0x5b,0x67,0xfe,0x96,0x06,0xba,0xd2,0xa6,0xba,0x4f,0xe8,0xd8,0xf4,0xb5,0x3b,0x65,0xc3,0x1e,0xba,0x41,0x7f,0xf4,0x7d,0x6a,0xe1,0xe7}, 0},
+    {{0x9c,0x89,0x30,0xe9,0x81,0x47,0x5b,0x67,0xfe,0x96,0x06,0xba,0xd2,0xa6,0xba,0x4f,0xe8,0xd8,0xf4,0xb5,0x3b,0x65,0xc3,0x1e,0xba,0x41,0x7f,0xf4,0x7d,0x6a,0xe1,0xe7}, 1},
+    {{0x9c,0xef,0x0b,0xf6,0x29,0x1e,0xa6,0x3e,0x57,0x8f,0x05,0x23,0x99,0x9f,0xba,0x4c,0x6a,0xac,0xc4,0x73,0x25,0xf8,0x3e,0x1c,0xd0,0xfb,0x6a,0x74,0x20,0xd1,0xca,0xbe}, 0},
+    {{0x9d,0xa0,0xf9,0x71,0x31,0x4f,0x4d,0xc0,0xc5,0x54,0xbb,0x62,0x26,0x4a,0x1a,0x08,0x90,0x7a,0x61,0xc3,0x62,0x84,0xbd,0xaa,0x11,0x70,0x51,0x40,0xeb,0x74,0xcf,0x7d}, 0},
+    {{0x9d,0xa7,0x61,0x7a,0x87,0x10,0xbe,0xb5,0xb6,0xb4,0xe5,0xc2,0x68,0xa0,0x57,0x43,0xb9,0xeb,0x47,0x08,0x19,0x37,0x5d,0xc9,0x17,0x0c,0x7c,0xc8,0xce,0x83,0x50,0xb1}, 0},
+    {{0x9d,0xa7,0x61,0x7a,0x87,0x10,0xbe,0xb5,0xb6,0xb4,0xe5,0xc2,0x68,0xa0,0x57,0x43,0xb9,0xeb,0x47,0x08,0x19,0x37,0x5d,0xc9,0x17,0x0c,0x7c,0xc8,0xce,0x83,0x50,0xb1}, 1},
+    {{0x9d,0xb4,0xa7,0x88,0x6d,0x9c,0xa6,0x50,0x0f,0xe2,0x79,0xe8,0xa7,0x02,0xf1,0xe7,0x1f,0x95,0x52,0x9f,0x55,0x04,0xbd,0x8c,0x9b,0x17,0x7b,0x23,0x32,0xbd,0xfa,0xd3}, 0},
+    {{0x9d,0xb4,0xa7,0x88,0x6d,0x9c,0xa6,0x50,0x0f,0xe2,0x79,0xe8,0xa7,0x02,0xf1,0xe7,0x1f,0x95,0x52,0x9f,0x55,0x04,0xbd,0x8c,0x9b,0x17,0x7b,0x23,0x32,0xbd,0xfa,0xd3}, 1},
+    {{0x9d,0xf1,0x2f,0x97,0xb0,0xd2,0x10,0x81,0x35,0x7a,0x18,0x25,0x9f,0xd5,0xa1,0x05,0x72,0xb9,0x0b,0x5c,0x92,0x82,0x89,0x5e,0xd8,0xed,0x9e,0x97,0xe6,0xde,0x69,0x4d}, 0},
+    {{0x9d,0xf1,0x2f,0x97,0xb0,0xd2,0x10,0x81,0x35,0x7a,0x18,0x25,0x9f,0xd5,0xa1,0x05,0x72,0xb9,0x0b,0x5c,0x92,0x82,0x89,0x5e,0xd8,0xed,0x9e,0x97,0xe6,0xde,0x69,0x4d}, 1},
+    {{0x9e,0x29,0x03,0x5e,0xd7,0x6e,0x90,0xfb,0x81,0xed,0xfe,0x1c,0x2e,0x86,0x7f,0x74,0xa2,0x14,0x88,0xb5,0x39,0x44,0x3b,0x37,0xd7,0x92,0xa6,0x1a,0x1b,0x70,0xc1,0xe0}, 0},
+    {{0x9e,0x29,0x03,0x5e,0xd7,0x6e,0x90,0xfb,0x81,0xed,0xfe,0x1c,0x2e,0x86,0x7f,0x74,0xa2,0x14,0x88,0xb5,0x39,0x44,0x3b,0x37,0xd7,0x92,0xa6,0x1a,0x1b,0x70,0xc1,0xe0}, 1},
+    {{0x9e,0x54,0x23,0x34,0x96,0xf0,0x96,0x1c,0xdf,0x6b,0x4e,0x76,0x87,0x96,0x2f,0x54,0x2c,0x1a,0x1f,0xc9,0x49,0x94,0x35,0xe1,0x24,0xcb,0x62,0x53,0x2b,0x8a,0x76,0x7e}, 1},
+    {{0x9e,0x54,0x23,0x34,0x96,0xf0,0x96,0x1c,0xdf,0x6b,0x4e,0x76,0x87,0x96,0x2f,0x54,0x2c,0x1a,0x1f,0xc9,0x49,0x94,0x35,0xe1,0x24,0xcb,0x62,0x53,0x2b,0x8a,0x76,0x7e}, 2},
+    {{0x9e,0xb9,0x29,0x4c,0x85,0x40,0xa5,0xc8,0x9a,0x35,0xf9,0x8e,0xc8,0x36,0xd1,0x67,0xb8,0xfa,0xf9,0xc4,0x65,0xe7,0xd6,0xee,0x79,0xd6,0xfa,0x01,0xc8,0x90,0xcf,0x8f}, 0},
+    {{0x9e,0xdf,0x7a,0xf4,0x14,0x12,0x55,0x1b,0x75,0xe1,0xa6,0x63,0xd7,0x2d,0x1a,0xc3,0x93,0xf9,0x96,0xae,0x77,0xf2,0xed,0x2f,0x83,0x4e,0xc6,0x6a,0xe8,0x20,0x84,0xba}, 0},
+    {{0x9e,0xdf,0x7a,0xf4,0x14,0x12,0x55,0x1b,0x75,0xe1,0xa6,0x63,0xd7,0x2d,0x1a,0xc3,0x93,0xf9,0x96,0xae,0x77,0xf2,0xed,0x2f,0x83,0x4e,0xc6,0x6a,0xe8,0x20,0x84,0xba}, 1},
+    {{0x9f,0x06,0x73,0x0c,0xfa,0x70,0x2c,0xe7,0xe8,0x66,0xe3,0xc5,0x07,0xdc,0xa4,0x9c,0xd8,0xf8,0x5e,0xc0,0x92,0xf2,0x36,0xd7,0x80,0x5f,0x40,0x96,0x3d,0x7e,0xd9,0x0b}, 0},
+    {{0x9f,0x06,0x73,0x0c,0xfa,0x70,0x2c,0xe7,0xe8,0x66,0xe3,0xc5,0x07,0xdc,0xa4,0x9c,0xd8,0xf8,0x5e,0xc0,0x92,0xf2,0x36,0xd7,0x80,0x5f,0x40,0x96,0x3d,0x7e,0xd9,0x0b}, 1},
+    {{0x9f,0x58,0x37,0x29,0x63,0x11,0x1a,0x8f,0xcf,0x28,0x03,0x68,0xed,0x4e,0xd2,0x07,0xfa,0x26,0x32,0x8f,0xe0,0xb5,0x18,0x3e,0xab,0x2e,0x84,0x41,0xe1,0x5a,0x37,0x4e}, 0},
+    {{0x9f,0x58,0x37,0x29,0x63,0x11,0x1a,0x8f,0xcf,0x28,0x03,0x68,0xed,0x4e,0xd2,0x07,0xfa,0x26,0x32,0x8f,0xe0,0xb5,0x18,0x3e,0xab,0x2e,0x84,0x41,0xe1,0x5a,0x37,0x4e}, 1},
+    {{0x9f,0x87,0x8b,0x00,0xaa,0xb1,0xbb,0x6f,0xcc,0x38,0x0d,0x2c,0x0c,0x61,0x79,0xc1,0x61,0xad,0x34,0x29,0x1d,0x78,0x96,0xf9,0xa8,0x57,0x05,0x91,0xb0,0x8e,0xec,0xf3}, 0},
+    {{0x9f,0x87,0x8b,0x00,0xaa,0xb1,0xbb,0x6f,0xcc,0x38,0x0d,0x2c,0x0c,0x61,0x79,0xc1,0x61,0xad,0x34,0x29,0x1d,0x78,0x96,0xf9,0xa8,0x57,0x05,0x91,0xb0,0x8e,0xec,0xf3}, 1},
+    {{0x9f,0xa9,0xa1,0x6d,0x14,0xd8,0x53,0x5e,0x86,0x4e,0x95,0x3c,0x8d,0x09,0xde,0x0e,0x96,0xfa,0xcc,0x47,0xd4,0xa0,0x96,0x87,0xac,0xab,0x3c,0xa4,0x33,0xc3,0xfb,0x72}, 0},
+    {{0x9f,0xa9,0xa1,0x6d,0x14,0xd8,0x53,0x5e,0x86,0x4e,0x95,0x3c,0x8d,0x09,0xde,0x0e,0x96,0xfa,0xcc,0x47,0xd4,0xa0,0x96,0x87,0xac,0xab,0x3c,0xa4,0x33,0xc3,0xfb,0x72}, 1},
+    {{0x9f,0xd1,0x65,0x2c,0x4f,0xdf,0x3b,0x57,0x9e,0x96,0x30,0xf9,0x29,0x2d,0xc7,0x40,0x2a,0xc4,0xb9,0x58,0xa6,0xa6,0x66,0x2f,0xfb,0x45,0x8b,0xd2,0xa5,0x5a,0x89,0x06}, 0},
+    {{0x9f,0xe2,0x1a,0x1b,0xa4,0xa9,0xbd,0x79,0x40,0xe1,0xc8,0x06,0xf5,0x5b,0xcc,0xe9,0x59,0xb9,0x57,0xb5,0x3e,0xd2,0x77,0x9d,0xf5,0xac,0xf3,0x8d,0xdd,0x08,0x11,0x2e}, 0},
+    {{0x9f,0xe2,0x1a,0x1b,0xa4,0xa9,0xbd,0x79,0x40,0xe1,0xc8,0x06,0xf5,0x5b,0xcc,0xe9,0x59,0xb9,0x57,0xb5,0x3e,0xd2,0x77,0x9d,0xf5,0xac,0xf3,0x8d,0xdd,0x08,0x11,0x2e}, 1},
+    {{0xa0,0x32,0x69,0x6e,0xb0,0x12,0xf6,0x6c,0x8c,0x62,0xb4,0x63,0xb8,0xdc,0xa8,0x24,0xab,0xf8,0x5d,0xa3,0x1c,0x13,0x35,0x7e,0x74,0x80,0x85,0xa4,0x42,0x68,0xf9,0xa8}, 0},
+    {{0xa0,0x48,0x0a,0x27,0xd4,0x4d,0x5e,0x29,0xd5,0xec,0x0a,0x04,0xb5,0xf8,0x85,0xa0,0x68,0x1a,0x9c,0x21,0x8e,0xc7,0xaf,0x0d,0xe7,0x2b,0x9b,0xc8,0x1e,0x06,0xf0,0xfb}, 0},
+    {{0xa0,0x48,0x0a,0x27,0xd4,0x4d,0x5e,0x29,0xd5,0xec,0x0a,0x04,0xb5,0xf8,0x85,0xa0,0x68,0x1a,0x9c,0x21,0x8e,0xc7,0xaf,0x0d,0xe7,0x2b,0x9b,0xc8,0x1e,0x06,0xf0,0xfb}, 1},
+    {{0xa0,0x6a,0x55,0x04,0x53,0x86,0xa7,0x13,0x62,0x9c,0x40,0x8c,0x13,0x9c,0x73,0xb4,0x29,0xb2,0x93,0x50,0x73,0x87,0x5f,0xab,0x86,0x76,0xcb,0x49,0x24,0x8a,0x78,0x1f}, 0},
+    {{0xa0,0x6a,0x55,0x04,0x53,0x86,0xa7,0x13,0x62,0x9c,0x40,0x8c,0x13,0x9c,0x73,0xb4,0x29,0xb2,0x93,0x50,0x73,0x87,0x5f,0xab,0x86,0x76,0xcb,0x49,0x24,0x8a,0x78,0x1f}, 1},
+    {{0xa0,0x7d,0x63,0xba,0xbd,0x30,0xf3,0x14,0x29,0xa2,0xbd,0x5e,0xde,0x78,0x96,0x0d,0xff,0xcb,0x87,0x2c,0x91,0x7e,0x63,0xa5,0xe6,0xb2,0xdd,0xfd,0xbe,0x19,0x56,0x06}, 0},
+    {{0xa1,0x16,0xce,0xf4,0x55,0x45,0xc7,0x40,0xac,0x7f,0xe2,0xa7,0x33,0x4b,0x5d,0xe7,0x91,0x0e,0x7f,0x33,0xd2,0xa5,0xa5,0xf0,0xf4,0xd7,0x93,0x52,0x12,0xdb,0x3c,0x30}, 0},
+    {{0xa1,0x16,0xce,0xf4,0x55,0x45,0xc7,0x40,0xac,0x7f,0xe2,0xa7,0x33,0x4b,0x5d,0xe7,0x91,0x0e,0x7f,0x33,0xd2,0xa5,0xa5,0xf0,0xf4,0xd7,0x93,0x52,0x12,0xdb,0x3c,0x30}, 1},
+    {{0xa1,0x5b,0x0b,0xcd,0xea,0xac,0xec,0x39,0xbc,0x61,0x9e,0xc8,0xa7,0x01,0x4a,0xdf,0x3c,0x37,0xde,0xb1,0x79,0xa4,0xce,0x56,0xa0,0xbe,0xdc,0xa5,0xaa,0x81,0xd3,0x2b}, 0},
+    {{0xa1,0x60,0xee,0x74,0x06,0x5c,0x03,0xf0,0xac,0xc3,0x5c,0x55,0x0d,0x94,0x74,0xd8,0x15,0x35,0x25,0x43,0xd4,0x00,0x5c,0xa1,0x83,0x99,0xf0,0x09,0x85,0x42,0xcf,0x12}, 0},
+    {{0xa1,0x60,0xee,0x74,0x06,0x5c,0x03,0xf0,0xac,0xc3,0x5c,0x55,0x0d,0x94,0x74,0xd8,0x15,0x35,0x25,0x43,0xd4,0x00,0x5c,0xa1,0x83,0x99,0xf0,0x09,0x85,0x42,0xcf,0x12}, 1},
+    {{0xa1,0xd6,0x88,0x70,0xeb,0x91,0xa3,0x33,0x10,0x19,0x86,0xed,0x39,0xc9,0xbb,0xef,0xf0,0x4c,0x78,0x3f,0xd9,0xeb,0x37,0x9a,0xbe,0x94,0x18,0xcb,0xf7,0xcf,0xcc,0x3b}, 0},
+    {{0xa1,0xd6,0x88,0x70,0xeb,0x91,0xa3,0x33,0x10,0x19,0x86,0xed,0x39,0xc9,0xbb,0xef,0xf0,0x4c,0x78,0x3f,0xd9,0xeb,0x37,0x9a,0xbe,0x94,0x18,0xcb,0xf7,0xcf,0xcc,0x3b}, 1},
+    {{0xa2,0x16,0x56,0xd4,0x1b,0x01,0xa6,0xa6,0x68,0x32,0x87,0x52,0xed,0xaa,0xbf,0x7d,0x8a,0xeb,0x10,0xde,0x3d,0x3c,0x58,0x58,0xa4,0xd7,0xf5,0x10,0x16,0x2d,0xec,0x76}, 0},
+    {{0xa2,0x16,0x56,0xd4,0x1b,0x01,0xa6,0xa6,0x68,0x32,0x87,0x52,0xed,0xaa,0xbf,0x7d,0x8a,0xeb,0x10,0xde,0x3d,0x3c,0x58,0x58,0xa4,0xd7,0xf5,0x10,0x16,0x2d,0xec,0x76}, 1},
+    {{0xa2,0x23,0xe1,0xd6,0x2f,0x0d,0xc0,0xd3,0xc0,0x4c,0xb9,0x2c,0x43,0xc3,0xff,0x7b,0x44,0x24,0xa9,0xad,0x85,0x72,0x88,0x3b,0xcf,0xba,0xa8,0x27,0x01,0x66,0x6e,0x28}, 0},
+    {{0xa2,0x23,0xe1,0xd6,0x2f,0x0d,0xc0,0xd3,0xc0,0x4c,0xb9,0x2c,0x43,0xc3,0xff,0x7b,0x44,0x24,0xa9,0xad,0x85,0x72,0x88,0x3b,0xcf,0xba,0xa8,0x27,0x01,0x66,0x6e,0x28}, 1},
+    {{0xa2,0x57,0x51,0x20,0xc3,0xbf,0x60,0x8e,0xfc,0xa2,0x70,0x3c,0x87,0x93,0x19,0x69,0x65,0x76,0x0e,0x3a,0x25,0x64,0x33,0xdd,0x00,0x8c,0x81,0x1f,0x44,0x6c,0x59,0xd3}, 0},
+    {{0xa2,0x57,0x51,0x20,0xc3,0xbf,0x60,0x8e,0xfc,0xa2,0x70,0x3c,0x87,0x93,0x19,0x69,0x65,0x76,0x0e,0x3a,0x25,0x64,0x33,0xdd,0x00,0x8c,0x81,0x1f,0x44,0x6c,0x59,0xd3}, 1},
+    {{0xa2,0x90,0xe7,0x28,0xe7,0x68,0x42,0x66,0x18,0x6b,0x5e,0xc0,0x73,0x27,0x2a,0x88,0x48,0x83,0xb3,0x30,0x0e,0x6e,0x80,0xe7,0xd7,0x48,0x84,0x7f,0xf7,0xdc,0xf7,0xfd}, 0},
+    {{0xa2,0xac,0x01,0xe8,0xdf,0x93,0x62,0x58,0xf3,0x6e,0x08,0xa0,0x69,0x40,0x27,0x6d,0x7f,0xef,0xbd,0x25,0x32,0x19,0xbd,0x2e,0x01,0x41,0x39,0x41,0x9b,0x1b,0xb1,0x4c}, 0},
+    {{0xa2,0xc9,0x7f,0x54,0x06,0x60,0x68,0x50,0x13,0x12,0x80,0x43,0xd1,0x3c,0x2f,0x24,0x9a,0x3d,0x62,0xd8,0xca,0x17,0x4c,0xfb,0x0a,0x6f,0x61,0x44,0x66,0xae,0x5d,0x3d}, 0},
+    {{0xa3,0x05,0x49,0x6d,0xa9,0xdc,0xbc,0x80,0x08,0x06,0x18,0x94,0xb7,0x6d,0x31,0xf2,0x5f,0x1d,0xc3,0x41,0xf3,0x0f,0x8a,0x3b,0x45,0x3c,0xcb,0x82,0xa5,0xbd,0x08,0xb7}, 0},
+    {{0xa3,0x06,0x54,0x94,0xc1,0xbd,0x64,0xf4,0x14,0x42,0x32,0x43,0x85,0x0d,0xbc,0xf1,0xce,0x3b,0xa7,0xb6,0x8d,0x28,0xc3,0x7e,0x27,0xf9,0x5f,0x88,0xd8,0x70,0x5c,0xbf}, 0},
+    {{0xa3,0x06,0x54,0x94,0xc1,0xbd,0x64,0xf4,0x14,0x42,0x32,0x43,0x85,0x0d,0xbc,0xf1,0xce,0x3b,0xa7,0xb6,0x8d,0x28,0xc3,0x7e,0x27,0xf9,0x5f,0x88,0xd8,0x70,0x5c,0xbf}, 1},
+    {{0xa3,0x49,0xad,0xe5,0xd1,0x32,0x47,0x3d,0xf9,0x7e,0x34,0x2b,0x28,0xcf,0x2b,0x9a,0x55,0x8f,0xfc,0xda,0x93,0x4a,0xd1,0x6e,0xb0,0x24,0xef,0x6f,0x4a,0xcc,0x6e,0xda}, 0},
+    {{0xa3,0x50,0x6b,0x29,0x4c,0x04,0x8f,0x6f,0xeb,0x67,0x7f,0xce,0xdb,0xbf,0x1b,0x5b,0xe1,0x86,0x7e,0xa0,0x1b,0xe3,0x34,0xa4,0xa2,0xa1,0x0d,0x40,0x94,0x12,0x9a,0xce}, 0},
+    {{0xa3,0x50,0x6b,0x29,0x4c,0x04,0x8f,0x6f,0xeb,0x67,0x7f,0xce,0xdb,0xbf,0x1b,0x5b,0xe1,0x86,0x7e,0xa0,0x1b,0xe3,0x34,0xa4,0xa2,0xa1,0x0d,0x40,0x94,0x12,0x9a,0xce}, 1},
+    {{0xa3,0x99,0x6e,0xd1,0xec,0x85,0xa4,0xbb,0x6c,0xaa,0x92,0xfd,0x2f,0xce,0x27,0xc2,0x52,0x4d,0xa3,0x06,0x5f,0xd3,0x14,0xe7,0xa1,0xaa,0xe3,0x68,0xb3,0x78,0x92,0x71}, 0},
+    {{0xa3,0x99,0x6e,0xd1,0xec,0x85,0xa4,0xbb,0x6c,0xaa,0x92,0xfd,0x2f,0xce,0x27,0xc2,0x52,0x4d,0xa3,0x06,0x5f,0xd3,0x14,0xe7,0xa1,0xaa,0xe3,0x68,0xb3,0x78,0x92,0x71}, 1},
+    {{0xa3,0x9a,0xf8,0x6b,0x54,0x4a,0xc6,0x59,0x65,0xcc,0xd7,0x8a,0x4c,0x95,0x4d,0x6c,0xa2,0x56,0xf5,0x77,0x8b,0xce,0x7a,0xf3,0xd3,0x60,0x55,0xbb,0xdc,0x32,0x4a,0x57}, 0},
+    {{0xa3,0xa3,0x93,0x4e,0xa9,0x34,0x7a,0xf3,0x61,0xc9,0xeb,0x61,0x00,0x56,0xc7,0x41,0x85,0x30,0x9e,0x30,0x67,0x36,0xe0,0x45,0x30,0x48,0xb6,0xdb,0x12,0x28,0x88,0x50}, 0},
+    {{0xa3,0xc1,0xc7,0x5d,0x51,0xfe,0xd5,0x29,0xb0,0x0f,0x16,0xeb,0xd9,0xa7,0x1c,0x32,0x18,0x4c,0xf2,0xba,0x59,0xd5,0xa7,0xac,0xf5,0x84,0x18,0x1d,0xe2,0x10,0x7c,0x4f}, 0},
+    {{0xa3,0xc1,0xc7,0x5d,0x51,0xfe,0xd5,0x29,0xb0,0x0f,0x16,0xeb,0xd9,0xa7,0x1c,0x32,0x18,0x4c,0xf2,0xba,0x59,0xd5,0xa7,0xac,0xf5,0x84,0x18,0x1d,0xe2,0x10,0x7c,0x4f}, 1},
+    {{0xa3,0xef,0xc7,0x48,0xd7,0xdf,0x9e,0xf4,0x27,0xaf,0xcb,0x0d,0xef,0x97,0x49,0xcc,0xd4,0xdf,0x30,0xac,0x93,0x95,0xdb,0xe3,0xa4,0xbe,0x56,0x88,0x23,0x7d,0x26,0x84}, 0},
+    {{0xa3,0xef,0xc7,0x48,0xd7,0xdf,0x9e,0xf4,0x27,0xaf,0xcb,0x0d,0xef,0x97,0x49,0xcc,0xd4,0xdf,0x30,0xac,0x93,0x95,0xdb,0xe3,0xa4,0xbe,0x56,0x88,0x23,0x7d,0x26,0x84}, 1},
+    {{0xa3,0xfa,0x5d,0x48,0x48,0x20,0xcc,0xbe,0x5c,0xa4,0x34,0x3e,0x31,0x5f,0x8c,0xbb,0xa3,0x15,0x4b,0xdb,0xd0,0xe1,0x0c,0x37,0x57,0x75,0x4a,0x31,0x9b,0x11,0x49,0xca}, 0},
+    {{0xa3,0xfa,0x5d,0x48,0x48,0x20,0xcc,0xbe,0x5c,0xa4,0x34,0x3e,0x31,0x5f,0x8c,0xbb,0xa3,0x15,0x4b,0xdb,0xd0,0xe1,0x0c,0x37,0x57,0x75,0x4a,0x31,0x9b,0x11,0x49,0xca}, 1},
+    {{0xa4,0xb6,0x12,0x8b,0x3f,0x64,0xe8,0x52,0x80,0x63,0xa1,0xfe,0xa6,0x36,0x8f,0xa0,0xf6,0x4a,0xa5,0xa8,0x11,0xb8,0x5f,0xf6,0x8c,0xd3,0x53,0xfd,0x0c,0x0e,0x8e,0xc1}, 0},
+    {{0xa4,0xb6,0x12,0x8b,0x3f,0x64,0xe8,0x52,0x80,0x63,0xa1,0xfe,0xa6,0x36,0x8f,0xa0,0xf6,0x4a,0xa5,0xa8,0x11,0xb8,0x5f,0xf6,0x8c,0xd3,0x53,0xfd,0x0c,0x0e,0x8e,0xc1}, 1},
+    {{0xa4,0xef,0xcf,0x4c,0x49,0xc0,0xc9,0x80,0xbf,0x31,0xf9,0x53,0x99,0xf5,0xbc,0x00,0xe1,0x92,0x31,0x69,0x3e,0xcc,0x18,0x86,0x89,0xed,0x38,0x8a,0x26,0x1a,0x5f,0x40}, 0},
+    {{0xa4,0xef,0xcf,0x4c,0x49,0xc0,0xc9,0x80,0xbf,0x31,0xf9,0x53,0x99,0xf5,0xbc,0x00,0xe1,0x92,0x31,0x69,0x3e,0xcc,0x18,0x86,0x89,0xed,0x38,0x8a,0x26,0x1a,0x5f,0x40}, 1},
+    {{0xa5,0x07,0x0a,0xdb,0x87,0x42,0xc9,0x45,0x07,0x07,0x3a,0x8b,0x5d,0xcc,0x3d,0xd5,0x7b,0xd6,0xf4,0x76,0xc6,0x20,0x51,0x4f,0xdc,0x3a,0x39,0x8d,0xbb,0xbc,0x73,0xbd}, 0},
+    {{0xa5,0x07,0x0a,0xdb,0x87,0x42,0xc9,0x45,0x07,0x07,0x3a,0x8b,0x5d,0xcc,0x3d,0xd5,0x7b,0xd6,0xf4,0x76,0xc6,0x20,0x51,0x4f,0xdc,0x3a,0x39,0x8d,0xbb,0xbc,0x73,0xbd}, 1},
+    {{0xa5,0x1c,0x63,0x8e,0x06,0x2c,0x24,0xd9,0x3e,0x1f,0x10,0x13,0x02,0x6c,0x09,0x27,0x72,0xf1,0x01,0xe0,0x1b,0x3b,0x2d,0x13,0xaa,0x39,0x7c,0xcc,0x42,0xaa,0x16,0xa7}, 0},
+    {{0xa5,0x1c,0x63,0x8e,0x06,0x2c,0x24,0xd9,0x3e,0x1f,0x10,0x13,0x02,0x6c,0x09,0x27,0x72,0xf1,0x01,0xe0,0x1b,0x3b,0x2d,0x13,0xaa,0x39,0x7c,0xcc,0x42,0xaa,0x16,0xa7}, 1},
+    {{0xa5,0x8a,0x35,0x27,0xd1,0x0c,0xee,0xfc,0xb8,0xe8,0xad,0x95,0x88,0xf3,0x36,0x9b,0x9e,0xa1,0x8c,0xe1,0x71,0x70,0x5b,0x03,0x00,0x8a,0xc3,0xa8,0x90,0xf0,0x19,0xc2}, 0},
+    {{0xa5,0x8a,0x35,0x27,0xd1,0x0c,0xee,0xfc,0xb8,0xe8,0xad,0x95,0x88,0xf3,0x36,0x9b,0x9e,0xa1,0x8c,0xe1,0x71,0x70,0x5b,0x03,0x00,0x8a,0xc3,0xa8,0x90,0xf0,0x19,0xc2}, 1},
+    {{0xa5,0xe0,0x54,0xc1,0x3e,0xea,0x5b,0x0b,0x92,0x01,0x93,0x0a,0x97,0xfb,0xb9,0x4d,0x2f,0xbe,0xe5,0x6b,0x93,0xa7,0x77,0xc5,0x32,0x76,0xd7,0x62,0x9c,0x61,0xa9,0x63}, 0},
+    {{0xa5,0xfb,0xec,0x87,0x7e,0xb1,0x84,0x2f,0xa9,0x76,0xf5,0x1c,0xea,0x75,0x6c,0xfa,0x88,0x7c,0x39,0xc1,0xf1,0xbf,0x6b,0x0b,0x93,0xbb,0x9b,0x4f,0xa6,0xb9,0xa3,0xed}, 0},
+    {{0xa5,0xfb,0xec,0x87,0x7e,0xb1,0x84,0x2f,0xa9,0x76,0xf5,0x1c,0xea,0x75,0x6c,0xfa,0x88,0x7c,0x39,0xc1,0xf1,0xbf,0x6b,0x0b,0x93,0xbb,0x9b,0x4f,0xa6,0xb9,0xa3,0xed}, 1},
+    {{0xa6,0x6e,0x58,0x98,0x0e,0x46,0x7e,0x63,0xca,0xbc,0x7d,0xfc,0x9f,0x69,0xe4,0xd7,0x60,0xd9,0xef,0x42,0x2f,0x25,0x2d,0x96,0x55,0xc6,0x09,0x23,0x7b,0x45,0x5f,0x30}, 0},
+    {{0xa6,0xbe,0x38,0x2f,0x47,0x0e,0x72,0x9a,0xb0,0x7c,0xd7,0x1f,0xfa,0xe4,0x8a,0xaa,0xca,0x67,0x6f,0x22,0xe7,0x42,0xca,0xee,0xd1,0x33,0xf8,0xef,0x97,0x47,0x58,0xcd}, 0},
+    {{0xa6,0xbe,0x38,0x2f,0x47,0x0e,0x72,0x9a,0xb0,0x7c,0xd7,0x1f,0xfa,0xe4,0x8a,0xaa,0xca,0x67,0x6f,0x22,0xe7,0x42,0xca,0xee,0xd1,0x33,0xf8,0xef,0x97,0x47,0x58,0xcd}, 1},
+    {{0xa6,0xcc,0x11,0x99,0xa8,0xbf,0x3d,0xa5,0x82,0xa1,0x82,0x78,0x79,0xc8,0x6f,0x19,0x88,0x71,0x7e,0x04,0x3e,0xc0,0xed,0x35,0x0e,0x79,0xda,0xf8,0xea,0xa9,0xbf,0x8f}, 0},
+    {{0xa6,0xdd,0x5d,0x1a,0xb4,0xd9,0xcc,0x2a,0x57,0xf8,0xc9,0xb2,0xe6,0xad,0x3e,0x30,0xe6,0x36,0xc7,0x98,0x9c,0xd2,0x3d,0x05,0xe7,0x1b,0x21,0xd0,0xe7,0xf6,0xd8,0x8a}, 0},
+    {{0xa7,0x17,0x53,0xa8,0x57,0xfe,0x72,0x97,0x22,0xd3,0x81,0xdc,0x59,0x02,0x60,0xea,0xd4,0x85,0xed,0x8f,0xdf,0xfd,0xc8,0x15,0xb8,0x6d,0x48,0xa0,0x1b,0x1d,0x2e,0x69}, 0},
+    {{0xa7,0x17,0x53,0xa8,0x57,0xfe,0x72,0x97,0x22,0xd3,0x81,0xdc,0x59,0x02,0x60,0xea,0xd4,0x85,0xed,0x8f,0xdf,0xfd,0xc8,0x15,0xb8,0x6d,0x48,0xa0,0x1b,0x1d,0x2e,0x69}, 1},
+    {{0xa7,0x25,0x76,0xb7,0x4f,0xdb,0x9a,0xe9,0x0a,0x96,0x20,0x89,0x13,0x88,0xca,0x99,0x6d,0x3e,0x7f,0xdb,0xfc,0x82,0x29,0x79,0x8d,0xa8,0xb1,0xed,0x4e,0xd9,0xfd,0x75}, 0},
+    {{0xa7,0x25,0x76,0xb7,0x4f,0xdb,0x9a,0xe9,0x0a,0x96,0x20,0x89,0x13,0x88,0xca,0x99,0x6d,0x3e,0x7f,0xdb,0xfc,0x82,0x29,0x79,0x8d,0xa8,0xb1,0xed,0x4e,0xd9,0xfd,0x75}, 1},
+    {{0xa7,0x35,0x36,0x0b,0x5b,0x9f,0xb0,0x31,0x07,0xfa,0x2c,0x34,0x20,0x7e,0x5b,0x75,0xeb,0x97,0x91,0x99,0x85,0x02,0x58,0x59,0x82,0xfc,0xed,0x99,0x7f,0x5b,0xd7,0xa5}, 0},
+    {{0xa7,0x35,0x36,0x0b,0x5b,0x9f,0xb0,0x31,0x07,0xfa,0x2c,0x34,0x20,0x7e,0x5b,0x75,0xeb,0x97,0x91,0x99,0x85,0x02,0x58,0x59,0x82,0xfc,0xed,0x99,0x7f,0x5b,0xd7,0xa5}, 1},
+    {{0xa7,0x4a,0x24,0x36,0x8c,0xb9,0xde,0x94,0x48,0x09,0xd8,0xf6,0xe7,0xbd,0x77,0x31,0xe2,0xc2,0x93,0x26,0xec,0x03,0x8c,0x46,0x85,0xa9,0x2c,0x5f,0xab,0x39,0x03,0x57}, 0},
+    {{0xa7,0x4a,0x24,0x36,0x8c,0xb9,0xde,0x94,0x48,0x09,0xd8,0xf6,0xe7,0xbd,0x77,0x31,0xe2,0xc2,0x93,0x26,0xec,0x03,0x8c,0x46,0x85,0xa9,0x2c,0x5f,0xab,0x39,0x03,0x57}, 1},
+    {{0xa7,0x73,0x2e,0xc2,0x53,0x6b,0x13,0xc9,0x36,0x04,0x73,0xce,0xd0,0xac,0x32,0x85,0x84,0x31,0xf2,0x96,0x87,0x80,0x8e,0x00,0xad,0xa6,0xd1,0x29,0x54,0xa2,0x38,0xe4}, 0},
+    {{0xa7,0x73,0x2e,0xc2,0x53,0x6b,0x13,0xc9,0x36,0x04,0x73,0xce,0xd0,0xac,0x32,0x85,0x84,0x31,0xf2,0x96,0x87,0x80,0x8e,0x00,0xad,0xa6,0xd1,0x29,0x54,0xa2,0x38,0xe4}, 1},
+    {{0xa8,0x41,0x6f,0x64,0x9e,0x4e,0x70,0x2d,0xf3,0x74,0x5f,0xf1,0xde,0xdc,0x1f,0xb8,0xab,0x97,0xe6,0xc3,0xc8,0x30,0x87,0xbe,0x59,0x24,0xd1,0x26,0x94,0x81,0xda,0x2f}, 0},
+    {{0xa8,0x41,0x6f,0x64,0x9e,0x4e,0x70,0x2d,0xf3,0x74,0x5f,0xf1,0xde,0xdc,0x1f,0xb8,0xab,0x97,0xe6,0xc3,0xc8,0x30,0x87,0xbe,0x59,0x24,0xd1,0x26,0x94,0x81,0xda,0x2f}, 1},
+    {{0xa8,0x98,0x49,0x09,0x43,0xaf,0x8a,0x5c,0x11,0x89,0x8c,0xf7,0x08,0xa5,0x33,0xe6,0x54,0x9d,0x30,0xd0,0x1b,0x93,0xec,0x4d,0x05,0xe7,0xe3,0xca,0xb5,0x2f,0x2e,0x54}, 0},
+    {{0xa8,0xa8,0x9e,0x3e,0x18,0x3f,0x18,0xe7,0x2b,0x4d,0x6e,0x19,0x19,0x68,0xbb,0xc5,0xa9,0x74,0x02,0x0d,0xfd,0x02,0xcc,0xee,0xf5,0xc6,0xf0,0x56,0xd0,0x48,0x45,0xee}, 0},
+    {{0xa8,0xa8,0x9e,0x3e,0x18,0x3f,0x18,0xe7,0x2b,0x4d,0x6e,0x19,0x19,0x68,0xbb,0xc5,0xa9,0x74,0x02,0x0d,0xfd,0x02,0xcc,0xee,0xf5,0xc6,0xf0,0x56,0xd0,0x48,0x45,0xee}, 1},
+    {{0xa8,0xc6,0x75,0xe4,0x0e,0x3f,0xc0,0xc7,0x68,0xb8,0xa9,0x4c,0xdf,0x74,0x9d,0x8c,0xa0,0x90,0xaf,0xb4,0x63,0xd2,0x0e,0x71,0xbb,0x31,0x63,0x8b,0xba,0x52,0xa1,0x78}, 0},
+    {{0xa8,0xc6,0x75,0xe4,0x0e,0x3f,0xc0,0xc7,0x68,0xb8,0xa9,0x4c,0xdf,0x74,0x9d,0x8c,0xa0,0x90,0xaf,0xb4,0x63,0xd2,0x0e,0x71,0xbb,0x31,0x63,0x8b,0xba,0x52,0xa1,0x78}, 1},
+    {{0xa8,0xda,0x88,0x6b,0x63,0x59,0x07,0xe3,0xcc,0x91,0x2d,0xfc,0xe8,0x1b,0xfc,0x60,0x81,0x1f,0x00,0xd2,0xbb,0x0c,0x26,0x2b,0x63,0x90,0x81,0xcb,0xdf,0x8d,0x97,0x71}, 0},
+    {{0xa8,0xe9,0xee,0x92,0x4b,0x4e,0x64,0xd5,0xf4,0x91,0xf4,0x06,0xb5,0xc3,0x17,0x86,0xcf,0x06,0x61,0x90,0x80,0xff,0x67,0xf0,0xe2,0x42,0xe2,0xdc,0x21,0x5a,0x53,0x7e}, 0},
+    {{0xa8,0xe9,0xee,0x92,0x4b,0x4e,0x64,0xd5,0xf4,0x91,0xf4,0x06,0xb5,0xc3,0x17,0x86,0xcf,0x06,0x61,0x90,0x80,0xff,0x67,0xf0,0xe2,0x42,0xe2,0xdc,0x21,0x5a,0x53,0x7e}, 1},
+    {{0xa9,0x43,0x44,0x07,0xcd,0xa1,0x13,0xfd,0x47,0x36,0x9a,0x81,0xe4,0xaa,0x89,0xa0,0x73,0xb6,0x56,0x1c,0x40,0xe8,0xb0,0xb0,0x93,0xf2,0x71,0xd5,0xa5,0x81,0x2a,0x86}, 0},
+    {{0xa9,0x43,0x44,0x07,0xcd,0xa1,0x13,0xfd,0x47,0x36,0x9a,0x81,0xe4,0xaa,0x89,0xa0,0x73,0xb6,0x56,0x1c,0x40,0xe8,0xb0,0xb0,0x93,0xf2,0x71,0xd5,0xa5,0x81,0x2a,0x86}, 1},
+    {{0xa9,0x56,0x5c,0xcf,0x27,0xc2,0xdd,0xf0,0xca,0x54,0x84,0x89,0x7a,0xbd,0x89,0x6a,0x06,0x97,0xda,0xeb,0xb8,0x81,0xe1,0x0b,0xa8,0x61,0x46,0xf0,0x48,0xa7,0xb1,0x51}, 0},
+    {{0xa9,0x56,0x5c,0xcf,0x27,0xc2,0xdd,0xf0,0xca,0x54,0x84,0x89,0x7a,0xbd,0x89,0x6a,0x06,0x97,0xda,0xeb,0xb8,0x81,0xe1,0x0b,0xa8,0x61,0x46,0xf0,0x48,0xa7,0xb1,0x51}, 1},
+    {{0xa9,0x98,0x19,0xe4,0x48,0x29,0xf5,0x0c,0x76,0x43,0xf7,0x6f,0xfa,0x3d,0xdd,0x5b,0x52,0xd7,0x73,0xa1,0x5e,0x6d,0xaa,0xcd,0xf0,0xb3,0xe3,0x86,0x8a,0xc4,0x1a,0x61}, 0},
+    {{0xa9,0xf5,0xb0,0xb7,0xcd,0x54,0x02,0xe1,0x72,0xf5,0x1d,0x45,0xd0,0xb4,0x7f,0x19,0x31,0xe1,0x78,0x05,0x65,0x41,0x93,0x89,0xa9,0xb0,0xc9,0x9e,0xce,0x47,0xe0,0x7f}, 0},
+    {{0xaa,0x04,0x51,0xe0,0xe8,0xeb,0x2a,0xb3,0x84,0x74,0x59,0xf0,0xd8,0xcc,0x66,0xd1,0x6c,0x8f,0xde,0x2d,0x66,0xe8,0x6e,0x3c,0x68,0x00,0x0f,0x2f,0xfc,0x0f,0x73,0x05}, 0},
+    {{0xaa,0x0b,0xe9,0xac,0xa5,0xf4,0xac,0x61,0x37,0x9c,0xa8,0x3b,0x18,0x12,0x05,0xab,0xe2,0xce,0x41,0x4f,0x5c,0x92,0x55,0xa9,0xf6,0x9f,0x27,0x1f,0xdd,0xac,0xa9,0xe2}, 0},
+    {{0xaa,0x0b,0xe9,0xac,0xa5,0xf4,0xac,0x61,0x37,0x9c,0xa8,0x3b,0x18,0x12,0x05,0xab,0xe2,0xce,0x41,0x4f,0x5c,0x92,0x55,0xa9,0xf6,0x9f,0x27,0x1f,0xdd,0xac,0xa9,0xe2}, 1},
+    {{0xaa,0xad,0x91,0xc9,0xc8,0x7d,0x1e,0x30,0x14,0x00,0xec,0x92,0xab,0xf8,0x1b,0x7d,0x12,0x6a,0x03,0x41,0xba,0x99,0x9b,0xf8,0x29,0x2c,0x36,0xb8,0xd8,0x35,0x24,0x9e}, 0},
+    {{0xaa,0xad,0x91,0xc9,0xc8,0x7d,0x1e,0x30,0x14,0x00,0xec,0x92,0xab,0xf8,0x1b,0x7d,0x12,0x6a,0x03,0x41,0xba,0x99,0x9b,0xf8,0x29,0x2c,0x36,0xb8,0xd8,0x35,0x24,0x9e}, 1},
+    {{0xaa,0xb5,0x0f,0x0d,0xc0,0xfe,0x0c,0x47,0x8d,0xbc,0x26,0xd0,0x12,0x59,0x25,0x91,0x47,0x30,0x38,0x37,0x4e,0xcb,0xe3,0xdc,0xa8,0xb7,0x8f,0x61,0x23,0x50,0xf7,0xaa}, 0},
+    {{0xaa,0xd7,0x56,0x67,0x08,0x8f,0xd9,0x68,0x8e,0x67,0xb7,0x95,0xc6,0x7a,0x4d,0x73,0x1e,0x28,0x5e,0x77,0x6d,0x11,0x36,0x30,0x29,0x6e,0xee,0x4d,0xb4,0x0f,0x89,0xed}, 0},
+    {{0xaa,0xd7,0x56,0x67,0x08,0x8f,0xd9,0x68,0x8e,0x67,0xb7,0x95,0xc6,0x7a,0x4d,0x73,0x1e,0x28,0x5e,0x77,0x6d,0x11,0x36,0x30,0x29,0x6e,0xee,0x4d,0xb4,0x0f,0x89,0xed}, 1},
+    {{0xab,0x07,0x6a,0x4d,0x1a,0x37,0xbe,0x1e,0x3b,0xe0,0xae,0x3c,0x0e,0xa0,0x6f,0x6f,0x0f,0x03,0xff,0xe1,0x87,0xfa,0xc4,0x53,0x65,0x60,0x16,0xb9,0xdd,0xbf,0x09,0xe4}, 0},
+    {{0xab,0x13,0x50,0xcf,0xbd,0x33,0xb6,0xa8,0x5d,0xde,0xe2,0xf6,0x68,0xf3,0xb0,0x80,0xb8,0x49,0xc7,0x24,0xcb,0x73,0x75,0x95,0x5b,0x8c,0xcd,0x97,0xa2,0x70,0x4c,0xad}, 0},
+    {{0xab,0x13,0x50,0xcf,0xbd,0x33,0xb6,0xa8,0x5d,0xde,0xe2,0xf6,0x68,0xf3,0xb0,0x80,0xb8,0x49,0xc7,0x24,0xcb,0x73,0x75,0x95,0x5b,0x8c,0xcd,0x97,0xa2,0x70,0x4c,0xad}, 1},
+    {{0xab,0x24,0x09,0xce,0x7d,0xbf,0xbb,0x3f,0xfb,0x6a,0x98,0x16,0xb3,0x8e,0x77,0x76,0x18,0xa0,0x20,0xcb,0x1f,0xf8,0x51,0x7c,0x7f,0x0c,0xac,0xf3,0x0f,0xd1,0x51,0x35}, 0},
+    {{0xab,0x8b,0x6a,0x54,0x49,0x7c,0x61,0x41,0xd8,0x83,0x47,0x9c,0x6e,0x10,0x4b,0x10,0xd4,0x0e,0x9b,0x2d,0xa6,0xfd,0x66,0xf3,0x97,0x10,0x96,0xa2,0x47,0x42,0x5e,0xae}, 0},
+    {{0xab,0x8b,0x6a,0x54,0x49,0x7c,0x61,0x41,0xd8,0x83,0x47,0x9c,0x6e,0x10,0x4b,0x10,0xd4,0x0e,0x9b,0x2d,0xa6,0xfd,0x66,0xf3,0x97,0x10,0x96,0xa2,0x47,0x42,0x5e,0xae}, 1},
+    {{0xab,0xc7,0x55,0x53,0x12,0xdf,0xc1,0xa9,0x4b,0x50,0x79,0x25,0xf1,0x45,0xed,0x16,0xe9,0xfd,0x26,0x34,0x78,0xd7,0x07,0x44,0xe2,0x4d,0x85,0xbc,0xac,0x53,0x23,0x84}, 0},
+    {{0xab,0xc7,0x55,0x53,0x12,0xdf,0xc1,0xa9,0x4b,0x50,0x79,0x25,0xf1,0x45,0xed,0x16,0xe9,0xfd,0x26,0x34,0x78,0xd7,0x07,0x44,0xe2,0x4d,0x85,0xbc,0xac,0x53,0x23,0x84}, 1},
+    {{0xab,0xdd,0x6b,0x1a,0xbb,0x0d,0x0e,0xc0,0x76,0xf9,0xbb,0xb8,0xd9,0xe2,0x2b,0x52,0x0d,0x5e,0x31,0x98,0x8c,0x6c,0xcc,0xb2,0x77,0x9e,0x9a,0xd0,0x05,0x1c,0x3e,0x25}, 0},
+    {{0xac,0x56,0x4a,0xca,0xcc,0xbb,0xa2,0x53,0x94,0x3e,0x47,0x5a,0x31,0x5a,0xca,0x34,0xe5,0x40,0x64,0x5a,0xca,0xd2,0xef,0xa2,0x53,0x42,0xc6,0x92,0x3e,0xbb,0x17,0xbb}, 0},
+    {{0xac,0x6a,0x27,0x8f,0xf3,0x67,0x82,0xf1,0xff,0x5b,0x13,0xcd,0x40,0xfd,0x85,0x13,0x85,0xf7,0x3e,0x6b,0x9d,0xbe,0x85,0xdb,0x8f,0xe4,0x01,0x8f,0x8f,0x27,0x46,0x42}, 0},
+    {{0xac,0x72,0x7c,0x37,0xc2,0xfb,0x06,0x07,0x7a,0xcf,0x9d,0x13,0x6e,0x67,0xe5,0x2c,0x18,0x99,0xe2,0xcf,0xc3,0x1b,0xd7,0xd0,0x5e,0x8a,0x4a,0x7c,0x66,0xdc,0x2b,0x9c}, 0},
+    {{0xac,0x72,0x7c,0x37,0xc2,0xfb,0x06,0x07,0x7a,0xcf,0x9d,0x13,0x6e,0x67,0xe5,0x2c,0x18,0x99,0xe2,0xcf,0xc3,0x1b,0xd7,0xd0,0x5e,0x8a,0x4a,0x7c,0x66,0xdc,0x2b,0x9c}, 1},
+    {{0xac,0x8c,0x59,0x61,0xc9,0x5a,0x6e,0xbc,0x7a,0x44,0xec,0x80,0xec,0xc8,0xcf,0x3b,0xc5,0xcf,0x10,0x45,0xaa,0x73,0x2a,0xb8,0x76,0xc7,0x68,0x9c,0x8a,0x0a,0xc3,0xe9}, 0},
+    {{0xac,0x8c,0x59,0x61,0xc9,0x5a,0x6e,0xbc,0x7a,0x44,0xec,0x80,0xec,0xc8,0xcf,0x3b,0xc5,0xcf,0x10,0x45,0xaa,0x73,0x2a,0xb8,0x76,0xc7,0x68,0x9c,0x8a,0x0a,0xc3,0xe9}, 1},
+    {{0xac,0xd2,0x53,0x46,0x93,0xfe,0x50,0x14,0xee,0x67,0x7d,0x42,0x63,0xc8,0xd4,0xe8,0xa9,0x72,0x9c,0x84,0x92,0xde,0x26,0xe5,0xdc,0x7f,0x4f,0xe8,0xba,0xac,0x6a,0x16}, 0},
+    {{0xac,0xd2,0x53,0x46,0x93,0xfe,0x50,0x14,0xee,0x67,0x7d,0x42,0x63,0xc8,0xd4,0xe8,0xa9,0x72,0x9c,0x84,0x92,0xde,0x26,0xe5,0xdc,0x7f,0x4f,0xe8,0xba,0xac,0x6a,0x16}, 1},
+    {{0xac,0xe0,0xd1,0xe6,0x60,0x34,0x54,0x88,0xf0,0x6c,0x51,0x4b,0x5c,0x7e,0x90,0xa3,0x17,0xf9,0xaf,0x08,0x0c,0x3c,0x01,0x39,0xab,0x89,0x6b,0x29,0x96,0x8c,0x75,0x35}, 0},
+    {{0xac,0xe3,0x58,0x89,0x3a,0xd0,0x6b,0x74,0x5e,0x82,0xbb,0x42,0xc5,0xb0,0x5e,0xe9,0xd7,0x16,0xd5,0xc8,0xc6,0xf6,0x40,0x5a,0x87,0x59,0x4e,0xe2,0xd5,0x04,0x11,0x57}, 0},
+    {{0xac,0xe3,0x58,0x89,0x3a,0xd0,0x6b,0x74,0x5e,0x82,0xbb,0x42,0xc5,0xb0,0x5e,0xe9,0xd7,0x16,0xd5,0xc8,0xc6,0xf6,0x40,0x5a,0x87,0x59,0x4e,0xe2,0xd5,0x04,0x11,0x57}, 1},
+    {{0xad,0xd0,0xfa,0xa4,0xcc,0xcd,0x88,0x0c,0xa9,0x93,0x09,0xf7,0xc7,0xe0,0x83,0xd7,0xb9,0xfe,0x65,0x47,0x5f,0xfe,0xc3,0xad,0x4c,0x2c,0xb1,0x8c,0x9f,0x64,0x73,0xec}, 0},
+    {{0xad,0xd7,0x67,0x8e,0x94,0xcc,0x9a,0xf2,0xd7,0xc2,0xc3,0x04,0x61,0xb7,0x36,0x92,0x09,0x57,0x23,0xc3,0x27,0xf1,0xd1,0x36,0xc2,0xeb,0xc7,0xce,0x89,0xdd,0x56,0xec}, 0},
+    {{0xad,0xd7,0x67,0x8e,0x94,0xcc,0x9a,0xf2,0xd7,0xc2,0xc3,0x04,0x61,0xb7,0x36,0x92,0x09,0x57,0x23,0xc3,0x27,0xf1,0xd1,0x36,0xc2,0xeb,0xc7,0xce,0x89,0xdd,0x56,0xec}, 1},
+    {{0xad,0xe1,0xdb,0xc2,0x9c,0x50,0xd3,0xbf,0xd5,0x35,0xfa,0xdc,0x3a,0xfc,0xf7,0x9b,0xde,0x77,0x5b,0xfb,0xc9,0xa8,0x40,0x44,0x4f,0xe9,0xa2,0x90,0x59,0xc3,0xc7,0x11}, 0},
+    {{0xad,0xef,0x59,0xd7,0xf4,0xe6,0xda,0x91,0x79,0x20,0x4f,0x22,0x7e,0x6a,0xd2,0xe1,0xf9,0x71,0x62,0x1d,0x98,0x21,0x61,0xf9,0xc8,0x07,0x80,0x61,0xbd,0x73,0xd1,0x14}, 0},
+    {{0xae,0x76,0xbd,0x7a,0xf2,0x70,0x5b,0x0a,0x41,0x6e,0x98,0x05,0x51,0x97,0x1e,0x46,0x84,0x55,0xf1,0x12,0xf5,0x8b,0xd4,0xf0,0x9a,0x81,0x76,0xac,0xe7,0x84,0xc6,0xb9}, 0},
+    {{0xae,0x7e,0x9b,0x37,0x5e,0xe6,0x80,0xa6,0xb4,0xa0,0xbd,0x03,0x47,0xfe,0x7b,0x7d,0x97,0x4e,0x2e,0xa5,0x61,0x3d,0xa1,0xca,0xf8,0x39,0x7a,0x90,0x18,0x47,0x48,0x02}, 0},
+    {{0xae,0x7e,0x9b,0x37,0x5e,0xe6,0x80,0xa6,0xb4,0xa0,0xbd,0x03,0x47,0xfe,0x7b,0x7d,0x97,0x4e,0x2e,0xa5,0x61,0x3d,0xa1,0xca,0xf8,0x39,0x7a,0x90,0x18,0x47,0x48,0x02}, 1},
+    {{0xae,0xa6,0x9f,0x24,0x32,0x5d,0x3a,0xf4,0x00,0xa6,0x1c,0x83,0xb4,0xd2,0x4a,0x19,0x75,0x6c,0x11,0x51,0x92,0xb0,0xca,0xd6,0xc9,0x0b,0x4d,0x4c,0xd5,0x80,0x86,0x9f}, 0},
+    {{0xae,0xa6,0x9f,0x24,0x32,0x5d,0x3a,0xf4,0x00,0xa6,0x1c,0x83,0xb4,0xd2,0x4a,0x19,0x75,0x6c,0x11,0x51,0x92,0xb0,0xca,0xd6,0xc9,0x0b,0x4d,0x4c,0xd5,0x80,0x86,0x9f}, 1},
+    {{0xae,0xda,0x7e,0x3e,0x0e,0x4a,0xb2,0xb6,0x4e,0xf0,0x98,0x91,0x08,0x33,0xd9,0x95,0xce,0xf5,0x7d,0x42,0xc9,0xb8,0x9e,0x5c,0x42,0x83,0x7f,0x59,0x5d,0xd0,0x68,0x69}, 0},
+    {{0xae,0xda,0x7e,0x3e,0x0e,0x4a,0xb2,0xb6,0x4e,0xf0,0x98,0x91,0x08,0x33,0xd9,0x95,0xce,0xf5,0x7d,0x42,0xc9,0xb8,0x9e,0x5c,0x42,0x83,0x7f,0x59,0x5d,0xd0,0x68,0x69}, 1},
+    {{0xaf,0x11,0x41,0xff,0x77,0xff,0x3b,0xfb,0xc0,0xc8,0x78,0x2d,0x52,0x35,0xbf,0x60,0x34,0x45,0xd5,0xce,0x96,0x2a,0xea,0x83,0xfb,0x48,0xe3,0x8b,0x17,0xdb,0xd3,0x3e}, 0},
+    {{0xaf,0x11,0x41,0xff,0x77,0xff,0x3b,0xfb,0xc0,0xc8,0x78,0x2d,0x52,0x35,0xbf,0x60,0x34,0x45,0xd5,0xce,0x96,0x2a,0xea,0x83,0xfb,0x48,0xe3,0x8b,0x17,0xdb,0xd3,0x3e}, 1},
+    {{0xaf,0x31,0xac,0x3e,0xf3,0xc5,0x4b,0xc1,0x09,0x88,0x8f,0xa6,0xf7,0x15,0xbe,0x7e,0xd5,0xc7,0x96,0x26,0x14,0xdc,0x47,0x2a,0x67,0x84,0xd4,0xcd,0xc7,0xaf,0xbb,0x73}, 0},
+    {{0xaf,0x8e,0x80,0xb9,0xdf,0x9f,0x84,0x8f,0x18,0xb5,0x82,0xab,0x56,0x09,0x62,0x62,0x38,0x23,0xe9,0xfe,0xe6,0xa6,0x5b,0xa2,0xdc,0x9b,0xdb,0x47,0xe7,0xef,0x10,0x33}, 0},
+    {{0xaf,0x8e,0x80,0xb9,0xdf,0x9f,0x84,0x8f,0x18,0xb5,0x82,0xab,0x56,0x09,0x62,0x62,0x38,0x23,0xe9,0xfe,0xe6,0xa6,0x5b,0xa2,0xdc,0x9b,0xdb,0x47,0xe7,0xef,0x10,0x33}, 1},
+    {{0xaf,0xee,0xc3,0x4b,0xbd,0xe5,0xcf,0xe9,0xca,0xf4,0x06,0xa6,0xfd,0xbd,0x0e,0x03,0xd6,0x47,0x8e,0x61,0x78,0x09,0xec,0xb3,0xed,0x4e,0x39,0xe0,0x43,0xcb,0x6f,0x85}, 0},
+    {{0xaf,0xf3,0x82,0xea,0x6a,0xcf,0x1d,0x14,0xd0,0xe9,0x7c,0x2c,0xe7,0xeb,0x78,0x9a,0xe4,0xe0,0x2d,0xf7,0x75,0xb9,0x84,0x62,0xac,0x76,0x1a,0xd4,0x2b,0xe5,0xd2,0x25}, 0},
+    {{0xaf,0xf3,0x82,0xea,0x6a,0xcf,0x1d,0x14,0xd0,0xe9,0x7c,0x2c,0xe7,0xeb,0x78,0x9a,0xe4,0xe0,0x2d,0xf7,0x75,0xb9,0x84,0x62,0xac,0x76,0x1a,0xd4,0x2b,0xe5,0xd2,0x25}, 1},
+    {{0xb0,0x09,0xb5,0x14,0x4d,0x09,0xda,0x90,0x0a,0xf3,0x13,0x4c,0xe0,0xa2,0x82,0x0d,0xc4,0x29,0xbe,0x9e,0xb9,0xe9,0x39,0x46,0x30,0x54,0x98,0xb9,0xdd,0xf6,0x5f,0x80}, 0},
+    {{0xb0,0x0d,0xcc,0xaf,0x2d,0xd7,0x18,0xb1,0xab,0x99,0x27,0xd7,0x3a,0x46,0x13,0xcf,0x26,0x9c,0x87,0x15,0xc1,0x90,0xd0,0xfa,0x1a,0x60,0x12,0x30,0x32,0x25,0x69,0xa3}, 0},
+    {{0xb0,0x0d,0xcc,0xaf,0x2d,0xd7,0x18,0xb1,0xab,0x99,0x27,0xd7,0x3a,0x46,0x13,0xcf,0x26,0x9c,0x87,0x15,0xc1,0x90,0xd0,0xfa,0x1a,0x60,0x12,0x30,0x32,0x25,0x69,0xa3}, 1},
+    {{0xb0,0xfa,0x91,0xf6,0x05,0x7f,0x60,0x0d,0x80,0xf8,0x12,0xdd,0xa3,0x18,0x17,0x22,0x2e,0xc1,0xb3,0x2a,0x38,0x95,0x0a,0xc4,0x4b,0x95,0x03,0x85,0x20,0x14,0x12,0x11}, 0},
+    {{0xb0,0xfa,0x91,0xf6,0x05,0x7f,0x60,0x0d,0x80,0xf8,0x12,0xdd,0xa3,0x18,0x17,0x22,0x2e,0xc1,0xb3,0x2a,0x38,0x95,0x0a,0xc4,0x4b,0x95,0x03,0x85,0x20,0x14,0x12,0x11}, 1},
+    {{0xb1,0x40,0xc8,0x3e,0xb4,0x53,0xfd,0x80,0x9e,0xa8,0xd3,0x34,0x20,0x7b,0xc9,0x50,0x0d,0x36,0x14,0xc0,0xe6,0x12,0x5a,0xf5,0x31,0x0c,0xc2,0x92,0xbc,0xae,0x88,0x10}, 0},
+    {{0xb1,0x4b,0x69,0xc5,0xcb,0xcf,0x6c,0xa4,0x58,0x0b,0xc1,0x0b,0x0a,0x75,0xf1,0xbd,0xf1,0x70,0x49,0xb5,0x00,0x58,0xe3,0xb5,0xd2,0x9b,0x27,0x2c,0xc1,0x3e,0xd2,0xb1}, 0},
+    {{0xb1,0x74,0x9c,0x10,0x71,0x9a,0xfe,0xa9,0x71,0x58,0x16,0xa4,0xe2,0xd4,0xe8,0x33,0xe7,0xbf,0xbd,0xd8,0x16,0x73,0x26,0x0b,0x00,0x6d,0xce,0xb0,0xf8,0x96,0x1a,0xc5}, 0},
+    {{0xb1,0x74,0x9c,0x10,0x71,0x9a,0xfe,0xa9,0x71,0x58,0x16,0xa4,0xe2,0xd4,0xe8,0x33,0xe7,0xbf,0xbd,0xd8,0x16,0x73,0x26,0x0b,0x00,0x6d,0xce,0xb0,0xf8,0x96,0x1a,0xc5}, 1},
+    {{0xb1,0xb9,0x1c,0x71,0xf4,0xd9,0xd1,0xb7,0x9a,0x88,0xde,0x95,0xf2,0x81,0x1b,0xc9,0xba,0x46,0xce,0x70,0xa1,0x03,0xb2,0x81,0xe2,0xd5,0x91,0x1c,0xf7,0x88,0xeb,0x38}, 0},
+    {{0xb1,0xb9,0xb2,0x3b,0x6a,0x6a,0x3f,0xab,0xce,0xc8,0xe3,0xbe,0x06,0x7c,0xec,0xf3,0x8e,0x9f,0x98,0xea,0xa7,0xdd,0x77,0xd5,0x59,0x6e,0x29,0x31,0xe2,0x3d,0xad,0xbf}, 0},
+    {{0xb1,0xf0,0xe3,0x25,0x1d,0xc3,0xb3,0x8b,0x75,0x55,0x45,0xa9,0x93,0x5e,0x00,0x3e,0xb8,0x88,0x78,0x6b,0xf4,0x16,0x2a,0x28,0xa3,0x97,0x56,0xb3,0x62,0x45,0x66,0xdf}, 0},
+    {{0xb2,0x31,0x23,0xe1,0x2f,0xbc,0xeb,0x65,0x43,0x5a,0x66,0x33,0x9b,0xbd,0x67,0x56,0x96,0xcd,0x23,0xa4,0xa2,0x20,0x9e,0x02,0x39,0xdd,0x35,0x29,0x0f,0xb4,0x24,0x7e}, 0},
+    {{0xb2,0x31,0x23,0xe1,0x2f,0xbc,0xeb,0x65,0x43,0x5a,0x66,0x33,0x9b,0xbd,0x67,0x56,0x96,0xcd,0x23,0xa4,0xa2,0x20,0x9e,0x02,0x39,0xdd,0x35,0x29,0x0f,0xb4,0x24,0x7e}, 1},
+    {{0xb2,0x47,0x88,0x2f,0xd1,0x3b,0x8c,0x9c,0xea,0xf8,0xd1,0xe0,0xf9,0x43,0xff,0x84,0xe7,0x12,0xda,0x84,0xc2,0xf3,0xfb,0xf7,0x83,0x72,0x48,0xe0,0x9f,0x9b,0xbe,0x58}, 0},
+    {{0xb2,0x4a,0x1a,0xa1,0x37,0x8b,0xcd,0xd9,0x75,0xfd,0x0a,0xfa,0x14,0x2c,0xc5,0xac,0xf5,0xfe,0x96,0x42,0xc1,0x5c,0x17,0xbd,0xf4,0x04,0xe3,0x7a,0xc1,0x3a,0xb9,0x0e}, 0},
+    {{0xb2,0x4a,0x1a,0xa1,0x37,0x8b,0xcd,0xd9,0x75,0xfd,0x0a,0xfa,0x14,0x2c,0xc5,0xac,0xf5,0xfe,0x96,0x42,0xc1,0x5c,0x17,0xbd,0xf4,0x04,0xe3,0x7a,0xc1,0x3a,0xb9,0x0e}, 1},
+    {{0xb2,0x9d,0x5a,0x25,0x38,0xca,0xf6,0x41,0xcc,0x00,0x3e,0x50,0x37,0xaa,0x3a,0xa3,0x9e,0x7b,0x7c,0x46,0xaa,0xcd,0x1c,0x2b,0xdc,0x5c,0xa6,0x4f,0x55,0xec,0x3a,0xc4}, 0},
+    {{0xb2,0x9d,0x5a,0x25,0x38,0xca,0xf6,0x41,0xcc,0x00,0x3e,0x50,0x37,0xaa,0x3a,0xa3,0x9e,0x7b,0x7c,0x46,0xaa,0xcd,0x1c,0x2b,0xdc,0x5c,0xa6,0x4f,0x55,0xec,0x3a,0xc4}, 1},
+    {{0xb2,0xdd,0x1f,0x49,0xd2,0xad,0x29,0x47,0x7c,0x41,0x26,0x86,0x85,0xac,0xd0,0x7e,0xf6,0x2f,0xc8,0x21,0x07,0xc8,0x2f,0x7a,0x4d,0x9d,0xff,0x30,0x63,0x7f,0xa7,0x4d}, 0},
+    {{0xb3,0x5d,0x79,0xdc,0x4c,0xf4,0xb1,0x7a,0xf1,0x70,0x77,0xb5,0x25,0xaa,0x91,0x58,0xde,0x28,0x5b,0xd6,0x65,0xd2,0x76,0x62,0x0d,0x9c,0x9e,0xad,0xfb,0x70,0x4b,0xd1}, 0},
+    {{0xb3,0x5d,0x79,0xdc,0x4c,0xf4,0xb1,0x7a,0xf1,0x70,0x77,0xb5,0x25,0xaa,0x91,0x58,0xde,0x28,0x5b,0xd6,0x65,0xd2,0x76,0x62,0x0d,0x9c,0x9e,0xad,0xfb,0x70,0x4b,0xd1}, 1},
+    {{0xb3,0x65,0x01,0x1d,0xdc,0x07,0xe9,0x4d,0x42,0xef,0x56,0x51,0x63,0x40,0x11,0x42,0x72,0xef,0x45,0x8f,0x11,0x4e,0x9b,0x86,0x86,0xdb,0xc5,0x5a,0xef,0xf0,0x2d,0x0a}, 0},
+    {{0xb3,0x65,0x01,0x1d,0xdc,0x07,0xe9,0x4d,0x42,0xef,0x56,0x51,0x63,0x40,0x11,0x42,0x72,0xef,0x45,0x8f,0x11,0x4e,0x9b,0x86,0x86,0xdb,0xc5,0x5a,0xef,0xf0,0x2d,0x0a}, 1},
+    {{0xb3,0x9d,0xc1,0x8c,0x0e,0xda,0xdf,0x5a,0x8c,0xc1,0x4e,0x5c,0x01,0x61,0x9a,0x53,0xd7,0x23,0xb6,0x39,0xbd,0x31,0x01,0x90,0x8e,0x0a,0x9e,0x5b,0x0d,0xf8,0xcc,0x42}, 0},
+    {{0xb3,0xaf,0x9a,0x5c,0x25,0xff,0x77,0x83,0x73,0xc3,0x7e,0x8a,0x10,0xb0,0x63,0x78,0xd7,0xaf,0x1e,0x5a,0x1e,0xd1,0xd9,0x7c,0x2f,0x8f,0x7a,0xad,0xeb,0x9d,0x1b,0xd0}, 0},
+    {{0xb3,0xaf,0x9a,0x5c,0x25,0xff,0x77,0x83,0x73,0xc3,0x7e,0x8a,0x10,0xb0,0x63,0x78,0xd7,0xaf,0x1e,0x5a,0x1e,0xd1,0xd9,0x7c,0x2f,0x8f,0x7a,0xad,0xeb,0x9d,0x1b,0xd0}, 1},
+    {{0xb3,0xc9,0x46,0xb6,0xb4,0x70,0x2b,0x37,0xef,0xfe,0xfc,0xcf,0xcf,0xde,0x92,0x66,0xdb,0x8e,0x86,0xa0,0xcc,0xc3,0x53,0xb3,0xb2,0x1f,0x76,0xed,0x3d,0x75,0x23,0x34}, 0},
+    {{0xb3,0xc9,0x46,0xb6,0xb4,0x70,0x2b,0x37,0xef,0xfe,0xfc,0xcf,0xcf,0xde,0x92,0x66,0xdb,0x8e,0x86,0xa0,0xcc,0xc3,0x53,0xb3,0xb2,0x1f,0x76,0xed,0x3d,0x75,0x23,0x34}, 1},
+    {{0xb3,0xf6,0x5c,0xe3,0xbe,0x8d,0xc4,0x45,0x08,0xcf,0xbc,0x2e,0x68,0x47,0xea,0x29,0xa9,0xc4,0xdc,0xe9,0x83,0xfb,0x69,0x0c,0xb4,0x9c,0x10,0xe2,0xb8,0x6c,0x2a,0x70}, 0},
+    {{0xb4,0x50,0xc9,0xd3,0xdf,0x55,0xae,0x6a,0xcd,0xd1,0x50,0x0e,0x1a,0xe4,0x1c,0x3b,0x61,0x7a,0x6c,0x3e,0x38,0x50,0x50,0x26,0x52,0xa6,0x76,0xbf,0xdd,0xbd,0x5e,0x5d}, 0},
+    {{0xb4,0xa2,0xf5,0xbd,0xae,0xe5,0x3b,0x2f,0x12,0xb1,0x58,0x35,0x2c,0x58,0x6f,0xeb,0xf5,0xa2,0x6a,0xc3,0xbb,0xf2,0x80,0x4a,0xf4,0x55,0x9a,0x59,0x1f,0xe8,0xa6,0xeb}, 0},
+    {{0xb4,0xa2,0xf5,0xbd,0xae,0xe5,0x3b,0x2f,0x12,0xb1,0x58,0x35,0x2c,0x58,0x6f,0xeb,0xf5,0xa2,0x6a,0xc3,0xbb,0xf2,0x80,0x4a,0xf4,0x55,0x9a,0x59,0x1f,0xe8,0xa6,0xeb}, 1},
+    {{0xb4,0xa3,0xa2,0xbd,0xda,0xc8,0x10,0x54,0xb2,0x88,0x1a,0x5b,0xc3,0xeb,0xf6,0x07,0xfa,0x6a,0x36,0x5f,0x52,0x09,0x18,0x8c,0x95,0x2e,0x1a,0xa1,0x8b,0x3a,0x89,0x47}, 0},
+    {{0xb4,0xb8,0xb3,0xa8,0x50,0x62,0x82,0xe4,0x67,0x2d,0x09,0xd9,0x5b,0x83,0xfc,0x4c,0x17,0x89,0x26,0xb3,0x84,0x1b,0x39,0xce,0xf2,0xb5,0xf3,0x1a,0x30,0x4f,0xe5,0x9b}, 0},
+    {{0xb4,0xb8,0xb3,0xa8,0x50,0x62,0x82,0xe4,0x67,0x2d,0x09,0xd9,0x5b,0x83,0xfc,0x4c,0x17,0x89,0x26,0xb3,0x84,0x1b,0x39,0xce,0xf2,0xb5,0xf3,0x1a,0x30,0x4f,0xe5,0x9b}, 1},
+    {{0xb5,0x9b,0x6c,0x20,0xde,0x81,0x91,0x5c,0xd1,0xfd,0x48,0xcc,0xd1,0x27,0x53,0x3c,0x02,0xa2,0xf2,0x79,0xe7,0x99,0x6c,0xc6,0xe4,0x5f,0x36,0x2f,0x63,0x92,0xeb,0xbe}, 0},
+    {{0xb6,0x03,0xb1,0x6f,0xbd,0xe5,0x8d,0xbd,0x16,0xc9,0x46,0x82,0x66,0x60,0xf4,0x7f,0x26,0x9c,0x47,0x55,0xab,0xeb,0x3f,0x82,0x9f,0x41,0x06,0x75,0x83,0xf1,0xc0,0x67}, 0},
+    {{0xb6,0x08,0xe5,0xcb,0xbb,0xb4,0xac,0x62,0x8b,0xe3,0x4b,0x7a,0xbf,0xf5,0x09,0x18,0xe1,0x99,0xc0,0xf5,0x97,0xfd,0xee,0x8a,0xa4,0x8b,0x08,0xf1,0xd8,0x05,0x4c,0x4c}, 0},
+    {{0xb6,0x08,0xe5,0xcb,0xbb,0xb4,0xac,0x62,0x8b,0xe3,0x4b,0x7a,0xbf,0xf5,0x09,0x18,0xe1,0x99,0xc0,0xf5,0x97,0xfd,0xee,0x8a,0xa4,0x8b,0x08,0xf1,0xd8,0x05,0x4c,0x4c}, 1},
+    {{0xb6,0x6d,0x43,0x53,0x4a,0x33,0xcc,0xa6,0x42,0x42,0x52,0xe1,0x43,0x9b,0x05,0x27,0x30,0x13,0x8d,0x92,0x09,0xfb,0xee,0x97,0xa9,0x18,0xb0,0x02,0xbd,0xe6,0xff,0x56}, 0},
+    {{0xb6,0xb2,0x9d,0x78,0xd1,0xe7,0xe2,0x3a,0xe0,0x5b,0x53,0xfa,0x76,0xd5,0xdc,0xad,0xd8,0x2b,0xce,0x55,0xb6,0x93,0x80,0x51,0xf3,0x12,0x87,0xfd,0x73,0x9e,0xc0,0xa0}, 0},
+    {{0xb6,0xb2,0x9d,0x78,0xd1,0xe7,0xe2,0x3a,0xe0,0x5b,0x53,0xfa,0x76,0xd5,0xdc,0xad,0xd8,0x2b,0xce,0x55,0xb6,0x93,0x80,0x51,0xf3,0x12,0x87,0xfd,0x73,0x9e,0xc0,0xa0}, 1},
+    {{0xb6,0xe7,0xbb,0x71,0xea,0x5b,0xb3,0xf8,0xf2,0x64,0xdf,0xaf,0x9a,0x4b,0x17,0x7a,0x75,0x5b,0x60,0xab,0xed,0x5e,0xfa,0x6e,0x49,0x9a,0xac,0x94,0x9f,0x03,0x51,0x56}, 0},
+    {{0xb6,0xe7,0xbb,0x71,0xea,0x5b,0xb3,0xf8,0xf2,0x64,0xdf,0xaf,0x9a,0x4b,0x17,0x7a,0x75,0x5b,0x60,0xab,0xed,0x5e,0xfa,0x6e,0x49,0x9a,0xac,0x94,0x9f,0x03,0x51,0x56}, 1},
+    {{0xb6,0xf6,0x04,0x35,0x70,0x4f,0x57,0x5b,0x05,0x40,0x5b,0x6f,0x65,0x73,0x2b,0xd3,0xe2,0x73,0xb0,0x34,0xe2,0x56,0xf1,0xde,0x80,0xeb,0x1e,0xb2,0x9b,0xf8,0x29,0xb8}, 0},
+    {{0xb6,0xf6,0x04,0x35,0x70,0x4f,0x57,0x5b,0x05,0x40,0x5b,0x6f,0x65,0x73,0x2b,0xd3,0xe2,0x73,0xb0,0x34,0xe2,0x56,0xf1,0xde,0x80,0xeb,0x1e,0xb2,0x9b,0xf8,0x29,0xb8}, 1},
+    {{0xb6,0xf6,0xac,0x20,0x33,0x4f,0x36,0x55,0x79,0xa4,0xfd,0x23,0x76,0xea,0xf0,0x75,0x88,0x95,0xf7,0x75,0x1e,0xc5,0xf3,0x4e,0xc7,0x63,0x9c,0x5b,0x18,0xa3,0x43,0xcd}, 0},
+    {{0xb6,0xf6,0xac,0x20,0x33,0x4f,0x36,0x55,0x79,0xa4,0xfd,0x23,0x76,0xea,0xf0,0x75,0x88,0x95,0xf7,0x75,0x1e,0xc5,0xf3,0x4e,0xc7,0x63,0x9c,0x5b,0x18,0xa3,0x43,0xcd}, 1},
+    {{0xb7,0x24,0xf4,0x67,0xbd,0xfb,0xd0,0xd6,0x4d,0x71,0xeb,0x98,0xb3,0x13,0xcf,0xf1,0x3b,0x96,0x51,0xc1,0x9d,0x5e,0xe6,0x9b,0xf7,0x80,0xd3,0xae,0x37,0xa7,0x28,0xc6}, 0},
+    {{0xb7,0x82,0x44,0x58,0xcb,0x59,0x7d,0x71,0xb8,0xa2,0x96,0x33,0xb7,0x40,0xa5,0x8b,0xeb,0x7f,0x0b,0xff,0x12,0x6d,0x33,0xcc,0xd1,0xd0,0x9f,0x2f,0xe6,0xff,0xd1,0x8f}, 0},
+    {{0xb7,0x82,0x44,0x58,0xcb,0x59,0x7d,0x71,0xb8,0xa2,0x96,0x33,0xb7,0x40,0xa5,0x8b,0xeb,0x7f,0x0b,0xff,0x12,0x6d,0x33,0xcc,0xd1,0xd0,0x9f,0x2f,0xe6,0xff,0xd1,0x8f}, 1},
+    {{0xb7,0x83,0xe6,0xc2,0x6a,0xe6,0x87,0xde,0xf0,0x23,0xa2,0x77,0xb0,0x85,0xb6,0x0a,0x8b,0x91,0x5c,0x0b,0xfc,0x0a,0x4e,0x95,0xc7,0xa7,0x2e,0x3d,0xfc,0x98,0xd2,0xc8}, 0},
+    {{0xb7,0x83,0xe6,0xc2,0x6a,0xe6,0x87,0xde,0xf0,0x23,0xa2,0x77,0xb0,0x85,0xb6,0x0a,0x8b,0x91,0x5c,0x0b,0xfc,0x0a,0x4e,0x95,0xc7,0xa7,0x2e,0x3d,0xfc,0x98,0xd2,0xc8}, 1},
+    {{0xb8,0x28,0x70,0x2e,0xce,0x3f,0xf7,0x5f,0xb8,0xf5,0xc6,0xd4,0x04,0x04,0x11,0x23,0xcc,0x27,0xf0,0x17,0x36,0x0c,0x19,0x39,0x08,0x67,0xd2,0x44,0x38,0xe4,0x57,0x1a}, 0},
+    {{0xb8,0x47,0x7f,0x12,0xc6,0x98,0x47,0x4a,0x69,0xfa,0x34,0xcd,0x40,0xa7,0x7f,0xc4,0x4d,0x3c,0x6b,0x89,0x47,0xcd,0x8c,0x98,0x4f,0x1e,0x53,0x0d,0x56,0xbb,0x43,0x39}, 0},
+    {{0xb8,0xcb,0x62,0x13,0x95,0x5f,0xe7,0x63,0x02,0xc5,0xda,0x5a,0x0c,0xb1,0xf5,0x47,0x63,0x28,0xea,0x0b,0x52,0x3d,0x2b,0x50,0xce,0xc7,0x6c,0xdc,0x87,0xde,0x17,0xbe}, 0},
+    {{0xb8,0xcb,0x62,0x13,0x95,0x5f,0xe7,0x63,0x02,0xc5,0xda,0x5a,0x0c,0xb1,0xf5,0x47,0x63,0x28,0xea,0x0b,0x52,0x3d,0x2b,0x50,0xce,0xc7,0x6c,0xdc,0x87,0xde,0x17,0xbe}, 1},
+    {{0xb9,0x46,0x48,0x8d,0x78,0x10,0x7e,0xe4,0x8e,0x52,0xfc,0x15,0xfd,0x07,0xf1,0x83,0x5c,0xc2,0xed,0x21,0x02,0x96,0x3a,0x17,0x5c,0xe4,0x25,0x12,0xc1,0x10,0x77,0xe5}, 0},
+    {{0xb9,0x46,0x48,0x8d,0x78,0x10,0x7e,0xe4,0x8e,0x52,0xfc,0x15,0xfd,0x07,0xf1,0x83,0x5c,0xc2,0xed,0x21,0x02,0x96,0x3a,0x17,0x5c,0xe4,0x25,0x12,0xc1,0x10,0x77,0xe5}, 1},
+    {{0xb9,0xe3,0x3b,0x68,0x98,0x0f,0x5a,0x12,0xfc,0x23,0x83,0x48,0x41,0xe6,0xf0,0x64,0x2f,0x8b,0x02,0x3c,0xa8,0xdc,0x06,0xe4,0x7f,0x00,0x5b,0x7d,0x7f,0x35,0x29,0xfc}, 0},
+    {{0xba,0x27,0xb1,0x4b,0x64,0x4d,0x40,0x30,0x65,0x69,0xc0,0x91,0xb3,0xc2,0x0a,0x5b,0xa6,0xf1,0xad,0x98,0x22,0x50,0x15,0x90,0x0b,0xbc,0x80,0x58,0x0b,0xae,0x6d,0x19}, 0},
+    {{0xba,0x42,0x30,0x75,0xec,0x93,0xc7,0x45,0x3e,0x2d,0x7d,0x01,0xe2,0xa9,0xc2,0x38,0xc6,0x1a,0x30,0xaf,0xee,0xd1,0x69,0xd0,0xe6,0xf4,0x3e,0xbc,0x6a,0xfd,0x08,0x2e}, 0},
+    {{0xba,0x42,0x30,0x75,0xec,0x93,0xc7,0x45,0x3e,0x2d,0x7d,0x01,0xe2,0xa9,0xc2,0x38,0xc6,0x1a,0x30,0xaf,0xee,0xd1,0x69,0xd0,0xe6,0xf4,0x3e,0xbc,0x6a,0xfd,0x08,0x2e}, 1},
+    {{0xba,0x5e,0x13,0x86,0x79,0x61,0xaa,0x21,0x9d,0xac,0x97,0x8c,0x48,0x77,0x62,0x50,0x0a,0xd0,0xed,0x62,0xdd,0xe5,0xe3,0x5d,0xf8,0x0a,0xfe,0x23,0x96,0xa8,0x07,0xe5}, 0},
+    {{0xba,0x5e,0x13,0x86,0x79,0x61,0xaa,0x21,0x9d,0xac,0x97,0x8c,0x48,0x77,0x62,0x50,0x0a,0xd0,0xed,0x62,0xdd,0xe5,0xe3,0x5d,0xf8,0x0a,0xfe,0x23,0x96,0xa8,0x07,0xe5}, 1},
+    {{0xba,0x6c,0x4a,0xae,0x53,0xa5,0x07,0x57,0x2a,0x54,0x72,0x0f,0x6a,0xbb,0x4b,0xe7,0x0c,0x2e,0xe9,0x18,0x62,0x86,0x65,0xaf,0xf2,0x27,0xad,0xef,0xd0,0x43,0x21,0xee}, 0},
+    {{0xba,0x6c,0x4a,0xae,0x53,0xa5,0x07,0x57,0x2a,0x54,0x72,0x0f,0x6a,0xbb,0x4b,0xe7,0x0c,0x2e,0xe9,0x18,0x62,0x86,0x65,0xaf,0xf2,0x27,0xad,0xef,0xd0,0x43,0x21,0xee}, 1},
+    {{0xba,0x9f,0x5a,0x9d,0x8c,0x95,0x75,0xf4,0xdc,0x69,0x06,0xc1,0xd8,0x02,0x1e,0x6d,0x73,0x0d,0xc2,0xe9,0xb6,0x6b,0xb0,0x3a,0xd7,0xe3,0x02,0x53,0x5b,0x03,0xc1,0x08}, 0},
+    {{0xba,0xa8,0x9b,0x63,0xf3,0xb2,0x6e,0x9c,0xcc,0x52,0x66,0xd1,0x62,0xe6,0xf4,0xd5,0x35,0x34,0x53,0xf1,0xc0,0x54,0x22,0xc4,0xcd,0x0c,0x1a,0xa3,0x34,0x6d,0x16,0x29}, 0},
+    {{0xba,0xa8,0x9b,0x63,0xf3,0xb2,0x6e,0x9c,0xcc,0x52,0x66,0xd1,0x62,0xe6,0xf4,0xd5,0x35,0x34,0x53,0xf1,0xc0,0x54,0x22,0xc4,0xcd,0x0c,0x1a,0xa3,0x34,0x6d,0x16,0x29}, 1},
+    {{0xba,0xc6,0x6b,0xb3,0x1e,0x16,0x8a,0x62,0xee,0x04,0xf4,0x94,0x98,0xbe,0x45,0xf8,0xa8,0xb1,0x58,0x3b,0xe4,0x43,0xd9,0x94,0x3f,0x30,0x1f,0x4a,0x38,0x26,0x32,0x27}, 0},
+    {{0xba,0xc6,0x6b,0xb3,0x1e,0x16,0x8a,0x62,0xee,0x04,0xf4,0x94,0x98,0xbe,0x45,0xf8,0xa8,0xb1,0x58,0x3b,0xe4,0x43,0xd9,0x94,0x3f,0x30,0x1f,0x4a,0x38,0x26,0x32,0x27}, 1},
+    {{0xba,0xd1,0x8c,0x31,0x3d,0xa3,0x37,0x5c,0x69,0x16,0xa1,0x03,0xab,0x68,0x4a,0xec,0x9f,0x76,0x10,0xaf,0x47,0x2e,0xb6,0xf5,0x85,0x90,0xf5,0x93,0x45,0x86,0x3d,0x0a}, 0},
+    {{0xba,0xd1,0x8c,0x31,0x3d,0xa3,0x37,0x5c,0x69,0x16,0xa1,0x03,0xab,0x68,0x4a,0xec,0x9f,0x76,0x10,0xaf,0x47,0x2e,0xb6,0xf5,0x85,0x90,0xf5,0x93,0x45,0x86,0x3d,0x0a}, 1},
+    {{0xba,0xe2,0xfe,0xeb,0xd5,0x7a,0xb2,0xa2,0xea,0x83,0x71,0xff,0x58,0x65,0x4e,0x85,0x9c,0x92,0x18,0xae,0x55,0x18,0x3b,0xe6,0xcb,0xda,0x65,0x0b,0x45,0x74,0x12,0xf0}, 0},
+    {{0xba,0xe2,0xfe,0xeb,0xd5,0x7a,0xb2,0xa2,0xea,0x83,0x71,0xff,0x58,0x65,0x4e,0x85,0x9c,0x92,0x18,0xae,0x55,0x18,0x3b,0xe6,0xcb,0xda,0x65,0x0b,0x45,0x74,0x12,0xf0}, 1},
+    {{0xbb,0x5d,0x8c,0xde,0x09,0x13,0x1e,0xfd,0x20,0xb3,0x3c,0x1e,0x55,0xf5,0x45,0x0c,0x6a,0xe1,0xfe,0xd7,0x7d,0x2f,0xe4,0xe4,0xd1,0xae,0x06,0xfd,0xba,0x00,0x56,0x87}, 0},
+    {{0xbb,0x64,0xb7,0x6e,0x14,0xa6,0x96,0xcd,0x06,0x72,0x9b,0xc7,0xd5,0x33,0x97,0xf2,0xbd,0x77,0x15,0xcc,0xc1,0xfc,0x17,0x0e,0xd7,0xb1,0x62,0xc6,0x40,0x08,0xff,0x4f}, 0},
+    {{0xbb,0x64,0xb7,0x6e,0x14,0xa6,0x96,0xcd,0x06,0x72,0x9b,0xc7,0xd5,0x33,0x97,0xf2,0xbd,0x77,0x15,0xcc,0xc1,0xfc,0x17,0x0e,0xd7,0xb1,0x62,0xc6,0x40,0x08,0xff,0x4f}, 1},
+    {{0xbb,0xd0,0x83,0x42,0xf5,0x04,0xc0,0xbd,0xf2,0x87,0xb1,0xa5,0xdb,0x92,0x02,0x06,0xec,0xef,0xd4,0xe6,0x5a,0xf3,0x1e,0xec,0xe4,0xe7,0xf6,0x29,0x26,0x13,0xdc,0xc4}, 0},
+    {{0xbb,0xdd,0xe2,0x4e,0x11,0xf6,0xb0,0xa6,0x72,0x47,0x48,0x5c,0x3b,0xbf,0xbf,0x50,0xb9,0xc8,0x60,0xde,0x58,0x04,0x72,0x95,0xdb,0x19,0x0f,0x96,0xbc,0x80,0x99,0x95}, 0},
+    {{0xbb,0xdd,0xe2,0x4e,0x11,0xf6,0xb0,0xa6,0x72,0x47,0x48,0x5c,0x3b,0xbf,0xbf,0x50,0xb9,0xc8,0x60,0xde,0x58,0x04,0x72,0x95,0xdb,0x19,0x0f,0x96,0xbc,0x80,0x99,0x95}, 1},
+    {{0xbc,0x5f,0x44,0xa1,0x30,0x89,0x67,0xc3,0x06,0xea,0x06,0x2a,0x9f,0x96,0x94,0x45,0x92,0xb9,0x9c,0x06,0xd6,0x8a,0x5f,0xce,0x11,0x70,0x2d,0xe7,0xe1,0x06,0x88,0x8b}, 0},
+    {{0xbc,0x5f,0x44,0xa1,0x30,0x89,0x67,0xc3,0x06,0xea,0x06,0x2a,0x9f,0x96,0x94,0x45,0x92,0xb9,0x9c,0x06,0xd6,0x8a,0x5f,0xce,0x11,0x70,0x2d,0xe7,0xe1,0x06,0x88,0x8b}, 1},
+    {{0xbc,0x60,0xd3,0x2e,0x28,0x45,0x7b,0x1a,0xd8,0x3d,0x84,0x0d,0x78,0x8c,0xfe,0x53,0xb0,0xe3,0x4b,0x26,0x4f,0x5b,0xcd,0x19,0x23,0x55,0x9e,0x80,0xbe,0x95,0xa5,0x24}, 0},
+    {{0xbc,0x60,0xd3,0x2e,0x28,0x45,0x7b,0x1a,0xd8,0x3d,0x84,0x0d,0x78,0x8c,0xfe,0x53,0xb0,0xe3,0x4b,0x26,0x4f,0x5b,0xcd,0x19,0x23,0x55,0x9e,0x80,0xbe,0x95,0xa5,0x24}, 1},
+    {{0xbd,0x08,0xb3,0x5a,0x14,0xbb,0x3f,0x5e,0x86,0x8a,0x28,0xb3,0xc7,0xa7,0xbd,0x87,0xa0,0xcc,0x16,0x86,0xa5,0xd4,0x52,0x92,0x2d,0xcc,0xe6,0x61,0x33,0x15,0xa7,0x94}, 0},
+    {{0xbd,0x08,0xb3,0x5a,0x14,0xbb,0x3f,0x5e,0x86,0x8a,0x28,0xb3,0xc7,0xa7,0xbd,0x87,0xa0,0xcc,0x16,0x86,0xa5,0xd4,0x52,0x92,0x2d,0xcc,0xe6,0x61,0x33,0x15,0xa7,0x94}, 1},
+    {{0xbd,0x4b,0x61,0x8f,0xb2,0x41,0xaa,0x04,0x44,0xd0,0x18,0xaf,0x9f,0x99,0xc7,0xbc,0x70,0xeb,0x45,0x9c,0xfc,0x37,0x2f,0x70,0x57,0xc3,0xf6,0x5b,0x58,0xb3,0xcb,0x8d}, 0},
+    {{0xbd,0x99,0x58,0x3e,0xda,0x5a,0xc2,0x99,0xdb,0x2f,0x3f,0x7f,0x6b,0xd6,0x32,0x08,0xff,0xd9,0xcc,0xe3,0xde,0xf0,0x35,0x68,0xd9,0x2d,0xbc,0x88,0x9e,0x95,0x50,0x0f}, 0},
+    {{0xbd,0x99,0x58,0x3e,0xda,0x5a,0xc2,0x99,0xdb,0x2f,0x3f,0x7f,0x6b,0xd6,0x32,0x08,0xff,0xd9,0xcc,0xe3,0xde,0xf0,0x35,0x68,0xd9,0x2d,0xbc,0x88,0x9e,0x95,0x50,0x0f}, 1},
+    {{0xbd,0xd7,0x33,0x52,0x95,0x47,0x9a,0x02,0x66,0xf9,0x1c,0x5b,0x91,0x76,0x6c,0x37,0x87,0x9f,0xc6,0xc4,0x92,0xe3,0xec,0x72,0x6b,0x47,0xf1,0x96,0xc7,0xee,0xdc,0x8c}, 0},
+    {{0xbd,0xd7,0x33,0x52,0x95,0x47,0x9a,0x02,0x66,0xf9,0x1c,0x5b,0x91,0x76,0x6c,0x37,0x87,0x9f,0xc6,0xc4,0x92,0xe3,0xec,0x72,0x6b,0x47,0xf1,0x96,0xc7,0xee,0xdc,0x8c}, 1},
+    {{0xbd,0xeb,0xb9,0x24,0x96,0x9f,0xfb,0x73,0x03,0xbb,0xdf,0x2f,0x4a,0x84,0x25,0x77,0xfe,0x1a,0xec,0xb0,0x7e,0x2c,0xe4,0xbc,0x78,0x98,0x4f,0x8b,0x84,0x45,0xa7,0xb3}, 0},
+    {{0xbe,0x48,0x9f,0x4a,0xa2,0x23,0x0d,0xa9,0xe8,0x9d,0xbc,0x28,0xd9,0x59,0x00,0xd0,0xe8,0x12,0x58,0xf1,0xf3,0x92,0x7d,0x72,0xf6,0x15,0x63,0x5b,0x8f,0x3a,0x74,0x84}, 0},
+    {{0xbe,0x48,0x9f,0x4a,0xa2,0x23,0x0d,0xa9,0xe8,0x9d,0xbc,0x28,0xd9,0x59,0x00,0xd0,0xe8,0x12,0x58,0xf1,0xf3,0x92,0x7d,0x72,0xf6,0x15,0x63,0x5b,0x8f,0x3a,0x74,0x84}, 1},
+    {{0xbe,0x8b,0x24,0xcd,0x62,0x38,0x25,0x32,0xdd,0x63,0xbd,0x58,0xa4,0xd5,0xbd,0xda,0x95,0x46,0xb5,0x2b,0x3c,0x45,0x25,0x90,0x6b,0xc1,0xde,0x72,0xa0,0x2f,0x3f,0x20}, 0},
+    {{0xbe,0x8b,0x24,0xcd,0x62,0x38,0x25,0x32,0xdd,0x63,0xbd,0x58,0xa4,0xd5,0xbd,0xda,0x95,0x46,0xb5,0x2b,0x3c,0x45,0x25,0x90,0x6b,0xc1,0xde,0x72,0xa0,0x2f,0x3f,0x20}, 1},
+    {{0xbe,0x90,0xd4,0xf7,0xca,0x36,0x85,0xf1,0xf8,0xaa,0x29,0x95,0x25,0x96,0x4a,0xfa,0x2a,0x30,0x09,0xe5,0x76,0x52,0x1e,0x98,0xb0,0x1c,0x25,0xb5,0x87,0xe7,0x2d,0x70}, 0},
+    {{0xbe,0xfd,0xfc,0x1c,0x2a,0x1f,0x4a,0x79,0x71,0xf2,0x08,0x47,0x07,0xba,0x70,0x67,0x99,0xbb,0x70,0xcf,0xea,0x33,0x95,0x6a,0xf8,0xac,0xcf,0x19,0x51,0xcd,0x61,0x53}, 0},
+    {{0xbf,0x17,0x39,0x3f,0xa4,0x03,0xb4,0x47,0x2f,0xf2,0x02,0x96,0xca,0xe9,0x8d,0x59,0xe3,0xca,0x03,0x73,0x61,0x5a,0x66,0x33,0xa5,0x7d,0x64,0xc8,0xc5,0x39,0x95,0xfc}, 0},
+    {{0xbf,0x17,0x39,0x3f,0xa4,0x03,0xb4,0x47,0x2f,0xf2,0x02,0x96,0xca,0xe9,0x8d,0x59,0xe3,0xca,0x03,0x73,0x61,0x5a,0x66,0x33,0xa5,0x7d,0x64,0xc8,0xc5,0x39,0x95,0xfc}, 1},
+    {{0xbf,0x42,0x7e,0x7d,0xe6,0x38,0x96,0xca,0xcc,0x7f,0x40,0xb2,0x62,0x7e,0x28,0x93,0xd5,0xa4,0x7f,0x64,0x1e,0x56,0xfa,0xbf,0xdb,0x73,0x29,0xd4,0x7f,0x91,0xcd,0x98}, 0},
+    {{0xbf,0xb2,0x74,0xfe,0xd0,0x9d,0x49,0x22,0x2c,0xfa,0x32,0xe7,0xb8,0xff,0x49,0x40,0xff,0x06,0xc2,0x42,0x46,0xde,0x1c,0xb3,0x82,0x90,0xd1,0x4c,0xca,0x9f,0xbe,0x8d}, 0},
+    {{0xbf,0xe1,0xa1,0xf4,0x0d,0x3b,0x7c,0xd4,0x33,0x9b,0xea,0x30,0x31,0x51,0x93,0xa6,0x49,0xec,0x99,0xe4,0xc1,0xe9,0xb7,0x22,0x43,0x0c,0xba,0x29,0x7a,0x0e,0x98,0x99}, 0},
+    {{0xbf,0xe1,0xa1,0xf4,0x0d,0x3b,0x7c,0xd4,0x33,0x9b,0xea,0x30,0x31,0x51,0x93,0xa6,0x49,0xec,0x99,0xe4,0xc1,0xe9,0xb7,0x22,0x43,0x0c,0xba,0x29,0x7a,0x0e,0x98,0x99}, 1},
+    {{0xc0,0x42,0x77,0x6d,0x1e,0xc0,0xee,0xdf,0x85,0x5b,0xac,0x24,0x93,0xf3,0xb4,0xa6,0xda,0xab,0x5b,0x21,0xc5,0x76,0x49,0x34,0x5c,0xdf,0xbc,0xab,0x48,0xee,0x05,0x71}, 0},
+    {{0xc0,0x42,0x77,0x6d,0x1e,0xc0,0xee,0xdf,0x85,0x5b,0xac,0x24,0x93,0xf3,0xb4,0xa6,0xda,0xab,0x5b,0x21,0xc5,0x76,0x49,0x34,0x5c,0xdf,0xbc,0xab,0x48,0xee,0x05,0x71}, 1},
+    {{0xc0,0x5b,0x18,0x96,0x47,0x24,0x8b,0x4d,0x47,0x37,0xf0,0xc7,0x11,0x31,0xc6,0x75,0xac,0x30,0x10,0x12,0x1b,0xa5,0x8c,0x0f,0xf9,0x83,0x20,0x07,0x84,0x13,0x46,0xa9}, 0},
+    {{0xc0,0x5b,0x18,0x96,0x47,0x24,0x8b,0x4d,0x47,0x37,0xf0,0xc7,0x11,0x31,0xc6,0x75,0xac,0x30,0x10,0x12,0x1b,0xa5,0x8c,0x0f,0xf9,0x83,0x20,0x07,0x84,0x13,0x46,0xa9}, 1},
+    {{0xc0,0x5f,0x08,0x31,0x31,0x25,0x9d,0xcd,0x50,0x64,0x22,0xad,0xfa,0x34,0xc5,0x5b,0xf7,0x5e,0xe6,0x81,0xfd,0xfc,0xef,0x65,0xcf,0x3a,0x78,0xf9,0x7c,0x53,0x26,0x83}, 0},
+    {{0xc1,0x11,0x0a,0xff,0x08,0xb1,0x87,0xd9,0x34,0x67,0xdc,0x12,0xf3,0x53,0x70,0x10,0xc3,0x3a,0xfc,0xc2,0x72,0x29,0xda,0x89,0xb8,0xdf,0x4a,0xc8,0x8c,0xec,0xb7,0x3f}, 0},
+    {{0xc1,0x32,0xe7,0x6d,0x96,0xee,0x81,0x66,0xb7,0x4a,0x20,0xf7,0xd0,0x6e,0xce,0x61,0xda,0x3a,0x37,0x67,0xc2,0x90,0x24,0xe4,0xbd,0xc3,0xce,0xec,0x1c,0xf6,0x10,0x32}, 0},
+    {{0xc1,0x32,0xe7,0x6d,0x96,0xee,0x81,0x66,0xb7,0x4a,0x20,0xf7,0xd0,0x6e,0xce,0x61,0xda,0x3a,0x37,0x67,0xc2,0x90,0x24,0xe4,0xbd,0xc3,0xce,0xec,0x1c,0xf6,0x10,0x32}, 1},
+    {{0xc1,0x80,0x5e,0x12,0x3b,0x71,0xa8,0x21,0xd8,0xce,0xca,0x90,0x41,0x6e,0x9a,0x50,0xe7,0xd9,0x7e,0xbf,0x9d,0xc2,0xb8,0xc6,0xa3,0xc7,0x1d,0x42,0x47,0xdd,0xa5,0x7e}, 0},
+    {{0xc1,0x80,0x5e,0x12,0x3b,0x71,0xa8,0x21,0xd8,0xce,0xca,0x90,0x41,0x6e,0x9a,0x50,0xe7,0xd9,0x7e,0xbf,0x9d,0xc2,0xb8,0xc6,0xa3,0xc7,0x1d,0x42,0x47,0xdd,0xa5,0x7e}, 1},
+    {{0xc1,0xca,0xe2,0x4e,0xc9,0xfe,0xb1,0x70,0x2c,0xe5,0xe7,0x7f,0x29,0x8f,0x8f,0xec,0x32,0xdc,0xd9,0x43,0xd6,0xd7,0x2d,0xfe,0xbc,0xf6,0x64,0x5a,0xcb,0x2f,0x3b,0xa5}, 0},
+    {{0xc1,0xca,0xe2,0x4e,0xc9,0xfe,0xb1,0x70,0x2c,0xe5,0xe7,0x7f,0x29,0x8f,0x8f,0xec,0x32,0xdc,0xd9,0x43,0xd6,0xd7,0x2d,0xfe,0xbc,0xf6,0x64,0x5a,0xcb,0x2f,0x3b,0xa5}, 1},
+    {{0xc1,0xce,0x92,0xaa,0x34,0x42,0x88,0x6b,0x51,0x0d,0xcf,0x7a,0x5f,0xc2,0xf4,0x11,0xc1,0x99,0x6e,0xcc,0x9b,0x20,0x37,0x9e,0x14,0xeb,0x9e,0x07,0x50,0x20,0x0f,0x9e}, 0},
+    {{0xc2,0x38,0xe0,0xf3,0xa1,0xd2,0xb4,0xe3,0xab,0x2b,0xb3,0xb9,0x23,0x5b,0xcb,0x24,0xbc,0x07,0xf9,0x32,0xdc,0x76,0x7c,0x31,0x6c,0x51,0x5f,0xed,0xc0,0x26,0xfa,0x13}, 0},
+    {{0xc2,0x38,0xe0,0xf3,0xa1,0xd2,0xb4,0xe3,0xab,0x2b,0xb3,0xb9,0x23,0x5b,0xcb,0x24,0xbc,0x07,0xf9,0x32,0xdc,0x76,0x7c,0x31,0x6c,0x51,0x5f,0xed,0xc0,0x26,0xfa,0x13}, 1},
+    {{0xc2,0xa8,0xa2,0x09,0x27,0x14,0xe3,0x73,0xa0,0xda,0x47,0xe2,0x35,0xbe,0xdd,0x6a,0xd0,0xb7,0x66,0xa9,0xd8,0x63,0x96,0x8f,0xfc,0xaf,0x3f,0xb7,0xb5,0x01,0xb6,0xb5}, 0},
+    {{0xc2,0xa8,0xa2,0x09,0x27,0x14,0xe3,0x73,0xa0,0xda,0x47,0xe2,0x35,0xbe,0xdd,0x6a,0xd0,0xb7,0x66,0xa9,0xd8,0x63,0x96,0x8f,0xfc,0xaf,0x3f,0xb7,0xb5,0x01,0xb6,0xb5}, 1},
+    {{0xc2,0xe9,0x13,0x8e,0xef,0x79,0xe4,0x9e,0x1f,0xe2,0xcf,0xfe,0x1a,0xc2,0xfb,0x5d,0xe9,0xe4,0x98,0x45,0x5f,0xc1,0x73,0xc0,0xd0,0xd3,0xaa,0x4e,0xb7,0x5d,0x85,0x76}, 0},
+    {{0xc2,0xe9,0x13,0x8e,0xef,0x79,0xe4,0x9e,0x1f,0xe2,0xcf,0xfe,0x1a,0xc2,0xfb,0x5d,0xe9,0xe4,0x98,0x45,0x5f,0xc1,0x73,0xc0,0xd0,0xd3,0xaa,0x4e,0xb7,0x5d,0x85,0x76}, 1},
+    {{0xc3,0x03,0x1e,0xbe,0x0d,0x26,0xb1,0x41,0x2a,0x17,0x1c,0x7c,0xfa,0x2f,0x22,0xb9,0x40,0x69,0x6c,0xdf,0xc3,0x59,0x4b,0xed,0xdf,0x02,0x5f,0x43,0x23,0x10,0xcb,0xd2}, 0},
+    {{0xc3,0x5d,0xef,0x41,0x86,0x37,0x59,0xf3,0x8f,0x55,0x90,0x48,0xe7,0x54,0x62,0x00,0xcf,0x57,0x1f,0x0c,0xeb,0x08,0x75,0x22,0x5b,0xc1,0xef,0x46,0x56,0x5c,0x5e,0xc7}, 0},
+    {{0xc3,0x90,0xe0,0xbc,0x5e,0x22,0x71,0x84,0xa7,0x18,0x74,0xc6,0x2f,0xb7,0x3b,0x93,0x2a,0xac,0x40,0x47,0xa5,0x60,0xde,0x43,0x4e,0x88,0xcd,0x73,0xc0,0xdb,0xb1,0xb9}, 0},
+    {{0xc4,0x49,0xd0,0x12,0xd3,0x45,0x2b,0x39,0x37,0xd9,0x4a,0x8c,0xc2,0x7f,0xf9,0x55,0x7b,0x1a,0x7f,0xc7,0x79,0xf9,0xd5,0x5d,0x74,0xe1,0x69,0x8d,0x52,0x09,0x68,0xff}, 0},
+    {{0xc4,0x4e,0x35,0xe4,0x6a,0xf5,0xdc,0x30,0xf0,0xfc,0x7b,0x1a,0xf7,0x47,0x4b,0x51,0x87,0x31,0xe7,0x80,0x46,0x2f,0xd9,0xde,0xb9,0x7f,0x0b,0x81,0x7b,0x96,0x26,0xbe}, 0},
+    {{0xc4,0x84,0x21,0x2c,0xa9,0x87,0x47,0x42,0x77,0x05,0xd4,0x78,0xb2,0xe3,0xb7,0xfc,0xa8,0x01,0x2c,0x41,0xf6,0x5d,0xdb,0xd9,0xfc,0xff,0x96,0x90,0x52,0xee,0x5b,0x90}, 0},
+    {{0xc4,0x84,0x21,0x2c,0xa9,0x87,0x47,0x42,0x77,0x05,0xd4,0x78,0xb2,0xe3,0xb7,0xfc,0xa8,0x01,0x2c,0x41,0xf6,0x5d,0xdb,0xd9,0xfc,0xff,0x96,0x90,0x52,0xee,0x5b,0x90}, 1},
+    {{0xc4,0xc2,0xc3,0x0d,0x4b,0x22,0x12,0x1e,0xc5,0x8d,0x33,0x9b,0x84,0x4f,0x04,0xbb,0x5f,0x05,0x1f,0xda,0x3e,0xbb,0x7e,0x57,0x9e,0xa5,0x04,0x10,0xf9,0xe8,0xb5,0x37}, 0},
+    {{0xc4,0xd3,0x6e,0xf3,0xff,0xd3,0x49,0x5b,0x9e,0x47,0x5f,0xd4,0xdc,0x1d,0x86,0xa2,0x9c,0x6d,0x12,0xb7,0x66,0xc3,0x23,0xcb,0xe6,0x0c,0xf5,0x49,0x05,0xfb,0x91,0x4a}, 0},
+    {{0xc5,0x0c,0xf4,0x06,0xab,0x75,0x63,0x68,0xfc,0x12,0x1b,0x45,0x69,0x83,0xde,0xba,0x74,0x2c,0x72,0x6f,0x7e,0xd4,0x0a,0x5c,0x0e,0x0a,0xfb,0xa3,0x63,0x9a,0x2b,0x69}, 0},
+    {{0xc5,0x0c,0xf4,0x06,0xab,0x75,0x63,0x68,0xfc,0x12,0x1b,0x45,0x69,0x83,0xde,0xba,0x74,0x2c,0x72,0x6f,0x7e,0xd4,0x0a,0x5c,0x0e,0x0a,0xfb,0xa3,0x63,0x9a,0x2b,0x69}, 1},
+    {{0xc5,0x27,0xcd,0x87,0xbf,0x53,0xf7,0xd2,0xdc,0x48,0x47,0xd8,0x80,0x97,0x3c,0xaf,0xf0,0x25,0xab,0x4c,0x62,0x2a,0x8d,0xdd,0xeb,0xda,0x10,0x37,0x7d,0x59,0xdd,0xbf}, 0},
+    {{0xc5,0x27,0xcd,0x87,0xbf,0x53,0xf7,0xd2,0xdc,0x48,0x47,0xd8,0x80,0x97,0x3c,0xaf,0xf0,0x25,0xab,0x4c,0x62,0x2a,0x8d,0xdd,0xeb,0xda,0x10,0x37,0x7d,0x59,0xdd,0xbf}, 1},
+    {{0xc5,0x2f,0xfc,0x10,0xcf,0x6d,0xd6,0x0b,0x12,0x37,0x2f,0x8d,0x02,0x17,0xb6,0x08,0x7c,0x55,0x68,0xaa,0x18,0xee,0x8f,0x91,0x46,0x41,0xb1,0x99,0xe4,0x05,0x59,0x8f}, 0},
+    {{0xc5,0x2f,0xfc,0x10,0xcf,0x6d,0xd6,0x0b,0x12,0x37,0x2f,0x8d,0x02,0x17,0xb6,0x08,0x7c,0x55,0x68,0xaa,0x18,0xee,0x8f,0x91,0x46,0x41,0xb1,0x99,0xe4,0x05,0x59,0x8f}, 1},
+    {{0xc5,0x47,0x20,0x09,0x46,0x41,0x72,0x4e,0x9b,0x84,0x47,0xd1,0x51,0x23,0xed,0x44,0x73,0x56,0x37,0x88,0x00,0x8f,0x75,0x37,0x10,0x28,0xa0,0xbe,0x75,0x2b,0x61,0x54}, 0},
+    {{0xc5,0x47,0x20,0x09,0x46,0x41,0x72,0x4e,0x9b,0x84,0x47,0xd1,0x51,0x23,0xed,0x44,0x73,0x56,0x37,0x88,0x00,0x8f,0x75,0x37,0x10,0x28,0xa0,0xbe,0x75,0x2b,0x61,0x54}, 1},
+    {{0xc5,0x79,0xd1,0xd9,0x00,0x3c,0x52,0x47,0x05,0xbf,0xb7,0x8a,0xb1,0x31,0x07,0x34,0xb8,0xc2,0x9f,0xd2,0xae,0x2d,0x0f,0x56,0xf0,0x9b,0x57,0xb2,0xdb,0x11,0x63,0x54}, 0},
+    {{0xc5,0x79,0xd1,0xd9,0x00,0x3c,0x52,0x47,0x05,0xbf,0xb7,0x8a,0xb1,0x31,0x07,0x34,0xb8,0xc2,0x9f,0xd2,0xae,0x2d,0x0f,0x56,0xf0,0x9b,0x57,0xb2,0xdb,0x11,0x63,0x54}, 1},
+    {{0xc5,0xc6,0xc6,0xbb,0x6e,0x29,0x03,0x2f,0x1a,0xc2,0x2d,0x0e,0x16,0x39,0x3a,0x83,0xa8,0x2b,0x16,0x30,0xee,0x22,0xcb,0x9f,0x59,0xe9,0x2a,0x2f,0xa7,0x14,0xb5,0xce}, 0},
+    {{0xc5,0xdc,0xbd,0x6d,0xf3,0x43,0x05,0x44,0x58,0xc3,0xf7,0x6a,0x1e,0xc1,0x90,0xf0,0xd2,0xd9,0x46,0x2f,0x45,0xc3,0x17,0x6a,0x17,0xd3,0x92,0xa2,0x85,0x8b,0x46,0x06}, 0},
+    {{0xc5,0xdc,0xbd,0x6d,0xf3,0x43,0x05,0x44,0x58,0xc3,0xf7,0x6a,0x1e,0xc1,0x90,0xf0,0xd2,0xd9,0x46,0x2f,0x45,0xc3,0x17,0x6a,0x17,0xd3,0x92,0xa2,0x85,0x8b,0x46,0x06}, 1},
+    {{0xc5,0xe3,0x29,0x86,0x5a,0x08,0x87,0x67,0xe1,0x86,0x0f,0x0e,0xc5,0x22,0xda,0x1e,0x60,0x8b,0x06,0x7f,0xc3,0x78,0x5c,0x87,0xb7,0xb5,0xab,0x23,0x6a,0xd7,0xfd,0xde}, 0},
+    {{0xc6,0x19,0x38,0x32,0x21,0x78,0x7a,0x90,0x04,0x2e,0x8b,0x1d,0xb6,0x21,0xf3,0xc8,0xb7,0x59,0x45,0x7d,0xa2,0xd7,0x8c,0xa0,0x1b,0xea,0x5c,0x3a,0xd1,0xca,0x4d,0x32}, 0},
+    {{0xc6,0x19,0x38,0x32,0x21,0x78,0x7a,0x90,0x04,0x2e,0x8b,0x1d,0xb6,0x21,0xf3,0xc8,0xb7,0x59,0x45,0x7d,0xa2,0xd7,0x8c,0xa0,0x1b,0xea,0x5c,0x3a,0xd1,0xca,0x4d,0x32}, 1},
+    {{0xc6,0x2d,0xa2,0xa3,0x66,0xb4,0x85,0x08,0x7a,0x9d,0x7e,0x10,0xd6,0x04,0x93,0x48,0xcf,0x78,0x30,0x9f,0x70,0xcf,0x43,0x2d,0x05,0xe4,0xfe,0x59,0x4f,0xe4,0x39,0x01}, 0},
+    {{0xc6,0x2d,0xa2,0xa3,0x66,0xb4,0x85,0x08,0x7a,0x9d,0x7e,0x10,0xd6,0x04,0x93,0x48,0xcf,0x78,0x30,0x9f,0x70,0xcf,0x43,0x2d,0x05,0xe4,0xfe,0x59,0x4f,0xe4,0x39,0x01}, 1},
+    {{0xc6,0x62,0xac,0x2e,0xaa,0x6f,0xf7,0x5e,0x48,0x3f,0xe7,0xb1,0xdf,0xb4,0xe1,0x4e,0x82,0x6e,0x4c,0x6e,0x10,0xf2,0xc6,0xab,0x08,0x59,0xdc,0xd9,0x52,0x4c,0x09,0xff}, 0},
+    {{0xc6,0x62,0xac,0x2e,0xaa,0x6f,0xf7,0x5e,0x48,0x3f,0xe7,0xb1,0xdf,0xb4,0xe1,0x4e,0x82,0x6e,0x4c,0x6e,0x10,0xf2,0xc6,0xab,0x08,0x59,0xdc,0xd9,0x52,0x4c,0x09,0xff}, 1},
+    {{0xc6,0xb8,0x58,0x3b,0xcd,0x3d,0xec,0x0f,0xf1,0xbb,0xb9,0x12,0xa2,0xda,0x17,0x5b,0x3e,0xa2,0x6a,0xe5,0x52,0x0f,0x94,0x9e,0x97,0x3d,0xd6,0x4d,0x46,0xbf,0xcd,0xbc}, 0},
+    {{0xc6,0xe5,0xcf,0x2e,0x79,0x99,0xc4,0x22,0xed,0xe6,0x1f,0xb3,0x2f,0x45,0xf9,0x6b,0x58,0x15,0xef,0x3d,0x7f,0x45,0xf1,0xab,0x4f,0x5c,0xff,0xa8,0xf6,0xa9,0x28,0x1d}, 0},
+    {{0xc6,0xe5,0xcf,0x2e,0x79,0x99,0xc4,0x22,0xed,0xe6,0x1f,0xb3,0x2f,0x45,0xf9,0x6b,0x58,0x15,0xef,0x3d,0x7f,0x45,0xf1,0xab,0x4f,0x5c,0xff,0xa8,0xf6,0xa9,0x28,0x1d}, 1},
+    {{0xc6,0xe9,0x78,0x73,0x84,0x27,0x32,0xa7,0x08,0x8e,0xce,0xdb,0x63,0x26,0x66,0x53,0x19,0x76,0x93,0xee,0x0d,0x7a,0xa8,0x92,0x74,0x90,0x00,0xf1,0xdd,0x8a,0x57,0xf9}, 0},
+    {{0xc6,0xe9,0x78,0x73,0x84,0x27,0x32,0xa7,0x08,0x8e,0xce,0xdb,0x63,0x26,0x66,0x53,0x19,0x76,0x93,0xee,0x0d,0x7a,0xa8,0x92,0x74,0x90,0x00,0xf1,0xdd,0x8a,0x57,0xf9}, 1},
+    {{0xc6,0xe9,0xc3,0x7c,0x50,0xad,0xbc,0xd7,0x21,0x7e,0x56,0xb1,0x38,0x98,0xdb,0xa1,0x18,0x17,0x22,0xaf,0xeb,0x78,0x61,0xf2,0xb9,0x5d,0x61,0x76,0x0c,0x2c,0xad,0x8e}, 0},
+    {{0xc7,0x3c,0xd9,0x7a,0xaf,0xeb,0x51,0x12,0x5d,0xab,0xa7,0xd1,0xa7,0xd3,0x36,0xd4,0x39,0x59,0x72,0xee,0x18,0x3e,0x10,0x1b,0x9a,0x0e,0x1e,0x28,0xf2,0x1c,0x5b,0xbe}, 0},
+    {{0xc7,0x3c,0xd9,0x7a,0xaf,0xeb,0x51,0x12,0x5d,0xab,0xa7,0xd1,0xa7,0xd3,0x36,0xd4,0x39,0x59,0x72,0xee,0x18,0x3e,0x10,0x1b,0x9a,0x0e,0x1e,0x28,0xf2,0x1c,0x5b,0xbe}, 1},
+    {{0xc7,0x9b,0xc2,0xdd,0x6a,0x3e,0xd2,0x3c,0xd4,0xbe,0x05,0xce,0xc6,0xea,0x0c,0x00,0xa4,0x9b,0x2a,0x75,0x4e,0xcc,0x5f,0x8c,0xe6,0xba,0xd7,0x16,0x91,0xd7,0xa6,0xc6}, 0},
+    {{0xc7,0x9b,0xc2,0xdd,0x6a,0x3e,0xd2,0x3c,0xd4,0xbe,0x05,0xce,0xc6,0xea,0x0c,0x00,0xa4,0x9b,0x2a,0x75,0x4e,0xcc,0x5f,0x8c,0xe6,0xba,0xd7,0x16,0x91,0xd7,0xa6,0xc6}, 1},
+    {{0xc7,0xda,0xd4,0xb0,0xd0,0x11,0x9c,0xac,0xf7,0x97,0xa2,0xf7,0x24,0xb6,0x08,0x03,0x69,0x21,0x83,0x6c,0x61,0xc1,0xba,0xb7,0xad,0xf6,0xd0,0x72,0x74,0xd1,0x70,0x7f}, 0},
+    {{0xc7,0xda,0xd4,0xb0,0xd0,0x11,0x9c,0xac,0xf7,0x97,0xa2,0xf7,0x24,0xb6,0x08,0x03,0x69,0x21,0x83,0x6c,0x61,0xc1,0xba,0xb7,0xad,0xf6,0xd0,0x72,0x74,0xd1,0x70,0x7f}, 1},
+    {{0xc8,0x46,0x84,0x19,0x47,0x16,0xdf,0x32,0x80,0x13,0xe9,0x50,0xa9,0xc6,0xda,0xfa,0x3c,0xda,0x88,0xe2,0x0c,0xab,0x26,0x2f,0xb4,0xc6,0x7f,0x2a,0x23,0x55,0xde,0x99}, 0},
+    {{0xc8,0x46,0x84,0x19,0x47,0x16,0xdf,0x32,0x80,0x13,0xe9,0x50,0xa9,0xc6,0xda,0xfa,0x3c,0xda,0x88,0xe2,0x0c,0xab,0x26,0x2f,0xb4,0xc6,0x7f,0x2a,0x23,0x55,0xde,0x99}, 1},
+    {{0xc8,0x6f,0x33,0x32,0xa0,0xdf,0xed,0xf8,0xf8,0x39,0xe5,0x4a,0x47,0x3f,0xcc,0x42,0x7e,0xe9,0x15,0xae,0xaa,0xd5,0xbd,0x1d,0x93,0xe2,0xf8,0x33,0x14,0x31,0xc7,0x0f}, 0},
+    {{0xc8,0x6f,0x33,0x32,0xa0,0xdf,0xed,0xf8,0xf8,0x39,0xe5,0x4a,0x47,0x3f,0xcc,0x42,0x7e,0xe9,0x15,0xae,0xaa,0xd5,0xbd,0x1d,0x93,0xe2,0xf8,0x33,0x14,0x31,0xc7,0x0f}, 1},
+    {{0xc8,0x92,0xbc,0x03,0x63,0x32,0xbb,0xcf,0xaf,0xad,0x12,0x5f,0x41,0x1e,0x21,0x29,0xb8,0x20,0x9e,0x7b,0x05,0xdc,0x33,0xd0,0xf4,0x22,0x4a,0xd4,0x4f,0xf1,0x0b,0x13}, 0},
+    {{0xc8,0xbb,0x9c,0x73,0x89,0x01,0x18,0xa9,0xfd,0x30,0x7d,0x51,0xd0,0xd4,0x31,0xcc,0x67,0xd1,0xc5,0x36,0x94,0x5b,0xae,0xcf,0xc2,0x2b,0xd1,0x15,0x87,0xf3,0xf3,0xa3}, 0},
+    {{0xc8,0xbb,0x9c,0x73,0x89,0x01,0x18,0xa9,0xfd,0x30,0x7d,0x51,0xd0,0xd4,0x31,0xcc,0x67,0xd1,0xc5,0x36,0x94,0x5b,0xae,0xcf,0xc2,0x2b,0xd1,0x15,0x87,0xf3,0xf3,0xa3}, 1},
+    {{0xc8,0xca,0x44,0x40,0x27,0xa1,0xc3,0x48,0x17,0x81,0x43,0x4e,0x99,0xb5,0x1b,0x1c,0xbc,0x70,0xcb,0xfc,0x78,0x1f,0xe9,0x1f,0x73,0x06,0x92,0x85,0xfb,0xda,0x6a,0x27}, 0},
+    {{0xc8,0xca,0x44,0x40,0x27,0xa1,0xc3,0x48,0x17,0x81,0x43,0x4e,0x99,0xb5,0x1b,0x1c,0xbc,0x70,0xcb,0xfc,0x78,0x1f,0xe9,0x1f,0x73,0x06,0x92,0x85,0xfb,0xda,0x6a,0x27}, 1},
+    {{0xc8,0xf0,0x84,0x62,0xed,0x6f,0xfb,0x3c,0xc1,0x30,0xa9,0xee,0x75,0xa3,0x8d,0x10,0x87,0xce,0xf1,0x26,0x83,0xd0,0x69,0xa3,0x35,0x6f,0x89,0x58,0xf4,0x56,0xd8,0x6b}, 0},
+    {{0xc8,0xf0,0x84,0x62,0xed,0x6f,0xfb,0x3c,0xc1,0x30,0xa9,0xee,0x75,0xa3,0x8d,0x10,0x87,0xce,0xf1,0x26,0x83,0xd0,0x69,0xa3,0x35,0x6f,0x89,0x58,0xf4,0x56,0xd8,0x6b}, 1},
+    {{0xc9,0x36,0xae,0x51,0x97,0x74,0xc9,0x55,0x39,0xd3,0x2b,0x4e,0xc6,0xeb,0x62,0x69,0xf6,0x61,0xfd,0x07,0x35,0x66,0x2d,0x67,0x16,0x8a,0x7a,0x3a,0x92,0x1c,0x81,0x66}, 0},
+    {{0xc9,0xe1,0xd0,0xd6,0x14,0xc1,0x8f,0xcc,0x7d,0x84,0xf6,0x36,0xde,0xba,0xc4,0x33,0x2f,0x8e,0xbe,0x22,0xb4,0x4a,0x44,0x44,0x8d,0x53,0xdf,0xcc,0xc6,0x1c,0x86,0xc4}, 0},
+    {{0xca,0x55,0xff,0x37,0xb2,0xfc,0x8b,0xaf,0xc9,0xb2,0xf5,0xff,0x54,0xda,0x5f,0xf4,0x34,0x13,0xab,0x5c,0x4d,0xb3,0xaa,0x78,0xc1,0xb8,0xb6,0x62,0xbd,0x99,0x8e,0xe3}, 0},
+    {{0xcb,0x9d,0x3d,0xf5,0xb2,0xc4,0x33,0xed,0xaa,0x6d,0x94,0xcc,0xb1,0x4b,0xe2,0xc5,0xb2,0xc7,0xa9,0x72,0xf2,0xfb,0x6a,0x43,0x14,0x72,0x1b,0xd0,0x19,0xe7,0x22,0xf9}, 0},
+    {{0xcb,0x9d,0x3d,0xf5,0xb2,0xc4,0x33,0xed,0xaa,0x6d,0x94,0xcc,0xb1,0x4b,0xe2,0xc5,0xb2,0xc7,0xa9,0x72,0xf2,0xfb,0x6a,0x43,0x14,0x72,0x1b,0xd0,0x19,0xe7,0x22,0xf9}, 1},
+    {{0xcb,0xc1,0x99,0x41,0xca,0x99,0x5e,0x98,0xc2,0x63,0xfc,0x27,0x4f,0x6b,0x8a,0x3b,0xa1,0xcb,0x0a,0x7f,0x25,0xa3,0x33,0xa1,0x00,0xef,0x31,0x68,0x6e,0x05,0x9b,0x8b}, 0},
+    {{0xcb,0xc1,0x99,0x41,0xca,0x99,0x5e,0x98,0xc2,0x63,0xfc,0x27,0x4f,0x6b,0x8a,0x3b,0xa1,0xcb,0x0a,0x7f,0x25,0xa3,0x33,0xa1,0x00,0xef,0x31,0x68,0x6e,0x05,0x9b,0x8b}, 1},
+    {{0xcb,0xf4,0x6b,0xe1,0x7e,0x38,0x1f,0x22,0xd5,0x34,0xc4,0xe2,0x48,0x04,0x19,0xeb,0xef,0xfa,0xc2,0x2b,0xbc,0xf7,0xa2,0xbf,0x46,0x3b,0x56,0x69,0x16,0xdd,0x5a,0xb4}, 0},
+    {{0xcb,0xf4,0x6b,0xe1,0x7e,0x38,0x1f,0x22,0xd5,0x34,0xc4,0xe2,0x48,0x04,0x19,0xeb,0xef,0xfa,0xc2,0x2b,0xbc,0xf7,0xa2,0xbf,0x46,0x3b,0x56,0x69,0x16,0xdd,0x5a,0xb4}, 1},
+    {{0xcc,0x3c,0x42,0x4a,0xb7,0x4f,0x5a,0x06,0xc6,0x97,0x8d,0x21,0x08,0x41,0x6e,0x75,0x4a,0x68,0x4b,0xc9,0x58,0x86,0xd5,0x27,0x75,0x4e,0xd9,0x1f,0xea,0xa2,0x9d,0x2e}, 0},
+    {{0xcc,0x3c,0x42,0x4a,0xb7,0x4f,0x5a,0x06,0xc6,0x97,0x8d,0x21,0x08,0x41,0x6e,0x75,0x4a,0x68,0x4b,0xc9,0x58,0x86,0xd5,0x27,0x75,0x4e,0xd9,0x1f,0xea,0xa2,0x9d,0x2e}, 1},
+    {{0xcc,0x50,0xcc,0x5c,0xdd,0x6b,0x83,0x98,0x61,0x45,0x0d,0x9d,0x06,0xb2,0xa4,0x74,0x42,0x9a,0x6f,0xc9,0x1b,0x41,0xe6,0xeb,0x34,0xb7,0xdb,0xe4,0xf1,0x55,0x71,0xdf}, 0},
+    {{0xcc,0x50,0xcc,0x5c,0xdd,0x6b,0x83,0x98,0x61,0x45,0x0d,0x9d,0x06,0xb2,0xa4,0x74,0x42,0x9a,0x6f,0xc9,0x1b,0x41,0xe6,0xeb,0x34,0xb7,0xdb,0xe4,0xf1,0x55,0x71,0xdf}, 1},
+    {{0xcc,0x7b,0xe9,0xb1,0xa7,0xe9,0x87,0x4e,0x2e,0x6d,0xe0,0x3d,0x37,0x2a,0x90,0xe6,0xe4,0x02,0x0a,0x3b,0xdc,0xf9,0x37,0x1a,0x37,0xbc,0xa0,0x61,0xe7,0x43,0x2e,0x0e}, 0},
+    {{0xcc,0xe9,0x9e,0xb2,0xd3,0x4a,0xc5,0x05,0x50,0xc2,0xd3,0xb8,0x5e,0xd1,0x34,0xdb,0x70,0xcb,0x84,0xff,0x88,0x09,0x69,0x4d,0xb2,0xa7,0x08,0xd8,0x8c,0x04,0x8b,0xb4}, 0},
+    {{0xcd,0x3e,0x9d,0x14,0xe2,0x52,0x6d,0xfb,0xeb,0xb8,0x68,0xa1,0x27,0xd7,0x79,0xd5,0x97,0x1d,0x77,0x0f,0xeb,0xd4,0xfc,0xb3,0xf3,0x60,0x89,0x1b,0x03,0x40,0xe1,0x88}, 0},
+    {{0xcd,0x3e,0x9d,0x14,0xe2,0x52,0x6d,0xfb,0xeb,0xb8,0x68,0xa1,0x27,0xd7,0x79,0xd5,0x97,0x1d,0x77,0x0f,0xeb,0xd4,0xfc,0xb3,0xf3,0x60,0x89,0x1b,0x03,0x40,0xe1,0x88}, 1},
+    {{0xcd,0x91,0x0c,0x47,0x53,0x9e,0x81,0xbd,0x33,0x2a,0xe5,0xeb,0xa0,0x2e,0xfc,0xb2,0x52,0x1f,0x3b,0x41,0x62,0xe8,0x68,0x2a,0xb0,0x2b,0xfc,0x85,0x44,0x1d,0x3e,0xed}, 0},
+    {{0xce,0x0b,0xd1,0xac,0x0e,0xbb,0x3c,0x11,0x32,0x1a,0x1b,0xdf,0x83,0x5a,0x05,0x5d,0x0a,0x57,0xa7,0x06,0x9d,0x09,0x8f,0x5f,0xff,0x6e,0x8a,0xd8,0x15,0xf0,0x95,0xc1}, 0},
+    {{0xce,0x97,0xd2,0x1c,0x5d,0xae,0xea,0xc1,0x01,0x91,0x7b,0x19,0x32,0xb3,0x77,0x17,0x2c,0x1a,0x69,0x46,0x41,0x46,0xcc,0x97,0xcf,0xae,0x74,0x60,0xab,0x7d,0x44,0x38}, 0},
+    {{0xcf,0x05,0xf8,0xa9,0x35,0xae,0x51,0xa7,0x19,0x52,0x33,0xd9,0xb1,0x69,0x78,0xf8,0x6d,0xbe,0x33,0xa1,0xbf,0xd4,0x9b,0xac,0x41,0xdb,0x96,0x91,0x12,0xd0,0x18,0x6d}, 0},
+    {{0xcf,0x05,0xf8,0xa9,0x35,0xae,0x51,0xa7,0x19,0x52,0x33,0xd9,0xb1,0x69,0x78,0xf8,0x6d,0xbe,0x33,0xa1,0xbf,0xd4,0x9b,0xac,0x41,0xdb,0x96,0x91,0x12,0xd0,0x18,0x6d}, 1},
+    {{0xcf,0x68,0x10,0x2a,0x93,0x1c,0x07,0x24,0x53,0x47,0x0a,0x00,0x8d,0x38,0x04,0xca,0x67,0x2d,0x6e,0xf1,0x35,0xb8,0x90,0x1c,0x2d,0xad,0xb3,0xf9,0xae,0x35,0x53,0x94}, 0},
+    {{0xcf,0x68,0x10,0x2a,0x93,0x1c,0x07,0x24,0x53,0x47,0x0a,0x00,0x8d,0x38,0x04,0xca,0x67,0x2d,0x6e,0xf1,0x35,0xb8,0x90,0x1c,0x2d,0xad,0xb3,0xf9,0xae,0x35,0x53,0x94}, 1},
+    {{0xcf,0x86,0x1a,0x75,0x55,0x22,0xed,0x5a,0x55,0x79,0x8f,0x67,0xd3,0xed,0x2e,0x03,0x6a,0xdb,0xda,0xdc,0x99,0x36,0xaf,0xce,0xd6,0x65,0x67,0x9c,0xe1,0xff,0xad,0x6e}, 0},
+    {{0xcf,0x86,0x1a,0x75,0x55,0x22,0xed,0x5a,0x55,0x79,0x8f,0x67,0xd3,0xed,0x2e,0x03,0x6a,0xdb,0xda,0xdc,0x99,0x36,0xaf,0xce,0xd6,0x65,0x67,0x9c,0xe1,0xff,0xad,0x6e}, 1},
+    {{0xcf,0x96,0x59,0xe9,0x19,0x34,0x56,0x41,0xf5,0xf3,0x11,0xaa,0x3c,0x02,0xf5,0x61,0x7a,0x59,0xaa,0x85,0x33,0x64,0x7f,0x44,0xe4,0xcb,0x36,0xdf,0xb5,0xdd,0x2e,0xf6}, 0},
+    {{0xcf,0xad,0x29,0xaa,0xd8,0xb4,0x76,0xb6,0x70,0xd7,0x18,0x34,0x47,0x39,0xe6,0xf4,0x36,0x8c,0xc6,0x0b,0x5e,0x8e,0x89,0xb8,0xc2,0xaf,0xd4,0x1b,0x72,0x48,0xb1,0xe2}, 0},
+    {{0xd0,0x2d,0xd7,0x93,0xdc,0x38,0xec,0x1a,0x4f,0xec,0x91,0x8f,0xc3,0x2c,0x88,0x6b,0xbc,0x39,0x27,0x93,0x8d,0xe4,0x78,0xf8,0x4a,0xff,0xfa,0xbf,0xc2,0x4d,0x50,0xf7}, 0},
+    {{0xd0,0x2d,0xd7,0x93,0xdc,0x38,0xec,0x1a,0x4f,0xec,0x91,0x8f,0xc3,0x2c,0x88,0x6b,0xbc,0x39,0x27,0x93,0x8d,0xe4,0x78,0xf8,0x4a,0xff,0xfa,0xbf,0xc2,0x4d,0x50,0xf7}, 1},
+    {{0xd0,0x7a,0x0e,0x1e,0x20,0x02,0xa8,0xba,0x0c,0x5a,0xa5,0x55,0xb0,0xcb,0x45,0x87,0x87,0x24,0x24,0x0a,0xa7,0xc5,0x01,0x40,0x65,0x8a,0x6f,0x69,0xe3,0xbd,0xc0,0xb2}, 0},
+    {{0xd0,0x7a,0x0e,0x1e,0x20,0x02,0xa8,0xba,0x0c,0x5a,0xa5,0x55,0xb0,0xcb,0x45,0x87,0x87,0x24,0x24,0x0a,0xa7,0xc5,0x01,0x40,0x65,0x8a,0x6f,0x69,0xe3,0xbd,0xc0,0xb2}, 1},
+    {{0xd0,0xaa,0xf7,0xb6,0x9a,0x47,0x2c,0x61,0x12,0x36,0xa5,0x2e,0x6c,0x4b,0x2e,0x1e,0x2b,0x9c,0xfa,0x93,0xd5,0x22,0x0e,0x61,0xfa,0x31,0x3f,0xc3,0xcd,0xd2,0x84,0x84}, 0},
+    {{0xd0,0xaa,0xf7,0xb6,0x9a,0x47,0x2c,0x61,0x12,0x36,0xa5,0x2e,0x6c,0x4b,0x2e,0x1e,0x2b,0x9c,0xfa,0x93,0xd5,0x22,0x0e,0x61,0xfa,0x31,0x3f,0xc3,0xcd,0xd2,0x84,0x84}, 1},
+    {{0xd0,0xd4,0x74,0x90,0x47,0x1a,0xb8,0x03,0x60,0x0f,0x26,0x46,0x47,0x59,0x39,0xf1,0x90,0x1a,0x05,0x31,0x8a,0x21,0x98,0x89,0x89,0x3e,0x1a,0xc8,0x24,0x12,0xf7,0xab}, 0},
+    {{0xd0,0xd4,0x74,0x90,0x47,0x1a,0xb8,0x03,0x60,0x0f,0x26,0x46,0x47,0x59,0x39,0xf1,0x90,0x1a,0x05,0x31,0x8a,0x21,0x98,0x89,0x89,0x3e,0x1a,0xc8,0x24,0x12,0xf7,0xab}, 1},
+    {{0xd0,0xf5,0xa7,0x94,0x1d,0x41,0xa2,0x4d,0x78,0x69,0xf2,0x47,0xc8,0xe0,0x26,0x6b,0x41,0xde,0xcd,0x0f,0x9a,0xfc,0x31,0xa2,0xdd,0x22,0x13,0x50,0xfd,0x4a,0xa7,0xb1}, 0},
+    {{0xd1,0x33,0x06,0xe2,0xdf,0x48,0xfd,0x05,0x64,0x3b,0xf2,0x9c,0xfe,0x5a,0x81,0x84,0x55,0xa0,0xfd,0x57,0xe4,0x78,0xf8,0x11,0xd1,0xac,0x9f,0x66,0xcc,0xf6,0xf9,0x91}, 0},
+    {{0xd1,0x33,0x06,0xe2,0xdf,0x48,0xfd,0x05,0x64,0x3b,0xf2,0x9c,0xfe,0x5a,0x81,0x84,0x55,0xa0,0xfd,0x57,0xe4,0x78,0xf8,0x11,0xd1,0xac,0x9f,0x66,0xcc,0xf6,0xf9,0x91}, 1},
+    {{0xd1,0x3f,0xed,0xe9,0x73,0x66,0xf0,0x2a,0x7e,0x40,0x41,0xee,0xdb,0x8a,0x4a,0x44,0xd4,0x89,0x47,0x19,0x9d,0xe7,0xa6,0xae,0x87,0x6f,0x29,0xb1,0x7f,0xc3,0x6b,0xe0}, 0},
+    {{0xd1,0x3f,0xed,0xe9,0x73,0x66,0xf0,0x2a,0x7e,0x40,0x41,0xee,0xdb,0x8a,0x4a,0x44,0xd4,0x89,0x47,0x19,0x9d,0xe7,0xa6,0xae,0x87,0x6f,0x29,0xb1,0x7f,0xc3,0x6b,0xe0}, 1},
+    {{0xd1,0x4a,0x00,0x44,0x82,0xbb,0x73,0x4f,0xf3,0x8f,0xa4,0xbf,0xfc,0x4a,0xd9,0x59,0x66,0xd8,0x56,0x05,0x1b,0x5d,0x60,0x6e,0x55,0x48,0x83,0xb5,0x09,0x4d,0x28,0xda}, 0},
+    {{0xd1,0x58,0xa3,0x1d,0x7f,0xe4,0x20,0x01,0xca,0xf5,0xff,0xf2,0x0b,0x44,0x1c,0x72,0xe0,0x91,0x52,0x69,0x22,0x81,0xb6,0x56,0xf1,0x14,0x63,0xc1,0x7c,0x85,0x7e,0x19}, 0},
+    {{0xd1,0x58,0xa3,0x1d,0x7f,0xe4,0x20,0x01,0xca,0xf5,0xff,0xf2,0x0b,0x44,0x1c,0x72,0xe0,0x91,0x52,0x69,0x22,0x81,0xb6,0x56,0xf1,0x14,0x63,0xc1,0x7c,0x85,0x7e,0x19}, 1},
+    {{0xd1,0x76,0x98,0xed,0xe4,0x1b,0x34,0x18,0x35,0x25,0x6e,0x41,0x2b,0xe6,0x23,0x68,0x43,0x91,0x91,0xcb,0xf2,0x9a,0x34,0xd4,0xd6,0x52,0x60,0x5a,0x97,0x84,0x18,0xbb}, 0},
+    {{0xd1,0x76,0x98,0xed,0xe4,0x1b,0x34,0x18,0x35,0x25,0x6e,0x41,0x2b,0xe6,0x23,0x68,0x43,0x91,0x91,0xcb,0xf2,0x9a,0x34,0xd4,0xd6,0x52,0x60,0x5a,0x97,0x84,0x18,0xbb}, 1},
+    {{0xd1,0x8e,0xfe,0x9c,0x0b,0x7c,0x3e,0x11,0x37,0xf9,0x62,0xf1,0x49,0x1d,0xce,0x6f,0xc0,0x53,0x23,0x49,0xcd,0xb0,0x4d,0x5b,0x7f,0xeb,0x9c,0xe9,0xfd,0xe7,0x17,0x7b}, 0},
+    {{0xd1,0x8e,0xfe,0x9c,0x0b,0x7c,0x3e,0x11,0x37,0xf9,0x62,0xf1,0x49,0x1d,0xce,0x6f,0xc0,0x53,0x23,0x49,0xcd,0xb0,0x4d,0x5b,0x7f,0xeb,0x9c,0xe9,0xfd,0xe7,0x17,0x7b}, 1},
+    {{0xd1,0xf5,0xe7,0xd4,0x3f,0x73,0x9d,0xc0,0x3a,0x33,0x62,0x1a,0xff,0xfa,0xf7,0xec,0xb5,0xc9,0x37,0x91,0x7f,0x8f,0x06,0x7b,0x86,0xa2,0x63,0x5b,0xf0,0x1a,0x37,0x67}, 0},
+    {{0xd1,0xf5,0xe7,0xd4,0x3f,0x73,0x9d,0xc0,0x3a,0x33,0x62,0x1a,0xff,0xfa,0xf7,0xec,0xb5,0xc9,0x37,0x91,0x7f,0x8f,0x06,0x7b,0x86,0xa2,0x63,0x5b,0xf0,0x1a,0x37,0x67}, 1},
+    {{0xd2,0x2e,0x75,0xb0,0x5f,0x81,0xcf,0x17,0xa5,0xa4,0xc9,0x88,0x31,0x59,0x5a,0xd1,0xb0,0xdf,0x35,0xab,0x96,0x9a,0x01,0x77,0x65,0xa2,0x6a,0x74,0xf7,0x3c,0x61,0x66}, 0},
+    {{0xd2,0x2e,0x75,0xb0,0x5f,0x81,0xcf,0x17,0xa5,0xa4,0xc9,0x88,0x31,0x59,0x5a,0xd1,0xb0,0xdf,0x35,0xab,0x96,0x9a,0x01,0x77,0x65,0xa2,0x6a,0x74,0xf7,0x3c,0x61,0x66}, 1},
+    {{0xd2,0xbb,0x8c,0x5a,0x6e,0x44,0x41,0x47,0xd5,0xd3,0x96,0x9b,0xe5,0x6a,0x1c,0x27,0xdc,0xe9,0x45,0x77,0x4c,0xf6,0xbe,0x49,0x05,0x12,0x3d,0x09,0x4c,0x8e,0xe1,0xd7}, 0},
+    {{0xd2,0xbb,0x8c,0x5a,0x6e,0x44,0x41,0x47,0xd5,0xd3,0x96,0x9b,0xe5,0x6a,0x1c,0x27,0xdc,0xe9,0x45,0x77,0x4c,0xf6,0xbe,0x49,0x05,0x12,0x3d,0x09,0x4c,0x8e,0xe1,0xd7}, 1},
+    {{0xd3,0x31,0x1b,0xb3,0x40,0xc4,0x73,0xee,0x75,0xc6,0xd3,0xc2,0x27,0xf4,0xd0,0x68,0xde,0xc8,0x81,0xb1,0xd5,0x1b,0x16,0xd6,0xbb,0x4f,0x95,0xdd,0xb5,0x11,0xb1,0xf6}, 0},
+    {{0xd3,0x31,0x1b,0xb3,0x40,0xc4,0x73,0xee,0x75,0xc6,0xd3,0xc2,0x27,0xf4,0xd0,0x68,0xde,0xc8,0x81,0xb1,0xd5,0x1b,0x16,0xd6,0xbb,0x4f,0x95,0xdd,0xb5,0x11,0xb1,0xf6}, 1},
+    {{0xd4,0x41,0xca,0xcf,0x26,0x87,0x81,0x40,0x6e,0x80,0x54,0x04,0x84,0x1e,0xb7,0x54,0xbb,0xbe,0x28,0x08,0xbf,0xd0,0xbb,0xff,0xe3,0x01,0xc5,0x0e,0x6a,0xe6,0x7b,0x53}, 0},
+    {{0xd4,0x41,0xca,0xcf,0x26,0x87,0x81,0x40,0x6e,0x80,0x54,0x04,0x84,0x1e,0xb7,0x54,0xbb,0xbe,0x28,0x08,0xbf,0xd0,0xbb,0xff,0xe3,0x01,0xc5,0x0e,0x6a,0xe6,0x7b,0x53}, 1},
+    {{0xd4,0x7b,0x3d,0x1f,0x48,0x6d,0xbe,0xb3,0x44,0x13,0x36,0x3e,0xed,0xa2,0xa2,0x4d,0x82,0xe2,0x48,0xf0,0xf7,0x65,0x9c,0x92,0x13,0x10,0x55,0x4f,0xe2,0x14,0x3a,0x94}, 0},
+    {{0xd4,0x93,0x74,0x96,0xe4,0x17,0x05,0xea,0x7c,0x93,0xa7,0x18,0x6b,0xa2,0x14,0xa3,0x5e,0x4b,0x59,0xf3,0x87,0x4d,0x0d,0x8b,0x37,0xb6,0xcc,0x1b,0x25,0x6c,0xa9,0x9d}, 0},
+    {{0xd4,0x93,0x74,0x96,0xe4,0x17,0x05,0xea,0x7c,0x93,0xa7,0x18,0x6b,0xa2,0x14,0xa3,0x5e,0x4b,0x59,0xf3,0x87,0x4d,0x0d,0x8b,0x37,0xb6,0xcc,0x1b,0x25,0x6c,0xa9,0x9d}, 1},
+    {{0xd5,0x5c,0x63,0xe9,0x85,0xe9,0xab,0x9d,0x2c,0xd6,0x81,0xbb,0x96,0x45,0x85,0xbc,0x66,0xe0,0x95,0x2b,0xce,0x48,0xf0,0xca,0x33,0x49,0x9c,0x22,0xfb,0x5c,0x66,0x18}, 0},
+    {{0xd5,0xaa,0x4e,0xd6,0xc2,0x1a,0xa0,0x55,0x80,0x54,0x03,0x38,0xd7,0x72,0x60,0xa2,0xc7,0xf7,0xcb,0x6f,0x42,0x32,0xa9,0xf6,0x64,0xa9,0x63,0x2d,0x58,0xac,0xef,0xe4}, 0},
+    {{0xd5,0xaa,0x4e,0xd6,0xc2,0x1a,0xa0,0x55,0x80,0x54,0x03,0x38,0xd7,0x72,0x60,0xa2,0xc7,0xf7,0xcb,0x6f,0x42,0x32,0xa9,0xf6,0x64,0xa9,0x63,0x2d,0x58,0xac,0xef,0xe4}, 1},
+    {{0xd5,0xab,0x06,0x3b,0x33,0x67,0x35,0x50,0x8a,0x03,0x96,0xe6,0x5a,0x36,0x0f,0x60,0xce,0x7d,0xdc,0x8a,0x75,0x60,0xce,0xfd,0xc0,0x32,0xd5,0x14,0xa2,0x59,0xc7,0x22}, 0},
+    {{0xd5,0xab,0x06,0x3b,0x33,0x67,0x35,0x50,0x8a,0x03,0x96,0xe6,0x5a,0x36,0x0f,0x60,0xce,0x7d,0xdc,0x8a,0x75,0x60,0xce,0xfd,0xc0,0x32,0xd5,0x14,0xa2,0x59,0xc7,0x22}, 1},
+    {{0xd6,0x54,0xe7,0x55,0xf1,0x35,0x1d,0x92,0xd2,0x4c,0xfd,0x63,0xa9,0x16,0xe2,0xb6,0x26,0x57,0x22,0x10,0x6a,0xbd,0x81,0xcf,0x88,0xfe,0xe0,0x0e,0xd9,0xb4,0x76,0x52}, 0},
+    {{0xd6,0x90,0x7b,0xbd,0x20,0x52,0x18,0xb3,0x23,0xea,0xc9,0x6c,0xd2,0x95,0x34,0xe9,0x79,0x90,0xc1,0x2b,0xc4,0xe2,0x8c,0x58,0x03,0xda,0xab,0xd7,0xca,0xd1,0x5e,0xfc}, 0},
+    {{0xd6,0xbf,0x28,0xe3,0xda,0x60,0xb2,0x30,0x45,0x85,0xe2,0x31,0x95,0x95,0xf5,0xf6,0x44,0x7a,0xf7,0xd6,0xf5,0x9b,0x64,0x25,0x2b,0xc8,0xd0,0xef,0xd3,0x54,0x3a,0x99}, 0},
+    {{0xd6,0xc4,0x91,0xf3,0xd5,0xe1,0x40,0xbf,0x5e,0x2a,0xcd,0x83,0x9f,0xca,0x27,0x2d,0xca,0x4c,0xa6,0x71,0x4e,0xb3,0xdd,0x96,0x27,0xba,0x7a,0xa8,0x76,0x27,0xa2,0x66}, 0},
+    {{0xd7,0x01,0x21,0x69,0x03,0x3a,0xf1,0xb5,0x28,0x48,0x06,0x66,0xbc,0x6a,0xbf,0x80,0x54,0xbf,0xa6,0xa2,0x15,0x6f,0xd8,0x48,0xba,0x9b,0x8f,0xc0,0xca,0x49,0x8d,0x50}, 0},
+    {{0xd7,0x01,0x21,0x69,0x03,0x3a,0xf1,0xb5,0x28,0x48,0x06,0x66,0xbc,0x6a,0xbf,0x80,0x54,0xbf,0xa6,0xa2,0x15,0x6f,0xd8,0x48,0xba,0x9b,0x8f,0xc0,0xca,0x49,0x8d,0x50}, 1},
+    {{0xd7,0x0b,0x07,0x13,0xbf,0x27,0xc3,0x41,0x00,0x2a,0x0d,0xaf,0x5d,0x7b,0xd6,0xf8,0x99,0x75,0xff,0x90,0x87,0x20,0xf9,0xdd,0xcb,0xac,0x03,0x46,0x39,0xe5,0x71,0xe3}, 0},
+    {{0xd7,0x0b,0x07,0x13,0xbf,0x27,0xc3,0x41,0x00,0x2a,0x0d,0xaf,0x5d,0x7b,0xd6,0xf8,0x99,0x75,0xff,0x90,0x87,0x20,0xf9,0xdd,0xcb,0xac,0x03,0x46,0x39,0xe5,0x71,0xe3}, 1},
+    {{0xd7,0x22,0xd4,0x0e,0x0a,0x85,0xb8,0x96,0x50,0xfb,0xf2,0x9e,0x4c,0xa6,0xb7,0xfc,0x36,0x1f,0x3f,0x9f,0xaf,0x8c,0x5f,0x05,0xbf,0xfe,0x56,0x75,0x75,0x00,0xd2,0x47}, 0},
+    {{0xd7,0x22,0xd4,0x0e,0x0a,0x85,0xb8,0x96,0x50,0xfb,0xf2,0x9e,0x4c,0xa6,0xb7,0xfc,0x36,0x1f,0x3f,0x9f,0xaf,0x8c,0x5f,0x05,0xbf,0xfe,0x56,0x75,0x75,0x00,0xd2,0x47}, 1},
+    {{0xd7,0xb2,0x3e,0xd5,0xac,0x75,0x4b,0xd6,0xd1,0xc9,0xa7,0xae,0x72,0x1a,0x9b,0xf8,0x78,0xc2,0xb1,0x3c,0x6b,0x14,0xfc,0x53,0x78,0x19,0x1c,0x7f,0x0a,0xf5,0x69,0x1a}, 0},
+    {{0xd7,0xb2,0x3e,0xd5,0xac,0x75,0x4b,0xd6,0xd1,0xc9,0xa7,0xae,0x72,0x1a,0x9b,0xf8,0x78,0xc2,0xb1,0x3c,0x6b,0x14,0xfc,0x53,0x78,0x19,0x1c,0x7f,0x0a,0xf5,0x69,0x1a}, 1},
+    {{0xd8,0x4d,0x84,0x85,0x66,0xcf,0xf5,0xb6,0x0e,0x61,0x15,0x7d,0x4e,0x98,0x40,0x66,0xa0,0x22,0x5b,0xe4,0x27,0xe6,0x4b,0x74,0x0d,0xfe,0xce,0x60,0x27,0x84,0xc6,0xce}, 0},
+    {{0xd8,0x77,0x82,0xa0,0xaf,0x6d,0x4c,0xdf,0x77,0x20,0x05,0x61,0x84,0x4d,0x30,0xae,0x29,0xce,0xc5,0x0f,0x0b,0x15,0xb1,0x56,0xab,0x57,0xf6,0x48,0xcd,0x28,0x67,0x8c}, 0},
+    {{0xd9,0x33,0x46,0xa3,0x5e,0xb0,0x9a,0x7a,0x9c,0x7f,0xc8,0x73,0xf1,0x4a,0x48,0xa6,0x5f,0x31,0xad,0x6a,0xf5,0x9b,0xd7,0x10,0xcb,0x3e,0x93,0x96,0x7d,0x33,0x1d,0xf1}, 0},
+    {{0xd9,0x33,0x46,0xa3,0x5e,0xb0,0x9a,0x7a,0x9c,0x7f,0xc8,0x73,0xf1,0x4a,0x48,0xa6,0x5f,0x31,0xad,0x6a,0xf5,0x9b,0xd7,0x10,0xcb,0x3e,0x93,0x96,0x7d,0x33,0x1d,0xf1}, 1},
+    {{0xd9,0x82,0xf0,0xdd,0x1d,0xa7,0xcb,0x35,0x87,0x2e,0xec,0xfd,0x35,0x57,0xc7,0xb2,0x1d,0xed,0x7b,0x65,0x88,0x82,0x90,0xd1,0x61,0x4c,0x35,0xc5,0x39,0xa2,0xf7,0xb9}, 0},
+    {{0xd9,0x82,0xf0,0xdd,0x1d,0xa7,0xcb,0x35,0x87,0x2e,0xec,0xfd,0x35,0x57,0xc7,0xb2,0x1d,0xed,0x7b,0x65,0x88,0x82,0x90,0xd1,0x61,0x4c,0x35,0xc5,0x39,0xa2,0xf7,0xb9}, 1},
+    {{0xda,0x0b,0x29,0xa9,0x32,0xe5,0x10,0x13,0x73,0x3f,0x21,0x4d,0x54,0xc3,0xdc,0x2a,0xb3,0xc5,0x5c,0xb0,0xdc,0x6f,0x42,0xef,0xe3,0x2b,0x82,0xcd,0x86,0xb5,0x5f,0x61}, 0},
+    {{0xda,0x17,0x67,0x25,0x94,0xcd,0xcd,0x24,0x81,0xac,0x8e,0xd3,0x8c,0x2d,0x47,0x2b,0x25,0x5d,0x43,0xef,0x6e,0xf5,0xe0,0x33,0x7b,0x38,0x79,0xeb,0x16,0x24,0xb9,0xf9}, 0},
+    {{0xda,0x4b,0x95,0x54,0xd2,0x22,0xdf,0x00,0x64,0xd4,0xb3,0x3e,0xf3,0x98,0x80,0xc8,0x3b,0x7e,0x3a,0x2e,0x91,0x30,0x85,0xf1,0x1c,0xc6,0x07,0xa3,0x25,0x2a,0xb9,0x85}, 0},
+    {{0xda,0x6c,0x62,0xf2,0xf4,0xdd,0xbe,0x8a,0x9e,0x8a,0xb0,0x4b,0x10,0xaf,0x29,0xb1,0x4a,0x71,0xda,0x08,0xea,0x37,0x3a,0x8d,0x0f,0xa3,0x0e,0xe3,0xf8,0xbc,0x5c,0xe8}, 0},
+    {{0xda,0xed,0x63,0xcf,0x7b,0x3d,0x98,0x99,0x97,0x11,0x01,0xdd,0xe3,0x9d,0x2f,0xe5,0x6b,0x2b,0x96,0xda,0x8b,0xb8,0x6b,0xae,0xe0,0xe5,0x4a,0x52,0x27,0x2b,0x0e,0xd2}, 0},
+    {{0xda,0xed,0x63,0xcf,0x7b,0x3d,0x98,0x99,0x97,0x11,0x01,0xdd,0xe3,0x9d,0x2f,0xe5,0x6b,0x2b,0x96,0xda,0x8b,0xb8,0x6b,0xae,0xe0,0xe5,0x4a,0x52,0x27,0x2b,0x0e,0xd2}, 1},
+    {{0xdb,0x0a,0xb6,0xaa,0x79,0x31,0x26,0x23,0xee,0x0a,0xbd,0x2e,0x71,0x5d,0x4c,0xf8,0x11,0x5c,0x7c,0x0f,0x9c,0x98,0xc9,0x4d,0x2f,0x78,0xa9,0x07,0x82,0x37,0xa8,0x55}, 0},
+    {{0xdb,0x0a,0xb6,0xaa,0x79,0x31,0x26,0x23,0xee,0x0a,0xbd,0x2e,0x71,0x5d,0x4c,0xf8,0x11,0x5c,0x7c,0x0f,0x9c,0x98,0xc9,0x4d,0x2f,0x78,0xa9,0x07,0x82,0x37,0xa8,0x55}, 1},
+    {{0xdb,0x0c,0x19,0xb8,0x94,0x21,0x2f,0xf5,0x8c,0xbb,0xb8,0x1b,0xf9,0x78,0x0e,0x4a,0x91,0xd5,0xee,0x74,0xc2,0x75,0x2c,0xb1,0xf8,0x31,0x9b,0x08,0x4c,0x8a,0x43,0x00}, 0},
+    {{0xdb,0x0c,0x19,0xb8,0x94,0x21,0x2f,0xf5,0x8c,0xbb,0xb8,0x1b,0xf9,0x78,0x0e,0x4a,0x91,0xd5,0xee,0x74,0xc2,0x75,0x2c,0xb1,0xf8,0x31,0x9b,0x08,0x4c,0x8a,0x43,0x00}, 1},
+    {{0xdb,0x0d,0x7f,0x70,0x15,0x9a,0x10,0x9c,0x41,0xe9,0x0e,0x3e,0x19,0x43,0x39,0x05,0x22,0x0c,0x3f,0xcd,0x37,0x53,0xee,0xd2,0x67,0x0e,0x18,0x83,0x15,0x2e,0x39,0xe1}, 0},
+    {{0xdb,0x58,0x0a,0x4c,0x27,0x0b,0x3f,0x53,0xf1,0xa2,0x19,0x62,0x58,0x39,0x2d,0xb6,0xb8,0x8c,0x9e,0x94,0xa6,0x34,0xa3,0x90,0x6b,0x02,0x71,0x34,0xc5,0x39,0x50,0x48}, 0},
+    {{0xdb,0x77,0x15,0x83,0x9b,0x67,0xb6,0xfc,0x10,0xf0,0xed,0xf1,0x04,0x96,0x2f,0x2d,0xa0,0x80,0xa7,0x18,0x16,0x69,0x41,0xa3,0x55,0xff,0x45,0x29,0x9b,0xef,0xf0,0x68}, 0},
+    {{0xdb,0x77,0x15,0x83,0x9b,0x67,0xb6,0xfc,0x10,0xf0,0xed,0xf1,0x04,0x96,0x2f,0x2d,0xa0,0x80,0xa7,0x18,0x16,0x69,0x41,0xa3,0x55,0xff,0x45,0x29,0x9b,0xef,0xf0,0x68}, 1},
+    {{0xdb,0xfe,0x28,0x0e,0xce,0x42,0xb8,0x1c,0x47,0x31,0x73,0xec,0x37,0xad,0xe4,0xb9,0x46,0xfa,0x35,0x36,0x7b,0xae,0xd0,0x62,0x5e,0x93,0x33,0xe1,0xdf,0xec,0x7a,0x9f}, 0},
+    {{0xdb,0xfe,0x28,0x0e,0xce,0x42,0xb8,0x1c,0x47,0x31,0x73,0xec,0x37,0xad,0xe4,0xb9,0x46,0xfa,0x35,0x36,0x7b,0xae,0xd0,0x62,0x5e,0x93,0x33,0xe1,0xdf,0xec,0x7a,0x9f}, 1},
+    {{0xdc,0x20,0x58,0x28,0x84,0x81,0xf9,0x06,0xdb,0x71,0xfd,0xd7,0x3c,0x26,0x20,0x22,0x88,0x2b,0x81,0x8d,0xe6,0xcc,0xf6,0x3a,0x9d,0x27,0xce,0xca,0x13,0x99,0x0a,0xbf}, 0},
+    {{0xdc,0x33,0x68,0x38,0x72,0x99,0xbc,0x90,0xfc,0x7f,0xdb,0x70,0xec,0x4f,0x4a,0xff,0xd4,0xd4,0x49,0x4e,0xbd,0xf3,0x06,0xfa,0x84,0xa0,0xd0,0xf4,0xee,0x1c,0x73,0x9a}, 0},
+    {{0xdc,0x33,0x68,0x38,0x72,0x99,0xbc,0x90,0xfc,0x7f,0xdb,0x70,0xec,0x4f,0x4a,0xff,0xd4,0xd4,0x49,0x4e,0xbd,0xf3,0x06,0xfa,0x84,0xa0,0xd0,0xf4,0xee,0x1c,0x73,0x9a}, 1},
+    {{0xdc,0x35,0x9c,0x32,0x63,0x1c,0xa8,0x4a,0x0b,0x44,0xab,0xcb,0x52,0x45,0xe1,0xa5,0x06,0x41,0x62,0x87,0x41,0xc1,0x29,0xc0,0xaa,0x56,0x28,0x56,0xea,0x5a,0x17,0x06}, 0},
+    {{0xdc,0x35,0x9c,0x32,0x63,0x1c,0xa8,0x4a,0x0b,0x44,0xab,0xcb,0x52,0x45,0xe1,0xa5,0x06,0x41,0x62,0x87,0x41,0xc1,0x29,0xc0,0xaa,0x56,0x28,0x56,0xea,0x5a,0x17,0x06}, 1},
+    {{0xdc,0x80,0xd3,0x52,0x03,0x8b,0x58,0x00,0xf0,0x87,0x9e,0xac,0xb8,0xb6,0xb7,0x75,0x61,0x64,0x5c,0x04,0xaa,0x6a,0xbb,0x64,0x37,0x85,0x8f,0xbf,0x55,0x2e,0x0f,0x76}, 0},
+    {{0xdc,0xc0,0xa5,0xf5,0x4c,0x19,0x4e,0xaa,0xf8,0x05,0xde,0x12,0x05,0x2b,0x9a,0x1b,0xcc,0xcd,0xb0,0x81,0x21,0x83,0x87,0x1a,0x53,0x39,0x91,0x26,0x14,0xce,0xef,0xfa}, 0},
+    {{0xdc,0xc0,0xa5,0xf5,0x4c,0x19,0x4e,0xaa,0xf8,0x05,0xde,0x12,0x05,0x2b,0x9a,0x1b,0xcc,0xcd,0xb0,0x81,0x21,0x83,0x87,0x1a,0x53,0x39,0x91,0x26,0x14,0xce,0xef,0xfa}, 1},
+    {{0xdc,0xf3,0xf1,0xde,0xdd,0x5b,0x6e,0x24,0xba,0xcc,0xea,0x03,0x4d,0x6b,0xee,0x31,0x20,0xb9,0x69,0x91,0x0b,0x46,0xa5,0x9d,0x4b,0x6c,0x1f,0x48,0x83,0x19,0x2e,0x1b}, 0},
+    {{0xdd,0x40,0x1f,0xbe,0xdf,0x67,0xd7,0x88,0x21,0x7a,0x97,0x81,0xab,0x9b,0x35,0x61,0x84,0x31,0x91,0x65,0xcd,0x19,0xbd,0x1e,0xbc,0xfd,0xcc,0xce,0x7e,0x85,0x40,0x52}, 0},
+    {{0xdd,0x44,0xda,0x6b,0x61,0x2f,0x65,0xb4,0x0c,0x65,0x32,0x32,0x88,0x06,0x0e,0x44,0xe8,0xc3,0x45,0xb6,0x92,0x79,0x2d,0x6e,0x6e,0x5e,0x85,0xb0,0x5d,0xaa,0x8b,0xa8}, 0},
+    {{0xdd,0x4c,0x6c,0x06,0x46,0x15,0xa4,0xc1,0xeb,0x0f,0xfa,0x96,0x46,0xe0,0x69,0x9f,0x0d,0x93,0xcc,0x90,0xd4,0xa3,0xe3,0x85,0x26,0x86,0xd3,0x4d,0x8d,0x5c,0xe5,0x2c}, 0},
+    {{0xdd,0xaf,0xf2,0x91,0x65,0x89,0x47,0x59,0xbc,0x36,0x92,0xf7,0xdd,0x04,0x08,0x20,0x3a,0x62,0x8a,0x44,0x07,0xec,0x62,0x4f,0xbd,0x4b,0x4c,0xe4,0xe4,0x00,0x72,0xf8}, 0},
+    {{0xdd,0xaf,0xf2,0x91,0x65,0x89,0x47,0x59,0xbc,0x36,0x92,0xf7,0xdd,0x04,0x08,0x20,0x3a,0x62,0x8a,0x44,0x07,0xec,0x62,0x4f,0xbd,0x4b,0x4c,0xe4,0xe4,0x00,0x72,0xf8}, 1},
+    {{0xdd,0xcb,0x51,0x3f,0xf4,0x80,0x3a,0x7d,0xc7,0x61,0x65,0x4e,0x59,0xe3,0xdb,0x0a,0x7e,0x5b,0xf8,0x22,0x69,0x34,0x07,0x58,0xab,0xf3,0x5a,0x3c,0x5a,0xec,0xf0,0xcc}, 0},
+    {{0xdd,0xcb,0x51,0x3f,0xf4,0x80,0x3a,0x7d,0xc7,0x61,0x65,0x4e,0x59,0xe3,0xdb,0x0a,0x7e,0x5b,0xf8,0x22,0x69,0x34,0x07,0x58,0xab,0xf3,0x5a,0x3c,0x5a,0xec,0xf0,0xcc}, 1},
+    {{0xdd,0xe8,0x92,0xe8,0xb1,0x36,0x24,0x2e,0x7f,0x31,0x0f,0xaf,0x5d,0xeb,0x79,0x51,0x0a,0x1e,0x0f,0xa9,0xb0,0xb0,0x99,0x7c,0xe8,0xc6,0xb4,0x77,0x1e,0x34,0xc3,0x4d}, 0},
+    {{0xdd,0xe8,0x92,0xe8,0xb1,0x36,0x24,0x2e,0x7f,0x31,0x0f,0xaf,0x5d,0xeb,0x79,0x51,0x0a,0x1e,0x0f,0xa9,0xb0,0xb0,0x99,0x7c,0xe8,0xc6,0xb4,0x77,0x1e,0x34,0xc3,0x4d}, 1},
+    {{0xdd,0xf5,0xb1,0x4c,0xc0,0x5d,0xd8,0xc6,0xbe,0x67,0x16,0x1c,0xe7,0xc9,0x33,0xd1,0xc7,0x99,0x0c,0xb6,0x45,0xd4,0x76,0x47,0x59,0xe7,0x82,0x39,0x72,0xc7,0x6d,0x7b}, 0},
+    {{0xdd,0xf5,0xb1,0x4c,0xc0,0x5d,0xd8,0xc6,0xbe,0x67,0x16,0x1c,0xe7,0xc9,0x33,0xd1,0xc7,0x99,0x0c,0xb6,0x45,0xd4,0x76,0x47,0x59,0xe7,0x82,0x39,0x72,0xc7,0x6d,0x7b}, 1},
+    {{0xde,0x64,0x94,0x0b,0x58,0xef,0x18,0xc1,0x93,0x9d,0xdc,0xfd,0x83,0x0e,0x9a,0xd1,0xce,0x97,0xd6,0x95,0x92,0x6e,0x7a,0xf9,0xe8,0x5e,0xe5,0xd0,0xcf,0x9c,0x66,0x09}, 0},
+    {{0xde,0x64,0x94,0x0b,0x58,0xef,0x18,0xc1,0x93,0x9d,0xdc,0xfd,0x83,0x0e,0x9a,0xd1,0xce,0x97,0xd6,0x95,0x92,0x6e,0x7a,0xf9,0xe8,0x5e,0xe5,0xd0,0xcf,0x9c,0x66,0x09}, 1},
+    {{0xde,0x67,0x6e,0xfd,0x0d,0x5c,0xbf,0xd7,0x52,0xe5,0x1f,0x03,0x38,0xe3,0xf8,0xeb,0x2f,0x9f,0xf1,0x6b,0xdc,0xde,0x27,0xbe,0xb6,0xc7,0x4e,0xcc,0xd8,0x5a,0x40,0x00}, 0},
+    {{0xde,0x8d,0xa7,0x30,0x9a,0xea,0x00,0x32,0x53,0xad,0x51,0xda,0x4b,0x7f,0xb0,0xa6,0xa6,0xa6,0x13,0xdd,0x3b,0x4e,0x20,0x3c,0xe2,0x83,0x4e,0x09,0x95,0x02,0x0e,0x13}, 0},
+    {{0xde,0xa4,0x48,0x71,0x20,0x43,0x84,0x34,0x4c,0x5f,0x53,0x70,0xd0,0x06,0x34,0xcc,0xc2,0x3c,0xf7,0x7a,0xae,0x96,0xcb,0x48,0x3a,0xb3,0x82,0x3d,0x3e,0x40,0xd6,0x9a}, 0},
+    {{0xde,0xa4,0x48,0x71,0x20,0x43,0x84,0x34,0x4c,0x5f,0x53,0x70,0xd0,0x06,0x34,0xcc,0xc2,0x3c,0xf7,0x7a,0xae,0x96,0xcb,0x48,0x3a,0xb3,0x82,0x3d,0x3e,0x40,0xd6,0x9a}, 1},
+    {{0xde,0xd6,0xf2,0x31,0x39,0x5f,0x02,0xe8,0x64,0xbd,0x53,0x06,0xbf,0x3d,0x14,0x6b,0xff,0xe6,0x8e,0xf4,0xf0,0x56,0xc4,0x84,0xe7,0x06,0xeb,0xd3,0x53,0xd3,0x81,0x99}, 0},
+    {{0xde,0xe1,0x6e,0x0b,0xa9,0x51,0x9e,0xc6,0x9e,0x4d,0xf3,0x4b,0xa6,0x9b,0xfe,0xf6,0xe7,0x36,0xb8,0x66,0xf9,0xe2,0x28,0x08,0x19,0x26,0x7f,0x0f,0x42,0x54,0x49,0xb3}, 0},
+    {{0xde,0xf9,0xb1,0x35,0xd1,0xfe,0x89,0x95,0x8c,0xd3,0xf6,0x8f,0x82,0xd3,0x44,0x76,0x4c,0x6c,0xa2,0x24,0x8f,0x4c,0x49,0xa9,0x71,0x2b,0xd7,0xa8,0xe3,0x00,0x64,0x3b}, 0},
+    {{0xdf,0x23,0x98,0x14,0x51,0x5f,0xb1,0xda,0xee,0x0c,0x92,0x2e,0x44,0x99,0x91,0x55,0x7d,0x68,0x08,0xc2,0xf5,0xfd,0x52,0x4b,0x5e,0x62,0x7a,0xe3,0xa1,0x0a,0x15,0x77}, 0},
+    {{0xdf,0x2f,0xf6,0xe7,0xe2,0xe4,0x3e,0x3f,0x42,0xcf,0x44,0x7d,0x44,0x02,0x87,0x08,0x60,0x6d,0x0e,0xe5,0x99,0x18,0xaf,0xe2,0x11,0xda,0xcf,0x22,0x17,0x4c,0x2f,0xac}, 0},
+    {{0xdf,0x4d,0xb2,0x13,0xd8,0xe7,0xbf,0x56,0x30,0x10,0x85,0xa0,0xca,0x64,0xb8,0x2e,0xc5,0xde,0xc2,0xe9,0x93,0xf7,0xc0,0x35,0x9d,0x2e,0xd3,0x32,0x0f,0x12,0x08,0x0d}, 0},
+    {{0xdf,0x4d,0xb2,0x13,0xd8,0xe7,0xbf,0x56,0x30,0x10,0x85,0xa0,0xca,0x64,0xb8,0x2e,0xc5,0xde,0xc2,0xe9,0x93,0xf7,0xc0,0x35,0x9d,0x2e,0xd3,0x32,0x0f,0x12,0x08,0x0d}, 1},
+    {{0xdf,0x84,0xdd,0xf4,0x88,0x7b,0x0f,0xeb,0x17,0xf8,0xc1,0x80,0xfc,0x7a,0xc1,0x85,0xb3,0x60,0xbe,0xa0,0x12,0x29,0xa0,0x15,0x66,0xf4,0x25,0x8f,0x59,0xa2,0x0e,0x89}, 0},
+    {{0xe0,0x3c,0x4e,0xd3,0x2d,0xce,0x7a,0xfd,0x55,0x2d,0xe4,0x5f,0xee,0xa6,0xeb,0xb2,0xc0,0x92,0x1e,0xaf,0x6b,0x47,0xab,0xca,0xc5,0x32,0x06,0xcd,0x69,0xc6,0xe8,0xb9}, 0},
+    {{0xe0,0x49,0xed,0xf5,0xc6,0x46,0x1c,0x3b,0xc5,0x2a,0x89,0x63,0x71,0x59,0x57,0x08,0xed,0xab,0x7b,0x16,0x8e,0xc8,0x04,0x1a,0xe4,0x57,0x59,0xcc,0x90,0x28,0xf4,0x0b}, 0},
+    {{0xe0,0x49,0xed,0xf5,0xc6,0x46,0x1c,0x3b,0xc5,0x2a,0x89,0x63,0x71,0x59,0x57,0x08,0xed,0xab,0x7b,0x16,0x8e,0xc8,0x04,0x1a,0xe4,0x57,0x59,0xcc,0x90,0x28,0xf4,0x0b}, 1},
+    {{0xe0,0x63,0x94,0x05,0xf2,0xc7,0x5a,0xea,0x0b,0x61,0x47,0xb6,0x4b,0x5a,0x0b,0xb7,0x23,0x69,0xa7,0xbe,0xa6,0x50,0x54,0x79,0xdd,0x6d,0xc2,0xc8,0xa6,0xe2,0xbd,0x62}, 1},
+    {{0xe0,0x63,0x94,0x05,0xf2,0xc7,0x5a,0xea,0x0b,0x61,0x47,0xb6,0x4b,0x5a,0x0b,0xb7,0x23,0x69,0xa7,0xbe,0xa6,0x50,0x54,0x79,0xdd,0x6d,0xc2,0xc8,0xa6,0xe2,0xbd,0x62}, 2},
+    {{0xe0,0x84,0x3b,0x0c,0x00,0xa4,0x7a,0x7b,0x5e,0x30,0x25,0x10,0x7f,0x21,0x84,0x1a,0x79,0xb5,0xdf,0xb4,0x45,0xda,0xa8,0xfb,0x82,0xcb,0xca,0x2b,0x16,0x62,0x2f,0x93}, 0},
+    {{0xe0,0x84,0x3b,0x0c,0x00,0xa4,0x7a,0x7b,0x5e,0x30,0x25,0x10,0x7f,0x21,0x84,0x1a,0x79,0xb5,0xdf,0xb4,0x45,0xda,0xa8,0xfb,0x82,0xcb,0xca,0x2b,0x16,0x62,0x2f,0x93}, 1},
+    {{0xe0,0xa4,0x79,0x7e,0xb6,0x5f,0x7d,0x11,0xd9,0x6f,0x07,0x77,0xe6,0x86,0xdd,0xce,0xf9,0xd4,0x47,0x98,0x79,0x8e,0x34,0x6d,0x62,0x85,0x75,0x31,0xb6,0x76,0x6e,0xb0}, 0},
+    {{0xe0,0xa6,0x48,0x8e,0x2c,0xa2,0x28,0x86,0x44,0x91,0xdd,0xad,0xd2,0x54,0x3a,0x77,0x71,0xcd,0xdf,0xc7,0x00,0x13,0x7e,0xef,0x2d,0x8a,0xd0,0x13,0x04,0xec,0xb6,0xd0}, 0},
+    {{0xe0,0xa6,0x48,0x8e,0x2c,0xa2,0x28,0x86,0x44,0x91,0xdd,0xad,0xd2,0x54,0x3a,0x77,0x71,0xcd,0xdf,0xc7,0x00,0x13,0x7e,0xef,0x2d,0x8a,0xd0,0x13,0x04,0xec,0xb6,0xd0}, 1},
+    {{0xe1,0x3f,0x0d,0x14,0x06,0x91,0x86,0x0a,0x5a,0x2b,0xce,0x29,0xdf,0xb9,0x2e,0x5b,0x3a,0xe0,0x68,0x8b,0x18,0x41,0xdc,0xed,0xad,0x9d,0x32,0x61,0x6d,0x63,0x4f,0x68}, 0},
+    {{0xe1,0x3f,0x0d,0x14,0x06,0x91,0x86,0x0a,0x5a,0x2b,0xce,0x29,0xdf,0xb9,0x2e,0x5b,0x3a,0xe0,0x68,0x8b,0x18,0x41,0xdc,0xed,0xad,0x9d,0x32,0x61,0x6d,0x63,0x4f,0x68}, 1},
+    {{0xe1,0xeb,0x3e,0xdd,0x3d,0x53,0xaf,0x03,0x5c,0x0b,0xba,0x12,0xb5,0xfe,0xaf,0x9d,0x18,0xde,0x2c,0xd7,0xa6,0xd0,0x73,0x9a,0x93,0xd8,0xf4,0x60,0x95,0x5b,0x6e,0xb5}, 0},
+    {{0xe2,0x7a,0xe1,0xdb,0x01,0x9e,0x2a,0xe2,0x83,0x40,0xff,0xd8,0x05,0x1b,0x15,0x0a,0xac,0x77,0x98,0xbf,0x3d,0x96,0x43,0x25,0xf3,0x9e,0x2c,0x77,0x3f,0xb5,0x2b,0x81}, 0},
+    {{0xe2,0x7a,0xe1,0xdb,0x01,0x9e,0x2a,0xe2,0x83,0x40,0xff,0xd8,0x05,0x1b,0x15,0x0a,0xac,0x77,0x98,0xbf,0x3d,0x96,0x43,0x25,0xf3,0x9e,0x2c,0x77,0x3f,0xb5,0x2b,0x81}, 1},
+    {{0xe2,0xc1,0x52,0xe8,0x26,0x02,0xb6,0xeb,0x7a,0x01,0xee,0x5e,0xe5,0xe4,0x13,0xe4,0xec,0xbd,0x7d,0xf1,0xfd,0x36,0x5f,0x41,0x64,0x0a,0x39,0xcc,0xcf,0x58,0x21,0xe9}, 0},
+    {{0xe2,0xc1,0x52,0xe8,0x26,0x02,0xb6,0xeb,0x7a,0x01,0xee,0x5e,0xe5,0xe4,0x13,0xe4,0xec,0xbd,0x7d,0xf1,0xfd,0x36,0x5f,0x41,0x64,0x0a,0x39,0xcc,0xcf,0x58,0x21,0xe9}, 1},
+    {{0xe2,0xec,0x32,0x61,0x81,0x82,0x8a,0x0b,0xf1,0x09,0xde,0x75,0x03,0x66,0x2c,0x04,0x92,0x30,0xb4,0x9d,0xc2,0xdd,0xe5,0x77,0xc5,0x80,0xd4,0x9c,0x56,0xb0,0x8d,0xf1}, 0},
+    {{0xe3,0x17,0x3d,0xed,0xca,0x51,0x8f,0x7e,0xd9,0x03,0xa5,0xd3,0xa1,0x08,0xfc,0x9f,0x3b,0xfc,0x14,0xd7,0x5d,0xa5,0x13,0xc6,0x2e,0xc1,0x49,0x91,0xa2,0x48,0x2f,0x67}, 0},
+    {{0xe3,0x17,0x3d,0xed,0xca,0x51,0x8f,0x7e,0xd9,0x03,0xa5,0xd3,0xa1,0x08,0xfc,0x9f,0x3b,0xfc,0x14,0xd7,0x5d,0xa5,0x13,0xc6,0x2e,0xc1,0x49,0x91,0xa2,0x48,0x2f,0x67}, 1},
+    {{0xe3,0x60,0xea,0xf9,0x08,0xcd,0x2c,0xfd,0x77,0xb3,0x39,0xe9,0x97,0xfd,0x4e,0x52,0x70,0x79,0xde,0xc2,0x0f,0x2f,0x25,0xff,0x89,0x46,0x3d,0x7d,0x7a,0x5b,0x34,0x82}, 0},
+    {{0xe3,0x60,0xea,0xf9,0x08,0xcd,0x2c,0xfd,0x77,0xb3,0x39,0xe9,0x97,0xfd,0x4e,0x52,0x70,0x79,0xde,0xc2,0x0f,0x2f,0x25,0xff,0x89,0x46,0x3d,0x7d,0x7a,0x5b,0x34,0x82}, 1},
+    {{0xe3,0x65,0xc1,0x2a,0x6f,0x10,0x57,0x4e,0x5b,0xd6,0x04,0x86,0x79,0x78,0x1c,0xcb,0xeb,0xea,0xc4,0x11,0xa0,0xcd,0x7e,0xa8,0xe0,0x9e,0xd8,0x4f,0xd3,0xf6,0xf9,0x6a}, 0},
+    {{0xe3,0x65,0xc1,0x2a,0x6f,0x10,0x57,0x4e,0x5b,0xd6,0x04,0x86,0x79,0x78,0x1c,0xcb,0xeb,0xea,0xc4,0x11,0xa0,0xcd,0x7e,0xa8,0xe0,0x9e,0xd8,0x4f,0xd3,0xf6,0xf9,0x6a}, 1},
+    {{0xe3,0x9a,0x37,0x93,0x92,0x2b,0x48,0xba,0x41,0x23,0xc0,0x98,0x7a,0xf8,0xbb,0xa0,0x25,0xcd,0x7e,0xac,0x74,0x47,0x9b,0xcb,0x48,0xae,0xd7,0x18,0x4b,0xc8,0x37,0x6b}, 0},
+    {{0xe3,0xdf,0x0f,0x2e,0x71,0xfb,0x73,0xd3,0x9c,0xdb,0x01,0x7c,0x3d,0xfe,0xbb,0xe0,0x40,0x20,0x91,0xcf,0x49,0x40,0x25,0x45,0xe5,0x58,0x06,0x78,0x30,0xc0,0x43,0xb7}, 0},
+    {{0xe4,0x6d,0x69,0xeb,0x7f,0xda,0xbf,0x98,0x3d,0x93,0x2d,0x12,0x81,0x9f,0xbc,0xcc,0xb8,0x59,0x9b,0xdb,0x55,0xd2,0xff,0xa3,0xb2,0xf5,0x1a,0x22,0xb1,0x06,0x70,0xb0}, 0},
+    {{0xe5,0x5e,0x66,0x4c,0x0a,0xee,0xcf,0xfc,0xc9,0xd5,0x49,0x1e,0xbd,0x65,0x4a,0x25,0xdf,0xa1,0x21,0x23,0x45,0x27,0xfa,0x6b,0x62,0x85,0x25,0x66,0x08,0x55,0xe5,0x84}, 0},
+    {{0xe5,0x5e,0x66,0x4c,0x0a,0xee,0xcf,0xfc,0xc9,0xd5,0x49,0x1e,0xbd,0x65,0x4a,0x25,0xdf,0xa1,0x21,0x23,0x45,0x27,0xfa,0x6b,0x62,0x85,0x25,0x66,0x08,0x55,0xe5,0x84}, 1},
+    {{0xe5,0x7d,0x62,0x94,0xa8,0x42,0xa8,0xa0,0xfb,0xc4,0xe1,0xe9,0xdb,0x28,0x2d,0x6c,0x63,0x0a,0xaf,0xd5,0xa9,0x8b,0x31,0x9f,0x71,0xf4,0x5e,0xd9,0xd3,0x5c,0xe7,0x44}, 0},
+    {{0xe5,0x7d,0x62,0x94,0xa8,0x42,0xa8,0xa0,0xfb,0xc4,0xe1,0xe9,0xdb,0x28,0x2d,0x6c,0x63,0x0a,0xaf,0xd5,0xa9,0x8b,0x31,0x9f,0x71,0xf4,0x5e,0xd9,0xd3,0x5c,0xe7,0x44}, 1},
+    {{0xe5,0x84,0xe0,0x2a,0x96,0xaa,0x80,0x1c,0x30,0x6d,0xab,0xad,0x83,0xb2,0x19,0x4e,0x75,0xf0,0xcb,0xd5,0x06,0x1d,0x5c,0x54,0x60,0x08,0x6b,0x4b,0xab,0xc7,0x3f,0xc8}, 0},
+    {{0xe5,0xd2,0x5f,0x2f,0x14,0x8a,0xc0,0x41,0x3c,0x17,0x85,0x31,0x1a,0xa7,0x7b,0x55,0x15,0xf4,0x56,0x26,0xeb,0xe0,0x66,0x17,0x18,0x70,0x4f,0x82,0x19,0x7d,0xab,0x9a}, 0},
+    {{0xe5,0xf7,0x6b,0x55,0x8c,0xb6,0x52,0x05,0xc5,0xc7,0x68,0xf3,0xa7,0xfe,0xa5,0xcc,0x94,0xb7,0xc7,0x7e,0x9a,0x7a,0x96,0x40,0x68,0xfa,0x23,0xc5,0x2f,0x13,0x9f,0x46}, 0},
+    {{0xe5,0xf7,0x6b,0x55,0x8c,0xb6,0x52,0x05,0xc5,0xc7,0x68,0xf3,0xa7,0xfe,0xa5,0xcc,0x94,0xb7,0xc7,0x7e,0x9a,0x7a,0x96,0x40,0x68,0xfa,0x23,0xc5,0x2f,0x13,0x9f,0x46}, 1},
+    {{0xe6,0x03,0x05,0x67,0xc4,0x57,0x99,0x70,0x40,0xc1,0xdf,0xbb,0x8c,0x16,0x8c,0x27,0x44,0x28,0x74,0xf8,0x50,0xf9,0xdc,0x07,0x3f,0x64,0x01,0x74,0x1f,0x39,0x6d,0xc2}, 0},
+    {{0xe6,0x03,0x05,0x67,0xc4,0x57,0x99,0x70,0x40,0xc1,0xdf,0xbb,0x8c,0x16,0x8c,0x27,0x44,0x28,0x74,0xf8,0x50,0xf9,0xdc,0x07,0x3f,0x64,0x01,0x74,0x1f,0x39,0x6d,0xc2}, 1},
+    {{0xe6,0x87,0xe6,0x2a,0xd0,0x67,0x15,0x61,0x64,0xf3,0xbf,0xba,0x61,0xfd,0x38,0x6d,0x1d,0xec,0xf2,0xe5,0xb0,0x5a,0xf8,0x7a,0x79,0x87,0x86,0x73,0xa2,0xff,0x34,0x30}, 0},
+    {{0xe6,0x87,0xe6,0x2a,0xd0,0x67,0x15,0x61,0x64,0xf3,0xbf,0xba,0x61,0xfd,0x38,0x6d,0x1d,0xec,0xf2,0xe5,0xb0,0x5a,0xf8,0x7a,0x79,0x87,0x86,0x73,0xa2,0xff,0x34,0x30}, 1},
+    {{0xe7,0x69,0xdf,0x89,0x61,0xad,0xc6,0xc9,0x31,0xa4,0xb7,0x99,0x75,0x55,0x08,0xa0,0x98,0x99,0xef,0xfd,0xbb,0x57,0x23,0x76,0xfa,0x89,0x41,0x08,0x4a,0x8e,0x09,0xcb}, 0},
+    {{0xe7,0x86,0x35,0x74,0x97,0xc9,0xf8,0xb8,0x54,0xfd,0x72,0x0c,0x02,0x96,0x48,0x2e,0xa0,0x3f,0x44,0x82,0x62,0xf5,0xc3,0x5f,0x92,0xb6,0x0f,0x03,0xeb,0xa0,0x21,0x7d}, 0},
+    {{0xe7,0x86,0x7d,0x7c,0xb2,0xbe,0xb4,0x6f,0x2c,0x8f,0x99,0x75,0xea,0x46,0xe7,0x21,0xad,0x92,0x65,0x5d,0xce,0x9a,0xfc,0x2f,0x7b,0x7e,0x78,0x86,0x45,0x31,0xcb,0xb2}, 0},
+    {{0xe7,0x86,0x7d,0x7c,0xb2,0xbe,0xb4,0x6f,0x2c,0x8f,0x99,0x75,0xea,0x46,0xe7,0x21,0xad,0x92,0x65,0x5d,0xce,0x9a,0xfc,0x2f,0x7b,0x7e,0x78,0x86,0x45,0x31,0xcb,0xb2}, 1},
+    {{0xe7,0xce,0x6a,0xac,0x81,0xd9,0x3d,0xe9,0x73,0x0a,0x82,0x23,0x8f,0x9a,0x75,0x95,0x3d,0x8b,0x52,0xc3,0x25,0xed,0xa6,0xb9,0xd9,0xfd,0x0b,0x0b,0x9a,0xbb,0x7c,0xf0}, 0},
+    {{0xe7,0xce,0x6a,0xac,0x81,0xd9,0x3d,0xe9,0x73,0x0a,0x82,0x23,0x8f,0x9a,0x75,0x95,0x3d,0x8b,0x52,0xc3,0x25,0xed,0xa6,0xb9,0xd9,0xfd,0x0b,0x0b,0x9a,0xbb,0x7c,0xf0}, 1},
+    {{0xe7,0xd4,0x25,0x90,0xb9,0x09,0xd2,0xbf,0x22,0x20,0xf4,0xd2,0x12,0x37,0x2e,0x56,0x7a,0x9f,0x02,0xc1,0xc2,0x7f,0x88,0xf1,0xda,0x4d,0x86,0x0b,0xf0,0xc2,0xc8,0x32}, 0},
+    {{0xe7,0xd4,0x25,0x90,0xb9,0x09,0xd2,0xbf,0x22,0x20,0xf4,0xd2,0x12,0x37,0x2e,0x56,0x7a,0x9f,0x02,0xc1,0xc2,0x7f,0x88,0xf1,0xda,0x4d,0x86,0x0b,0xf0,0xc2,0xc8,0x32}, 1},
+    {{0xe8,0x29,0xe4,0x27,0x26,0xd6,0x14,0x53,0xc7,0x3a,0xc4,0xf2,0xeb,0xd6,0x1a,0x4d,0xa2,0x25,0xa6,0xe3,0xe3,0xff,0xe6,0xb3,0xd8,0xda,0xf5,0x6a,0x73,0x1d,0xa2,0xd4}, 0},
+    {{0xe8,0x29,0xe4,0x27,0x26,0xd6,0x14,0x53,0xc7,0x3a,0xc4,0xf2,0xeb,0xd6,0x1a,0x4d,0xa2,0x25,0xa6,0xe3,0xe3,0xff,0xe6,0xb3,0xd8,0xda,0xf5,0x6a,0x73,0x1d,0xa2,0xd4}, 1},
+    {{0xe8,0x72,0x12,0x3f,0xfe,0xde,0x0b,0x34,0xb3,0xbf,0x0f,0xa8,0x82,0x89,0xfc,0xe7,0xeb,0xe3,0x8e,0x15,0xa3,0xbb,0x17,0xe4,0x93,0x24,0x6f,0xb0,0xc4,0x84,0x9e,0x7b}, 0},
+    {{0xe8,0x72,0x12,0x3f,0xfe,0xde,0x0b,0x34,0xb3,0xbf,0x0f,0xa8,0x82,0x89,0xfc,0xe7,0xeb,0xe3,0x8e,0x15,0xa3,0xbb,0x17,0xe4,0x93,0x24,0x6f,0xb0,0xc4,0x84,0x9e,0x7b}, 1},
+    {{0xe8,0xb2,0x45,0x0e,0x86,0xda,0x3b,0x80,0xcd,0x32,0x12,0x30,0x1e,0xee,0xa5,0xe2,0x04,0x3e,0x06,0xc6,0xb1,0x68,0xeb,0x05,0x14,0xeb,0x73,0x46,0xcb,0xe0,0x3c,0xc7}, 0},
+    {{0xe8,0xde,0xde,0xf9,0x2a,0xfe,0xb6,0xa6,0xed,0xfd,0xa3,0xb7,0x5c,0x6a,0x2a,0xe8,0x4b,0xd5,0x4a,0x93,0x2b,0x92,0x0e,0xdd,0x2e,0x93,0x5f,0xa7,0x2c,0x76,0xf8,0x20}, 0},
+    {{0xe9,0x05,0x8a,0xd5,0x83,0x74,0x66,0x46,0xe0,0x73,0x1c,0xd5,0xe6,0x5f,0x11,0xf5,0x36,0xc4,0x35,0x0b,0xdb,0xc8,0xaa,0x2b,0x67,0x28,0x32,0xcf,0x82,0x45,0x68,0x2c}, 0},
+    {{0xe9,0x05,0x8a,0xd5,0x83,0x74,0x66,0x46,0xe0,0x73,0x1c,0xd5,0xe6,0x5f,0x11,0xf5,0x36,0xc4,0x35,0x0b,0xdb,0xc8,0xaa,0x2b,0x67,0x28,0x32,0xcf,0x82,0x45,0x68,0x2c}, 1},
+    {{0xe9,0x12,0xb0,0xe4,0xc0,0x40,0xbf,0x20,0x59,0xa6,0x81,0x37,0x2e,0xfc,0x43,0x2b,0x97,0xb8,0x4b,0xf1,0x7d,0x3f,0x10,0x02,0x11,0x0a,0x38,0x0b,0xc6,0x4c,0xe7,0x01}, 0},
+    {{0xe9,0x12,0xb0,0xe4,0xc0,0x40,0xbf,0x20,0x59,0xa6,0x81,0x37,0x2e,0xfc,0x43,0x2b,0x97,0xb8,0x4b,0xf1,0x7d,0x3f,0x10,0x02,0x11,0x0a,0x38,0x0b,0xc6,0x4c,0xe7,0x01}, 1},
+    {{0xe9,0x27,0xec,0x4b,0xdd,0x89,0x28,0x17,0xec,0x03,0x15,0x79,0x42,0x54,0x34,0x08,0x6c,0xfc,0x2f,0xd1,0xe3,0xcf,0xfc,0x33,0x5c,0x92,0xe1,0x9c,0x52,0x6a,0xc7,0xbf}, 0},
+    {{0xe9,0x27,0xec,0x4b,0xdd,0x89,0x28,0x17,0xec,0x03,0x15,0x79,0x42,0x54,0x34,0x08,0x6c,0xfc,0x2f,0xd1,0xe3,0xcf,0xfc,0x33,0x5c,0x92,0xe1,0x9c,0x52,0x6a,0xc7,0xbf}, 1},
+    {{0xe9,0x70,0x9a,0x86,0xd1,0x4d,0xe6,0x5c,0x2d,0x88,0x50,0x6b,0x81,0x93,0xd7,0x55,0x2b,0x48,0x0d,0xd0,0xd3,0xa9,0x80,0xb5,0x8e,0x59,0xbd,0x6e,0xe8,0x61,0x03,0x04}, 0},
+    {{0xe9,0x70,0x9a,0x86,0xd1,0x4d,0xe6,0x5c,0x2d,0x88,0x50,0x6b,0x81,0x93,0xd7,0x55,0x2b,0x48,0x0d,0xd0,0xd3,0xa9,0x80,0xb5,0x8e,0x59,0xbd,0x6e,0xe8,0x61,0x03,0x04}, 1},
+    {{0xe9,0x80,0xc3,0xb2,0x2d,0x8a,0xc2,0x1b,0x62,0x00,0x8c,0xdf,0xbf,0x5a,0xd7,0x26,0x10,0xc0,0xdf,0xf3,0xb1,0x56,0x68,0xc3,0x60,0x27,0xa9,0x6b,0x2f,0xac,0xe0,0x1a}, 0},
+    {{0xe9,0x80,0xc3,0xb2,0x2d,0x8a,0xc2,0x1b,0x62,0x00,0x8c,0xdf,0xbf,0x5a,0xd7,0x26,0x10,0xc0,0xdf,0xf3,0xb1,0x56,0x68,0xc3,0x60,0x27,0xa9,0x6b,0x2f,0xac,0xe0,0x1a}, 1},
+    {{0xe9,0xb7,0xf8,0x13,0x57,0x14,0x20,0x73,0xd3,0x88,0x05,0xcd,0x67,0xdb,0xb4,0xa0,0x65,0x12,0xc6,0x1e,0x02,0xe7,0x55,0x72,0x2f,0x10,0xb3,0x2b,0xa0,0xbc,0xe7,0x8a}, 0},
+    {{0xe9,0xc4,0xec,0xf6,0xbd,0x0f,0x94,0x84,0x72,0xea,0xaa,0xa3,0xd8,0xb9,0x9b,0xb2,0x95,0x1d,0x34,0x49,0xed,0x22,0x95,0xca,0x3c,0x8a,0xc3,0x54,0x1e,0x75,0xb4,0x3b}, 1},
+    {{0xe9,0xc4,0xec,0xf6,0xbd,0x0f,0x94,0x84,0x72,0xea,0xaa,0xa3,0xd8,0xb9,0x9b,0xb2,0x95,0x1d,0x34,0x49,0xed,0x22,0x95,0xca,0x3c,0x8a,0xc3,0x54,0x1e,0x75,0xb4,0x3b}, 2},
+    {{0xe9,0xda,0x6c,0x7c,0x84,0x02,0x09,0x7d,0x20,0x08,0x69,0x70,0x2c,0xe7,0x09,0x75,0x20,0x41,0x11,0xbe,0x82,0xd2,0x5a,0x19,0xd8,0xdd,0xd8,0x0a,0x40,0x87,0xaa,0x96}, 0},
+    {{0xea,0xeb,0xa9,0x30,0x77,0x54,0x99,0x2a,0x48,0x62,0xef,0x29,0x88,0xd9,0x6e,0x1a,0xca,0x39,0xc2,0xa6,0x4c,0xf8,0x69,0x63,0x14,0x88,0xfc,0xd0,0x75,0xf1,0xb2,0x91}, 0},
+    {{0xeb,0x44,0x05,0x8c,0xbb,0xec,0xb3,0x06,0x95,0x46,0x22,0x9e,0xf6,0xc2,0xfe,0xdf,0x20,0x7a,0x45,0x4a,0x3d,0xe1,0x0f,0x6a,0xdb,0x6f,0x09,0xc6,0x8a,0x9f,0x06,0xea}, 0},
+    {{0xeb,0x44,0x05,0x8c,0xbb,0xec,0xb3,0x06,0x95,0x46,0x22,0x9e,0xf6,0xc2,0xfe,0xdf,0x20,0x7a,0x45,0x4a,0x3d,0xe1,0x0f,0x6a,0xdb,0x6f,0x09,0xc6,0x8a,0x9f,0x06,0xea}, 1},
+    {{0xeb,0x4c,0xde,0x7a,0x38,0xa2,0x75,0x57,0x70,0x3e,0x92,0xdc,0x07,0xa7,0x51,0xa3,0xb3,0x56,0x21,0xc1,0x7e,0x23,0xb2,0xb9,0xc2,0xf9,0xb8,0xde,0x2f,0x50,0x19,0x4c}, 0},
+    {{0xeb,0xe9,0x72,0xf7,0x2f,0x86,0xa7,0x85,0x01,0xd2,0x87,0x1c,0xfc,0x26,0x03,0x9a,0x71,0x4e,0x3b,0x15,0x61,0xe6,0xff,0x50,0xc6,0xba,0xaf,0x40,0xc9,0x65,0xa7,0xe4}, 0},
+    {{0xeb,0xe9,0x72,0xf7,0x2f,0x86,0xa7,0x85,0x01,0xd2,0x87,0x1c,0xfc,0x26,0x03,0x9a,0x71,0x4e,0x3b,0x15,0x61,0xe6,0xff,0x50,0xc6,0xba,0xaf,0x40,0xc9,0x65,0xa7,0xe4}, 1},
+    {{0xec,0x15,0xb3,0x18,0x0d,0x8a,0x69,0xe6,0x0f,0xf0,0x42,0xad,0xd9,0x9c,0x39,0xe6,0x8b,0xf9,0xa6,0x37,0x77,0x0b,0xe3,0x81,0x4e,0x28,0x4e,0x1b,0xd6,0xe2,0x33,0x5a}, 0},
+    {{0xec,0x94,0x3c,0xbf,0xcd,0x8a,0xc5,0x1f,0x72,0x1c,0xc6,0x7f,0xfc,0xbb,0xff,0x70,0x37,0x75,0x59,0x9f,0x1c,0x3f,0x2f,0x35,0xb1,0xfc,0x3b,0xb3,0x91,0x01,0xbd,0xdb}, 0},
+    {{0xec,0xf7,0x19,0x06,0x2a,0x4e,0x61,0xa6,0x8a,0x75,0x79,0x92,0xa9,0x48,0x4d,0x7b,0x3e,0x53,0x27,0x6e,0xa7,0x04,0x4f,0x45,0xdf,0xc7,0xf4,0xe8,0x36,0xb3,0x4a,0xe0}, 0},
+    {{0xed,0x82,0xb6,0x1c,0x7a,0xe2,0xb1,0x97,0xfc,0xbc,0x4f,0x94,0xdd,0xdc,0xe8,0x98,0x66,0x80,0x5e,0xcc,0xa8,0x85,0xb4,0x40,0x0f,0xa7,0xe3,0x4d,0xdb,0x29,0x7a,0xc2}, 0},
+    {{0xed,0x82,0xb6,0x1c,0x7a,0xe2,0xb1,0x97,0xfc,0xbc,0x4f,0x94,0xdd,0xdc,0xe8,0x98,0x66,0x80,0x5e,0xcc,0xa8,0x85,0xb4,0x40,0x0f,0xa7,0xe3,0x4d,0xdb,0x29,0x7a,0xc2}, 1},
+    {{0xed,0xb0,0xd5,0x14,0x5b,0xb0,0xc0,0x4c,0x1f,0x3e,0xc7,0x0f,0x00,0x49,0x49,0xc1,0x2b,0x17,0xef,0xdc,0x68,0x26,0x45,0x23,0x1a,0x7c,0xf2,0x29,0xed,0x66,0x3b,0xa4}, 0},
+    {{0xed,0xb0,0xd5,0x14,0x5b,0xb0,0xc0,0x4c,0x1f,0x3e,0xc7,0x0f,0x00,0x49,0x49,0xc1,0x2b,0x17,0xef,0xdc,0x68,0x26,0x45,0x23,0x1a,0x7c,0xf2,0x29,0xed,0x66,0x3b,0xa4}, 1},
+    {{0xed,0xe3,0x56,0x52,0x84,0xe7,0x60,0x74,0x71,0x3c,0xc6,0x32,0xf2,0xed,0xb8,0x96,0xd8,0xbf,0xf1,0x29,0x4f,0x73,0xee,0x4b,0xc0,0x77,0xd6,0xea,0x1a,0xc6,0x3a,0x1c}, 0},
+    {{0xed,0xe3,0x56,0x52,0x84,0xe7,0x60,0x74,0x71,0x3c,0xc6,0x32,0xf2,0xed,0xb8,0x96,0xd8,0xbf,0xf1,0x29,0x4f,0x73,0xee,0x4b,0xc0,0x77,0xd6,0xea,0x1a,0xc6,0x3a,0x1c}, 1},
+    {{0xee,0x17,0x6a,0x16,0x79,0x25,0x62,0x0d,0x14,0x0f,0x22,0x40,0x60,0xf2,0xfe,0x5d,0x1a,0xfa,0x3e,0x8f,0x84,0xe6,0xe4,0xe3,0x39,0x8e,0x98,0x7c,0x99,0x6f,0x71,0xdd}, 0},
+    {{0xee,0x2d,0x8f,0x55,0xa6,0xcc,0xae,0xd7,0x52,0xf7,0x35,0x98,0xc8,0x75,0x13,0xe7,0x81,0x93,0x4d,0xaa,0xe8,0xed,0x47,0xeb,0xc5,0x8a,0xc5,0x22,0xb6,0x9f,0x61,0x1f}, 0},
+    {{0xee,0x2d,0x8f,0x55,0xa6,0xcc,0xae,0xd7,0x52,0xf7,0x35,0x98,0xc8,0x75,0x13,0xe7,0x81,0x93,0x4d,0xaa,0xe8,0xed,0x47,0xeb,0xc5,0x8a,0xc5,0x22,0xb6,0x9f,0x61,0x1f}, 1},
+    {{0xee,0x2f,0x87,0x55,0xea,0xf2,0x5d,0xbd,0xf5,0x2c,0x24,0x97,0x74,0xf4,0xa3,0xe1,0x4c,0x5b,0xab,0x5c,0x8d,0x33,0x7d,0xe5,0x16,0xb4,0xad,0xb2,0x28,0xc9,0x54,0x38}, 0},
+    {{0xee,0x2f,0x87,0x55,0xea,0xf2,0x5d,0xbd,0xf5,0x2c,0x24,0x97,0x74,0xf4,0xa3,0xe1,0x4c,0x5b,0xab,0x5c,0x8d,0x33,0x7d,0xe5,0x16,0xb4,0xad,0xb2,0x28,0xc9,0x54,0x38}, 1},
+    {{0xee,0x5e,0x69,0x49,0x60,0xea,0xe1,0x8d,0x99,0xf5,0x74,0x8f,0xf0,0xda,0x0b,0x6c,0xb2,0xd5,0x95,0x87,0x3a,0xc4,0xe2,0xa5,0xfb,0x0b,0xd6,0x99,0x76,0xca,0xf3,0x25}, 0},
+    {{0xee,0x5e,0x69,0x49,0x60,0xea,0xe1,0x8d,0x99,0xf5,0x74,0x8f,0xf0,0xda,0x0b,0x6c,0xb2,0xd5,0x95,0x87,0x3a,0xc4,0xe2,0xa5,0xfb,0x0b,0xd6,0x99,0x76,0xca,0xf3,0x25}, 1},
+    {{0xee,0xfb,0xfc,0x0d,0xc7,0x88,0xeb,0x6d,0x56,0xb1,0x52,0xfa,0x0d,0xac,0xee,0x9f,0xf7,0xa6,0x35,0xf3,0x24,0x21,0x3c,0x74,0xda,0xe0,0x90,0x84,0xe8,0x5c,0x4f,0xd5}, 0},
+    {{0xef,0x2c,0x02,0x14,0xff,0x66,0x17,0x42,0x59,0xd5,0xca,0xaa,0x1c,0xf5,0x04,0x1a,0xf7,0xff,0x99,0xd4,0x9b,0xe4,0x26,0xe2,0xbc,0x7b,0x21,0x09,0xbc,0x4f,0x3f,0x48}, 0},
+    {{0xef,0x3e,0x79,0x10,0x07,0x88,0x75,0xe7,0x2e,0x0c,0x49,0x38,0xcc,0x9e,0x68,0x4e,0xa7,0x8d,0xc5,0xf8,0xde,0x5d,0xf6,0x25,0x42,0xbb,0xfc,0xab,0xbd,0x79,0xc7,0x4d}, 1},
+    {{0xef,0x53,0x91,0x63,0xa9,0x83,0x98,0x97,0x38,0xb9,0x16,0xe2,0xaa,0x94,0x3d,0xd3,0xfe,0x58,0xef,0xf2,0xb5,0x02,0x94,0xd9,0x04,0x96,0x7a,0xd8,0xef,0x95,0x0d,0x1b}, 0},
+    {{0xef,0x53,0x91,0x63,0xa9,0x83,0x98,0x97,0x38,0xb9,0x16,0xe2,0xaa,0x94,0x3d,0xd3,0xfe,0x58,0xef,0xf2,0xb5,0x02,0x94,0xd9,0x04,0x96,0x7a,0xd8,0xef,0x95,0x0d,0x1b}, 1},
+    {{0xef,0x5c,0xb8,0xe8,0x5c,0x6c,0xd6,0x8b,0x9b,0x8a,0x93,0xbc,0x3d,0xc2,0xb6,0xdf,0x6e,0xf6,0x79,0xc5,0x68,0xe1,0x8a,0xe5,0xf4,0x75,0xb7,0xd6,0xed,0xf0,0x85,0x77}, 0},
+    {{0xef,0x5c,0xb8,0xe8,0x5c,0x6c,0xd6,0x8b,0x9b,0x8a,0x93,0xbc,0x3d,0xc2,0xb6,0xdf,0x6e,0xf6,0x79,0xc5,0x68,0xe1,0x8a,0xe5,0xf4,0x75,0xb7,0xd6,0xed,0xf0,0x85,0x77}, 1},
+    {{0xef,0x62,0x9e,0x9c,0x12,0x48,0x63,0xf6,0xc9,0x29,0x94,0xf6,0x72,0x98,0x5c,0xc7,0x21,0xd9,0x0b,0x72,0x15,0xca,0xc4,0xc0,0xd4,0x94,0xf3,0x65,0x5a,0x5f,0xcd,0x9e}, 0},
+    {{0xef,0x62,0x9e,0x9c,0x12,0x48,0x63,0xf6,0xc9,0x29,0x94,0xf6,0x72,0x98,0x5c,0xc7,0x21,0xd9,0x0b,0x72,0x15,0xca,0xc4,0xc0,0xd4,0x94,0xf3,0x65,0x5a,0x5f,0xcd,0x9e}, 1},
+    {{0xef,0xce,0x15,0x0f,0x9f,0x1b,0xad,0x8c,0xc4,0xd3,0x5d,0x8b,0xec,0xe3,0x40,0x59,0x95,0xe7,0x0d,0x2e,0x94,0x61,0xbd,0x22,0x6c,0xe8,0x85,0x5f,0xde,0xa7,0xb4,0xf9}, 0},
+    {{0xef,0xce,0x15,0x0f,0x9f,0x1b,0xad,0x8c,0xc4,0xd3,0x5d,0x8b,0xec,0xe3,0x40,0x59,0x95,0xe7,0x0d,0x2e,0x94,0x61,0xbd,0x22,0x6c,0xe8,0x85,0x5f,0xde,0xa7,0xb4,0xf9}, 1},
+    {{0xf0,0x0b,0x92,0x7c,0x4c,0x92,0x50,0x90,0x2b,0x43,0x5f,0x6f,0x6d,0xb4,0x16,0x51,0xbc,0x14,0xe2,0x5d,0xc9,0x69,0x30,0x27,0x02,0x1f,0x1b,0xac,0xec,0xe0,0xaa,0xed}, 0},
+    {{0xf0,0x0b,0x92,0x7c,0x4c,0x92,0x50,0x90,0x2b,0x43,0x5f,0x6f,0x6d,0xb4,0x16,0x51,0xbc,0x14,0xe2,0x5d,0xc9,0x69,0x30,0x27,0x02,0x1f,0x1b,0xac,0xec,0xe0,0xaa,0xed}, 1},
+    {{0xf1,0x58,0x21,0x3c,0x91,0x47,0xd8,0xa3,0xa2,0xe6,0x4d,0x69,0xf0,0xe5,0x3e,0x2c,0x31,0x36,0x1a,0xa7,0x89,0x94,0x20,0x06,0x36,0x79,0x8b,0xcc,0xcd,0x8c,0x15,0x86}, 0},
+    {{0xf1,0x8c,0x9c,0x69,0xe8,0x9a,0xdf,0x1b,0xd8,0x11,0x78,0xd1,0x05,0x18,0x7d,0xb3,0xb3,0x43,0xda,0x67,0x2d,0x1f,0x2e,0xbe,0x15,0x32,0x98,0xa9,0x0b,0xae,0x83,0x05}, 0},
+    {{0xf1,0x92,0x30,0xf1,0x01,0x1b,0xbf,0x5e,0x21,0xa3,0x3a,0xbb,0x66,0x65,0xcb,0xdc,0x76,0x2c,0xb9,0x17,0xaf,0x60,0x4c,0x07,0x5c,0x76,0x85,0xb0,0xc6,0xab,0xa3,0xc2}, 0},
+    {{0xf1,0x92,0x30,0xf1,0x01,0x1b,0xbf,0x5e,0x21,0xa3,0x3a,0xbb,0x66,0x65,0xcb,0xdc,0x76,0x2c,0xb9,0x17,0xaf,0x60,0x4c,0x07,0x5c,0x76,0x85,0xb0,0xc6,0xab,0xa3,0xc2}, 1},
+    {{0xf1,0xb5,0x8d,0xe0,0xcb,0xf6,0xac,0x07,0x58,0x3b,0xbe,0x97,0xde,0x42,0xf5,0x6e,0xae,0xc0,0x29,0x41,0x73,0x73,0xbb,0x84,0xe5,0x54,0x80,0xb7,0x9f,0x3a,0xcd,0xb3}, 0},
+    {{0xf1,0xb5,0x8d,0xe0,0xcb,0xf6,0xac,0x07,0x58,0x3b,0xbe,0x97,0xde,0x42,0xf5,0x6e,0xae,0xc0,0x29,0x41,0x73,0x73,0xbb,0x84,0xe5,0x54,0x80,0xb7,0x9f,0x3a,0xcd,0xb3}, 1},
+    {{0xf1,0xdc,0x26,0xb7,0x19,0x24,0x4c,0x73,0xda,0xcb,0x93,0x4c,0xf5,0x05,0x4c,0x84,0x1c,0x91,0x53,0x89,0xb5,0xdb,0x5a,0xa3,0xe0,0x6e,0x92,0x5b,0xa7,0x46,0x04,0xc8}, 0},
+    {{0xf1,0xdc,0x26,0xb7,0x19,0x24,0x4c,0x73,0xda,0xcb,0x93,0x4c,0xf5,0x05,0x4c,0x84,0x1c,0x91,0x53,0x89,0xb5,0xdb,0x5a,0xa3,0xe0,0x6e,0x92,0x5b,0xa7,0x46,0x04,0xc8}, 1},
+    {{0xf2,0x18,0x43,0xf3,0xf0,0x4f,0x23,0xe3,0xdd,0x14,0x1a,0xd8,0x89,0x5c,0x95,0x2c,0x8c,0x17,0xa8,0x4f,0xbb,0xd7,0xc7,0xf6,0x23,0x65,0x4a,0xcc,0xe3,0xab,0x4b,0x90}, 0},
+    {{0xf2,0x18,0x43,0xf3,0xf0,0x4f,0x23,0xe3,0xdd,0x14,0x1a,0xd8,0x89,0x5c,0x95,0x2c,0x8c,0x17,0xa8,0x4f,0xbb,0xd7,0xc7,0xf6,0x23,0x65,0x4a,0xcc,0xe3,0xab,0x4b,0x90}, 1},
+    {{0xf2,0x37,0x53,0x78,0xd8,0x55,0x7b,0x43,0x24,0x11,0xb3,0x82,0x5e,0x59,0x7a,0xb2,0x71,0x02,0x1d,0x06,0xfc,0xb4,0xa5,0x17,0xad,0x52,0x7c,0x14,0x8c,0xb4,0x9d,0x9e}, 0},
+    {{0xf2,0x37,0x53,0x78,0xd8,0x55,0x7b,0x43,0x24,0x11,0xb3,0x82,0x5e,0x59,0x7a,0xb2,0x71,0x02,0x1d,0x06,0xfc,0xb4,0xa5,0x17,0xad,0x52,0x7c,0x14,0x8c,0xb4,0x9d,0x9e}, 1},
+    {{0xf2,0x6a,0xfa,0xac,0x04,0x2b,0x02,0x99,0x18,0x03,0x45,0x46,0x27,0x26,0x85,0xa7,0x7a,0x9e,0x1b,0x7c,0xc8,0x96,0x7a,0xfa,0xd9,0x4a,0x05,0x78,0x29,0xc3,0x40,0x55}, 1},
+    {{0xf2,0x6a,0xfa,0xac,0x04,0x2b,0x02,0x99,0x18,0x03,0x45,0x46,0x27,0x26,0x85,0xa7,0x7a,0x9e,0x1b,0x7c,0xc8,0x96,0x7a,0xfa,0xd9,0x4a,0x05,0x78,0x29,0xc3,0x40,0x55}, 2},
+    {{0xf2,0xb1,0x79,0x56,0xfc,0xd8,0x55,0x4a,0x49,0x77,0x30,0x47,0xc0,0xf9,0x9f,0x21,0xb1,0x2d,0x3f,0xd9,0x77,0x1c,0x13,0x56,0xa3,0x58,0x13,0x98,0x30,0xe4,0xb7,0xcd}, 0},
+    {{0xf2,0xb1,0x79,0x56,0xfc,0xd8,0x55,0x4a,0x49,0x77,0x30,0x47,0xc0,0xf9,0x9f,0x21,0xb1,0x2d,0x3f,0xd9,0x77,0x1c,0x13,0x56,0xa3,0x58,0x13,0x98,0x30,0xe4,0xb7,0xcd}, 1},
+    {{0xf2,0xb9,0x82,0x65,0xcb,0x59,0xa8,0xc5,0xd0,0xad,0x39,0xe0,0xde,0xe4,0xda,0xa5,0xd2,0x87,0x20,0x41,0xa5,0x3a,0x5e,0x44,0xa3,0x12,0xce,0x48,0x6f,0x92,0x95,0x32}, 0},
+    {{0xf3,0x0d,0xc9,0x09,0xda,0x76,0xce,0x9b,0x60,0xd6,0xf1,0x3d,0x79,0x8e,0x71,0x89,0xae,0xa4,0x68,0x4e,0x3b,0x07,0x20,0x57,0x65,0x99,0x8f,0x15,0x78,0x65,0x1f,0x69}, 0},
+    {{0xf3,0x0d,0xc9,0x09,0xda,0x76,0xce,0x9b,0x60,0xd6,0xf1,0x3d,0x79,0x8e,0x71,0x89,0xae,0xa4,0x68,0x4e,0x3b,0x07,0x20,0x57,0x65,0x99,0x8f,0x15,0x78,0x65,0x1f,0x69}, 1},
+    {{0xf3,0x13,0xe5,0x56,0xa0,0x6c,0x45,0xb5,0xe8,0x57,0x22,0x3e,0x9f,0x90,0x0d,0x7d,0x70,0x20,0xef,0x20,0x93,0x7a,0x97,0x48,0xd4,0x8d,0x0e,0xfd,0xe4,0xfa,0xb1,0x37}, 0},
+    {{0xf3,0xf2,0x24,0x20,0x52,0x35,0x0c,0x10,0x8f,0xfa,0xab,0xba,0xab,0x9f,0x20,0x11,0x81,0xd1,0x9c,0xf5,0xf8,0x87,0x17,0x01,0xcb,0x38,0x54,0x32,0xdd,0x9c,0x04,0x12}, 0},
+    {{0xf4,0xa0,0xd8,0x07,0x71,0xd0,0xa0,0x48,0x42,0xca,0x28,0xc8,0x43,0x13,0xfe,0xca,0x42,0xe6,0xa5,0x83,0x79,0xac,0x0f,0xc3,0x30,0xf7,0x22,0xe7,0xd0,0x59,0x97,0x43}, 0},
+    {{0xf4,0xa0,0xd8,0x07,0x71,0xd0,0xa0,0x48,0x42,0xca,0x28,0xc8,0x43,0x13,0xfe,0xca,0x42,0xe6,0xa5,0x83,0x79,0xac,0x0f,0xc3,0x30,0xf7,0x22,0xe7,0xd0,0x59,0x97,0x43}, 1},
+    {{0xf4,0xd8,0xf6,0x21,0x0c,0x07,0x4f,0xf3,0xf8,0xd3,0x07,0x1c,0x65,0x9a,0xb6,0x5b,0xe9,0x27,0xfc,0xae,0x66,0xa3,0xba,0x34,0xab,0x67,0x01,0x7c,0x52,0x8f,0x53,0xc3}, 0},
+    {{0xf4,0xd8,0xf6,0x21,0x0c,0x07,0x4f,0xf3,0xf8,0xd3,0x07,0x1c,0x65,0x9a,0xb6,0x5b,0xe9,0x27,0xfc,0xae,0x66,0xa3,0xba,0x34,0xab,0x67,0x01,0x7c,0x52,0x8f,0x53,0xc3}, 1},
+    {{0xf5,0x06,0x70,0xbb,0x4e,0x0c,0x05,0xf2,0xab,0xcc,0xb3,0x6d,0xd8,0xf6,0x33,0x06,0xf2,0x61,0x29,0x41,0x00,0xe3,0xbe,0x9d,0x93,0x80,0x84,0xdd,0xd3,0x4d,0xb9,0xb0}, 0},
+    {{0xf5,0x37,0x40,0x4c,0x1e,0xc9,0x8d,0x6f,0x5f,0x7f,0x8f,0x2d,0x85,0x2b,0xc2,0x1c,0x1e,0xfc,0x41,0xf2,0x89,0x20,0x88,0xd5,0xf5,0x1c,0xe5,0x7a,0x12,0x44,0x9e,0x08}, 0},
+    {{0xf5,0x37,0x40,0x4c,0x1e,0xc9,0x8d,0x6f,0x5f,0x7f,0x8f,0x2d,0x85,0x2b,0xc2,0x1c,0x1e,0xfc,0x41,0xf2,0x89,0x20,0x88,0xd5,0xf5,0x1c,0xe5,0x7a,0x12,0x44,0x9e,0x08}, 1},
+    {{0xf5,0x3c,0xb8,0x8b,0xf2,0x44,0x6b,0x6f,0xdf,0xfd,0x49,0x1c,0xeb,0x1f,0x18,0x56,0xf9,0xf8,0x5d,0x2e,0x3c,0x68,0xb4,0xbe,0xe3,0xa0,0x7b,0x89,0xe0,0x3e,0x92,0x19}, 0},
+    {{0xf5,0x3c,0xb8,0x8b,0xf2,0x44,0x6b,0x6f,0xdf,0xfd,0x49,0x1c,0xeb,0x1f,0x18,0x56,0xf9,0xf8,0x5d,0x2e,0x3c,0x68,0xb4,0xbe,0xe3,0xa0,0x7b,0x89,0xe0,0x3e,0x92,0x19}, 1},
+    {{0xf5,0x58,0x46,0xec,0xde,0xca,0x92,0x0d,0x98,0x80,0x01,0x13,0x97,0x0a,0x42,0x9d,0xd4,0x25,0x35,0x7b,0xb6,0x98,0x94,0x54,0xed,0x7c,0x24,0x27,0xb6,0xe0,0xf0,0x3d}, 0},
+    {{0xf5,0x58,0x46,0xec,0xde,0xca,0x92,0x0d,0x98,0x80,0x01,0x13,0x97,0x0a,0x42,0x9d,0xd4,0x25,0x35,0x7b,0xb6,0x98,0x94,0x54,0xed,0x7c,0x24,0x27,0xb6,0xe0,0xf0,0x3d}, 1},
+    {{0xf5,0x58,0x5a,0x14,0x91,0x7b,0xb1,0x63,0x8c,0xdb,0x87,0x4e,0x06,0x00,0xdb,0x9b,0x22,0x25,0xf3,0x95,0xb7,0xc5,0xc5,0x4d,0xda,0xa4,0x87,0x49,0xc2,0xc6,0x0e,0xaf}, 0},
+    {{0xf5,0x58,0x5a,0x14,0x91,0x7b,0xb1,0x63,0x8c,0xdb,0x87,0x4e,0x06,0x00,0xdb,0x9b,0x22,0x25,0xf3,0x95,0xb7,0xc5,0xc5,0x4d,0xda,0xa4,0x87,0x49,0xc2,0xc6,0x0e,0xaf}, 1},
+    {{0xf5,0x7a,0x95,0x4c,0x2d,0x31,0x46,0xd5,0xc9,0x2a,0x51,0x31,0x4b,0x62,0xac,0xbc,0x20,0xb5,0x6c,0x5a,0x2e,0xdf,0xc4,0x23,0x9a,0x6d,0xfd,0x41,0xc1,0xfb,0xd4,0xe3}, 0},
+    {{0xf5,0xcd,0x6f,0x93,0xee,0x8a,0x48,0x11,0x7e,0x5c,0xa6,0x7e,0xc5,0xe5,0xd6,0xaa,0xca,0xc7,0x57,0xf4,0xb8,0x8f,0xc2,0x38,0xa8,0xf5,0x4f,0x3b,0x12,0xcd,0x84,0xa5}, 0},
+    {{0xf5,0xcd,0x6f,0x93,0xee,0x8a,0x48,0x11,0x7e,0x5c,0xa6,0x7e,0xc5,0xe5,0xd6,0xaa,0xca,0xc7,0x57,0xf4,0xb8,0x8f,0xc2,0x38,0xa8,0xf5,0x4f,0x3b,0x12,0xcd,0x84,0xa5}, 1},
+    {{0xf5,0xd3,0xea,0x28,0x60,0xf2,0x7e,0x1d,0xd7,0xfb,0xf7,0x85,0x4a,0x38,0xcc,0xc6,0xe8,0x8a,0xc7,0x8d,0x15,0x42,0x42,0x2a,0x0d,0xc4,0xfe,0xad,0xfc,0x9f,0x06,0x94}, 0},
+    {{0xf6,0x1b,0xfe,0xaf,0xad,0x43,0xe2,0x3b,0x25,0x72,0xc3,0x97,0x21,0xaf,0xc7,0xd9,0x36,0xb7,0xb3,0xaa,0xc9,0xd5,0x06,0x9c,0x52,0xd6,0xf4,0x51,0x8f,0x51,0x4f,0x26}, 0},
+    {{0xf6,0x1b,0xfe,0xaf,0xad,0x43,0xe2,0x3b,0x25,0x72,0xc3,0x97,0x21,0xaf,0xc7,0xd9,0x36,0xb7,0xb3,0xaa,0xc9,0xd5,0x06,0x9c,0x52,0xd6,0xf4,0x51,0x8f,0x51,0x4f,0x26}, 1},
+    {{0xf6,0x1f,0x98,0x71,0x38,0x03,0x97,0xea,0xf7,0xbc,0x05,0x20,0x21,0x78,0x8d,0x16,0x3b,0x5e,0xe4,0xfd,0x84,0x9f,0x03,0xbd,0x70,0x0a,0x82,0xfc,0xfc,0x2e,0x03,0x38}, 0},
+    {{0xf6,0x1f,0x98,0x71,0x38,0x03,0x97,0xea,0xf7,0xbc,0x05,0x20,0x21,0x78,0x8d,0x16,0x3b,0x5e,0xe4,0xfd,0x84,0x9f,0x03,0xbd,0x70,0x0a,0x82,0xfc,0xfc,0x2e,0x03,0x38}, 1},
+    {{0xf6,0x63,0x6e,0x68,0x5c,0x9c,0x39,0x15,0x97,0xfb,0xec,0x45,0x8c,0x63,0xd0,0x99,0x46,0xfe,0x4c,0x47,0x8f,0x81,0x58,0xdb,0xf5,0xa4,0xf4,0x66,0x93,0x3f,0x8b,0xd7}, 0},
+    {{0xf6,0x90,0x4a,0x5d,0x74,0x5b,0x9a,0x5a,0x5c,0x87,0xe7,0x5f,0xea,0x0d,0xb6,0x51,0x24,0xd9,0xd9,0x75,0x19,0xae,0x08,0x6f,0x2f,0x7d,0x5e,0xab,0x74,0x1d,0x82,0xe3}, 0},
+    {{0xf6,0x90,0x4a,0x5d,0x74,0x5b,0x9a,0x5a,0x5c,0x87,0xe7,0x5f,0xea,0x0d,0xb6,0x51,0x24,0xd9,0xd9,0x75,0x19,0xae,0x08,0x6f,0x2f,0x7d,0x5e,0xab,0x74,0x1d,0x82,0xe3}, 1},
+    {{0xf6,0x97,0x48,0xc9,0x94,0x32,0x02,0xd5,0xa6,0x61,0xdd,0x21,0x4c,0x38,0xde,0x41,0x19,0xc2,0xde,0x26,0xe4,0x47,0x89,0x41,0xa5,0x1f,0xec,0xdb,0xe9,0xfd,0x50,0x0f}, 0},
+    {{0xf6,0x97,0x48,0xc9,0x94,0x32,0x02,0xd5,0xa6,0x61,0xdd,0x21,0x4c,0x38,0xde,0x41,0x19,0xc2,0xde,0x26,0xe4,0x47,0x89,0x41,0xa5,0x1f,0xec,0xdb,0xe9,0xfd,0x50,0x0f}, 1},
+    {{0xf6,0x9a,0xd1,0xa1,0xec,0xa3,0xe1,0xbe,0x27,0x69,0xe0,0xb3,0xad,0xdd,0x4f,0x3f,0x88,0x9d,0x2c,0xf1,0x99,0x19,0xa4,0xfe,0x57,0xe2,0x3e,0xe8,0xef,0xc1,0x0a,0xa8}, 0},
+    {{0xf6,0x9a,0xd1,0xa1,0xec,0xa3,0xe1,0xbe,0x27,0x69,0xe0,0xb3,0xad,0xdd,0x4f,0x3f,0x88,0x9d,0x2c,0xf1,0x99,0x19,0xa4,0xfe,0x57,0xe2,0x3e,0xe8,0xef,0xc1,0x0a,0xa8}, 1},
+    {{0xf6,0xd0,0xad,0x0b,0x5f,0xa9,0xd1,0x8e,0x0a,0x4e,0xf4,0xc9,0x33,0x8f,0xe5,0x83,0xe0,0xfe,0xa4,0x52,0xa7,0x2c,0x96,0x7c,0x6f,0xf5,0xea,0x9e,0x23,0x27,0x34,0x5b}, 0},
+    {{0xf7,0x43,0xc7,0xf0,0xa4,0xf6,0x0b,0x0d,0x17,0xb0,0x1b,0xe7,0xbb,0x9d,0xf5,0xd2,0x7c,0xb5,0x0b,0x0c,0x08,0xb0,0xb1,0xe5,0x1c,0x27,0x2a,0xc4,0xf2,0xba,0xbc,0x03}, 0},
+    {{0xf7,0x57,0x16,0xb9,0x51,0xd4,0xc5,0xee,0x80,0x09,0x15,0x91,0x8e,0x4a,0xb2,0x58,0x24,0x61,0xfe,0xcb,0xc1,0xea,0x1d,0x22,0x98,0xa1,0x62,0xb0,0xf7,0x91,0x95,0x15}, 0},
+    {{0xf7,0x57,0x16,0xb9,0x51,0xd4,0xc5,0xee,0x80,0x09,0x15,0x91,0x8e,0x4a,0xb2,0x58,0x24,0x61,0xfe,0xcb,0xc1,0xea,0x1d,0x22,0x98,0xa1,0x62,0xb0,0xf7,0x91,0x95,0x15}, 1},
+    {{0xf7,0xbe,0x67,0xc5,0xce,0xdc,0xfd,0x0a,0x37,0x95,0xbd,0xe2,0x52,0x78,0x84,0x7c,0xab,0x0f,0x07,0x58,0x3a,0xc4,0x12,0xca,0x5c,0xbc,0x67,0x6b,0x2c,0x8a,0xb6,0x39}, 0},
+    {{0xf7,0xbe,0x67,0xc5,0xce,0xdc,0xfd,0x0a,0x37,0x95,0xbd,0xe2,0x52,0x78,0x84,0x7c,0xab,0x0f,0x07,0x58,0x3a,0xc4,0x12,0xca,0x5c,0xbc,0x67,0x6b,0x2c,0x8a,0xb6,0x39}, 1},
+    {{0xf7,0xd8,0x85,0xb1,0xe5,0x76,0x58,0x2f,0x85,0x77,0x46,0x34,0x9f,0xf7,0x94,0xb4,0x76,0x26,0xf1,0x56,0xbb,0xe8,0x36,0x06,0xc4,0xf8,0x8e,0x04,0x8f,0x52,0x8f,0x23}, 0},
+    {{0xf7,0xd8,0x85,0xb1,0xe5,0x76,0x58,0x2f,0x85,0x77,0x46,0x34,0x9f,0xf7,0x94,0xb4,0x76,0x26,0xf1,0x56,0xbb,0xe8,0x36,0x06,0xc4,0xf8,0x8e,0x04,0x8f,0x52,0x8f,0x23}, 1},
+    {{0xf8,0x16,0x33,0x8b,0xf3,0xb2,0xcf,0x4f,0x56,0x51,0xc1,0xd3,0x73,0xf9,0xf1,0x1e,0xf4,0xc6,0xe9,0x50,0x31,0x5d,0x88,0x06,0x7f,0x66,0x8a,0x40,0xb9,0x44,0x6b,0x63}, 0},
+    {{0xf8,0x2a,0x82,0x17,0x8f,0xb8,0x34,0xec,0xba,0x28,0x0b,0x51,0x80,0x89,0x6b,0x0b,0xd8,0x99,0xbe,0x5b,0x63,0xd9,0x87,0x45,0xc9,0x28,0x3e,0x29,0x70,0xa4,0x26,0xb4}, 0},
+    {{0xf9,0x0f,0xd9,0x84,0x3f,0x49,0xff,0x43,0x98,0x50,0xb4,0x73,0x5d,0x9f,0x2a,0xfc,0x58,0xfd,0x95,0x62,0x22,0xb8,0xf2,0xbe,0x70,0x6a,0xdc,0x53,0x2c,0xb8,0x37,0x68}, 0},
+    {{0xf9,0x0f,0xd9,0x84,0x3f,0x49,0xff,0x43,0x98,0x50,0xb4,0x73,0x5d,0x9f,0x2a,0xfc,0x58,0xfd,0x95,0x62,0x22,0xb8,0xf2,0xbe,0x70,0x6a,0xdc,0x53,0x2c,0xb8,0x37,0x68}, 1},
+    {{0xf9,0x52,0x7c,0x28,0xe2,0xb6,0x4f,0x42,0x5f,0x46,0x97,0xcf,0xa6,0x91,0x8b,0x65,0x13,0x6a,0xa4,0x56,0xb7,0x75,0xcd,0x3d,0x50,0x64,0x2d,0xde,0x1e,0x3e,0xf1,0x0d}, 0},
+    {{0xf9,0xd7,0x7b,0x9c,0x9c,0x21,0x3c,0x72,0xde,0x92,0xef,0x3a,0xc5,0xb6,0x1f,0x60,0xbe,0xfe,0x6e,0x0b,0x38,0x30,0x86,0x4e,0x74,0x33,0x11,0x70,0xbf,0x10,0xe4,0xbf}, 0},
+    {{0xf9,0xfc,0x3c,0x08,0x10,0xe1,0x7c,0x3e,0x95,0xa1,0x1a,0x92,0x1d,0xaf,0x8c,0xb4,0x9a,0x19,0xaf,0xd6,0xd7,0x4f,0x2a,0x66,0xcd,0x0d,0x7c,0xda,0xa6,0x53,0xec,0x02}, 0},
+    {{0xfa,0x0f,0xf8,0x76,0xa5,0x61,0xd5,0xd9,0xda,0x8d,0x25,0x33,0xed,0xa8,0x6c,0xf8,0xd5,0x7f,0x07,0xc8,0x55,0x16,0xd8,0x93,0x54,0xd1,0xe4,0x9b,0xd1,0xc5,0x8b,0xe3}, 0},
+    {{0xfa,0x0f,0xf8,0x76,0xa5,0x61,0xd5,0xd9,0xda,0x8d,0x25,0x33,0xed,0xa8,0x6c,0xf8,0xd5,0x7f,0x07,0xc8,0x55,0x16,0xd8,0x93,0x54,0xd1,0xe4,0x9b,0xd1,0xc5,0x8b,0xe3}, 1},
+    {{0xfa,0x65,0x71,0xec,0xd7,0x4e,0xc7,0x1d,0x07,0x3c,0x32,0xdc,0xfa,0x8c,0x79,0x17,0x8b,0x47,0x3f,0xb8,0x96,0x2d,0xb8,0xf2,0x2e,0x40,0xa5,0x27,0x4d,0x4f,0x13,0x19}, 0},
+    {{0xfa,0x65,0x71,0xec,0xd7,0x4e,0xc7,0x1d,0x07,0x3c,0x32,0xdc,0xfa,0x8c,0x79,0x17,0x8b,0x47,0x3f,0xb8,0x96,0x2d,0xb8,0xf2,0x2e,0x40,0xa5,0x27,0x4d,0x4f,0x13,0x19}, 1},
+    {{0xfa,0x8a,0x2c,0xd6,0xbc,0x0e,0x89,0x3c,0x8a,0x68,0x50,0x25,0x30,0xe8,0x4c,0x54,0xc5,0x64,0x1a,0x5f,0xf2,0x29,0xba,0x30,0x17,0xb4,0xd9,0xc5,0xe3,0x71,0xd9,0x6c}, 0},
+    {{0xfa,0x8a,0x2c,0xd6,0xbc,0x0e,0x89,0x3c,0x8a,0x68,0x50,0x25,0x30,0xe8,0x4c,0x54,0xc5,0x64,0x1a,0x5f,0xf2,0x29,0xba,0x30,0x17,0xb4,0xd9,0xc5,0xe3,0x71,0xd9,0x6c}, 1},
+    {{0xfa,0xe7,0x0e,0x9a,0xeb,0xfc,0x46,0xa7,0x09,0x0d,0x5c,0xb2,0xc1,0xe0,0xb1,0x6e,0x39,0xa6,0x16,0x47,0x78,0xd5,0xdf,0xce,0xd3,0xc8,0xb7,0xda,0x57,0x0a,0x60,0x12}, 0},
+    {{0xfa,0xf6,0x6d,0x17,0x61,0x08,0xb8,0xd8,0xfd,0x88,0x5d,0x8c,0xd8,0x7a,0xae,0x5e,0x9e,0x61,0xfa,0x65,0x2b,0x3d,0x38,0x46,0x4a,0x60,0x03,0x6e,0xd8,0x6b,0x56,0x15}, 0},
+    {{0xfa,0xf6,0x6d,0x17,0x61,0x08,0xb8,0xd8,0xfd,0x88,0x5d,0x8c,0xd8,0x7a,0xae,0x5e,0x9e,0x61,0xfa,0x65,0x2b,0x3d,0x38,0x46,0x4a,0x60,0x03,0x6e,0xd8,0x6b,0x56,0x15}, 1},
+    {{0xfb,0x4d,0x7c,0x70,0xc2,0x20,0xae,0xcd,0xfa,0x97,0x91,0x0f,0x4f,0x14,0xf2,0x42,0xe2,0xbd,0xc2,0x0b,0xd7,0xc9,0x21,0x06,0x01,0xe9,0xa5,0x3c,0x82,0x20,0xf2,0xf9}, 0},
+    {{0xfc,0x20,0xab,0x9e,0xc9,0x2d,0x84,0xde,0x86,0x53,0xd8,0x5b,0x57,0x3c,0xde,0x49,0xa7,0x5d,0x05,0xcd,0xb4,0x3d,0x20,0xf9,0xc1,0xab,0x7f,0xe5,0xb6,0x56,0xe3,0x7c}, 0},
+    {{0xfc,0x20,0xab,0x9e,0xc9,0x2d,0x84,0xde,0x86,0x53,0xd8,0x5b,0x57,0x3c,0xde,0x49,0xa7,0x5d,0x05,0xcd,0xb4,0x3d,0x20,0xf9,0xc1,0xab,0x7f,0xe5,0xb6,0x56,0xe3,0x7c}, 1},
+    {{0xfc,0xf3,0x67,0x6f,0xba,0x70,0x8f,0x3d,0xa6,0xaf,0xf8,0x47,0xa0,0x1f,0x81,0xc6,0xa9,0x66,0xf0,0x98,0x48,0xb8,0x0f,0xec,0x4f,0xa9,0x63,0x76,0xfb,0x96,0x6d,0x9b}, 0},
+    {{0xfc,0xfa,0xae,0x8e,0x8b,0xe1,0x71,0x58,0xb0,0xb7,0x1c,0x6c,0xb0,0x95,0xc6,0x5a,0xad,0x28,0x91,0xe2,0x47,0x58,0x26,0x0c,0xc8,0x92,0x02,0xc0,0x87,0x1a,0xab,0x64}, 0},
+    {{0xfc,0xfa,0xae,0x8e,0x8b,0xe1,0x71,0x58,0xb0,0xb7,0x1c,0x6c,0xb0,0x95,0xc6,0x5a,0xad,0x28,0x91,0xe2,0x47,0x58,0x26,0x0c,0xc8,0x92,0x02,0xc0,0x87,0x1a,0xab,0x64}, 1},
+    {{0xfd,0x00,0xc0,0xe7,0xfb,0xec,0xf6,0x4c,0xed,0x33,0x23,0x72,0x42,0x18,0x11,0x81,0x52,0x9f,0x30,0x32,0x7c,0xbd,0x68,0xcf,0x28,0x2b,0x5c,0x88,0xcd,0xd4,0xb3,0x5d}, 0},
+    {{0xfd,0x01,0x19,0x80,0xab,0x0e,0x9b,0x09,0x10,0x67,0xf8,0x18,0x96,0xad,0xf8,0xe1,0x23,0x01,0xe4,0xac,0xa0,0x62,0x6a,0x5b,0x11,0x6f,0x49,0x8b,0x54,0xf5,0xd3,0x35}, 0},
+    {{0xfd,0x17,0x73,0xf1,0x5f,0xa0,0x60,0xb5,0x4e,0x25,0x31,0xde,0xf6,0xb3,0x26,0xe9,0x94,0x2b,0xb2,0xa6,0xb9,0x9b,0x7e,0x87,0x95,0xec,0x12,0x01,0x12,0xe7,0x6f,0x2d}, 0},
+    {{0xfd,0x17,0x73,0xf1,0x5f,0xa0,0x60,0xb5,0x4e,0x25,0x31,0xde,0xf6,0xb3,0x26,0xe9,0x94,0x2b,0xb2,0xa6,0xb9,0x9b,0x7e,0x87,0x95,0xec,0x12,0x01,0x12,0xe7,0x6f,0x2d}, 1},
+    {{0xfd,0x38,0x0a,0x52,0x0c,0xc7,0xab,0x8f,0xd2,0x1d,0x6d,0xdb,0xff,0xe2,0xcf,0x7d,0x48,0x33,0xf6,0x25,0x02,0xe9,0xb9,0xa4,0x78,0xb0,0xf9,0x28,0x0d,0xe1,0x18,0xb0}, 0},
+    {{0xfd,0x38,0x0a,0x52,0x0c,0xc7,0xab,0x8f,0xd2,0x1d,0x6d,0xdb,0xff,0xe2,0xcf,0x7d,0x48,0x33,0xf6,0x25,0x02,0xe9,0xb9,0xa4,0x78,0xb0,0xf9,0x28,0x0d,0xe1,0x18,0xb0}, 1},
+    {{0xfd,0xc3,0xdf,0x82,0xd0,0x93,0x73,0xe1,0xd6,0x64,0xe8,0xeb,0xe3,0x66,0xc8,0xe7,0x53,0x5a,0xce,0x83,0x28,0x45,0x68,0xac,0x86,0x66,0xb1,0xb8,0x0d,0xc6,0xf5,0xec}, 0},
+    {{0xfd,0xc3,0xdf,0x82,0xd0,0x93,0x73,0xe1,0xd6,0x64,0xe8,0xeb,0xe3,0x66,0xc8,0xe7,0x53,0x5a,0xce,0x83,0x28,0x45,0x68,0xac,0x86,0x66,0xb1,0xb8,0x0d,0xc6,0xf5,0xec}, 1},
+    {{0xfd,0xcb,0x13,0xc8,0xf1,0x6e,0xe0,0x27,0x16,0x49,0x25,0xe6,0x4d,0x9f,0x1b,0x43,0xc4,0x74,0x63,0x27,0x2f,0xf4,0x60,0xb5,0x89,0xfa,0x20,0x23,0x8e,0x3b,0xe8,0x40}, 0},
+    {{0xfd,0xcb,0x13,0xc8,0xf1,0x6e,0xe0,0x27,0x16,0x49,0x25,0xe6,0x4d,0x9f,0x1b,0x43,0xc4,0x74,0x63,0x27,0x2f,0xf4,0x60,0xb5,0x89,0xfa,0x20,0x23,0x8e,0x3b,0xe8,0x40}, 1},
+    {{0xfd,0xdd,0x71,0x06,0x37,0x35,0x6f,0x87,0xd8,0x3b,0x30,0x1a,0x0f,0xdf,0xb0,0x2a,0xd7,0x21,0x1c,0xe7,0x1f,0xe6,0x35,0xed,0x4d,0xc5,0xe1,0x55,0x7a,0x5c,0x1f,0x48}, 0},
+    {{0xfd,0xdd,0x71,0x06,0x37,0x35,0x6f,0x87,0xd8,0x3b,0x30,0x1a,0x0f,0xdf,0xb0,0x2a,0xd7,0x21,0x1c,0xe7,0x1f,0xe6,0x35,0xed,0x4d,0xc5,0xe1,0x55,0x7a,0x5c,0x1f,0x48}, 1},
+    {{0xfd,0xde,0x3c,0x51,0xfb,0x05,0xef,0x79,0xd0,0x45,0x72,0xff,0xbc,0xa7,0x4d,0x03,0x1b,0xe4,0x06,0xec,0xc3,0x85,0x45,0x64,0x49,0xb3,0x90,0x0c,0x3e,0x3b,0x9a,0x3d}, 0},
+    {{0xfe,0x2f,0x9d,0xd6,0xf1,0x61,0xab,0x92,0x3a,0x17,0xb3,0x87,0x6e,0x41,0x00,0x43,0xab,0x28,0x14,0x0e,0x92,0x53,0x91,0x27,0x07,0x1b,0x77,0xa9,0xba,0xaa,0x78,0xa9}, 0},
+    {{0xfe,0x2f,0x9d,0xd6,0xf1,0x61,0xab,0x92,0x3a,0x17,0xb3,0x87,0x6e,0x41,0x00,0x43,0xab,0x28,0x14,0x0e,0x92,0x53,0x91,0x27,0x07,0x1b,0x77,0xa9,0xba,0xaa,0x78,0xa9}, 1},
+    {{0xfe,0xb0,0x87,0x05,0xa4,0x6c,0x3d,0xfc,0x9d,0xc5,0xe2,0x18,0x98,0x0b,0x38,0x5b,0x5c,0xe9,0x90,0xa7,0xe6,0x45,0xcb,0xc0,0x41,0x3c,0x4f,0x64,0xb8,0x08,0x39,0xd5}, 0},
+    {{0xfe,0xb0,0x87,0x05,0xa4,0x6c,0x3d,0xfc,0x9d,0xc5,0xe2,0x18,0x98,0x0b,0x38,0x5b,0x5c,0xe9,0x90,0xa7,0xe6,0x45,0xcb,0xc0,0x41,0x3c,0x4f,0x64,0xb8,0x08,0x39,0xd5}, 1},
+    {{0xfe,0xfa,0xb9,0x0e,0xfa,0x3c,0x0f,0x6a,0xc2,0x48,0x96,0xed,0x40,0x3b,0x87,0x68,0x15,0xa8,0xfb,0x85,0xff,0xad,0x36,0x58,0xaf,0x50,0x27,0x86,0x8e,0xde,0x2e,0x8e}, 0},
+    {{0xff,0x03,0xf7,0xc6,0xba,0x6c,0xd2,0x8b,0x40,0xa3,0xb1,0x5c,0x83,0x70,0x61,0x1d,0xa5,0xd4,0x07,0x0a,0x5e,0x38,0x17,0x5e,0x46,0x9f,0xa8,0x4f,0x79,0xc8,0x67,0x93}, 0},
+    {{0xff,0x03,0xf7,0xc6,0xba,0x6c,0xd2,0x8b,0x40,0xa3,0xb1,0x5c,0x83,0x70,0x61,0x1d,0xa5,0xd4,0x07,0x0a,0x5e,0x38,0x17,0x5e,0x46,0x9f,0xa8,0x4f,0x79,0xc8,0x67,0x93}, 1},
+    {{0xff,0x2b,0x14,0x6e,0xa0,0xed,0x0b,0x78,0xbe,0xf5,0x53,0x25,0x43,0xac,0xb1,0x0b,0x17,0xc7,0x2a,0xb9,0x2a,0x23,0x41,0x24,0x10,0x82,0xf2,0x29,0x4f,0xd0,0xf4,0x53}, 0},
+    {{0xff,0x3a,0xb0,0xa5,0x04,0xba,0xd4,0x4b,0x55,0x62,0xab,0xfb,0xcf,0xf5,0xb8,0x5e,0x6c,0x88,0xe1,0xb6,0x4c,0x82,0xf3,0x03,0x71,0xd8,0xd0,0x64,0x7c,0x89,0x53,0x12}, 0},
+    {{0xff,0x3a,0xb0,0xa5,0x04,0xba,0xd4,0x4b,0x55,0x62,0xab,0xfb,0xcf,0xf5,0xb8,0x5e,0x6c,0x88,0xe1,0xb6,0x4c,0x82,0xf3,0x03,0x71,0xd8,0xd0,0x64,0x7c,0x89,0x53,0x12}, 1},
+    {{0xff,0xa3,0xd8,0xfe,0x2b,0xdb,0x1e,0x3a,0x28,0x34,0xca,0x1a,0xd5,0xdf,0x51,0x11,0xe4,0x12,0xea,0x40,0x07,0x30,0x33,0x5f,0x71,0x71,0xcc,0x90,0x42,0x9a,0xed,0xa4}, 0},
+    {{0xff,0xa3,0xd8,0xfe,0x2b,0xdb,0x1e,0x3a,0x28,0x34,0xca,0x1a,0xd5,0xdf,0x51,0x11,0xe4,0x12,0xea,0x40,0x07,0x30,0x33,0x5f,0x71,0x71,0xcc,0x90,0x42,0x9a,0xed,0xa4}, 1}
+};
+
+static const InvalidSerialSpec pInvalidSerials[] = {
+    {{0x00,0x50,0x94,0x5c,0x7c,0x13,0xbc,0x3e,0xa9,0x11,0xab,0x47,0x5e,0x81,0x19,0xa9,0xea,0x6f,0x44,0xaf,0x38,0x5e,0x48,0xad,0x97,0x2d,0xe2,0xab,0xd0,0xfd,0x78,0xd3,0x00}},
+    {{0x00,0x55,0xcf,0xf6,0xbe,0x3d,0xcd,0x49,0x2d,0x56,0x17,0x45,0x51,0xac,0xf5,0x28,0x3c,0xc1,0x7b,0x1a,0x1c,0x36,0x38,0xcc,0xa4,0x85,0xef,0xcc,0x88,0x1a,0x8b,0x94,0x01}},
+    {{0x01,0xaf,0xcc,0xf0,0x3b,0x69,0x75,0xb0,0x0c,0x35,0x3a,0xfd,0xed,0x97,0xfc,0xf3,0xe5,0xd6,0x98,0x57,0xe6,0x27,0x88,0x95,0x27,0x09,0x3d,0x23,0x2e,0xf9,0x48,0x63,0x00}},
+    {{0x01,0xf1,0x07,0x54,0xd8,0xf7,0x6b,0xa5,0xe0,0x79,0xee,0x70,0x0a,0x9a,0x7c,0x78,0x3f,0x6c,0x72,0x6c,0x4e,0xa6,0x63,0xef,0x85,0x20,0x79,0x66,0x5e,0x59,0x63,0x2b,0x01}},
+    {{0x02,0xa5,0xfe,0x0b,0x79,0xbd,0x82,0xcb,0x09,0x97,0x60,0x44,0xc4,0xc9,0x3b,0x65,0xb0,0x4d,0x09,0x10,0x74,0x1d,0x0d,0xda,0xc0,0x01,0xc6,0xed,0xff,0xcf,0xc3,0x30,0x00}},
+    {{0x02,0xf8,0x45,0x7c,0x32,0xcf,0x09,0xfc,0x51,0x8f,0xc4,0x89,0xfd,0x0e,0xff,0x14,0xe4,0x6e,0x2d,0xba,0xe2,0xc8,0x6d,0xc4,0x2e,0x13,0xf8,0x65,0xc5,0x64,0x0a,0xeb,0x00}},
+    {{0x03,0x3b,0x60,0x53,0x21,0x68,0xfd,0x57,0xff,0x31,0x1b,0x3f,0x10,0xc5,0x9a,0xc2,0x21,0x04,0x43,0x57,0xa7,0x5b,0xd3,0x61,0xc0,0x07,0x72,0x17,0xad,0x00,0x5c,0x59,0x00}},
+    {{0x04,0x4e,0x84,0x09,0x98,0xab,0xc9,0x37,0x2d,0x9a,0x8c,0xdd,0xe2,0x71,0xd5,0x71,0x66,0x7b,0xcf,0xcb,0x2a,0x7e,0x7e,0x39,0x7e,0x7f,0xd3,0xaf,0xc9,0xf9,0x6b,0x51,0x00}},
+    {{0x05,0x80,0x4b,0x8a,0xf4,0xa8,0xc0,0x6b,0x9f,0x14,0xaf,0x3b,0x55,0x30,0xb5,0xb9,0x86,0x7e,0xc7,0x0e,0x1b,0xf3,0x98,0x9f,0x57,0x70,0x35,0x3a,0x89,0xfd,0x1f,0xbe,0x00}},
+    {{0x05,0x95,0x53,0x79,0x2b,0x53,0xa4,0xe7,0x59,0x6f,0xcc,0xd3,0x3a,0x71,0xee,0xfb,0x08,0xaa,0xda,0xa8,0xe3,0xf3,0x63,0xae,0xe6,0x78,0x4e,0x96,0x55,0x20,0xe6,0x72,0x00}},
+    {{0x05,0xb6,0x39,0xa6,0xd5,0xbb,0xb1,0xa4,0x04,0x40,0xef,0xdc,0x93,0x31,0xe3,0x49,0x31,0x2d,0x70,0x3b,0x1e,0x93,0x40,0xc9,0x4b,0x43,0xc1,0xb1,0x28,0xaf,0xe7,0x26,0x00}},
+    {{0x07,0x1c,0x17,0x70,0x4f,0x51,0x51,0x12,0xa2,0x14,0x9e,0x51,0x18,0x08,0x30,0x3e,0x90,0xef,0xe0,0xe9,0x02,0x3c,0x09,0x44,0x5b,0xdf,0x65,0xf1,0x78,0xdb,0x81,0xf6,0x00}},
+    {{0x07,0x71,0x62,0x46,0x39,0x80,0xbf,0x16,0x6f,0x86,0x15,0xb1,0xca,0x3c,0x08,0x7c,0xc1,0x89,0x41,0xbc,0xe4,0xbf,0x79,0xab,0xfb,0x00,0x70,0x21,0x53,0x22,0xb6,0x98,0x01}},
+    {{0x08,0xeb,0x66,0xd6,0xb4,0x10,0x20,0xbf,0xf5,0x92,0x3e,0x05,0xad,0x61,0x70,0xeb,0xa6,0x4f,0xca,0x72,0xe7,0x98,0x16,0xb0,0x93,0x56,0x50,0xb3,0x2f,0xbd,0x5f,0xba,0x00}},
+    {{0x09,0xa4,0x4f,0xe2,0xd2,0x3c,0xa7,0x71,0xa6,0x7a,0x7f,0xd9,0x99,0xaf,0x3c,0x1d,0x71,0xd9,0x45,0x92,0x42,0xe1,0xdb,0x08,0xbf,0x3e,0x3c,0x35,0x33,0xca,0x5e,0x67,0x00}},
+    {{0x0a,0x8e,0x86,0x4d,0x80,0x42,0x37,0xeb,0x64,0x22,0xaa,0x73,0x61,0x77,0xda,0x87,0x4a,0xfd,0x45,0x69,0x38,0x0a,0xae,0x62,0x33,0x93,0x98,0xc2,0xd0,0xba,0xeb,0x33,0x00}},
+    {{0x0a,0x9c,0x85,0x30,0x1e,0x26,0xfb,0xde,0xc8,0x78,0xd2,0x55,0x73,0x9d,0x7c,0xaa,0xba,0x3e,0xb3,0x1c,0xa3,0x0d,0xb3,0x57,0x56,0xec,0x24,0x63,0xcb,0x4f,0x41,0x55,0x01}},
+    {{0x0c,0x6e,0xc6,0x68,0xf1,0xfd,0xcd,0x07,0x8f,0x8d,0x05,0x5e,0xfa,0xbe,0x5d,0xe1,0x19,0x7c,0x95,0x3e,0x4c,0x66,0xd4,0x0b,0xed,0x83,0xe3,0xd3,0xca,0xa6,0x09,0xfd,0x00}},
+    {{0x0c,0x75,0x76,0xfa,0xc5,0xfb,0x8d,0xb8,0xe6,0x56,0xbf,0x23,0x1b,0xd0,0x51,0x8b,0xed,0xb1,0x98,0xb3,0xbb,0xc6,0x90,0x73,0xa5,0xe3,0x1a,0x38,0x50,0xb3,0xc0,0x28,0x01}},
+    {{0x0d,0x5c,0x0e,0xea,0xd9,0xfa,0x5e,0x53,0xc6,0x16,0x84,0xdd,0x25,0xa2,0xcf,0xcf,0x70,0x53,0x7b,0xe5,0xde,0x8f,0x81,0xf9,0x19,0x0c,0xb7,0xfb,0xe8,0x3b,0x45,0x28,0x00}},
+    {{0x0d,0x86,0x43,0x99,0x9e,0x9f,0x22,0x44,0x5b,0x6a,0x43,0xb9,0x16,0x4e,0xd9,0x03,0x1b,0xc7,0xa7,0xed,0x0b,0x7e,0x0c,0x7c,0x40,0xbd,0xfb,0x98,0xe5,0xc0,0xad,0x30,0x00}},
+    {{0x0e,0x4b,0x8f,0x4c,0xd5,0xa6,0xed,0xc4,0x80,0x84,0x7d,0xb7,0x18,0xd0,0x2f,0x89,0x97,0x1d,0x8c,0x31,0xc8,0x5a,0x27,0x54,0xcf,0x3b,0xfd,0xdb,0xc2,0xe1,0x5f,0x0a,0x00}},
+    {{0x0f,0xbe,0x21,0x9f,0x87,0x68,0x57,0x25,0x7d,0xee,0x40,0x83,0xe2,0xa8,0x84,0x4e,0x03,0xf0,0x43,0xdd,0x89,0xec,0x21,0xa1,0x0e,0x92,0x43,0xe7,0xaa,0x6d,0xd3,0x47,0x00}},
+    {{0x10,0x00,0x5c,0xac,0xda,0x26,0xcb,0x9f,0x8e,0x9f,0x3c,0x17,0xd6,0x3d,0x08,0x35,0x52,0x2f,0x17,0x75,0x61,0x6a,0x08,0x60,0x4d,0x02,0x74,0x90,0x26,0xca,0xce,0x4c,0x00}},
+    {{0x10,0x5d,0x6b,0x72,0x99,0xd2,0xea,0x6d,0x38,0x0f,0x58,0xde,0xcf,0xa5,0x9f,0xc3,0x43,0x2d,0xe1,0xc5,0xb4,0x79,0x06,0xdd,0x9a,0x92,0x70,0x55,0x32,0x81,0x99,0x8f,0x00}},
+    {{0x10,0x69,0x4c,0x5b,0x55,0x6c,0x93,0x8f,0x97,0xa9,0x74,0x54,0xa9,0xef,0x95,0x1f,0xc9,0xd2,0x74,0x9c,0x6a,0xe2,0xe8,0x73,0xb5,0xa1,0x20,0x44,0x41,0x96,0xfc,0x8e,0x00}},
+    {{0x10,0xcc,0xb9,0x15,0x82,0x8f,0xa9,0x68,0x5e,0x9b,0x1d,0x07,0xf3,0xba,0xec,0xa3,0x06,0x75,0xdd,0x62,0x78,0x8f,0x15,0x3e,0x73,0x29,0xe2,0x3f,0xda,0x2f,0x05,0x78,0x00}},
+    {{0x10,0xef,0xbd,0x1a,0x9a,0x8a,0x62,0x9a,0x47,0xa4,0x16,0xe1,0xd4,0xfb,0x2e,0x04,0x13,0x08,0xaa,0x8f,0x51,0x05,0xb0,0x41,0x82,0x86,0xcd,0x93,0xa8,0xa9,0x52,0x3c,0x00}},
+    {{0x11,0x09,0x3e,0x34,0x32,0xa3,0x81,0x19,0xbc,0x09,0xc5,0x9e,0x9e,0x44,0x6d,0x5f,0x94,0xf3,0xb6,0xaf,0xea,0x79,0x67,0xbc,0x5a,0xb6,0xb0,0xbb,0x14,0xcd,0x15,0x51,0x00}},
+    {{0x12,0x05,0x1a,0xf7,0xae,0x29,0xb2,0xf4,0x18,0xd8,0xec,0x4d,0xe3,0x6c,0xff,0x25,0xb7,0x6f,0xe1,0x91,0xbe,0xca,0x30,0x33,0x59,0x55,0xc8,0xd0,0x39,0xf0,0xbd,0x32,0x01}},
+    {{0x16,0x34,0xf1,0xc4,0x6f,0xd9,0xa5,0x2b,0xa2,0x53,0xb4,0xf9,0x7d,0x18,0x7a,0xba,0x99,0xbd,0xe6,0xfa,0xfe,0x62,0x81,0x58,0x94,0xe7,0xcb,0xd8,0x87,0xd7,0x76,0x63,0x01}},
+    {{0x16,0xc4,0x96,0x21,0x84,0x5c,0xdd,0xeb,0x17,0xac,0x97,0x79,0x50,0x95,0x58,0x69,0x53,0x38,0x5f,0xca,0x95,0x81,0x8a,0xf3,0x04,0xa0,0x9e,0x5f,0x4c,0x84,0x6e,0x61,0x00}},
+    {{0x17,0x5f,0x43,0x98,0x56,0xa0,0xd4,0x3a,0xb8,0x9a,0xfb,0x96,0x56,0x73,0x9d,0x1f,0x92,0x52,0x58,0x1c,0xf1,0x53,0xb5,0x61,0x16,0x4a,0xd0,0xef,0xc6,0x7d,0x4a,0xb3,0x00}},
+    {{0x18,0x0b,0x6b,0xc9,0x62,0xc1,0xef,0x80,0x25,0xc6,0xbb,0xcd,0x9c,0xce,0x8d,0xe6,0xe9,0xc7,0xec,0xfd,0x58,0x8d,0x3d,0x58,0xb0,0x8b,0xd0,0xe8,0x7c,0xa7,0x23,0x3a,0x01}},
+    {{0x19,0x64,0x0e,0xf8,0x0d,0xb1,0xa4,0xa8,0x1b,0x13,0x34,0xf4,0x73,0xea,0x76,0xf2,0xba,0x55,0xad,0x28,0x1b,0x9f,0xf3,0x50,0x75,0x2b,0x17,0x8c,0xf6,0xee,0xa0,0xb5,0x00}},
+    {{0x19,0x6c,0x1e,0xba,0xf5,0x81,0x92,0x4d,0x2a,0x82,0x89,0xd5,0xfc,0xc6,0xd8,0x49,0xa0,0x77,0x70,0x0b,0x7b,0xc4,0x24,0x05,0x54,0xb5,0xe9,0x8f,0x0c,0xf2,0xd2,0x85,0x01}},
+    {{0x19,0x78,0x74,0x9d,0x56,0x75,0x1b,0xc1,0x6c,0x40,0xf1,0x51,0xb2,0x4b,0x96,0x4f,0x8f,0x6a,0x4e,0x05,0xbb,0xfc,0x73,0x11,0x10,0x0e,0x29,0x4d,0x16,0xa8,0x06,0x4d,0x00}},
+    {{0x19,0xfe,0xa9,0x15,0xa1,0x29,0xba,0x0f,0x75,0x6c,0x9b,0x37,0xbe,0xa5,0x8c,0x2b,0xb7,0x6b,0xfa,0x3e,0x44,0x13,0xb2,0x71,0x18,0x7c,0xcd,0xea,0x9a,0x2e,0xfd,0x77,0x00}},
+    {{0x1a,0x28,0x32,0x30,0xc4,0x3d,0x26,0x07,0x28,0xb0,0x8c,0xd0,0x08,0x6b,0xa5,0x29,0xb1,0x05,0xcf,0x47,0xad,0x25,0x46,0x0e,0xdd,0x4d,0x1b,0x20,0xca,0x96,0xfd,0x08,0x01}},
+    {{0x1a,0x7e,0x34,0xc3,0x53,0xbf,0x1a,0x62,0x91,0x78,0x0c,0xf7,0x1e,0x63,0x2e,0xa6,0xa5,0x37,0x7f,0x2f,0xaf,0x51,0x26,0x20,0x22,0x98,0x1e,0x92,0x0f,0x9a,0xf1,0xe9,0x00}},
+    {{0x1b,0x1d,0x16,0x7a,0x4e,0xb9,0x55,0xc6,0x76,0x18,0x48,0x84,0xb8,0x2a,0x8a,0x8b,0x10,0xa7,0x42,0xb7,0x05,0xcf,0x45,0xdd,0xb1,0x04,0x22,0x6b,0x02,0x70,0x07,0x64,0x01}},
+    {{0x1b,0x3b,0xf3,0x04,0xa9,0xb1,0x6a,0xce,0x99,0xc6,0x8f,0x4d,0x24,0xd1,0x8d,0x9b,0x80,0xe7,0x82,0x8b,0x21,0x65,0x77,0x0a,0xf0,0xa7,0x8c,0x39,0xfc,0x04,0x86,0xd4,0x00}},
+    {{0x1b,0x59,0xfd,0x0d,0x85,0xc4,0xc7,0x7f,0x2a,0x3d,0x4c,0xa6,0x98,0xf8,0xd2,0x27,0x50,0x31,0x7d,0x23,0xbf,0xe6,0x52,0x78,0xd9,0xcb,0x05,0x10,0x37,0x4f,0xb2,0xc9,0x00}},
+    {{0x1b,0xbd,0xcf,0x4a,0x74,0x23,0x50,0x2b,0x8a,0xf2,0x78,0xd5,0xcf,0x70,0xd0,0x62,0x21,0xc5,0xd8,0x75,0x82,0x5b,0xec,0x26,0x13,0x7f,0xac,0xef,0xe1,0xc9,0x56,0xa9,0x00}},
+    {{0x1d,0x67,0xfc,0x1b,0xe2,0xaf,0x48,0xb5,0xa5,0xa5,0x3d,0xaa,0xe6,0xca,0xff,0x34,0xd1,0x62,0x2d,0x94,0x57,0x67,0x66,0x1e,0x91,0xdb,0x1b,0xfb,0x4f,0x0a,0xef,0x78,0x01}},
+    {{0x1d,0xde,0x24,0x9b,0x74,0x13,0xee,0xe6,0x3a,0x22,0x28,0x52,0x64,0x3d,0xc7,0x23,0x0a,0xd1,0x5d,0xea,0x32,0x8d,0xb1,0xa0,0x69,0x0d,0x19,0x30,0xa7,0x0d,0xb2,0xac,0x00}},
+    {{0x1d,0xe3,0xa7,0xe0,0x5a,0x65,0xd5,0x72,0xa5,0x3e,0x1b,0x48,0x60,0x80,0xec,0x88,0xc7,0xbf,0xea,0x32,0x23,0x3d,0x68,0x67,0x02,0x9b,0xdf,0x16,0xdc,0x7e,0x0b,0x40,0x01}},
+    {{0x1f,0x04,0xc8,0xd9,0x29,0xaf,0xe2,0xab,0x88,0x86,0x2d,0xc1,0x97,0x7c,0xbf,0x6c,0xde,0x39,0x87,0x39,0x87,0x1c,0x01,0x3a,0x8c,0x94,0xcb,0xa5,0xe7,0xed,0x80,0x59,0x01}},
+    {{0x20,0xab,0xf4,0x22,0x2d,0x1e,0x64,0x04,0xc5,0x43,0x31,0x4b,0x17,0x22,0x49,0xda,0xfa,0x43,0xfc,0xce,0xeb,0x24,0xda,0xfd,0x1c,0x25,0x06,0x94,0x6b,0x51,0x69,0x6b,0x01}},
+    {{0x22,0x49,0x3e,0xfe,0xe2,0x30,0x99,0xc1,0x93,0xf3,0xed,0x24,0xe9,0x4b,0xdc,0x67,0x55,0x88,0x73,0x3d,0x4c,0x9e,0xd3,0xb1,0x2c,0x87,0x15,0x15,0x78,0x74,0x67,0x87,0x01}},
+    {{0x22,0xdf,0x99,0x52,0x64,0x37,0x09,0xa7,0xe4,0x3f,0x14,0x11,0xf8,0x1b,0x81,0xbd,0x46,0xa5,0xf1,0xfc,0x01,0x62,0x25,0xe5,0xb8,0xc0,0xeb,0x07,0xba,0xbb,0x1a,0x1f,0x01}},
+    {{0x25,0x5b,0x87,0x76,0x56,0xef,0x17,0x74,0xb3,0x6d,0xcb,0xb1,0xdd,0x2a,0x20,0xd6,0x0a,0x20,0x4e,0x40,0xec,0xac,0x60,0xe2,0x3f,0x68,0x69,0x06,0xd7,0x91,0x9e,0x2e,0x01}},
+    {{0x25,0xf6,0x79,0xc3,0x8b,0x55,0x8f,0x49,0x38,0x65,0x6c,0x8b,0x08,0x8d,0xd0,0xe6,0xa3,0xc3,0x92,0x4b,0xac,0x45,0xc5,0x58,0x05,0x29,0xf8,0x47,0x97,0x0e,0x24,0x77,0x00}},
+    {{0x26,0x1b,0xd4,0x9a,0xec,0x6e,0x56,0x2e,0x82,0xdb,0x38,0x64,0x11,0xb1,0xb7,0x7f,0x34,0xd5,0xd4,0x28,0x32,0x7c,0x9b,0x38,0x17,0x4d,0x63,0xab,0x75,0xcb,0xca,0x3c,0x01}},
+    {{0x26,0xb8,0xf8,0x27,0x3a,0x72,0x0a,0xf1,0xd8,0x96,0xe6,0x30,0xda,0x7b,0xec,0x23,0xe8,0x11,0xbd,0x2c,0xea,0x2f,0xae,0x31,0x49,0x5c,0x70,0xd5,0x44,0x61,0xc7,0xce,0x00}},
+    {{0x27,0x3c,0x01,0x79,0xec,0x4a,0x98,0xc3,0x3a,0x31,0xdc,0xed,0x67,0x61,0x78,0xfe,0xd2,0x77,0xeb,0xee,0x99,0xcd,0x64,0x56,0x85,0x26,0x86,0xdf,0xa8,0x1e,0xd3,0x9a,0x00}},
+    {{0x27,0x73,0x1a,0xd1,0xdc,0x0a,0x76,0x26,0x68,0xc3,0x70,0x26,0x8a,0x94,0x1f,0xa4,0x9a,0x00,0x25,0xe9,0xe2,0xba,0x83,0x68,0xe7,0x3c,0xf0,0x23,0xb1,0xc8,0x2c,0xa1,0x00}},
+    {{0x2a,0x11,0xc1,0x07,0x51,0x02,0xfe,0x0e,0x32,0x7b,0x0b,0x13,0x70,0xdc,0x2e,0xd3,0xc1,0xf3,0x9e,0xf9,0x90,0xd7,0xdc,0xe0,0xa6,0x65,0x99,0xd0,0xba,0x2b,0x82,0x2d,0x00}},
+    {{0x2b,0x2e,0xeb,0x39,0xd7,0x03,0x14,0x43,0xf0,0xb8,0xe6,0x7a,0xaf,0x26,0x65,0x03,0x1b,0xa5,0xbc,0xf0,0xf0,0xad,0x67,0x50,0x71,0xf1,0x46,0x6a,0x2c,0x33,0x03,0x9c,0x00}},
+    {{0x2b,0x3c,0xae,0x47,0x99,0x67,0x8a,0xb6,0x27,0x96,0xf6,0xc9,0xce,0x62,0xf4,0x68,0x69,0xba,0xc3,0xc7,0x7d,0x02,0x3d,0xbf,0xac,0x9e,0xba,0x6e,0xae,0x11,0xac,0x56,0x01}},
+    {{0x2b,0xb6,0xc9,0x29,0xef,0x3e,0xdb,0xdf,0xa4,0xa7,0x3b,0x54,0xd6,0xbc,0xf4,0x27,0x0d,0xd4,0x21,0xad,0x83,0x22,0x9b,0xf1,0x77,0xaf,0x7f,0x14,0xdd,0x7f,0x1b,0x8f,0x01}},
+    {{0x2d,0x7d,0xda,0xbb,0x57,0xd0,0xd5,0x17,0xab,0x97,0xce,0x38,0xa9,0x34,0x15,0x0e,0xea,0x54,0xa1,0x22,0x6c,0xeb,0x52,0x1f,0x26,0x14,0x9c,0x3e,0x98,0x55,0x2c,0x06,0x00}},
+    {{0x2d,0x82,0x15,0x56,0x9a,0xfa,0xe6,0x22,0x2f,0xdc,0x3a,0x36,0x9c,0x5f,0xf1,0x8d,0x3b,0xa6,0xd8,0x8d,0x4f,0xc3,0x42,0x3e,0x33,0x6c,0xa9,0x5f,0x50,0x72,0x3e,0xc7,0x00}},
+    {{0x2e,0x1e,0x4e,0xb3,0xb3,0xb4,0x85,0x7e,0xe2,0xff,0x11,0x62,0x55,0x4d,0x78,0xdd,0x3e,0x51,0xcf,0xdf,0x81,0x33,0x6e,0x61,0x14,0x07,0x33,0xf9,0x25,0xb1,0x16,0x5e,0x00}},
+    {{0x2e,0x5d,0xe2,0x78,0x0a,0xf0,0x26,0x43,0xcf,0x44,0x62,0xc4,0xaa,0xb0,0x8e,0x19,0x3c,0x24,0x5c,0x3e,0x94,0x7c,0x82,0x1d,0x4f,0xbf,0x3b,0xd3,0x97,0x9a,0xaf,0x21,0x01}},
+    {{0x2f,0x25,0x8c,0xdb,0x0d,0x8c,0x23,0xd5,0x53,0x15,0xe8,0x7a,0x48,0xc2,0xfa,0x79,0xe3,0x53,0x8a,0x2d,0x16,0x56,0x78,0x36,0xbd,0xf9,0xb1,0xf8,0x8c,0xbc,0xbd,0x1d,0x00}},
+    {{0x31,0xb1,0xd8,0x70,0x21,0x57,0x6b,0xfa,0xdf,0x36,0xf3,0xfa,0x6e,0x7a,0x92,0x68,0x3e,0xc1,0x22,0x16,0x2f,0xed,0x79,0x73,0xe3,0x98,0x8b,0x9c,0xbe,0xe4,0x89,0x2d,0x01}},
+    {{0x34,0x49,0x5d,0xcf,0x2a,0x0e,0x6b,0xeb,0xa3,0x9a,0xc1,0x42,0x63,0xbb,0x2b,0xa3,0x8f,0xd4,0x3d,0x5d,0x36,0xc9,0x13,0xb6,0xe9,0xc5,0x1f,0x84,0x40,0x33,0x35,0x29,0x00}},
+    {{0x34,0x9e,0xa8,0xa5,0x14,0x3d,0xd9,0xef,0x70,0x0c,0x39,0xa2,0x15,0xf0,0x03,0xe1,0xc0,0x6e,0x9e,0x2f,0x18,0x4d,0x84,0x1d,0x8a,0xe7,0x29,0xb4,0x1a,0x7a,0x69,0xcb,0x00}},
+    {{0x37,0x79,0xfe,0xec,0x3e,0x26,0xd0,0x11,0xa3,0xa8,0x60,0x5e,0x89,0x80,0x28,0xd5,0x37,0x5e,0x3b,0x54,0x5d,0x2e,0xaa,0xe8,0xf7,0x6a,0x3d,0x95,0x21,0x77,0x05,0x2b,0x01}},
+    {{0x37,0xc9,0xcb,0x8f,0xf9,0xe2,0x14,0xb8,0xca,0xfe,0xf5,0x46,0xbe,0x50,0x78,0x0f,0xba,0x23,0x10,0x90,0xd6,0x9a,0xbd,0xc9,0xe4,0xd2,0xde,0xf5,0x92,0xa7,0xf4,0x87,0x00}},
+    {{0x39,0x6c,0x42,0xea,0x07,0xa4,0xe8,0xe8,0xfb,0xcf,0x90,0xe1,0x25,0x94,0x63,0xdd,0x1c,0xcc,0x76,0x7e,0x1d,0x13,0x5b,0xce,0xa9,0xa8,0x4b,0x2a,0xbb,0x3b,0x4c,0x5c,0x01}},
+    {{0x39,0x9b,0x0c,0xc8,0xcc,0xba,0xe7,0xe0,0x90,0x13,0x29,0x4f,0x45,0x72,0x59,0x46,0x19,0x61,0xf2,0xb1,0x7f,0xf3,0xde,0x7d,0x7b,0x6a,0x9d,0x66,0x92,0xfe,0xbc,0x2f,0x00}},
+    {{0x39,0xa2,0xbc,0x59,0xa1,0xb8,0xa7,0x91,0xe8,0xdc,0xe2,0x14,0x66,0x83,0x4d,0xf0,0xec,0x96,0xf5,0x26,0xef,0x53,0x9b,0xe5,0x33,0xca,0xd4,0xca,0x17,0x0b,0x74,0x5b,0x00}},
+    {{0x3a,0x06,0x7f,0x05,0x19,0x25,0x9c,0xfd,0x24,0x44,0x99,0x25,0x2b,0x80,0x38,0x4c,0x9f,0xab,0xc4,0xbf,0xaa,0x87,0x61,0x28,0x55,0xd8,0x1c,0x04,0x03,0xba,0x88,0x5f,0x01}},
+    {{0x3a,0x8a,0x9e,0x38,0x35,0x39,0x1f,0xad,0xe1,0x41,0xe9,0x73,0x18,0x67,0x1d,0xe9,0x54,0x4e,0x23,0xfc,0x1b,0x46,0x07,0x7b,0xe3,0x3c,0x40,0x95,0xf1,0xc3,0x86,0x97,0x01}},
+    {{0x3a,0xea,0x1e,0xfa,0x7e,0x2f,0xbf,0xdb,0x47,0x27,0x1d,0xac,0x83,0x29,0xf3,0xaf,0xfb,0xc1,0x0e,0x91,0x12,0x4a,0x27,0x39,0xd7,0x3a,0x75,0x03,0xff,0xce,0x9b,0xd7,0x00}},
+    {{0x3d,0x02,0xdc,0x23,0xae,0x3e,0xf9,0x45,0x32,0x31,0x7a,0xdc,0x33,0xeb,0x25,0xf8,0x3c,0x5f,0x68,0x14,0x50,0x6d,0x5b,0x8a,0x15,0xa3,0x7f,0x9f,0x80,0xa8,0xd6,0x97,0x01}},
+    {{0x3d,0x7c,0xef,0xbe,0xed,0x73,0x74,0x91,0xae,0x22,0x74,0xee,0xbb,0x25,0x49,0x88,0x7f,0x2f,0xc6,0x49,0x12,0xee,0xa6,0x54,0x43,0x54,0xaf,0x45,0x41,0xfc,0x49,0x5e,0x01}},
+    {{0x3f,0x1e,0x6d,0xca,0x71,0x25,0x08,0xc4,0xde,0x3d,0x14,0x1d,0x3a,0xe2,0xe5,0xf7,0xb3,0xb6,0x5a,0xee,0x8f,0x73,0xc7,0x35,0x73,0xdf,0x55,0x8e,0x67,0x54,0x4e,0xd5,0x00}},
+    {{0x3f,0x32,0x60,0x56,0x8a,0xe6,0xcb,0xcd,0x1a,0x5e,0x10,0x3f,0x2e,0x20,0xfb,0x8a,0xb6,0x54,0x3e,0x05,0xf2,0x57,0x3b,0xa5,0xe7,0x3b,0x82,0x63,0x01,0x48,0x71,0x65,0x00}},
+    {{0x40,0xc7,0x1a,0x8f,0x88,0xae,0x86,0xc9,0xae,0x31,0xd0,0x1d,0x1d,0xd5,0xa9,0x03,0xb1,0x81,0xff,0x2b,0xa0,0xd3,0x27,0x7a,0x77,0x45,0x75,0x79,0x4f,0xe1,0x77,0xd6,0x00}},
+    {{0x42,0x10,0xc1,0xca,0x0f,0x6e,0x01,0x22,0x38,0xe9,0x99,0x7f,0xb1,0xbd,0x69,0x4a,0x05,0x15,0xaa,0xf3,0x6b,0x7c,0x93,0x28,0x01,0x9c,0xb9,0x18,0xc0,0x66,0xf7,0x30,0x01}},
+    {{0x43,0x61,0x37,0x24,0x4b,0x96,0xbf,0x04,0xa4,0xd9,0xd7,0xea,0xc8,0xcb,0x75,0x1f,0x99,0xa2,0x43,0x6e,0x32,0xf0,0x8b,0xca,0x22,0xce,0x85,0x6b,0x4f,0x2f,0x2a,0x96,0x00}},
+    {{0x43,0xc5,0xfc,0x34,0xb7,0xfe,0xfc,0x12,0x9a,0x7e,0x2b,0xb0,0x9a,0x96,0xdd,0x68,0x62,0x19,0x26,0xd4,0x1e,0xba,0xe1,0x4c,0x03,0x55,0x13,0x16,0xb4,0x9a,0xd3,0x22,0x01}},
+    {{0x44,0xc3,0x5a,0x43,0x82,0xe2,0xf9,0x8d,0x39,0x23,0x9a,0x7f,0xca,0x16,0xde,0x0f,0x2b,0x07,0x33,0x15,0x95,0x40,0x8f,0xe7,0x0f,0x77,0xde,0x24,0x31,0x7c,0xe3,0x83,0x01}},
+    {{0x45,0x36,0x66,0x89,0xe3,0x0c,0x5f,0x7b,0x39,0x7d,0x38,0xd9,0x80,0xda,0x42,0x20,0x1b,0xd2,0xdb,0xef,0xd7,0x25,0xea,0xea,0x9a,0xaf,0x64,0x3d,0xcc,0xa2,0xf9,0x4f,0x01}},
+    {{0x45,0x38,0xb1,0x28,0x3e,0x7e,0x09,0x5a,0x27,0x4c,0xdf,0xbe,0xe7,0x81,0x89,0x4b,0xe9,0xac,0x49,0x71,0x8c,0x1a,0x48,0xca,0x3e,0x72,0x8a,0x7b,0x44,0xff,0xd6,0x6c,0x00}},
+    {{0x45,0xda,0x72,0xd3,0x42,0x41,0xdf,0xaa,0xb3,0x06,0x5a,0x03,0xd3,0x0d,0x8d,0x97,0xa1,0xdc,0xa1,0xcd,0x4b,0x14,0x97,0x79,0xe0,0x4e,0x14,0x04,0x18,0x20,0xe5,0xf8,0x00}},
+    {{0x46,0x99,0x64,0x19,0xd1,0x3e,0xac,0x26,0x2c,0x08,0xad,0xc6,0x47,0x7a,0xd4,0xae,0x9f,0x5c,0xcd,0x7e,0xae,0x51,0x2f,0x77,0xe2,0x9b,0xa3,0x22,0xd4,0x49,0x86,0xb8,0x00}},
+    {{0x46,0xa4,0x6e,0xab,0x36,0xaa,0x3c,0x12,0xc3,0xeb,0xdd,0x8a,0x22,0x61,0x99,0xa5,0x4f,0x76,0xb8,0xc1,0x12,0x97,0x66,0x36,0x28,0x4c,0x12,0x29,0x08,0x06,0x54,0xd4,0x00}},
+    {{0x47,0x55,0x78,0x8f,0x9f,0xfa,0x3f,0xe0,0x29,0x36,0xb0,0xc1,0x53,0x1e,0xa1,0x8e,0xb0,0xea,0x2b,0xbb,0xe0,0xb2,0x50,0x80,0x6b,0x34,0xd5,0xb2,0x91,0xee,0xb0,0x3b,0x00}},
+    {{0x47,0x85,0x26,0xc2,0xfe,0xe4,0x25,0xc3,0xd4,0x76,0xbd,0x5b,0x05,0xb7,0xdb,0xa7,0x8d,0x88,0xed,0x47,0x81,0x02,0x9c,0x87,0xd6,0xb5,0x5b,0x5b,0xc5,0x99,0x44,0x67,0x01}},
+    {{0x47,0xab,0x7a,0x22,0x2f,0x7c,0x34,0x3b,0x93,0xfe,0x2f,0xe8,0x69,0x16,0x2a,0x0b,0xa5,0x1c,0xdc,0xa2,0xe2,0xde,0x30,0x92,0xb0,0x7e,0xd8,0x24,0xd7,0xf1,0xa4,0x1c,0x00}},
+    {{0x48,0x4a,0x5c,0xd9,0x29,0x76,0x6f,0x9f,0x78,0x9e,0x6b,0x75,0x03,0xde,0x85,0xf0,0x0f,0x8c,0x9f,0x2a,0x39,0x5c,0x50,0x4f,0x40,0xeb,0xdb,0xfd,0xc9,0xc7,0xba,0x96,0x00}},
+    {{0x48,0x68,0x39,0x64,0x84,0x6e,0x84,0xa7,0x9b,0x4c,0xb3,0x3e,0x6f,0x84,0x89,0x00,0x80,0xcc,0xdf,0xfe,0x54,0xf2,0x81,0x7c,0x7e,0x8e,0x46,0xcc,0xc3,0x5c,0x39,0x07,0x00}},
+    {{0x48,0x9c,0x86,0xa1,0x3b,0x28,0xed,0x87,0xf5,0x1f,0x68,0xa9,0xcf,0xe9,0xd3,0xf6,0xb6,0x73,0xa4,0x48,0x81,0xe7,0x25,0xe1,0x18,0x17,0x88,0x91,0x5e,0x94,0xaa,0xde,0x00}},
+    {{0x49,0x0e,0x56,0xb0,0x44,0xad,0x0e,0xda,0xab,0xb9,0x75,0xfa,0x59,0xb4,0x9c,0x53,0xc5,0xf4,0x18,0x6c,0x5d,0x22,0x22,0x1f,0x7b,0x15,0x52,0x0a,0x03,0xfa,0x09,0x0c,0x01}},
+    {{0x4a,0x10,0xee,0x3f,0x36,0x22,0xef,0x4b,0xa7,0xc4,0x3e,0x39,0xab,0x33,0xe8,0xed,0xc6,0xa4,0x47,0xa6,0x56,0xca,0x72,0xd9,0x90,0x81,0x99,0xa9,0xa3,0xd6,0xbe,0x72,0x00}},
+    {{0x4a,0x94,0x42,0x7b,0xbd,0x6c,0x62,0x8e,0xa7,0x2b,0x61,0x9b,0x31,0x7e,0xfb,0x99,0xd0,0x47,0x8a,0x07,0x8b,0xf4,0x70,0x90,0x1f,0xc2,0xd5,0x8d,0x17,0x62,0xa2,0xab,0x00}},
+    {{0x4b,0x24,0x70,0xdb,0xbc,0xfd,0x84,0xeb,0x23,0x39,0xba,0xac,0x58,0x91,0x23,0xf7,0xe4,0x65,0xe2,0x72,0x6e,0x9d,0x85,0x93,0x2e,0x0e,0xef,0x1a,0x15,0x33,0x06,0x12,0x01}},
+    {{0x4b,0x7e,0xc5,0x70,0x48,0x2f,0x9c,0xb0,0x1a,0x22,0x77,0x1d,0x44,0x0a,0x6d,0x03,0x84,0x7b,0x65,0x6b,0x84,0x0c,0xc9,0xd7,0xdb,0x59,0x4a,0x0b,0x1e,0xbd,0x4d,0xf5,0x00}},
+    {{0x4b,0xfe,0x26,0xbc,0x62,0x5e,0xe9,0xf6,0x3e,0x22,0xdf,0x71,0xf0,0xc7,0x61,0x4f,0xf3,0xe2,0x74,0xb4,0x19,0xa7,0x47,0x10,0x29,0x8d,0x04,0x63,0x75,0xf1,0x5b,0xe2,0x00}},
+    {{0x4c,0x31,0x0e,0x39,0x05,0x6c,0xfc,0x84,0x8a,0x0c,0x51,0xb2,0xe2,0x2f,0xbb,0xd1,0xdd,0x1e,0xe4,0xac,0xba,0xa9,0x0b,0xac,0x1a,0x7b,0x85,0x38,0xaf,0x45,0x34,0x8c,0x00}},
+    {{0x4d,0xd8,0x3a,0x82,0x08,0xdb,0x7d,0xdd,0xc6,0xc9,0x54,0x3c,0x62,0xd5,0x44,0x3f,0xfa,0x28,0x59,0x42,0x1f,0xb2,0xe4,0x6f,0xab,0x0b,0xc0,0x26,0x33,0xa9,0x1c,0x9e,0x00}},
+    {{0x4e,0x28,0x16,0x05,0xd9,0x77,0x74,0xd7,0x45,0xd6,0x87,0xf6,0xbf,0xbb,0x2c,0xf7,0x8c,0xe6,0x4e,0xb6,0x22,0x74,0x6d,0xc1,0xa4,0x2f,0xce,0xc1,0x81,0x69,0x01,0x0d,0x01}},
+    {{0x4e,0x71,0xa9,0x71,0x02,0xa8,0x54,0x9b,0xb8,0xdf,0xd7,0x70,0xe9,0xdc,0x37,0xd4,0x38,0x8c,0x29,0xd7,0x87,0xfa,0xa8,0x7a,0x0e,0xcd,0x4e,0x0f,0x8a,0x2b,0xef,0x8a,0x01}},
+    {{0x4e,0xa3,0xd0,0x4f,0xa2,0x3d,0xdf,0x61,0xce,0x4b,0xcd,0x02,0x09,0xa4,0x84,0xe8,0x5c,0xa4,0xd6,0xb0,0x16,0x38,0x19,0x70,0xea,0x0b,0x8e,0x40,0xec,0xc5,0x20,0x6a,0x01}},
+    {{0x4f,0x0c,0xe0,0xb1,0x3f,0xf4,0x22,0x80,0xe6,0xc5,0x37,0x02,0x43,0xcf,0x7c,0x22,0x46,0x8a,0x4e,0x70,0x35,0xef,0x2f,0x57,0x47,0xa7,0xa5,0x9a,0x81,0x13,0xce,0x51,0x00}},
+    {{0x4f,0x13,0xf6,0x17,0x4b,0x4a,0x2d,0x64,0xc9,0x2c,0x60,0x96,0x7b,0xec,0x66,0xfe,0xe7,0x23,0xb8,0x4c,0x50,0x06,0xbc,0x60,0xa3,0x49,0x7a,0x4d,0xbc,0x34,0x2e,0xe3,0x00}},
+    {{0x4f,0x53,0x65,0x87,0xb0,0xd4,0xcf,0x9a,0xf8,0x67,0x47,0x16,0x24,0xe0,0xea,0x80,0x76,0xda,0x0a,0x83,0xe9,0x8a,0xbe,0x3a,0x75,0x21,0xe0,0xdf,0xde,0xc5,0x42,0x77,0x01}},
+    {{0x50,0xed,0x4b,0xbb,0x7e,0xf1,0x8d,0x38,0x2d,0x5e,0xf9,0xed,0x78,0xad,0xe4,0x2b,0xc0,0xfa,0x03,0xa6,0x22,0x56,0x8b,0x66,0xdf,0x8a,0x99,0xc9,0xb5,0xd4,0xed,0x30,0x01}},
+    {{0x52,0x88,0xcd,0xd5,0x31,0xac,0x31,0x4d,0xb5,0xf3,0xee,0xa2,0x28,0xde,0x1b,0x3b,0x0a,0x05,0xab,0xb3,0x1f,0x3a,0x6b,0x54,0xce,0x4e,0x23,0x99,0x9e,0xe9,0x51,0x61,0x00}},
+    {{0x52,0xb8,0x13,0x57,0xba,0x67,0xec,0xcf,0x13,0xb4,0xfc,0x9b,0xca,0x6d,0x11,0x07,0x28,0xcb,0xaf,0x79,0x87,0x71,0x31,0xd2,0x1d,0x43,0xa1,0xba,0x2f,0xbc,0x9e,0x54,0x01}},
+    {{0x53,0x48,0x1a,0xfa,0xc7,0x2b,0x70,0x07,0x84,0x61,0x5c,0x55,0x5c,0x64,0xb3,0xe4,0x33,0xba,0x31,0x9c,0x65,0x09,0xa6,0xaa,0xa5,0x33,0x1d,0x3e,0x3d,0x23,0x7e,0x6f,0x00}},
+    {{0x53,0xe5,0x3e,0x87,0x15,0x2f,0x24,0xca,0xda,0x1c,0x0a,0x22,0x25,0x2f,0xe8,0x88,0xe7,0xf6,0x19,0xa0,0x1d,0xbd,0xb8,0xa3,0xd7,0x42,0x2a,0x68,0x0c,0xb9,0x7a,0x01,0x00}},
+    {{0x54,0x8a,0xbe,0x5a,0x54,0xbe,0x65,0xac,0xc4,0x3d,0x1d,0x66,0xc8,0xf8,0x81,0x62,0xd0,0x7a,0xe6,0xb7,0x52,0xbb,0x36,0x36,0xbc,0x63,0xbb,0x91,0x4b,0x5d,0x77,0x94,0x01}},
+    {{0x57,0x5e,0x5a,0x8e,0xa8,0x20,0x3e,0x37,0x87,0xa5,0xeb,0x50,0x41,0xe1,0x66,0xd6,0x89,0xfe,0xd2,0xeb,0x6a,0x0c,0x2d,0x12,0xce,0xa1,0x68,0x07,0x6f,0x05,0x50,0x7e,0x01}},
+    {{0x57,0xaf,0x87,0x8b,0xc6,0x31,0x87,0xf0,0xe4,0xb2,0xa9,0x28,0x1b,0x3f,0xe4,0xad,0xe8,0x25,0x2d,0xdf,0xf5,0x4a,0xe9,0x52,0x41,0x04,0x9d,0x28,0xa1,0x70,0x16,0xce,0x00}},
+    {{0x58,0x69,0xf4,0xa6,0x74,0x24,0xa4,0x8f,0x29,0x1c,0x1a,0xbb,0x19,0x16,0xf0,0xcd,0x68,0x9f,0x20,0x3b,0xb1,0x8f,0x47,0x31,0x3b,0x85,0x74,0x01,0x76,0x69,0x5f,0x89,0x00}},
+    {{0x58,0xe3,0x0f,0x89,0xca,0xfb,0xf4,0xb8,0xa6,0x2d,0x5f,0x45,0x21,0x70,0xf0,0x8c,0x0c,0xb9,0x7e,0x20,0xb7,0xaf,0xa5,0x63,0x06,0x96,0x39,0xa7,0xa4,0xd7,0xce,0xc1,0x00}},
+    {{0x59,0xe9,0x38,0x92,0xe7,0xca,0x9b,0xf7,0x55,0xaf,0x63,0x0a,0xb4,0x37,0xcb,0xc6,0x33,0x1b,0xda,0x90,0x78,0xbe,0x01,0x01,0x53,0x3e,0xa5,0x09,0x3a,0x72,0xe6,0x78,0x01}},
+    {{0x5b,0x8a,0x28,0xd8,0xe5,0xac,0x40,0x1c,0xd1,0xca,0x85,0xb5,0xf5,0x63,0x8a,0x7e,0x3b,0x09,0xb9,0xb1,0xc7,0x09,0x8d,0x8f,0xdd,0xa5,0xf5,0x65,0x5f,0xf2,0x62,0x54,0x00}},
+    {{0x5c,0x57,0xf6,0xcd,0xd3,0x2c,0x09,0xd5,0x69,0x42,0xd1,0x08,0x96,0x30,0xaf,0xc2,0x18,0xa2,0x96,0x6e,0x53,0x0b,0xdd,0xa5,0x8e,0x0d,0xfa,0x37,0x58,0x68,0xd9,0x93,0x01}},
+    {{0x5c,0xd6,0xef,0xf6,0x8a,0xf3,0xf9,0x02,0x6f,0x6c,0x6a,0xa4,0xd4,0x33,0x48,0x2a,0x95,0x12,0xb6,0x16,0xc3,0x64,0xbd,0x46,0x30,0x6b,0x9a,0x6c,0xae,0x22,0xad,0x66,0x01}},
+    {{0x5e,0x54,0xfc,0x39,0x9d,0xe3,0xb9,0x13,0xa7,0x3e,0x03,0xbd,0x54,0x58,0x10,0xe4,0x91,0xc5,0x12,0x9d,0x01,0x67,0x6c,0x52,0x70,0x96,0x5c,0xfd,0x95,0x7b,0xc3,0xf4,0x00}},
+    {{0x5e,0xde,0x1e,0xd0,0xfc,0x13,0x85,0xd3,0xe1,0xbc,0x16,0xec,0xb9,0x2d,0x8e,0xcd,0x3d,0xa6,0x7f,0x89,0x62,0x7a,0x84,0xe5,0x71,0x7f,0x45,0x2f,0x86,0x3c,0x3d,0x60,0x00}},
+    {{0x5f,0x94,0x51,0x61,0xf6,0xcc,0x72,0x0f,0x87,0xb2,0x73,0xaa,0x68,0x93,0xb7,0x17,0xb3,0x25,0x3a,0x05,0x78,0xdc,0x1d,0x5f,0xcc,0xe4,0x82,0x31,0x4a,0x24,0xc0,0x6d,0x01}},
+    {{0x5f,0xac,0x04,0x04,0x75,0x62,0x69,0x93,0xe3,0x92,0xdc,0x1b,0x82,0xe1,0x4d,0x36,0x02,0xdc,0xa8,0xf4,0x59,0xe6,0x5e,0xc0,0x73,0x59,0x10,0xa2,0x72,0x37,0x96,0x42,0x01}},
+    {{0x5f,0xfc,0x08,0xf8,0x4f,0x88,0xba,0xf3,0x73,0x9c,0x21,0x5f,0xfe,0x4d,0x41,0x2b,0xce,0x37,0x13,0xbe,0x8d,0xf5,0xd8,0x80,0x29,0xc7,0x23,0x2e,0xb0,0x9b,0xad,0x2b,0x01}},
+    {{0x61,0xc4,0x18,0x40,0x87,0x9f,0xc8,0xcb,0xc4,0x45,0x4e,0x02,0x28,0x58,0xb4,0xe2,0xe3,0xde,0xee,0x33,0xe1,0x87,0xc4,0xd6,0xbb,0x22,0x48,0xb6,0xc9,0x2d,0x5a,0x2a,0x01}},
+    {{0x64,0xa6,0x44,0x4c,0x1a,0xe3,0xe9,0xea,0xa4,0x2e,0x84,0x4f,0xd4,0x33,0x24,0x3a,0x37,0x43,0x98,0xc7,0x90,0xbb,0xb4,0x5a,0x86,0x51,0xf7,0x27,0xe9,0xce,0xb8,0x5d,0x00}},
+    {{0x65,0x01,0x5b,0x17,0x35,0xf0,0x79,0xdb,0x4e,0x37,0x67,0x9c,0x82,0xe6,0x81,0x56,0xae,0x8e,0x5b,0x9d,0xf8,0x55,0x0e,0xf4,0x3c,0x64,0x92,0x67,0xfa,0x5e,0xa2,0x5e,0x01}},
+    {{0x66,0x83,0x7a,0x33,0xc2,0x24,0x21,0x23,0x3a,0x1d,0x51,0xe9,0x3d,0xb8,0x6a,0x1f,0x17,0x7d,0xd0,0x7d,0x17,0x15,0xf8,0x9b,0x76,0xe7,0xd6,0x52,0x3f,0x9d,0x71,0xe5,0x00}},
+    {{0x66,0x99,0x88,0x49,0xe3,0x60,0x02,0xc2,0xfd,0x55,0xb4,0xd2,0x70,0x47,0x5f,0x42,0x1c,0xb1,0xd3,0xf1,0x50,0xa0,0x65,0x40,0x38,0x8f,0x05,0xbd,0x82,0x93,0xff,0x8e,0x00}},
+    {{0x67,0x17,0x65,0x59,0x5a,0xec,0xd8,0xb4,0x49,0xad,0x40,0x9d,0xce,0xdc,0xee,0x14,0xfb,0xa6,0x6b,0x04,0x46,0xd7,0x31,0xab,0x65,0x21,0x2f,0x96,0xc6,0x26,0x4f,0x0a,0x00}},
+    {{0x67,0x33,0xc5,0x64,0xf4,0xe1,0xb5,0xd6,0x26,0xca,0xbc,0x16,0x76,0x33,0x34,0xb1,0x9e,0x90,0x21,0x33,0xde,0x14,0x6c,0x9a,0xe3,0xbe,0xd6,0x96,0xca,0x11,0x3c,0x92,0x00}},
+    {{0x67,0xb7,0xe4,0x97,0x10,0xf6,0x38,0x86,0xe3,0xc7,0x0c,0x65,0x63,0x1a,0x19,0x4e,0x54,0x33,0x80,0x6f,0x4f,0xd3,0x11,0xed,0x71,0x23,0xfa,0x27,0xb9,0x1b,0x3a,0xca,0x00}},
+    {{0x6a,0x2f,0x22,0x83,0x89,0xfb,0x12,0x1f,0x34,0xb7,0x9d,0xcd,0x7e,0x9e,0x21,0x5d,0x3c,0x44,0xc5,0x87,0x83,0xfa,0x65,0xfc,0xa3,0x89,0x39,0x32,0x48,0x00,0x8a,0xca,0x00}},
+    {{0x6a,0xa9,0x35,0x1e,0xc9,0x30,0x8e,0x6a,0xb0,0xa8,0x97,0xdf,0x06,0xd9,0x44,0xed,0x7e,0x14,0x23,0xbd,0x45,0x7b,0xb1,0xc6,0xd1,0x3a,0x69,0xd8,0x08,0x54,0xfd,0x90,0x00}},
+    {{0x6a,0xd4,0xaa,0x1a,0x46,0x94,0x2d,0xa4,0x73,0xdc,0x08,0x7f,0x81,0x66,0x5b,0xfe,0x4a,0x50,0xe2,0x18,0x28,0x8c,0x0d,0x0f,0x58,0x6f,0x1f,0x3f,0xca,0xe8,0x48,0xd7,0x00}},
+    {{0x6c,0x4b,0xb3,0x29,0x4d,0xe2,0x21,0x9d,0xe0,0xc3,0x37,0x0e,0x85,0x95,0xe1,0x5c,0xb3,0x9b,0xb7,0x61,0xc3,0x00,0xd2,0xa7,0x01,0xc6,0x0f,0x21,0x2f,0xac,0x01,0x08,0x00}},
+    {{0x6d,0xf4,0x60,0xee,0x63,0x6b,0xa0,0xa2,0xb0,0xb7,0xf3,0x0e,0x68,0x88,0xa5,0x68,0xb0,0x66,0x5c,0x9f,0xd3,0x60,0x32,0xec,0x05,0x2c,0x2f,0x0c,0x17,0x39,0x2b,0x09,0x00}},
+    {{0x6e,0xb2,0x0f,0x55,0x77,0x1f,0x05,0x10,0x75,0x44,0xec,0xac,0x76,0x78,0x0e,0xd7,0xd6,0xb1,0xde,0x47,0x18,0x54,0xc8,0x79,0x60,0x80,0x4b,0x43,0x3f,0x8b,0x6c,0x52,0x01}},
+    {{0x6f,0x3d,0x07,0x2a,0xeb,0x2a,0x1b,0xfb,0x39,0x6f,0xbd,0x70,0xfc,0x70,0x65,0xaf,0x04,0xfa,0x06,0x67,0x9f,0x09,0x9e,0x9a,0x8f,0x82,0x73,0xab,0x87,0xbe,0xaa,0x63,0x00}},
+    {{0x70,0xf2,0x42,0x94,0x92,0xbb,0x16,0xec,0x9b,0x04,0x4f,0xa1,0xe5,0x49,0xd9,0xcd,0x61,0xfe,0x82,0x47,0x52,0x47,0xec,0xbe,0x91,0x3b,0xcd,0xa8,0x7b,0xf2,0x86,0x55,0x00}},
+    {{0x71,0xf0,0xa0,0xa2,0x5d,0x9f,0x13,0x67,0x3b,0xa9,0xbd,0x70,0x15,0xca,0xd9,0x74,0x2a,0xec,0x8f,0x88,0xc8,0xcd,0x99,0x59,0x9e,0x5d,0x98,0xb7,0xf8,0xd3,0x96,0xb6,0x00}},
+    {{0x72,0x07,0xb9,0x32,0x1e,0xfe,0xf8,0x83,0xb5,0x8c,0x7d,0xf4,0x1d,0xc1,0x88,0xfc,0xa0,0xc1,0xfe,0x40,0x7f,0xa1,0xa1,0xeb,0x6e,0x35,0xce,0x96,0xdf,0x77,0x98,0x2b,0x00}},
+    {{0x72,0x63,0xac,0xe8,0xbe,0xc9,0x78,0x54,0x3b,0x03,0x5c,0xca,0xcb,0x8d,0x3e,0x85,0x1a,0xb7,0x38,0x63,0x0b,0xb3,0xf4,0x5c,0x29,0x96,0x1e,0xd0,0x93,0xfa,0xac,0x82,0x00}},
+    {{0x72,0xda,0xd6,0x35,0x64,0x3b,0xdf,0x87,0x7a,0x58,0xe5,0xa4,0x00,0xbc,0xa1,0xe9,0xe1,0x5a,0x86,0x6c,0xe8,0x3f,0xc1,0xbd,0xec,0x4c,0xc7,0x23,0x7d,0x30,0xd0,0x0e,0x01}},
+    {{0x73,0x06,0x02,0xf0,0x8e,0xd3,0x02,0x2b,0x6e,0x15,0x9c,0xb9,0x04,0x2a,0xcc,0x0a,0x69,0xe8,0xc4,0x03,0x57,0x62,0x5f,0x0a,0x90,0xad,0xa0,0xf7,0x54,0x9d,0xa0,0xe7,0x00}},
+    {{0x73,0xd1,0xb4,0x0a,0x12,0x67,0x56,0xeb,0xc4,0x71,0x01,0x7c,0x6d,0x14,0x95,0x0a,0x4f,0x5b,0x15,0x35,0x46,0x24,0x71,0xa8,0xb6,0x32,0xcc,0xbb,0xcf,0x5d,0x07,0x07,0x00}},
+    {{0x74,0x12,0x1f,0x2e,0xf1,0xdf,0x96,0x02,0x7f,0x27,0xbc,0xbb,0xad,0x69,0x48,0x51,0x03,0x96,0x8c,0xaf,0x17,0x67,0xbf,0x77,0xe9,0xae,0x92,0xf5,0x03,0xd3,0x03,0x00,0x01}},
+    {{0x74,0xb2,0x6c,0x21,0xda,0xa1,0x3f,0x9c,0xd6,0xfc,0xe0,0x4c,0x50,0x6a,0xd7,0x0c,0x8d,0x6d,0x4a,0xbb,0xb4,0x8f,0xa6,0xf9,0x64,0x9c,0x15,0xee,0x8c,0xf1,0xf7,0x99,0x00}},
+    {{0x75,0xc9,0xcc,0x00,0x17,0xe5,0x06,0x61,0xf7,0xa5,0x8b,0x9a,0x1a,0x9d,0xcf,0x5b,0xb6,0x58,0x01,0xbc,0xb4,0x74,0x30,0x53,0xa7,0xfd,0x41,0x24,0x26,0xec,0x5d,0x11,0x00}},
+    {{0x76,0x3b,0x9c,0x0f,0x20,0x6a,0x28,0xb3,0xad,0x3f,0x99,0xeb,0xa4,0x67,0x98,0xb8,0xc4,0xd9,0x75,0xdf,0x90,0xaf,0x2c,0x91,0x09,0xfc,0x0b,0x9d,0xca,0x51,0xbd,0x3e,0x00}},
+    {{0x77,0x41,0x03,0x1d,0xf9,0xc1,0xaa,0x51,0x13,0x56,0x63,0xc0,0x2b,0x07,0x87,0x23,0xff,0x33,0xa1,0xc2,0x33,0xd1,0xc7,0x2f,0xef,0xcd,0x97,0x48,0x19,0x75,0x0a,0x7c,0x01}},
+    {{0x78,0x2b,0x6d,0x1b,0x3e,0x1b,0x03,0xd0,0x40,0xa8,0x02,0x63,0x3b,0x7b,0x5d,0xb4,0xf2,0xc7,0xd1,0x27,0x4d,0x34,0x52,0x82,0xb7,0x73,0xbe,0xf5,0x3c,0x49,0x0f,0x15,0x00}},
+    {{0x78,0x51,0xb6,0x3a,0x98,0xba,0x9e,0xc4,0x25,0xbf,0xdd,0x9d,0xa3,0x44,0x1f,0x5c,0xe4,0x4a,0x3f,0xe6,0xa1,0x2a,0x90,0x05,0xbd,0xf4,0xa8,0xad,0xdc,0x8a,0xb9,0x44,0x00}},
+    {{0x78,0xab,0x0b,0xd0,0x23,0xec,0xb5,0x89,0x1c,0xa8,0x9a,0x0e,0x8f,0xbd,0x68,0x68,0x83,0x60,0xc2,0xde,0xb7,0x99,0xd3,0x49,0x6a,0x40,0x04,0x9e,0xe5,0x14,0x01,0x28,0x00}},
+    {{0x7b,0x55,0x5c,0x64,0xb4,0x34,0x8e,0xb0,0x47,0x5c,0xab,0xe7,0x0a,0x6f,0x28,0x5c,0x8c,0xcb,0xab,0x29,0x56,0x01,0x78,0x33,0x33,0x16,0x88,0x54,0x49,0xc1,0xb4,0x3f,0x00}},
+    {{0x7b,0x9e,0xef,0xd0,0xdd,0x64,0x6e,0x74,0xba,0x65,0xfb,0x61,0x34,0x90,0x33,0x39,0x38,0x71,0x86,0x4a,0xbb,0x87,0xb3,0xec,0x9c,0xb3,0x08,0xa2,0x51,0x83,0xa2,0xbd,0x00}},
+    {{0x7b,0xd0,0x16,0xaf,0x7d,0xfa,0xf8,0x3a,0xd0,0xd1,0xf0,0xf3,0x53,0x57,0x80,0x4d,0x5c,0x89,0x33,0x24,0x4a,0xc5,0x23,0xe2,0x78,0xf2,0x47,0xd3,0xb3,0x1d,0xd4,0x9c,0x00}},
+    {{0x7c,0x40,0x3c,0x77,0x26,0x07,0x47,0x3d,0xcb,0xb2,0x83,0x87,0xc6,0x9f,0x62,0x63,0xe7,0x08,0x15,0xc0,0x83,0x93,0xc6,0xd2,0x31,0x30,0x34,0xe0,0x83,0x8c,0xe1,0x15,0x00}},
+    {{0x7c,0x44,0x50,0x34,0x45,0x14,0x42,0x2e,0xe7,0x5b,0xec,0x1e,0x8e,0xe7,0x5b,0xcf,0x0e,0x39,0xa5,0x05,0xb3,0x5d,0x2a,0x1a,0xd6,0xde,0x74,0x2b,0x03,0x1b,0x9c,0x05,0x01}},
+    {{0x7c,0x80,0xab,0xe6,0x8b,0x91,0xe9,0x73,0xfa,0xed,0x6a,0x07,0x6f,0x93,0xe6,0xe5,0x75,0xbf,0x67,0xf6,0x1c,0x18,0xc9,0xac,0x03,0x08,0x9a,0x72,0xa6,0x1d,0xf6,0xa9,0x00}},
+    {{0x7d,0x1a,0x92,0x1a,0x5a,0xae,0xa7,0x11,0x2f,0xe4,0x1c,0xdf,0xc3,0x60,0xe0,0x90,0xbf,0xdf,0x60,0x19,0x56,0xe3,0x95,0xd8,0x6d,0x71,0x53,0x5c,0x7d,0x2c,0xa1,0x63,0x00}},
+    {{0x7f,0x52,0xfd,0x0e,0xd6,0xb1,0xd7,0x18,0x9e,0x9f,0x5f,0x38,0x58,0x42,0x45,0xbc,0x80,0x69,0xcc,0xc6,0xc5,0xa6,0x29,0xd9,0x00,0xca,0x31,0x77,0xa2,0x81,0x09,0x39,0x01}},
+    {{0x7f,0xe5,0x59,0xb6,0x95,0x24,0x06,0xa9,0x15,0x3a,0x20,0x8d,0x15,0x21,0x0d,0x6c,0x27,0xb0,0x0c,0xed,0xba,0xfe,0x3b,0x44,0xac,0x29,0x5b,0x4d,0xf7,0x13,0x52,0x87,0x00}},
+    {{0x80,0xae,0x07,0x52,0xed,0x8b,0x5f,0xfd,0xd1,0x96,0x33,0xc1,0x8c,0xeb,0x4c,0x98,0x9f,0x31,0x5b,0x68,0x02,0x9b,0xc9,0xfb,0xb2,0xcd,0x77,0xb9,0x98,0xa3,0x22,0x47,0x01}},
+    {{0x81,0xb7,0x04,0xba,0x2f,0x7b,0x7f,0x85,0xc6,0xc3,0x40,0x57,0x13,0xac,0x7d,0xc7,0xcf,0x5f,0x43,0x2b,0x86,0x48,0x41,0xa8,0x4a,0x4a,0x75,0x24,0x13,0xb5,0x2a,0xc7,0x00}},
+    {{0x82,0xf1,0x04,0x5f,0x97,0x8e,0x97,0x57,0xfb,0x4d,0x8d,0xc5,0xf1,0x12,0xb0,0x1d,0x87,0x62,0xe8,0xe3,0x56,0xe9,0x95,0x78,0x98,0xff,0xe0,0xc8,0xcc,0xd9,0xec,0x3b,0x01}},
+    {{0x83,0x91,0x3e,0x95,0x51,0xcb,0x8c,0xdf,0x9b,0x9a,0xce,0x2f,0x10,0x23,0x39,0x12,0xa5,0xe9,0xd9,0x47,0x46,0x48,0xae,0x41,0x95,0x80,0x71,0x0d,0xe5,0x7e,0x57,0xdb,0x00}},
+    {{0x84,0x8b,0xa0,0xed,0x83,0xdd,0x57,0x10,0x89,0x2b,0x0f,0x42,0x8c,0x94,0x62,0x3b,0x89,0xe3,0x2f,0x5f,0x9e,0x99,0x37,0x84,0x5c,0x88,0x22,0x9a,0x36,0x5d,0x03,0xb1,0x00}},
+    {{0x84,0xdc,0xcd,0xea,0xa1,0xee,0xa0,0xc9,0xe6,0x38,0xcd,0x19,0x66,0xf2,0xdf,0x12,0xe8,0x0a,0x8a,0x52,0x29,0xd8,0xf3,0xc4,0xcf,0xea,0x56,0xbb,0x68,0xc8,0xc9,0x00,0x00}},
+    {{0x85,0xe4,0xc4,0x58,0xbd,0x22,0x59,0xe2,0x51,0x2d,0x25,0x6d,0x7c,0x0f,0x70,0xd5,0xf4,0x41,0xaf,0xfd,0x90,0x7c,0x55,0xf2,0x37,0x38,0xbe,0xbe,0x31,0xb0,0x0c,0x45,0x01}},
+    {{0x86,0x16,0x7f,0xf1,0xc2,0x87,0xb5,0xd0,0x57,0x35,0x87,0xfb,0xfe,0xea,0xc6,0x2b,0x33,0x00,0x37,0x04,0xac,0x4b,0x0c,0x73,0xe1,0x24,0x5f,0x9c,0x01,0xca,0x99,0xab,0x00}},
+    {{0x86,0x2d,0xc8,0x08,0x2b,0x8b,0x1a,0x26,0xa4,0x64,0xff,0x81,0x3a,0x5b,0x9b,0xa6,0xb1,0xdf,0xf3,0x3b,0xb2,0xa1,0x4d,0x7c,0x92,0xf8,0x4b,0xa2,0x4a,0x23,0xf7,0xd7,0x00}},
+    {{0x86,0x77,0xd8,0x9b,0x7d,0x56,0x84,0x89,0x92,0x23,0x18,0xae,0x69,0xfc,0x4d,0x63,0xc7,0x69,0x48,0x57,0x84,0xbd,0xf5,0x1b,0x74,0x56,0xf5,0xd3,0x11,0x9c,0x38,0x41,0x01}},
+    {{0x87,0xc1,0x3e,0xee,0x01,0x2f,0x58,0xf1,0xfe,0x95,0xf4,0x7e,0xd2,0xf6,0x92,0xdc,0xa1,0xbf,0xdb,0xd3,0xec,0x3d,0x25,0xeb,0x6c,0x18,0xc3,0x20,0x2e,0x32,0x9f,0x3a,0x01}},
+    {{0x88,0x46,0x87,0xab,0x08,0xf7,0xa3,0xec,0x74,0x5c,0x98,0xc9,0x63,0xdf,0x2a,0x60,0x38,0xd8,0x5c,0x3d,0x4e,0x64,0x8d,0xeb,0xcd,0xac,0x44,0xa0,0x36,0xf6,0x75,0xf8,0x00}},
+    {{0x89,0x03,0x36,0x56,0x66,0xb0,0x13,0xdc,0x70,0xf2,0x8d,0x95,0x1f,0xe7,0x43,0x8f,0x94,0xf7,0x12,0x8a,0xf6,0xf1,0xc7,0xb8,0xbe,0x51,0x54,0xff,0x75,0x7a,0x60,0x99,0x00}},
+    {{0x89,0x3f,0x76,0xc1,0x04,0xaf,0x2c,0xfb,0xfe,0x5c,0x3e,0xac,0x0a,0x86,0x21,0xdb,0xa6,0xfa,0xe2,0xb5,0x7e,0xa4,0x66,0xf2,0xc9,0x89,0xc6,0x2f,0x30,0x7c,0x39,0x81,0x01}},
+    {{0x89,0x80,0x9a,0xe2,0x34,0x97,0x6e,0x4c,0x28,0x72,0xac,0xc4,0x05,0xfa,0xfe,0x2f,0x18,0x2b,0x88,0x68,0xab,0x8c,0xc5,0x18,0x64,0x7c,0x4b,0xa4,0x8d,0x1c,0x61,0x40,0x01}},
+    {{0x89,0x84,0x3c,0x2d,0xaf,0xe9,0x22,0xae,0x6b,0xc8,0xf4,0xf9,0xe0,0xe3,0xaa,0x27,0x18,0x87,0xf3,0xe1,0x86,0x98,0xe7,0x17,0x1d,0xf4,0xb3,0xca,0x1f,0xc0,0x8c,0xc6,0x00}},
+    {{0x89,0xb9,0x8a,0x93,0x04,0xe9,0xb5,0x7f,0xef,0x36,0x88,0x69,0x28,0xaf,0x15,0xa9,0x95,0xde,0x81,0x07,0x0c,0x9f,0xa0,0x60,0x83,0x99,0x0f,0x32,0x90,0x77,0x01,0x32,0x01}},
+    {{0x8a,0x01,0xb3,0x99,0xbe,0x41,0x25,0x9f,0xff,0xb7,0xd4,0xca,0xf5,0x4c,0xad,0x5f,0xf5,0x70,0x49,0xcb,0x2d,0x09,0x25,0xd4,0x8e,0x15,0x86,0x4f,0x3b,0x59,0x08,0xd7,0x00}},
+    {{0x8a,0x80,0xfc,0x0f,0x66,0xf5,0x4f,0x3b,0x84,0x5a,0x89,0x20,0x5b,0x8b,0x9a,0x59,0x3c,0xa9,0x57,0xae,0x44,0x14,0x70,0x0f,0x46,0x87,0xdf,0xc6,0x2f,0xca,0xf8,0xeb,0x00}},
+    {{0x8b,0x81,0x42,0x99,0x78,0xa0,0xd3,0xec,0xa8,0xc4,0x26,0xae,0x9f,0x0b,0x0c,0x49,0x91,0xaa,0x6f,0x10,0x35,0xf4,0x76,0xc4,0xfe,0x7c,0x16,0x90,0x5d,0xd3,0x76,0x27,0x00}},
+    {{0x8b,0xc2,0x68,0x4d,0x08,0x43,0x95,0x08,0xd2,0x43,0x7c,0x52,0xff,0x72,0x08,0x8a,0xd7,0x80,0x0e,0x2c,0xc3,0xf8,0x20,0xb2,0xeb,0x01,0x4d,0xe7,0xd9,0x80,0xa7,0x18,0x01}},
+    {{0x8c,0x29,0x4f,0x57,0x2b,0x45,0xd4,0xcc,0x75,0x22,0x45,0x50,0x49,0x01,0x3d,0x90,0xcd,0x1c,0x70,0x31,0xc1,0x82,0xe3,0xf2,0xb7,0xad,0xdd,0xc0,0x77,0xf3,0x60,0x5e,0x00}},
+    {{0x8c,0xc1,0x97,0xc0,0xd1,0x89,0x8c,0xe8,0x88,0x38,0x97,0x9b,0xb3,0x46,0xb3,0x7c,0xb2,0x0a,0x97,0x78,0xab,0x69,0x28,0xd1,0x5a,0xcb,0x3c,0xc4,0x11,0x7c,0x73,0xa0,0x00}},
+    {{0x8c,0xd9,0x4a,0x63,0x50,0x1f,0x83,0x6c,0xe5,0x18,0x00,0x0d,0xcd,0x94,0x49,0x9b,0x01,0xc1,0x05,0x68,0x8d,0x73,0x69,0x32,0x02,0x40,0xca,0x34,0x3a,0x8f,0x49,0x75,0x00}},
+    {{0x8c,0xe3,0x36,0x76,0x66,0x4b,0xed,0x16,0xa7,0x56,0x12,0x0e,0x13,0x45,0xbb,0x33,0x8e,0x57,0x99,0xaf,0xea,0x4c,0x24,0x11,0x8d,0x54,0xd1,0x46,0x9e,0x1f,0x9a,0xfb,0x00}},
+    {{0x8e,0x0f,0x42,0xef,0xc9,0xaa,0x5b,0xba,0xcf,0x34,0x33,0x2f,0xe0,0x5a,0x5c,0xdb,0xff,0xf1,0x80,0x39,0xc1,0xbd,0x84,0x2e,0xcf,0x58,0x1e,0x0a,0x94,0x78,0x5a,0xdc,0x00}},
+    {{0x8e,0x4e,0x5d,0x4c,0x11,0x87,0x46,0x0a,0x70,0xab,0x26,0xa0,0xe5,0xc3,0x55,0x31,0x11,0x5f,0x61,0xa0,0x71,0xb7,0x62,0x18,0x13,0x60,0x9f,0xf9,0xf2,0xa6,0x29,0x2a,0x01}},
+    {{0x8e,0xf1,0x5e,0x9f,0x62,0x5c,0xe2,0xa4,0xc6,0xcb,0x71,0xf3,0x72,0x0b,0xb0,0x47,0xe3,0xc3,0x4b,0xa7,0x14,0x15,0xcf,0x48,0x4a,0x09,0x02,0x49,0x91,0x85,0x0d,0x5d,0x00}},
+    {{0x91,0x03,0x51,0xa5,0x32,0x20,0x36,0x82,0xa0,0x99,0x51,0xa8,0x50,0x64,0x28,0xf0,0xb9,0xe7,0xcb,0xc1,0xbe,0x8b,0xf6,0xb2,0x5d,0x4d,0xfe,0x54,0xa8,0x0d,0x2d,0x28,0x01}},
+    {{0x91,0x82,0xe6,0xb8,0x0f,0x8c,0x54,0x8f,0x6a,0x50,0x67,0xcf,0x10,0x82,0xea,0x5f,0xcb,0xa2,0xf7,0x35,0x70,0xa5,0x6b,0x10,0xf2,0xc4,0x0e,0x51,0x75,0xba,0x21,0xf5,0x00}},
+    {{0x92,0x2e,0xa1,0x76,0x10,0xad,0x93,0xb4,0x50,0xbd,0x8a,0x8d,0xcd,0x99,0x7d,0xbb,0xad,0x73,0xb8,0x10,0x2c,0xe3,0x18,0x66,0xcb,0x4a,0x4c,0xfa,0xc1,0xb6,0x55,0x91,0x00}},
+    {{0x93,0xb0,0xc0,0x92,0x9d,0xe1,0x3a,0xfc,0x3b,0xa3,0x74,0xda,0x88,0x6b,0x66,0x84,0x16,0x62,0x2d,0xf1,0x4a,0xa2,0x02,0x0e,0x05,0xce,0x90,0xe5,0x06,0xf5,0x24,0x18,0x00}},
+    {{0x94,0x4b,0xb0,0x64,0x9c,0x1c,0xfc,0x29,0x83,0x83,0x18,0xc6,0x4a,0x43,0x00,0x50,0x2d,0xbe,0xa5,0x54,0x7f,0xb1,0x75,0x7e,0x75,0x7c,0x9c,0x74,0x79,0x94,0xa7,0x35,0x01}},
+    {{0x95,0xd9,0x80,0xd3,0xdd,0xa0,0x09,0xe6,0x66,0xec,0xf2,0x45,0xfb,0xdb,0x98,0x9a,0x2f,0x88,0x75,0xf8,0x0e,0x9e,0xd1,0x24,0x8d,0xe5,0xdd,0x9c,0xc3,0x84,0x56,0xf5,0x00}},
+    {{0x96,0x81,0x3a,0x47,0x93,0x3f,0x93,0x90,0x7b,0xb4,0x66,0x49,0x96,0xbc,0x3c,0x0b,0x4e,0x39,0x3c,0xe8,0xc2,0xc3,0x5b,0xb9,0x3e,0x0d,0xfd,0x90,0x3c,0xee,0x20,0x4e,0x01}},
+    {{0x97,0x01,0xf1,0x79,0x21,0x51,0x47,0x7d,0x75,0x62,0x2c,0x70,0xcc,0x19,0x57,0x63,0x4a,0x35,0x3f,0x8c,0x5b,0x19,0x18,0x81,0xe6,0x55,0xd9,0xd1,0x91,0x40,0xfc,0x09,0x00}},
+    {{0x97,0x91,0xa2,0x11,0x16,0x00,0x75,0x9d,0x6d,0x75,0x92,0x89,0xb5,0x35,0x54,0xb4,0x41,0xaf,0xaf,0xde,0xe5,0x6f,0x3b,0x3c,0x99,0xc6,0x4a,0xa2,0xfc,0xba,0x0d,0x60,0x01}},
+    {{0x98,0xd6,0xc8,0xed,0x72,0x20,0x06,0x4a,0xbe,0xd6,0x54,0x79,0xbf,0x4f,0x59,0xb6,0x0e,0x8f,0x66,0x0f,0xfc,0x82,0xcd,0xa6,0x1a,0xf8,0xcd,0xdd,0x41,0xe9,0xdf,0xe1,0x00}},
+    {{0x9a,0x52,0x80,0x48,0xe4,0x7f,0x10,0x14,0x45,0x05,0xba,0x21,0xe1,0x8b,0x71,0x51,0x3b,0x53,0xf1,0x6b,0x20,0xc7,0xc8,0x28,0x9c,0x44,0x44,0xed,0xa0,0x84,0x45,0xec,0x00}},
+    {{0x9b,0x63,0x80,0xd7,0xcb,0x62,0xe5,0xac,0x5b,0x31,0xf7,0x59,0x4a,0x07,0xe0,0xc3,0xa1,0xd7,0x97,0xeb,0xb9,0xda,0x6c,0xfa,0x9a,0x71,0x3c,0x33,0x9f,0xf7,0xbf,0x4b,0x01}},
+    {{0x9b,0xdf,0x55,0xb4,0x52,0xdc,0x1e,0xe9,0x76,0xca,0x0f,0x9e,0xc1,0x2b,0x0a,0x3c,0xd6,0x96,0x3b,0xbb,0x4b,0xe1,0xd2,0xeb,0xee,0x66,0x05,0xd6,0x06,0xe3,0x1f,0x85,0x00}},
+    {{0x9c,0x99,0x16,0x97,0x94,0x0b,0x0c,0xad,0x4e,0x48,0x73,0x37,0x82,0xd9,0x8c,0xc9,0x44,0xea,0x5b,0x87,0xa7,0xfa,0x22,0x67,0x26,0xcd,0xd6,0xb3,0x23,0x47,0x46,0x6a,0x01}},
+    {{0x9d,0xcd,0x3c,0x28,0xbc,0x91,0x2b,0xb6,0x4e,0x61,0x1e,0xec,0x5c,0x56,0x04,0x0e,0xac,0xaa,0x0f,0x58,0x83,0xa4,0xed,0x1c,0xa9,0x76,0xa3,0x4a,0xc9,0x17,0x5e,0xf3,0x00}},
+    {{0x9e,0x36,0x61,0x7b,0x7e,0x33,0x58,0x71,0xbb,0xb7,0x3d,0xc8,0xf0,0x3b,0x6a,0x3e,0x92,0x2c,0x7d,0xef,0xb5,0x68,0x54,0x58,0xec,0x77,0x3f,0xb5,0xeb,0x07,0xc1,0x94,0x01}},
+    {{0x9e,0x53,0xce,0x87,0x49,0xf9,0x51,0x87,0xa0,0x7a,0x26,0xc3,0xf8,0xdc,0x9e,0xfd,0x3d,0x99,0x78,0x3a,0x9d,0xe0,0x96,0x6d,0x11,0x02,0x5f,0xd9,0x81,0x1f,0xef,0xf0,0x00}},
+    {{0x9e,0x93,0x6b,0xfa,0x59,0xa7,0xdb,0x52,0xa6,0x26,0x25,0xca,0xee,0xd8,0xf5,0xb2,0x8b,0xa9,0x0b,0x56,0x16,0xf8,0xd8,0x9c,0x47,0x33,0x1b,0x61,0x40,0x33,0x25,0x1c,0x01}},
+    {{0x9e,0xaf,0x38,0x50,0xe1,0x82,0x3f,0xaf,0x39,0x7d,0x70,0xbe,0x9d,0xfc,0xdf,0x7f,0x91,0x4f,0x7f,0x82,0x5b,0x6e,0x40,0x25,0x7b,0x07,0xf8,0x2c,0xef,0xe7,0x1e,0xf2,0x00}},
+    {{0x9f,0x07,0x1d,0x95,0x3f,0xf8,0xf8,0x60,0x7c,0xde,0x08,0x96,0x4b,0x6f,0x9d,0x4e,0xe1,0x3f,0xe3,0xdf,0x1b,0xcd,0xcb,0x2f,0x7b,0x33,0x81,0xb6,0x44,0x88,0x83,0x41,0x00}},
+    {{0xa0,0x33,0x48,0x4f,0x6a,0x90,0x1c,0x04,0x70,0x9b,0xbf,0xaa,0x4f,0xdd,0xc7,0x6f,0x68,0xcd,0x21,0x77,0x8a,0xef,0x69,0x7c,0x1e,0x94,0x5a,0x8a,0x1c,0xf5,0x53,0x1a,0x00}},
+    {{0xa0,0xf8,0x98,0x28,0x65,0xb8,0x42,0x6e,0xa1,0xf8,0xe8,0x02,0x69,0xd1,0xa1,0x63,0xcd,0x4d,0xb0,0x53,0x87,0x8a,0x4e,0x5d,0x01,0x82,0x3e,0x50,0x3d,0xd9,0x2f,0x18,0x01}},
+    {{0xa1,0x3f,0x65,0x8d,0xcc,0x9c,0xb0,0xdb,0x80,0xad,0xdf,0xac,0xf8,0x1c,0x44,0xb6,0x02,0x7b,0xe9,0x22,0x4b,0xf4,0xc9,0xe9,0x77,0x95,0x4c,0x88,0xcb,0x2a,0xb7,0x32,0x00}},
+    {{0xa1,0x4b,0x6d,0x25,0xcc,0x6e,0xcd,0x10,0x98,0x7f,0x18,0xe7,0x2d,0x2c,0x08,0x91,0xd8,0xfc,0x6c,0x1c,0x48,0x4c,0x92,0x4c,0x2a,0x71,0x38,0xc8,0xfc,0xcf,0x72,0xec,0x00}},
+    {{0xa1,0x7d,0xa6,0x20,0xc5,0x6c,0x81,0xf4,0xca,0x4d,0x40,0xbf,0x35,0x3a,0xb6,0xc8,0x1c,0x1f,0x79,0xf7,0xa3,0x96,0x3a,0xa7,0xf2,0xed,0xe1,0x07,0x7e,0xcc,0xe1,0x16,0x01}},
+    {{0xa1,0xf5,0xd5,0x32,0x06,0x5e,0xa5,0x8f,0x3f,0xa9,0x7c,0x46,0x7c,0x09,0x7b,0x59,0x5f,0xbc,0x02,0x2b,0xdf,0x8c,0x11,0x7c,0x1d,0xd3,0x7c,0xe7,0x7c,0xbb,0x37,0x15,0x01}},
+    {{0xa4,0x43,0xd6,0x8a,0xc2,0xc0,0xbf,0x5d,0xe7,0x1e,0x3d,0x30,0xde,0xbb,0xa1,0xb5,0xb2,0x76,0x1b,0x54,0x17,0x06,0x7f,0x77,0x38,0x32,0x6e,0x49,0x51,0xc2,0xca,0x54,0x01}},
+    {{0xa4,0x6e,0x49,0x7c,0xd4,0x7e,0xc4,0x2a,0x15,0xdc,0x86,0xb1,0x76,0xba,0x82,0x88,0xfe,0x18,0xfe,0x35,0x67,0x5e,0xd2,0xa1,0x7d,0xb4,0x51,0xdb,0xe0,0xcc,0xbd,0xae,0x00}},
+    {{0xa6,0xd8,0xfb,0xee,0xd6,0x89,0x8f,0xa0,0x4c,0x79,0x87,0x1e,0x8b,0x26,0xb5,0xef,0x97,0x54,0x57,0xe5,0x15,0xe2,0xb5,0x68,0xdb,0x18,0xe6,0x16,0xbd,0x26,0xc3,0x0b,0x01}},
+    {{0xa6,0xf4,0xe1,0x73,0x42,0x40,0xef,0xb1,0x4e,0x29,0x01,0x92,0x36,0x02,0x9f,0x50,0x5e,0x43,0x4d,0x12,0xc0,0x0e,0x04,0x12,0xb1,0x87,0x90,0x0b,0xa6,0x0c,0x6b,0x5c,0x01}},
+    {{0xa7,0xc5,0xd5,0xf5,0xcd,0xba,0x1b,0x3e,0x65,0x67,0xc3,0x9d,0x21,0x40,0xff,0x90,0xf0,0x18,0x9a,0xb1,0xc2,0x8c,0x0d,0xf8,0x77,0x89,0x24,0xb0,0x1f,0x9b,0x82,0x71,0x01}},
+    {{0xa8,0xa3,0xc4,0x97,0x44,0x59,0x2a,0x69,0xb6,0x62,0xf8,0x60,0xd7,0x62,0x18,0xbd,0xe2,0x9e,0xb8,0xe2,0xf3,0xc2,0x90,0x35,0x7a,0x18,0x39,0xdc,0x06,0x7a,0x83,0x68,0x01}},
+    {{0xa9,0x71,0x96,0x93,0x20,0xd1,0x5b,0x07,0xe9,0xe1,0x0f,0x10,0xd9,0x9a,0x57,0x34,0x0e,0x1e,0x02,0x79,0xe6,0xea,0x34,0x8c,0x64,0xc5,0x2e,0xbe,0xca,0x72,0x4f,0x38,0x00}},
+    {{0xa9,0xf3,0xe4,0x85,0x0f,0x56,0x80,0x87,0x47,0x79,0x70,0xf9,0xff,0xf7,0x80,0x1b,0xb6,0x2c,0x27,0x79,0x27,0x64,0x8f,0xcf,0x5e,0x70,0xf2,0x38,0xf1,0x98,0x0a,0x5f,0x01}},
+    {{0xaa,0x35,0x5c,0xa2,0x12,0xc7,0xa8,0x3d,0x49,0xea,0x89,0xf4,0x44,0xc5,0x99,0x39,0xe8,0x5d,0x03,0x20,0x5b,0x3a,0xf9,0x9b,0xd5,0x6a,0x17,0x84,0x2b,0xbe,0x3b,0x80,0x01}},
+    {{0xab,0x54,0xa3,0x8c,0xfc,0x11,0xad,0x80,0x7a,0x50,0x6e,0xa3,0x8c,0x7c,0x7f,0xfd,0x1d,0x68,0xe0,0xaa,0xdc,0xf4,0xdc,0x22,0xfd,0x38,0x7a,0x69,0x03,0xa9,0xff,0x5b,0x01}},
+    {{0xac,0x7f,0x43,0x6e,0xb1,0x6e,0xf1,0xf1,0x9f,0x25,0x83,0x29,0xa3,0xf5,0x40,0x21,0x80,0x4e,0x29,0x3a,0xf9,0x33,0x34,0x4b,0x8f,0xb0,0xeb,0x09,0x6a,0xd9,0xbc,0x6b,0x00}},
+    {{0xac,0xe4,0x6b,0x52,0x68,0xc0,0xd8,0x6b,0x59,0xc1,0xbd,0x2f,0x9a,0x95,0xa6,0xc2,0xdb,0xbf,0xb1,0xea,0x2f,0x13,0xdb,0x99,0x89,0x67,0x65,0x77,0x55,0x64,0xba,0xed,0x00}},
+    {{0xad,0xdb,0x4d,0xb1,0xc8,0x48,0x79,0xd6,0xd3,0x1c,0x57,0xb2,0xd7,0x9e,0x48,0xfd,0x9e,0x16,0xb8,0xdb,0x35,0x28,0xd4,0x6d,0x41,0xb4,0x31,0x4c,0x60,0xfb,0xd5,0x79,0x00}},
+    {{0xae,0xed,0x50,0x26,0x0e,0xa2,0x49,0x5d,0x10,0x5a,0x16,0xd9,0xe8,0xde,0xd2,0x73,0xc5,0x4d,0xaf,0x40,0xc8,0x08,0x6a,0xb5,0x83,0xc0,0x28,0x76,0x1b,0x53,0x3c,0xe9,0x00}},
+    {{0xaf,0x1e,0x4b,0xbe,0x72,0x4b,0xb1,0x30,0xfd,0xd3,0xb0,0xb6,0x3c,0xc6,0xab,0x82,0x86,0x47,0x45,0x57,0x8a,0x76,0xa0,0xea,0x26,0xe6,0x9a,0x5b,0x94,0x31,0xa0,0x6e,0x00}},
+    {{0xb0,0x03,0x9e,0x35,0xf8,0x98,0x87,0x16,0x9b,0x6d,0x7c,0x39,0xc6,0xcd,0x4b,0x9b,0x3e,0x91,0x23,0x46,0xb0,0x04,0x0e,0x81,0x29,0xe3,0x3f,0xcb,0xb1,0xe8,0x92,0xfa,0x00}},
+    {{0xb0,0x25,0xb6,0xea,0xf1,0x79,0x9c,0x94,0xcf,0x86,0x58,0xe1,0xa0,0x86,0xb5,0xba,0x83,0xa5,0x00,0xab,0xd4,0x5a,0xe3,0x2c,0xdb,0x21,0x4f,0x11,0xe5,0xec,0x6e,0x33,0x01}},
+    {{0xb0,0x56,0x3d,0x28,0x4a,0xdf,0x3a,0x17,0x4b,0x7f,0xe2,0x96,0x9c,0x4f,0x77,0x2e,0xd1,0x4a,0x9f,0x3c,0x76,0x41,0xbf,0xb6,0xe7,0x84,0x91,0x83,0x29,0xdc,0x4e,0x96,0x01}},
+    {{0xb0,0xbe,0x84,0xf4,0x2c,0x88,0xa6,0xb8,0x9d,0x20,0xf2,0x20,0x5b,0xd6,0x34,0x77,0xa4,0xce,0x36,0xbb,0x79,0xd5,0xb8,0xb3,0x23,0x67,0x2b,0xa0,0xac,0xd6,0x0a,0x0e,0x00}},
+    {{0xb1,0x24,0x4e,0x82,0xa0,0xc7,0x8b,0x4e,0x9e,0x99,0x39,0xc5,0x1c,0xf4,0x9f,0x1d,0x0c,0x61,0xc9,0x8a,0x21,0xeb,0xf8,0x4d,0x29,0xc1,0x88,0x9e,0x71,0x2a,0x27,0x65,0x01}},
+    {{0xb1,0x7c,0x03,0x01,0xfd,0xc6,0x69,0xb2,0x2a,0xac,0x3c,0x77,0x1e,0x7b,0x8b,0x54,0x23,0x01,0xcb,0x38,0x53,0x66,0xa0,0xb9,0x4b,0x8c,0x54,0x42,0xa4,0xa8,0x43,0xd5,0x00}},
+    {{0xb2,0x11,0x0b,0xb8,0x98,0xdf,0x72,0xbb,0x53,0xb3,0x48,0x5e,0xc7,0xc2,0x6b,0x3a,0xf4,0x26,0x0c,0x71,0xc4,0x09,0x60,0x64,0xc6,0x1e,0x78,0x51,0xf9,0x07,0xc0,0x77,0x00}},
+    {{0xb3,0x5a,0x0e,0x68,0x06,0x48,0x34,0xff,0xa5,0xea,0x22,0x73,0x85,0x0e,0x97,0x0b,0xb1,0xc4,0x50,0xaf,0xe5,0x2e,0x58,0xee,0x20,0xdf,0x05,0x35,0x12,0x7b,0xaa,0x0a,0x00}},
+    {{0xb3,0xa4,0x1e,0xfb,0x58,0x13,0x9e,0x62,0x94,0xa9,0x3b,0x9f,0xb4,0xaf,0x49,0xc8,0xc6,0x4e,0xa5,0xca,0xb7,0x4a,0x00,0x8e,0x02,0x3d,0xaf,0x66,0xd9,0xf3,0xeb,0x73,0x00}},
+    {{0xb3,0xee,0xbb,0x44,0x4b,0x26,0x19,0x1c,0x84,0x54,0x21,0x3e,0xce,0xa5,0x56,0x69,0xad,0x70,0x3b,0xfb,0x21,0xf0,0x4c,0x5a,0xcd,0xff,0x25,0x52,0xac,0x60,0xb8,0x82,0x01}},
+    {{0xb4,0xee,0x84,0x4d,0xdd,0xeb,0x71,0xca,0x00,0x1c,0x18,0x70,0x1d,0xaa,0x8e,0x41,0xa1,0xa4,0x38,0x47,0x20,0xcb,0x2f,0x5d,0xfb,0xfe,0x7c,0xb3,0xf5,0x89,0x52,0x6d,0x00}},
+    {{0xb5,0x73,0xcd,0x0a,0xe4,0xb3,0xbd,0xc5,0x76,0xe2,0xbb,0xba,0xae,0x92,0x26,0xc5,0x37,0xbd,0xb9,0xb0,0x81,0xf1,0x97,0x5d,0x5c,0x93,0xfe,0x32,0xfe,0x4d,0x29,0x2b,0x00}},
+    {{0xb6,0x6c,0xbc,0x20,0xe0,0x6b,0x46,0xd4,0x00,0xe3,0x61,0x9d,0x55,0x39,0x1d,0x40,0xa6,0xdf,0x3f,0x29,0xb2,0x31,0x71,0x64,0x58,0x70,0x80,0xc2,0xf7,0xd3,0xec,0xb3,0x00}},
+    {{0xb6,0xad,0xe0,0x41,0x10,0x54,0x88,0x25,0x2a,0xf8,0xcf,0xb5,0x50,0xad,0xfa,0x94,0x17,0x10,0xe5,0xdb,0xde,0x19,0xd0,0x8a,0xf2,0x62,0x05,0x37,0x55,0x74,0x14,0x73,0x00}},
+    {{0xb6,0xe6,0xd0,0xf2,0xdf,0xa5,0xcf,0x58,0xf1,0xbc,0xab,0x5a,0x73,0x62,0x11,0x0e,0x95,0xc3,0xde,0x7a,0x3f,0x2c,0xab,0xd2,0x11,0x80,0xc9,0xc4,0x57,0xcf,0xb4,0x64,0x00}},
+    {{0xb7,0x2e,0xf9,0xf8,0x99,0xfe,0x3e,0x78,0x01,0x3e,0xf8,0xbb,0x40,0x00,0xa9,0xc4,0xf4,0x55,0xa6,0x3e,0x61,0x96,0x2f,0x46,0x1d,0xfc,0x3f,0xe2,0x02,0xb1,0xbb,0x09,0x00}},
+    {{0xb7,0x45,0x2d,0x37,0x4d,0x47,0xd5,0x61,0x40,0x1b,0x03,0xcb,0xb3,0x24,0xd7,0x91,0x0e,0xea,0x6f,0x7a,0xe2,0xa0,0xc0,0x8d,0x93,0x10,0x57,0x02,0x40,0x49,0xe5,0xd6,0x00}},
+    {{0xb7,0xad,0x42,0x6f,0x41,0xb2,0x69,0x14,0x86,0xe0,0xac,0x11,0xa6,0x3e,0x96,0xbe,0x3b,0x8e,0xb4,0x21,0x78,0xa1,0x7a,0x81,0xd4,0x6d,0x99,0x59,0xf7,0x21,0xac,0x1e,0x00}},
+    {{0xb8,0xef,0xae,0xac,0xe3,0xff,0xae,0xe1,0xd3,0xc9,0x9f,0x43,0x4a,0x26,0x04,0xef,0xd6,0x65,0x6b,0x9f,0xf6,0x85,0x2b,0x24,0x7a,0xe8,0x06,0x7a,0xa1,0xd8,0x5a,0x4b,0x00}},
+    {{0xb9,0x10,0x7d,0xd5,0x41,0x08,0x07,0xf0,0xa8,0xdc,0x35,0xff,0x5d,0xf8,0xb6,0x98,0x8d,0x3c,0xf6,0x22,0x1e,0xda,0x2e,0x83,0x1b,0x3b,0x8b,0xd9,0x65,0x77,0x4d,0x2e,0x00}},
+    {{0xb9,0x69,0x85,0xb6,0x9f,0xe3,0xdd,0xaa,0x61,0xe7,0x7d,0x3d,0x31,0x1a,0xdd,0x84,0x34,0x89,0x5d,0x30,0x32,0x34,0xe1,0xa9,0xcd,0xdc,0x4f,0xb9,0xc5,0x94,0x1d,0x3e,0x01}},
+    {{0xbb,0x3c,0x88,0x4e,0xa5,0x67,0x75,0x93,0xd1,0xba,0x56,0x20,0x2b,0x0e,0x58,0x40,0xff,0xd6,0xdd,0xac,0xf4,0x4a,0x8f,0xa0,0x5d,0x3f,0xd8,0x9c,0x5b,0xd0,0x0d,0x0f,0x00}},
+    {{0xbb,0x7b,0xa3,0xab,0xec,0x43,0x60,0xe3,0x71,0x31,0x4a,0x91,0x30,0x77,0x51,0x96,0x10,0x44,0xbe,0x13,0xa5,0x44,0x6d,0x8a,0xa1,0x46,0x59,0x8c,0xba,0xfe,0xdc,0x5c,0x00}},
+    {{0xbd,0xfe,0x99,0x09,0xf8,0xe7,0xba,0xb8,0xf0,0x29,0xad,0x7b,0xaa,0xf0,0xa6,0xf2,0x01,0x13,0x87,0x59,0x2a,0xb7,0x65,0x2c,0xb5,0xa1,0x1b,0xee,0x5d,0x32,0x24,0x87,0x01}},
+    {{0xbe,0x30,0x97,0x04,0x0e,0xdd,0x4f,0x5b,0xa2,0x1f,0x75,0x99,0x9b,0x17,0x24,0x55,0xb9,0xcc,0x28,0x35,0xf2,0x18,0x01,0x25,0xec,0x33,0xb8,0xe7,0x6f,0x65,0xe0,0x5a,0x00}},
+    {{0xbe,0xaf,0x2c,0x18,0xeb,0x48,0x6e,0x68,0x6c,0xd6,0x8a,0xc0,0x5b,0x35,0xe6,0xc4,0xca,0x87,0x54,0xa9,0xa3,0x32,0x76,0x82,0x80,0xab,0xc8,0xe3,0x3c,0x12,0xd5,0x27,0x00}},
+    {{0xbf,0xb3,0x60,0x30,0x97,0x70,0x6f,0x2e,0x1c,0xa5,0x51,0x0c,0xea,0x6d,0x5a,0x99,0x3f,0xc6,0xe8,0xd6,0x93,0x95,0xd7,0x5c,0x64,0x49,0xe6,0xa9,0x71,0x08,0x86,0x89,0x01}},
+    {{0xc0,0x4a,0x6e,0x5e,0x85,0x09,0x82,0xaf,0xa1,0x40,0x4f,0x86,0x51,0x96,0x2a,0x73,0xd6,0xa5,0x9b,0x48,0x10,0x19,0x3b,0x27,0x50,0xf0,0x55,0xb9,0xe3,0x42,0xd4,0x29,0x01}},
+    {{0xc1,0x78,0xf6,0xc3,0x77,0xd9,0x15,0x03,0x85,0x09,0x3c,0xb7,0x95,0xf6,0xfb,0xb4,0x2c,0xa3,0x02,0xc8,0xb2,0x3e,0x80,0xf0,0x03,0x63,0x56,0x07,0x41,0xec,0x5a,0x68,0x00}},
+    {{0xc1,0x97,0xd3,0x91,0x52,0x40,0x95,0x89,0xd5,0x4e,0x9e,0x5f,0x9a,0xbf,0x92,0xa2,0x29,0xf7,0x83,0x76,0x95,0x54,0xcd,0xad,0x48,0xc4,0x7e,0x5e,0xd1,0x9a,0xe6,0x81,0x01}},
+    {{0xc2,0x06,0xc7,0x32,0xb9,0x5d,0x23,0xbf,0x68,0x72,0x16,0x37,0x46,0x8f,0x94,0xff,0x2e,0x6d,0xd2,0x6b,0x42,0x2b,0xdc,0x96,0x1b,0xcc,0x97,0x2f,0x8b,0xdc,0x09,0x28,0x00}},
+    {{0xc3,0x1e,0xe0,0x46,0xe5,0xcc,0xa6,0xc0,0x85,0x80,0xa6,0x79,0x74,0xd0,0x15,0x4a,0x05,0xe9,0xbb,0xfb,0x9d,0xef,0x4b,0x0a,0x54,0x24,0xb2,0xbe,0x28,0x28,0xa2,0x32,0x01}},
+    {{0xc3,0xae,0x80,0xa6,0x6e,0xfc,0xac,0x69,0x7d,0x3a,0x8a,0x3a,0xe1,0x6f,0x38,0x70,0x4d,0x1e,0x99,0x5b,0xf6,0x50,0x66,0x2b,0xcd,0xf3,0xb6,0x23,0x04,0x46,0xd4,0x80,0x00}},
+    {{0xc3,0xcc,0xe0,0x6f,0x67,0xcb,0xae,0xd0,0x14,0x50,0xf6,0x9a,0x21,0xd2,0x21,0x56,0xe5,0x74,0xb3,0x3c,0x0d,0x2b,0xa8,0xdb,0x9f,0x66,0xc6,0x08,0x61,0x37,0xa9,0x3f,0x01}},
+    {{0xc4,0x7e,0xf1,0x88,0x4e,0xd6,0x28,0xa3,0x45,0x57,0xb8,0x5f,0xc7,0x9c,0x35,0x93,0xbf,0x2e,0x3f,0xea,0x8c,0x11,0xa5,0xa3,0x38,0x9b,0x5f,0x18,0xd7,0x88,0x40,0xd2,0x00}},
+    {{0xc4,0xbe,0xe8,0x70,0xf1,0xbc,0x8e,0x76,0x6f,0xfb,0xb5,0x7a,0x00,0xe9,0x4f,0x19,0x41,0x94,0x0c,0x52,0x19,0xfd,0x45,0xae,0x27,0xad,0x04,0x35,0xc4,0x12,0xc1,0x92,0x00}},
+    {{0xc5,0x03,0x0f,0x4d,0x4e,0xdd,0x1f,0x23,0xc0,0x5c,0x78,0x6a,0x0a,0x03,0x55,0x1b,0x0e,0x74,0xc3,0x82,0x2f,0x10,0xd8,0x18,0xa9,0xde,0x87,0x70,0x09,0x41,0x93,0x14,0x00}},
+    {{0xc5,0x3b,0xa1,0x1f,0x5f,0x0b,0xdf,0x12,0x9a,0xb2,0x28,0x28,0x56,0x72,0x99,0x6c,0xd8,0x75,0xd2,0x71,0x12,0xee,0xa6,0x29,0x61,0xc5,0xc6,0x06,0x31,0xd9,0x61,0x5d,0x01}},
+    {{0xc5,0xa4,0x92,0x10,0x90,0xaa,0x90,0x58,0x73,0x82,0x52,0x0e,0x65,0x1a,0x24,0x84,0x10,0x56,0x59,0xe6,0x18,0x0b,0x3b,0x90,0xfa,0xb8,0x77,0xec,0x76,0xc3,0xd7,0x83,0x01}},
+    {{0xc6,0x58,0x51,0x18,0xfb,0x4d,0x6c,0x43,0x53,0x40,0x90,0x0a,0xd8,0x8f,0x6c,0x3d,0x54,0xf1,0xed,0x51,0x24,0xe8,0xfa,0x43,0x59,0x18,0x9b,0x6b,0xa9,0x57,0xd9,0x11,0x01}},
+    {{0xc6,0xe7,0xdf,0xa0,0x77,0x11,0xd9,0x45,0xf7,0x25,0x2f,0x3c,0xc6,0xab,0x1b,0xae,0xc6,0xbf,0x3e,0xa9,0xee,0xb5,0x1c,0x67,0xb3,0xce,0x7c,0x76,0x51,0x7a,0x99,0xf4,0x00}},
+    {{0xc7,0x7f,0xc6,0xa7,0xbf,0x3c,0x2a,0xed,0x46,0x8b,0xdd,0x12,0x2c,0x3f,0x6d,0xb6,0x3a,0x38,0x4e,0xdf,0x53,0x54,0xd3,0x9a,0x2a,0x2b,0xfe,0x7f,0x68,0xdc,0xf8,0x1e,0x00}},
+    {{0xc7,0xf1,0x57,0xaa,0x4e,0xe5,0xdf,0xc7,0x0e,0xb3,0xb8,0xe9,0x53,0xd7,0x24,0xb2,0x62,0x23,0x58,0x30,0x83,0x10,0x38,0x7f,0xde,0x51,0x2c,0xcd,0x12,0xf0,0x32,0x52,0x01}},
+    {{0xc8,0x39,0xcc,0x35,0xa3,0xf0,0x53,0xb8,0x3b,0x0b,0x26,0x7a,0x1a,0x40,0x64,0xfa,0x56,0xe3,0x4a,0x23,0x70,0x44,0xf9,0x61,0x94,0xe7,0x7b,0xe3,0xb2,0xba,0xbd,0x13,0x01}},
+    {{0xc8,0x59,0xd5,0x98,0x78,0xaf,0x9a,0xa4,0x76,0x50,0x45,0xfd,0x09,0xe5,0x55,0xf1,0xbf,0x4a,0xd2,0x67,0x29,0x68,0x90,0xf7,0x67,0x9a,0xdc,0xdd,0x5d,0x59,0xdb,0x2b,0x01}},
+    {{0xc8,0x7f,0x6e,0x8e,0x1a,0x1f,0x22,0x98,0x7f,0xc7,0x6c,0x20,0x7e,0x00,0x69,0xeb,0xa3,0xa2,0xbe,0x42,0x4d,0xd1,0x8e,0xdb,0xb9,0x6d,0xe9,0x55,0xc9,0x45,0x0f,0xdc,0x00}},
+    {{0xc8,0x90,0xc6,0x36,0xa7,0x1f,0xff,0x85,0x5d,0xb7,0x1a,0x4b,0x95,0xba,0xdb,0x28,0xa1,0xbc,0xf4,0x5e,0xed,0x67,0x77,0x6c,0x29,0x58,0xf6,0xc5,0x66,0x4f,0x73,0x7e,0x00}},
+    {{0xc8,0xad,0xe3,0xe5,0x8d,0xbc,0x43,0xb2,0xa7,0x3f,0xef,0xb7,0x8a,0x75,0x3d,0x27,0xd6,0xda,0x8b,0x1b,0x1b,0x32,0xb6,0x11,0x55,0x86,0x82,0xf6,0xe6,0xcc,0x89,0x0a,0x01}},
+    {{0xc9,0xc6,0x5c,0xf6,0x6f,0xc8,0x25,0x86,0x50,0xce,0x96,0x28,0xcd,0x8c,0x88,0x2e,0x44,0xcf,0xb8,0xfa,0xda,0x87,0x2d,0xd9,0xb4,0xb3,0x90,0x46,0xeb,0x9e,0xf9,0x9c,0x00}},
+    {{0xca,0x33,0x46,0xf9,0x33,0xe2,0xb2,0x2e,0xda,0x85,0xd2,0xa5,0xe4,0x36,0x1b,0x92,0x7b,0xd0,0x0b,0x06,0x80,0x92,0x77,0x7d,0x86,0x84,0xa4,0x73,0x9d,0x13,0x2b,0x13,0x01}},
+    {{0xca,0xcf,0x83,0xcd,0xb0,0xef,0x24,0x4d,0x9f,0x67,0xfb,0xb6,0x33,0xfb,0x6d,0xa0,0xa2,0x93,0xf5,0x11,0x60,0xb3,0x80,0xe5,0x9a,0xab,0x39,0xe8,0x2f,0x4b,0xf9,0xce,0x00}},
+    {{0xca,0xf6,0x09,0x1a,0x5b,0x56,0x52,0xf6,0x7a,0xcb,0xa2,0xef,0x70,0x75,0x61,0x50,0x14,0xb4,0x56,0x19,0x5e,0xd3,0x4c,0xc1,0xe2,0x9c,0xde,0x61,0x9e,0x10,0xdd,0x4f,0x01}},
+    {{0xca,0xf7,0xd8,0x67,0xd7,0x17,0x61,0x3f,0xca,0x9b,0xa5,0x3b,0xd5,0xdc,0x9e,0xba,0x1f,0xa8,0x3c,0xc0,0x76,0x9f,0xd3,0x6e,0xab,0x9a,0x68,0x45,0xd8,0xcc,0x42,0x04,0x01}},
+    {{0xca,0xfa,0x82,0x87,0x97,0x4e,0x45,0x8f,0x50,0xe7,0x41,0xdd,0xa7,0x09,0x00,0x73,0xab,0x8f,0x6c,0xcb,0xb6,0x31,0xf8,0x8e,0x37,0x5d,0x5d,0xdd,0x90,0x6f,0x11,0x26,0x00}},
+    {{0xcb,0x63,0xa7,0xda,0x59,0xf0,0x71,0x4a,0xbd,0x3d,0x61,0xb9,0x3b,0xef,0x65,0xa3,0x91,0x11,0xda,0x62,0xe9,0xf5,0x5e,0xca,0x7a,0x5e,0xf9,0x47,0xb3,0x5f,0x74,0xc7,0x00}},
+    {{0xcb,0x80,0x14,0xe7,0x24,0xb6,0x6b,0x60,0xa2,0x00,0x4a,0xb4,0x43,0x90,0x9a,0x62,0x3d,0x7e,0xd5,0xad,0xd0,0x6d,0xa1,0xdf,0x9f,0xe8,0x18,0x6c,0x49,0x77,0xa2,0x23,0x00}},
+    {{0xcb,0xc0,0xb1,0x59,0x35,0x64,0xf5,0x2b,0xa8,0xac,0x48,0xbb,0x39,0x8c,0xf1,0x17,0x8b,0x8e,0x68,0xc9,0x49,0x85,0xe3,0x0e,0xd6,0x19,0xd5,0xf3,0x07,0x8b,0xd8,0x4e,0x00}},
+    {{0xcb,0xdc,0x7e,0xaf,0xbc,0x3f,0x59,0x88,0x3b,0x03,0x94,0xaf,0xe8,0xaf,0xdb,0xe4,0x90,0x34,0xdc,0xf5,0x8e,0xfb,0x4a,0x97,0x09,0xee,0xb1,0xbf,0xb6,0x3f,0xd2,0x24,0x00}},
+    {{0xcc,0x48,0x00,0x1a,0xc4,0x72,0x7d,0x68,0x32,0x04,0x3f,0x4d,0x45,0x8c,0x85,0x9a,0xaa,0x72,0x51,0xe0,0x64,0xa3,0xcc,0x40,0x55,0x50,0x9a,0xdd,0xfc,0x57,0x9f,0x83,0x01}},
+    {{0xcd,0x25,0xdf,0x87,0x40,0x75,0x5c,0x47,0xa3,0x7e,0x0c,0xf4,0xb3,0x84,0x9d,0xc8,0xcc,0x32,0x0d,0xc7,0xba,0x17,0x59,0xcf,0x8f,0x68,0xf8,0xe2,0x04,0x31,0xe3,0x4a,0x00}},
+    {{0xcd,0x69,0x93,0x68,0x90,0xe9,0x61,0x64,0xc8,0x84,0xb8,0xcf,0x3b,0xc8,0x06,0x3d,0x0a,0x97,0x43,0xaa,0xb1,0x50,0x1c,0x1b,0xb1,0xfb,0x57,0x9b,0x75,0x16,0x7f,0x03,0x01}},
+    {{0xcd,0xb1,0x72,0x52,0x41,0xc2,0x9e,0xd6,0xbc,0xb0,0xd3,0x5c,0xa1,0xe1,0x34,0x7f,0x00,0xdf,0x02,0xe1,0x89,0x14,0x33,0x00,0xa7,0xac,0xf7,0xdd,0xb7,0x4a,0x2d,0x05,0x01}},
+    {{0xcd,0xcb,0xb2,0xad,0x32,0xf6,0xf8,0x6b,0x30,0x53,0x95,0xd4,0x87,0xa2,0x08,0x74,0x42,0x91,0x21,0xac,0x90,0xcb,0xcb,0x72,0x30,0x4b,0x5b,0x2f,0x76,0x76,0x04,0x19,0x01}},
+    {{0xce,0x1d,0x39,0xad,0xf0,0x07,0xed,0x36,0x52,0xf0,0x2e,0x4e,0x15,0x5a,0x28,0xc1,0xb2,0x25,0xac,0x97,0x99,0xb2,0xb2,0x8d,0xec,0x27,0x52,0xcf,0xd9,0x9f,0xb8,0x7a,0x01}},
+    {{0xce,0x22,0x1c,0x92,0xe1,0x1a,0xbf,0x68,0x41,0x2f,0xa0,0x37,0xc7,0xbc,0x76,0xbe,0x5e,0xa1,0x5f,0x9e,0x12,0x1a,0x1c,0xee,0xab,0xb9,0x36,0x7a,0x44,0x13,0xeb,0x47,0x00}},
+    {{0xce,0x4a,0xad,0x9c,0xb2,0xc1,0x63,0x17,0x1c,0x5c,0xe4,0x7c,0x5f,0x6e,0xd4,0xc0,0xa9,0xa2,0x35,0xc7,0x6d,0x9e,0x69,0xec,0xd6,0xfb,0xd4,0x1d,0x1b,0xea,0x42,0x32,0x01}},
+    {{0xce,0x78,0xb3,0x84,0xa7,0x2b,0xe7,0xe9,0x99,0x05,0x3c,0xd8,0x78,0xdf,0x03,0xf6,0xd7,0xe1,0xc9,0x8f,0x7b,0xd9,0x9c,0xbe,0xb8,0x57,0xf2,0x5a,0xc4,0x27,0x26,0x1f,0x00}},
+    {{0xce,0xaa,0xec,0x7f,0xa0,0x29,0x9b,0xcd,0xcc,0xd3,0x63,0xb0,0x80,0xed,0xb1,0x2d,0x1c,0x04,0xd6,0x6a,0xd7,0x23,0x45,0x19,0x81,0xd4,0x9b,0x9a,0x45,0x24,0x95,0x49,0x00}},
+    {{0xce,0xf0,0x10,0xeb,0xbc,0x11,0xe8,0x54,0x4e,0x77,0xee,0x9b,0x32,0x09,0x18,0x93,0xce,0x3e,0xf8,0x44,0xb3,0xc3,0xc2,0x91,0xd3,0x5a,0x8b,0x8a,0x70,0xcd,0xb3,0x0c,0x01}},
+    {{0xd0,0xd4,0x04,0xa8,0xaf,0x4e,0x1f,0xaf,0x40,0xd6,0xa4,0x3b,0x69,0x36,0x2c,0x81,0x13,0x87,0x17,0xf8,0x61,0x63,0xb6,0x92,0x61,0x40,0xc2,0xbc,0x02,0x13,0xbc,0x6e,0x01}},
+    {{0xd1,0x17,0xfe,0xa0,0x6f,0xb2,0x8b,0x2b,0x30,0xf4,0x67,0x63,0xec,0x04,0xa9,0xc7,0x7e,0xf8,0xa7,0xde,0xf0,0x44,0x67,0xe9,0xe6,0x85,0x21,0x13,0x92,0x8d,0xa5,0x8b,0x01}},
+    {{0xd1,0x20,0xa9,0x4f,0x6c,0x4c,0xeb,0x7d,0xd3,0x71,0x92,0xf6,0xd9,0x32,0x2b,0x52,0xef,0x04,0xa7,0x27,0xd7,0x85,0x69,0x98,0xdd,0x5e,0x23,0xad,0xcf,0x5a,0xd9,0x8a,0x01}},
+    {{0xd1,0x70,0x1c,0xea,0x9d,0x7d,0xd9,0x36,0xe9,0xa4,0x60,0x21,0x29,0x6f,0x9d,0x1a,0xb2,0x5b,0x78,0xc7,0x4a,0x93,0x89,0xe9,0xc6,0x18,0x28,0xdc,0x18,0x1a,0x7e,0x87,0x00}},
+    {{0xd3,0x05,0x42,0x4e,0xb2,0x46,0xa9,0x79,0x4e,0xff,0xaa,0x0f,0xd6,0xd9,0xb0,0x54,0x97,0x39,0xb4,0x58,0x49,0x6f,0xc0,0xda,0x69,0xff,0x9f,0xa9,0x84,0x7e,0x76,0x3e,0x00}},
+    {{0xd3,0x21,0x28,0xd3,0x1d,0xfd,0x08,0x8b,0x50,0xaf,0x24,0x83,0x81,0xb5,0x9a,0xb5,0x5d,0x28,0xaa,0x85,0xf3,0x9b,0x0e,0x84,0x3f,0x6e,0x4a,0x9e,0x6d,0x64,0x1e,0x8f,0x00}},
+    {{0xd4,0x81,0x86,0x91,0x60,0xac,0x5b,0xd7,0x0a,0xaf,0x16,0x0c,0xa3,0xe4,0x00,0x8f,0xe6,0xf1,0x3b,0xe4,0xb2,0x9a,0x7d,0x23,0x99,0x22,0x83,0x90,0x66,0xa1,0x95,0x30,0x01}},
+    {{0xd4,0xf2,0x1b,0x55,0xa9,0x77,0x35,0x17,0x67,0xed,0xe6,0x8e,0x6c,0xf3,0xfa,0xf5,0xef,0xfd,0xf6,0x24,0xf6,0x19,0x18,0x6a,0x06,0x70,0xde,0x42,0xe7,0xf2,0x35,0xa4,0x00}},
+    {{0xd5,0x77,0xb8,0xac,0x9d,0x00,0x69,0xf2,0x07,0x11,0x3d,0x53,0x79,0x16,0x40,0x00,0xb1,0x68,0xac,0x9c,0x40,0x90,0x02,0x68,0x32,0x1b,0x0c,0x5b,0x38,0x78,0x10,0xfe,0x00}},
+    {{0xd5,0xd0,0x0a,0xf7,0x1f,0x16,0x44,0x42,0xb8,0xe8,0x1b,0x52,0x22,0x16,0x14,0x22,0xe2,0x83,0x15,0x56,0x27,0x50,0x9b,0xa7,0x08,0xff,0xf2,0x6e,0xce,0xd1,0x36,0x9b,0x00}},
+    {{0xd6,0x0d,0x1a,0xf4,0x45,0xab,0xe3,0x7e,0xfd,0xab,0xf7,0x4d,0xc5,0x11,0x9f,0x5d,0x22,0x1f,0xe6,0xe3,0x73,0xce,0xc8,0xef,0x31,0x21,0xb8,0x84,0xe5,0xa8,0xa8,0x26,0x01}},
+    {{0xd6,0x20,0x2b,0xe5,0xea,0x12,0x9a,0x60,0x49,0xff,0x93,0xea,0x4a,0xab,0x7c,0x80,0xb5,0x11,0x84,0xec,0x5a,0xf1,0x99,0x41,0xed,0x56,0xac,0xcb,0xb8,0xf0,0xbd,0x91,0x00}},
+    {{0xd7,0x20,0x3e,0xaa,0xbc,0xee,0xaf,0x5e,0x2b,0x14,0x69,0xec,0x97,0xbe,0xd9,0x0c,0x67,0x96,0x72,0x58,0xf7,0xf0,0x73,0xc7,0xef,0x98,0x19,0x1d,0x02,0xa2,0xb8,0x1e,0x01}},
+    {{0xd7,0x62,0xa2,0x01,0xee,0x83,0xc2,0x16,0x4b,0x70,0xad,0xe5,0x8f,0x78,0x95,0x9e,0xe7,0x42,0x60,0x93,0x8e,0xc7,0x03,0x0e,0x64,0x51,0xd1,0x16,0xf3,0x15,0xef,0xb2,0x00}},
+    {{0xd8,0x52,0x05,0x2b,0x19,0xec,0xa6,0x92,0x9d,0x8e,0x8b,0x4a,0x0a,0x7d,0xb9,0x54,0x87,0x99,0x6a,0x9b,0xe7,0x65,0x8e,0x2d,0xc9,0x89,0x7b,0xa7,0xc1,0xa5,0x6c,0x8b,0x01}},
+    {{0xd8,0x67,0x0d,0x1a,0x50,0x96,0x8a,0x0e,0x58,0xe9,0xa8,0xe2,0xef,0xbd,0xf2,0x96,0x09,0xc5,0x7d,0x35,0xb0,0x66,0x59,0x3c,0x58,0x92,0x94,0x03,0x8e,0xc8,0x32,0x40,0x01}},
+    {{0xd8,0x81,0xe9,0xeb,0xd7,0xce,0xc6,0x59,0x7c,0xd6,0x91,0x94,0xd7,0x2f,0x7b,0x62,0x1d,0x4d,0x3d,0x1e,0x10,0x82,0xe7,0x94,0x8b,0x1f,0x34,0xfc,0xca,0x00,0xb3,0x8e,0x00}},
+    {{0xd8,0x88,0xf3,0x46,0xfa,0xfe,0x97,0xcb,0x02,0xba,0xcb,0xeb,0x48,0x7e,0xe7,0xe4,0x31,0x48,0x13,0xc8,0xea,0x05,0x36,0x57,0xbd,0x5c,0x07,0x1f,0x61,0x57,0x34,0xf4,0x00}},
+    {{0xd9,0x11,0xb2,0xb1,0x43,0x7d,0xf2,0x44,0x5b,0x47,0xe1,0x20,0xe5,0x48,0xa2,0x27,0xdb,0xa4,0x0e,0x5e,0x63,0xa0,0xe5,0x0b,0x18,0x4e,0x1f,0x0a,0x1d,0xbc,0x6d,0x20,0x00}},
+    {{0xdb,0x1a,0x97,0x85,0xe9,0x5e,0x63,0x36,0x12,0xe0,0x39,0xca,0x33,0x92,0xce,0xd8,0xc4,0x32,0x0c,0xb4,0xfb,0x95,0x74,0x27,0x12,0xa7,0xe2,0x08,0xe3,0xaa,0xef,0x1b,0x00}},
+    {{0xdb,0xbd,0x20,0x77,0xd9,0x53,0x06,0xe6,0xf3,0x0c,0x1b,0x14,0x62,0xae,0x74,0x86,0xa7,0x6a,0x6d,0xff,0xb3,0x0b,0x0c,0x3e,0x05,0x70,0x96,0x20,0x68,0x65,0xac,0x87,0x01}},
+    {{0xdc,0x76,0x09,0x83,0xf7,0x7f,0x8d,0x98,0xa4,0xf4,0x5b,0xe8,0x4e,0xfc,0x40,0xb8,0x71,0xf4,0xe8,0x1e,0x0f,0x54,0xd1,0x96,0x30,0x58,0x82,0xa2,0x6b,0x72,0xab,0x34,0x01}},
+    {{0xdd,0x30,0xe4,0x94,0xd3,0x55,0xa1,0xef,0x9c,0xf3,0x9f,0x2a,0x11,0x81,0x47,0x00,0x3e,0x76,0x80,0xb9,0xe3,0x91,0x18,0xf3,0xb7,0xc9,0xf9,0x5d,0x79,0x40,0x46,0x2d,0x00}},
+    {{0xdd,0x52,0xfc,0x49,0xcd,0x36,0xb6,0x6d,0xd1,0x0c,0x7c,0xd2,0xeb,0x39,0xb1,0x1f,0x83,0x8a,0x5d,0x1e,0x08,0xe8,0xed,0x9e,0x69,0x08,0x09,0xa4,0xac,0x44,0x22,0x66,0x00}},
+    {{0xdd,0x60,0x40,0xee,0xa4,0x85,0x1d,0x12,0x63,0x9c,0x86,0x82,0x16,0xc4,0xde,0x22,0x4b,0x18,0xe9,0xf5,0x04,0x7d,0xa3,0xf0,0xa4,0xac,0xde,0x2f,0x09,0x63,0x38,0x01,0x01}},
+    {{0xdd,0x83,0x83,0x87,0x25,0x9c,0x54,0xf0,0x4c,0x05,0x06,0x88,0xe7,0x02,0x73,0x93,0xd0,0x2f,0xfc,0xaf,0xa9,0xce,0xc9,0x28,0x76,0x6b,0x4b,0x16,0xf1,0x33,0x02,0xc9,0x00}},
+    {{0xde,0x51,0x94,0xe1,0x7b,0x84,0xa5,0x27,0xa0,0x1f,0x5d,0xb6,0x67,0xa7,0x9b,0x82,0x0b,0x46,0x26,0xfe,0x54,0x78,0x03,0xc0,0xb7,0xa7,0x42,0x31,0x39,0x82,0xda,0x97,0x00}},
+    {{0xde,0xa9,0x49,0x60,0xd8,0x83,0x83,0x8b,0x2c,0x32,0x60,0x68,0x69,0x2e,0x87,0xb9,0x22,0xe6,0x27,0xac,0x86,0xf3,0xaa,0x2b,0xda,0x72,0x0e,0xd5,0x6b,0x00,0xf7,0x07,0x00}},
+    {{0xe0,0x1b,0x02,0xa4,0x26,0xe3,0x32,0xf5,0x85,0xda,0x44,0x2f,0x19,0x59,0x52,0xce,0xac,0x55,0x98,0x6e,0x55,0x7d,0x57,0xcc,0x5b,0xe6,0xdf,0xe4,0x73,0xb8,0x6b,0xb5,0x00}},
+    {{0xe0,0x2e,0xc8,0x8a,0xfe,0x3d,0x45,0x7a,0xc4,0x90,0x60,0xec,0xda,0xee,0xd3,0x6a,0x71,0x6e,0x1e,0x72,0xab,0x02,0x77,0x87,0x8b,0x25,0xfd,0x68,0x21,0xe4,0x91,0xf5,0x00}},
+    {{0xe0,0x58,0xfd,0x39,0xc3,0xe2,0x08,0x6b,0x59,0xe4,0x1f,0xc8,0xcb,0x9a,0xdd,0x9e,0x1b,0xe2,0x4a,0x7a,0xd8,0xf0,0x01,0x0a,0xb2,0xd6,0x41,0x06,0x1e,0x69,0xfa,0xfd,0x00}},
+    {{0xe1,0x1d,0x49,0xed,0xf9,0xe9,0xd3,0xeb,0x7e,0xfe,0x59,0xc6,0xcd,0x1c,0x34,0x24,0x98,0x38,0x2f,0xbe,0x94,0xcd,0x1c,0xe2,0x40,0x55,0x43,0x49,0xfb,0x89,0xac,0xd7,0x00}},
+    {{0xe2,0x90,0xdb,0x3f,0xac,0xab,0x3d,0x4c,0x7b,0x68,0x1d,0x92,0x97,0xf5,0x88,0xe9,0x03,0x0b,0xe7,0x69,0x56,0x5f,0x17,0x2f,0x80,0xab,0x89,0x54,0xe3,0x15,0x20,0x15,0x01}},
+    {{0xe3,0x2f,0x25,0x13,0xbe,0x15,0xd1,0x94,0x36,0x89,0x34,0xed,0x84,0xf2,0xa3,0x5e,0x44,0x48,0x84,0x52,0x81,0xec,0xfb,0x6a,0x0c,0xac,0xb6,0xc2,0x6a,0x29,0xe6,0x5c,0x01}},
+    {{0xe3,0x3b,0x06,0xfc,0x79,0xaf,0x79,0xb6,0x95,0x23,0x51,0x63,0x5e,0x3c,0x9a,0xba,0xc9,0xed,0x17,0x29,0x37,0x55,0xde,0x01,0x27,0xbb,0x66,0xb1,0x79,0x3e,0x49,0x5c,0x01}},
+    {{0xe3,0x9e,0x73,0xb6,0xa6,0xd2,0x8f,0x8f,0x5c,0x15,0xfa,0x15,0xa8,0x07,0xf1,0x3e,0x07,0x90,0x80,0xef,0x44,0x02,0x0b,0xcc,0xe4,0x42,0x28,0xad,0x12,0xd8,0x51,0x45,0x01}},
+    {{0xe3,0xc1,0x77,0xbb,0xbe,0xcd,0x48,0xc1,0x45,0x1e,0xf3,0xef,0x89,0x48,0x33,0x9f,0x13,0x23,0x4d,0x1c,0x1e,0x78,0xa5,0xcf,0xf3,0x9f,0x13,0x01,0xe1,0x51,0x9f,0x09,0x01}},
+    {{0xe3,0xd2,0x15,0x4d,0xff,0x69,0xb1,0xc6,0x8c,0x19,0x19,0x26,0x8b,0x8a,0x0c,0xd0,0x52,0x4a,0xba,0x01,0x2e,0xdd,0xfd,0xed,0xbe,0x1b,0xba,0xfd,0x5e,0x72,0x1b,0x1a,0x01}},
+    {{0xe4,0x72,0x73,0x96,0x28,0x04,0xef,0x3a,0x42,0xa1,0x26,0xbc,0xfe,0xd7,0xd2,0xf6,0x0d,0xcf,0xcc,0xed,0x15,0x2e,0xcb,0xff,0x21,0xf7,0x10,0x95,0x07,0xa1,0x98,0x09,0x00}},
+    {{0xe4,0xdb,0xf7,0xd4,0x56,0xe6,0x67,0x40,0xba,0x83,0xa1,0xad,0x53,0x91,0x71,0xfa,0x94,0x0e,0x5a,0x3c,0xb7,0xec,0x5c,0x4a,0xcc,0xcf,0xf6,0x28,0x4d,0x75,0x62,0x1e,0x01}},
+    {{0xe6,0x96,0xcb,0x15,0x7b,0xa0,0xf7,0x83,0x63,0x6d,0xa1,0x2e,0x7c,0xcd,0xd8,0xe9,0x33,0x6e,0xba,0xa3,0x65,0xc1,0xeb,0x1b,0x5c,0xc3,0x09,0x4c,0x8d,0xec,0xd0,0x70,0x00}},
+    {{0xe9,0x96,0x50,0xc2,0xa8,0x9f,0xc3,0x12,0x16,0x26,0x74,0x88,0x05,0xe2,0x5c,0x04,0x54,0x53,0x02,0x57,0x62,0xf4,0x7f,0x81,0x76,0xb9,0xe4,0xcc,0x84,0x2c,0xbb,0x2e,0x01}},
+    {{0xea,0x2b,0xe0,0x68,0xd3,0xa4,0xd4,0x91,0xf2,0xaf,0xd0,0x6c,0xf5,0xa3,0xa2,0x57,0x01,0xf8,0xe3,0xcc,0x5d,0x44,0x70,0x9e,0x43,0x88,0xd5,0x80,0x25,0x8a,0xd7,0xb9,0x00}},
+    {{0xea,0x31,0xfd,0x38,0x7b,0xe3,0xba,0x61,0xb6,0x14,0xd8,0xa5,0x0b,0xc0,0xa1,0xba,0x92,0x6d,0xfb,0xa8,0xbd,0xc6,0xaa,0xef,0x87,0x63,0x16,0x5d,0xff,0x25,0x97,0x80,0x01}},
+    {{0xec,0x36,0xc8,0x98,0x32,0xf4,0x8a,0xcf,0x19,0x8d,0x10,0x03,0x29,0x37,0x7b,0x8d,0xbb,0x70,0x50,0xb5,0xe7,0x11,0xe9,0xde,0xe6,0x44,0x5d,0xf9,0x2e,0x97,0xed,0x82,0x01}},
+    {{0xec,0x4a,0x2e,0x3e,0x7b,0xb8,0x01,0xe8,0x6a,0xba,0xcd,0x60,0x67,0x98,0x9a,0xea,0x8f,0x85,0xf1,0x91,0x87,0x6f,0x69,0x9f,0x81,0x27,0x6f,0xba,0x4e,0x50,0x53,0x1a,0x01}},
+    {{0xec,0xd0,0x63,0xb6,0xc5,0x6c,0xa0,0x36,0x73,0xe6,0x77,0x46,0x73,0xf2,0x90,0xc6,0xb7,0x86,0x9d,0xcb,0x10,0x86,0xa7,0xff,0x89,0x95,0x13,0x58,0xd3,0xd6,0x49,0x45,0x01}},
+    {{0xec,0xe0,0xa6,0x8f,0x72,0x2d,0x89,0x07,0x1e,0x2b,0x75,0xfd,0x34,0x21,0x56,0xfe,0x3e,0xab,0x45,0x4a,0xc7,0x22,0xe2,0xce,0xf2,0x2f,0xa0,0x3c,0x39,0x60,0x39,0xbc,0x00}},
+    {{0xed,0x77,0xb4,0xbd,0x60,0xc6,0x9b,0x88,0xa3,0xc6,0x72,0x77,0x9c,0x49,0x26,0xd8,0xd5,0x8a,0xf8,0xbb,0x43,0xa6,0x45,0x99,0xde,0xd6,0x0f,0x4c,0xab,0x9a,0x87,0x5c,0x00}},
+    {{0xee,0x2b,0xb7,0xae,0xa9,0x07,0xae,0xa6,0x28,0xb7,0x28,0xb5,0x4d,0x45,0xd7,0xc2,0x50,0x4c,0x20,0xb0,0x8b,0x59,0x48,0x06,0x4b,0xe5,0x4b,0x7d,0x6f,0xf7,0xfe,0x96,0x01}},
+    {{0xee,0x8f,0x89,0xeb,0x98,0x66,0x36,0x52,0x88,0x6c,0x55,0xe4,0x84,0xbd,0xd4,0xfd,0x21,0xe0,0x7b,0x02,0x4f,0xce,0xe1,0xb4,0x84,0x98,0xf2,0x5c,0x1a,0x72,0xa3,0x76,0x01}},
+    {{0xee,0xc4,0x19,0xf1,0x2d,0xfd,0xae,0x62,0xd7,0xd4,0xc1,0x50,0xe5,0x72,0x8e,0x07,0x29,0xdc,0xe0,0xe9,0xc8,0xe1,0xd7,0x1f,0xd7,0xaa,0x38,0xf1,0x98,0xf2,0x99,0xb4,0x00}},
+    {{0xf0,0x4b,0x26,0xa6,0xc0,0x89,0xc0,0x99,0x87,0x06,0xca,0x6a,0xbf,0x83,0x11,0xaf,0x04,0xce,0x18,0x6f,0xd1,0x7c,0x56,0x7c,0xe2,0x0a,0x6c,0x51,0xf0,0x7f,0x55,0x65,0x00}},
+    {{0xf0,0xb0,0xde,0x3b,0x99,0x56,0xd4,0x0d,0x39,0x9c,0x04,0x61,0x19,0x8a,0xcb,0xbe,0x0a,0xec,0x00,0x77,0xff,0xff,0xa6,0x2e,0xdb,0x26,0x5f,0x9d,0xdf,0xb5,0xfe,0x79,0x01}},
+    {{0xf0,0xf9,0x26,0xcf,0x42,0x88,0xc8,0xa9,0x16,0xd6,0x19,0x8c,0x6c,0x85,0x1d,0xbb,0xe4,0x59,0x10,0xb0,0x40,0xb8,0xb2,0x4d,0x2e,0x4d,0x80,0x9b,0x28,0x8f,0x5c,0x72,0x00}},
+    {{0xf1,0xab,0x37,0xe8,0x29,0x93,0x42,0x7c,0x47,0xdd,0xdb,0x50,0x12,0x50,0x31,0xf8,0xbe,0x13,0x9c,0x5d,0xc0,0x9e,0xaf,0x15,0xc7,0x81,0x19,0xab,0x9e,0xe0,0xf3,0x04,0x00}},
+    {{0xf2,0x68,0xe7,0x7e,0x3a,0xc8,0xf8,0xeb,0x9b,0x38,0x4c,0x19,0xa1,0x25,0x95,0xd1,0xd7,0x5a,0x2f,0xe5,0x45,0x7b,0xb1,0x9b,0xef,0xab,0x80,0x99,0xf8,0x30,0x15,0x90,0x00}},
+    {{0xf2,0xd1,0xd8,0x6f,0x6b,0x67,0xaa,0x31,0x75,0x08,0x76,0xff,0xaf,0xcd,0x1f,0xe9,0x0f,0x3b,0xb6,0x59,0x4c,0x98,0x45,0x02,0x89,0x9f,0x31,0x7f,0x3e,0x1b,0x8b,0xb6,0x00}},
+    {{0xf3,0x14,0x26,0x00,0x53,0xce,0xf2,0x1e,0xf9,0xab,0x52,0x2d,0x11,0x5f,0x17,0x13,0xc6,0xa4,0x9b,0x1c,0x22,0x43,0x27,0xd9,0x41,0xb5,0x36,0x09,0x19,0xd2,0x4c,0x27,0x00}},
+    {{0xf3,0x85,0x97,0x77,0xd6,0x0a,0x86,0x1c,0x55,0xc6,0xb3,0xfb,0x22,0x43,0x68,0xa2,0x53,0xd6,0x4a,0xc5,0x57,0x75,0x05,0xb6,0xe7,0xfe,0x54,0xfe,0x70,0xaf,0x8c,0x44,0x00}},
+    {{0xf4,0x1e,0x9e,0x09,0x2a,0xa2,0xf9,0xa0,0x10,0x39,0xdc,0xda,0x9e,0x8a,0x20,0x17,0x62,0x08,0xb5,0xa3,0xb6,0x9d,0x42,0xf1,0x6c,0x38,0xe6,0x5f,0xda,0x47,0xe6,0x84,0x00}},
+    {{0xf5,0x66,0x12,0x95,0x7e,0xad,0x6d,0x91,0x3d,0x91,0x49,0x6b,0x65,0xf3,0x5f,0x5f,0x56,0xc8,0xa7,0x96,0xa3,0xd1,0x03,0xd4,0x22,0xce,0x35,0x76,0x7a,0x12,0x71,0x46,0x00}},
+    {{0xf5,0x86,0x1b,0xf8,0x53,0x6c,0xb4,0x7d,0x78,0xd6,0x68,0xee,0x54,0x98,0x51,0x56,0xbf,0x2f,0x2f,0xdb,0x5c,0xf5,0x9a,0x69,0xf6,0x80,0x96,0x70,0x25,0xb1,0x8e,0x5e,0x00}},
+    {{0xf5,0xac,0xb4,0xed,0xf5,0xdb,0x3b,0x71,0x81,0x4d,0x90,0x11,0xc9,0xb3,0x64,0x50,0xa3,0x87,0x1b,0xb6,0x80,0x5e,0x99,0x4d,0x48,0x54,0xa3,0xe8,0x90,0x9d,0xc2,0x0e,0x00}},
+    {{0xf5,0xda,0x29,0x45,0x69,0x79,0x5d,0x8b,0xa9,0xc5,0x12,0xa9,0xd5,0x28,0x39,0x8c,0xd5,0xbf,0xe8,0x8e,0x4e,0xbf,0xc0,0x83,0xe3,0x6c,0x3c,0x89,0xae,0x24,0x3d,0x3d,0x00}},
+    {{0xf7,0x23,0x50,0x79,0x36,0x13,0x6c,0xcf,0x7c,0x51,0xc6,0xe0,0xbb,0x28,0x5d,0xb5,0x13,0x99,0xb3,0x8c,0x91,0x60,0x57,0x33,0x71,0x83,0x98,0xf4,0x65,0x68,0x90,0x82,0x00}},
+    {{0xf7,0x24,0x1f,0xc7,0xb2,0xd4,0x7a,0x18,0xcc,0x21,0xc9,0x2c,0x20,0x90,0x9a,0x1f,0x1f,0x8d,0x99,0x33,0xaa,0x2c,0xde,0xe0,0x39,0x81,0x22,0xd8,0x9f,0x24,0xf6,0x36,0x00}},
+    {{0xf7,0x60,0x8c,0x58,0x0f,0x9f,0xcc,0x07,0xdc,0x0b,0xf6,0x96,0x2f,0xea,0x16,0xf7,0x7a,0xb5,0x68,0x79,0xb3,0x1f,0x82,0xef,0x14,0x6b,0x5e,0x06,0x65,0x6b,0xde,0x45,0x00}},
+    {{0xf7,0xfc,0xc9,0x2c,0x8c,0xac,0x3e,0x26,0xa1,0xed,0x1e,0xa8,0x7e,0xae,0x69,0x05,0xa2,0x78,0x52,0x85,0x93,0x40,0x8b,0x57,0x29,0x92,0xf3,0x7a,0xf7,0xa2,0xac,0x01,0x00}},
+    {{0xf8,0xc8,0x33,0x64,0xb0,0x98,0x75,0x70,0x36,0xdf,0x48,0x9a,0xbd,0xd9,0xd4,0x81,0xa4,0xde,0x35,0xd8,0x78,0xb8,0xba,0xe6,0x76,0x42,0x3e,0xb5,0xcf,0xb6,0x70,0x44,0x01}},
+    {{0xf9,0x75,0x46,0x79,0x9f,0x2f,0x97,0x41,0x34,0x8a,0x62,0x3e,0x90,0x3f,0x81,0xff,0xa9,0x57,0xae,0x53,0x98,0x30,0xd7,0xb2,0xe3,0x36,0x54,0x70,0xc4,0xaf,0x52,0xb6,0x00}},
+    {{0xfa,0x0e,0xbb,0x19,0x11,0x8e,0x7e,0xea,0x38,0xab,0xb8,0xfc,0x1c,0xae,0x7c,0x99,0xd3,0x92,0x8e,0x7b,0x66,0x40,0x5a,0xe4,0xf6,0x3f,0xcc,0x4c,0xe1,0xc6,0x1f,0x68,0x01}},
+    {{0xfa,0x45,0xd4,0x71,0x01,0x4e,0x5c,0x4d,0x66,0x3d,0x4d,0x35,0x3f,0xe1,0x23,0x3f,0x9b,0x1b,0xc8,0x75,0xaf,0x2d,0x79,0xf6,0x58,0x56,0x36,0x91,0xe9,0x70,0x79,0x6e,0x01}},
+    {{0xfa,0x96,0xd9,0xc7,0x6b,0xa6,0x7b,0x3d,0xca,0x0a,0xdc,0xc0,0x86,0x7b,0x02,0xa2,0x09,0x7c,0xa0,0x1d,0xe5,0xdd,0x26,0x8d,0x3f,0xe2,0x11,0x2e,0x3d,0x6e,0x32,0x36,0x00}},
+    {{0xfa,0xde,0xb8,0xb1,0x1c,0x7f,0xb8,0xaf,0xbe,0x36,0xf7,0x4d,0xec,0x94,0x30,0xe4,0xff,0xc3,0x5f,0x54,0xbd,0xa1,0x3d,0x72,0x35,0x93,0xb1,0x70,0x7f,0xa2,0xe0,0x37,0x00}},
+    {{0xfa,0xf8,0xf8,0x0c,0x0e,0xb3,0x12,0x45,0x32,0xd9,0xb8,0xc5,0xd2,0x55,0x04,0xd9,0x41,0x76,0x7e,0x1f,0xc4,0x58,0xd6,0xe4,0xbe,0x31,0x15,0xc2,0x3d,0xce,0xb7,0x4b,0x00}},
+    {{0xfb,0x1d,0x57,0x4a,0x98,0xce,0x01,0x2e,0x50,0xfd,0x11,0x8d,0x7d,0xbc,0x13,0xf8,0xcd,0x23,0x55,0xb8,0xe6,0x50,0xcd,0x03,0x62,0x41,0x45,0x1d,0x38,0x25,0x67,0x3f,0x00}},
+    {{0xfb,0x4a,0x7f,0x0c,0xcc,0xc4,0x06,0x10,0x54,0x76,0x52,0x3f,0x60,0x0d,0x24,0x26,0xb2,0x0a,0x09,0x0b,0xcd,0x3f,0xbd,0xff,0x7a,0x0e,0x0c,0x62,0xa1,0xf7,0x6b,0xad,0x00}},
+    {{0xfb,0x77,0xf3,0xfb,0x8d,0x7e,0x7d,0xf0,0x1d,0xe2,0x07,0x6e,0xaa,0x21,0xd0,0x25,0xa9,0x87,0x92,0x3a,0xa1,0x2b,0x74,0x5e,0x65,0xe2,0x8e,0xb0,0xe2,0x41,0xf6,0x64,0x00}},
+    {{0xfd,0x01,0x4b,0x07,0x8b,0x0b,0x39,0x88,0x42,0x5c,0xc8,0x2c,0xb4,0xe9,0x27,0xe6,0x12,0x6c,0x74,0x6b,0x95,0xf0,0xc0,0x04,0xf0,0x26,0x7c,0x4f,0xca,0x6a,0x6f,0xa1,0x00}},
+    {{0xfd,0xe3,0x7a,0xa8,0x75,0x45,0xe4,0x35,0x30,0xf5,0xe7,0x21,0x25,0x29,0x33,0x6e,0xc2,0x0e,0x42,0x86,0x5d,0x4a,0xd2,0x6e,0x18,0x7f,0xdf,0x3d,0xf3,0xd3,0xce,0xfa,0x00}},
+    {{0xfe,0x00,0xa5,0xda,0xfb,0x46,0xfa,0x69,0xee,0x32,0xc3,0x89,0x64,0x73,0x69,0x9e,0x1b,0xc0,0x5f,0x7d,0xbd,0x20,0x5d,0xde,0xe2,0x0a,0x8d,0xd7,0x64,0xdb,0x4f,0x69,0x01}},
+    {{0xfe,0x44,0x44,0x00,0x4b,0x6f,0xa5,0x04,0x32,0x7a,0x8b,0x54,0x37,0xb8,0xa4,0x2c,0x7e,0xdd,0x04,0x52,0x24,0xd2,0x71,0x5b,0x75,0x6c,0xdb,0xa5,0x59,0xe5,0x58,0xbe,0x00}},
+    {{0xfe,0x4d,0xef,0xae,0x47,0x09,0x05,0x57,0xd5,0xf7,0xb5,0xe7,0x24,0xe6,0x26,0xb7,0xee,0xe9,0x03,0x9b,0x0a,0x13,0x74,0x0a,0x6c,0x45,0xdd,0x3f,0x97,0xb2,0x8c,0xbd,0x00}}
+};
+#endif // PIVX_INVALID_TABLES_H
@@ -59,6 +59,11 @@ public:
 
         batch.Delete(slKey);
     }
+
+    void Clear()
+    {
+        batch.Clear();
+    }
 };
 
 class CLevelDBWrapper
@@ -164,9 +169,10 @@ public:
     }
 
     // not exactly clean encapsulation, but it's easiest for now
-    leveldb::Iterator* NewIterator()
+    // fFillCache: use for short lookups whose blocks are worth keeping in the block cache
+    leveldb::Iterator* NewIterator(bool fFillCache = false)
     {
-        return pdb->NewIterator(iteroptions);
+        return pdb->NewIterator(fFillCache ? readoptions : iteroptions);
     }
 };
 
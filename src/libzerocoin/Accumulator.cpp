@@ -43,7 +43,20 @@ Accumulator::Accumulator(const ZerocoinParams* p, const CoinDenomination d, cons
 
 void Accumulator::increment(const CBigNum& bnValue) {
     // Compute new accumulator = "old accumulator"^{element} mod N
-    this->value = this->value.pow_mod(bnValue, this->params->accumulatorModulus);
+    // Both the accumulator and the element are public: use variable time
+    this->value = this->value.pow_mod_vartime(bnValue, this->params->accumulatorModulus);
+}
+
+void Accumulator::increment(const std::vector<CBigNum>& vValues) {
+    if (vValues.empty())
+        return;
+
+    // (acc^x1)^x2 = acc^(x1*x2): one exponentiation by the product
+    // of the elements instead of one per element
+    CBigNum bnProduct = vValues[0];
+    for (unsigned int i = 1; i < vValues.size(); i++)
+        bnProduct *= vValues[i];
+    increment(bnProduct);
 }
 
 void Accumulator::accumulate(const PublicCoin& coin) {
@@ -117,6 +130,10 @@ void AccumulatorWitness::addRawValue(const CBigNum& bnValue) {
         witness.increment(bnValue);
 }
 
+void AccumulatorWitness::addRawValues(const std::vector<CBigNum>& vValues) {
+    witness.increment(vValues);
+}
+
 const CBigNum& AccumulatorWitness::getValue() const {
     return this->witness.getValue();
 }
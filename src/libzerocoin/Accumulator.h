@@ -63,6 +63,14 @@ public:
     void accumulate(const PublicCoin &coin);
     void increment(const CBigNum& bnValue);
 
+    /**
+     * Accumulate several coin values at once, with a single
+     * exponentiation by their product. No checks performed!
+     *
+     * @param vValues    the coins' values to add
+     */
+    void increment(const std::vector<CBigNum>& vValues);
+
     CoinDenomination getDenomination() const;
     /** Get the accumulator result
      *
@@ -129,6 +137,12 @@ public:
      */
     void addRawValue(const CBigNum& bnValue);
 
+    /** Adds several elements at once, with a single exponentiation. No checks performed!
+     *
+     * @param vValues the coins' values to add
+     */
+    void addRawValues(const std::vector<CBigNum>& vValues);
+
     /**
      *
      * @return the value of the witness
@@ -118,14 +118,19 @@ bool AccumulatorProofOfKnowledge:: Verify(const Accumulator& a, const CBigNum& v
 
     CBigNum c = CBigNum(hasher.GetHash()); //this hash should be of length k_prime bits
 
-    CBigNum st_1_prime = (valueOfCommitmentToCoin.pow_mod(c, params->accumulatorPoKCommitmentGroup.modulus) * sg.pow_mod(s_alpha, params->accumulatorPoKCommitmentGroup.modulus) * sh.pow_mod(s_phi, params->accumulatorPoKCommitmentGroup.modulus)) % params->accumulatorPoKCommitmentGroup.modulus;
-    CBigNum st_2_prime = (sg.pow_mod(c, params->accumulatorPoKCommitmentGroup.modulus) * ((valueOfCommitmentToCoin * sg.inverse(params->accumulatorPoKCommitmentGroup.modulus)).pow_mod(s_gamma, params->accumulatorPoKCommitmentGroup.modulus)) * sh.pow_mod(s_psi, params->accumulatorPoKCommitmentGroup.modulus)) % params->accumulatorPoKCommitmentGroup.modulus;
-    CBigNum st_3_prime = (sg.pow_mod(c, params->accumulatorPoKCommitmentGroup.modulus) * (sg * valueOfCommitmentToCoin).pow_mod(s_sigma, params->accumulatorPoKCommitmentGroup.modulus) * sh.pow_mod(s_xi, params->accumulatorPoKCommitmentGroup.modulus)) % params->accumulatorPoKCommitmentGroup.modulus;
-
-    CBigNum t_1_prime = (C_r.pow_mod(c, params->accumulatorModulus) * h_n.pow_mod(s_zeta, params->accumulatorModulus) * g_n.pow_mod(s_epsilon, params->accumulatorModulus)) % params->accumulatorModulus;
-    CBigNum t_2_prime = (C_e.pow_mod(c, params->accumulatorModulus) * h_n.pow_mod(s_eta, params->accumulatorModulus) * g_n.pow_mod(s_alpha, params->accumulatorModulus)) % params->accumulatorModulus;
-    CBigNum t_3_prime = ((a.getValue()).pow_mod(c, params->accumulatorModulus) * C_u.pow_mod(s_alpha, params->accumulatorModulus) * ((h_n.inverse(params->accumulatorModulus)).pow_mod(s_beta, params->accumulatorModulus))) % params->accumulatorModulus;
-    CBigNum t_4_prime = (C_r.pow_mod(s_alpha, params->accumulatorModulus) * ((h_n.inverse(params->accumulatorModulus)).pow_mod(s_delta, params->accumulatorModulus)) * ((g_n.inverse(params->accumulatorModulus)).pow_mod(s_beta, params->accumulatorModulus))) % params->accumulatorModulus;
+    // Everything here is public: use variable time exponentiations, with the precomputed
+    // tables for the fixed bases of the commitment group (the QRN group has no known order)
+    const CBigNum& pokModulus = params->accumulatorPoKCommitmentGroup.modulus;
+    const CBigNum& accModulus = params->accumulatorModulus;
+    const IntegerGroupParams& pokGroup = params->accumulatorPoKCommitmentGroup;
+    CBigNum st_1_prime = valueOfCommitmentToCoin.pow_mod_vartime(c, pokModulus).mul_mod(pokGroup.pow_g_vartime(s_alpha).mul_mod(pokGroup.pow_h_vartime(s_phi), pokModulus), pokModulus);
+    CBigNum st_2_prime = (valueOfCommitmentToCoin * sg.inverse(pokModulus)).pow_mod_vartime(s_gamma, pokModulus).mul_mod(pokGroup.pow_g_vartime(c).mul_mod(pokGroup.pow_h_vartime(s_psi), pokModulus), pokModulus);
+    CBigNum st_3_prime = (sg * valueOfCommitmentToCoin).pow_mod_vartime(s_sigma, pokModulus).mul_mod(pokGroup.pow_g_vartime(c).mul_mod(pokGroup.pow_h_vartime(s_xi), pokModulus), pokModulus);
+
+    CBigNum t_1_prime = CBigNum::mul_pow_mod({C_r, h_n, g_n}, {c, s_zeta, s_epsilon}, accModulus);
+    CBigNum t_2_prime = CBigNum::mul_pow_mod({C_e, h_n, g_n}, {c, s_eta, s_alpha}, accModulus);
+    CBigNum t_3_prime = CBigNum::mul_pow_mod({a.getValue(), C_u, h_n.inverse(accModulus)}, {c, s_alpha, s_beta}, accModulus);
+    CBigNum t_4_prime = CBigNum::mul_pow_mod({C_r, h_n.inverse(accModulus), g_n.inverse(accModulus)}, {s_alpha, s_delta, s_beta}, accModulus);
 
     bool result_st1 = (st_1 == st_1_prime);
     bool result_st2 = (st_2 == st_2_prime);
@@ -38,8 +38,6 @@ bool CoinRandomnessSchnorrSignature::Verify(
 {
     const CBigNum p = zcparams->coinCommitmentGroup.modulus;
     const CBigNum q = zcparams->coinCommitmentGroup.groupOrder;
-    const CBigNum h = zcparams->coinCommitmentGroup.h;
-    const CBigNum g = zcparams->coinCommitmentGroup.g;
 
     // Params validation.
     if (!IsValidSerial(zcparams, S)) return error("%s: Invalid serial range", __func__);
@@ -47,10 +45,10 @@ bool CoinRandomnessSchnorrSignature::Verify(
     if (beta < BN_ZERO || beta >= q) return error("%s: beta out of range", __func__);
 
     // Schnorr public key computation.
-    const CBigNum pk = C.mul_mod(g.pow_mod(-S,p),p);
+    const CBigNum pk = C.mul_mod(zcparams->coinCommitmentGroup.pow_g_vartime(-S),p);
 
     // Signature verification.
-    const CBigNum rv = (pk.pow_mod(alpha,p)).mul_mod(h.pow_mod(beta,p),p);
+    const CBigNum rv = (pk.pow_mod_vartime(alpha,p)).mul_mod(zcparams->coinCommitmentGroup.pow_h_vartime(beta),p);
     CHashWriter hasher(0,0);
     hasher << *zcparams << pk << rv << msghash;
 
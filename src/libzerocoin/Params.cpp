@@ -14,8 +14,57 @@
 #include "Params.h"
 #include "ParamGeneration.h"
 
+#include <mutex>
+
 namespace libzerocoin {
 
+// Guards the lazily built fixed base tables of all the groups
+static std::mutex csFixedBaseTables;
+
+FixedBaseTable::FixedBaseTable(const CBigNum& baseIn, const CBigNum& modulusIn, const CBigNum& orderIn) :
+    base(baseIn), modulus(modulusIn), order(orderIn) {
+    // Reducing the exponents mod the order is only valid if base^order = 1
+    if (order <= BN_ONE || !base.pow_mod_vartime(order, modulus).isOne())
+        return;
+
+    const unsigned int nRows = (order.bitSize() + WINDOW_BITS - 1) / WINDOW_BITS;
+    table.reserve(nRows * ROW_SIZE);
+    CBigNum rowBase = base % modulus;
+    for (unsigned int i = 0; i < nRows; i++) {
+        // rowBase = base^(16^i): row i holds rowBase^1 ... rowBase^15
+        table.push_back(rowBase);
+        for (unsigned int d = 1; d < ROW_SIZE; d++)
+            table.push_back(table.back().mul_mod(rowBase, modulus));
+        rowBase = table.back().mul_mod(rowBase, modulus);
+    }
+}
+
+bool FixedBaseTable::Matches(const CBigNum& baseIn, const CBigNum& modulusIn) const {
+    return base == baseIn && modulus == modulusIn;
+}
+
+CBigNum FixedBaseTable::pow_mod(const CBigNum& e) const {
+    if (table.empty())
+        return base.pow_mod_vartime(e, modulus);
+
+    CBigNum x = e % order;
+    if (x < BN_ZERO)
+        x += order;
+
+    // little endian magnitude: every byte holds two windows of the exponent
+    const std::vector<unsigned char> vch = x.getvch();
+    CBigNum ret = BN_ONE;
+    for (unsigned int i = 0; i < vch.size() && i * 2 * ROW_SIZE < table.size(); i++) {
+        const unsigned int lo = vch[i] & 0x0f;
+        const unsigned int hi = vch[i] >> 4;
+        if (lo)
+            ret = ret.mul_mod(table[(2 * i) * ROW_SIZE + lo - 1], modulus);
+        if (hi)
+            ret = ret.mul_mod(table[(2 * i + 1) * ROW_SIZE + hi - 1], modulus);
+    }
+    return ret % modulus;
+}
+
 ZerocoinParams::ZerocoinParams(CBigNum N, uint32_t securityLevel) {
     this->zkp_hash_len = securityLevel;
     this->zkp_iterations = securityLevel;
@@ -45,4 +94,24 @@ CBigNum IntegerGroupParams::randomElement() const {
     return this->g.pow_mod(CBigNum::randBignum(this->groupOrder),this->modulus);
 }
 
+CBigNum IntegerGroupParams::PowFixedBase(std::shared_ptr<const FixedBaseTable>& table, const CBigNum& base, const CBigNum& e) const {
+    std::shared_ptr<const FixedBaseTable> t;
+    {
+        std::lock_guard<std::mutex> lock(csFixedBaseTables);
+        // (re)build the table if missing or if the group changed since
+        if (!table || !table->Matches(base, this->modulus))
+            table = std::make_shared<const FixedBaseTable>(base, this->modulus, this->groupOrder);
+        t = table;
+    }
+    return t->pow_mod(e);
+}
+
+CBigNum IntegerGroupParams::pow_g_vartime(const CBigNum& e) const {
+    return PowFixedBase(gTable, this->g, e);
+}
+
+CBigNum IntegerGroupParams::pow_h_vartime(const CBigNum& e) const {
+    return PowFixedBase(hTable, this->h, e);
+}
+
 } /* namespace libzerocoin */
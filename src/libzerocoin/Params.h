@@ -17,8 +17,37 @@
 #include "bignum.h"
 #include "ZerocoinDefines.h"
 
+#include <memory>
+
 namespace libzerocoin {
 
+/**
+ * Precomputed powers base^(d * 16^i) mod modulus of a fixed base, so that
+ * base^e needs one multiplication per 4 bits of e and no squaring.
+ * Exponents are reduced mod the order of the base, so the table only has to
+ * cover the bits of the order. Variable time: only use it on public exponents.
+ */
+class FixedBaseTable {
+public:
+	FixedBaseTable(const CBigNum& base, const CBigNum& modulus, const CBigNum& order);
+
+	/** Returns true if this is the table of base mod modulus */
+	bool Matches(const CBigNum& base, const CBigNum& modulus) const;
+
+	/** base^e mod modulus */
+	CBigNum pow_mod(const CBigNum& e) const;
+
+private:
+	static const unsigned int WINDOW_BITS = 4;
+	static const unsigned int ROW_SIZE = (1 << WINDOW_BITS) - 1;
+
+	CBigNum base;
+	CBigNum modulus;
+	CBigNum order;
+	// ROW_SIZE entries per window of the exponent, empty if base^order != 1
+	std::vector<CBigNum> table;
+};
+
 class IntegerGroupParams {
 public:
 	/** @brief Integer group class, default constructor
@@ -32,6 +61,16 @@ public:
 	 * @return a random element in the group.
 	 */
 	CBigNum randomElement() const;
+
+	/**
+	 * g^e and h^e mod modulus, using precomputed tables of the
+	 * powers of g and h, built on first use.
+	 * Variable time: only use them on public values, e.g. when
+	 * verifying proofs.
+	 */
+	CBigNum pow_g_vartime(const CBigNum& e) const;
+	CBigNum pow_h_vartime(const CBigNum& e) const;
+
 	bool initialized;
 
 	/**
@@ -56,6 +95,13 @@ public:
 	 */
 	CBigNum groupOrder;
 
+private:
+	mutable std::shared_ptr<const FixedBaseTable> gTable;
+	mutable std::shared_ptr<const FixedBaseTable> hTable;
+
+	CBigNum PowFixedBase(std::shared_ptr<const FixedBaseTable>& table, const CBigNum& base, const CBigNum& e) const;
+
+public:
 	ADD_SERIALIZE_METHODS;
   template <typename Stream, typename Operation>  inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion) {
 		    READWRITE(initialized);
@@ -14,6 +14,14 @@
 #include <streams.h>
 #include "SerialNumberSignatureOfKnowledge.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 namespace libzerocoin {
 
 SerialNumberSignatureOfKnowledge::SerialNumberSignatureOfKnowledge(const ZerocoinParams* p): params(p) { }
@@ -109,26 +117,118 @@ SerialNumberSignatureOfKnowledge::SerialNumberSignatureOfKnowledge(const
 }
 
 inline CBigNum SerialNumberSignatureOfKnowledge::challengeCalculation(const CBigNum& a_exp,const CBigNum& b_exp,
-        const CBigNum& h_exp) const {
+        const CBigNum& h_exp, bool fVarTime) const {
 
     CBigNum a = params->coinCommitmentGroup.g;
     CBigNum b = params->coinCommitmentGroup.h;
     CBigNum g = params->serialNumberSoKCommitmentGroup.g;
     CBigNum h = params->serialNumberSoKCommitmentGroup.h;
 
+    if (fVarTime) {
+        // public values only: all the bases are fixed, use their precomputed tables
+        // (the order of the serial number group is the modulus of the coin commitment group)
+        const CBigNum exponent = params->coinCommitmentGroup.pow_g_vartime(a_exp).mul_mod(
+                params->coinCommitmentGroup.pow_h_vartime(b_exp), params->serialNumberSoKCommitmentGroup.groupOrder);
+        return params->serialNumberSoKCommitmentGroup.pow_g_vartime(exponent).mul_mod(
+                params->serialNumberSoKCommitmentGroup.pow_h_vartime(h_exp), params->serialNumberSoKCommitmentGroup.modulus);
+    }
+
     CBigNum exponent = (a.pow_mod(a_exp, params->serialNumberSoKCommitmentGroup.groupOrder) *
             b.pow_mod(b_exp, params->serialNumberSoKCommitmentGroup.groupOrder)) % params->serialNumberSoKCommitmentGroup.groupOrder;
 
     return (g.pow_mod(exponent, params->serialNumberSoKCommitmentGroup.modulus) * h.pow_mod(h_exp, params->serialNumberSoKCommitmentGroup.modulus)) % params->serialNumberSoKCommitmentGroup.modulus;
 }
 
+/**
+ * Threads verifying the iterations of serial number proofs, started on first use
+ * and kept for the following proofs. One proof is verified at a time; a caller
+ * finding the workers busy verifies its proof on its own thread.
+ */
+class CVerifyWorkers
+{
+private:
+    std::mutex csRun;
+    std::mutex cs;
+    std::condition_variable condWork;
+    std::condition_variable condDone;
+    std::function<void(uint32_t, uint32_t)> job;
+    uint64_t nJob;
+    uint32_t nRunning;
+    bool fShutdown;
+    std::vector<std::thread> threads;
+
+    void Loop(uint32_t nWorker)
+    {
+        uint64_t nLastJob = 0;
+        while (true) {
+            std::function<void(uint32_t, uint32_t)> fn;
+            {
+                std::unique_lock<std::mutex> lock(cs);
+                condWork.wait(lock, [&] { return fShutdown || nJob != nLastJob; });
+                if (fShutdown)
+                    return;
+                nLastJob = nJob;
+                fn = job;
+            }
+            fn(nWorker, threads.size() + 1);
+            std::lock_guard<std::mutex> lock(cs);
+            if (--nRunning == 0)
+                condDone.notify_one();
+        }
+    }
+
+public:
+    CVerifyWorkers(uint32_t nThreads) : nJob(0), nRunning(0), fShutdown(false)
+    {
+        for (uint32_t t = 1; t < nThreads; t++)
+            threads.emplace_back(&CVerifyWorkers::Loop, this, t);
+    }
+
+    ~CVerifyWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(cs);
+            fShutdown = true;
+        }
+        condWork.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    /** Run fn(0, n) .. fn(n - 1, n) concurrently on n threads */
+    void Run(const std::function<void(uint32_t, uint32_t)>& fn)
+    {
+        std::unique_lock<std::mutex> lockRun(csRun, std::try_to_lock);
+        if (!lockRun.owns_lock() || threads.empty()) {
+            fn(0, 1);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(cs);
+            job = fn;
+            nRunning = threads.size();
+            nJob++;
+        }
+        condWork.notify_all();
+        fn(0, threads.size() + 1);
+        std::unique_lock<std::mutex> lock(cs);
+        condDone.wait(lock, [&] { return nRunning == 0; });
+        job = nullptr;
+    }
+};
+
+static CVerifyWorkers& GetVerifyWorkers()
+{
+    uint32_t nThreads = 1;
+#ifdef ZEROCOIN_THREADING
+    nThreads = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)ZEROCOIN_MAX_VERIFY_THREADS));
+#endif
+    static CVerifyWorkers workers(nThreads);
+    return workers;
+}
+
 bool SerialNumberSignatureOfKnowledge::Verify(const CBigNum& coinSerialNumber, const CBigNum& valueOfCommitmentToCoin,
         const uint256 msghash, bool isInParamsValidationRange) const {
-    CBigNum a = params->coinCommitmentGroup.g;
-    CBigNum b = params->coinCommitmentGroup.h;
-    CBigNum g = params->serialNumberSoKCommitmentGroup.g;
-    CBigNum h = params->serialNumberSoKCommitmentGroup.h;
-
     //// Params validation.
     if(isInParamsValidationRange) {
         // Check that the serial is within the max size
@@ -144,35 +244,59 @@ bool SerialNumberSignatureOfKnowledge::Verify(const CBigNum& coinSerialNumber, c
     CHashWriter hasher(0,0);
     hasher << *params << valueOfCommitmentToCoin << coinSerialNumber << msghash;
 
+    if (s_notprime.size() < params->zkp_iterations || sprime.size() < params->zkp_iterations)
+        return error("SoK Verify() :: wrong number of responses");
+
     std::vector<CBigNum> tprime(params->zkp_iterations);
-    unsigned char *hashbytes = (unsigned char*) &this->hash;
-
-    try {
-        for (uint32_t i = 0; i < params->zkp_iterations; i++) {
-            int bit = i % 8;
-            int byte = i / 8;
-            bool challenge_bit = ((hashbytes[byte] >> bit) & 0x01);
-            if (challenge_bit) {
-                CBigNum bn = SeedTo1024(sprime[i].getuint256());
-                if (bn > params->serialNumberSoKCommitmentGroup.groupOrder && isInParamsValidationRange)
-                    return error("SoK Verify() :: sprime in pos %d not in valid range", i);
-                tprime[i] = challengeCalculation(coinSerialNumber, s_notprime[i], bn);
-            } else {
-                CBigNum exp = b.pow_mod(s_notprime[i], params->serialNumberSoKCommitmentGroup.groupOrder);
-                tprime[i] = ((valueOfCommitmentToCoin.pow_mod(exp, params->serialNumberSoKCommitmentGroup.modulus) %
-                              params->serialNumberSoKCommitmentGroup.modulus) *
-                             (h.pow_mod(sprime[i], params->serialNumberSoKCommitmentGroup.modulus) %
-                              params->serialNumberSoKCommitmentGroup.modulus)) %
-                            params->serialNumberSoKCommitmentGroup.modulus;
+    const unsigned char *hashbytes = (const unsigned char*) &this->hash;
+
+    // The iterations are independent: compute the t' values of
+    // every n-th iteration on each of the n verify workers.
+    std::atomic<int> nInvalidPos(-1);
+    std::atomic<bool> fRangeError(false);
+    std::exception_ptr exception;
+    std::mutex csException;
+    auto computeTPrime = [&](uint32_t nStart, uint32_t nStep) {
+        try {
+            for (uint32_t i = nStart; i < params->zkp_iterations && nInvalidPos < 0 && !fRangeError; i += nStep) {
+                int bit = i % 8;
+                int byte = i / 8;
+                bool challenge_bit = ((hashbytes[byte] >> bit) & 0x01);
+                if (challenge_bit) {
+                    CBigNum bn = SeedTo1024(sprime[i].getuint256());
+                    if (bn > params->serialNumberSoKCommitmentGroup.groupOrder && isInParamsValidationRange) {
+                        nInvalidPos = i;
+                        return;
+                    }
+                    tprime[i] = challengeCalculation(coinSerialNumber, s_notprime[i], bn, true);
+                } else {
+                    CBigNum exp = params->coinCommitmentGroup.pow_h_vartime(s_notprime[i]);
+                    tprime[i] = valueOfCommitmentToCoin.pow_mod_vartime(exp, params->serialNumberSoKCommitmentGroup.modulus).mul_mod(
+                            params->serialNumberSoKCommitmentGroup.pow_h_vartime(sprime[i]), params->serialNumberSoKCommitmentGroup.modulus);
+                }
             }
+        } catch (const std::range_error& e) {
+            fRangeError = true;
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(csException);
+            exception = std::current_exception();
+            fRangeError = true;
         }
-        for (uint32_t i = 0; i < params->zkp_iterations; i++) {
-            hasher << tprime[i];
-        }
-        return hasher.GetHash() == hash;
-    } catch (const std::range_error& e) {
+    };
+
+    GetVerifyWorkers().Run(computeTPrime);
+
+    if (exception)
+        std::rethrow_exception(exception);
+    if (nInvalidPos >= 0)
+        return error("SoK Verify() :: sprime in pos %d not in valid range", (int)nInvalidPos);
+    if (fRangeError)
         return error("SoK Verify() :: sprime invalid range.");
+
+    for (uint32_t i = 0; i < params->zkp_iterations; i++) {
+        hasher << tprime[i];
     }
+    return hasher.GetHash() == hash;
 }
 
 } /* namespace libzerocoin */
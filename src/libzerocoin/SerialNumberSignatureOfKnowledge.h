@@ -67,8 +67,9 @@ private:
     // define something named s and it conflicts
     std::vector<CBigNum> s_notprime;
     std::vector<CBigNum> sprime;
+    // fVarTime: use the faster variable time exponentiation, only when verifying
     inline CBigNum challengeCalculation(const CBigNum& a_exp, const CBigNum& b_exp,
-                                       const CBigNum& h_exp) const;
+                                       const CBigNum& h_exp, bool fVarTime = false) const;
 };
 
 } /* namespace libzerocoin */
@@ -34,6 +34,9 @@
 // Activate multithreaded mode for proof verification
 #define ZEROCOIN_THREADING 1
 
+// Maximum number of threads verifying the iterations of a serial number proof
+#define ZEROCOIN_MAX_VERIFY_THREADS         8
+
 // Uses a fast technique for coin generation. Could be more vulnerable
 // to timing attacks. Turn off if an attacker can measure coin minting time.
 #define	ZEROCOIN_FAST_MINT 1
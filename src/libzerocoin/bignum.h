@@ -145,6 +145,26 @@ public:
      */
     CBigNum pow_mod(const CBigNum& e, const CBigNum& m) const;
 
+    /**
+     * modular exponentiation: this^e mod m, in variable time.
+     * Faster than pow_mod, but its timing depends on e: only use it
+     * on public values, e.g. when verifying proofs.
+     * @param e exponent
+     * @param m modulus
+     */
+    CBigNum pow_mod_vartime(const CBigNum& e, const CBigNum& m) const;
+
+    /**
+     * modular multi-exponentiation: bases[0]^exps[0] * bases[1]^exps[1] * ... mod m,
+     * in variable time. The exponentiations share their squarings, which makes
+     * this considerably faster than multiplying separate pow_mod results.
+     * Only use it on public values, e.g. when verifying proofs.
+     * @param bases the bases
+     * @param exps the exponents, one per base
+     * @param m modulus
+     */
+    static CBigNum mul_pow_mod(const std::vector<CBigNum>& bases, const std::vector<CBigNum>& exps, const CBigNum& m);
+
     /**
     * Calculates the inverse of this element mod m.
     * i.e. i such this*i = 1 mod m
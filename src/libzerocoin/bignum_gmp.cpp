@@ -6,6 +6,9 @@
 
 #include "bignum.h"
 
+#include <algorithm>
+#include <assert.h>
+
 /** C++ wrapper for BIGNUM (Gmp bignum) */
 CBigNum::CBigNum()
 {
@@ -245,6 +248,105 @@ CBigNum CBigNum::pow_mod(const CBigNum& e, const CBigNum& m) const
     return ret;
 }
 
+/**
+ * modular exponentiation: this^e mod n, in variable time
+ * @param e exponent
+ * @param m modulus
+ */
+CBigNum CBigNum::pow_mod_vartime(const CBigNum& e, const CBigNum& m) const
+{
+    CBigNum ret;
+    mpz_powm (ret.bn, bn, e.bn, m.bn);
+    return ret;
+}
+
+/**
+ * modular multi-exponentiation: prod(bases[i]^exps[i]) mod m, in variable time.
+ * Interleaved (Straus) exponentiation: all the exponents are scanned together,
+ * w bits at a time, against a table with every product of the base powers,
+ * so the squarings are done only once for all the bases.
+ * @param bases the bases
+ * @param exps the exponents
+ * @param m modulus
+ */
+CBigNum CBigNum::mul_pow_mod(const std::vector<CBigNum>& bases, const std::vector<CBigNum>& exps, const CBigNum& m)
+{
+    assert(bases.size() == exps.size());
+    const size_t k = bases.size();
+    if (k == 0)
+        return CBigNum(1) % m;
+    if (k == 1)
+        return bases[0].pow_mod_vartime(exps[0], m);
+    if (k > 4) {
+        // keep the table small: split in chunks of 4 bases
+        CBigNum ret = 1;
+        for (size_t i = 0; i < k; i += 4) {
+            const size_t j = std::min(k, i + 4);
+            const std::vector<CBigNum> b(bases.begin() + i, bases.begin() + j);
+            const std::vector<CBigNum> e(exps.begin() + i, exps.begin() + j);
+            ret = ret.mul_mod(mul_pow_mod(b, e, m), m);
+        }
+        return ret;
+    }
+
+    // g^-x = (g^-1)^x
+    std::vector<CBigNum> b(k), e(k);
+    for (size_t i = 0; i < k; i++) {
+        if (mpz_sgn(exps[i].bn) < 0) {
+            if (!mpz_invert(b[i].bn, bases[i].bn, m.bn)) {
+                // not invertible: let mpz_powm handle it, one base at a time
+                CBigNum ret = 1;
+                for (size_t j = 0; j < k; j++)
+                    ret = ret.mul_mod(bases[j].pow_mod_vartime(exps[j], m), m);
+                return ret;
+            }
+            mpz_neg(e[i].bn, exps[i].bn);
+        } else {
+            mpz_mod(b[i].bn, bases[i].bn, m.bn);
+            e[i] = exps[i];
+        }
+    }
+
+    // table[idx] = prod(b[i]^d[i]), where d[i] is the i-th w-bit digit of idx
+    const unsigned int w = (k <= 3) ? 2 : 1;
+    const size_t nTable = (size_t)1 << (k * w);
+    std::vector<CBigNum> table(nTable);
+    mpz_set_ui(table[0].bn, 1);
+    for (size_t idx = 1; idx < nTable; idx++) {
+        size_t j = 0;
+        while (((idx >> (j * w)) & ((1 << w) - 1)) == 0)
+            j++;
+        mpz_mul(table[idx].bn, table[idx - ((size_t)1 << (j * w))].bn, b[j].bn);
+        mpz_mod(table[idx].bn, table[idx].bn, m.bn);
+    }
+
+    size_t nBits = 0;
+    for (size_t i = 0; i < k; i++)
+        if (mpz_sgn(e[i].bn) != 0)
+            nBits = std::max(nBits, mpz_sizeinbase(e[i].bn, 2));
+    nBits = (nBits + w - 1) / w * w;
+
+    CBigNum ret;
+    mpz_set_ui(ret.bn, 1);
+    for (size_t pos = nBits; pos > 0; pos -= w) {
+        for (unsigned int s = 0; s < w && mpz_cmp_ui(ret.bn, 1) != 0; s++) {
+            mpz_mul(ret.bn, ret.bn, ret.bn);
+            mpz_mod(ret.bn, ret.bn, m.bn);
+        }
+        size_t idx = 0;
+        for (size_t i = 0; i < k; i++)
+            for (unsigned int s = 0; s < w; s++)
+                if (mpz_tstbit(e[i].bn, pos - w + s))
+                    idx |= (size_t)1 << (i * w + s);
+        if (idx != 0) {
+            mpz_mul(ret.bn, ret.bn, table[idx].bn);
+            mpz_mod(ret.bn, ret.bn, m.bn);
+        }
+    }
+    mpz_mod(ret.bn, ret.bn, m.bn);
+    return ret;
+}
+
 /**
 * Calculates the inverse of this element mod m.
 * i.e. i such this*i = 1 mod m
@@ -6,6 +6,53 @@
 
 #include "bignum.h"
 
+#include <assert.h>
+#include <map>
+#include <mutex>
+
+namespace
+{
+/**
+ * Montgomery contexts of the moduli used for variable time exponentiation.
+ * The zerocoin proofs use a handful of fixed moduli, so setting up the
+ * context once per modulus instead of once per exponentiation pays off.
+ */
+class CMontCache
+{
+private:
+    static const size_t MAX_ENTRIES = 32;
+    std::mutex cs;
+    std::map<std::vector<unsigned char>, BN_MONT_CTX*> mapCtx;
+
+public:
+    ~CMontCache()
+    {
+        for (auto& entry : mapCtx)
+            BN_MONT_CTX_free(entry.second);
+    }
+
+    /** Returns the cached context for odd modulus m, or NULL if the cache is full. */
+    BN_MONT_CTX* Get(const std::vector<unsigned char>& key, const BIGNUM* m, BN_CTX* pctx)
+    {
+        std::lock_guard<std::mutex> lock(cs);
+        auto it = mapCtx.find(key);
+        if (it != mapCtx.end())
+            return it->second;
+        if (mapCtx.size() >= MAX_ENTRIES)
+            return NULL;
+        BN_MONT_CTX* mont = BN_MONT_CTX_new();
+        if (mont == NULL || !BN_MONT_CTX_set(mont, m, pctx)) {
+            BN_MONT_CTX_free(mont);
+            throw bignum_error("CMontCache::Get : BN_MONT_CTX_set failed");
+        }
+        mapCtx.emplace(key, mont);
+        return mont;
+    }
+};
+
+CMontCache montCache;
+}
+
 CBigNum::CBigNum()
 {
     bn = BN_new();
@@ -373,6 +420,69 @@ CBigNum CBigNum::pow_mod(const CBigNum& e, const CBigNum& m) const
     return ret;
 }
 
+/**
+ * modular exponentiation: this^e mod n, in variable time
+ * @param e exponent
+ * @param m modulus
+ */
+CBigNum CBigNum::pow_mod_vartime(const CBigNum& e, const CBigNum& m) const
+{
+    if (!BN_is_odd(m.bn))
+        return pow_mod(e, m);
+
+    CAutoBN_CTX pctx;
+    CBigNum ret;
+    BN_MONT_CTX* mont = montCache.Get(m.getvch(), m.bn, pctx);
+    if (e < 0) {
+        // g^-x = (g^-1)^x
+        CBigNum inv = this->inverse(m);
+        CBigNum posE = e * -1;
+        if (!BN_mod_exp_mont(ret.bn, inv.bn, posE.bn, m.bn, pctx, mont))
+            throw bignum_error("CBigNum::pow_mod_vartime : BN_mod_exp_mont failed on negative exponent");
+    } else {
+        if (!BN_mod_exp_mont(ret.bn, bn, e.bn, m.bn, pctx, mont))
+            throw bignum_error("CBigNum::pow_mod_vartime : BN_mod_exp_mont failed");
+    }
+    return ret;
+}
+
+/**
+ * modular multi-exponentiation: prod(bases[i]^exps[i]) mod m, in variable time.
+ * Bases are taken in pairs with BN_mod_exp2_mont, which shares the squarings
+ * of the two exponentiations.
+ * @param bases the bases
+ * @param exps the exponents
+ * @param m modulus
+ */
+CBigNum CBigNum::mul_pow_mod(const std::vector<CBigNum>& bases, const std::vector<CBigNum>& exps, const CBigNum& m)
+{
+    assert(bases.size() == exps.size());
+    CBigNum ret = CBigNum(1) % m;
+    if (!BN_is_odd(m.bn)) {
+        for (size_t i = 0; i < bases.size(); i++)
+            ret = ret.mul_mod(bases[i].pow_mod(exps[i], m), m);
+        return ret;
+    }
+
+    CAutoBN_CTX pctx;
+    BN_MONT_CTX* mont = montCache.Get(m.getvch(), m.bn, pctx);
+    size_t i = 0;
+    for (; i + 1 < bases.size(); i += 2) {
+        // g^-x = (g^-1)^x
+        CBigNum b1 = exps[i] < 0 ? bases[i].inverse(m) : bases[i];
+        CBigNum e1 = exps[i] < 0 ? exps[i] * -1 : exps[i];
+        CBigNum b2 = exps[i + 1] < 0 ? bases[i + 1].inverse(m) : bases[i + 1];
+        CBigNum e2 = exps[i + 1] < 0 ? exps[i + 1] * -1 : exps[i + 1];
+        CBigNum r;
+        if (!BN_mod_exp2_mont(r.bn, b1.bn, e1.bn, b2.bn, e2.bn, m.bn, pctx, mont))
+            throw bignum_error("CBigNum::mul_pow_mod : BN_mod_exp2_mont failed");
+        ret = ret.mul_mod(r, m);
+    }
+    if (i < bases.size())
+        ret = ret.mul_mod(bases[i].pow_mod_vartime(exps[i], m), m);
+    return ret;
+}
+
 /**
 * Calculates the inverse of this element mod m.
 * i.e. i such this*i = 1 mod m
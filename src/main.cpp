@@ -12,8 +12,10 @@
 
 #include "zpiv/accumulators.h"
 #include "zpiv/accumulatormap.h"
+#include "addressindex.h"
 #include "addrman.h"
 #include "alert.h"
+#include "blockreader.h"
 #include "blocksignature.h"
 #include "chainparams.h"
 #include "checkpoints.h"
@@ -51,6 +53,7 @@
 #include <boost/thread.hpp>
 #include <boost/foreach.hpp>
 #include <atomic>
+#include <mutex>
 #include <queue>
 
 
@@ -79,7 +82,7 @@ bool fTxIndex = true;
 bool fIsBareMultisigStd = true;
 bool fCheckBlockIndex = false;
 bool fVerifyingBlocks = false;
-unsigned int nCoinCacheSize = 5000;
+size_t nCoinCacheUsage = 5000 * 300;
 bool fAlerts = DEFAULT_ALERTS;
 bool fClearSpendCache = false;
 
@@ -617,6 +620,7 @@ CBlockIndex* FindForkInGlobalIndex(const CChain& chain, const CBlockLocator& loc
 }
 
 CCoinsViewCache* pcoinsTip = NULL;
+CCoinsViewBackgroundWriter* pcoinsWriter = NULL;
 CBlockTreeDB* pblocktree = NULL;
 CZerocoinDB* zerocoinDB = NULL;
 CSporkDB* pSporkDB = NULL;
@@ -1326,7 +1330,7 @@ CAmount GetMinRelayFee(const CTransaction& tx, unsigned int nBytes, bool fAllowF
 }
 
 
-bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState& state, const CTransaction& tx, bool fLimitFree, bool* pfMissingInputs, bool fRejectInsaneFee, bool ignoreFees)
+static bool AcceptToMemoryPoolWithTime(CTxMemPool& pool, CValidationState& state, const CTransaction& tx, bool fLimitFree, bool* pfMissingInputs, int64_t nAcceptTime, bool fRejectInsaneFee, bool ignoreFees)
 {
     AssertLockHeld(cs_main);
     if (pfMissingInputs)
@@ -1529,7 +1533,7 @@ bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState& state, const CTransa
         if (!hasZcSpendInputs)
             view.GetPriority(tx, chainActive.Height());
 
-        CTxMemPoolEntry entry(tx, nFees, GetTime(), dPriority, chainActive.Height());
+        CTxMemPoolEntry entry(tx, nFees, nAcceptTime, dPriority, chainActive.Height());
         unsigned int nSize = entry.GetTxSize();
 
         // Don't accept it if it can't get into a block
@@ -1628,6 +1632,11 @@ bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState& state, const CTransa
     return true;
 }
 
+bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState& state, const CTransaction& tx, bool fLimitFree, bool* pfMissingInputs, bool fRejectInsaneFee, bool ignoreFees)
+{
+    return AcceptToMemoryPoolWithTime(pool, state, tx, fLimitFree, pfMissingInputs, GetTime(), fRejectInsaneFee, ignoreFees);
+}
+
 bool AcceptableInputs(CTxMemPool& pool, CValidationState& state, const CTransaction& tx, bool fLimitFree, bool* pfMissingInputs, bool fRejectInsaneFee, bool isDSTX)
 {
     AssertLockHeld(cs_main);
@@ -1845,6 +1854,30 @@ bool GetOutput(const uint256& hash, unsigned int index, CValidationState& state,
     return true;
 }
 
+/** Read a transaction through the transaction index. Does not need cs_main. */
+static bool ReadTransactionFromIndex(const uint256& hash, CTransaction& txOut, uint256& hashBlock)
+{
+    CDiskTxPos postx;
+    if (!pblocktree->ReadTxIndex(hash, postx))
+        return false;
+
+    CAutoFile file(OpenBlockFile(postx, true), SER_DISK, CLIENT_VERSION);
+    if (file.IsNull())
+        return error("%s: OpenBlockFile failed", __func__);
+    CBlockHeader header;
+    try {
+        file >> header;
+        fseek(file.Get(), postx.nTxOffset, SEEK_CUR);
+        file >> txOut;
+    } catch (const std::exception& e) {
+        return error("%s : Deserialize or I/O error - %s", __func__, e.what());
+    }
+    hashBlock = header.GetHash();
+    if (txOut.GetHash() != hash)
+        return error("%s : txid mismatch", __func__);
+    return true;
+}
+
 /** Return transaction in tx, and if it was found inside a block, its hash is placed in hashBlock */
 bool GetTransaction(const uint256& hash, CTransaction& txOut, uint256& hashBlock, bool fAllowSlow, CBlockIndex* blockIndex)
 {
@@ -1858,27 +1891,8 @@ bool GetTransaction(const uint256& hash, CTransaction& txOut, uint256& hashBlock
         }
 
         if (fTxIndex) {
-            CDiskTxPos postx;
-            if (pblocktree->ReadTxIndex(hash, postx)) {
-                CAutoFile file(OpenBlockFile(postx, true), SER_DISK, CLIENT_VERSION);
-                if (file.IsNull())
-                    return error("%s: OpenBlockFile failed", __func__);
-                CBlockHeader header;
-                try {
-                    file >> header;
-                    fseek(file.Get(), postx.nTxOffset, SEEK_CUR);
-                    file >> txOut;
-                } catch (const std::exception& e) {
-                    return error("%s : Deserialize or I/O error - %s", __func__, e.what());
-                }
-                hashBlock = header.GetHash();
-                if (txOut.GetHash() != hash)
-                    return error("%s : txid mismatch", __func__);
-                return true;
-            }
-
-            // transaction not found in the index, nothing more can be done
-            return false;
+            // if the transaction is not in the index, nothing more can be done
+            return ReadTransactionFromIndex(hash, txOut, hashBlock);
         }
 
         if (fAllowSlow) { // use coin database to locate block that contains transaction, and scan it
@@ -1973,6 +1987,46 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex)
     return true;
 }
 
+bool ReadRawBlockFromDisk(std::string& strBlock, const CBlockIndex* pindex)
+{
+    // Blocks are preceded on disk by the network magic and their size
+    CDiskBlockPos pos = pindex->GetBlockPos();
+    if (pos.nPos < MESSAGE_START_SIZE + sizeof(unsigned int))
+        return error("%s : invalid block position", __func__);
+    pos.nPos -= MESSAGE_START_SIZE + sizeof(unsigned int);
+
+    CAutoFile filein(OpenBlockFile(pos, true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull())
+        return error("%s : OpenBlockFile failed", __func__);
+
+    try {
+        unsigned char buf[MESSAGE_START_SIZE];
+        unsigned int nSize;
+        filein >> FLATDATA(buf) >> nSize;
+        if (memcmp(buf, Params().MessageStart(), MESSAGE_START_SIZE))
+            return error("%s : block magic mismatch in file %d at %u", __func__, pos.nFile, pos.nPos);
+        if (nSize < 80 || nSize > MAX_BLOCK_SIZE_CURRENT)
+            return error("%s : invalid block size %u in file %d at %u", __func__, nSize, pos.nFile, pos.nPos);
+        strBlock.resize(nSize);
+        filein.read(&strBlock[0], nSize);
+    } catch (const std::exception& e) {
+        return error("%s : I/O error - %s", __func__, e.what());
+    }
+
+    // Only the header (at most 112 bytes with the accumulator checkpoint) is
+    // deserialized, to check that this is the expected block
+    CBlockHeader header;
+    try {
+        CDataStream ssHeader(strBlock.data(), strBlock.data() + std::min(strBlock.size(), (size_t)112), SER_DISK, CLIENT_VERSION);
+        ssHeader >> header;
+    } catch (const std::exception& e) {
+        return error("%s : Deserialize error - %s", __func__, e.what());
+    }
+    if (header.GetHash() != pindex->GetBlockHash())
+        return error("%s : block=%s index=%s", __func__, header.GetHash().GetHex(), pindex->GetBlockHash().GetHex());
+    return true;
+}
+
 
 double ConvertBitsToDouble(unsigned int nBits)
 {
@@ -2542,7 +2596,7 @@ bool ValidOutPoint(const COutPoint& out, int nHeight)
 CAmount GetInvalidUTXOValue()
 {
     CAmount nValue = 0;
-    for (auto out : invalid_out::setInvalidOutPoints) {
+    for (const COutPoint& out : invalid_out::GetOutPoints()) {
         bool fSpent = false;
         CCoinsViewCache cache(pcoinsTip);
         const CCoins *coins = cache.AccessCoins(out.hash);
@@ -2790,6 +2844,9 @@ bool DisconnectBlock(CBlock& block, CValidationState& state, CBlockIndex* pindex
         }
     }
 
+    if (!AddressIndexBlockDisconnected(block, blockUndo, pindex))
+        return error("DisconnectBlock() : failed to update address index");
+
     // move best block pointer to prevout block
     view.SetBestBlock(pindex->pprev->GetBlockHash());
 
@@ -2843,6 +2900,216 @@ void ThreadScriptCheck()
     scriptcheckqueue.Thread();
 }
 
+static CCheckQueue<CScriptCheck> mempoolcheckqueue(128);
+/** Serializes the users of mempoolcheckqueue (a CCheckQueueControl needs an idle queue) */
+static CCriticalSection cs_mempoolcheck;
+
+void ThreadMempoolScriptCheck()
+{
+    RenameThread("pivx-mempoolch");
+    mempoolcheckqueue.Thread();
+}
+
+/** Reject code and reason of a transaction that failed PreVerifyTransaction */
+struct CPreVerifyReject {
+    unsigned char chRejectCode;
+    std::string strRejectReason;
+};
+
+/**
+ * Transactions that failed PreVerifyTransaction, so that a peer repeating one doesn't get its
+ * scripts verified again. Finality and the spent coins depend on the tip: the map is cleared
+ * when it changes, and when it holds MAX_PREVERIFY_REJECTS entries.
+ */
+static const unsigned int MAX_PREVERIFY_REJECTS = 10000;
+static std::map<uint256, CPreVerifyReject> mapPreVerifyRejects;
+static uint256 hashPreVerifyRejectsTip;
+static CCriticalSection cs_preverifyrejects;
+
+static bool IsPreVerifyRejected(const uint256& hashTx, const uint256& hashTip, CValidationState& state)
+{
+    LOCK(cs_preverifyrejects);
+    if (hashPreVerifyRejectsTip != hashTip) {
+        mapPreVerifyRejects.clear();
+        hashPreVerifyRejectsTip = hashTip;
+        return false;
+    }
+
+    std::map<uint256, CPreVerifyReject>::const_iterator it = mapPreVerifyRejects.find(hashTx);
+    if (it == mapPreVerifyRejects.end())
+        return false;
+    // the peer that sent it first was already punished
+    state.DoS(0, false, it->second.chRejectCode, it->second.strRejectReason);
+    return true;
+}
+
+static void AddPreVerifyReject(const uint256& hashTx, const uint256& hashTip, const CValidationState& state)
+{
+    LOCK(cs_preverifyrejects);
+    // checked against an older tip, the failure may not hold anymore
+    if (hashPreVerifyRejectsTip != hashTip)
+        return;
+    if (mapPreVerifyRejects.size() >= MAX_PREVERIFY_REJECTS)
+        mapPreVerifyRejects.clear();
+    CPreVerifyReject& reject = mapPreVerifyRejects[hashTx];
+    reject.chRejectCode = state.GetRejectCode();
+    reject.strRejectReason = state.GetRejectReason();
+}
+
+/**
+ * Run the checks of AcceptToMemoryPool that need no more than a short cs_main: CheckTransaction,
+ * the standardness rules and, on a snapshot of the spent coins taken into view, AreInputsStandard.
+ * Returns false with state set if one of them failed. Otherwise fScripts tells whether the scripts
+ * can be checked against view with flags; they can't for zerocoin spends, missing inputs, ...
+ */
+static bool PreCheckTransaction(CTxMemPool& pool, const CTransaction& tx, int nHeight, CValidationState& state, CCoinsViewCache& view, unsigned int& flags, bool& fScripts)
+{
+    fScripts = false;
+
+    // Zerocoin spends have no scripts to verify, block-only transactions are rejected by AcceptToMemoryPool
+    if (tx.IsCoinBase() || tx.IsCoinStake() || tx.HasZerocoinSpendInputs())
+        return true;
+
+    bool fColdStakingActive = sporkManager.IsSporkActive(SPORK_17_COLDSTAKING_ENFORCEMENT);
+    if (!CheckTransaction(tx, nHeight >= Params().Zerocoin_StartHeight(), true, state, isBlockBetweenFakeSerialAttackRange(nHeight), fColdStakingActive))
+        return state.DoS(100, error("%s : CheckTransaction failed", __func__), REJECT_INVALID, "bad-tx");
+
+    CCoinsView dummy;
+    bool fCLTVIsActivated = false;
+    {
+        LOCK2(cs_main, pool.cs);
+        if (!CheckFinalTx(tx, STANDARD_LOCKTIME_VERIFY_FLAGS))
+            return state.DoS(0, false, REJECT_NONSTANDARD, "non-final");
+
+        std::string reason;
+        if (Params().RequireStandard() && !IsStandardTx(tx, reason))
+            return state.DoS(0, error("%s : nonstandard transaction: %s", __func__, reason), REJECT_NONSTANDARD, reason);
+
+        if (pool.exists(tx.GetHash()))
+            return true;
+
+        CCoinsViewMemPool viewMemPool(pcoinsTip, pool);
+        view.SetBackend(viewMemPool);
+        for (const CTxIn& txin : tx.vin) {
+            // missing inputs are reported by AcceptToMemoryPool
+            if (!view.HaveCoins(txin.prevout.hash)) {
+                view.SetBackend(dummy);
+                return true;
+            }
+        }
+        fCLTVIsActivated = chainActive.Tip()->nHeight >= Params().BIP65ActivationHeight();
+
+        // the spent coins are cached now, switch back to dummy so the locks can be released
+        view.SetBackend(dummy);
+    }
+
+    if (!view.HaveInputs(tx))
+        return true;
+
+    if (Params().RequireStandard() && !AreInputsStandard(tx, view))
+        return state.DoS(0, error("%s : nonstandard transaction input", __func__), REJECT_NONSTANDARD, "bad-txns-nonstandard-inputs");
+
+    flags = STANDARD_SCRIPT_VERIFY_FLAGS;
+    if (fCLTVIsActivated)
+        flags |= SCRIPT_VERIFY_CHECKLOCKTIMEVERIFY;
+    fScripts = true;
+    return true;
+}
+
+static void GetPreVerifyScriptChecks(const CTransaction& tx, const CCoinsViewCache& view, unsigned int flags, std::vector<CScriptCheck>& vChecks)
+{
+    for (unsigned int i = 0; i < tx.vin.size(); i++) {
+        const CCoins* coins = view.AccessCoins(tx.vin[i].prevout.hash);
+        CScriptCheck check(*coins, tx, i, flags, true);
+        vChecks.push_back(CScriptCheck());
+        check.swap(vChecks.back());
+    }
+}
+
+static bool RunPreVerifyScriptChecks(std::vector<CScriptCheck>& vChecks)
+{
+    if (vChecks.empty())
+        return true;
+
+    if (!nScriptCheckThreads) {
+        bool fRet = true;
+        for (CScriptCheck& check : vChecks)
+            fRet = check() && fRet;
+        return fRet;
+    }
+
+    LOCK(cs_mempoolcheck);
+    CCheckQueueControl<CScriptCheck> control(&mempoolcheckqueue);
+    control.Add(vChecks);
+    return control.Wait();
+}
+
+/** Set state for the input of tx whose script check failed, with the outcome CheckInputs gives */
+static bool InvalidPreVerifyScripts(const CTransaction& tx, const CCoinsViewCache& view, unsigned int flags, CValidationState& state)
+{
+    for (unsigned int i = 0; i < tx.vin.size(); i++) {
+        const CCoins* coins = view.AccessCoins(tx.vin[i].prevout.hash);
+        // the inputs that passed are signature cache hits now
+        CScriptCheck check(*coins, tx, i, flags, true);
+        if (check())
+            continue;
+        if (flags & STANDARD_NOT_MANDATORY_VERIFY_FLAGS) {
+            // a failure of a non-mandatory flag only makes the transaction non-standard
+            CScriptCheck check(*coins, tx, i, flags & ~STANDARD_NOT_MANDATORY_VERIFY_FLAGS, true);
+            if (check())
+                return state.Invalid(false, REJECT_NONSTANDARD, strprintf("non-mandatory-script-verify-flag (%s)", ScriptErrorString(check.GetScriptError())));
+        }
+        return state.DoS(100, false, REJECT_INVALID, strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(check.GetScriptError())));
+    }
+    return true;
+}
+
+bool PreVerifyTransaction(CTxMemPool& pool, const CTransaction& tx, CValidationState& state)
+{
+    ChainTipSnapshotRef tip = GetChainTipSnapshot();
+    const uint256 hashTip = tip->Tip() ? tip->Tip()->GetBlockHash() : uint256();
+    const uint256 hashTx = tx.GetHash();
+    if (IsPreVerifyRejected(hashTx, hashTip, state))
+        return false;
+
+    CCoinsView dummy;
+    CCoinsViewCache view(&dummy);
+    unsigned int flags = 0;
+    bool fScripts = false;
+    if (!PreCheckTransaction(pool, tx, tip->Height(), state, view, flags, fScripts)) {
+        AddPreVerifyReject(hashTx, hashTip, state);
+        return false;
+    }
+    if (!fScripts)
+        return true;
+
+    std::vector<CScriptCheck> vChecks;
+    vChecks.reserve(tx.vin.size());
+    GetPreVerifyScriptChecks(tx, view, flags, vChecks);
+    if (RunPreVerifyScriptChecks(vChecks) || InvalidPreVerifyScripts(tx, view, flags, state))
+        return true;
+
+    AddPreVerifyReject(hashTx, hashTip, state);
+    return false;
+}
+
+bool PreVerifyTransactions(CTxMemPool& pool, const std::vector<CTransaction>& vtx)
+{
+    ChainTipSnapshotRef tip = GetChainTipSnapshot();
+    std::vector<CScriptCheck> vChecks;
+    // the checks keep pointers to the transactions only, the views can go after queuing
+    for (const CTransaction& tx : vtx) {
+        CCoinsView dummy;
+        CCoinsViewCache view(&dummy);
+        CValidationState state;
+        unsigned int flags = 0;
+        bool fScripts = false;
+        if (PreCheckTransaction(pool, tx, tip->Height(), state, view, flags, fScripts) && fScripts)
+            GetPreVerifyScriptChecks(tx, view, flags, vChecks);
+    }
+    return RunPreVerifyScriptChecks(vChecks);
+}
+
 void AddWrappedSerialsInflation()
 {
     CBlockIndex* pindex = chainActive[Params().Zerocoin_Block_EndFakeSerial()];
@@ -2872,54 +3139,85 @@ void AddWrappedSerialsInflation()
     uiInterface.ShowProgress("", 100);
 }
 
-void RecalculateZPIVMinted()
+int GetRecalculationThreads()
 {
-    CBlockIndex *pindex = chainActive[Params().Zerocoin_StartHeight()];
-    uiInterface.ShowProgress(_("Recalculating minted ZPIV..."), 0);
-    while (true) {
-        // Log Message and feedback message every 1000 blocks
-        if (pindex->nHeight % 1000 == 0) {
-            LogPrintf("%s : block %d...\n", __func__, pindex->nHeight);
-            int percent = std::max(1, std::min(99, (int)((double)(pindex->nHeight - Params().Zerocoin_StartHeight()) * 100 / (chainActive.Height() - Params().Zerocoin_StartHeight()))));
-            uiInterface.ShowProgress(_("Recalculating minted ZPIV..."), percent);
+    return std::max(1, std::min((int)boost::thread::hardware_concurrency(), MAX_SCRIPTCHECK_THREADS));
+}
+
+/**
+ * Walk the active chain from nHeightStart to the tip in batches of blocks. Blocks
+ * are read with fnRead on worker threads when fParallel is set, then fnApply folds
+ * the results in height order on the calling thread. The next height to process is
+ * stored under strProgressKey after every batch, and reset to 0 once the tip is
+ * reached, so that an interrupted run can be resumed. Returns false if it stopped
+ * because of a shutdown request.
+ */
+template <typename T, typename ReadFn, typename ApplyFn>
+static bool ScanActiveChain(const char* pszFunc, const std::string& strProgress, const std::string& strProgressKey,
+    int nHeightStart, bool fParallel, bool fInterruptible, ReadFn fnRead, ApplyFn fnApply)
+{
+    static const int RECALCULATION_BATCH_SIZE = 1000;
+
+    const int nHeightEnd = chainActive.Height();
+    const int nThreads = fParallel ? GetRecalculationThreads() : 1;
+    LogPrintf("%s : blocks %d to %d using %d threads\n", pszFunc, nHeightStart, nHeightEnd, nThreads);
+
+    std::vector<CBlockIndex*> vIndex;
+    std::vector<T> vResults;
+    uiInterface.ShowProgress(strProgress, 0);
+    for (int nBatchStart = nHeightStart; nBatchStart <= nHeightEnd; nBatchStart += RECALCULATION_BATCH_SIZE) {
+        if (fInterruptible && ShutdownRequested()) {
+            LogPrintf("%s : interrupted at block %d\n", pszFunc, nBatchStart);
+            uiInterface.ShowProgress("", 100);
+            return false;
         }
 
-        //overwrite possibly wrong vMintsInBlock data
-        CBlock block;
-        assert(ReadBlockFromDisk(block, pindex));
+        const int nBatchEnd = std::min(nHeightEnd, nBatchStart + RECALCULATION_BATCH_SIZE - 1);
+        vIndex.clear();
+        for (int nHeight = nBatchStart; nHeight <= nBatchEnd; nHeight++)
+            vIndex.push_back(chainActive[nHeight]);
 
-        std::list<CZerocoinMint> listMints;
-        BlockToZerocoinMintList(block, listMints, true);
+        ParallelReadBlocks(vIndex, vResults, nThreads, fnRead);
+        for (size_t i = 0; i < vIndex.size(); i++)
+            fnApply(vIndex[i], vResults[i]);
 
-        std::vector<libzerocoin::CoinDenomination> vDenomsBefore = pindex->vMintDenominationsInBlock;
-        pindex->vMintDenominationsInBlock.clear();
-        for (auto mint : listMints)
-            pindex->vMintDenominationsInBlock.emplace_back(mint.GetDenomination());
+        pblocktree->WriteInt(strProgressKey, nBatchEnd + 1);
 
-        if (pindex->nHeight < chainActive.Height())
-            pindex = chainActive.Next(pindex);
-        else
-            break;
+        LogPrintf("%s : block %d...\n", pszFunc, nBatchEnd);
+        int percent = std::max(1, std::min(99, (int)((double)(nBatchEnd - nHeightStart) * 100 / std::max(1, nHeightEnd - nHeightStart))));
+        uiInterface.ShowProgress(strProgress, percent);
     }
+    pblocktree->WriteInt(strProgressKey, 0);
     uiInterface.ShowProgress("", 100);
+    return true;
 }
 
-void RecalculateZPIVSpent()
+/** Mints and spends of a block, as needed to rebuild the zPIV supply */
+struct CZerocoinBlockDelta {
+    std::vector<libzerocoin::CoinDenomination> vMints;
+    std::list<libzerocoin::CoinDenomination> listSpends;
+};
+
+bool RecalculateZPIVSupply(int nHeightStart, bool fInterruptible)
 {
-    CBlockIndex* pindex = chainActive[Params().Zerocoin_StartHeight()];
-    uiInterface.ShowProgress(_("Recalculating spent ZPIV..."), 0);
-    while (true) {
-        if (pindex->nHeight % 1000 == 0) {
-            LogPrintf("%s : block %d...\n", __func__, pindex->nHeight);
-            int percent = std::max(1, std::min(99, (int)((double)(pindex->nHeight - Params().Zerocoin_StartHeight()) * 100 / (chainActive.Height() - Params().Zerocoin_StartHeight()))));
-            uiInterface.ShowProgress(_("Recalculating spent ZPIV..."), percent);
-        }
+    if (nHeightStart > chainActive.Height())
+        return true;
 
-        //Rewrite zPIV supply
+    auto fnRead = [](const CBlockIndex* pindex, CZerocoinBlockDelta& delta) {
         CBlock block;
         assert(ReadBlockFromDisk(block, pindex));
 
-        std::list<libzerocoin::CoinDenomination> listDenomsSpent = ZerocoinSpendListFromBlock(block, true);
+        std::list<CZerocoinMint> listMints;
+        BlockToZerocoinMintList(block, listMints, true);
+        for (const CZerocoinMint& mint : listMints)
+            delta.vMints.emplace_back(mint.GetDenomination());
+
+        delta.listSpends = ZerocoinSpendListFromBlock(block, true);
+    };
+
+    auto fnApply = [](CBlockIndex* pindex, CZerocoinBlockDelta& delta) {
+        //overwrite possibly wrong vMintsInBlock data
+        pindex->vMintDenominationsInBlock = std::move(delta.vMints);
 
         //Reset the supply to previous block
         pindex->mapZerocoinSupply = pindex->pprev->mapZerocoinSupply;
@@ -2931,7 +3229,7 @@ void RecalculateZPIVSpent()
         }
 
         //Remove spends from zPIV supply
-        for (auto denom : listDenomsSpent)
+        for (auto denom : delta.listSpends)
             pindex->mapZerocoinSupply.at(denom)--;
 
         // Add inflation from Wrapped Serials if block is Zerocoin_Block_EndFakeSerial()
@@ -2942,16 +3240,13 @@ void RecalculateZPIVSpent()
 
         //Rewrite money supply
         assert(pblocktree->WriteBlockIndex(CDiskBlockIndex(pindex)));
+    };
 
-        if (pindex->nHeight < chainActive.Height())
-            pindex = chainActive.Next(pindex);
-        else
-            break;
-    }
-    uiInterface.ShowProgress("", 100);
+    return ScanActiveChain<CZerocoinBlockDelta>(__func__, _("Recalculating zPIV supply..."), "recalczpivsupply",
+        nHeightStart, true, fInterruptible, fnRead, fnApply);
 }
 
-bool RecalculatePIVSupply(int nHeightStart)
+bool RecalculatePIVSupply(int nHeightStart, bool fInterruptible)
 {
     if (nHeightStart > chainActive.Height())
         return false;
@@ -2961,14 +3256,11 @@ bool RecalculatePIVSupply(int nHeightStart)
     if (nHeightStart == Params().Zerocoin_StartHeight())
         nSupplyPrev = CAmount(5449796547496199);
 
-    uiInterface.ShowProgress(_("Recalculating PIV supply..."), 0);
-    while (true) {
-        if (pindex->nHeight % 1000 == 0) {
-            LogPrintf("%s : block %d...\n", __func__, pindex->nHeight);
-            int percent = std::max(1, std::min(99, (int)((double)((pindex->nHeight - nHeightStart) * 100) / (chainActive.Height() - nHeightStart))));
-            uiInterface.ShowProgress(_("Recalculating PIV supply..."), percent);
-        }
+    // Without the transaction index the previous outputs are found through
+    // GetTransaction, which takes cs_main, so the blocks are read on this thread.
+    const bool fParallel = fTxIndex;
 
+    auto fnRead = [fParallel](const CBlockIndex* pindex, CAmount& nDelta) {
         CBlock block;
         assert(ReadBlockFromDisk(block, pindex));
 
@@ -2987,7 +3279,10 @@ bool RecalculatePIVSupply(int nHeightStart)
                 COutPoint prevout = tx.vin[i].prevout;
                 CTransaction txPrev;
                 uint256 hashBlock;
-                assert(GetTransaction(prevout.hash, txPrev, hashBlock, true));
+                if (fParallel)
+                    assert(ReadTransactionFromIndex(prevout.hash, txPrev, hashBlock));
+                else
+                    assert(GetTransaction(prevout.hash, txPrev, hashBlock, true));
                 nValueIn += txPrev.vout[prevout.n].nValue;
             }
 
@@ -2998,32 +3293,33 @@ bool RecalculatePIVSupply(int nHeightStart)
                 nValueOut += tx.vout[i].nValue;
             }
         }
+        nDelta = nValueOut - nValueIn;
+    };
 
+    // __func__ of the enclosing function, the lambda's own is operator()
+    const char* pszFunc = __func__;
+    auto fnApply = [&nSupplyPrev, pszFunc](CBlockIndex* pindex, CAmount& nDelta) {
         // Rewrite money supply
-        pindex->nMoneySupply = nSupplyPrev + nValueOut - nValueIn;
+        pindex->nMoneySupply = nSupplyPrev + nDelta;
         nSupplyPrev = pindex->nMoneySupply;
 
         // Add fraudulent funds to the supply and remove any recovered funds.
         if (pindex->nHeight == Params().Zerocoin_Block_RecalculateAccumulators()) {
-            LogPrintf("%s : Original money supply=%s\n", __func__, FormatMoney(pindex->nMoneySupply));
+            LogPrintf("%s : Original money supply=%s\n", pszFunc, FormatMoney(pindex->nMoneySupply));
 
             pindex->nMoneySupply += Params().InvalidAmountFiltered();
-            LogPrintf("%s : Adding filtered funds to supply + %s : supply=%s\n", __func__, FormatMoney(Params().InvalidAmountFiltered()), FormatMoney(pindex->nMoneySupply));
+            LogPrintf("%s : Adding filtered funds to supply + %s : supply=%s\n", pszFunc, FormatMoney(Params().InvalidAmountFiltered()), FormatMoney(pindex->nMoneySupply));
 
             CAmount nLocked = GetInvalidUTXOValue();
             pindex->nMoneySupply -= nLocked;
-            LogPrintf("%s : Removing locked from supply - %s : supply=%s\n", __func__, FormatMoney(nLocked), FormatMoney(pindex->nMoneySupply));
+            LogPrintf("%s : Removing locked from supply - %s : supply=%s\n", pszFunc, FormatMoney(nLocked), FormatMoney(pindex->nMoneySupply));
         }
 
         assert(pblocktree->WriteBlockIndex(CDiskBlockIndex(pindex)));
+    };
 
-        if (pindex->nHeight < chainActive.Height())
-            pindex = chainActive.Next(pindex);
-        else
-            break;
-    }
-    uiInterface.ShowProgress("", 100);
-    return true;
+    return ScanActiveChain<CAmount>(pszFunc, _("Recalculating PIV supply..."), "recalcpivsupply",
+        nHeightStart, fParallel, fInterruptible, fnRead, fnApply);
 }
 
 bool ReindexAccumulators(std::list<uint256>& listMissingCheckpoints, std::string& strError)
@@ -3036,40 +3332,77 @@ bool ReindexAccumulators(std::list<uint256>& listMissingCheckpoints, std::string
         //search the chain to see when zerocoin started
         int nZerocoinStart = Params().Zerocoin_Block_V2_Start();
 
-        // find each checkpoint that is missing
+        // find the first block of each checkpoint that is missing
+        std::set<uint256> setMissing(listMissingCheckpoints.begin(), listMissingCheckpoints.end());
+        std::vector<CBlockIndex*> vCheckpointBlocks;
         CBlockIndex* pindex = chainActive[nZerocoinStart];
         while (pindex && pindex->nHeight <= Params().Zerocoin_Block_Last_Checkpoint()) {
-            uiInterface.ShowProgress(_("Calculating missing accumulators..."), std::max(1, std::min(99, (int)((double)(pindex->nHeight - nZerocoinStart) / (double)(chainActive.Height() - nZerocoinStart) * 100))));
+            if (pindex->nAccumulatorCheckpoint != pindex->pprev->nAccumulatorCheckpoint && setMissing.erase(pindex->nAccumulatorCheckpoint))
+                vCheckpointBlocks.push_back(pindex);
+            pindex = chainActive.Next(pindex);
+        }
 
+        // The pubcoins of the blocks accumulated by a batch of checkpoints are read in
+        // parallel ahead of time, the checkpoints themselves are calculated in order
+        // as each one starts from the previous.
+        static const size_t CHECKPOINT_BATCH_SIZE = 100;
+        const int nThreads = GetRecalculationThreads();
+        for (size_t nBatchStart = 0; nBatchStart < vCheckpointBlocks.size(); nBatchStart += CHECKPOINT_BATCH_SIZE) {
             if (ShutdownRequested())
                 return false;
 
-            // find checkpoints by iterating through the blockchain beginning with the first zerocoin block
-            if (pindex->nAccumulatorCheckpoint != pindex->pprev->nAccumulatorCheckpoint) {
-                if (find(listMissingCheckpoints.begin(), listMissingCheckpoints.end(), pindex->nAccumulatorCheckpoint) != listMissingCheckpoints.end()) {
-                    uint256 nCheckpointCalculated = 0;
-                    AccumulatorMap mapAccumulators(Params().Zerocoin_Params(false));
-                    if (!CalculateAccumulatorCheckpoint(pindex->nHeight, nCheckpointCalculated, mapAccumulators)) {
-                        // GetCheckpoint could have terminated due to a shutdown request. Check this here.
-                        if (ShutdownRequested())
-                            break;
-                        strError = _("Failed to calculate accumulator checkpoint");
-                        return error("%s: %s", __func__, strError);
-                    }
+            const size_t nBatchEnd = std::min(vCheckpointBlocks.size(), nBatchStart + CHECKPOINT_BATCH_SIZE);
+            std::vector<std::pair<CBlockIndex*, bool> > vMintBlocks;
+            for (size_t i = nBatchStart; i < nBatchEnd; i++) {
+                int nHeight = vCheckpointBlocks[i]->nHeight;
+                if (nHeight % 10 != 0)
+                    continue;
+                bool fFilterInvalid = nHeight >= Params().Zerocoin_Block_RecalculateAccumulators();
+                for (int nMintHeight = std::max(nHeight - 20, Params().Zerocoin_StartHeight()); nMintHeight < nHeight - 10; nMintHeight++)
+                    vMintBlocks.emplace_back(chainActive[nMintHeight], fFilterInvalid);
+            }
 
-                    //check that the calculated checkpoint is what is in the index.
-                    if (nCheckpointCalculated != pindex->nAccumulatorCheckpoint) {
-                        LogPrintf("%s : height=%d calculated_checkpoint=%s actual=%s\n", __func__, pindex->nHeight, nCheckpointCalculated.GetHex(), pindex->nAccumulatorCheckpoint.GetHex());
-                        strError = _("Calculated accumulator checkpoint is not what is recorded by block index");
-                        return error("%s: %s", __func__, strError);
-                    }
+            std::vector<std::pair<bool, std::list<libzerocoin::PublicCoin> > > vPubcoins;
+            ParallelReadBlocks(vMintBlocks, vPubcoins, nThreads, [](const std::pair<CBlockIndex*, bool>& mintBlock, std::pair<bool, std::list<libzerocoin::PublicCoin> >& result) {
+                CBlock block;
+                result.first = ReadBlockFromDisk(block, mintBlock.first) && BlockToPubcoinList(block, result.second, mintBlock.second);
+            });
+
+            PubcoinBlockCache mapPubcoinCache;
+            for (size_t i = 0; i < vMintBlocks.size(); i++) {
+                // blocks that failed to read are left to CalculateAccumulatorCheckpoint to report
+                if (vPubcoins[i].first)
+                    mapPubcoinCache[std::make_pair(vMintBlocks[i].first->nHeight, vMintBlocks[i].second)].swap(vPubcoins[i].second);
+            }
+
+            for (size_t i = nBatchStart; i < nBatchEnd; i++) {
+                pindex = vCheckpointBlocks[i];
+                uiInterface.ShowProgress(_("Calculating missing accumulators..."), std::max(1, std::min(99, (int)((double)(pindex->nHeight - nZerocoinStart) / (double)(chainActive.Height() - nZerocoinStart) * 100))));
+
+                if (ShutdownRequested())
+                    return false;
 
-                    DatabaseChecksums(mapAccumulators);
-                    auto it = find(listMissingCheckpoints.begin(), listMissingCheckpoints.end(), pindex->nAccumulatorCheckpoint);
-                    listMissingCheckpoints.erase(it);
+                uint256 nCheckpointCalculated = 0;
+                AccumulatorMap mapAccumulators(Params().Zerocoin_Params(false));
+                if (!CalculateAccumulatorCheckpoint(pindex->nHeight, nCheckpointCalculated, mapAccumulators, &mapPubcoinCache)) {
+                    // GetCheckpoint could have terminated due to a shutdown request. Check this here.
+                    if (ShutdownRequested())
+                        return false;
+                    strError = _("Failed to calculate accumulator checkpoint");
+                    return error("%s: %s", __func__, strError);
                 }
+
+                //check that the calculated checkpoint is what is in the index.
+                if (nCheckpointCalculated != pindex->nAccumulatorCheckpoint) {
+                    LogPrintf("%s : height=%d calculated_checkpoint=%s actual=%s\n", __func__, pindex->nHeight, nCheckpointCalculated.GetHex(), pindex->nAccumulatorCheckpoint.GetHex());
+                    strError = _("Calculated accumulator checkpoint is not what is recorded by block index");
+                    return error("%s: %s", __func__, strError);
+                }
+
+                DatabaseChecksums(mapAccumulators);
+                auto it = find(listMissingCheckpoints.begin(), listMissingCheckpoints.end(), pindex->nAccumulatorCheckpoint);
+                listMissingCheckpoints.erase(it);
             }
-            pindex = chainActive.Next(pindex);
         }
         uiInterface.ShowProgress("", 100);
     }
@@ -3359,8 +3692,7 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
 
     //A one-time event where money supply counts were off and recalculated on a certain block.
     if (pindex->nHeight == Params().Zerocoin_Block_RecalculateAccumulators() + 1) {
-        RecalculateZPIVMinted();
-        RecalculateZPIVSpent();
+        RecalculateZPIVSupply(Params().Zerocoin_StartHeight());
         RecalculatePIVSupply(Params().Zerocoin_StartHeight());
     }
 
@@ -3472,6 +3804,9 @@ bool ConnectBlock(const CBlock& block, CValidationState& state, CBlockIndex* pin
         if (!pblocktree->WriteTxIndex(vPos))
             return state.Abort("Failed to write transaction index");
 
+    if (!AddressIndexBlockConnected(block, blockundo, pindex))
+        return state.Abort("Failed to write address index");
+
     // add this block to the view's block chain
     view.SetBestBlock(pindex->GetBlockHash());
 
@@ -3513,13 +3848,27 @@ enum FlushStateMode {
  * The caches and indexes are flushed if either they're too large, forceWrite is set, or
  * fast is not set and it's been a while since the last write.
  */
+/** Queued behind a coins batch: the wallet only records a best block whose chainstate is on disk */
+static bool SignalBestChain(const CBlockLocator& locator)
+{
+    GetMainSignals().SetBestChain(locator);
+    return true;
+}
+
 bool static FlushStateToDisk(CValidationState& state, FlushStateMode mode)
 {
     LOCK(cs_main);
     static int64_t nLastWrite = 0;
     try {
-        if ((mode == FLUSH_STATE_ALWAYS) ||
-            ((mode == FLUSH_STATE_PERIODIC || mode == FLUSH_STATE_IF_NEEDED) && pcoinsTip->GetCacheSize() > nCoinCacheSize) ||
+        // A batch still being written in the background holds memory too.
+        size_t cacheSize = pcoinsTip->DynamicMemoryUsage();
+        if (pcoinsWriter)
+            cacheSize += pcoinsWriter->DynamicMemoryUsage();
+        // The cache is large and close to the limit, but we have time now (not in the middle of a block processing).
+        bool fCacheLarge = mode == FLUSH_STATE_PERIODIC && cacheSize * (10.0 / 9) > nCoinCacheUsage;
+        // The cache is over the limit, we have to write now.
+        bool fCacheCritical = mode == FLUSH_STATE_IF_NEEDED && cacheSize > nCoinCacheUsage;
+        if ((mode == FLUSH_STATE_ALWAYS) || fCacheLarge || fCacheCritical ||
             (mode == FLUSH_STATE_PERIODIC && GetTimeMicros() > nLastWrite + DATABASE_WRITE_INTERVAL * 1000000)) {
             // Typical CCoins structures on disk are around 100 bytes in size.
             // Pushing a new one to the database can cause it to be written
@@ -3531,30 +3880,51 @@ bool static FlushStateToDisk(CValidationState& state, FlushStateMode mode)
             // First make sure all block and undo data is flushed to disk.
             FlushBlockFile();
             // Then update all block file information (which may refer to block and undo files).
+            // The dirty entries are snapshotted, so that the write can happen in the background.
             {
-                std::vector<std::pair<int, const CBlockFileInfo*> > vFiles;
+                std::vector<std::pair<int, CBlockFileInfo> > vFiles;
                 vFiles.reserve(setDirtyFileInfo.size());
                 for (std::set<int>::iterator it = setDirtyFileInfo.begin(); it != setDirtyFileInfo.end(); ) {
-                    vFiles.push_back(std::make_pair(*it, &vinfoBlockFile[*it]));
+                    vFiles.push_back(std::make_pair(*it, vinfoBlockFile[*it]));
                     setDirtyFileInfo.erase(it++);
                 }
-                std::vector<const CBlockIndex*> vBlocks;
+                std::vector<std::pair<uint256, CDiskBlockIndex> > vBlocks;
                 vBlocks.reserve(setDirtyBlockIndex.size());
                 for (std::set<CBlockIndex*>::iterator it = setDirtyBlockIndex.begin(); it != setDirtyBlockIndex.end(); ) {
-                    vBlocks.push_back(*it);
+                    vBlocks.push_back(std::make_pair((*it)->GetBlockHash(), CDiskBlockIndex(*it)));
                     setDirtyBlockIndex.erase(it++);
                 }
-                if (!pblocktree->WriteBatchSync(vFiles, nLastBlockFile, vBlocks)) {
+                if (pcoinsWriter) {
+                    if (!pcoinsWriter->Queue(boost::bind(&CBlockTreeDB::WriteBatchSync, pblocktree, vFiles, nLastBlockFile, vBlocks)))
+                        return state.Abort("Files to write to block index database");
+                } else if (!pblocktree->WriteBatchSync(vFiles, nLastBlockFile, vBlocks)) {
                     return state.Abort("Files to write to block index database");
                 }
             }
             // Finally flush the chainstate (which may refer to block index entries).
-            if (!pcoinsTip->Flush())
+            // With a background writer, the dirty coins are written behind the block index
+            // while validation carries on; the best block marker is part of that same batch.
+            // Only dirty entries are written; the rest of the cache stays warm,
+            // and is trimmed back when it was the cache size that forced the write.
+            size_t nRetainUsage = nCoinCacheUsage;
+            if (fCacheLarge || fCacheCritical)
+                nRetainUsage = nCoinCacheUsage / 100 * COINS_CACHE_RETAIN_PERCENT;
+            if (!pcoinsTip->WriteBack(nRetainUsage))
                 return state.Abort("Failed to write to coin database");
-            // Update best block in wallet (so we can detect restored wallets).
+            if (pcoinsWriter) {
+                // Make room for the batch just handed over, until it is written.
+                size_t nPendingUsage = pcoinsWriter->DynamicMemoryUsage();
+                pcoinsTip->Trim(nRetainUsage > nPendingUsage ? nRetainUsage - nPendingUsage : 0);
+            }
+            // Update best block in wallet (so we can detect restored wallets), once the coins are on disk.
             if (mode != FLUSH_STATE_IF_NEEDED) {
-                GetMainSignals().SetBestChain(chainActive.GetLocator());
+                if (!pcoinsWriter)
+                    GetMainSignals().SetBestChain(chainActive.GetLocator());
+                else if (!pcoinsWriter->Queue(boost::bind(&SignalBestChain, chainActive.GetLocator())))
+                    return state.Abort("Failed to write to coin database");
             }
+            if (mode == FLUSH_STATE_ALWAYS && pcoinsWriter && !pcoinsWriter->Sync())
+                return state.Abort("Failed to write to coin database");
             nLastWrite = GetTimeMicros();
         }
     } catch (const std::runtime_error& e) {
@@ -3569,6 +3939,34 @@ void FlushStateToDisk()
     FlushStateToDisk(state, FLUSH_STATE_ALWAYS);
 }
 
+static std::mutex cs_chainTipSnapshot;
+static ChainTipSnapshotRef chainTipSnapshot = std::make_shared<const CChainTipSnapshot>();
+
+/** Make the current chainActive tip visible to GetChainTipSnapshot; called wherever chainActive's tip is set */
+static void PublishChainTipSnapshot()
+{
+    std::shared_ptr<CChainTipSnapshot> snapshot = std::make_shared<CChainTipSnapshot>();
+    snapshot->pindexTip = chainActive.Tip();
+    snapshot->nHeight = chainActive.Height();
+    snapshot->nMempoolSequence = mempool.GetTransactionsUpdated();
+
+    std::lock_guard<std::mutex> lock(cs_chainTipSnapshot);
+    chainTipSnapshot = snapshot;
+}
+
+ChainTipSnapshotRef GetChainTipSnapshot()
+{
+    std::lock_guard<std::mutex> lock(cs_chainTipSnapshot);
+    return chainTipSnapshot;
+}
+
+CBlockIndex* LookupBlockIndex(const uint256& hash)
+{
+    LOCK(cs_main);
+    BlockMap::const_iterator it = mapBlockIndex.find(hash);
+    return it == mapBlockIndex.end() ? NULL : it->second;
+}
+
 /** Update chainActive and related internal data structures. */
 void static UpdateTip(CBlockIndex* pindexNew)
 {
@@ -3587,11 +3985,12 @@ void static UpdateTip(CBlockIndex* pindexNew)
     // New best block
     nTimeBestReceived = GetTime();
     mempool.AddTransactionsUpdated(1);
+    PublishChainTipSnapshot();
 
-    LogPrintf("UpdateTip: new best=%s  height=%d version=%d  log2_work=%.8g  tx=%lu  date=%s progress=%f  cache=%u\n",
+    LogPrintf("UpdateTip: new best=%s  height=%d version=%d  log2_work=%.8g  tx=%lu  date=%s progress=%f  cache=%.1fMiB(%utx)\n",
         chainActive.Tip()->GetBlockHash().ToString(), chainActive.Height(), chainActive.Tip()->nVersion, log(chainActive.Tip()->nChainWork.getdouble()) / log(2.0), (unsigned long)chainActive.Tip()->nChainTx,
         DateTimeStrFormat("%Y-%m-%d %H:%M:%S", chainActive.Tip()->GetBlockTime()),
-        Checkpoints::GuessVerificationProgress(chainActive.Tip()), (unsigned int)pcoinsTip->GetCacheSize());
+        Checkpoints::GuessVerificationProgress(chainActive.Tip()), pcoinsTip->DynamicMemoryUsage() * (1.0 / (1 << 20)), (unsigned int)pcoinsTip->GetCacheSize());
 
     cvBlockChange.notify_all();
 
@@ -4050,7 +4449,7 @@ bool ActivateBestChain(CValidationState& state, CBlock* pblock, bool fAlreadyChe
             // Notify external listeners about the new tip.
             // Note: uiInterface, should switch main signals.
             uiInterface.NotifyBlockTip(hashNewTip);
-            GetMainSignals().UpdatedBlockTip(pindexNewTip);
+            GetMainSignals().UpdatedBlockTip(pindexNewTip, pblock && pblock->GetHash() == hashNewTip ? pblock : NULL);
 
             unsigned size = 0;
             if (pblock)
@@ -5428,6 +5827,7 @@ bool static LoadBlockIndexDB(std::string& strError)
     if (it == mapBlockIndex.end())
         return true;
     chainActive.SetTip(it->second);
+    PublishChainTipSnapshot();
 
     PruneBlockIndexCandidates();
 
@@ -5489,7 +5889,7 @@ bool CVerifyDB::VerifyDB(CCoinsView* coinsview, int nCheckLevel, int nCheckDepth
             }
         }
         // check level 3: check for inconsistencies during memory-only disconnect of tip blocks
-        if (nCheckLevel >= 3 && pindex == pindexState && (coins.GetCacheSize() + pcoinsTip->GetCacheSize()) <= nCoinCacheSize) {
+        if (nCheckLevel >= 3 && pindex == pindexState && (coins.DynamicMemoryUsage() + pcoinsTip->DynamicMemoryUsage()) <= nCoinCacheUsage) {
             bool fClean = true;
             if (!DisconnectBlock(block, state, pindex, coins, &fClean))
                 return error("VerifyDB() : *** irrecoverable inconsistency in block data at %d, hash=%s", pindex->nHeight, pindex->GetBlockHash().ToString());
@@ -5531,6 +5931,7 @@ void UnloadBlockIndex()
     LOCK(cs_main);
     setBlockIndexCandidates.clear();
     chainActive.SetTip(NULL);
+    PublishChainTipSnapshot();
     pindexBestInvalid = NULL;
     pindexBestHeader = NULL;
     mempool.clear();
@@ -6658,15 +7059,21 @@ bool static ProcessMessage(CNode* pfrom, std::string strCommand, CDataStream& vR
         CInv inv(MSG_TX, tx.GetHash());
         pfrom->AddInventoryKnown(inv);
 
+        // Check the transaction and its signatures before taking cs_main, so that block
+        // connection is not serialized behind script checks. A failure is reported below.
+        CValidationState state;
+        bool fPreVerified = PreVerifyTransaction(mempool, tx, state);
+
         LOCK(cs_main);
 
         bool fMissingInputs = false;
         bool fMissingZerocoinInputs = false;
-        CValidationState state;
 
         mapAlreadyAskedFor.erase(inv);
 
-        if (!tx.HasZerocoinSpendInputs() && AcceptToMemoryPool(mempool, state, tx, true, &fMissingInputs, false, ignoreFees)) {
+        if (!fPreVerified) {
+            LogPrint("mempool", "%s: precheck of %s from peer=%d failed\n", __func__, tx.GetHash().ToString(), pfrom->id);
+        } else if (!tx.HasZerocoinSpendInputs() && AcceptToMemoryPool(mempool, state, tx, true, &fMissingInputs, false, ignoreFees)) {
             mempool.check(pcoinsTip);
             RelayTransaction(tx);
             vWorkQueue.push_back(inv.hash);
@@ -7168,6 +7575,80 @@ int ActiveProtocol()
     return MIN_PEER_PROTO_VERSION_BEFORE_ENFORCEMENT;
 }
 
+template <typename T>
+static std::shared_ptr<CSignedMessage> DecodeSignedMessage(CDataStream& vRecv)
+{
+    std::shared_ptr<T> pmessage = std::make_shared<T>();
+    vRecv >> *pmessage;
+    return pmessage;
+}
+
+/**
+ * Decode the masternode, payment and budget messages waiting in the receive buffer of
+ * pfrom, and hand their signatures to the message signature check queue. They get
+ * verified in parallel while the messages before them are processed, and checking them
+ * again in ProcessMessage is then a signature cache hit. The decoded messages are kept
+ * for ProcessMessage, which reads them with CNode::ReadSignedMessage.
+ */
+static void PreVerifyMessageSignatures(CNode* pfrom)
+{
+    if (!nScriptCheckThreads)
+        return;
+
+    std::vector<CMessageSigCheck> vChecks;
+    // messages signed by the key of a masternode, looked up for all of them at once below
+    std::vector<std::shared_ptr<CSignedMessage> > vMasternodeSigned;
+    std::map<COutPoint, CPubKey> mapPubKeys;
+    for (CNetMessage& msg : pfrom->vRecvMsg) {
+        if (!msg.complete())
+            break;
+        if (msg.fSigChecksQueued)
+            continue;
+        msg.fSigChecksQueued = true;
+
+        const std::string strCommand = msg.hdr.GetCommand();
+        if (strCommand != "mnb" && strCommand != "mnp" && strCommand != "mnw" &&
+            strCommand != "mvote" && strCommand != "fbvote")
+            continue;
+
+        try {
+            CDataStream vRecv(msg.vRecv.begin(), msg.vRecv.end(), msg.vRecv.GetType(), msg.vRecv.GetVersion());
+            if (strCommand == "mnb") {
+                std::shared_ptr<CMasternodeBroadcast> pmnb = std::make_shared<CMasternodeBroadcast>();
+                vRecv >> *pmnb;
+                vChecks.push_back(pmnb->GetSignatureCheck(pmnb->pubKeyCollateralAddress));
+                vChecks.push_back(pmnb->lastPing.GetSignatureCheck(pmnb->pubKeyMasternode));
+                msg.pDecoded = pmnb;
+                continue;
+            }
+            if (strCommand == "mnp")
+                msg.pDecoded = DecodeSignedMessage<CMasternodePing>(vRecv);
+            else if (strCommand == "mnw")
+                msg.pDecoded = DecodeSignedMessage<CMasternodePaymentWinner>(vRecv);
+            else if (strCommand == "mvote")
+                msg.pDecoded = DecodeSignedMessage<CBudgetVote>(vRecv);
+            else
+                msg.pDecoded = DecodeSignedMessage<CFinalizedBudgetVote>(vRecv);
+            vMasternodeSigned.push_back(msg.pDecoded);
+            mapPubKeys[msg.pDecoded->GetVin().prevout] = CPubKey();
+        } catch (const std::exception&) {
+            // malformed, ProcessMessage will reject it
+            msg.pDecoded.reset();
+        }
+    }
+
+    if (!mapPubKeys.empty())
+        mnodeman.GetMasternodePubKeys(mapPubKeys);
+    for (const std::shared_ptr<CSignedMessage>& pmessage : vMasternodeSigned) {
+        const CPubKey& pubKey = mapPubKeys[pmessage->GetVin().prevout];
+        if (pubKey.IsValid())
+            vChecks.push_back(pmessage->GetSignatureCheck(pubKey));
+    }
+
+    if (!vChecks.empty())
+        QueueMessageSigChecks(vChecks);
+}
+
 // requires LOCK(cs_vRecvMsg)
 bool ProcessMessages(CNode* pfrom)
 {
@@ -7190,6 +7671,8 @@ bool ProcessMessages(CNode* pfrom)
     // this maintains the order of responses
     if (!pfrom->vRecvGetData.empty()) return fOk;
 
+    PreVerifyMessageSignatures(pfrom);
+
     std::deque<CNetMessage>::iterator it = pfrom->vRecvMsg.begin();
     while (!pfrom->fDisconnect && it != pfrom->vRecvMsg.end()) {
         // Don't bother if send buffer is too full to respond anyway
@@ -7242,6 +7725,7 @@ bool ProcessMessages(CNode* pfrom)
 
         // Process message
         bool fRet = false;
+        pfrom->pRecvDecoded.swap(msg.pDecoded);
         try {
             fRet = ProcessMessage(pfrom, strCommand, vRecv, msg.nTime);
             boost::this_thread::interruption_point();
@@ -7264,6 +7748,8 @@ bool ProcessMessages(CNode* pfrom)
             PrintExceptionContinue(NULL, "ProcessMessages()");
         }
 
+        pfrom->pRecvDecoded.reset();
+
         if (!fRet)
             LogPrintf("ProcessMessage(%s, %u bytes) FAILED peer=%d\n", SanitizeString(strCommand), nMessageSize, pfrom->id);
 
@@ -7563,6 +8049,117 @@ std::string CBlockFileInfo::ToString() const
     return strprintf("CBlockFileInfo(blocks=%u, size=%u, heights=%u...%u, time=%s...%s)", nBlocks, nSize, nHeightFirst, nHeightLast, DateTimeStrFormat("%Y-%m-%d", nTimeFirst), DateTimeStrFormat("%Y-%m-%d", nTimeLast));
 }
 
+static const uint64_t MEMPOOL_DUMP_VERSION = 1;
+
+bool LoadMempool()
+{
+    int64_t nStart = GetTimeMillis();
+
+    boost::filesystem::path path = GetDataDir() / "mempool.dat";
+    CAutoFile file(fopen(path.string().c_str(), "rb"), SER_DISK, CLIENT_VERSION);
+    if (file.IsNull()) {
+        LogPrintf("%s: failed to open %s, continuing anyway\n", __func__, path.string());
+        return false;
+    }
+
+    int64_t nAccepted = 0;
+    int64_t nFailed = 0;
+    int64_t nAlreadyThere = 0;
+    try {
+        uint64_t nVersion;
+        file >> nVersion;
+        if (nVersion != MEMPOOL_DUMP_VERSION)
+            return error("%s: unknown mempool.dat version %d", __func__, nVersion);
+
+        // Prioritisation comes first so that it is taken into account by the fee checks
+        std::map<uint256, std::pair<double, CAmount> > mapDeltas;
+        file >> mapDeltas;
+        for (const auto& it : mapDeltas)
+            mempool.PrioritiseTransaction(it.first, it.first.ToString(), it.second.first, it.second.second);
+
+        uint64_t nCount;
+        file >> nCount;
+        std::vector<CTransaction> vtx;
+        std::vector<int64_t> vTime;
+        while (nCount > 0) {
+            // Transactions were dumped parents first: a batch only needs the batches before it
+            vtx.clear();
+            vTime.clear();
+            for (; nCount > 0 && vtx.size() < MEMPOOL_LOAD_BATCH_SIZE; nCount--) {
+                CTransaction tx;
+                int64_t nTime;
+                file >> tx >> nTime;
+                vtx.push_back(tx);
+                vTime.push_back(nTime);
+            }
+
+            // Check the signatures of the whole batch in parallel, without cs_main
+            PreVerifyTransactions(mempool, vtx);
+
+            LOCK(cs_main);
+            for (unsigned int i = 0; i < vtx.size(); i++) {
+                CValidationState state;
+                if (mempool.exists(vtx[i].GetHash())) {
+                    nAlreadyThere++;
+                } else if (AcceptToMemoryPoolWithTime(mempool, state, vtx[i], true, nullptr, vTime[i], false, false)) {
+                    nAccepted++;
+                } else {
+                    nFailed++;
+                }
+            }
+            if (ShutdownRequested())
+                return false;
+        }
+    } catch (const std::exception& e) {
+        LogPrintf("%s: failed to deserialize mempool data on disk: %s, continuing anyway\n", __func__, e.what());
+        return false;
+    }
+
+    LogPrintf("Imported mempool transactions from disk: %i successes, %i failed, %i already there  %dms\n",
+            nAccepted, nFailed, nAlreadyThere, GetTimeMillis() - nStart);
+    return true;
+}
+
+bool DumpMempool()
+{
+    int64_t nStart = GetTimeMillis();
+
+    std::map<uint256, std::pair<double, CAmount> > mapDeltas;
+    std::vector<CTxMemPoolEntry> vEntries;
+    {
+        LOCK(mempool.cs);
+        mapDeltas = mempool.mapDeltas;
+        mempool.queryEntriesInDependencyOrder(vEntries);
+    }
+
+    int64_t nMid = GetTimeMillis();
+
+    boost::filesystem::path path = GetDataDir() / "mempool.dat";
+    boost::filesystem::path pathNew = GetDataDir() / "mempool.dat.new";
+    try {
+        FILE* filestr = fopen(pathNew.string().c_str(), "wb");
+        if (!filestr)
+            return error("%s: failed to open %s", __func__, pathNew.string());
+
+        CAutoFile file(filestr, SER_DISK, CLIENT_VERSION);
+        file << MEMPOOL_DUMP_VERSION;
+        file << mapDeltas;
+        file << (uint64_t)vEntries.size();
+        for (const CTxMemPoolEntry& entry : vEntries)
+            file << entry.GetTx() << entry.GetTime();
+
+        FileCommit(file.Get());
+        file.fclose();
+        RenameOver(pathNew, path);
+    } catch (const std::exception& e) {
+        return error("%s: failed to dump mempool: %s", __func__, e.what());
+    }
+
+    int64_t nLast = GetTimeMillis();
+    LogPrintf("Dumped mempool: %dms to copy, %dms to dump\n", nMid - nStart, nLast - nMid);
+    return true;
+}
+
 
 class CMainCleanup
 {
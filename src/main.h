@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <exception>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdint.h>
 #include <string>
@@ -50,6 +51,7 @@
 
 class CBlockIndex;
 class CBlockTreeDB;
+class CCoinsViewBackgroundWriter;
 class CZerocoinDB;
 class CSporkDB;
 class CBloomFilter;
@@ -87,6 +89,10 @@ static const unsigned int MAX_BLOCKFILE_SIZE = 0x8000000; // 128 MiB
 static const unsigned int BLOCKFILE_CHUNK_SIZE = 0x1000000; // 16 MiB
 /** The pre-allocation chunk size for rev?????.dat files (since 0.8) */
 static const unsigned int UNDOFILE_CHUNK_SIZE = 0x100000; // 1 MiB
+/** Default for -persistmempool */
+static const bool DEFAULT_PERSIST_MEMPOOL = true;
+/** Number of mempool.dat transactions pre-verified together on startup */
+static const unsigned int MEMPOOL_LOAD_BATCH_SIZE = 256;
 /** Maximum number of script-checking threads allowed */
 static const int MAX_SCRIPTCHECK_THREADS = 16;
 /** -par default (number of script-checking threads, 0 = auto) */
@@ -105,6 +111,8 @@ static const unsigned int MAX_HEADERS_RESULTS = 2000;
 static const unsigned int BLOCK_DOWNLOAD_WINDOW = 1024;
 /** Time to wait (in seconds) between writing blockchain state to disk. */
 static const unsigned int DATABASE_WRITE_INTERVAL = 3600;
+/** Share (in percent) of the coins cache budget kept warm after a flush forced by the cache size. */
+static const unsigned int COINS_CACHE_RETAIN_PERCENT = 50;
 /** Maximum length of reject messages. */
 static const unsigned int MAX_REJECT_MESSAGE_LENGTH = 111;
 
@@ -159,7 +167,7 @@ extern int nScriptCheckThreads;
 extern bool fTxIndex;
 extern bool fIsBareMultisigStd;
 extern bool fCheckBlockIndex;
-extern unsigned int nCoinCacheSize;
+extern size_t nCoinCacheUsage;
 extern CFeeRate minRelayTxFee;
 extern bool fAlerts;
 extern int64_t nMaxTipAge;
@@ -232,6 +240,8 @@ bool ProcessMessages(CNode* pfrom);
 bool SendMessages(CNode* pto, bool fSendTrickle);
 /** Run an instance of the script checking thread */
 void ThreadScriptCheck();
+/** Run an instance of the mempool precheck script checking thread */
+void ThreadMempoolScriptCheck();
 
 /** Check whether we are doing an initial block download (synchronizing from disk or network) */
 bool IsInitialBlockDownload();
@@ -261,11 +271,28 @@ bool GetNodeStateStats(NodeId nodeid, CNodeStateStats& stats);
 void Misbehaving(NodeId nodeid, int howmuch);
 /** Flush all state, indexes and buffers to disk. */
 void FlushStateToDisk();
+/** Dump the mempool to mempool.dat, parents before children. */
+bool DumpMempool();
+/** Reload mempool.dat through AcceptToMemoryPool, pre-verifying it in batches. */
+bool LoadMempool();
 
 
 /** (try to) add transaction to memory pool **/
 bool AcceptToMemoryPool(CTxMemPool& pool, CValidationState& state, const CTransaction& tx, bool fLimitFree, bool* pfMissingInputs, bool fRejectInsaneFee = false, bool ignoreFees = false);
 
+/**
+ * Check a loose transaction without holding cs_main for long: CheckTransaction and the
+ * standardness rules first, then its input scripts on the mempool check threads, against
+ * a snapshot of the spent coins. This warms the signature cache for the script checks
+ * AcceptToMemoryPool does later under cs_main. Failures are remembered until the tip
+ * changes, so a repeated invalid transaction is answered without verifying it again.
+ * Returns false with state set if a check failed; a transaction that passes can still be
+ * refused by AcceptToMemoryPool, which remains authoritative.
+ */
+bool PreVerifyTransaction(CTxMemPool& pool, const CTransaction& tx, CValidationState& state);
+/** Pre-verify a batch of transactions, spreading all their script checks over the mempool check threads */
+bool PreVerifyTransactions(CTxMemPool& pool, const std::vector<CTransaction>& vtx);
+
 bool AcceptableInputs(CTxMemPool& pool, CValidationState& state, const CTransaction& tx, bool fLimitFree, bool* pfMissingInputs, bool fRejectInsaneFee = false, bool isDSTX = false);
 
 int GetInputAge(CTxIn& vin);
@@ -367,9 +394,8 @@ bool IsTransactionInChain(const uint256& txId, int& nHeightTx);
 bool IsBlockHashInChain(const uint256& hashBlock);
 bool ValidOutPoint(const COutPoint& out, int nHeight);
 void AddWrappedSerialsInflation();
-void RecalculateZPIVSpent();
-void RecalculateZPIVMinted();
-bool RecalculatePIVSupply(int nHeightStart);
+bool RecalculateZPIVSupply(int nHeightStart, bool fInterruptible = false);
+bool RecalculatePIVSupply(int nHeightStart, bool fInterruptible = false);
 bool ReindexAccumulators(std::list<uint256>& listMissingCheckpoints, std::string& strError);
 
 // Fake Serial attack Range
@@ -454,6 +480,8 @@ public:
 bool WriteBlockToDisk(CBlock& block, CDiskBlockPos& pos);
 bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex);
+/** Read the serialized block of pindex from disk without deserializing its transactions */
+bool ReadRawBlockFromDisk(std::string& strBlock, const CBlockIndex* pindex);
 
 
 /** Functions for validating blocks and updating the block tree */
@@ -640,9 +668,61 @@ bool ReconsiderBlock(CValidationState& state, CBlockIndex* pindex);
 /** The currently-connected chain of blocks. */
 extern CChain chainActive;
 
+/**
+ * Read-only view of the active chain at one tip, for readers that don't take cs_main.
+ * A new snapshot is published every time the tip changes; holders of an older one
+ * keep a consistent view of the chain as it was. Block index entries are never freed
+ * while running, so the chain is walked from the tip through its ancestors.
+ */
+struct CChainTipSnapshot {
+    //! The tip, NULL before the block index is loaded
+    const CBlockIndex* pindexTip;
+    int nHeight;
+    //! mempool.GetTransactionsUpdated() when the snapshot was taken
+    unsigned int nMempoolSequence;
+
+    CChainTipSnapshot() : pindexTip(NULL), nHeight(-1), nMempoolSequence(0) {}
+
+    const CBlockIndex* Tip() const { return pindexTip; }
+    int Height() const { return nHeight; }
+
+    /** The block at nHeightIn on this chain, or NULL (like chainActive[]) */
+    const CBlockIndex* operator[](int nHeightIn) const
+    {
+        if (nHeightIn < 0 || nHeightIn > nHeight)
+            return NULL;
+        return pindexTip->GetAncestor(nHeightIn);
+    }
+
+    /** Whether pindex is part of this chain (like chainActive.Contains) */
+    bool Contains(const CBlockIndex* pindex) const
+    {
+        return pindex && (*this)[pindex->nHeight] == pindex;
+    }
+
+    /** The successor of pindex on this chain, or NULL (like chainActive.Next) */
+    const CBlockIndex* Next(const CBlockIndex* pindex) const
+    {
+        if (!Contains(pindex))
+            return NULL;
+        return (*this)[pindex->nHeight + 1];
+    }
+};
+
+typedef std::shared_ptr<const CChainTipSnapshot> ChainTipSnapshotRef;
+
+/** Latest snapshot of the active chain; doesn't need cs_main */
+ChainTipSnapshotRef GetChainTipSnapshot();
+
+/** Find a block index entry by hash, holding cs_main only for the lookup. Returns NULL if unknown. */
+CBlockIndex* LookupBlockIndex(const uint256& hash);
+
 /** Global variable that points to the active CCoinsView (protected by cs_main) */
 extern CCoinsViewCache* pcoinsTip;
 
+/** Global variable that points to the background chainstate writer, if one is running (protected by cs_main) */
+extern CCoinsViewBackgroundWriter* pcoinsWriter;
+
 /** Global variable that points to the active block tree (protected by cs_main) */
 extern CBlockTreeDB* pblocktree;
 
@@ -268,39 +268,17 @@ void CBudgetManager::SubmitFinalBudget()
 // CBudgetDB
 //
 
-CBudgetDB::CBudgetDB()
+CBudgetDB::CBudgetDB() : CCacheFile(GetDataDir() / "budget.dat", "MasternodeBudget")
 {
-    pathDB = GetDataDir() / "budget.dat";
-    strMagicMessage = "MasternodeBudget";
 }
 
 bool CBudgetDB::Write(const CBudgetManager& objToSave)
 {
-    LOCK(objToSave.cs);
-
     int64_t nStart = GetTimeMillis();
 
-    // serialize, checksum data up to that point, then append checksum
-    CDataStream ssObj(SER_DISK, CLIENT_VERSION);
-    ssObj << strMagicMessage;                   // masternode cache file specific magic message
-    ssObj << FLATDATA(Params().MessageStart()); // network specific magic number
-    ssObj << objToSave;
-    uint256 hash = Hash(ssObj.begin(), ssObj.end());
-    ssObj << hash;
-
-    // open output file, and associate with CAutoFile
-    FILE* file = fopen(pathDB.string().c_str(), "wb");
-    CAutoFile fileout(file, SER_DISK, CLIENT_VERSION);
-    if (fileout.IsNull())
-        return error("%s : Failed to open file %s", __func__, pathDB.string());
-
-    // Write and commit header, data
-    try {
-        fileout << ssObj;
-    } catch (const std::exception& e) {
-        return error("%s : Serialize or I/O error - %s", __func__, e.what());
-    }
-    fileout.fclose();
+    objToSave.WriteCacheChunks(*this);
+    if (!CCacheFile::Write())
+        return false;
 
     LogPrint("mnbudget","Written info to budget.dat  %dms\n", GetTimeMillis() - nStart);
 
@@ -309,85 +287,22 @@ bool CBudgetDB::Write(const CBudgetManager& objToSave)
 
 CBudgetDB::ReadResult CBudgetDB::Read(CBudgetManager& objToLoad, bool fDryRun)
 {
-    LOCK(objToLoad.cs);
-
     int64_t nStart = GetTimeMillis();
-    // open input file, and associate with CAutoFile
-    FILE* file = fopen(pathDB.string().c_str(), "rb");
-    CAutoFile filein(file, SER_DISK, CLIENT_VERSION);
-    if (filein.IsNull()) {
-        error("%s : Failed to open file %s", __func__, pathDB.string());
-        return FileError;
-    }
 
-    // use file size to size memory buffer
-    int fileSize = boost::filesystem::file_size(pathDB);
-    int dataSize = fileSize - sizeof(uint256);
-    // Don't try to resize to a negative number if file is small
-    if (dataSize < 0)
-        dataSize = 0;
-    std::vector<unsigned char> vchData;
-    vchData.resize(dataSize);
-    uint256 hashIn;
+    ReadResult result = CCacheFile::Read(fDryRun);
+    if (result != Ok || fDryRun)
+        return result;
 
-    // read data and checksum from file
-    try {
-        filein.read((char*)&vchData[0], dataSize);
-        filein >> hashIn;
-    } catch (const std::exception& e) {
-        error("%s : Deserialize or I/O error - %s", __func__, e.what());
-        return HashReadError;
-    }
-    filein.fclose();
-
-    CDataStream ssObj(vchData, SER_DISK, CLIENT_VERSION);
-
-    // verify stored checksum matches input data
-    uint256 hashTmp = Hash(ssObj.begin(), ssObj.end());
-    if (hashIn != hashTmp) {
-        error("%s : Checksum mismatch, data corrupted", __func__);
-        return IncorrectHash;
-    }
-
-
-    unsigned char pchMsgTmp[4];
-    std::string strMagicMessageTmp;
-    try {
-        // de-serialize file header (masternode cache file specific magic message) and ..
-        ssObj >> strMagicMessageTmp;
-
-        // ... verify the message matches predefined one
-        if (strMagicMessage != strMagicMessageTmp) {
-            error("%s : Invalid masternode cache magic message", __func__);
-            return IncorrectMagicMessage;
-        }
-
-
-        // de-serialize file header (network specific magic number) and ..
-        ssObj >> FLATDATA(pchMsgTmp);
-
-        // ... verify the network matches ours
-        if (memcmp(pchMsgTmp, Params().MessageStart(), sizeof(pchMsgTmp))) {
-            error("%s : Invalid network magic number", __func__);
-            return IncorrectMagicNumber;
-        }
-
-        // de-serialize data into CBudgetManager object
-        ssObj >> objToLoad;
-    } catch (const std::exception& e) {
-        objToLoad.Clear();
-        error("%s : Deserialize or I/O error - %s", __func__, e.what());
-        return IncorrectFormat;
-    }
+    // chunks that failed their integrity check are simply re-synced from the network
+    if (!objToLoad.ReadCacheChunks(*this))
+        LogPrintf("%s : some chunks of budget.dat were lost, continuing with the others\n", __func__);
 
     LogPrint("mnbudget","Loaded info from budget.dat  %dms\n", GetTimeMillis() - nStart);
     LogPrint("mnbudget","  %s\n", objToLoad.ToString());
-    if (!fDryRun) {
-        LogPrint("mnbudget","Budget manager - cleaning....\n");
-        objToLoad.CheckAndRemove();
-        LogPrint("mnbudget","Budget manager - result:\n");
-        LogPrint("mnbudget","  %s\n", objToLoad.ToString());
-    }
+    LogPrint("mnbudget","Budget manager - cleaning....\n");
+    objToLoad.CheckAndRemove();
+    LogPrint("mnbudget","Budget manager - result:\n");
+    LogPrint("mnbudget","  %s\n", objToLoad.ToString());
 
     return Ok;
 }
@@ -429,9 +344,41 @@ bool CBudgetManager::AddFinalizedBudget(CFinalizedBudget& finalizedBudget)
     }
 
     mapFinalizedBudgets.insert(std::make_pair(finalizedBudget.GetHash(), finalizedBudget));
+    AddFinalizedBudgetToIndex(finalizedBudget);
     return true;
 }
 
+void CBudgetManager::AddFinalizedBudgetToIndex(CFinalizedBudget& finalizedBudget)
+{
+    const uint256 nHash = finalizedBudget.GetHash();
+    for (int nHeight = finalizedBudget.GetBlockStart(); nHeight <= finalizedBudget.GetBlockEnd(); nHeight++)
+        mapFinalizedBudgetsByHeight[nHeight].insert(nHash);
+}
+
+void CBudgetManager::RebuildFinalizedBudgetIndex()
+{
+    mapFinalizedBudgetsByHeight.clear();
+    for (auto& it : mapFinalizedBudgets)
+        AddFinalizedBudgetToIndex(it.second);
+}
+
+// Finalized budgets paying nBlockHeight, in the same (hash) order as mapFinalizedBudgets
+std::vector<CFinalizedBudget*> CBudgetManager::GetFinalizedBudgetsByHeight(int nBlockHeight)
+{
+    std::vector<CFinalizedBudget*> vFinalizedBudgets;
+
+    std::map<int, std::set<uint256> >::const_iterator mi = mapFinalizedBudgetsByHeight.find(nBlockHeight);
+    if (mi == mapFinalizedBudgetsByHeight.end())
+        return vFinalizedBudgets;
+
+    for (const uint256& nHash : mi->second) {
+        std::map<uint256, CFinalizedBudget>::iterator it = mapFinalizedBudgets.find(nHash);
+        if (it != mapFinalizedBudgets.end())
+            vFinalizedBudgets.push_back(&(it->second));
+    }
+    return vFinalizedBudgets;
+}
+
 bool CBudgetManager::AddProposal(CBudgetProposal& budgetProposal)
 {
     LOCK(cs);
@@ -516,6 +463,7 @@ void CBudgetManager::CheckAndRemove()
     // Remove invalid entries by overwriting complete map
     mapFinalizedBudgets.swap(tmpMapFinalizedBudgets);
     mapProposals.swap(tmpMapProposals);
+    RebuildFinalizedBudgetIndex();
 
     // clang doesn't accept copy assignemnts :-/
     // mapFinalizedBudgets = tmpMapFinalizedBudgets;
@@ -540,17 +488,11 @@ void CBudgetManager::FillBlockPayee(CMutableTransaction& txNew, CAmount nFees, b
 
     // ------- Grab The Highest Count
 
-    std::map<uint256, CFinalizedBudget>::iterator it = mapFinalizedBudgets.begin();
-    while (it != mapFinalizedBudgets.end()) {
-        CFinalizedBudget* pfinalizedBudget = &((*it).second);
+    for (CFinalizedBudget* pfinalizedBudget : GetFinalizedBudgetsByHeight(pindexPrev->nHeight + 1)) {
         if (pfinalizedBudget->GetVoteCount() > nHighestCount &&
-            pindexPrev->nHeight + 1 >= pfinalizedBudget->GetBlockStart() &&
-            pindexPrev->nHeight + 1 <= pfinalizedBudget->GetBlockEnd() &&
             pfinalizedBudget->GetPayeeAndAmount(pindexPrev->nHeight + 1, payee, nAmount)) {
             nHighestCount = pfinalizedBudget->GetVoteCount();
         }
-
-        ++it;
     }
 
     CAmount blockValue = GetBlockValue(pindexPrev->nHeight);
@@ -634,16 +576,9 @@ bool CBudgetManager::IsBudgetPaymentBlock(int nBlockHeight)
     int nHighestCount = -1;
     int nFivePercent = mnodeman.CountEnabled(ActiveProtocol()) / 20;
 
-    std::map<uint256, CFinalizedBudget>::iterator it = mapFinalizedBudgets.begin();
-    while (it != mapFinalizedBudgets.end()) {
-        CFinalizedBudget* pfinalizedBudget = &((*it).second);
-        if (pfinalizedBudget->GetVoteCount() > nHighestCount &&
-            nBlockHeight >= pfinalizedBudget->GetBlockStart() &&
-            nBlockHeight <= pfinalizedBudget->GetBlockEnd()) {
+    for (CFinalizedBudget* pfinalizedBudget : GetFinalizedBudgetsByHeight(nBlockHeight)) {
+        if (pfinalizedBudget->GetVoteCount() > nHighestCount)
             nHighestCount = pfinalizedBudget->GetVoteCount();
-        }
-
-        ++it;
     }
 
     LogPrint("mnbudget","CBudgetManager::IsBudgetPaymentBlock() - nHighestCount: %lli, 5%% of Masternodes: %lli. Number of finalized budgets: %lli\n",
@@ -668,17 +603,10 @@ TrxValidationStatus CBudgetManager::IsTransactionValid(const CTransaction& txNew
 
     // ------- Grab The Highest Count
 
-    std::map<uint256, CFinalizedBudget>::iterator it = mapFinalizedBudgets.begin();
-    while (it != mapFinalizedBudgets.end()) {
-        CFinalizedBudget* pfinalizedBudget = &((*it).second);
-
-        if (pfinalizedBudget->GetVoteCount() > nHighestCount &&
-            nBlockHeight >= pfinalizedBudget->GetBlockStart() &&
-            nBlockHeight <= pfinalizedBudget->GetBlockEnd()) {
+    const std::vector<CFinalizedBudget*> vFinalizedBudgets = GetFinalizedBudgetsByHeight(nBlockHeight);
+    for (CFinalizedBudget* pfinalizedBudget : vFinalizedBudgets) {
+        if (pfinalizedBudget->GetVoteCount() > nHighestCount)
             nHighestCount = pfinalizedBudget->GetVoteCount();
-        }
-
-        ++it;
     }
 
     LogPrint("mnbudget","CBudgetManager::IsTransactionValid() - nHighestCount: %lli, 5%% of Masternodes: %lli mapFinalizedBudgets.size(): %ld\n",
@@ -693,36 +621,36 @@ TrxValidationStatus CBudgetManager::IsTransactionValid(const CTransaction& txNew
     std::string strProposals = "";
     int nCountThreshold = nHighestCount - mnodeman.CountEnabled(ActiveProtocol()) / 10;
     bool fThreshold = false;
-    it = mapFinalizedBudgets.begin();
-    while (it != mapFinalizedBudgets.end()) {
-        CFinalizedBudget* pfinalizedBudget = &((*it).second);
-        strProposals = pfinalizedBudget->GetProposals();
-
-        LogPrint("mnbudget","CBudgetManager::IsTransactionValid - checking budget (%s) with blockstart %lli, blockend %lli, nBlockHeight %lli, votes %lli, nCountThreshold %lli\n",
-                 strProposals.c_str(), pfinalizedBudget->GetBlockStart(), pfinalizedBudget->GetBlockEnd(),
-                 nBlockHeight, pfinalizedBudget->GetVoteCount(), nCountThreshold);
+    for (CFinalizedBudget* pfinalizedBudget : vFinalizedBudgets) {
+        if (LogAcceptCategory("mnbudget")) {
+            strProposals = pfinalizedBudget->GetProposals();
+            LogPrint("mnbudget","CBudgetManager::IsTransactionValid - checking budget (%s) with blockstart %lli, blockend %lli, nBlockHeight %lli, votes %lli, nCountThreshold %lli\n",
+                     strProposals.c_str(), pfinalizedBudget->GetBlockStart(), pfinalizedBudget->GetBlockEnd(),
+                     nBlockHeight, pfinalizedBudget->GetVoteCount(), nCountThreshold);
+        }
 
         if (pfinalizedBudget->GetVoteCount() > nCountThreshold) {
             fThreshold = true;
             LogPrint("mnbudget","CBudgetManager::IsTransactionValid - GetVoteCount() > nCountThreshold passed\n");
-            if (nBlockHeight >= pfinalizedBudget->GetBlockStart() && nBlockHeight <= pfinalizedBudget->GetBlockEnd()) {
-                LogPrint("mnbudget","CBudgetManager::IsTransactionValid - GetBlockStart() passed\n");
-                transactionStatus = pfinalizedBudget->IsTransactionValid(txNew, nBlockHeight);
-                if (transactionStatus == TrxValidationStatus::Valid) {
-                    LogPrint("mnbudget","CBudgetManager::IsTransactionValid - pfinalizedBudget->IsTransactionValid() passed\n");
-                    return TrxValidationStatus::Valid;
-                }
-                else {
-                    LogPrint("mnbudget","CBudgetManager::IsTransactionValid - pfinalizedBudget->IsTransactionValid() error\n");
-                }
+            transactionStatus = pfinalizedBudget->IsTransactionValid(txNew, nBlockHeight);
+            if (transactionStatus == TrxValidationStatus::Valid) {
+                LogPrint("mnbudget","CBudgetManager::IsTransactionValid - pfinalizedBudget->IsTransactionValid() passed\n");
+                return TrxValidationStatus::Valid;
             }
             else {
-                LogPrint("mnbudget","CBudgetManager::IsTransactionValid - GetBlockStart() failed, budget is outside current payment cycle and will be ignored.\n");
+                LogPrint("mnbudget","CBudgetManager::IsTransactionValid - pfinalizedBudget->IsTransactionValid() error\n");
             }
-
         }
+    }
 
-        ++it;
+    // budgets outside of the current payment cycle still count towards the vote threshold
+    if (!fThreshold) {
+        for (auto& it : mapFinalizedBudgets) {
+            if (it.second.GetVoteCount() > nCountThreshold) {
+                fThreshold = true;
+                break;
+            }
+        }
     }
 
     // If not enough masternodes autovoted for any of the finalized budgets pay a masternode instead
@@ -879,24 +807,18 @@ std::string CBudgetManager::GetRequiredPaymentsString(int nBlockHeight)
 
     std::string ret = "unknown-budget";
 
-    std::map<uint256, CFinalizedBudget>::iterator it = mapFinalizedBudgets.begin();
-    while (it != mapFinalizedBudgets.end()) {
-        CFinalizedBudget* pfinalizedBudget = &((*it).second);
-        if (nBlockHeight >= pfinalizedBudget->GetBlockStart() && nBlockHeight <= pfinalizedBudget->GetBlockEnd()) {
-            CTxBudgetPayment payment;
-            if (pfinalizedBudget->GetBudgetPaymentByBlock(nBlockHeight, payment)) {
-                if (ret == "unknown-budget") {
-                    ret = payment.nProposalHash.ToString();
-                } else {
-                    ret += ",";
-                    ret += payment.nProposalHash.ToString();
-                }
+    for (CFinalizedBudget* pfinalizedBudget : GetFinalizedBudgetsByHeight(nBlockHeight)) {
+        CTxBudgetPayment payment;
+        if (pfinalizedBudget->GetBudgetPaymentByBlock(nBlockHeight, payment)) {
+            if (ret == "unknown-budget") {
+                ret = payment.nProposalHash.ToString();
             } else {
-                LogPrint("mnbudget","CBudgetManager::GetRequiredPaymentsString - Couldn't find budget payment for block %d\n", nBlockHeight);
+                ret += ",";
+                ret += payment.nProposalHash.ToString();
             }
+        } else {
+            LogPrint("mnbudget","CBudgetManager::GetRequiredPaymentsString - Couldn't find budget payment for block %d\n", nBlockHeight);
         }
-
-        ++it;
     }
 
     return ret;
@@ -1123,8 +1045,8 @@ void CBudgetManager::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
     }
 
     if (strCommand == "mvote") { //Masternode Vote
-        CBudgetVote vote;
-        vRecv >> vote;
+        std::shared_ptr<CBudgetVote> pvote = pfrom->ReadSignedMessage<CBudgetVote>(vRecv);
+        CBudgetVote& vote = *pvote;
         vote.fValid = true;
 
         if (mapSeenMasternodeBudgetVotes.count(vote.GetHash())) {
@@ -1198,8 +1120,8 @@ void CBudgetManager::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
     }
 
     if (strCommand == "fbvote") { //Finalized Budget Vote
-        CFinalizedBudgetVote vote;
-        vRecv >> vote;
+        std::shared_ptr<CFinalizedBudgetVote> pvote = pfrom->ReadSignedMessage<CFinalizedBudgetVote>(vRecv);
+        CFinalizedBudgetVote& vote = *pvote;
         vote.fValid = true;
 
         if (mapSeenFinalizedBudgetVotes.count(vote.GetHash())) {
@@ -1449,6 +1371,10 @@ CBudgetProposal::CBudgetProposal()
     nAmount = 0;
     nTime = 0;
     fValid = true;
+    nYeas = 0;
+    nNays = 0;
+    nAbstains = 0;
+    nVotesCheckedListVersion = -1;
 }
 
 CBudgetProposal::CBudgetProposal(std::string strProposalNameIn, std::string strURLIn, int nBlockStartIn, int nBlockEndIn, CScript addressIn, CAmount nAmountIn, uint256 nFeeTXHashIn)
@@ -1461,6 +1387,10 @@ CBudgetProposal::CBudgetProposal(std::string strProposalNameIn, std::string strU
     nAmount = nAmountIn;
     nFeeTXHash = nFeeTXHashIn;
     fValid = true;
+    nYeas = 0;
+    nNays = 0;
+    nAbstains = 0;
+    nVotesCheckedListVersion = -1;
 }
 
 CBudgetProposal::CBudgetProposal(const CBudgetProposal& other)
@@ -1474,6 +1404,10 @@ CBudgetProposal::CBudgetProposal(const CBudgetProposal& other)
     nTime = other.nTime;
     nFeeTXHash = other.nFeeTXHash;
     mapVotes = other.mapVotes;
+    nYeas = other.nYeas;
+    nNays = other.nNays;
+    nAbstains = other.nAbstains;
+    nVotesCheckedListVersion = other.nVotesCheckedListVersion;
     fValid = true;
 }
 
@@ -1609,7 +1543,11 @@ bool CBudgetProposal::AddOrUpdateVote(CBudgetVote& vote, std::string& strError)
         return false;
     }
 
+    std::map<uint256, CBudgetVote>::iterator it = mapVotes.find(hash);
+    if (it != mapVotes.end())
+        AddVoteToTally(it->second, -1);
     mapVotes[hash] = vote;
+    AddVoteToTally(vote, 1);
     LogPrint("mnbudget", "CBudgetProposal::AddOrUpdateVote - %s %s\n", strAction.c_str(), vote.GetHash().ToString().c_str());
 
     return true;
@@ -1618,12 +1556,39 @@ bool CBudgetProposal::AddOrUpdateVote(CBudgetVote& vote, std::string& strError)
 // If masternode voted for a proposal, but is now invalid -- remove the vote
 void CBudgetProposal::CleanAndRemove(bool fSignatureCheck)
 {
+    // without signature checks, a vote is only invalidated by its masternode leaving the list
+    const int nListVersion = mnodeman.GetListVersion();
+    if (!fSignatureCheck && nVotesCheckedListVersion == nListVersion)
+        return;
+
     std::map<uint256, CBudgetVote>::iterator it = mapVotes.begin();
 
     while (it != mapVotes.end()) {
         (*it).second.fValid = (*it).second.CheckSignature(fSignatureCheck);
         ++it;
     }
+
+    RecountVotes();
+    nVotesCheckedListVersion = nListVersion;
+}
+
+void CBudgetProposal::AddVoteToTally(const CBudgetVote& vote, int nSign)
+{
+    if (!vote.fValid) return;
+
+    if (vote.nVote == VOTE_YES) nYeas += nSign;
+    else if (vote.nVote == VOTE_NO) nNays += nSign;
+    else if (vote.nVote == VOTE_ABSTAIN) nAbstains += nSign;
+}
+
+void CBudgetProposal::RecountVotes()
+{
+    nYeas = 0;
+    nNays = 0;
+    nAbstains = 0;
+
+    for (const auto& it : mapVotes)
+        AddVoteToTally(it.second, 1);
 }
 
 double CBudgetProposal::GetRatio()
@@ -1646,41 +1611,17 @@ double CBudgetProposal::GetRatio()
 
 int CBudgetProposal::GetYeas() const
 {
-    int ret = 0;
-
-    std::map<uint256, CBudgetVote>::const_iterator it = mapVotes.begin();
-    while (it != mapVotes.end()) {
-        if ((*it).second.nVote == VOTE_YES && (*it).second.fValid) ret++;
-        ++it;
-    }
-
-    return ret;
+    return nYeas;
 }
 
 int CBudgetProposal::GetNays() const
 {
-    int ret = 0;
-
-    std::map<uint256, CBudgetVote>::const_iterator it = mapVotes.begin();
-    while (it != mapVotes.end()) {
-        if ((*it).second.nVote == VOTE_NO && (*it).second.fValid) ret++;
-        ++it;
-    }
-
-    return ret;
+    return nNays;
 }
 
 int CBudgetProposal::GetAbstains() const
 {
-    int ret = 0;
-
-    std::map<uint256, CBudgetVote>::const_iterator it = mapVotes.begin();
-    while (it != mapVotes.end()) {
-        if ((*it).second.nVote == VOTE_ABSTAIN && (*it).second.fValid) ret++;
-        ++it;
-    }
-
-    return ret;
+    return nAbstains;
 }
 
 int CBudgetProposal::GetBlockStartCycle()
@@ -1799,6 +1740,7 @@ std::string CBudgetVote::GetStrMessage() const
 
 CFinalizedBudget::CFinalizedBudget() :
         fAutoChecked(false),
+        nVotesCheckedListVersion(-1),
         fValid(true),
         strBudgetName(""),
         nBlockStart(0),
@@ -1810,6 +1752,7 @@ CFinalizedBudget::CFinalizedBudget() :
 
 CFinalizedBudget::CFinalizedBudget(const CFinalizedBudget& other) :
         fAutoChecked(false),
+        nVotesCheckedListVersion(other.nVotesCheckedListVersion),
         fValid(true),
         strBudgetName(other.strBudgetName),
         nBlockStart(other.nBlockStart),
@@ -1961,12 +1904,18 @@ void CFinalizedBudget::CheckAndVote()
 // Remove votes from masternodes which are not valid/existent anymore
 void CFinalizedBudget::CleanAndRemove(bool fSignatureCheck)
 {
+    const int nListVersion = mnodeman.GetListVersion();
+    if (!fSignatureCheck && nVotesCheckedListVersion == nListVersion)
+        return;
+
     std::map<uint256, CFinalizedBudgetVote>::iterator it = mapVotes.begin();
 
     while (it != mapVotes.end()) {
         (*it).second.fValid = (*it).second.CheckSignature(fSignatureCheck);
         ++it;
     }
+
+    nVotesCheckedListVersion = nListVersion;
 }
 
 CAmount CFinalizedBudget::GetTotalPayout()
@@ -2287,6 +2236,34 @@ std::string CFinalizedBudgetVote::GetStrMessage() const
     return vin.prevout.ToStringShort() + nBudgetHash.ToString() + std::to_string(nTime);
 }
 
+void CBudgetManager::WriteCacheChunks(CCacheFile& file) const
+{
+    LOCK(cs);
+    file.AddMapChunks("seenproposals", mapSeenMasternodeBudgetProposals);
+    file.AddMapChunks("seenvotes", mapSeenMasternodeBudgetVotes);
+    file.AddMapChunks("seenfinalized", mapSeenFinalizedBudgets);
+    file.AddMapChunks("seenfinalizedvotes", mapSeenFinalizedBudgetVotes);
+    file.AddMapChunks("orphanvotes", mapOrphanMasternodeBudgetVotes);
+    file.AddMapChunks("orphanfinalizedvotes", mapOrphanFinalizedBudgetVotes);
+    file.AddMapChunks("proposals", mapProposals);
+    file.AddMapChunks("finalized", mapFinalizedBudgets);
+}
+
+bool CBudgetManager::ReadCacheChunks(const CCacheFile& file)
+{
+    LOCK(cs);
+    bool fComplete = file.GetMapChunks("seenproposals", mapSeenMasternodeBudgetProposals);
+    fComplete = file.GetMapChunks("seenvotes", mapSeenMasternodeBudgetVotes) && fComplete;
+    fComplete = file.GetMapChunks("seenfinalized", mapSeenFinalizedBudgets) && fComplete;
+    fComplete = file.GetMapChunks("seenfinalizedvotes", mapSeenFinalizedBudgetVotes) && fComplete;
+    fComplete = file.GetMapChunks("orphanvotes", mapOrphanMasternodeBudgetVotes) && fComplete;
+    fComplete = file.GetMapChunks("orphanfinalizedvotes", mapOrphanFinalizedBudgetVotes) && fComplete;
+    fComplete = file.GetMapChunks("proposals", mapProposals) && fComplete;
+    fComplete = file.GetMapChunks("finalized", mapFinalizedBudgets) && fComplete;
+    RebuildFinalizedBudgetIndex();
+    return fComplete;
+}
+
 std::string CBudgetManager::ToString() const
 {
     std::ostringstream info;
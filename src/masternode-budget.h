@@ -7,6 +7,7 @@
 #define MASTERNODE_BUDGET_H
 
 #include "base58.h"
+#include "cachefile.h"
 #include "init.h"
 #include "key.h"
 #include "main.h"
@@ -148,23 +149,9 @@ public:
 
 /** Save Budget Manager (budget.dat)
  */
-class CBudgetDB
+class CBudgetDB : public CCacheFile
 {
-private:
-    boost::filesystem::path pathDB;
-    std::string strMagicMessage;
-
 public:
-    enum ReadResult {
-        Ok,
-        FileError,
-        HashReadError,
-        IncorrectHash,
-        IncorrectMagicMessage,
-        IncorrectMagicNumber,
-        IncorrectFormat
-    };
-
     CBudgetDB();
     bool Write(const CBudgetManager& objToSave);
     ReadResult Read(CBudgetManager& objToLoad, bool fDryRun = false);
@@ -181,6 +168,13 @@ private:
     // XX42    std::map<uint256, CTransaction> mapCollateral;
     std::map<uint256, uint256> mapCollateralTxids;
 
+    // finalized budgets by the block heights they pay, to avoid scanning all of them per block
+    std::map<int, std::set<uint256> > mapFinalizedBudgetsByHeight;
+
+    void AddFinalizedBudgetToIndex(CFinalizedBudget& finalizedBudget);
+    void RebuildFinalizedBudgetIndex();
+    std::vector<CFinalizedBudget*> GetFinalizedBudgetsByHeight(int nBlockHeight);
+
 public:
     // critical section to protect the inner data structures
     mutable CCriticalSection cs;
@@ -255,10 +249,16 @@ public:
         mapSeenFinalizedBudgetVotes.clear();
         mapOrphanMasternodeBudgetVotes.clear();
         mapOrphanFinalizedBudgetVotes.clear();
+        mapFinalizedBudgetsByHeight.clear();
     }
     void CheckAndRemove();
     std::string ToString() const;
 
+    /// Save the proposals, budgets and votes as budget.dat chunks
+    void WriteCacheChunks(CCacheFile& file) const;
+    /// Load the chunks read from budget.dat, returns false if some were lost
+    bool ReadCacheChunks(const CCacheFile& file);
+
 
     ADD_SERIALIZE_METHODS;
 
@@ -274,6 +274,8 @@ public:
 
         READWRITE(mapProposals);
         READWRITE(mapFinalizedBudgets);
+        if (ser_action.ForRead())
+            RebuildFinalizedBudgetIndex();
     }
 };
 
@@ -315,6 +317,9 @@ private:
     mutable CCriticalSection cs;
     bool fAutoChecked; //If it matches what we see, we'll auto vote for it (masternode only)
 
+protected:
+    int nVotesCheckedListVersion; //masternode list version the votes were last validated against
+
 public:
     bool fValid;
     std::string strBudgetName;
@@ -419,6 +424,7 @@ public:
         swap(first.strBudgetName, second.strBudgetName);
         swap(first.nBlockStart, second.nBlockStart);
         first.mapVotes.swap(second.mapVotes);
+        swap(first.nVotesCheckedListVersion, second.nVotesCheckedListVersion);
         first.vecBudgetPayments.swap(second.vecBudgetPayments);
         swap(first.nFeeTXHash, second.nFeeTXHash);
         swap(first.nTime, second.nTime);
@@ -458,6 +464,16 @@ private:
     mutable CCriticalSection cs;
     CAmount nAlloted;
 
+protected:
+    // running tallies of the valid votes in mapVotes
+    int nYeas;
+    int nNays;
+    int nAbstains;
+    int nVotesCheckedListVersion; //masternode list version the votes were last validated against
+
+    void AddVoteToTally(const CBudgetVote& vote, int nSign);
+    void RecountVotes();
+
 public:
     bool fValid;
     std::string strProposalName;
@@ -543,6 +559,8 @@ public:
 
         //for saving to the serialized db
         READWRITE(mapVotes);
+        if (ser_action.ForRead())
+            RecountVotes();
     }
 };
 
@@ -571,6 +589,10 @@ public:
         swap(first.nTime, second.nTime);
         swap(first.nFeeTXHash, second.nFeeTXHash);
         first.mapVotes.swap(second.mapVotes);
+        swap(first.nYeas, second.nYeas);
+        swap(first.nNays, second.nNays);
+        swap(first.nAbstains, second.nAbstains);
+        swap(first.nVotesCheckedListVersion, second.nVotesCheckedListVersion);
     }
 
     CBudgetProposalBroadcast& operator=(CBudgetProposalBroadcast from)
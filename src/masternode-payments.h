@@ -6,6 +6,7 @@
 #ifndef MASTERNODE_PAYMENTS_H
 #define MASTERNODE_PAYMENTS_H
 
+#include "cachefile.h"
 #include "key.h"
 #include "main.h"
 #include "masternode.h"
@@ -34,23 +35,9 @@ void DumpMasternodePayments();
 
 /** Save Masternode Payment Data (mnpayments.dat)
  */
-class CMasternodePaymentDB
+class CMasternodePaymentDB : public CCacheFile
 {
-private:
-    boost::filesystem::path pathDB;
-    std::string strMagicMessage;
-
 public:
-    enum ReadResult {
-        Ok,
-        FileError,
-        HashReadError,
-        IncorrectHash,
-        IncorrectMagicMessage,
-        IncorrectMagicNumber,
-        IncorrectFormat
-    };
-
     CMasternodePaymentDB();
     bool Write(const CMasternodePayments& objToSave);
     ReadResult Read(CMasternodePayments& objToLoad, bool fDryRun = false);
@@ -284,6 +271,11 @@ public:
     int GetOldestBlock();
     int GetNewestBlock();
 
+    /// Save the payment votes as mnpayments.dat chunks
+    void WriteCacheChunks(CCacheFile& file) const;
+    /// Load the chunks read from mnpayments.dat, returns false if some were lost
+    bool ReadCacheChunks(const CCacheFile& file);
+
     ADD_SERIALIZE_METHODS;
 
     template <typename Stream, typename Operation>
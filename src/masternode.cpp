@@ -491,6 +491,16 @@ bool CMasternodeBroadcast::CheckSignature() const
     return true;
 }
 
+CMessageSigCheck CMasternodeBroadcast::GetSignatureCheck(const CPubKey& pubKey) const
+{
+    const std::string strMessage = (
+                            nMessVersion == MessageVersion::MESS_VER_HASH ?
+                            GetSignatureHash().GetHex() :
+                            GetStrMessage()
+                            );
+    return CMessageSigCheck(CMessageSigner::GetMessageHash(strMessage), pubKey.GetID(), vchSig);
+}
+
 bool CMasternodeBroadcast::CheckDefaultPort(std::string strService, std::string& strErrorRet, std::string strContext)
 {
     CService service = CService(strService);
@@ -319,6 +319,7 @@ public:
     bool Sign(const CKey& key, const CPubKey& pubKey, const bool fNewSigs);
     bool Sign(const std::string strSignKey, const bool fNewSigs);
     bool CheckSignature() const;
+    CMessageSigCheck GetSignatureCheck(const CPubKey& pubKey) const override;
 
     ADD_SERIALIZE_METHODS;
 
@@ -46,38 +46,17 @@ struct CompareScoreMN {
 // CMasternodeDB
 //
 
-CMasternodeDB::CMasternodeDB()
+CMasternodeDB::CMasternodeDB() : CCacheFile(GetDataDir() / "mncache.dat", "MasternodeCache")
 {
-    pathMN = GetDataDir() / "mncache.dat";
-    strMagicMessage = "MasternodeCache";
 }
 
 bool CMasternodeDB::Write(const CMasternodeMan& mnodemanToSave)
 {
     int64_t nStart = GetTimeMillis();
 
-    // serialize, checksum data up to that point, then append checksum
-    CDataStream ssMasternodes(SER_DISK, CLIENT_VERSION);
-    ssMasternodes << strMagicMessage;                   // masternode cache file specific magic message
-    ssMasternodes << FLATDATA(Params().MessageStart()); // network specific magic number
-    ssMasternodes << mnodemanToSave;
-    uint256 hash = Hash(ssMasternodes.begin(), ssMasternodes.end());
-    ssMasternodes << hash;
-
-    // open output file, and associate with CAutoFile
-    FILE* file = fopen(pathMN.string().c_str(), "wb");
-    CAutoFile fileout(file, SER_DISK, CLIENT_VERSION);
-    if (fileout.IsNull())
-        return error("%s : Failed to open file %s", __func__, pathMN.string());
-
-    // Write and commit header, data
-    try {
-        fileout << ssMasternodes;
-    } catch (const std::exception& e) {
-        return error("%s : Serialize or I/O error - %s", __func__, e.what());
-    }
-    //    FileCommit(fileout);
-    fileout.fclose();
+    mnodemanToSave.WriteCacheChunks(*this);
+    if (!CCacheFile::Write())
+        return false;
 
     LogPrint("masternode","Written info to mncache.dat  %dms\n", GetTimeMillis() - nStart);
     LogPrint("masternode","  %s\n", mnodemanToSave.ToString());
@@ -88,80 +67,21 @@ bool CMasternodeDB::Write(const CMasternodeMan& mnodemanToSave)
 CMasternodeDB::ReadResult CMasternodeDB::Read(CMasternodeMan& mnodemanToLoad, bool fDryRun)
 {
     int64_t nStart = GetTimeMillis();
-    // open input file, and associate with CAutoFile
-    FILE* file = fopen(pathMN.string().c_str(), "rb");
-    CAutoFile filein(file, SER_DISK, CLIENT_VERSION);
-    if (filein.IsNull()) {
-        error("%s : Failed to open file %s", __func__, pathMN.string());
-        return FileError;
-    }
-
-    // use file size to size memory buffer
-    int fileSize = boost::filesystem::file_size(pathMN);
-    int dataSize = fileSize - sizeof(uint256);
-    // Don't try to resize to a negative number if file is small
-    if (dataSize < 0)
-        dataSize = 0;
-    std::vector<unsigned char> vchData;
-    vchData.resize(dataSize);
-    uint256 hashIn;
-
-    // read data and checksum from file
-    try {
-        filein.read((char*)&vchData[0], dataSize);
-        filein >> hashIn;
-    } catch (const std::exception& e) {
-        error("%s : Deserialize or I/O error - %s", __func__, e.what());
-        return HashReadError;
-    }
-    filein.fclose();
-
-    CDataStream ssMasternodes(vchData, SER_DISK, CLIENT_VERSION);
-
-    // verify stored checksum matches input data
-    uint256 hashTmp = Hash(ssMasternodes.begin(), ssMasternodes.end());
-    if (hashIn != hashTmp) {
-        error("%s : Checksum mismatch, data corrupted", __func__);
-        return IncorrectHash;
-    }
 
-    unsigned char pchMsgTmp[4];
-    std::string strMagicMessageTmp;
-    try {
-        // de-serialize file header (masternode cache file specific magic message) and ..
+    ReadResult result = CCacheFile::Read(fDryRun);
+    if (result != Ok || fDryRun)
+        return result;
 
-        ssMasternodes >> strMagicMessageTmp;
-
-        // ... verify the message matches predefined one
-        if (strMagicMessage != strMagicMessageTmp) {
-            error("%s : Invalid masternode cache magic message", __func__);
-            return IncorrectMagicMessage;
-        }
-
-        // de-serialize file header (network specific magic number) and ..
-        ssMasternodes >> FLATDATA(pchMsgTmp);
-
-        // ... verify the network matches ours
-        if (memcmp(pchMsgTmp, Params().MessageStart(), sizeof(pchMsgTmp))) {
-            error("%s : Invalid network magic number", __func__);
-            return IncorrectMagicNumber;
-        }
-        // de-serialize data into CMasternodeMan object
-        ssMasternodes >> mnodemanToLoad;
-    } catch (const std::exception& e) {
-        mnodemanToLoad.Clear();
-        error("%s : Deserialize or I/O error - %s", __func__, e.what());
-        return IncorrectFormat;
-    }
+    // chunks that failed their integrity check are simply re-synced from the network
+    if (!mnodemanToLoad.ReadCacheChunks(*this))
+        LogPrintf("%s : some chunks of mncache.dat were lost, continuing with the others\n", __func__);
 
     LogPrint("masternode","Loaded info from mncache.dat  %dms\n", GetTimeMillis() - nStart);
     LogPrint("masternode","  %s\n", mnodemanToLoad.ToString());
-    if (!fDryRun) {
-        LogPrint("masternode","Masternode manager - cleaning....\n");
-        mnodemanToLoad.CheckAndRemove(true);
-        LogPrint("masternode","Masternode manager - result:\n");
-        LogPrint("masternode","  %s\n", mnodemanToLoad.ToString());
-    }
+    LogPrint("masternode","Masternode manager - cleaning....\n");
+    mnodemanToLoad.CheckAndRemove(true);
+    LogPrint("masternode","Masternode manager - result:\n");
+    LogPrint("masternode","  %s\n", mnodemanToLoad.ToString());
 
     return Ok;
 }
@@ -193,11 +113,39 @@ void DumpMasternodes()
     LogPrint("masternode","Masternode dump finished  %dms\n", GetTimeMillis() - nStart);
 }
 
-CMasternodeMan::CMasternodeMan()
+CMasternodeMan::CMasternodeMan() : nListVersion(0)
 {
     nDsqCount = 0;
 }
 
+void CMasternodeMan::WriteCacheChunks(CCacheFile& file) const
+{
+    LOCK(cs);
+    // a ping only dirties the chunk of its masternode
+    file.AddVectorChunks("masternodes", vMasternodes, [](const CMasternode& mn) { return mn.vin.prevout.hash; });
+    file.AddChunk("askedus", mAskedUsForMasternodeList);
+    file.AddChunk("weasked", mWeAskedForMasternodeList);
+    file.AddChunk("weaskedentry", mWeAskedForMasternodeListEntry);
+    file.AddChunk("dsqcount", nDsqCount);
+    file.AddMapChunks("seenmnb", mapSeenMasternodeBroadcast);
+    file.AddMapChunks("seenmnp", mapSeenMasternodePing);
+}
+
+bool CMasternodeMan::ReadCacheChunks(const CCacheFile& file)
+{
+    LOCK(cs);
+    vMasternodes.clear();
+    bool fComplete = file.GetVectorChunks("masternodes", vMasternodes);
+    fComplete = file.GetChunk("askedus", mAskedUsForMasternodeList) && fComplete;
+    fComplete = file.GetChunk("weasked", mWeAskedForMasternodeList) && fComplete;
+    fComplete = file.GetChunk("weaskedentry", mWeAskedForMasternodeListEntry) && fComplete;
+    fComplete = file.GetChunk("dsqcount", nDsqCount) && fComplete;
+    fComplete = file.GetMapChunks("seenmnb", mapSeenMasternodeBroadcast) && fComplete;
+    fComplete = file.GetMapChunks("seenmnp", mapSeenMasternodePing) && fComplete;
+    ++nListVersion;
+    return fComplete;
+}
+
 bool CMasternodeMan::Add(CMasternode& mn)
 {
     LOCK(cs);
@@ -209,6 +157,7 @@ bool CMasternodeMan::Add(CMasternode& mn)
     if (pmn == NULL) {
         LogPrint("masternode", "CMasternodeMan: Adding new Masternode %s - %i now\n", mn.vin.prevout.hash.ToString(), size() + 1);
         vMasternodes.push_back(mn);
+        ++nListVersion;
         return true;
     }
 
@@ -279,6 +228,7 @@ void CMasternodeMan::CheckAndRemove(bool forceExpiredRemoval)
             }
 
             it = vMasternodes.erase(it);
+            ++nListVersion;
         } else {
             ++it;
         }
@@ -340,6 +290,7 @@ void CMasternodeMan::Clear()
 {
     LOCK(cs);
     vMasternodes.clear();
+    ++nListVersion;
     mAskedUsForMasternodeList.clear();
     mWeAskedForMasternodeList.clear();
     mWeAskedForMasternodeListEntry.clear();
@@ -448,6 +399,17 @@ CMasternode* CMasternodeMan::Find(const CScript& payee)
     return NULL;
 }
 
+void CMasternodeMan::GetMasternodePubKeys(std::map<COutPoint, CPubKey>& mapPubKeys)
+{
+    LOCK(cs);
+
+    for (const CMasternode& mn : vMasternodes) {
+        std::map<COutPoint, CPubKey>::iterator it = mapPubKeys.find(mn.vin.prevout);
+        if (it != mapPubKeys.end())
+            it->second = mn.pubKeyMasternode;
+    }
+}
+
 CMasternode* CMasternodeMan::Find(const CTxIn& vin)
 {
     LOCK(cs);
@@ -730,8 +692,8 @@ void CMasternodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
     LOCK(cs_process_message);
 
     if (strCommand == "mnb") { //Masternode Broadcast
-        CMasternodeBroadcast mnb;
-        vRecv >> mnb;
+        std::shared_ptr<CMasternodeBroadcast> pmnb = pfrom->ReadSignedMessage<CMasternodeBroadcast>(vRecv);
+        CMasternodeBroadcast& mnb = *pmnb;
 
         if (mapSeenMasternodeBroadcast.count(mnb.GetHash())) { //seen
             masternodeSync.AddedMasternodeList(mnb.GetHash());
@@ -771,8 +733,8 @@ void CMasternodeMan::ProcessMessage(CNode* pfrom, std::string& strCommand, CData
     }
 
     else if (strCommand == "mnp") { //Masternode Ping
-        CMasternodePing mnp;
-        vRecv >> mnp;
+        std::shared_ptr<CMasternodePing> pmnp = pfrom->ReadSignedMessage<CMasternodePing>(vRecv);
+        CMasternodePing& mnp = *pmnp;
 
         LogPrint("masternode", "mnp - Masternode ping, vin: %s\n", mnp.vin.prevout.hash.ToString());
 
@@ -1140,6 +1102,7 @@ void CMasternodeMan::Remove(CTxIn vin)
         if ((*it).vin == vin) {
             LogPrint("masternode", "CMasternodeMan: Removing Masternode %s - %i now\n", (*it).vin.prevout.hash.ToString(), size() - 1);
             vMasternodes.erase(it);
+            ++nListVersion;
             break;
         }
         ++it;
@@ -7,6 +7,7 @@
 #define MASTERNODEMAN_H
 
 #include "base58.h"
+#include "cachefile.h"
 #include "key.h"
 #include "main.h"
 #include "masternode.h"
@@ -14,6 +15,8 @@
 #include "sync.h"
 #include "util.h"
 
+#include <atomic>
+
 #define MASTERNODES_DUMP_SECONDS (15 * 60)
 #define MASTERNODES_DSEG_SECONDS (3 * 60 * 60)
 
@@ -25,23 +28,9 @@ void DumpMasternodes();
 
 /** Access to the MN database (mncache.dat)
  */
-class CMasternodeDB
+class CMasternodeDB : public CCacheFile
 {
-private:
-    boost::filesystem::path pathMN;
-    std::string strMagicMessage;
-
 public:
-    enum ReadResult {
-        Ok,
-        FileError,
-        HashReadError,
-        IncorrectHash,
-        IncorrectMagicMessage,
-        IncorrectMagicNumber,
-        IncorrectFormat
-    };
-
     CMasternodeDB();
     bool Write(const CMasternodeMan& mnodemanToSave);
     ReadResult Read(CMasternodeMan& mnodemanToLoad, bool fDryRun = false);
@@ -64,6 +53,8 @@ private:
     std::map<CNetAddr, int64_t> mWeAskedForMasternodeList;
     // which Masternodes we've asked for
     std::map<COutPoint, int64_t> mWeAskedForMasternodeListEntry;
+    // bumped whenever an entry is added to or removed from vMasternodes
+    std::atomic<int> nListVersion;
 
 public:
     // Keep track of all broadcasts I've seen
@@ -88,6 +79,8 @@ public:
 
         READWRITE(mapSeenMasternodeBroadcast);
         READWRITE(mapSeenMasternodePing);
+        if (ser_action.ForRead())
+            ++nListVersion;
     }
 
     CMasternodeMan();
@@ -117,6 +110,8 @@ public:
     /// Find an entry
     CMasternode* Find(const CScript& payee);
     CMasternode* Find(const CTxIn& vin);
+    /// Set the masternode key of each collateral in mapPubKeys found in the list, in a single pass
+    void GetMasternodePubKeys(std::map<COutPoint, CPubKey>& mapPubKeys);
     CMasternode* Find(const CPubKey& pubKeyMasternode);
 
     /// Find an entry in the masternode list that is next to be paid
@@ -145,11 +140,19 @@ public:
     /// Return the number of (unique) Masternodes
     int size() { return vMasternodes.size(); }
 
+    /// Version of the set of known Masternodes, changes whenever one is added or removed
+    int GetListVersion() const { return nListVersion; }
+
     /// Return the number of Masternodes older than (default) 8000 seconds
     int stable_size ();
 
     std::string ToString() const;
 
+    /// Save the manager state as mncache.dat chunks
+    void WriteCacheChunks(CCacheFile& file) const;
+    /// Load the chunks read from mncache.dat, returns false if some were lost
+    bool ReadCacheChunks(const CCacheFile& file);
+
     void Remove(CTxIn vin);
 
     int GetEstimatedMasternodes(int nBlock);
@@ -4,13 +4,99 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include "base58.h"
+#include "checkqueue.h"
 #include "hash.h"
 #include "main.h" // For strMessageMagic
 #include "messagesigner.h"
 #include "masternodeman.h"  // For GetPublicKey (of MN from its vin)
+#include "random.h"
 #include "tinyformat.h"
 #include "utilstrencodings.h"
 
+#include <atomic>
+
+#include <boost/thread.hpp>
+
+namespace {
+
+/**
+ * Valid message signature cache. Masternode, budget and payment messages are
+ * received many times from different peers and re-checked during cleanups, so
+ * this avoids recovering the public key of the same signature over and over.
+ */
+class CMessageSignatureCache
+{
+private:
+    //! entries are the hash of (signed hash, key id, signature)
+    std::set<uint256> setValid;
+    boost::shared_mutex cs_sigcache;
+
+public:
+    static uint256 GetEntry(const uint256& hash, const CKeyID& keyID, const std::vector<unsigned char>& vchSig)
+    {
+        CHashWriter ss(SER_GETHASH, 0);
+        ss << hash << keyID << vchSig;
+        return ss.GetHash();
+    }
+
+    bool Get(const uint256& entry)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_sigcache);
+        return setValid.count(entry) > 0;
+    }
+
+    void Set(const uint256& entry)
+    {
+        // same bound as the script signature cache
+        int64_t nMaxCacheSize = GetArg("-maxsigcachesize", 50000);
+        if (nMaxCacheSize <= 0) return;
+
+        boost::unique_lock<boost::shared_mutex> lock(cs_sigcache);
+
+        while (static_cast<int64_t>(setValid.size()) > nMaxCacheSize) {
+            // Evict a random entry, see CSignatureCache
+            std::set<uint256>::iterator it = setValid.lower_bound(GetRandHash());
+            if (it == setValid.end())
+                it = setValid.begin();
+            setValid.erase(it);
+        }
+
+        setValid.insert(entry);
+    }
+};
+
+CMessageSignatureCache messageSignatureCache;
+
+CCheckQueue<CMessageSigCheck> messagesigcheckqueue(128);
+std::atomic<int> nMessageSigCheckThreads(0);
+
+}
+
+bool CMessageSigCheck::operator()()
+{
+    // the outcome is only recorded in the signature cache, a bad signature is
+    // reported when its message gets processed
+    std::string strError;
+    CHashSigner::VerifyHash(hash, keyID, vchSig, strError);
+    return true;
+}
+
+void ThreadMessageSigCheck()
+{
+    RenameThread("pivx-msgsigch");
+    nMessageSigCheckThreads++;
+    messagesigcheckqueue.Thread();
+}
+
+bool QueueMessageSigChecks(std::vector<CMessageSigCheck>& vChecks)
+{
+    // nobody waits on this queue, so it can only be used with workers
+    if (nMessageSigCheckThreads == 0)
+        return false;
+    messagesigcheckqueue.Add(vChecks);
+    return true;
+}
+
 bool CMessageSigner::GetKeysFromSecret(const std::string& strSecret, CKey& keyRet, CPubKey& pubkeyRet)
 {
     CBitcoinSecret vchSecret;
@@ -58,6 +144,10 @@ bool CHashSigner::VerifyHash(const uint256& hash, const CPubKey& pubkey, const s
 
 bool CHashSigner::VerifyHash(const uint256& hash, const CKeyID& keyID, const std::vector<unsigned char>& vchSig, std::string& strErrorRet)
 {
+    const uint256 entry = CMessageSignatureCache::GetEntry(hash, keyID, vchSig);
+    if (messageSignatureCache.Get(entry))
+        return true;
+
     CPubKey pubkeyFromSig;
     if(!pubkeyFromSig.RecoverCompact(hash, vchSig)) {
         strErrorRet = "Error recovering public key.";
@@ -71,9 +161,15 @@ bool CHashSigner::VerifyHash(const uint256& hash, const CKeyID& keyID, const std
         return false;
     }
 
+    messageSignatureCache.Set(entry);
     return true;
 }
 
+bool CHashSigner::IsVerifiedHash(const uint256& hash, const CKeyID& keyID, const std::vector<unsigned char>& vchSig)
+{
+    return messageSignatureCache.Get(CMessageSignatureCache::GetEntry(hash, keyID, vchSig));
+}
+
 /** CSignedMessage Class
  *  Functions inherited by network signed-messages
  */
@@ -151,6 +247,14 @@ bool CSignedMessage::CheckSignature(const bool fSignatureCheck) const
     return !fSignatureCheck || CheckSignature(pubkey);
 }
 
+CMessageSigCheck CSignedMessage::GetSignatureCheck(const CPubKey& pubKey) const
+{
+    const uint256 hash = (nMessVersion == MessageVersion::MESS_VER_HASH ?
+                          GetSignatureHash() :
+                          CMessageSigner::GetMessageHash(GetStrMessage()));
+    return CMessageSigCheck(hash, pubKey.GetID(), vchSig);
+}
+
 const CPubKey CSignedMessage::GetPublicKey(std::string& strErrorRet) const
 {
     const CTxIn vin = GetVin();
@@ -31,6 +31,40 @@ public:
     static bool VerifyMessage(const CKeyID& keyID, const std::vector<unsigned char>& vchSig, const std::string& strMessage, std::string& strErrorRet);
 };
 
+/** A signature check of a hash, to be run on the message signature check queue.
+ * Valid signatures end up in the message signature cache, so that checking
+ * them again when the message is processed is a cache hit.
+ */
+class CMessageSigCheck
+{
+private:
+    uint256 hash;
+    CKeyID keyID;
+    std::vector<unsigned char> vchSig;
+
+public:
+    CMessageSigCheck() {}
+    CMessageSigCheck(const uint256& hashIn, const CKeyID& keyIDIn, const std::vector<unsigned char>& vchSigIn) : hash(hashIn), keyID(keyIDIn), vchSig(vchSigIn) {}
+
+    bool operator()();
+
+    const uint256& GetHash() const { return hash; }
+    const CKeyID& GetKeyID() const { return keyID; }
+    const std::vector<unsigned char>& GetSig() const { return vchSig; }
+
+    void swap(CMessageSigCheck& check)
+    {
+        std::swap(hash, check.hash);
+        std::swap(keyID, check.keyID);
+        vchSig.swap(check.vchSig);
+    }
+};
+
+/** Run a worker of the message signature check queue */
+void ThreadMessageSigCheck();
+/** Verify the signatures in the background on the message signature check queue. Returns false if there are no workers */
+bool QueueMessageSigChecks(std::vector<CMessageSigCheck>& vChecks);
+
 /** Helper class for signing hashes and checking their signatures
  */
 class CHashSigner
@@ -42,6 +76,8 @@ public:
     static bool VerifyHash(const uint256& hash, const CPubKey& pubkey, const std::vector<unsigned char>& vchSig, std::string& strErrorRet);
     /// Verify the hash signature, returns true if successful
     static bool VerifyHash(const uint256& hash, const CKeyID& keyID, const std::vector<unsigned char>& vchSig, std::string& strErrorRet);
+    /// Whether the hash signature is in the cache of valid signatures, without verifying it
+    static bool IsVerifiedHash(const uint256& hash, const CKeyID& keyID, const std::vector<unsigned char>& vchSig);
 };
 
 /** Base Class for all signed messages on the network
@@ -71,6 +107,8 @@ public:
     bool Sign(const std::string strSignKey, const bool fNewSigs);
     bool CheckSignature(const CPubKey& pubKey) const;
     bool CheckSignature(const bool fSignatureCheck = true) const;
+    // Build the check of the signature against pubKey, for the message signature check queue
+    virtual CMessageSigCheck GetSignatureCheck(const CPubKey& pubKey) const;
 
     // Pure virtual functions (used in Sign-Verify functions)
     // Must be implemented in child classes
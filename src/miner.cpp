@@ -650,6 +650,8 @@ bool ProcessBlockFound(CBlock* pblock, CWallet& wallet, CReserveKey& reservekey)
         }
         return error("PIVXMiner : ProcessNewBlock, block not accepted");
     }
+    // Let the wallet catch up with the new block before staking again
+    SyncWithValidationInterfaceQueue();
 
     for (CNode* node : vNodes) {
         node->PushInventory(CInv(MSG_BLOCK, pblock->GetHash()));
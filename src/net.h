@@ -21,6 +21,7 @@
 #include "utilstrencodings.h"
 
 #include <deque>
+#include <memory>
 #include <stdint.h>
 
 #ifndef WIN32
@@ -34,6 +35,7 @@ class CAddrMan;
 class CBlockIndex;
 class CScheduler;
 class CNode;
+class CSignedMessage;
 
 namespace boost
 {
@@ -196,6 +198,9 @@ public:
 
     int64_t nTime; // time (in microseconds) of message receipt.
 
+    bool fSigChecksQueued; // signatures handed to the message signature check queue
+    std::shared_ptr<CSignedMessage> pDecoded; // the message, if it was decoded to queue its signature
+
     CNetMessage(int nTypeIn, int nVersionIn) : hdrbuf(nTypeIn, nVersionIn), vRecv(nTypeIn, nVersionIn)
     {
         hdrbuf.resize(24);
@@ -203,6 +208,7 @@ public:
         nHdrPos = 0;
         nDataPos = 0;
         nTime = 0;
+        fSigChecksQueued = false;
     }
 
     bool complete() const
@@ -216,6 +222,8 @@ public:
     {
         hdrbuf.SetVersion(nVersionIn);
         vRecv.SetVersion(nVersionIn);
+        // decoded with the previous version
+        pDecoded.reset();
     }
 
     int readHeader(const char* pch, unsigned int nBytes);
@@ -302,6 +310,8 @@ public:
     std::deque<CInv> vRecvGetData;
     std::deque<CNetMessage> vRecvMsg;
     CCriticalSection cs_vRecvMsg;
+    // the decoded message being processed, see ReadSignedMessage
+    std::shared_ptr<CSignedMessage> pRecvDecoded;
     uint64_t nRecvBytes;
     int nRecvVersion;
 
@@ -431,6 +441,22 @@ public:
             msg.SetVersion(nVersionIn);
     }
 
+    /**
+     * Decode the message being processed from vRecv, unless it was decoded already to
+     * queue its signature check (see PreVerifyMessageSignatures).
+     */
+    template <typename T>
+    std::shared_ptr<T> ReadSignedMessage(CDataStream& vRecv)
+    {
+        std::shared_ptr<T> pmessage = std::dynamic_pointer_cast<T>(pRecvDecoded);
+        pRecvDecoded.reset();
+        if (!pmessage) {
+            pmessage = std::make_shared<T>();
+            vRecv >> *pmessage;
+        }
+        return pmessage;
+    }
+
     CNode* AddRef()
     {
         nRefCount++;
@@ -9,6 +9,8 @@
 #include "primitives/transaction.h"
 #include "main.h"
 #include "httpserver.h"
+#include "rpc/jsonstream.h"
+#include "rpc/responsecache.h"
 #include "rpc/server.h"
 #include "streams.h"
 #include "sync.h"
@@ -23,6 +25,11 @@
 
 
 static const size_t MAX_GETUTXOS_OUTPOINTS = 15; //allow a max of 15 outpoints to be queried at once
+static const int MAX_REST_HEADERS_RESULTS = 2000;
+//! Maximum number of blocks returned by one /rest/blockrange/ request
+static const int MAX_REST_BLOCK_RANGE = 1000;
+//! Maximum number of scripts in a /rest/blockrange/ filter
+static const size_t MAX_REST_FILTER_SCRIPTS = 16;
 
 enum RetFormat {
     RF_UNDEF,
@@ -59,10 +66,13 @@ struct CCoin {
 
 extern void TxToJSON(const CTransaction& tx, const uint256 hashBlock, UniValue& entry);
 extern UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, bool txDetails = false);
+extern UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, const CChainTipSnapshot& chain, bool txDetails);
 extern UniValue mempoolInfoToJSON();
 extern UniValue mempoolToJSON(bool fVerbose = false);
 extern void ScriptPubKeyToJSON(const CScript& scriptPubKey, UniValue& out, bool fIncludeHex);
 extern UniValue blockheaderToJSON(const CBlockIndex* blockindex);
+extern void blockToJSONStream(CJSONStreamWriter& writer, const CBlock& block, const CBlockIndex* blockindex, bool txDetails);
+extern void mempoolToJSONStream(CJSONStreamWriter& writer);
 
 static bool RESTERR(HTTPRequest* req, enum HTTPStatusCode status, std::string message)
 {
@@ -71,6 +81,18 @@ static bool RESTERR(HTTPRequest* req, enum HTTPStatusCode status, std::string me
     return false;
 }
 
+/** Send a JSON document produced by fnWrite while it is written */
+static void RESTStreamJSON(HTTPRequest* req, const std::function<void(CJSONStreamWriter&)>& fnWrite)
+{
+    req->WriteHeader("Content-Type", "application/json");
+    HTTPReplyStream reply(req, HTTP_OK);
+    CJSONStreamWriter writer([&reply](const std::string& strChunk) { return reply.Write(strChunk); }, HTTP_REPLY_CHUNK_SIZE);
+    fnWrite(writer);
+    writer.Flush();
+    reply.Write("\n");
+    reply.Finish();
+}
+
 static enum RetFormat ParseDataFormat(std::vector<std::string>& params, const std::string& strReq)
 {
     boost::split(params, strReq, boost::is_any_of("."));
@@ -116,42 +138,9 @@ static bool CheckWarmup(HTTPRequest* req)
     return true;
 }
 
-static bool rest_headers(HTTPRequest* req,
-                         const std::string& strURIPart)
+/** Reply with the headers of a range of blocks */
+static bool RESTWriteHeaders(HTTPRequest* req, const RetFormat rf, const std::vector<const CBlockIndex*>& headers)
 {
-    if (!CheckWarmup(req))
-        return false;
-    std::vector<std::string> params;
-    const RetFormat rf = ParseDataFormat(params, strURIPart);
-    std::vector<std::string> path;
-    boost::split(path, params[0], boost::is_any_of("/"));
-
-    if (path.size() != 2)
-        return RESTERR(req, HTTP_BAD_REQUEST, "No header count specified. Use /rest/headers/<count>/<hash>.<ext>.");
-
-    long count = strtol(path[0].c_str(), NULL, 10);
-    if (count < 1 || count > 2000)
-        return RESTERR(req, HTTP_BAD_REQUEST, "Header count out of range: " + path[0]);
-
-    std::string hashStr = path[1];
-    uint256 hash;
-    if (!ParseHashStr(hashStr, hash))
-        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
-
-    std::vector<const CBlockIndex *> headers;
-    headers.reserve(count);
-    {
-        LOCK(cs_main);
-        BlockMap::const_iterator it = mapBlockIndex.find(hash);
-        const CBlockIndex *pindex = (it != mapBlockIndex.end()) ? it->second : NULL;
-        while (pindex != NULL && chainActive.Contains(pindex)) {
-            headers.push_back(pindex);
-            if (headers.size() == (unsigned long)count)
-                break;
-            pindex = chainActive.Next(pindex);
-        }
-    }
-
     CDataStream ssHeader(SER_NETWORK, PROTOCOL_VERSION);
     for (const CBlockIndex *pindex : headers) {
         ssHeader << pindex->GetBlockHeader();
@@ -190,6 +179,87 @@ static bool rest_headers(HTTPRequest* req,
     return true; // continue to process further HTTP reqs on this cxn
 }
 
+static bool rest_headers(HTTPRequest* req,
+                         const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::vector<std::string> params;
+    const RetFormat rf = ParseDataFormat(params, strURIPart);
+    std::vector<std::string> path;
+    boost::split(path, params[0], boost::is_any_of("/"));
+
+    if (path.size() != 2)
+        return RESTERR(req, HTTP_BAD_REQUEST, "No header count specified. Use /rest/headers/<count>/<hash>.<ext>.");
+
+    long count = strtol(path[0].c_str(), NULL, 10);
+    if (count < 1 || count > MAX_REST_HEADERS_RESULTS)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Header count out of range: " + path[0]);
+
+    std::string hashStr = path[1];
+    uint256 hash;
+    if (!ParseHashStr(hashStr, hash))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
+
+    std::vector<const CBlockIndex *> headers;
+    headers.reserve(count);
+    {
+        ChainTipSnapshotRef chain = GetChainTipSnapshot();
+        const CBlockIndex *pindex = LookupBlockIndex(hash);
+        while (pindex != NULL && chain->Contains(pindex)) {
+            headers.push_back(pindex);
+            if (headers.size() == (unsigned long)count)
+                break;
+            pindex = chain->Next(pindex);
+        }
+    }
+
+    return RESTWriteHeaders(req, rf, headers);
+}
+
+/**
+ * Parse the height and count of a range request, and collect the blocks of the
+ * range that are in the active chain. The range is cut short at the tip.
+ */
+static bool ParseBlockRange(HTTPRequest* req, const std::string& strHeight, const std::string& strCount, int nMaxCount, std::vector<const CBlockIndex*>& vIndex)
+{
+    int32_t nHeight, nCount;
+    if (!ParseInt32(strHeight, &nHeight) || nHeight < 0)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid height: " + strHeight);
+    if (!ParseInt32(strCount, &nCount) || nCount < 1 || nCount > nMaxCount)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Block count out of range: " + strCount);
+
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
+    if (nHeight > chain->Height())
+        return RESTERR(req, HTTP_NOT_FOUND, "Block height out of range: " + strHeight);
+
+    // Walk back from the last block of the range instead of looking up every height
+    const CBlockIndex* pindex = (*chain)[std::min(nHeight + nCount - 1, chain->Height())];
+    vIndex.resize(pindex->nHeight - nHeight + 1);
+    for (size_t i = vIndex.size(); i > 0; pindex = pindex->pprev)
+        vIndex[--i] = pindex;
+    return true;
+}
+
+static bool rest_headerrange(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::vector<std::string> params;
+    const RetFormat rf = ParseDataFormat(params, strURIPart);
+    std::vector<std::string> path;
+    boost::split(path, params[0], boost::is_any_of("/"));
+
+    if (path.size() != 2)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Use /rest/headerrange/<height>/<count>.<ext>.");
+
+    std::vector<const CBlockIndex*> headers;
+    if (!ParseBlockRange(req, path[0], path[1], MAX_REST_HEADERS_RESULTS, headers))
+        return false;
+
+    return RESTWriteHeaders(req, rf, headers);
+}
+
 static bool rest_block(HTTPRequest* req,
                        const std::string& strURIPart,
                        bool showTxDetails)
@@ -205,43 +275,71 @@ static bool rest_block(HTTPRequest* req,
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
     CBlock block;
-    CBlockIndex* pblockindex = NULL;
-    {
-        LOCK(cs_main);
-        if (mapBlockIndex.count(hash) == 0)
-            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+    CBlockIndex* pblockindex = LookupBlockIndex(hash);
+    if (!pblockindex)
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
 
-        pblockindex = mapBlockIndex[hash];
-        if (!(pblockindex->nStatus & BLOCK_HAVE_DATA) && pblockindex->nTx > 0)
-            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not available (pruned data)");
+    if (!(pblockindex->nStatus & BLOCK_HAVE_DATA) && pblockindex->nTx > 0)
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not available (pruned data)");
 
+    // Serialized blocks and their JSON without transaction details are shared with
+    // getblock through the response cache. Fully detailed JSON is always streamed.
+    const bool fCached = (rf == RF_BINARY || rf == RF_HEX || (rf == RF_JSON && !showTxDetails));
+    const std::string strCacheKey = ResponseCacheKey(rf == RF_JSON ? "blockjson" : "blockhex", hash);
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
+    UniValue cached;
+    if (!fCached || !blockResponseCache.Get(strCacheKey, cached, *chain)) {
         if (!ReadBlockFromDisk(block, pblockindex))
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        if (fCached && blockResponseCache.IsEnabled()) {
+            if (rf == RF_JSON) {
+                cached = blockToJSON(block, pblockindex, *chain, false);
+            } else {
+                CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
+                ssBlock << block;
+                cached = HexStr(ssBlock.begin(), ssBlock.end());
+            }
+            blockResponseCache.Put(strCacheKey, pblockindex, cached, *chain);
+        }
     }
 
-    CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
-    ssBlock << block;
-
     switch (rf) {
     case RF_BINARY: {
-        std::string binaryBlock = ssBlock.str();
+        std::string binaryBlock;
+        if (cached.isStr()) {
+            std::vector<unsigned char> vBlock = ParseHex(cached.get_str());
+            binaryBlock.assign(vBlock.begin(), vBlock.end());
+        } else {
+            CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
+            ssBlock << block;
+            binaryBlock = ssBlock.str();
+        }
         req->WriteHeader("Content-Type", "application/octet-stream");
         req->WriteReply(HTTP_OK, binaryBlock);
         return true;
     }
 
     case RF_HEX: {
-        std::string strHex = HexStr(ssBlock.begin(), ssBlock.end()) + "\n";
+        std::string strHex;
+        if (cached.isStr()) {
+            strHex = cached.get_str() + "\n";
+        } else {
+            CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
+            ssBlock << block;
+            strHex = HexStr(ssBlock.begin(), ssBlock.end()) + "\n";
+        }
         req->WriteHeader("Content-Type", "text/plain");
         req->WriteReply(HTTP_OK, strHex);
         return true;
     }
 
     case RF_JSON: {
-        UniValue objBlock = blockToJSON(block, pblockindex, showTxDetails);
-        std::string strJSON = objBlock.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        RESTStreamJSON(req, [&](CJSONStreamWriter& writer) {
+            if (cached.isObject())
+                writer.Value(cached);
+            else
+                blockToJSONStream(writer, block, pblockindex, showTxDetails);
+        });
         return true;
     }
 
@@ -264,6 +362,119 @@ static bool rest_block_notxdetails(HTTPRequest* req, const std::string& strURIPa
     return rest_block(req, strURIPart, false);
 }
 
+/**
+ * Serialize the header of the block of pindex, followed by those of its transactions
+ * that contain zerocoins (fZerocoin), or else that pay to or spend from one of setScripts.
+ */
+static bool ReadFilteredBlock(std::string& strData, const CBlockIndex* pindex, bool fZerocoin, const std::set<CScript>& setScripts)
+{
+    CBlock block;
+    if (!ReadBlockFromDisk(block, pindex))
+        return false;
+
+    // The scripts of the spent outputs come from the undo data
+    CBlockUndo blockUndo;
+    if (!fZerocoin && pindex->pprev) {
+        if (!blockUndo.ReadFromDisk(pindex->GetUndoPos(), pindex->pprev->GetBlockHash()))
+            return false;
+        if (blockUndo.vtxundo.size() + 1 != block.vtx.size())
+            return error("%s : block and undo data inconsistent", __func__);
+    }
+
+    std::vector<CTransaction> vtx;
+    for (unsigned int i = 0; i < block.vtx.size(); i++) {
+        const CTransaction& tx = block.vtx[i];
+        bool fMatch = false;
+        if (fZerocoin) {
+            fMatch = tx.ContainsZerocoins();
+        } else {
+            for (const CTxOut& out : tx.vout)
+                fMatch |= setScripts.count(out.scriptPubKey) > 0;
+            if (i > 0) {
+                for (const CTxInUndo& prevout : blockUndo.vtxundo[i - 1].vprevout)
+                    fMatch |= setScripts.count(prevout.txout.scriptPubKey) > 0;
+            }
+        }
+        if (fMatch)
+            vtx.push_back(tx);
+    }
+
+    CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
+    ssBlock << block.GetBlockHeader() << vtx;
+    strData = ssBlock.str();
+    return true;
+}
+
+static bool rest_blockrange(HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::vector<std::string> params;
+    const RetFormat rf = ParseDataFormat(params, strURIPart);
+    if (rf != RF_BINARY && rf != RF_HEX)
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: .bin, .hex)");
+    std::vector<std::string> path;
+    boost::split(path, params[0], boost::is_any_of("/"));
+
+    if (path.size() != 2 && path.size() != 3)
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid URI format. Use /rest/blockrange/<height>/<count>[/<filter>].<ext>.");
+
+    std::vector<const CBlockIndex*> vIndex;
+    if (!ParseBlockRange(req, path[0], path[1], MAX_REST_BLOCK_RANGE, vIndex))
+        return false;
+
+    // The filter is either "zerocoin" or a comma separated list of hex scripts
+    const bool fFiltered = path.size() == 3;
+    const bool fZerocoin = fFiltered && path[2] == "zerocoin";
+    std::set<CScript> setScripts;
+    if (fFiltered && !fZerocoin) {
+        std::vector<std::string> vScripts;
+        boost::split(vScripts, path[2], boost::is_any_of(","));
+        if (vScripts.size() > MAX_REST_FILTER_SCRIPTS)
+            return RESTERR(req, HTTP_BAD_REQUEST, strprintf("Too many scripts in filter (max %u)", MAX_REST_FILTER_SCRIPTS));
+        for (const std::string& strScript : vScripts) {
+            if (strScript.empty() || !IsHex(strScript))
+                return RESTERR(req, HTTP_BAD_REQUEST, "Invalid filter: " + strScript);
+            std::vector<unsigned char> vchScript = ParseHex(strScript);
+            setScripts.insert(CScript(vchScript.begin(), vchScript.end()));
+        }
+    }
+
+    for (const CBlockIndex* pindex : vIndex) {
+        if (!(pindex->nStatus & BLOCK_HAVE_DATA) && pindex->nTx > 0)
+            return RESTERR(req, HTTP_NOT_FOUND, pindex->GetBlockHash().GetHex() + " not available (pruned data)");
+    }
+
+    // Blocks are sent as soon as they are read; unfiltered ones are copied from
+    // disk without being deserialized. If the first block can't be read the
+    // request fails with 404. A later block that can't be read aborts the reply,
+    // closing the connection before its end, so it is never taken for a complete one.
+    HTTPReplyStream reply(req, HTTP_OK);
+    bool fStarted = false;
+    for (const CBlockIndex* pindex : vIndex) {
+        std::string strData;
+        if (!(fFiltered ? ReadFilteredBlock(strData, pindex, fZerocoin, setScripts) : ReadRawBlockFromDisk(strData, pindex))) {
+            if (!fStarted)
+                return RESTERR(req, HTTP_NOT_FOUND, pindex->GetBlockHash().GetHex() + " not found");
+            LogPrintf("%s : can't read block %s, aborting the reply\n", __func__, pindex->GetBlockHash().GetHex());
+            reply.Abort();
+            return false;
+        }
+        if (!fStarted) {
+            req->WriteHeader("Content-Type", rf == RF_BINARY ? "application/octet-stream" : "text/plain");
+            fStarted = true;
+        }
+        if (rf == RF_HEX)
+            strData = HexStr(strData.begin(), strData.end());
+        if (!reply.Write(strData))
+            break; // client is gone
+    }
+    if (rf == RF_HEX)
+        reply.Write("\n");
+    reply.Finish();
+    return true;
+}
+
 static bool rest_chaininfo(HTTPRequest* req, const std::string& strURIPart)
 {
     if (!CheckWarmup(req))
@@ -323,11 +534,7 @@ static bool rest_mempool_contents(HTTPRequest* req, const std::string& strURIPar
 
     switch (rf) {
     case RF_JSON: {
-        UniValue mempoolObject = mempoolToJSON(true);
-
-        std::string strJSON = mempoolObject.write() + "\n";
-        req->WriteHeader("Content-Type", "application/json");
-        req->WriteReply(HTTP_OK, strJSON);
+        RESTStreamJSON(req, mempoolToJSONStream);
         return true;
     }
     default: {
@@ -351,6 +558,15 @@ static bool rest_tx(HTTPRequest* req, const std::string& strURIPart)
     if (!ParseHashStr(hashStr, hash))
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
+    // Confirmed transactions in JSON are shared with getrawtransaction through the response cache
+    const std::string strCacheKey = ResponseCacheKey("txjson", hash);
+    UniValue cached;
+    if (rf == RF_JSON && blockResponseCache.Get(strCacheKey, cached)) {
+        req->WriteHeader("Content-Type", "application/json");
+        req->WriteReply(HTTP_OK, cached.write() + "\n");
+        return true;
+    }
+
     CTransaction tx;
     uint256 hashBlock = uint256();
     if (!GetTransaction(hash, tx, hashBlock, true))
@@ -376,7 +592,13 @@ static bool rest_tx(HTTPRequest* req, const std::string& strURIPart)
 
     case RF_JSON: {
         UniValue objTx(UniValue::VOBJ);
-        TxToJSON(tx, hashBlock, objTx);
+        {
+            // TxToJSON reads chainActive, which the latest snapshot matches under cs_main
+            LOCK(cs_main);
+            TxToJSON(tx, hashBlock, objTx);
+            if (!hashBlock.IsNull())
+                blockResponseCache.Put(strCacheKey, LookupBlockIndex(hashBlock), objTx);
+        }
         std::string strJSON = objTx.write() + "\n";
         req->WriteHeader("Content-Type", "application/json");
         req->WriteReply(HTTP_OK, strJSON);
@@ -599,6 +821,8 @@ static const struct {
       {"/rest/mempool/info", rest_mempool_info},
       {"/rest/mempool/contents", rest_mempool_contents},
       {"/rest/headers/", rest_headers},
+      {"/rest/headerrange/", rest_headerrange},
+      {"/rest/blockrange/", rest_blockrange},
       {"/rest/getutxos", rest_getutxos},
 };
 
@@ -10,11 +10,14 @@
 #include "clientversion.h"
 #include "kernel.h"
 #include "main.h"
+#include "rpc/jsonstream.h"
+#include "rpc/responsecache.h"
 #include "rpc/server.h"
 #include "sync.h"
 #include "txdb.h"
 #include "util.h"
 #include "utilmoneystr.h"
+#include "validationinterface.h"
 #include "zpiv/accumulatormap.h"
 #include "zpiv/accumulators.h"
 #include "wallet/wallet.h"
@@ -47,10 +50,9 @@ double GetDifficulty(const CBlockIndex* blockindex)
     // Floating point number that is a multiple of the minimum difficulty,
     // minimum difficulty = 1.0.
     if (blockindex == NULL) {
-        if (chainActive.Tip() == NULL)
+        blockindex = GetChainTipSnapshot()->Tip();
+        if (blockindex == NULL)
             return 1.0;
-        else
-            blockindex = chainActive.Tip();
     }
 
     int nShift = (blockindex->nBits >> 24) & 0xff;
@@ -72,12 +74,13 @@ double GetDifficulty(const CBlockIndex* blockindex)
 
 UniValue blockheaderToJSON(const CBlockIndex* blockindex)
 {
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
     UniValue result(UniValue::VOBJ);
     result.push_back(Pair("hash", blockindex->GetBlockHash().GetHex()));
     int confirmations = -1;
     // Only report confirmations if the block is on the main chain
-    if (chainActive.Contains(blockindex))
-        confirmations = chainActive.Height() - blockindex->nHeight + 1;
+    if (chain->Contains(blockindex))
+        confirmations = chain->Height() - blockindex->nHeight + 1;
     result.push_back(Pair("confirmations", confirmations));
     result.push_back(Pair("height", blockindex->nHeight));
     result.push_back(Pair("version", blockindex->nVersion));
@@ -92,20 +95,59 @@ UniValue blockheaderToJSON(const CBlockIndex* blockindex)
 
     if (blockindex->pprev)
         result.push_back(Pair("previousblockhash", blockindex->pprev->GetBlockHash().GetHex()));
-    CBlockIndex *pnext = chainActive.Next(blockindex);
+    const CBlockIndex* pnext = chain->Next(blockindex);
     if (pnext)
         result.push_back(Pair("nextblockhash", pnext->GetBlockHash().GetHex()));
     return result;
 }
 
-UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, bool txDetails = false)
+static UniValue zpivSupplyToJSON(const CBlockIndex* blockindex)
+{
+    UniValue zpivObj(UniValue::VOBJ);
+    for (auto denom : libzerocoin::zerocoinDenomList) {
+        zpivObj.push_back(Pair(std::to_string(denom), ValueFromAmount(blockindex->mapZerocoinSupply.at(denom) * (denom*COIN))));
+    }
+    zpivObj.push_back(Pair("total", ValueFromAmount(blockindex->GetZerocoinSupply())));
+    return zpivObj;
+}
+
+//////////
+////////// Coin stake data ////////////////
+/////////
+static UniValue stakeDataToJSON(const CBlock& block, const CBlockIndex* blockindex)
+{
+    // The stake input is looked up in mapBlockIndex and chainActive
+    LOCK(cs_main);
+
+    // First grab it
+    uint256 hashProofOfStakeRet;
+    std::unique_ptr <CStakeInput> stake;
+    // Initialize the stake object (we should look for this in some other place and not initialize it every time..)
+    if (!initStakeInput(block, stake, blockindex->nHeight - 1))
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Cannot initialize stake input");
+
+    unsigned int nTxTime = block.nTime;
+    // todo: Add the debug as param..
+    if (!GetHashProofOfStake(blockindex->pprev, stake.get(), nTxTime, false, hashProofOfStakeRet))
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Cannot get proof of stake hash");
+
+    UniValue stakeData(UniValue::VOBJ);
+    stakeData.push_back(Pair("BlockFromHash", stake.get()->GetIndexFrom()->GetBlockHash().GetHex()));
+    stakeData.push_back(Pair("BlockFromHeight", stake.get()->GetIndexFrom()->nHeight));
+    stakeData.push_back(Pair("hashProofOfStake", hashProofOfStakeRet.GetHex()));
+    stakeData.push_back(Pair("stakeModifierHeight", ((stake->IsZPIV()) ? "Not available" : std::to_string(
+            stake->getStakeModifierHeight()))));
+    return stakeData;
+}
+
+UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, const CChainTipSnapshot& chain, bool txDetails)
 {
     UniValue result(UniValue::VOBJ);
     result.push_back(Pair("hash", block.GetHash().GetHex()));
     int confirmations = -1;
     // Only report confirmations if the block is on the main chain
-    if (chainActive.Contains(blockindex))
-        confirmations = chainActive.Height() - blockindex->nHeight + 1;
+    if (chain.Contains(blockindex))
+        confirmations = chain.Height() - blockindex->nHeight + 1;
     result.push_back(Pair("confirmations", confirmations));
     result.push_back(Pair("size", (int)::GetSerializeSize(block, SER_NETWORK, PROTOCOL_VERSION)));
     result.push_back(Pair("height", blockindex->nHeight));
@@ -131,7 +173,7 @@ UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, bool tx
 
     if (blockindex->pprev)
         result.push_back(Pair("previousblockhash", blockindex->pprev->GetBlockHash().GetHex()));
-    CBlockIndex* pnext = chainActive.Next(blockindex);
+    const CBlockIndex* pnext = chain.Next(blockindex);
     if (pnext)
         result.push_back(Pair("nextblockhash", pnext->GetBlockHash().GetHex()));
 
@@ -139,42 +181,80 @@ UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, bool tx
     result.push_back(Pair("modifierV2", blockindex->nStakeModifierV2.GetHex()));
 
     result.push_back(Pair("moneysupply",ValueFromAmount(blockindex->nMoneySupply)));
+    result.push_back(Pair("zPIVsupply", zpivSupplyToJSON(blockindex)));
 
-    UniValue zpivObj(UniValue::VOBJ);
-    for (auto denom : libzerocoin::zerocoinDenomList) {
-        zpivObj.push_back(Pair(std::to_string(denom), ValueFromAmount(blockindex->mapZerocoinSupply.at(denom) * (denom*COIN))));
-    }
-    zpivObj.push_back(Pair("total", ValueFromAmount(blockindex->GetZerocoinSupply())));
-    result.push_back(Pair("zPIVsupply", zpivObj));
-
-    //////////
-    ////////// Coin stake data ////////////////
-    /////////
-    if (block.IsProofOfStake()) {
-        // First grab it
-        uint256 hashProofOfStakeRet;
-        std::unique_ptr <CStakeInput> stake;
-        // Initialize the stake object (we should look for this in some other place and not initialize it every time..)
-        if (!initStakeInput(block, stake, blockindex->nHeight - 1))
-            throw JSONRPCError(RPC_INTERNAL_ERROR, "Cannot initialize stake input");
-
-        unsigned int nTxTime = block.nTime;
-        // todo: Add the debug as param..
-        if (!GetHashProofOfStake(blockindex->pprev, stake.get(), nTxTime, false, hashProofOfStakeRet))
-            throw JSONRPCError(RPC_INTERNAL_ERROR, "Cannot get proof of stake hash");
-
-        UniValue stakeData(UniValue::VOBJ);
-        stakeData.push_back(Pair("BlockFromHash", stake.get()->GetIndexFrom()->GetBlockHash().GetHex()));
-        stakeData.push_back(Pair("BlockFromHeight", stake.get()->GetIndexFrom()->nHeight));
-        stakeData.push_back(Pair("hashProofOfStake", hashProofOfStakeRet.GetHex()));
-        stakeData.push_back(Pair("stakeModifierHeight", ((stake->IsZPIV()) ? "Not available" : std::to_string(
-                stake->getStakeModifierHeight()))));
-        result.push_back(Pair("CoinStake", stakeData));
-    }
+    if (block.IsProofOfStake())
+        result.push_back(Pair("CoinStake", stakeDataToJSON(block, blockindex)));
 
     return result;
 }
 
+UniValue blockToJSON(const CBlock& block, const CBlockIndex* blockindex, bool txDetails = false)
+{
+    return blockToJSON(block, blockindex, *GetChainTipSnapshot(), txDetails);
+}
+
+/**
+ * Same document as blockToJSON, written to the stream as it is produced: with
+ * txDetails, only one transaction at a time is held as a UniValue.
+ */
+void blockToJSONStream(CJSONStreamWriter& writer, const CBlock& block, const CBlockIndex* blockindex, bool txDetails)
+{
+    // Whatever can fail is done before the first byte is written
+    UniValue stakeData;
+    if (block.IsProofOfStake())
+        stakeData = stakeDataToJSON(block, blockindex);
+
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
+    writer.BeginObject();
+    writer.Pair("hash", block.GetHash().GetHex());
+    int confirmations = -1;
+    // Only report confirmations if the block is on the main chain
+    if (chain->Contains(blockindex))
+        confirmations = chain->Height() - blockindex->nHeight + 1;
+    writer.Pair("confirmations", confirmations);
+    writer.Pair("size", (int)::GetSerializeSize(block, SER_NETWORK, PROTOCOL_VERSION));
+    writer.Pair("height", blockindex->nHeight);
+    writer.Pair("version", block.nVersion);
+    writer.Pair("merkleroot", block.hashMerkleRoot.GetHex());
+    writer.Pair("acc_checkpoint", block.nAccumulatorCheckpoint.GetHex());
+    writer.Key("tx");
+    writer.BeginArray();
+    for (const CTransaction& tx : block.vtx) {
+        if (writer.IsStopped())
+            break;
+        if (txDetails) {
+            UniValue objTx(UniValue::VOBJ);
+            TxToJSON(tx, uint256(0), objTx);
+            writer.Value(objTx);
+        } else
+            writer.Value(tx.GetHash().GetHex());
+    }
+    writer.EndArray();
+    writer.Pair("time", block.GetBlockTime());
+    writer.Pair("mediantime", (int64_t)blockindex->GetMedianTimePast());
+    writer.Pair("nonce", (uint64_t)block.nNonce);
+    writer.Pair("bits", strprintf("%08x", block.nBits));
+    writer.Pair("difficulty", GetDifficulty(blockindex));
+    writer.Pair("chainwork", blockindex->nChainWork.GetHex());
+
+    if (blockindex->pprev)
+        writer.Pair("previousblockhash", blockindex->pprev->GetBlockHash().GetHex());
+    const CBlockIndex* pnext = chain->Next(blockindex);
+    if (pnext)
+        writer.Pair("nextblockhash", pnext->GetBlockHash().GetHex());
+
+    writer.Pair("modifier", strprintf("%016x", blockindex->nStakeModifier));
+    writer.Pair("modifierV2", blockindex->nStakeModifierV2.GetHex());
+
+    writer.Pair("moneysupply", ValueFromAmount(blockindex->nMoneySupply));
+    writer.Pair("zPIVsupply", zpivSupplyToJSON(blockindex));
+
+    if (!stakeData.isNull())
+        writer.Pair("CoinStake", stakeData);
+    writer.EndObject();
+}
+
 UniValue getchecksumblock(const UniValue& params, bool fHelp)
 {
     if (fHelp || params.size() < 2 || params.size() > 3)
@@ -274,8 +354,7 @@ UniValue getblockcount(const UniValue& params, bool fHelp)
             "\nExamples:\n" +
             HelpExampleCli("getblockcount", "") + HelpExampleRpc("getblockcount", ""));
 
-    LOCK(cs_main);
-    return chainActive.Height();
+    return GetChainTipSnapshot()->Height();
 }
 
 UniValue getbestblockhash(const UniValue& params, bool fHelp)
@@ -291,8 +370,7 @@ UniValue getbestblockhash(const UniValue& params, bool fHelp)
             "\nExamples\n" +
             HelpExampleCli("getbestblockhash", "") + HelpExampleRpc("getbestblockhash", ""));
 
-    LOCK(cs_main);
-    return chainActive.Tip()->GetBlockHash().GetHex();
+    return GetChainTipSnapshot()->Tip()->GetBlockHash().GetHex();
 }
 
 void RPCNotifyBlockChange(const uint256 hashBlock)
@@ -437,6 +515,21 @@ UniValue waitforblockheight(const UniValue& params, bool fHelp)
     return ret;
 }
 
+UniValue syncwithvalidationinterfacequeue(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() > 0) {
+        throw std::runtime_error(
+            "syncwithvalidationinterfacequeue\n"
+            "\nWaits for the validation interface queue to catch up on everything that was there when we entered this function.\n"
+            "\nExamples:\n"
+            + HelpExampleCli("syncwithvalidationinterfacequeue","")
+            + HelpExampleRpc("syncwithvalidationinterfacequeue","")
+        );
+    }
+    SyncWithValidationInterfaceQueue();
+    return NullUniValue;
+}
+
 UniValue getdifficulty(const UniValue& params, bool fHelp)
 {
     if (fHelp || params.size() != 0)
@@ -450,41 +543,43 @@ UniValue getdifficulty(const UniValue& params, bool fHelp)
             "\nExamples:\n" +
             HelpExampleCli("getdifficulty", "") + HelpExampleRpc("getdifficulty", ""));
 
-    LOCK(cs_main);
     return GetDifficulty();
 }
 
 
+static UniValue mempoolEntryToJSON(const CTxMemPoolEntry& e)
+{
+    AssertLockHeld(mempool.cs);
+    UniValue info(UniValue::VOBJ);
+    info.push_back(Pair("size", (int)e.GetTxSize()));
+    info.push_back(Pair("fee", ValueFromAmount(e.GetFee())));
+    info.push_back(Pair("time", e.GetTime()));
+    info.push_back(Pair("height", (int)e.GetHeight()));
+    info.push_back(Pair("startingpriority", e.GetPriority(e.GetHeight())));
+    info.push_back(Pair("currentpriority", e.GetPriority(GetChainTipSnapshot()->Height())));
+    const CTransaction& tx = e.GetTx();
+    std::set<std::string> setDepends;
+    for (const CTxIn& txin : tx.vin) {
+        if (mempool.exists(txin.prevout.hash))
+            setDepends.insert(txin.prevout.hash.ToString());
+    }
+
+    UniValue depends(UniValue::VARR);
+    for (const std::string& dep : setDepends) {
+        depends.push_back(dep);
+    }
+
+    info.push_back(Pair("depends", depends));
+    return info;
+}
+
 UniValue mempoolToJSON(bool fVerbose = false)
 {
     if (fVerbose) {
         LOCK(mempool.cs);
         UniValue o(UniValue::VOBJ);
-        for (const PAIRTYPE(uint256, CTxMemPoolEntry) & entry : mempool.mapTx) {
-            const uint256& hash = entry.first;
-            const CTxMemPoolEntry& e = entry.second;
-            UniValue info(UniValue::VOBJ);
-            info.push_back(Pair("size", (int)e.GetTxSize()));
-            info.push_back(Pair("fee", ValueFromAmount(e.GetFee())));
-            info.push_back(Pair("time", e.GetTime()));
-            info.push_back(Pair("height", (int)e.GetHeight()));
-            info.push_back(Pair("startingpriority", e.GetPriority(e.GetHeight())));
-            info.push_back(Pair("currentpriority", e.GetPriority(chainActive.Height())));
-            const CTransaction& tx = e.GetTx();
-            std::set<std::string> setDepends;
-            for (const CTxIn& txin : tx.vin) {
-                if (mempool.exists(txin.prevout.hash))
-                    setDepends.insert(txin.prevout.hash.ToString());
-            }
-
-            UniValue depends(UniValue::VARR);
-            for (const std::string& dep : setDepends) {
-                depends.push_back(dep);
-            }
-
-            info.push_back(Pair("depends", depends));
-            o.push_back(Pair(hash.ToString(), info));
-        }
+        for (const PAIRTYPE(uint256, CTxMemPoolEntry) & entry : mempool.mapTx)
+            o.push_back(Pair(entry.first.ToString(), mempoolEntryToJSON(entry.second)));
         return o;
     } else {
         std::vector<uint256> vtxid;
@@ -498,6 +593,35 @@ UniValue mempoolToJSON(bool fVerbose = false)
     }
 }
 
+/**
+ * Verbose mempoolToJSON written to the stream. mempool.cs isn't held while writing,
+ * as the output may wait for the client: the entries are read in batches, and those
+ * that left the mempool in between are skipped.
+ */
+void mempoolToJSONStream(CJSONStreamWriter& writer)
+{
+    static const size_t nBatchSize = 1000;
+
+    std::vector<uint256> vtxid;
+    mempool.queryHashes(vtxid);
+
+    writer.BeginObject();
+    for (size_t nStart = 0; nStart < vtxid.size() && !writer.IsStopped(); nStart += nBatchSize) {
+        std::vector<std::pair<std::string, UniValue> > vEntries;
+        {
+            LOCK(mempool.cs);
+            for (size_t i = nStart; i < std::min(nStart + nBatchSize, vtxid.size()); i++) {
+                std::map<uint256, CTxMemPoolEntry>::const_iterator it = mempool.mapTx.find(vtxid[i]);
+                if (it != mempool.mapTx.end())
+                    vEntries.emplace_back(it->first.ToString(), mempoolEntryToJSON(it->second));
+            }
+        }
+        for (const auto& entry : vEntries)
+            writer.Pair(entry.first, entry.second);
+    }
+    writer.EndObject();
+}
+
 UniValue getrawmempool(const UniValue& params, bool fHelp)
 {
     if (fHelp || params.size() > 1)
@@ -532,8 +656,6 @@ UniValue getrawmempool(const UniValue& params, bool fHelp)
             "\nExamples\n" +
             HelpExampleCli("getrawmempool", "true") + HelpExampleRpc("getrawmempool", "true"));
 
-    LOCK(cs_main);
-
     bool fVerbose = false;
     if (params.size() > 0)
         fVerbose = params[0].get_bool();
@@ -557,13 +679,13 @@ UniValue getblockhash(const UniValue& params, bool fHelp)
             "\nExamples:\n" +
             HelpExampleCli("getblockhash", "1000") + HelpExampleRpc("getblockhash", "1000"));
 
-    LOCK(cs_main);
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
 
     int nHeight = params[0].get_int();
-    if (nHeight < 0 || nHeight > chainActive.Height())
+    if (nHeight < 0 || nHeight > chain->Height())
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Block height out of range");
 
-    CBlockIndex* pblockindex = chainActive[nHeight];
+    const CBlockIndex* pblockindex = (*chain)[nHeight];
     return pblockindex->GetBlockHash().GetHex();
 }
 
@@ -626,8 +748,6 @@ UniValue getblock(const UniValue& params, bool fHelp)
             HelpExampleCli("getblock", "\"00000000000fd08c2fb661d2fcb0d49abb3a91e5f27082ce64feed3b4dede2e2\"") +
             HelpExampleRpc("getblock", "\"00000000000fd08c2fb661d2fcb0d49abb3a91e5f27082ce64feed3b4dede2e2\""));
 
-    LOCK(cs_main);
-
     std::string strHash = params[0].get_str();
     uint256 hash(strHash);
 
@@ -635,23 +755,32 @@ UniValue getblock(const UniValue& params, bool fHelp)
     if (params.size() > 1)
         fVerbose = params[1].get_bool();
 
-    if (mapBlockIndex.count(hash) == 0)
+    // cs_main is only held for the lookup, the block is read and converted without it
+    CBlockIndex* pblockindex = LookupBlockIndex(hash);
+    if (!pblockindex)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
 
-    CBlock block;
-    CBlockIndex* pblockindex = mapBlockIndex[hash];
+    // The result is rendered and cached for the same chain
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
+    const std::string strCacheKey = ResponseCacheKey(fVerbose ? "blockjson" : "blockhex", hash);
+    UniValue cached;
+    if (blockResponseCache.Get(strCacheKey, cached, *chain))
+        return cached;
 
+    CBlock block;
     if (!ReadBlockFromDisk(block, pblockindex))
         throw JSONRPCError(RPC_INTERNAL_ERROR, "Can't read block from disk");
 
+    UniValue result;
     if (!fVerbose) {
         CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
         ssBlock << block;
-        std::string strHex = HexStr(ssBlock.begin(), ssBlock.end());
-        return strHex;
+        result = HexStr(ssBlock.begin(), ssBlock.end());
+    } else {
+        result = blockToJSON(block, pblockindex, *chain, false);
     }
-
-    return blockToJSON(block, pblockindex);
+    blockResponseCache.Put(strCacheKey, pblockindex, result, *chain);
+    return result;
 }
 
 UniValue getblockheader(const UniValue& params, bool fHelp)
@@ -691,11 +820,10 @@ UniValue getblockheader(const UniValue& params, bool fHelp)
     if (params.size() > 1)
         fVerbose = params[1].get_bool();
 
-    if (mapBlockIndex.count(hash) == 0)
+    CBlockIndex* pblockindex = LookupBlockIndex(hash);
+    if (!pblockindex)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
 
-    CBlockIndex* pblockindex = mapBlockIndex[hash];
-
     if (!fVerbose) {
         CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
         ssBlock << pblockindex->GetBlockHeader();
@@ -723,6 +851,8 @@ UniValue gettxoutsetinfo(const UniValue& params, bool fHelp)
             "  \"bytes_serialized\": n,  (numeric) The serialized size\n"
             "  \"hash_serialized\": \"hash\",   (string) The serialized hash\n"
             "  \"total_amount\": x.xxx          (numeric) The total amount\n"
+            "  \"cache_usage\": n,       (numeric) Memory used by the in-memory UTXO cache before this call flushed it, in bytes\n"
+            "  \"cache_limit\": n        (numeric) Memory the in-memory UTXO cache may use before being flushed, in bytes\n"
             "}\n"
 
             "\nExamples:\n" +
@@ -733,6 +863,7 @@ UniValue gettxoutsetinfo(const UniValue& params, bool fHelp)
     UniValue ret(UniValue::VOBJ);
 
     CCoinsStats stats;
+    const size_t nCacheUsage = pcoinsTip->DynamicMemoryUsage();
     FlushStateToDisk();
     if (pcoinsTip->GetStats(stats)) {
         ret.push_back(Pair("height", (int64_t)stats.nHeight));
@@ -742,6 +873,8 @@ UniValue gettxoutsetinfo(const UniValue& params, bool fHelp)
         ret.push_back(Pair("bytes_serialized", (int64_t)stats.nSerializedSize));
         ret.push_back(Pair("hash_serialized", stats.hashSerialized.GetHex()));
         ret.push_back(Pair("total_amount", ValueFromAmount(stats.nTotalAmount)));
+        ret.push_back(Pair("cache_usage", (uint64_t)nCacheUsage));
+        ret.push_back(Pair("cache_limit", (uint64_t)nCoinCacheUsage));
     }
     return ret;
 }
@@ -858,10 +991,10 @@ UniValue verifychain(const UniValue& params, bool fHelp)
 }
 
 /** Implementation of IsSuperMajority with better feedback */
-static UniValue SoftForkMajorityDesc(int minVersion, CBlockIndex* pindex, int nRequired)
+static UniValue SoftForkMajorityDesc(int minVersion, const CBlockIndex* pindex, int nRequired)
 {
     int nFound = 0;
-    CBlockIndex* pstart = pindex;
+    const CBlockIndex* pstart = pindex;
     for (int i = 0; i < Params().ToCheckBlockUpgradeMajority() && pstart != NULL; i++)
     {
         if (pstart->nVersion >= minVersion)
@@ -875,7 +1008,7 @@ static UniValue SoftForkMajorityDesc(int minVersion, CBlockIndex* pindex, int nR
     rv.push_back(Pair("window", Params().ToCheckBlockUpgradeMajority()));
     return rv;
 }
-static UniValue SoftForkDesc(const std::string &name, int version, CBlockIndex* pindex)
+static UniValue SoftForkDesc(const std::string &name, int version, const CBlockIndex* pindex)
 {
     UniValue rv(UniValue::VOBJ);
     rv.push_back(Pair("id", name));
@@ -901,6 +1034,11 @@ UniValue getblockchaininfo(const UniValue& params, bool fHelp)
             "  \"difficulty\": xxxxxx,     (numeric) the current difficulty\n"
             "  \"verificationprogress\": xxxx, (numeric) estimate of verification progress [0..1]\n"
             "  \"chainwork\": \"xxxx\"     (string) total amount of work in active chain, in hexadecimal\n"
+            "  \"coins_cache\": {          (object) the in-memory UTXO cache\n"
+            "     \"entries\": xx,          (numeric) number of cached transactions\n"
+            "     \"usage\": xx,            (numeric) memory used, in bytes\n"
+            "     \"limit\": xx             (numeric) memory the cache may use before being flushed (-dbcache), in bytes\n"
+            "  },\n"
             "  \"softforks\": [            (array) status of softforks in progress\n"
             "     {\n"
             "        \"id\": \"xxxx\",        (string) name of softfork\n"
@@ -919,17 +1057,28 @@ UniValue getblockchaininfo(const UniValue& params, bool fHelp)
             "\nExamples:\n" +
             HelpExampleCli("getblockchaininfo", "") + HelpExampleRpc("getblockchaininfo", ""));
 
-    LOCK(cs_main);
+    ChainTipSnapshotRef chain = GetChainTipSnapshot();
+    const CBlockIndex* tip = chain->Tip();
+
+    int nHeaders;
+    UniValue coinsCache(UniValue::VOBJ);
+    {
+        LOCK(cs_main);
+        nHeaders = pindexBestHeader ? pindexBestHeader->nHeight : -1;
+        coinsCache.push_back(Pair("entries", (uint64_t)pcoinsTip->GetCacheSize()));
+        coinsCache.push_back(Pair("usage", (uint64_t)pcoinsTip->DynamicMemoryUsage()));
+        coinsCache.push_back(Pair("limit", (uint64_t)nCoinCacheUsage));
+    }
 
     UniValue obj(UniValue::VOBJ);
     obj.push_back(Pair("chain", Params().NetworkIDString()));
-    obj.push_back(Pair("blocks", (int)chainActive.Height()));
-    obj.push_back(Pair("headers", pindexBestHeader ? pindexBestHeader->nHeight : -1));
-    obj.push_back(Pair("bestblockhash", chainActive.Tip()->GetBlockHash().GetHex()));
-    obj.push_back(Pair("difficulty", (double)GetDifficulty()));
-    obj.push_back(Pair("verificationprogress", Checkpoints::GuessVerificationProgress(chainActive.Tip())));
-    obj.push_back(Pair("chainwork", chainActive.Tip()->nChainWork.GetHex()));
-    CBlockIndex* tip = chainActive.Tip();
+    obj.push_back(Pair("blocks", chain->Height()));
+    obj.push_back(Pair("headers", nHeaders));
+    obj.push_back(Pair("bestblockhash", tip->GetBlockHash().GetHex()));
+    obj.push_back(Pair("difficulty", (double)GetDifficulty(tip)));
+    obj.push_back(Pair("verificationprogress", Checkpoints::GuessVerificationProgress(tip)));
+    obj.push_back(Pair("chainwork", tip->nChainWork.GetHex()));
+    obj.push_back(Pair("coins_cache", coinsCache));
     UniValue softforks(UniValue::VARR);
     softforks.push_back(SoftForkDesc("bip65", 5, tip));
     obj.push_back(Pair("softforks",             softforks));
@@ -1108,6 +1257,22 @@ UniValue getmempoolinfo(const UniValue& params, bool fHelp)
     return mempoolInfoToJSON();
 }
 
+UniValue savemempool(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 0)
+        throw std::runtime_error(
+            "savemempool\n"
+            "\nDumps the mempool to disk.\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("savemempool", "") + HelpExampleRpc("savemempool", ""));
+
+    if (!DumpMempool())
+        throw JSONRPCError(RPC_MISC_ERROR, "Unable to dump mempool to disk");
+
+    return NullUniValue;
+}
+
 UniValue invalidateblock(const UniValue& params, bool fHelp)
 {
     if (fHelp || params.size() != 1)
@@ -23,11 +23,20 @@ class CRPCConvertParam
 public:
     std::string methodName; //! method whose params want conversion
     int paramIdx;           //! 0-based idx of param to convert
+    bool fStringFallback;   //! pass the param as a string when it isn't JSON
 };
 // ***TODO***
 static const CRPCConvertParam vRPCConvertParams[] =
     {
         {"stop", 0},
+        {"getrpcstats", 0},
+        {"getlockcontention", 0},
+        {"getlockcontention", 1},
+        {"setlockprofiling", 0},
+        {"getaddressutxos", 0, true},
+        {"getaddressdeltas", 0, true},
+        {"getaddressbalance", 0, true},
+        {"getspentinfo", 0},
         {"setmocktime", 0},
         {"getaddednodeinfo", 0},
         {"setgenerate", 0},
@@ -177,6 +186,7 @@ class CRPCConvertTable
 {
 private:
     std::set<std::pair<std::string, int> > members;
+    std::set<std::pair<std::string, int> > membersStringFallback;
 
 public:
     CRPCConvertTable();
@@ -185,6 +195,11 @@ public:
     {
         return (members.count(std::make_pair(method, idx)) > 0);
     }
+
+    bool stringFallback(const std::string& method, int idx)
+    {
+        return (membersStringFallback.count(std::make_pair(method, idx)) > 0);
+    }
 };
 
 CRPCConvertTable::CRPCConvertTable()
@@ -195,6 +210,9 @@ CRPCConvertTable::CRPCConvertTable()
     for (unsigned int i = 0; i < n_elem; i++) {
         members.insert(std::make_pair(vRPCConvertParams[i].methodName,
             vRPCConvertParams[i].paramIdx));
+        if (vRPCConvertParams[i].fStringFallback)
+            membersStringFallback.insert(std::make_pair(vRPCConvertParams[i].methodName,
+                vRPCConvertParams[i].paramIdx));
     }
 }
 
@@ -223,6 +241,13 @@ UniValue RPCConvertValues(const std::string &strMethod, const std::vector<std::s
         if (!rpcCvtTable.convert(strMethod, idx)) {
             // insert string value directly
             params.push_back(strVal);
+        } else if (rpcCvtTable.stringFallback(strMethod, idx)) {
+            // JSON if it parses, e.g. an object, and the string itself otherwise, e.g. an address
+            UniValue jVal;
+            if (jVal.read(std::string("[") + strVal + std::string("]")) && jVal.isArray() && jVal.size() == 1)
+                params.push_back(jVal[0]);
+            else
+                params.push_back(strVal);
         } else {
             // parse string as JSON, insert bool/number/object/etc. value
             params.push_back(ParseNonRFCJSONValue(strVal));
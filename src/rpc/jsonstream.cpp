@@ -0,0 +1,149 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "rpc/jsonstream.h"
+
+#include <assert.h>
+
+#include <univalue.h>
+
+CJSONStreamWriter::CJSONStreamWriter(const OutputFunc& fnOutput, size_t nFlushSize) : fnOutput(fnOutput),
+                                                                                      nFlushSize(nFlushSize),
+                                                                                      fAfterKey(false),
+                                                                                      fStopped(false)
+{
+    strBuffer.reserve(nFlushSize + 1024);
+}
+
+void CJSONStreamWriter::Flush()
+{
+    if (strBuffer.empty())
+        return;
+    if (!fStopped && !fnOutput(strBuffer))
+        fStopped = true;
+    strBuffer.clear();
+}
+
+void CJSONStreamWriter::BeginValue()
+{
+    if (fAfterKey) {
+        fAfterKey = false;
+        return;
+    }
+    if (!vFirst.empty()) {
+        if (!vFirst.back())
+            strBuffer += ',';
+        vFirst.back() = false;
+    }
+}
+
+void CJSONStreamWriter::WriteString(const std::string& str)
+{
+    // Same escapes as univalue
+    static const char* hexdigits = "0123456789abcdef";
+    strBuffer += '"';
+    for (unsigned char ch : str) {
+        switch (ch) {
+        case '"': strBuffer += "\\\""; break;
+        case '\\': strBuffer += "\\\\"; break;
+        case '\b': strBuffer += "\\b"; break;
+        case '\t': strBuffer += "\\t"; break;
+        case '\n': strBuffer += "\\n"; break;
+        case '\f': strBuffer += "\\f"; break;
+        case '\r': strBuffer += "\\r"; break;
+        default:
+            if (ch < 0x20 || ch == 0x7f) {
+                strBuffer += "\\u00";
+                strBuffer += hexdigits[ch >> 4];
+                strBuffer += hexdigits[ch & 0xf];
+            } else {
+                strBuffer += ch;
+            }
+        }
+    }
+    strBuffer += '"';
+}
+
+void CJSONStreamWriter::BeginObject()
+{
+    BeginValue();
+    strBuffer += '{';
+    vFirst.push_back(true);
+}
+
+void CJSONStreamWriter::EndObject()
+{
+    assert(!vFirst.empty() && !fAfterKey);
+    vFirst.pop_back();
+    strBuffer += '}';
+    MaybeFlush();
+}
+
+void CJSONStreamWriter::BeginArray()
+{
+    BeginValue();
+    strBuffer += '[';
+    vFirst.push_back(true);
+}
+
+void CJSONStreamWriter::EndArray()
+{
+    assert(!vFirst.empty() && !fAfterKey);
+    vFirst.pop_back();
+    strBuffer += ']';
+    MaybeFlush();
+}
+
+void CJSONStreamWriter::Key(const std::string& strKey)
+{
+    assert(!vFirst.empty() && !fAfterKey);
+    BeginValue();
+    WriteString(strKey);
+    strBuffer += ':';
+    fAfterKey = true;
+}
+
+void CJSONStreamWriter::Value(const UniValue& val)
+{
+    switch (val.getType()) {
+    case UniValue::VOBJ: {
+        BeginObject();
+        const std::vector<std::string>& keys = val.getKeys();
+        const std::vector<UniValue>& values = val.getValues();
+        for (unsigned int i = 0; i < keys.size(); i++)
+            Pair(keys[i], values[i]);
+        EndObject();
+        return;
+    }
+    case UniValue::VARR:
+        BeginArray();
+        for (const UniValue& item : val.getValues())
+            Value(item);
+        EndArray();
+        return;
+    case UniValue::VNULL:
+        BeginValue();
+        strBuffer += "null";
+        break;
+    case UniValue::VSTR:
+        BeginValue();
+        WriteString(val.getValStr());
+        break;
+    case UniValue::VNUM:
+        BeginValue();
+        strBuffer += val.getValStr();
+        break;
+    case UniValue::VBOOL:
+        BeginValue();
+        strBuffer += val.isTrue() ? "true" : "false";
+        break;
+    }
+    MaybeFlush();
+}
+
+void CJSONStreamWriter::Pair(const std::string& strKey, const UniValue& val)
+{
+    Key(strKey);
+    Value(val);
+}
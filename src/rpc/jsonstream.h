@@ -0,0 +1,67 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef PIVX_RPC_JSONSTREAM_H
+#define PIVX_RPC_JSONSTREAM_H
+
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class UniValue;
+
+/** Size of the pieces handed to the output of a CJSONStreamWriter */
+static const size_t DEFAULT_JSON_FLUSH_SIZE = 64 * 1024;
+
+/**
+ * Writes compact JSON text, the same as UniValue::write(), while the document is
+ * walked, instead of building the whole UniValue tree and its string first.
+ * The text is buffered and handed to the output every nFlushSize bytes, so the
+ * memory used doesn't grow with the size of the document.
+ */
+class CJSONStreamWriter
+{
+public:
+    /** Receives the next piece of text; returns false to stop the output */
+    typedef std::function<bool(const std::string&)> OutputFunc;
+
+    explicit CJSONStreamWriter(const OutputFunc& fnOutput, size_t nFlushSize = DEFAULT_JSON_FLUSH_SIZE);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    /** Key of the next value of the current object */
+    void Key(const std::string& strKey);
+    /** Write a value, walking it if it is an object or an array */
+    void Value(const UniValue& val);
+    /** Shorthand for Key(strKey) followed by Value(val) */
+    void Pair(const std::string& strKey, const UniValue& val);
+
+    /** Hand the buffered text to the output; call it once the document is complete */
+    void Flush();
+    /** Whether the output refused more text; the rest of the document can be skipped */
+    bool IsStopped() const { return fStopped; }
+
+private:
+    OutputFunc fnOutput;
+    size_t nFlushSize;
+    std::string strBuffer;
+    //! One entry per open object or array: whether it has no element yet
+    std::vector<bool> vFirst;
+    //! A key was just written, the next value belongs to it
+    bool fAfterKey;
+    bool fStopped;
+
+    void BeginValue();
+    void WriteString(const std::string& str);
+    void MaybeFlush()
+    {
+        if (strBuffer.size() >= nFlushSize)
+            Flush();
+    }
+};
+
+#endif // PIVX_RPC_JSONSTREAM_H
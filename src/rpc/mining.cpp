@@ -175,6 +175,8 @@ UniValue generate(const UniValue& params, bool fHelp)
         CValidationState state;
         if (!ProcessNewBlock(state, NULL, pblock))
             throw JSONRPCError(RPC_INTERNAL_ERROR, "ProcessNewBlock, block not accepted");
+        // The wallet has to know about this block before staking the next one
+        SyncWithValidationInterfaceQueue();
         ++nHeight;
         fPoS = nHeight >= Params().LAST_POW_BLOCK();
         blockHashes.push_back(pblock->GetHash().GetHex());
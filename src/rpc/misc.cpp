@@ -5,6 +5,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include "addressindex.h"
 #include "base58.h"
 #include "clientversion.h"
 #include "init.h"
@@ -587,6 +588,323 @@ UniValue setmocktime(const UniValue& params, bool fHelp)
     return NullUniValue;
 }
 
+UniValue setlockprofiling(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 1)
+        throw std::runtime_error(
+            "setlockprofiling enabled\n"
+            "\nTurn the lock contention profiler on or off. The collected statistics are kept until reset.\n"
+
+            "\nArguments:\n"
+            "1. enabled  (boolean, required) true to start profiling, false to stop\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("setlockprofiling", "true") + HelpExampleRpc("setlockprofiling", "true"));
+
+    RPCTypeCheck(params, boost::assign::list_of(UniValue::VBOOL));
+    EnableLockProfiling(params[0].get_bool());
+
+    return NullUniValue;
+}
+
+UniValue getlockcontention(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() > 2)
+        throw std::runtime_error(
+            "getlockcontention ( count reset )\n"
+            "\nReturns the lock sites with the most time spent waiting, as recorded by the lock profiler\n"
+            "(see setlockprofiling and -lockprofiling).\n"
+
+            "\nArguments:\n"
+            "1. count  (numeric, optional, default=20) Number of sites to return, 0 for all\n"
+            "2. reset  (boolean, optional, default=false) Clear the statistics after reading them\n"
+
+            "\nResult:\n"
+            "{\n"
+            "  \"enabled\": true|false,     (boolean) if the profiler is running\n"
+            "  \"sites\": [                 (array) sites sorted by total wait time\n"
+            "    {\n"
+            "      \"lock\": \"name\",        (string) the locked critical section\n"
+            "      \"site\": \"file:line\",   (string) where it was locked\n"
+            "      \"acquisitions\": n,     (numeric) number of times the lock was taken there\n"
+            "      \"contentions\": n,      (numeric) how many of those had to wait\n"
+            "      \"wait_us\": n,          (numeric) total wait time in microseconds\n"
+            "      \"max_wait_us\": n,      (numeric) longest wait in microseconds\n"
+            "      \"hold_us\": n,          (numeric) total time the lock was held in microseconds\n"
+            "      \"max_hold_us\": n       (numeric) longest hold in microseconds\n"
+            "    }, ...\n"
+            "  ]\n"
+            "}\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("getlockcontention", "") + HelpExampleCli("getlockcontention", "10 true") +
+            HelpExampleRpc("getlockcontention", "10, true"));
+
+    int nCount = params.size() > 0 ? params[0].get_int() : 20;
+    if (nCount < 0)
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid count, must be non-negative");
+    bool fReset = params.size() > 1 && params[1].get_bool();
+
+    std::vector<CLockSiteStats> vSites = GetLockProfile();
+    if (fReset)
+        ResetLockProfile();
+    if (nCount > 0 && vSites.size() > (size_t)nCount)
+        vSites.resize(nCount);
+
+    UniValue sites(UniValue::VARR);
+    for (const CLockSiteStats& stats : vSites) {
+        UniValue site(UniValue::VOBJ);
+        site.push_back(Pair("lock", stats.strName));
+        site.push_back(Pair("site", strprintf("%s:%d", stats.strFile, stats.nLine)));
+        site.push_back(Pair("acquisitions", stats.nAcquisitions));
+        site.push_back(Pair("contentions", stats.nContentions));
+        site.push_back(Pair("wait_us", stats.nWaitMicros));
+        site.push_back(Pair("max_wait_us", stats.nMaxWaitMicros));
+        site.push_back(Pair("hold_us", stats.nHoldMicros));
+        site.push_back(Pair("max_hold_us", stats.nMaxHoldMicros));
+        sites.push_back(site);
+    }
+
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("enabled", g_fLockProfiling.load()));
+    obj.push_back(Pair("sites", sites));
+    return obj;
+}
+
+/** The addresses of an address index query, given as a single address or as {"addresses": [...]} */
+static std::vector<std::pair<CIndexAddress, std::string> > ParseIndexAddresses(const UniValue& param)
+{
+    std::vector<UniValue> vValues;
+    if (param.isStr()) {
+        vValues.push_back(param);
+    } else if (param.isObject()) {
+        const UniValue& addresses = find_value(param.get_obj(), "addresses");
+        if (!addresses.isArray())
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Addresses must be an array");
+        vValues = addresses.getValues();
+    } else {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Expected an address or an object with addresses");
+    }
+
+    std::vector<std::pair<CIndexAddress, std::string> > vAddresses;
+    for (const UniValue& value : vValues) {
+        CBitcoinAddress address(value.get_str());
+        CIndexAddress indexAddress = address.IsValid() ? CIndexAddress::FromDestination(address.Get()) : CIndexAddress();
+        if (indexAddress.IsNull())
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid address: ") + value.get_str());
+        vAddresses.push_back(std::make_pair(indexAddress, value.get_str()));
+    }
+    return vAddresses;
+}
+
+/** Refuse queries while the index is disabled or still being built */
+static void EnsureAddressIndex()
+{
+    if (!paddressindex)
+        throw JSONRPCError(RPC_MISC_ERROR, "Address index not enabled, restart with -addressindex");
+    int nHeight;
+    if (!IsAddressIndexSynced(&nHeight))
+        throw JSONRPCError(RPC_IN_WARMUP, strprintf("Address index is being built, at height %d", nHeight));
+}
+
+UniValue getaddressutxos(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 1)
+        throw std::runtime_error(
+            "getaddressutxos {\"addresses\": [\"address\",...]}\n"
+            "\nReturns the unspent outputs of the addresses. Requires -addressindex.\n"
+
+            "\nArguments:\n"
+            "1. addresses    (object or string, required) An address, or {\"addresses\": [\"address\",...]}\n"
+            "                 (on the command line, quote the object: '{\"addresses\": [...]}')\n"
+
+            "\nResult:\n"
+            "[\n"
+            "  {\n"
+            "    \"address\": \"address\",  (string) the address\n"
+            "    \"txid\": \"hash\",        (string) the transaction id\n"
+            "    \"outputIndex\": n,      (numeric) the output index\n"
+            "    \"script\": \"hex\",       (string) the output script\n"
+            "    \"satoshis\": n,         (numeric) the output value in satoshis\n"
+            "    \"height\": n            (numeric) the height of the block with the transaction\n"
+            "  }, ...\n"
+            "]\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("getaddressutxos", "DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6") +
+            HelpExampleCli("getaddressutxos", "'{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"]}'") +
+            HelpExampleRpc("getaddressutxos", "{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"]}"));
+
+    std::vector<std::pair<CIndexAddress, std::string> > vAddresses = ParseIndexAddresses(params[0]);
+    EnsureAddressIndex();
+
+    UniValue result(UniValue::VARR);
+    for (const std::pair<CIndexAddress, std::string>& address : vAddresses) {
+        std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > vUnspent;
+        if (!paddressindex->ReadAddressUnspent(address.first, vUnspent))
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Unable to read the address index");
+        for (const std::pair<CAddressUnspentKey, CAddressUnspentValue>& unspent : vUnspent) {
+            UniValue output(UniValue::VOBJ);
+            output.push_back(Pair("address", address.second));
+            output.push_back(Pair("txid", unspent.first.txid.GetHex()));
+            output.push_back(Pair("outputIndex", (int64_t)unspent.first.nIndex));
+            output.push_back(Pair("script", HexStr(unspent.second.script.begin(), unspent.second.script.end())));
+            output.push_back(Pair("satoshis", unspent.second.nValue));
+            output.push_back(Pair("height", unspent.second.nHeight));
+            result.push_back(output);
+        }
+    }
+    return result;
+}
+
+UniValue getaddressdeltas(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 1)
+        throw std::runtime_error(
+            "getaddressdeltas {\"addresses\": [\"address\",...], \"start\": n, \"end\": n}\n"
+            "\nReturns the outputs received (positive) and spent (negative) by the addresses, in height order.\n"
+            "Requires -addressindex.\n"
+
+            "\nArguments:\n"
+            "1. addresses    (object or string, required) An address, or an object (quoted on the command line) with\n"
+            "     \"addresses\"  (array, required) the addresses\n"
+            "     \"start\"      (numeric, optional, default=0) the first block height\n"
+            "     \"end\"        (numeric, optional, default=tip) the last block height\n"
+
+            "\nResult:\n"
+            "[\n"
+            "  {\n"
+            "    \"address\": \"address\",  (string) the address\n"
+            "    \"txid\": \"hash\",        (string) the receiving or spending transaction id\n"
+            "    \"index\": n,            (numeric) its output or input index\n"
+            "    \"satoshis\": n,         (numeric) the amount received or spent in satoshis\n"
+            "    \"height\": n            (numeric) the height of the block with the transaction\n"
+            "  }, ...\n"
+            "]\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("getaddressdeltas", "DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6") +
+            HelpExampleCli("getaddressdeltas", "'{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"], \"start\": 1000}'") +
+            HelpExampleRpc("getaddressdeltas", "{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"], \"start\": 1000}"));
+
+    std::vector<std::pair<CIndexAddress, std::string> > vAddresses = ParseIndexAddresses(params[0]);
+    int nStart = 0;
+    int nEnd = std::numeric_limits<int>::max();
+    if (params[0].isObject()) {
+        const UniValue& start = find_value(params[0].get_obj(), "start");
+        const UniValue& end = find_value(params[0].get_obj(), "end");
+        if (!start.isNull())
+            nStart = start.get_int();
+        if (!end.isNull())
+            nEnd = end.get_int();
+        if (nStart < 0 || nEnd < nStart)
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid start or end height");
+    }
+    EnsureAddressIndex();
+
+    UniValue result(UniValue::VARR);
+    for (const std::pair<CIndexAddress, std::string>& address : vAddresses) {
+        std::vector<std::pair<CAddressDeltaKey, CAmount> > vDeltas;
+        if (!paddressindex->ReadAddressDeltas(address.first, nStart, nEnd, vDeltas))
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Unable to read the address index");
+        for (const std::pair<CAddressDeltaKey, CAmount>& delta : vDeltas) {
+            UniValue entry(UniValue::VOBJ);
+            entry.push_back(Pair("address", address.second));
+            entry.push_back(Pair("txid", delta.first.txid.GetHex()));
+            entry.push_back(Pair("index", (int64_t)delta.first.nIndex));
+            entry.push_back(Pair("satoshis", delta.second));
+            entry.push_back(Pair("height", delta.first.nHeight));
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+UniValue getaddressbalance(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 1)
+        throw std::runtime_error(
+            "getaddressbalance {\"addresses\": [\"address\",...]}\n"
+            "\nReturns the balance of the addresses. Requires -addressindex.\n"
+
+            "\nArguments:\n"
+            "1. addresses    (object or string, required) An address, or {\"addresses\": [\"address\",...]}\n"
+            "                 (on the command line, quote the object: '{\"addresses\": [...]}')\n"
+
+            "\nResult:\n"
+            "{\n"
+            "  \"balance\": n,     (numeric) the current balance in satoshis\n"
+            "  \"received\": n     (numeric) the total received in satoshis, including change\n"
+            "}\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("getaddressbalance", "DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6") +
+            HelpExampleCli("getaddressbalance", "'{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"]}'") +
+            HelpExampleRpc("getaddressbalance", "{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"]}"));
+
+    std::vector<std::pair<CIndexAddress, std::string> > vAddresses = ParseIndexAddresses(params[0]);
+    EnsureAddressIndex();
+
+    CAmount nBalance = 0;
+    CAmount nReceived = 0;
+    for (const std::pair<CIndexAddress, std::string>& address : vAddresses) {
+        std::vector<std::pair<CAddressDeltaKey, CAmount> > vDeltas;
+        if (!paddressindex->ReadAddressDeltas(address.first, 0, std::numeric_limits<int>::max(), vDeltas))
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Unable to read the address index");
+        for (const std::pair<CAddressDeltaKey, CAmount>& delta : vDeltas) {
+            nBalance += delta.second;
+            if (delta.second > 0)
+                nReceived += delta.second;
+        }
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("balance", nBalance));
+    result.push_back(Pair("received", nReceived));
+    return result;
+}
+
+UniValue getspentinfo(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() != 1 || !params[0].isObject())
+        throw std::runtime_error(
+            "getspentinfo {\"txid\": \"hash\", \"index\": n}\n"
+            "\nReturns the transaction input that spent an output. Requires -addressindex.\n"
+
+            "\nArguments:\n"
+            "1. outpoint     (object, required) The output\n"
+            "     \"txid\"       (string, required) the transaction id\n"
+            "     \"index\"      (numeric, required) the output index\n"
+
+            "\nResult:\n"
+            "{\n"
+            "  \"txid\": \"hash\",     (string) the spending transaction id\n"
+            "  \"index\": n,         (numeric) the spending input index\n"
+            "  \"height\": n         (numeric) the height of the block with the spending transaction\n"
+            "}\n"
+
+            "\nExamples:\n" +
+            HelpExampleCli("getspentinfo", "'{\"txid\": \"0437cd7f8525ceed2324359c2d0ba26006d92d856a9c20fa0241106ee5a597c9\", \"index\": 0}'") +
+            HelpExampleRpc("getspentinfo", "{\"txid\": \"0437cd7f8525ceed2324359c2d0ba26006d92d856a9c20fa0241106ee5a597c9\", \"index\": 0}"));
+
+    const UniValue& txid = find_value(params[0].get_obj(), "txid");
+    const UniValue& index = find_value(params[0].get_obj(), "index");
+    uint256 hash = ParseHashV(txid, "txid");
+    if (!index.isNum() || index.get_int() < 0)
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid index");
+    EnsureAddressIndex();
+
+    CSpentIndexValue spent;
+    if (!paddressindex->ReadSpentIndex(CSpentIndexKey(hash, index.get_int()), spent))
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unable to get spent info");
+
+    UniValue result(UniValue::VOBJ);
+    result.push_back(Pair("txid", spent.txid.GetHex()));
+    result.push_back(Pair("index", (int64_t)spent.nInputIndex));
+    result.push_back(Pair("height", spent.nHeight));
+    return result;
+}
+
 #ifdef ENABLE_WALLET
 UniValue getstakingstatus(const UniValue& params, bool fHelp)
 {
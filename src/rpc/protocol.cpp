@@ -8,6 +8,7 @@
 #include "rpc/protocol.h"
 
 #include "random.h"
+#include "rpc/jsonstream.h"
 #include "tinyformat.h"
 #include "util.h"
 #include "utilstrencodings.h"
@@ -55,6 +56,15 @@ std::string JSONRPCReply(const UniValue& result, const UniValue& error, const Un
     return reply.write() + "\n";
 }
 
+void JSONRPCReplyStream(CJSONStreamWriter& writer, const UniValue& result, const UniValue& error, const UniValue& id)
+{
+    writer.BeginObject();
+    writer.Pair("result", error.isNull() ? result : NullUniValue);
+    writer.Pair("error", error);
+    writer.Pair("id", id);
+    writer.EndObject();
+}
+
 UniValue JSONRPCError(int code, const std::string& message)
 {
     UniValue error(UniValue::VOBJ);
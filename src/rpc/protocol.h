@@ -15,6 +15,8 @@
 
 #include <univalue.h>
 
+class CJSONStreamWriter;
+
 //! HTTP status codes
 enum HTTPStatusCode {
     HTTP_OK                    = 200,
@@ -78,6 +80,8 @@ enum RPCErrorCode {
 std::string JSONRPCRequest(const std::string& strMethod, const UniValue& params, const UniValue& id);
 UniValue JSONRPCReplyObj(const UniValue& result, const UniValue& error, const UniValue& id);
 std::string JSONRPCReply(const UniValue& result, const UniValue& error, const UniValue& id);
+/** Write the JSONRPCReplyObj document to the stream, without copying the result */
+void JSONRPCReplyStream(CJSONStreamWriter& writer, const UniValue& result, const UniValue& error, const UniValue& id);
 UniValue JSONRPCError(int code, const std::string& message);
 
 /** Get name of RPC authentication cookie file */
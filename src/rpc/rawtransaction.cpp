@@ -13,6 +13,7 @@
 #include "net.h"
 #include "primitives/transaction.h"
 #include "zpiv/deterministicmint.h"
+#include "rpc/responsecache.h"
 #include "rpc/server.h"
 #include "script/script.h"
 #include "script/script_error.h"
@@ -155,8 +156,6 @@ UniValue getrawtransaction(const UniValue& params, bool fHelp)
             + HelpExampleCli("getrawtransaction", "\"mytxid\" true \"myblockhash\"")
         );
 
-    LOCK(cs_main);
-
     bool in_active_chain = true;
     uint256 hash = ParseHashV(params[0], "parameter 1");
     CBlockIndex* blockindex = nullptr;
@@ -166,6 +165,14 @@ UniValue getrawtransaction(const UniValue& params, bool fHelp)
         fVerbose = params[1].isNum() ? (params[1].get_int() != 0) : params[1].get_bool();
     }
 
+    // Confirmed transactions looked up by txid alone are served from the response cache
+    const std::string strCacheKey = ResponseCacheKey(fVerbose ? "txjson" : "txhex", hash);
+    UniValue cached;
+    if (params[2].isNull() && blockResponseCache.Get(strCacheKey, cached))
+        return cached;
+
+    LOCK(cs_main);
+
     if (!params[2].isNull()) {
         uint256 blockhash = ParseHashV(params[2], "parameter 3");
         BlockMap::iterator it = mapBlockIndex.find(blockhash);
@@ -193,13 +200,19 @@ UniValue getrawtransaction(const UniValue& params, bool fHelp)
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, errmsg + ". Use gettransaction for wallet transactions.");
     }
 
+    UniValue result(UniValue::VOBJ);
     if (!fVerbose) {
-        return EncodeHexTx(tx);
+        result = EncodeHexTx(tx);
+    } else {
+        if (blockindex) result.push_back(Pair("in_active_chain", in_active_chain));
+        TxToJSON(tx, hash_block, result);
+    }
+    // Still under cs_main: the latest snapshot is the chain TxToJSON saw
+    if (!blockindex && !hash_block.IsNull()) {
+        BlockMap::iterator mi = mapBlockIndex.find(hash_block);
+        if (mi != mapBlockIndex.end())
+            blockResponseCache.Put(strCacheKey, mi->second, result);
     }
-
-    UniValue result(UniValue::VOBJ);
-    if (blockindex) result.push_back(Pair("in_active_chain", in_active_chain));
-    TxToJSON(tx, hash_block, result);
     return result;
 }
 
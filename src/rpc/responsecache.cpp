@@ -0,0 +1,164 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "rpc/responsecache.h"
+
+#include "main.h"
+
+CResponseCache blockResponseCache;
+
+/** Rough memory used by a UniValue tree */
+static size_t EstimateSize(const UniValue& value)
+{
+    size_t nSize = sizeof(UniValue) + value.getValStr().capacity();
+    if (value.isObject()) {
+        for (const std::string& strKey : value.getKeys())
+            nSize += sizeof(std::string) + strKey.capacity();
+    }
+    if (value.isObject() || value.isArray()) {
+        for (const UniValue& child : value.getValues())
+            nSize += EstimateSize(child);
+    }
+    return nSize;
+}
+
+/** Copy of a cached object with its confirmation count brought up to date */
+static UniValue WithConfirmations(const UniValue& value, int nConfirmations)
+{
+    if (!value.isObject() || !value.exists("confirmations"))
+        return value;
+    UniValue result(UniValue::VOBJ);
+    const std::vector<std::string>& keys = value.getKeys();
+    const std::vector<UniValue>& values = value.getValues();
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        if (keys[i] == "confirmations")
+            result.push_back(Pair(keys[i], nConfirmations));
+        else
+            result.push_back(Pair(keys[i], values[i]));
+    }
+    return result;
+}
+
+std::string ResponseCacheKey(const std::string& strKind, const uint256& hash)
+{
+    return strKind + ":" + hash.GetHex();
+}
+
+CResponseCache::CResponseCache() : nMaxBytes(0),
+                                   nBytes(0),
+                                   nHits(0),
+                                   nMisses(0),
+                                   nEvictions(0)
+{
+}
+
+void CResponseCache::SetMaxSize(size_t nMaxBytesIn)
+{
+    LOCK(cs);
+    nMaxBytes = nMaxBytesIn;
+    while (nBytes > nMaxBytes) {
+        Erase(std::prev(lruEntries.end()));
+        nEvictions++;
+    }
+}
+
+bool CResponseCache::IsEnabled() const
+{
+    LOCK(cs);
+    return nMaxBytes > 0;
+}
+
+void CResponseCache::Erase(std::list<Entry>::iterator it)
+{
+    nBytes -= it->nSize;
+    mapEntries.erase(it->strKey);
+    lruEntries.erase(it);
+}
+
+bool CResponseCache::Get(const std::string& strKey, UniValue& value)
+{
+    return Get(strKey, value, *GetChainTipSnapshot());
+}
+
+bool CResponseCache::Get(const std::string& strKey, UniValue& value, const CChainTipSnapshot& chain)
+{
+    LOCK(cs);
+    if (nMaxBytes == 0)
+        return false;
+    std::map<std::string, std::list<Entry>::iterator>::iterator mi = mapEntries.find(strKey);
+    if (mi == mapEntries.end()) {
+        nMisses++;
+        return false;
+    }
+    std::list<Entry>::iterator it = mi->second;
+    if (!chain.Contains(it->pindex) || chain.Next(it->pindex) != it->pindexNext) {
+        // Disconnected by a reorganization, or its nextblockhash changed
+        Erase(it);
+        nMisses++;
+        return false;
+    }
+    lruEntries.splice(lruEntries.begin(), lruEntries, it);
+    nHits++;
+    value = WithConfirmations(it->value, chain.Height() - it->pindex->nHeight + 1);
+    return true;
+}
+
+void CResponseCache::Put(const std::string& strKey, const CBlockIndex* pindex, const UniValue& value)
+{
+    Put(strKey, pindex, value, *GetChainTipSnapshot());
+}
+
+void CResponseCache::Put(const std::string& strKey, const CBlockIndex* pindex, const UniValue& value, const CChainTipSnapshot& chain)
+{
+    if (!pindex || !chain.Contains(pindex))
+        return;
+    if (!IsEnabled())
+        return;
+
+    size_t nSize = EstimateSize(value) + sizeof(Entry) + 2 * strKey.capacity() + 64;
+
+    LOCK(cs);
+    // Don't let a single huge block flush everything else
+    if (nSize > nMaxBytes / 8)
+        return;
+    std::map<std::string, std::list<Entry>::iterator>::iterator mi = mapEntries.find(strKey);
+    if (mi != mapEntries.end())
+        Erase(mi->second);
+    lruEntries.push_front(Entry{strKey, pindex, chain.Next(pindex), value, nSize});
+    mapEntries[strKey] = lruEntries.begin();
+    nBytes += nSize;
+    while (nBytes > nMaxBytes) {
+        Erase(std::prev(lruEntries.end()));
+        nEvictions++;
+    }
+}
+
+void CResponseCache::Clear()
+{
+    LOCK(cs);
+    lruEntries.clear();
+    mapEntries.clear();
+    nBytes = 0;
+}
+
+CResponseCache::Stats CResponseCache::GetStats() const
+{
+    LOCK(cs);
+    Stats stats;
+    stats.nEntries = lruEntries.size();
+    stats.nBytes = nBytes;
+    stats.nMaxBytes = nMaxBytes;
+    stats.nHits = nHits;
+    stats.nMisses = nMisses;
+    stats.nEvictions = nEvictions;
+    return stats;
+}
+
+void CResponseCache::ResetStats()
+{
+    LOCK(cs);
+    nHits = 0;
+    nMisses = 0;
+    nEvictions = 0;
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef PIVX_RPC_RESPONSECACHE_H
+#define PIVX_RPC_RESPONSECACHE_H
+
+#include "sync.h"
+#include "uint256.h"
+
+#include <list>
+#include <map>
+#include <stdint.h>
+#include <string>
+
+#include <univalue.h>
+
+class CBlockIndex;
+struct CChainTipSnapshot;
+
+/** Default for -rpccachesize, in MiB */
+static const int64_t DEFAULT_RPC_RESPONSE_CACHE_SIZE = 16;
+
+/**
+ * Size bounded LRU cache of rendered block and transaction query results, shared
+ * by the RPC and REST handlers.
+ *
+ * Results are only kept for blocks of the active chain. Their data can't change
+ * while the block and its successor stay the same, apart from the "confirmations"
+ * count, which is filled in again whenever an entry is served. Entries are keyed by
+ * hash, format and verbosity. An entry is dropped on the first lookup after its
+ * block was disconnected or got another successor ("nextblockhash"), so a new tip
+ * only invalidates the entries of the previous one and a reorganization the
+ * entries at or above the fork.
+ *
+ * A result must be rendered from the same chain state it is stored with: callers
+ * not holding cs_main pass the snapshot they rendered it from.
+ */
+class CResponseCache
+{
+public:
+    struct Stats {
+        size_t nEntries;
+        size_t nBytes;
+        size_t nMaxBytes;
+        uint64_t nHits;
+        uint64_t nMisses;
+        uint64_t nEvictions;
+    };
+
+    CResponseCache();
+
+    /** Set the memory limit, 0 disables the cache */
+    void SetMaxSize(size_t nMaxBytesIn);
+    bool IsEnabled() const;
+
+    /** Look up a result; fails if unknown or if its block left the active chain */
+    bool Get(const std::string& strKey, UniValue& value);
+    bool Get(const std::string& strKey, UniValue& value, const CChainTipSnapshot& chain);
+    /** Keep the result for a block; ignored unless the block is in the chain */
+    void Put(const std::string& strKey, const CBlockIndex* pindex, const UniValue& value);
+    void Put(const std::string& strKey, const CBlockIndex* pindex, const UniValue& value, const CChainTipSnapshot& chain);
+    void Clear();
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    struct Entry {
+        std::string strKey;
+        const CBlockIndex* pindex;
+        //! Successor of pindex when the result was stored, NULL for the tip
+        const CBlockIndex* pindexNext;
+        UniValue value;
+        size_t nSize;
+    };
+
+    mutable CCriticalSection cs;
+    size_t nMaxBytes;
+    size_t nBytes;
+    //! Most recently used first
+    std::list<Entry> lruEntries;
+    std::map<std::string, std::list<Entry>::iterator> mapEntries;
+    uint64_t nHits;
+    uint64_t nMisses;
+    uint64_t nEvictions;
+
+    void Erase(std::list<Entry>::iterator it);
+};
+
+/** Cache key of a result, e.g. "blockjson:<hash>" */
+std::string ResponseCacheKey(const std::string& strKind, const uint256& hash);
+
+/** Cache of getblock, getrawtransaction and REST block/tx results */
+extern CResponseCache blockResponseCache;
+
+#endif // PIVX_RPC_RESPONSECACHE_H
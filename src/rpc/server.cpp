@@ -11,10 +11,12 @@
 #include "init.h"
 #include "main.h"
 #include "random.h"
+#include "rpc/responsecache.h"
 #include "sync.h"
 #include "guiinterface.h"
 #include "util.h"
 #include "utilstrencodings.h"
+#include "validationinterface.h"
 
 #include <boost/bind.hpp>
 #include <boost/filesystem.hpp>
@@ -25,6 +27,11 @@
 #include <boost/thread.hpp>
 #include <boost/algorithm/string/case_conv.hpp> // for to_upper()
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 #include <univalue.h>
 
 
@@ -39,6 +46,94 @@ static RPCTimerInterface* timerInterface = NULL;
  * @note Can be changed to std::unique_ptr when C++11 */
 static std::map<std::string, boost::shared_ptr<RPCTimerBase> > deadlineTimers;
 
+/* Latency histogram of the RPC call statistics; the last bucket is open ended */
+static const int RPC_LATENCY_BUCKETS = 6;
+static const int64_t RPC_LATENCY_BOUNDS[RPC_LATENCY_BUCKETS - 1] = {1000, 10000, 100000, 1000000, 10000000};
+static const char* const RPC_LATENCY_NAMES[RPC_LATENCY_BUCKETS] = {"<1ms", "<10ms", "<100ms", "<1s", "<10s", ">=10s"};
+
+/** Call statistics of one RPC command, reported by getrpcstats */
+struct CRPCCommandStats
+{
+    uint64_t nCalls;
+    uint64_t nErrors;
+    int64_t nTotalMicros;
+    int64_t nMaxMicros;
+    int64_t nMainWaitMicros;
+    int64_t nWalletWaitMicros;
+    int64_t nLockWaitMicros;
+    uint64_t nReplies;
+    uint64_t nReplyBytes;
+    uint64_t vLatency[RPC_LATENCY_BUCKETS];
+
+    CRPCCommandStats() : nCalls(0), nErrors(0), nTotalMicros(0), nMaxMicros(0), nMainWaitMicros(0),
+                         nWalletWaitMicros(0), nLockWaitMicros(0), nReplies(0), nReplyBytes(0)
+    {
+        std::fill(vLatency, vLatency + RPC_LATENCY_BUCKETS, 0);
+    }
+};
+
+static CCriticalSection cs_rpcStats;
+static std::map<std::string, CRPCCommandStats> mapRPCStats;
+static int64_t nRPCStatsSince = GetTime();
+
+static void RecordRPCCall(const std::string& strMethod, int64_t nMicros, const CLockWaitTimes& waitStart, bool fError)
+{
+    CLockWaitTimes waitEnd = GetThreadLockWaitTimes();
+    int nBucket = std::upper_bound(RPC_LATENCY_BOUNDS, RPC_LATENCY_BOUNDS + RPC_LATENCY_BUCKETS - 1, nMicros) - RPC_LATENCY_BOUNDS;
+
+    LOCK(cs_rpcStats);
+    CRPCCommandStats& stats = mapRPCStats[strMethod];
+    stats.nCalls++;
+    if (fError)
+        stats.nErrors++;
+    stats.nTotalMicros += nMicros;
+    stats.nMaxMicros = std::max(stats.nMaxMicros, nMicros);
+    stats.nMainWaitMicros += waitEnd.nMain - waitStart.nMain;
+    stats.nWalletWaitMicros += waitEnd.nWallet - waitStart.nWallet;
+    stats.nLockWaitMicros += waitEnd.nTotal - waitStart.nTotal;
+    stats.vLatency[nBucket]++;
+}
+
+void RecordRPCReplySize(const std::string& strMethod, size_t nBytes)
+{
+    LOCK(cs_rpcStats);
+    std::map<std::string, CRPCCommandStats>::iterator it = mapRPCStats.find(strMethod);
+    if (it == mapRPCStats.end())
+        return;
+    it->second.nReplies++;
+    it->second.nReplyBytes += nBytes;
+}
+
+static UniValue RPCStatsToJSON(const CRPCCommandStats& stats)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("calls", stats.nCalls));
+    obj.push_back(Pair("errors", stats.nErrors));
+    obj.push_back(Pair("total_ms", stats.nTotalMicros / 1000.0));
+    obj.push_back(Pair("avg_ms", stats.nCalls ? stats.nTotalMicros / 1000.0 / stats.nCalls : 0.0));
+    obj.push_back(Pair("max_ms", stats.nMaxMicros / 1000.0));
+    obj.push_back(Pair("cs_main_wait_ms", stats.nMainWaitMicros / 1000.0));
+    obj.push_back(Pair("cs_wallet_wait_ms", stats.nWalletWaitMicros / 1000.0));
+    obj.push_back(Pair("lock_wait_ms", stats.nLockWaitMicros / 1000.0));
+    obj.push_back(Pair("avg_reply_bytes", stats.nReplies ? stats.nReplyBytes / stats.nReplies : 0));
+    UniValue latency(UniValue::VOBJ);
+    for (int i = 0; i < RPC_LATENCY_BUCKETS; i++)
+        latency.push_back(Pair(RPC_LATENCY_NAMES[i], stats.vLatency[i]));
+    obj.push_back(Pair("latency", latency));
+    return obj;
+}
+
+void LogRPCStats()
+{
+    LOCK(cs_rpcStats);
+    for (const std::pair<const std::string, CRPCCommandStats>& item : mapRPCStats) {
+        const CRPCCommandStats& stats = item.second;
+        LogPrintf("rpcstats: %s calls=%u errors=%u avg=%.3fms max=%.3fms cs_main_wait=%.3fms cs_wallet_wait=%.3fms\n",
+            item.first, stats.nCalls, stats.nErrors, stats.nCalls ? stats.nTotalMicros / 1000.0 / stats.nCalls : 0.0,
+            stats.nMaxMicros / 1000.0, stats.nMainWaitMicros / 1000.0, stats.nWalletWaitMicros / 1000.0);
+    }
+}
+
 static struct CRPCSignals
 {
     boost::signals2::signal<void ()> Started;
@@ -259,6 +354,77 @@ UniValue help(const UniValue& params, bool fHelp)
 }
 
 
+UniValue getrpcstats(const UniValue& params, bool fHelp)
+{
+    if (fHelp || params.size() > 1)
+        throw std::runtime_error(
+            "getrpcstats ( reset )\n"
+            "\nReturns call statistics of the RPC commands executed since startup or the last reset.\n"
+            "\nArguments:\n"
+            "1. reset     (boolean, optional, default=false) Clear the statistics after returning them\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"since\": ttt,                 (numeric) The time the statistics were started or reset, in seconds since epoch\n"
+            "  \"commands\": {\n"
+            "    \"command\": {\n"
+            "      \"calls\": n,               (numeric) Number of calls\n"
+            "      \"errors\": n,              (numeric) Number of calls that returned an error\n"
+            "      \"total_ms\": n,            (numeric) Total execution time in milliseconds\n"
+            "      \"avg_ms\": n,              (numeric) Average execution time in milliseconds\n"
+            "      \"max_ms\": n,              (numeric) Longest execution time in milliseconds\n"
+            "      \"cs_main_wait_ms\": n,     (numeric) Total time spent waiting for cs_main in milliseconds\n"
+            "      \"cs_wallet_wait_ms\": n,   (numeric) Total time spent waiting for cs_wallet in milliseconds\n"
+            "      \"lock_wait_ms\": n,        (numeric) Total time spent waiting for any lock in milliseconds\n"
+            "      \"avg_reply_bytes\": n,     (numeric) Average size of the replies to single (not batched) requests\n"
+            "      \"latency\": {              (json object) Number of calls by execution time\n"
+            "        \"<1ms\": n, \"<10ms\": n, \"<100ms\": n, \"<1s\": n, \"<10s\": n, \">=10s\": n\n"
+            "      }\n"
+            "    }, ...\n"
+            "  },\n"
+            "  \"response_cache\": {           (json object) Cache of block and transaction query results (see -rpccachesize)\n"
+            "    \"entries\": n,               (numeric) Number of cached results\n"
+            "    \"bytes\": n,                 (numeric) Estimated memory used by the cached results\n"
+            "    \"max_bytes\": n,             (numeric) Memory limit of the cache, 0 if disabled\n"
+            "    \"hits\": n,                  (numeric) Number of queries answered from the cache\n"
+            "    \"misses\": n,                (numeric) Number of cache lookups that failed\n"
+            "    \"hit_ratio\": x.xxx,         (numeric) Share of the lookups answered from the cache\n"
+            "    \"evictions\": n              (numeric) Number of results dropped to stay within the memory limit\n"
+            "  }\n"
+            "}\n"
+            "\nExamples:\n" +
+            HelpExampleCli("getrpcstats", "") + HelpExampleRpc("getrpcstats", "true"));
+
+    bool fReset = params.size() > 0 && params[0].get_bool();
+
+    LOCK(cs_rpcStats);
+    UniValue commands(UniValue::VOBJ);
+    for (const std::pair<const std::string, CRPCCommandStats>& item : mapRPCStats)
+        commands.push_back(Pair(item.first, RPCStatsToJSON(item.second)));
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("since", nRPCStatsSince));
+    ret.push_back(Pair("commands", commands));
+
+    CResponseCache::Stats cacheStats = blockResponseCache.GetStats();
+    UniValue cache(UniValue::VOBJ);
+    cache.push_back(Pair("entries", (uint64_t)cacheStats.nEntries));
+    cache.push_back(Pair("bytes", (uint64_t)cacheStats.nBytes));
+    cache.push_back(Pair("max_bytes", (uint64_t)cacheStats.nMaxBytes));
+    cache.push_back(Pair("hits", cacheStats.nHits));
+    cache.push_back(Pair("misses", cacheStats.nMisses));
+    const uint64_t nLookups = cacheStats.nHits + cacheStats.nMisses;
+    cache.push_back(Pair("hit_ratio", nLookups ? (double)cacheStats.nHits / nLookups : 0.0));
+    cache.push_back(Pair("evictions", cacheStats.nEvictions));
+    ret.push_back(Pair("response_cache", cache));
+
+    if (fReset) {
+        mapRPCStats.clear();
+        nRPCStatsSince = GetTime();
+        blockResponseCache.ResetStats();
+    }
+    return ret;
+}
+
 UniValue stop(const UniValue& params, bool fHelp)
 {
     // Accept the deprecated and ignored 'detach' boolean argument
@@ -282,17 +448,20 @@ static const CRPCCommand vRPCCommands[] =
         //  --------------------- ------------------------  -----------------------  ---------- ---------- ---------
         /* Overall control/query calls */
         {"control", "getinfo", &getinfo, true, false, false}, /* uses wallet if enabled */
+        {"control", "getlockcontention", &getlockcontention, true, true, false},
+        {"control", "getrpcstats", &getrpcstats, true, true, false},
         {"control", "help", &help, true, true, false},
-        {"control", "stop", &stop, true, true, false},
+        {"control", "setlockprofiling", &setlockprofiling, true, false, false},
+        {"control", "stop", &stop, true, false, false},
 
         /* P2P networking */
-        {"network", "getnetworkinfo", &getnetworkinfo, true, false, false},
-        {"network", "addnode", &addnode, true, true, false},
-        {"network", "disconnectnode", &disconnectnode, true, true, false},
+        {"network", "getnetworkinfo", &getnetworkinfo, true, true, false},
+        {"network", "addnode", &addnode, true, false, false},
+        {"network", "disconnectnode", &disconnectnode, true, false, false},
         {"network", "getaddednodeinfo", &getaddednodeinfo, true, true, false},
-        {"network", "getconnectioncount", &getconnectioncount, true, false, false},
+        {"network", "getconnectioncount", &getconnectioncount, true, true, false},
         {"network", "getnettotals", &getnettotals, true, true, false},
-        {"network", "getpeerinfo", &getpeerinfo, true, false, false},
+        {"network", "getpeerinfo", &getpeerinfo, true, true, false},
         {"network", "ping", &ping, true, false, false},
         {"network", "setban", &setban, true, false, false},
         {"network", "listbanned", &listbanned, true, false, false},
@@ -305,22 +474,23 @@ static const CRPCCommand vRPCCommands[] =
         {"blockchain", "getblockindexstats", &getblockindexstats, true, false, false},
         {"blockchain", "getmintsinblocks", &getmintsinblocks, true, false, false},
         {"blockchain", "getserials", &getserials, true, false, false},
-        {"blockchain", "getblockchaininfo", &getblockchaininfo, true, false, false},
-        {"blockchain", "getbestblockhash", &getbestblockhash, true, false, false},
-        {"blockchain", "getblockcount", &getblockcount, true, false, false},
-        {"blockchain", "getblock", &getblock, true, false, false},
-        {"blockchain", "getblockhash", &getblockhash, true, false, false},
-        {"blockchain", "getblockheader", &getblockheader, false, false, false},
-        {"blockchain", "getchaintips", &getchaintips, true, false, false},
+        {"blockchain", "getblockchaininfo", &getblockchaininfo, true, true, false},
+        {"blockchain", "getbestblockhash", &getbestblockhash, true, true, false},
+        {"blockchain", "getblockcount", &getblockcount, true, true, false},
+        {"blockchain", "getblock", &getblock, true, true, false},
+        {"blockchain", "getblockhash", &getblockhash, true, true, false},
+        {"blockchain", "getblockheader", &getblockheader, false, true, false},
+        {"blockchain", "getchaintips", &getchaintips, true, true, false},
         {"blockchain", "getchecksumblock", &getchecksumblock, false, false, false},
-        {"blockchain", "getdifficulty", &getdifficulty, true, false, false},
+        {"blockchain", "getdifficulty", &getdifficulty, true, true, false},
         {"blockchain", "getfeeinfo", &getfeeinfo, true, false, false},
         {"blockchain", "getmempoolinfo", &getmempoolinfo, true, true, false},
-        {"blockchain", "getrawmempool", &getrawmempool, true, false, false},
-        {"blockchain", "gettxout", &gettxout, true, false, false},
+        {"blockchain", "getrawmempool", &getrawmempool, true, true, false},
+        {"blockchain", "gettxout", &gettxout, true, true, false},
         {"blockchain", "gettxoutsetinfo", &gettxoutsetinfo, true, false, false},
-        {"blockchain", "invalidateblock", &invalidateblock, true, true, false},
-        {"blockchain", "reconsiderblock", &reconsiderblock, true, true, false},
+        {"blockchain", "invalidateblock", &invalidateblock, true, false, false},
+        {"blockchain", "reconsiderblock", &reconsiderblock, true, false, false},
+        {"blockchain", "savemempool", &savemempool, true, false, false},
         {"blockchain", "verifychain", &verifychain, true, false, false},
 
         /* Mining */
@@ -328,68 +498,75 @@ static const CRPCCommand vRPCCommands[] =
         {"mining", "getmininginfo", &getmininginfo, true, false, false},
         {"mining", "getnetworkhashps", &getnetworkhashps, true, false, false},
         {"mining", "prioritisetransaction", &prioritisetransaction, true, false, false},
-        {"mining", "submitblock", &submitblock, true, true, false},
-        {"mining", "reservebalance", &reservebalance, true, true, false},
+        {"mining", "submitblock", &submitblock, true, false, false},
+        {"mining", "reservebalance", &reservebalance, true, false, false},
 
 #ifdef ENABLE_WALLET
         /* Coin generation */
         {"generating", "getgenerate", &getgenerate, true, false, false},
         {"generating", "gethashespersec", &gethashespersec, true, false, false},
-        {"generating", "setgenerate", &setgenerate, true, true, false},
-        {"generating", "generate", &generate, true, true, false},
+        {"generating", "setgenerate", &setgenerate, true, false, false},
+        {"generating", "generate", &generate, true, false, false},
 #endif
 
         /* Raw transactions */
         {"rawtransactions", "createrawtransaction", &createrawtransaction, true, false, false},
-        {"rawtransactions", "decoderawtransaction", &decoderawtransaction, true, false, false},
-        {"rawtransactions", "decodescript", &decodescript, true, false, false},
-        {"rawtransactions", "getrawtransaction", &getrawtransaction, true, false, false},
+        {"rawtransactions", "decoderawtransaction", &decoderawtransaction, true, true, false},
+        {"rawtransactions", "decodescript", &decodescript, true, true, false},
+        {"rawtransactions", "getrawtransaction", &getrawtransaction, true, true, false},
         {"rawtransactions", "sendrawtransaction", &sendrawtransaction, false, false, false},
         {"rawtransactions", "signrawtransaction", &signrawtransaction, false, false, false}, /* uses wallet if enabled */
 
         /* Utility functions */
         {"util", "createmultisig", &createmultisig, true, true, false},
         {"util", "validateaddress", &validateaddress, true, false, false}, /* uses wallet if enabled */
-        {"util", "verifymessage", &verifymessage, true, false, false},
+        {"util", "verifymessage", &verifymessage, true, true, false},
         {"util", "estimatefee", &estimatefee, true, true, false},
         {"util", "estimatepriority", &estimatepriority, true, true, false},
 
+        /* Address index */
+        {"addressindex", "getaddressutxos", &getaddressutxos, true, true, false},
+        {"addressindex", "getaddressdeltas", &getaddressdeltas, true, true, false},
+        {"addressindex", "getaddressbalance", &getaddressbalance, true, true, false},
+        {"addressindex", "getspentinfo", &getspentinfo, true, true, false},
+
         /* Not shown in help */
-        {"hidden", "invalidateblock", &invalidateblock, true, true, false},
-        {"hidden", "reconsiderblock", &reconsiderblock, true, true, false},
+        {"hidden", "invalidateblock", &invalidateblock, true, false, false},
+        {"hidden", "reconsiderblock", &reconsiderblock, true, false, false},
         {"hidden", "setmocktime", &setmocktime, true, false, false},
-        { "hidden",             "waitfornewblock",        &waitfornewblock,        true,  true,  false  },
-        { "hidden",             "waitforblock",           &waitforblock,           true,  true,  false  },
-        { "hidden",             "waitforblockheight",     &waitforblockheight,     true,  true,  false  },
+        { "hidden",             "waitfornewblock",        &waitfornewblock,        true,  false, false  },
+        { "hidden",             "waitforblock",           &waitforblock,           true,  false, false  },
+        { "hidden",             "waitforblockheight",     &waitforblockheight,     true,  false, false  },
+        { "hidden",             "syncwithvalidationinterfacequeue", &syncwithvalidationinterfacequeue, true, false, false },
 
         /* PIVX features */
         {"pivx", "listmasternodes", &listmasternodes, true, true, false},
         {"pivx", "getmasternodecount", &getmasternodecount, true, true, false},
-        {"pivx", "masternodeconnect", &masternodeconnect, true, true, false},
+        {"pivx", "masternodeconnect", &masternodeconnect, true, false, false},
         {"pivx", "createmasternodebroadcast", &createmasternodebroadcast, true, true, false},
         {"pivx", "decodemasternodebroadcast", &decodemasternodebroadcast, true, true, false},
-        {"pivx", "relaymasternodebroadcast", &relaymasternodebroadcast, true, true, false},
+        {"pivx", "relaymasternodebroadcast", &relaymasternodebroadcast, true, false, false},
         {"pivx", "masternodecurrent", &masternodecurrent, true, true, false},
         {"pivx", "masternodedebug", &masternodedebug, true, true, false},
-        {"pivx", "startmasternode", &startmasternode, true, true, false},
+        {"pivx", "startmasternode", &startmasternode, true, false, false},
         {"pivx", "createmasternodekey", &createmasternodekey, true, true, false},
-        {"pivx", "getmasternodeoutputs", &getmasternodeoutputs, true, true, false},
+        {"pivx", "getmasternodeoutputs", &getmasternodeoutputs, true, false, false},
         {"pivx", "listmasternodeconf", &listmasternodeconf, true, true, false},
         {"pivx", "getmasternodestatus", &getmasternodestatus, true, true, false},
         {"pivx", "getmasternodewinners", &getmasternodewinners, true, true, false},
         {"pivx", "getmasternodescores", &getmasternodescores, true, true, false},
-        {"pivx", "preparebudget", &preparebudget, true, true, false},
-        {"pivx", "submitbudget", &submitbudget, true, true, false},
-        {"pivx", "mnbudgetvote", &mnbudgetvote, true, true, false},
+        {"pivx", "preparebudget", &preparebudget, true, false, false},
+        {"pivx", "submitbudget", &submitbudget, true, false, false},
+        {"pivx", "mnbudgetvote", &mnbudgetvote, true, false, false},
         {"pivx", "getbudgetvotes", &getbudgetvotes, true, true, false},
         {"pivx", "getnextsuperblock", &getnextsuperblock, true, true, false},
         {"pivx", "getbudgetprojection", &getbudgetprojection, true, true, false},
         {"pivx", "getbudgetinfo", &getbudgetinfo, true, true, false},
-        {"pivx", "mnbudgetrawvote", &mnbudgetrawvote, true, true, false},
-        {"pivx", "mnfinalbudget", &mnfinalbudget, true, true, false},
-        {"pivx", "checkbudgets", &checkbudgets, true, true, false},
-        {"pivx", "mnsync", &mnsync, true, true, false},
-        {"pivx", "spork", &spork, true, true, false},
+        {"pivx", "mnbudgetrawvote", &mnbudgetrawvote, true, false, false},
+        {"pivx", "mnfinalbudget", &mnfinalbudget, true, false, false},
+        {"pivx", "checkbudgets", &checkbudgets, true, false, false},
+        {"pivx", "mnsync", &mnsync, true, false, false},
+        {"pivx", "spork", &spork, true, false, false},
         {"pivx", "getpoolinfo", &getpoolinfo, true, true, false},
 
 #ifdef ENABLE_WALLET
@@ -600,12 +777,85 @@ static UniValue JSONRPCExecOne(const UniValue& req)
     return rpc_result;
 }
 
-std::string JSONRPCExecBatch(const UniValue& vReq)
+/** Whether a batch request may run concurrently with the others of its batch */
+static bool IsThreadSafeRequest(const UniValue& req)
+{
+    // Malformed requests and unknown methods only produce an error reply
+    if (!req.isObject())
+        return true;
+    const UniValue& method = find_value(req.get_obj(), "method");
+    if (!method.isStr())
+        return true;
+    const CRPCCommand* pcmd = tableRPC[method.get_str()];
+    return !pcmd || pcmd->threadSafe;
+}
+
+namespace {
+/** Requests and replies of a batch, shared by the threads executing it */
+struct CRPCBatch
+{
+    const UniValue vReq;
+    std::vector<UniValue> vReply;
+    std::atomic<size_t> nNext;
+    std::mutex cs;
+    std::condition_variable cond;
+    size_t nDone;
+
+    CRPCBatch(const UniValue& vReqIn) : vReq(vReqIn), vReply(vReqIn.size()), nNext(0), nDone(0) {}
+
+    /** Execute pending requests until there are none left */
+    void Run()
+    {
+        size_t i;
+        while ((i = nNext++) < vReq.size()) {
+            UniValue reply;
+            try {
+                reply = JSONRPCExecOne(vReq[i]);
+            } catch (...) {
+                reply = JSONRPCReplyObj(NullUniValue, JSONRPCError(RPC_MISC_ERROR, "Unknown error"), find_value(vReq[i], "id"));
+            }
+            std::lock_guard<std::mutex> lock(cs);
+            vReply[i] = reply;
+            if (++nDone == vReq.size())
+                cond.notify_all();
+        }
+    }
+};
+}
+
+std::string JSONRPCExecBatch(const UniValue& vReq, const RPCTaskQueueFn& fnQueue, int nMaxThreads)
 {
     UniValue ret(UniValue::VARR);
-    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
-        ret.push_back(JSONRPCExecOne(vReq[reqIdx]));
 
+    bool fParallel = !fnQueue.empty() && nMaxThreads > 1 && vReq.size() > 1;
+    for (unsigned int reqIdx = 0; fParallel && reqIdx < vReq.size(); reqIdx++)
+        fParallel = IsThreadSafeRequest(vReq[reqIdx]);
+
+    if (!fParallel) {
+        for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
+            ret.push_back(JSONRPCExecOne(vReq[reqIdx]));
+        return ret.write() + "\n";
+    }
+
+    // Helpers that only get to run after the batch is done find nothing left
+    // to do, so the batch must outlive this call
+    std::shared_ptr<CRPCBatch> batch = std::make_shared<CRPCBatch>(vReq);
+    size_t nHelpers = std::min((size_t)nMaxThreads, vReq.size()) - 1;
+    for (size_t i = 0; i < nHelpers; i++) {
+        if (!fnQueue([batch]() { batch->Run(); }))
+            break;
+    }
+
+    // Take part in the work, then wait for the requests still running elsewhere
+    batch->Run();
+    {
+        std::unique_lock<std::mutex> lock(batch->cs);
+        while (batch->nDone < vReq.size())
+            batch->cond.wait(lock);
+    }
+
+    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
+        ret.push_back(batch->vReply[reqIdx]);
     return ret.write() + "\n";
 }
 
@@ -618,14 +868,26 @@ UniValue CRPCTable::execute(const std::string &strMethod, const UniValue &params
 
     g_rpcSignals.PreCommand(*pcmd);
 
+    int64_t nStart = GetTimeMicros();
+    CLockWaitTimes waitStart = GetThreadLockWaitTimes();
+    UniValue result;
     try {
+        // Wallet commands see the transactions and blocks validated before the call
+        if (pcmd->reqWallet)
+            SyncWithValidationInterfaceQueue();
         // Execute
-        return pcmd->actor(params, false);
+        result = pcmd->actor(params, false);
     } catch (const std::exception& e) {
+        RecordRPCCall(strMethod, GetTimeMicros() - nStart, waitStart, true);
         throw JSONRPCError(RPC_MISC_ERROR, e.what());
+    } catch (...) {
+        RecordRPCCall(strMethod, GetTimeMicros() - nStart, waitStart, true);
+        throw;
     }
+    RecordRPCCall(strMethod, GetTimeMicros() - nStart, waitStart, false);
 
     g_rpcSignals.PostCommand(*pcmd);
+    return result;
 }
 
 std::vector<std::string> CRPCTable::listCommands() const
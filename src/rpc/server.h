@@ -12,6 +12,7 @@
 #include "rpc/protocol.h"
 #include "uint256.h"
 
+#include <functional>
 #include <list>
 #include <map>
 #include <stdint.h>
@@ -124,6 +125,7 @@ public:
     std::string name;
     rpcfn_type actor;
     bool okSafeMode;
+    //! May run concurrently with the other requests of a JSON-RPC batch
     bool threadSafe;
     bool reqWallet;
 };
@@ -159,6 +161,11 @@ public:
 
 extern const CRPCTable tableRPC;
 
+/** Add the size of a reply to the call statistics of strMethod */
+void RecordRPCReplySize(const std::string& strMethod, size_t nBytes);
+/** Write the call statistics of all RPC commands to the debug log */
+void LogRPCStats();
+
 /**
  * Utilities: convert hex-encoded Values
  * (throws error if not hex).
@@ -303,6 +310,7 @@ extern UniValue getbestblockhash(const UniValue& params, bool fHelp);
 extern UniValue waitfornewblock(const UniValue& params, bool fHelp);
 extern UniValue waitforblock(const UniValue& params, bool fHelp);
 extern UniValue waitforblockheight(const UniValue& params, bool fHelp);
+extern UniValue syncwithvalidationinterfacequeue(const UniValue& params, bool fHelp);
 extern UniValue getdifficulty(const UniValue& params, bool fHelp);
 extern UniValue settxfee(const UniValue& params, bool fHelp);
 extern UniValue getmempoolinfo(const UniValue& params, bool fHelp);
@@ -317,6 +325,7 @@ extern UniValue verifychain(const UniValue& params, bool fHelp);
 extern UniValue getchaintips(const UniValue& params, bool fHelp);
 extern UniValue invalidateblock(const UniValue& params, bool fHelp);
 extern UniValue reconsiderblock(const UniValue& params, bool fHelp);
+extern UniValue savemempool(const UniValue& params, bool fHelp);
 extern UniValue getaccumulatorvalues(const UniValue& params, bool fHelp);
 extern UniValue getaccumulatorwitness(const UniValue& params, bool fHelp);
 extern UniValue getblockindexstats(const UniValue& params, bool fHelp);
@@ -361,11 +370,31 @@ extern UniValue createmultisig(const UniValue& params, bool fHelp);
 extern UniValue verifymessage(const UniValue& params, bool fHelp);
 extern UniValue setmocktime(const UniValue& params, bool fHelp);
 extern UniValue getstakingstatus(const UniValue& params, bool fHelp);
+extern UniValue getlockcontention(const UniValue& params, bool fHelp);
+extern UniValue setlockprofiling(const UniValue& params, bool fHelp);
+extern UniValue getaddressutxos(const UniValue& params, bool fHelp);
+extern UniValue getaddressdeltas(const UniValue& params, bool fHelp);
+extern UniValue getaddressbalance(const UniValue& params, bool fHelp);
+extern UniValue getspentinfo(const UniValue& params, bool fHelp);
 
 bool StartRPC();
 void InterruptRPC();
 void StopRPC();
-std::string JSONRPCExecBatch(const UniValue& vReq);
+
+/** Default for -rpcbatchthreads; at most -rpcthreads minus one are used */
+static const int DEFAULT_RPC_BATCH_THREADS = 3;
+
+/** Queues a task on another thread, returns false if it could not be queued */
+typedef boost::function<bool(const std::function<void()>&)> RPCTaskQueueFn;
+
+/**
+ * Execute a batch of JSON-RPC requests and return the serialized replies, in
+ * the order of the requests. If every request is for a threadSafe command and
+ * fnQueue is set, up to nMaxThreads requests run at the same time: the calling
+ * thread and the tasks passed to fnQueue each take the next pending request
+ * until none are left. Otherwise the requests are executed one after another.
+ */
+std::string JSONRPCExecBatch(const UniValue& vReq, const RPCTaskQueueFn& fnQueue = RPCTaskQueueFn(), int nMaxThreads = 1);
 void RPCNotifyBlockChange(const uint256 nHeight);
 
 #endif // BITCOIN_RPCSERVER_H
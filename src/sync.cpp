@@ -5,13 +5,199 @@
 
 #include "sync.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 
 #include "util.h"
 #include "utilstrencodings.h"
 
 #include <stdio.h>
+#include <string.h>
+
+#ifdef HAVE_THREAD_LOCAL
+static thread_local CLockWaitTimes g_lockwaittimes;
+
+enum LockWaitCategory {
+    LOCK_WAIT_OTHER,
+    LOCK_WAIT_MAIN,
+    LOCK_WAIT_WALLET
+};
+
+//! Category of each lock name seen by the thread, keyed on the #cs literal of its LOCK site
+static thread_local std::unordered_map<const char*, LockWaitCategory> g_lockwaitcategories;
+
+static LockWaitCategory GetLockWaitCategory(const char* pszName)
+{
+    std::unordered_map<const char*, LockWaitCategory>::const_iterator it = g_lockwaitcategories.find(pszName);
+    if (it != g_lockwaitcategories.end())
+        return it->second;
+    LockWaitCategory category = LOCK_WAIT_OTHER;
+    if (strstr(pszName, "cs_main") != NULL)
+        category = LOCK_WAIT_MAIN;
+    else if (strstr(pszName, "cs_wallet") != NULL)
+        category = LOCK_WAIT_WALLET;
+    g_lockwaitcategories.emplace(pszName, category);
+    return category;
+}
+#endif
+
+void RecordLockWait(const char* pszName, int64_t nMicros)
+{
+#ifdef HAVE_THREAD_LOCAL
+    g_lockwaittimes.nTotal += nMicros;
+    switch (GetLockWaitCategory(pszName)) {
+    case LOCK_WAIT_MAIN:
+        g_lockwaittimes.nMain += nMicros;
+        break;
+    case LOCK_WAIT_WALLET:
+        g_lockwaittimes.nWallet += nMicros;
+        break;
+    case LOCK_WAIT_OTHER:
+        break;
+    }
+#endif
+}
+
+CLockWaitTimes GetThreadLockWaitTimes()
+{
+#ifdef HAVE_THREAD_LOCAL
+    return g_lockwaittimes;
+#else
+    return CLockWaitTimes();
+#endif
+}
+
+std::atomic<bool> g_fLockProfiling(false);
+
+namespace {
+
+/** Counters of one lock site, claimed lock free on its first acquisition */
+struct LockSiteSlot {
+    //! 0: free, 1: being claimed, 2: in use
+    std::atomic<int> nState;
+    const char* pszName;
+    const char* pszFile;
+    int nLine;
+    std::atomic<uint64_t> nAcquisitions;
+    std::atomic<uint64_t> nContentions;
+    std::atomic<uint64_t> nWaitMicros;
+    std::atomic<uint64_t> nMaxWaitMicros;
+    std::atomic<uint64_t> nHoldMicros;
+    std::atomic<uint64_t> nMaxHoldMicros;
+};
+
+//! Must be a power of two. The same site may take one slot per translation unit,
+//! as __FILE__ isn't guaranteed to be the same pointer in all of them.
+static const int LOCK_PROFILE_SLOTS = 8192;
+static LockSiteSlot g_locksites[LOCK_PROFILE_SLOTS];
+
+void UpdateMax(std::atomic<uint64_t>& nMax, uint64_t nValue)
+{
+    uint64_t nCurrent = nMax.load(std::memory_order_relaxed);
+    while (nValue > nCurrent && !nMax.compare_exchange_weak(nCurrent, nValue, std::memory_order_relaxed)) {
+    }
+}
+
+int FindLockSite(const char* pszName, const char* pszFile, int nLine)
+{
+    size_t nHash = std::hash<const void*>()(pszFile) ^ ((size_t)nLine * 0x9e3779b1);
+    for (int nProbe = 0; nProbe < LOCK_PROFILE_SLOTS; nProbe++) {
+        int nSlot = (nHash + nProbe) & (LOCK_PROFILE_SLOTS - 1);
+        LockSiteSlot& slot = g_locksites[nSlot];
+        int nState = slot.nState.load(std::memory_order_acquire);
+        if (nState == 0) {
+            if (slot.nState.compare_exchange_strong(nState, 1, std::memory_order_acquire)) {
+                slot.pszName = pszName;
+                slot.pszFile = pszFile;
+                slot.nLine = nLine;
+                slot.nState.store(2, std::memory_order_release);
+                return nSlot;
+            }
+        }
+        // Another thread is claiming this slot, wait to see which site it is for
+        while (nState == 1)
+            nState = slot.nState.load(std::memory_order_acquire);
+        if (slot.pszFile == pszFile && slot.nLine == nLine)
+            return nSlot;
+    }
+    return -1;
+}
+
+} // namespace
+
+void EnableLockProfiling(bool fEnable)
+{
+    g_fLockProfiling.store(fEnable);
+}
+
+int ProfileLockAcquired(const char* pszName, const char* pszFile, int nLine, int64_t nWaitMicros, bool fContended)
+{
+    int nSlot = FindLockSite(pszName, pszFile, nLine);
+    if (nSlot < 0)
+        return -1;
+    LockSiteSlot& slot = g_locksites[nSlot];
+    slot.nAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (fContended) {
+        slot.nContentions.fetch_add(1, std::memory_order_relaxed);
+        slot.nWaitMicros.fetch_add(nWaitMicros, std::memory_order_relaxed);
+        UpdateMax(slot.nMaxWaitMicros, nWaitMicros);
+    }
+    return nSlot;
+}
+
+void ProfileLockReleased(int nSlot, int64_t nHoldMicros)
+{
+    LockSiteSlot& slot = g_locksites[nSlot];
+    slot.nHoldMicros.fetch_add(nHoldMicros, std::memory_order_relaxed);
+    UpdateMax(slot.nMaxHoldMicros, nHoldMicros);
+}
+
+std::vector<CLockSiteStats> GetLockProfile()
+{
+    // Merge the slots a site got in different translation units
+    std::map<std::pair<std::string, int>, CLockSiteStats> mapSites;
+    for (const LockSiteSlot& slot : g_locksites) {
+        if (slot.nState.load(std::memory_order_acquire) != 2)
+            continue;
+        CLockSiteStats& stats = mapSites[std::make_pair(std::string(slot.pszFile), slot.nLine)];
+        if (stats.strFile.empty()) {
+            stats = CLockSiteStats();
+            stats.strName = slot.pszName;
+            stats.strFile = slot.pszFile;
+            stats.nLine = slot.nLine;
+        }
+        stats.nAcquisitions += slot.nAcquisitions.load(std::memory_order_relaxed);
+        stats.nContentions += slot.nContentions.load(std::memory_order_relaxed);
+        stats.nWaitMicros += slot.nWaitMicros.load(std::memory_order_relaxed);
+        stats.nMaxWaitMicros = std::max<uint64_t>(stats.nMaxWaitMicros, slot.nMaxWaitMicros.load(std::memory_order_relaxed));
+        stats.nHoldMicros += slot.nHoldMicros.load(std::memory_order_relaxed);
+        stats.nMaxHoldMicros = std::max<uint64_t>(stats.nMaxHoldMicros, slot.nMaxHoldMicros.load(std::memory_order_relaxed));
+    }
+
+    std::vector<CLockSiteStats> vSites;
+    for (const auto& item : mapSites)
+        vSites.push_back(item.second);
+    std::sort(vSites.begin(), vSites.end(), [](const CLockSiteStats& a, const CLockSiteStats& b) {
+        return a.nWaitMicros > b.nWaitMicros || (a.nWaitMicros == b.nWaitMicros && a.nAcquisitions > b.nAcquisitions);
+    });
+    return vSites;
+}
+
+void ResetLockProfile()
+{
+    // Sites keep their slots, only the counters are cleared
+    for (LockSiteSlot& slot : g_locksites) {
+        slot.nAcquisitions = 0;
+        slot.nContentions = 0;
+        slot.nWaitMicros = 0;
+        slot.nMaxWaitMicros = 0;
+        slot.nHoldMicros = 0;
+        slot.nMaxHoldMicros = 0;
+    }
+}
 
 #ifdef DEBUG_LOCKCONTENTION
 #if !defined(HAVE_THREAD_LOCAL)
@@ -9,9 +9,14 @@
 
 #include "threadsafety.h"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <stdint.h>
+#include <string>
 #include <thread>
 #include <mutex>
+#include <vector>
 
 
 /////////////////////////////////////////////////
@@ -110,31 +115,89 @@ typedef std::unique_lock<std::mutex> WaitableLock;
 void PrintLockContention(const char* pszName, const char* pszFile, int nLine);
 #endif
 
+/** Time a thread spent blocked on contended critical sections, in microseconds */
+struct CLockWaitTimes {
+    int64_t nMain;
+    int64_t nWallet;
+    int64_t nTotal;
+
+    CLockWaitTimes() : nMain(0), nWallet(0), nTotal(0) {}
+};
+
+/** Add a wait for the lock named pszName to the calling thread's totals */
+void RecordLockWait(const char* pszName, int64_t nMicros);
+/** Totals of the calling thread since it started; zero when thread_local is not supported */
+CLockWaitTimes GetThreadLockWaitTimes();
+
+/**
+ * Lock profiler: while enabled, every CCriticalBlock acquisition is counted against the
+ * file:line of its LOCK, with the time spent waiting for and holding the lock.
+ */
+extern std::atomic<bool> g_fLockProfiling;
+
+/** Aggregated statistics of one lock site, as returned by GetLockProfile */
+struct CLockSiteStats {
+    std::string strName;
+    std::string strFile;
+    int nLine;
+    uint64_t nAcquisitions;
+    uint64_t nContentions;
+    uint64_t nWaitMicros;
+    uint64_t nMaxWaitMicros;
+    uint64_t nHoldMicros;
+    uint64_t nMaxHoldMicros;
+};
+
+void EnableLockProfiling(bool fEnable);
+/** Count an acquisition; returns the slot of the site to pass to ProfileLockReleased, or -1 */
+int ProfileLockAcquired(const char* pszName, const char* pszFile, int nLine, int64_t nWaitMicros, bool fContended);
+void ProfileLockReleased(int nSlot, int64_t nHoldMicros);
+/** Statistics of all the sites seen so far, sorted by total wait time */
+std::vector<CLockSiteStats> GetLockProfile();
+void ResetLockProfile();
+
 /** Wrapper around std::unique_lock<CCriticalSection> */
 class SCOPED_LOCKABLE CCriticalBlock
 {
 private:
     std::unique_lock<CCriticalSection> lock;
 
+    //! Lock profiler site slot and acquisition time; -1 when this acquisition isn't profiled
+    int nProfileSlot = -1;
+    std::chrono::steady_clock::time_point lockedAt;
+
     void Enter(const char* pszName, const char* pszFile, int nLine)
     {
         EnterCritical(pszName, pszFile, nLine, (void*)(lock.mutex()));
-#ifdef DEBUG_LOCKCONTENTION
+        const bool fProfile = g_fLockProfiling.load(std::memory_order_relaxed);
         if (!lock.try_lock()) {
+#ifdef DEBUG_LOCKCONTENTION
             PrintLockContention(pszName, pszFile, nLine);
 #endif
+            // Only the contended path is timed
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
             lock.lock();
-#ifdef DEBUG_LOCKCONTENTION
+            lockedAt = std::chrono::steady_clock::now();
+            int64_t nWaitMicros = std::chrono::duration_cast<std::chrono::microseconds>(lockedAt - start).count();
+            RecordLockWait(pszName, nWaitMicros);
+            if (fProfile)
+                nProfileSlot = ProfileLockAcquired(pszName, pszFile, nLine, nWaitMicros, true);
+        } else if (fProfile) {
+            nProfileSlot = ProfileLockAcquired(pszName, pszFile, nLine, 0, false);
+            lockedAt = std::chrono::steady_clock::now();
         }
-#endif
     }
 
     bool TryEnter(const char* pszName, const char* pszFile, int nLine)
     {
         EnterCritical(pszName, pszFile, nLine, (void*)(lock.mutex()), true);
         lock.try_lock();
-        if (!lock.owns_lock())
+        if (!lock.owns_lock()) {
             LeaveCritical();
+        } else if (g_fLockProfiling.load(std::memory_order_relaxed)) {
+            nProfileSlot = ProfileLockAcquired(pszName, pszFile, nLine, 0, false);
+            lockedAt = std::chrono::steady_clock::now();
+        }
         return lock.owns_lock();
     }
 
@@ -160,8 +223,11 @@ public:
 
     ~CCriticalBlock() UNLOCK_FUNCTION()
     {
-        if (lock.owns_lock())
+        if (lock.owns_lock()) {
+            if (nProfileSlot >= 0)
+                ProfileLockReleased(nProfileSlot, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lockedAt).count());
             LeaveCritical();
+        }
     }
 
     operator bool()
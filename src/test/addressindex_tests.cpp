@@ -0,0 +1,158 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "addressindex.h"
+#include "chain.h"
+#include "primitives/block.h"
+#include "undo.h"
+#include "test/test_pivx.h"
+
+#include <limits>
+#include <set>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(addressindex_tests, TestingSetup)
+
+namespace {
+CMutableTransaction SpendTx(const std::vector<COutPoint>& vPrevouts, const std::vector<CTxOut>& vOutputs)
+{
+    CMutableTransaction tx;
+    for (const COutPoint& prevout : vPrevouts)
+        tx.vin.push_back(CTxIn(prevout));
+    tx.vout = vOutputs;
+    return tx;
+}
+
+std::set<std::pair<uint256, uint32_t> > Unspent(CAddressIndexDB& db, const CIndexAddress& address)
+{
+    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > vUnspent;
+    BOOST_CHECK(db.ReadAddressUnspent(address, vUnspent));
+    std::set<std::pair<uint256, uint32_t> > setUnspent;
+    for (const std::pair<CAddressUnspentKey, CAddressUnspentValue>& unspent : vUnspent)
+        setUnspent.insert(std::make_pair(unspent.first.txid, unspent.first.nIndex));
+    return setUnspent;
+}
+
+CAmount Balance(CAddressIndexDB& db, const CIndexAddress& address, int nStart, unsigned int* pnDeltas)
+{
+    std::vector<std::pair<CAddressDeltaKey, CAmount> > vDeltas;
+    BOOST_CHECK(db.ReadAddressDeltas(address, nStart, std::numeric_limits<int>::max(), vDeltas));
+    CAmount nBalance = 0;
+    int nLastHeight = 0;
+    for (const std::pair<CAddressDeltaKey, CAmount>& delta : vDeltas) {
+        BOOST_CHECK(delta.first.address == address);
+        BOOST_CHECK(delta.first.nHeight >= nLastHeight);
+        nLastHeight = delta.first.nHeight;
+        nBalance += delta.second;
+    }
+    *pnDeltas = vDeltas.size();
+    return nBalance;
+}
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(addressindex_connect_disconnect)
+{
+    CAddressIndexDB db(1 << 20, true);
+
+    CKeyID keyA(uint160(1));
+    CKeyID keyB(uint160(2));
+    CScript scriptMultisig = CScript() << OP_1 << OP_1 << OP_CHECKMULTISIG;
+    CIndexAddress addressA = CIndexAddress::FromDestination(keyA);
+    CIndexAddress addressB = CIndexAddress::FromDestination(keyB);
+    CIndexAddress addressS = CIndexAddress::FromDestination(CScriptID(scriptMultisig));
+    BOOST_CHECK(CIndexAddress::FromScript(GetScriptForDestination(keyA)) == addressA);
+    BOOST_CHECK(CIndexAddress::FromScript(CScript() << OP_RETURN).IsNull());
+
+    uint256 hash0(10), hash1(11), hash2(12);
+    CBlockIndex index0, index1, index2;
+    index0.phashBlock = &hash0;
+    index1.phashBlock = &hash1;
+    index1.pprev = &index0;
+    index1.nHeight = 1;
+    index2.phashBlock = &hash2;
+    index2.pprev = &index1;
+    index2.nHeight = 2;
+
+    // Nothing of the genesis block is indexed
+    BOOST_CHECK(db.ConnectBlock(CBlock(), CBlockUndo(), &index0));
+
+    // Block 1: a coinbase paying A and B
+    CMutableTransaction txA = SpendTx(std::vector<COutPoint>(1), {CTxOut(50, GetScriptForDestination(keyA)), CTxOut(10, GetScriptForDestination(keyB))});
+    CBlock block1;
+    block1.vtx.push_back(txA);
+    BOOST_CHECK(db.ConnectBlock(block1, CBlockUndo(), &index1));
+
+    // Block 2: D spends A's output, E spends D's change to A in the same block
+    CMutableTransaction txC = SpendTx(std::vector<COutPoint>(1), {CTxOut(1, GetScriptForDestination(keyB))});
+    CMutableTransaction txD = SpendTx({COutPoint(txA.GetHash(), 0)}, {CTxOut(30, GetScriptForDestination(keyB)), CTxOut(20, GetScriptForDestination(keyA))});
+    CMutableTransaction txE = SpendTx({COutPoint(txD.GetHash(), 1)}, {CTxOut(20, GetScriptForDestination(CScriptID(scriptMultisig)))});
+    CBlock block2;
+    block2.vtx.push_back(txC);
+    block2.vtx.push_back(txD);
+    block2.vtx.push_back(txE);
+    CBlockUndo undo2;
+    undo2.vtxundo.resize(2);
+    undo2.vtxundo[0].vprevout.push_back(CTxInUndo(txA.vout[0], true));
+    undo2.vtxundo[1].vprevout.push_back(CTxInUndo(txD.vout[1]));
+    BOOST_CHECK(db.ConnectBlock(block2, undo2, &index2));
+
+    uint256 hashBest;
+    BOOST_CHECK(db.ReadBestBlock(hashBest));
+    BOOST_CHECK(hashBest == hash2);
+
+    unsigned int nDeltas;
+    BOOST_CHECK_EQUAL(Balance(db, addressA, 0, &nDeltas), 0);
+    BOOST_CHECK_EQUAL(nDeltas, 4U);
+    BOOST_CHECK_EQUAL(Balance(db, addressA, 2, &nDeltas), -50);
+    BOOST_CHECK_EQUAL(nDeltas, 3U);
+    BOOST_CHECK_EQUAL(Balance(db, addressB, 0, &nDeltas), 41);
+    BOOST_CHECK_EQUAL(Balance(db, addressS, 0, &nDeltas), 20);
+
+    BOOST_CHECK(Unspent(db, addressA).empty());
+    std::set<std::pair<uint256, uint32_t> > setB = Unspent(db, addressB);
+    BOOST_CHECK_EQUAL(setB.size(), 3U);
+    BOOST_CHECK(setB.count(std::make_pair(txA.GetHash(), 1U)));
+    BOOST_CHECK(setB.count(std::make_pair(txC.GetHash(), 0U)));
+    BOOST_CHECK(setB.count(std::make_pair(txD.GetHash(), 0U)));
+    BOOST_CHECK_EQUAL(Unspent(db, addressS).size(), 1U);
+
+    CSpentIndexValue spent;
+    BOOST_CHECK(db.ReadSpentIndex(CSpentIndexKey(txA.GetHash(), 0), spent));
+    BOOST_CHECK(spent.txid == txD.GetHash());
+    BOOST_CHECK_EQUAL(spent.nInputIndex, 0U);
+    BOOST_CHECK_EQUAL(spent.nHeight, 2);
+    BOOST_CHECK_EQUAL(spent.nPrevHeight, 1);
+    BOOST_CHECK(spent.address == addressA);
+    BOOST_CHECK(db.ReadSpentIndex(CSpentIndexKey(txD.GetHash(), 1), spent));
+    BOOST_CHECK(spent.txid == txE.GetHash());
+    BOOST_CHECK_EQUAL(spent.nPrevHeight, 2);
+    BOOST_CHECK(!db.ReadSpentIndex(CSpentIndexKey(txA.GetHash(), 1), spent));
+
+    // Disconnecting block 2 restores the index as it was after block 1
+    BOOST_CHECK(db.DisconnectBlock(block2, undo2, &index2));
+    BOOST_CHECK(db.ReadBestBlock(hashBest));
+    BOOST_CHECK(hashBest == hash1);
+
+    BOOST_CHECK_EQUAL(Balance(db, addressA, 0, &nDeltas), 50);
+    BOOST_CHECK_EQUAL(nDeltas, 1U);
+    BOOST_CHECK_EQUAL(Balance(db, addressB, 0, &nDeltas), 10);
+    BOOST_CHECK_EQUAL(Balance(db, addressS, 0, &nDeltas), 0);
+    BOOST_CHECK_EQUAL(nDeltas, 0U);
+
+    std::vector<std::pair<CAddressUnspentKey, CAddressUnspentValue> > vUnspent;
+    BOOST_CHECK(db.ReadAddressUnspent(addressA, vUnspent));
+    BOOST_CHECK_EQUAL(vUnspent.size(), 1U);
+    BOOST_CHECK(vUnspent[0].first.txid == txA.GetHash());
+    BOOST_CHECK_EQUAL(vUnspent[0].second.nValue, 50);
+    BOOST_CHECK_EQUAL(vUnspent[0].second.nHeight, 1);
+    BOOST_CHECK(vUnspent[0].second.script == GetScriptForDestination(keyA));
+    BOOST_CHECK_EQUAL(Unspent(db, addressB).size(), 1U);
+    BOOST_CHECK(Unspent(db, addressS).empty());
+    BOOST_CHECK(!db.ReadSpentIndex(CSpentIndexKey(txA.GetHash(), 0), spent));
+    BOOST_CHECK(!db.ReadSpentIndex(CSpentIndexKey(txD.GetHash(), 1), spent));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,4 +30,45 @@ BOOST_AUTO_TEST_CASE(budget_value)
     CheckBudgetValue(nHeightTest, "mainnet", 43200*COIN);
 }
 
+BOOST_AUTO_TEST_CASE(budget_vote_tally)
+{
+    CBudgetProposal proposal("test", "https://forum.pivx.org", 0, 43200, CScript(), 10 * COIN, 0);
+    std::string strError;
+    std::vector<CBudgetVote> vVotes;
+    for (int i = 0; i < 9; i++) {
+        CBudgetVote vote(CTxIn(COutPoint(InsecureRand256(), 0)), proposal.GetHash(), i % 3 == 0 ? VOTE_YES : (i % 3 == 1 ? VOTE_NO : VOTE_ABSTAIN));
+        vote.nTime = GetTime() - BUDGET_VOTE_UPDATE_MIN - 1;
+        BOOST_CHECK(proposal.AddOrUpdateVote(vote, strError));
+        vVotes.push_back(vote);
+    }
+    BOOST_CHECK_EQUAL(proposal.GetYeas(), 3);
+    BOOST_CHECK_EQUAL(proposal.GetNays(), 3);
+    BOOST_CHECK_EQUAL(proposal.GetAbstains(), 3);
+
+    // a changed vote moves between the tallies
+    CBudgetVote& vote = vVotes[1];
+    vote.nVote = VOTE_YES;
+    vote.nTime = GetTime();
+    BOOST_CHECK(proposal.AddOrUpdateVote(vote, strError));
+    BOOST_CHECK_EQUAL(proposal.GetYeas(), 4);
+    BOOST_CHECK_EQUAL(proposal.GetNays(), 2);
+
+    // the tallies survive a copy and a serialization roundtrip
+    CBudgetProposal proposalCopy(proposal);
+    BOOST_CHECK_EQUAL(proposalCopy.GetYeas(), 4);
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << proposal;
+    CBudgetProposal proposalRead;
+    ss >> proposalRead;
+    BOOST_CHECK_EQUAL(proposalRead.GetYeas(), 4);
+    BOOST_CHECK_EQUAL(proposalRead.GetNays(), 2);
+    BOOST_CHECK_EQUAL(proposalRead.GetAbstains(), 3);
+
+    // none of the voters is a known masternode
+    proposal.CleanAndRemove(false);
+    BOOST_CHECK_EQUAL(proposal.GetYeas(), 0);
+    BOOST_CHECK_EQUAL(proposal.GetNays(), 0);
+    BOOST_CHECK_EQUAL(proposal.GetAbstains(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
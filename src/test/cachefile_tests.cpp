@@ -0,0 +1,137 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "cachefile.h"
+#include "test_pivx.h"
+
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(cachefile_tests, TestingSetup)
+
+static std::map<uint256, int> RandomMap(int nEntries)
+{
+    std::map<uint256, int> map;
+    for (int i = 0; i < nEntries; i++)
+        map[InsecureRand256()] = i;
+    return map;
+}
+
+BOOST_AUTO_TEST_CASE(cachefile_roundtrip)
+{
+    boost::filesystem::path path = pathTemp / "test_cache.dat";
+    std::map<uint256, int> mapIn = RandomMap(200);
+    std::vector<int> vIn;
+    for (int i = 0; i < 100; i++)
+        vIn.push_back(i);
+    {
+        CCacheFile file(path, "TestCache");
+        file.AddChunk("count", (int)mapIn.size());
+        file.AddMapChunks("map", mapIn);
+        file.AddVectorChunks("vector", vIn, [](int n) { return n; });
+        BOOST_CHECK(file.Write());
+    }
+
+    CCacheFile file(path, "TestCache");
+    BOOST_CHECK(file.Read() == CCacheFile::Ok);
+    int nCount = 0;
+    std::map<uint256, int> mapOut;
+    BOOST_CHECK(file.GetChunk("count", nCount));
+    BOOST_CHECK(file.GetMapChunks("map", mapOut));
+    BOOST_CHECK_EQUAL(nCount, 200);
+    BOOST_CHECK(mapIn == mapOut);
+    // the elements come back grouped by bucket
+    std::vector<int> vOut;
+    BOOST_CHECK(file.GetVectorChunks("vector", vOut));
+    std::sort(vOut.begin(), vOut.end());
+    BOOST_CHECK(vIn == vOut);
+
+    // a different magic message is rejected
+    CCacheFile fileOther(path, "OtherCache");
+    BOOST_CHECK(fileOther.Read() == CCacheFile::IncorrectMagicMessage);
+}
+
+BOOST_AUTO_TEST_CASE(cachefile_incremental)
+{
+    boost::filesystem::path path = pathTemp / "test_cache_incremental.dat";
+    std::map<uint256, int> map = RandomMap(2000);
+    {
+        CCacheFile file(path, "TestCache");
+        file.AddMapChunks("map", map);
+        BOOST_CHECK(file.Write());
+    }
+    uint64_t nSize = boost::filesystem::file_size(path);
+
+    // nothing changed: nothing is written
+    {
+        CCacheFile file(path, "TestCache");
+        file.AddMapChunks("map", map);
+        BOOST_CHECK(file.Write());
+        BOOST_CHECK_EQUAL(boost::filesystem::file_size(path), nSize);
+    }
+
+    // a single entry changed: only its chunk is appended
+    map.begin()->second = -1;
+    {
+        CCacheFile file(path, "TestCache");
+        file.AddMapChunks("map", map);
+        BOOST_CHECK(file.Write());
+        uint64_t nNewSize = boost::filesystem::file_size(path);
+        BOOST_CHECK(nNewSize > nSize);
+        BOOST_CHECK(nNewSize < nSize + nSize / 4);
+    }
+
+    CCacheFile file(path, "TestCache");
+    BOOST_CHECK(file.Read() == CCacheFile::Ok);
+    std::map<uint256, int> mapOut;
+    BOOST_CHECK(file.GetMapChunks("map", mapOut));
+    BOOST_CHECK(map == mapOut);
+}
+
+BOOST_AUTO_TEST_CASE(cachefile_corruption)
+{
+    boost::filesystem::path path = pathTemp / "test_cache_corrupt.dat";
+    std::map<uint256, int> map = RandomMap(2000);
+    {
+        CCacheFile file(path, "TestCache");
+        file.AddMapChunks("map", map);
+        BOOST_CHECK(file.Write());
+    }
+
+    // flip a byte in the middle of the records
+    uint64_t nSize = boost::filesystem::file_size(path);
+    FILE* f = fopen(path.string().c_str(), "r+b");
+    BOOST_REQUIRE(f);
+    fseek(f, nSize / 2, SEEK_SET);
+    int c = fgetc(f);
+    fseek(f, nSize / 2, SEEK_SET);
+    fputc(c ^ 0xff, f);
+    fclose(f);
+
+    // only the damaged chunk is lost
+    CCacheFile file(path, "TestCache");
+    BOOST_CHECK(file.Read() == CCacheFile::Ok);
+    std::map<uint256, int> mapOut;
+    BOOST_CHECK(!file.GetMapChunks("map", mapOut));
+    BOOST_CHECK(!mapOut.empty());
+    BOOST_CHECK(mapOut.size() < map.size());
+    for (const auto& it : mapOut)
+        BOOST_CHECK(map.count(it.first) && map[it.first] == it.second);
+
+    // the next write rewrites a clean file
+    {
+        CCacheFile fileRewrite(path, "TestCache");
+        fileRewrite.AddMapChunks("map", map);
+        BOOST_CHECK(fileRewrite.Write());
+    }
+    CCacheFile fileClean(path, "TestCache");
+    BOOST_CHECK(fileClean.Read() == CCacheFile::Ok);
+    mapOut.clear();
+    BOOST_CHECK(fileClean.GetMapChunks("map", mapOut));
+    BOOST_CHECK(map == mapOut);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 
 #include "coins.h"
 #include "script/standard.h"
+#include "txdb.h"
 #include "uint256.h"
 #include "utilstrencodings.h"
 #include "test/test_pivx.h"
@@ -12,7 +13,9 @@
 #include <vector>
 #include <map>
 
+#include <boost/bind.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 namespace
 {
@@ -61,6 +64,33 @@ public:
 
     bool GetStats(CCoinsStats& stats) const { return false; }
 };
+
+class CCoinsViewCacheTest : public CCoinsViewCache
+{
+public:
+    CCoinsViewCacheTest(CCoinsView* base) : CCoinsViewCache(base) {}
+
+    void SelfTest() const
+    {
+        // Manually recompute the dynamic usage of the whole data, and compare it.
+        size_t ret = memusage::DynamicUsage(cacheCoins);
+        for (CCoinsMap::iterator it = cacheCoins.begin(); it != cacheCoins.end(); it++) {
+            ret += it->second.coins.DynamicMemoryUsage();
+        }
+        BOOST_CHECK_EQUAL(DynamicMemoryUsage(), ret);
+    }
+};
+
+class CCoinsViewDBTest : public CCoinsViewDB
+{
+public:
+    CCoinsViewDBTest() : CCoinsViewDB(1 << 20, true, true) {}
+
+    void WriteLegacyCoins(const uint256& txid, const CCoins& coins)
+    {
+        BOOST_CHECK(db.Write(std::make_pair('c', txid), coins));
+    }
+};
 }
 
 BOOST_FIXTURE_TEST_SUITE(coins_tests, BasicTestingSetup)
@@ -92,8 +122,8 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
 
     // The cache stack.
     CCoinsViewTest base; // A CCoinsViewTest at the bottom.
-    std::vector<CCoinsViewCache*> stack; // A stack of CCoinsViewCaches on top.
-    stack.push_back(new CCoinsViewCache(&base)); // Start with one cache.
+    std::vector<CCoinsViewCacheTest*> stack; // A stack of CCoinsViewCaches on top.
+    stack.push_back(new CCoinsViewCacheTest(&base)); // Start with one cache.
 
     // Use a limited set of random transaction ids, so we do test overwriting entries.
     std::vector<uint256> txids;
@@ -118,6 +148,7 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
                 coins.nVersion = InsecureRand32();
                 coins.vout.resize(1);
                 coins.vout[0].nValue = InsecureRand32();
+                coins.vout[0].scriptPubKey.assign(InsecureRandBits(6), 0);
                 *entry = coins;
             } else {
                 coins.Clear();
@@ -138,6 +169,16 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
                     missed_an_entry = true;
                 }
             }
+            for (const CCoinsViewCacheTest* test : stack) {
+                test->SelfTest();
+            }
+        }
+
+        if (InsecureRandRange(100) == 0) {
+            // Every 100 iterations, write back the top cache while keeping it warm.
+            if (stack.size() > 0 && InsecureRandBool() == 0) {
+                stack.back()->WriteBack(InsecureRandBool() ? stack.back()->DynamicMemoryUsage() : InsecureRandRange(stack.back()->DynamicMemoryUsage() + 1));
+            }
         }
 
         if (InsecureRandRange(100) == 0) {
@@ -154,7 +195,7 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
                 } else {
                     removed_all_caches = true;
                 }
-                stack.push_back(new CCoinsViewCache(tip));
+                stack.push_back(new CCoinsViewCacheTest(tip));
                 if (stack.size() == 4) {
                     reached_4_caches = true;
                 }
@@ -247,4 +288,194 @@ BOOST_AUTO_TEST_CASE(ccoins_serialization)
     }
 }
 
+BOOST_AUTO_TEST_CASE(coins_cache_writeback_test)
+{
+    CCoinsViewTest base;
+    CCoinsViewCacheTest cache(&base);
+
+    std::vector<uint256> txids;
+    for (int i = 0; i < 100; i++) {
+        txids.push_back(InsecureRand256());
+        CCoinsModifier entry = cache.ModifyCoins(txids.back());
+        entry->vout.resize(1);
+        entry->vout[0].nValue = i + 1;
+        entry->vout[0].scriptPubKey.assign(20, 0);
+    }
+    {
+        // A fully spent entry is written as such and dropped from the cache.
+        CCoinsModifier entry = cache.ModifyCoins(txids[0]);
+        entry->Clear();
+    }
+    BOOST_CHECK(cache.WriteBack(cache.DynamicMemoryUsage()));
+    cache.SelfTest();
+
+    // Everything unspent stays resident, and the base has it too.
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 99U);
+    CCoins coins;
+    BOOST_CHECK(!base.GetCoins(txids[0], coins) || coins.IsPruned());
+    for (int i = 1; i < 100; i++) {
+        BOOST_CHECK(base.GetCoins(txids[i], coins));
+        BOOST_CHECK_EQUAL(coins.vout[0].nValue, i + 1);
+    }
+
+    // Touch the second half, then trim: the least recently used entries go first.
+    for (int i = 50; i < 100; i++)
+        BOOST_CHECK(cache.AccessCoins(txids[i]));
+    size_t nHalfUsage = cache.DynamicMemoryUsage() - 49 * cache.AccessCoins(txids[99])->DynamicMemoryUsage();
+    cache.Trim(nHalfUsage);
+    cache.SelfTest();
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 50U);
+    for (int i = 50; i < 100; i++)
+        BOOST_CHECK(cache.AccessCoins(txids[i])->vout[0].nValue == i + 1);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 50U);
+
+    // Evicted entries are simply fetched again from the base.
+    BOOST_CHECK(cache.AccessCoins(txids[1])->vout[0].nValue == 2);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 51U);
+}
+
+BOOST_FIXTURE_TEST_CASE(coins_db_per_output, TestingSetup)
+{
+    CCoinsViewDBTest dbview;
+
+    CCoins coins;
+    coins.fCoinStake = true;
+    coins.nHeight = 1000;
+    coins.nVersion = 1;
+    coins.vout.resize(6);
+    for (unsigned int i = 0; i < coins.vout.size(); i++) {
+        coins.vout[i].nValue = (i + 1) * COIN;
+        coins.vout[i].scriptPubKey.assign(25, (unsigned char)i);
+    }
+    coins.vout[1].SetNull();
+    uint256 txid = InsecureRand256();
+
+    // A record in the per-transaction format is converted by the upgrade.
+    dbview.WriteLegacyCoins(txid, coins);
+    BOOST_CHECK(dbview.Upgrade());
+    CCoins read;
+    BOOST_CHECK(dbview.GetCoins(txid, read));
+    BOOST_CHECK(read == coins);
+    BOOST_CHECK(read.fCoinStake && !read.fCoinBase);
+    BOOST_CHECK_EQUAL(read.nHeight, 1000);
+    // Nothing is left to convert.
+    BOOST_CHECK(dbview.Upgrade());
+
+    // Spending single outputs only removes those outputs.
+    {
+        CCoinsViewCache cache(&dbview);
+        cache.ModifyCoins(txid)->Spend(2);
+        BOOST_CHECK(cache.Flush());
+    }
+    coins.Spend(2);
+    BOOST_CHECK(dbview.GetCoins(txid, read));
+    BOOST_CHECK(read == coins);
+    {
+        CCoinsViewCache cache(&dbview);
+        cache.ModifyCoins(txid)->Spend(5);
+        BOOST_CHECK(cache.Flush());
+    }
+    coins.Spend(5);
+    BOOST_CHECK(dbview.GetCoins(txid, read));
+    BOOST_CHECK(read == coins);
+    BOOST_CHECK_EQUAL(read.vout.size(), 5U);
+
+    // Once fully spent the transaction is gone.
+    {
+        CCoinsViewCache cache(&dbview);
+        {
+            CCoinsModifier modifier = cache.ModifyCoins(txid);
+            for (unsigned int i = 0; i < modifier->vout.size(); i++)
+                modifier->Spend(i);
+        }
+        BOOST_CHECK(cache.Flush());
+    }
+    BOOST_CHECK(!dbview.HaveCoins(txid));
+    BOOST_CHECK(!dbview.GetCoins(txid, read));
+}
+
+BOOST_FIXTURE_TEST_CASE(coins_db_writeback_spent, TestingSetup)
+{
+    uint256 txid = InsecureRand256();
+    {
+        CCoinsViewDB dbview(1 << 20, false, true);
+        {
+            CCoinsViewCache cache(&dbview);
+            {
+                CCoinsModifier entry = cache.ModifyCoins(txid);
+                entry->nVersion = 1;
+                entry->nHeight = 100;
+                entry->vout.resize(3);
+                for (unsigned int i = 0; i < entry->vout.size(); i++) {
+                    entry->vout[i].nValue = (i + 1) * COIN;
+                    entry->vout[i].scriptPubKey.assign(25, (unsigned char)i);
+                }
+            }
+            BOOST_CHECK(cache.Flush());
+        }
+        BOOST_CHECK(dbview.HaveCoins(txid));
+
+        // All the outputs are spent in a cache that is then written back, not flushed.
+        CCoinsViewCache cache(&dbview);
+        {
+            CCoinsModifier modifier = cache.ModifyCoins(txid);
+            for (unsigned int i = 0; i < modifier->vout.size(); i++)
+                modifier->Spend(i);
+        }
+        BOOST_CHECK(cache.WriteBack(0));
+        BOOST_CHECK(!dbview.HaveCoins(txid));
+    }
+
+    // The spent outputs don't come back when the database is opened again.
+    CCoinsViewDB dbview(1 << 20);
+    BOOST_CHECK(!dbview.HaveCoins(txid));
+    CCoins coins;
+    BOOST_CHECK(!dbview.GetCoins(txid, coins));
+}
+
+BOOST_FIXTURE_TEST_CASE(coins_db_background_writer, TestingSetup)
+{
+    CCoinsViewDBTest dbview;
+    CCoinsViewBackgroundWriter writer(&dbview);
+    boost::thread thread(boost::bind(&CCoinsViewBackgroundWriter::ThreadWrite, &writer));
+
+    std::vector<uint256> txids;
+    uint256 hashBlock;
+    for (int nFlush = 0; nFlush < 10; nFlush++) {
+        CCoinsViewCache cache(&writer);
+        for (int i = 0; i < 100; i++) {
+            txids.push_back(InsecureRand256());
+            CCoinsModifier entry = cache.ModifyCoins(txids.back());
+            entry->vout.resize(1);
+            entry->vout[0].nValue = txids.size();
+            entry->vout[0].scriptPubKey.assign(20, 0);
+        }
+        // Spend an output written by an earlier flush, which may still be in flight.
+        if (nFlush > 0)
+            cache.ModifyCoins(txids[(nFlush - 1) * 100])->Spend(0);
+        hashBlock = InsecureRand256();
+        cache.SetBestBlock(hashBlock);
+        BOOST_CHECK(cache.Flush());
+
+        // Whatever was handed over is visible right away, written or not.
+        BOOST_CHECK(writer.GetBestBlock() == hashBlock);
+        BOOST_CHECK(writer.HaveCoins(txids.back()));
+        if (nFlush > 0)
+            BOOST_CHECK(!writer.HaveCoins(txids[(nFlush - 1) * 100]));
+    }
+
+    BOOST_CHECK(writer.Sync());
+    BOOST_CHECK(dbview.GetBestBlock() == hashBlock);
+    for (unsigned int i = 0; i < txids.size(); i++) {
+        CCoins coins;
+        bool fSpent = i % 100 == 0 && i < 900;
+        BOOST_CHECK_EQUAL(dbview.GetCoins(txids[i], coins), !fSpent);
+        if (!fSpent)
+            BOOST_CHECK_EQUAL(coins.vout[0].nValue, (CAmount)(i + 1));
+    }
+
+    thread.interrupt();
+    thread.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,47 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "invalid.h"
+#include "random.h"
+#include "test/test_pivx.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(invalid_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(invalid_outpoints_test)
+{
+    uint256 txid("00405ad8cc4ec7b6be27dedc6bf19f2febf8e338031fe552d7bf5c0dfd6e67de");
+    BOOST_CHECK(invalid_out::ContainsOutPoint(COutPoint(txid, 0)));
+    BOOST_CHECK(!invalid_out::ContainsOutPoint(COutPoint(txid, 1)));
+
+    txid = uint256("fff7164737e3437fd27b3787edeb2650eddd07966c492ffb7e0eb537c0a5b850");
+    BOOST_CHECK(invalid_out::ContainsOutPoint(COutPoint(txid, 1)));
+    BOOST_CHECK(!invalid_out::ContainsOutPoint(COutPoint(txid, 0)));
+
+    BOOST_CHECK(!invalid_out::ContainsOutPoint(COutPoint(GetRandHash(), 0)));
+
+    std::vector<COutPoint> vOutPoints = invalid_out::GetOutPoints();
+    BOOST_CHECK_EQUAL(vOutPoints.size(), 1695U);
+    for (const COutPoint& out : vOutPoints)
+        BOOST_CHECK(invalid_out::ContainsOutPoint(out));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_serials_test)
+{
+    CBigNum bnSerial;
+    bnSerial.SetHex("c9c868bb56eacfc4f3d829528a0ae812dff26619cd38e6c9a0eea1eacddc84");
+    BOOST_CHECK(invalid_out::ContainsSerial(bnSerial));
+    BOOST_CHECK(!invalid_out::ContainsSerial(bnSerial + 1));
+    BOOST_CHECK(!invalid_out::ContainsSerial(-bnSerial));
+
+    // Serials can be wider than 256 bits
+    bnSerial.SetHex("10003d303f592aee977bf6717af8c9603514869adbbbc277f0296dff12e1f1274");
+    BOOST_CHECK(invalid_out::ContainsSerial(bnSerial));
+
+    BOOST_CHECK(!invalid_out::ContainsSerial(CBigNum(0)));
+    BOOST_CHECK(!invalid_out::ContainsSerial(CBigNum(GetRandHash())));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "masternode.h"
+#include "masternode-budget.h"
+#include "messagesigner.h"
+#include "net.h"
+#include "test_pivx.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(messagesigner_tests, TestingSetup)
+
+static CKey NewKey()
+{
+    CKey key;
+    key.MakeNewKey(true);
+    return key;
+}
+
+static CTxIn NewVin()
+{
+    return CTxIn(COutPoint(InsecureRand256(), 0));
+}
+
+/**
+ * The signature check queued for a message must be the one its CheckSignature
+ * verifies: signing already verified that, so the check must hit the cache.
+ */
+static void CheckQueuedCheck(const CMessageSigCheck& check, const uint256& hashExpected, const CPubKey& pubKey, const std::vector<unsigned char>& vchSig)
+{
+    BOOST_CHECK(check.GetHash() == hashExpected);
+    BOOST_CHECK(check.GetKeyID() == pubKey.GetID());
+    BOOST_CHECK(check.GetSig() == vchSig);
+    BOOST_CHECK(CHashSigner::IsVerifiedHash(check.GetHash(), check.GetKeyID(), check.GetSig()));
+}
+
+BOOST_AUTO_TEST_CASE(message_signature_cache)
+{
+    const CKey key = NewKey();
+    const CKey key2 = NewKey();
+    const CKeyID keyID = key.GetPubKey().GetID();
+    const CKeyID keyID2 = key2.GetPubKey().GetID();
+    const uint256 hash = InsecureRand256();
+    std::string strError;
+
+    // signed directly, so that nothing was verified through the cache yet
+    std::vector<unsigned char> vchSig;
+    BOOST_CHECK(key.SignCompact(hash, vchSig));
+
+    // a valid signature is cached by its first check, the second one is a hit
+    BOOST_CHECK(!CHashSigner::IsVerifiedHash(hash, keyID, vchSig));
+    BOOST_CHECK(CHashSigner::VerifyHash(hash, keyID, vchSig, strError));
+    BOOST_CHECK(CHashSigner::IsVerifiedHash(hash, keyID, vchSig));
+    BOOST_CHECK(CHashSigner::VerifyHash(hash, keyID, vchSig, strError));
+
+    // the same hash and signature for another key id miss the cache and fail
+    BOOST_CHECK(!CHashSigner::IsVerifiedHash(hash, keyID2, vchSig));
+    BOOST_CHECK(!CHashSigner::VerifyHash(hash, keyID2, vchSig, strError));
+    BOOST_CHECK(!CHashSigner::IsVerifiedHash(hash, keyID2, vchSig));
+
+    // the same hash signed by another key misses the cache until verified
+    std::vector<unsigned char> vchSig2;
+    BOOST_CHECK(key2.SignCompact(hash, vchSig2));
+    BOOST_CHECK(!CHashSigner::IsVerifiedHash(hash, keyID2, vchSig2));
+    BOOST_CHECK(CHashSigner::VerifyHash(hash, keyID2, vchSig2, strError));
+    BOOST_CHECK(CHashSigner::IsVerifiedHash(hash, keyID2, vchSig2));
+
+    // an invalid signature is never cached and fails on every check
+    std::vector<unsigned char> vchBad(vchSig);
+    vchBad[10] ^= 1;
+    for (int i = 0; i < 2; i++) {
+        BOOST_CHECK(!CHashSigner::VerifyHash(hash, keyID, vchBad, strError));
+        BOOST_CHECK(!CHashSigner::IsVerifiedHash(hash, keyID, vchBad));
+    }
+
+    // neither is a valid signature of another hash
+    const uint256 hashOther = InsecureRand256();
+    for (int i = 0; i < 2; i++) {
+        BOOST_CHECK(!CHashSigner::VerifyHash(hashOther, keyID, vchSig, strError));
+        BOOST_CHECK(!CHashSigner::IsVerifiedHash(hashOther, keyID, vchSig));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(message_signature_check)
+{
+    const CKey key = NewKey();
+    const CKeyID keyID = key.GetPubKey().GetID();
+    const uint256 hash = InsecureRand256();
+    std::vector<unsigned char> vchSig;
+    BOOST_CHECK(key.SignCompact(hash, vchSig));
+
+    // the queued check only records a valid signature in the cache
+    CMessageSigCheck check(hash, keyID, vchSig);
+    BOOST_CHECK(check());
+    BOOST_CHECK(CHashSigner::IsVerifiedHash(hash, keyID, vchSig));
+
+    // and always succeeds, a bad signature is reported when its message is processed
+    std::vector<unsigned char> vchBad(vchSig);
+    vchBad[10] ^= 1;
+    CMessageSigCheck checkBad(hash, keyID, vchBad);
+    BOOST_CHECK(checkBad());
+    BOOST_CHECK(!CHashSigner::IsVerifiedHash(hash, keyID, vchBad));
+
+    // swapped checks keep their own work
+    check.swap(checkBad);
+    BOOST_CHECK(check.GetSig() == vchBad);
+    BOOST_CHECK(checkBad.GetSig() == vchSig);
+}
+
+BOOST_AUTO_TEST_CASE(mnb_signature_check)
+{
+    const CKey keyCollateral = NewKey();
+    const CKey keyMasternode = NewKey();
+    const CPubKey pubKeyCollateral = keyCollateral.GetPubKey();
+    CMasternodeBroadcast mnb(CService("1.2.3.4", 51472), NewVin(), pubKeyCollateral, keyMasternode.GetPubKey(), PROTOCOL_VERSION);
+
+    for (const bool fNewSigs : {false, true}) {
+        mnb.sigTime = GetTime() + (fNewSigs ? 1 : 0);
+        BOOST_CHECK(mnb.Sign(keyCollateral, pubKeyCollateral, fNewSigs));
+        BOOST_CHECK_EQUAL(mnb.nMessVersion, fNewSigs ? MessageVersion::MESS_VER_HASH : MessageVersion::MESS_VER_STRMESS);
+        BOOST_CHECK(mnb.CheckSignature());
+
+        const uint256 hashExpected = CMessageSigner::GetMessageHash(fNewSigs ? mnb.GetSignatureHash().GetHex() : mnb.GetStrMessage());
+        CheckQueuedCheck(mnb.GetSignatureCheck(pubKeyCollateral), hashExpected, pubKeyCollateral, mnb.GetVchSig());
+
+        // once the message changes, the queued check misses the cache like CheckSignature fails
+        mnb.sigTime++;
+        const CMessageSigCheck check = mnb.GetSignatureCheck(pubKeyCollateral);
+        BOOST_CHECK(!CHashSigner::IsVerifiedHash(check.GetHash(), check.GetKeyID(), check.GetSig()));
+        BOOST_CHECK(!mnb.CheckSignature());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(signed_message_signature_check)
+{
+    const CKey key = NewKey();
+    const CPubKey pubKey = key.GetPubKey();
+
+    CMasternodePing ping;
+    ping.vin = NewVin();
+    ping.blockHash = InsecureRand256();
+    CBudgetVote vote(NewVin(), InsecureRand256(), VOTE_YES);
+
+    for (CSignedMessage* pmessage : std::vector<CSignedMessage*>{&ping, &vote}) {
+        for (const bool fNewSigs : {false, true}) {
+            BOOST_CHECK(pmessage->Sign(key, pubKey, fNewSigs));
+            BOOST_CHECK_EQUAL(pmessage->nMessVersion, fNewSigs ? MessageVersion::MESS_VER_HASH : MessageVersion::MESS_VER_STRMESS);
+            BOOST_CHECK(pmessage->CheckSignature(pubKey));
+
+            const uint256 hashExpected = fNewSigs ? pmessage->GetSignatureHash() : CMessageSigner::GetMessageHash(pmessage->GetStrMessage());
+            CheckQueuedCheck(pmessage->GetSignatureCheck(pubKey), hashExpected, pubKey, pmessage->GetVchSig());
+
+            // a check for another key misses the cache like CheckSignature fails
+            const CPubKey pubKeyOther = NewKey().GetPubKey();
+            const CMessageSigCheck check = pmessage->GetSignatureCheck(pubKeyOther);
+            BOOST_CHECK(!CHashSigner::IsVerifiedHash(check.GetHash(), check.GetKeyID(), check.GetSig()));
+            BOOST_CHECK(!pmessage->CheckSignature(pubKeyOther));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(read_signed_message)
+{
+    CMasternodePing ping;
+    ping.vin = NewVin();
+    ping.blockHash = InsecureRand256();
+    CDataStream ssPing(SER_NETWORK, PROTOCOL_VERSION);
+    ssPing << ping;
+
+    CNode node(INVALID_SOCKET, CAddress(CService("1.2.3.4", 51472)), "", true);
+
+    // without a decoded copy, the message is read from the stream
+    {
+        CDataStream vRecv(ssPing);
+        std::shared_ptr<CMasternodePing> pping = node.ReadSignedMessage<CMasternodePing>(vRecv);
+        BOOST_CHECK(pping->GetHash() == ping.GetHash());
+        BOOST_CHECK(vRecv.empty());
+        BOOST_CHECK(!node.pRecvDecoded);
+    }
+
+    // a decoded copy of the message type is handed over, the stream is left alone
+    {
+        CDataStream vRecv(ssPing);
+        std::shared_ptr<CMasternodePing> pdecoded = std::make_shared<CMasternodePing>(ping);
+        node.pRecvDecoded = pdecoded;
+        std::shared_ptr<CMasternodePing> pping = node.ReadSignedMessage<CMasternodePing>(vRecv);
+        BOOST_CHECK(pping == pdecoded);
+        BOOST_CHECK_EQUAL(vRecv.size(), ssPing.size());
+        BOOST_CHECK(!node.pRecvDecoded);
+    }
+
+    // a decoded copy of another type is dropped and the stream decoded instead
+    {
+        CDataStream vRecv(ssPing);
+        node.pRecvDecoded = std::make_shared<CBudgetVote>(NewVin(), InsecureRand256(), VOTE_NO);
+        std::shared_ptr<CMasternodePing> pping = node.ReadSignedMessage<CMasternodePing>(vRecv);
+        BOOST_CHECK(pping->GetHash() == ping.GetHash());
+        BOOST_CHECK(vRecv.empty());
+        BOOST_CHECK(!node.pRecvDecoded);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,13 +5,19 @@
 
 #include "rpc/server.h"
 #include "rpc/client.h"
+#include "rpc/jsonstream.h"
+#include "rpc/protocol.h"
+#include "rpc/responsecache.h"
 
 #include "base58.h"
+#include "main.h"
 #include "netbase.h"
 #include "util.h"
 
 #include "test/test_pivx.h"
 
+#include <thread>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -183,6 +189,66 @@ BOOST_AUTO_TEST_CASE(json_parse_errors)
     BOOST_CHECK_THROW(ParseNonRFCJSONValue("3J98t1WpEZ73CNmQviecrnyiWrnqRhWNL"), std::runtime_error);
 }
 
+BOOST_AUTO_TEST_CASE(rpc_convert_address_params)
+{
+    // Address index queries take a bare address as well as a JSON object
+    UniValue params = RPCConvertValues("getaddressbalance", {"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6"});
+    BOOST_CHECK_EQUAL(params[0].get_str(), "DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6");
+    params = RPCConvertValues("getaddressutxos", {"{\"addresses\": [\"DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6\"]}"});
+    BOOST_CHECK(params[0].isObject());
+    BOOST_CHECK_EQUAL(find_value(params[0].get_obj(), "addresses")[0].get_str(), "DMJRSsuU9zfyrvxVaAEFQqK4MxZg6vgeS6");
+    // Other converted params still have to be valid JSON
+    BOOST_CHECK_THROW(RPCConvertValues("getblockindexstats", {"abc"}), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("str", std::string("quote\" backslash\\ ctrl\n\x01\x7f end", 30)));
+    obj.push_back(Pair("num", -12));
+    obj.push_back(Pair("amount", ValueFromAmount(123456789)));
+    obj.push_back(Pair("real", 0.25));
+    obj.push_back(Pair("yes", true));
+    obj.push_back(Pair("no", false));
+    obj.push_back(Pair("null", NullUniValue));
+    UniValue arr(UniValue::VARR);
+    arr.push_back(UniValue(UniValue::VOBJ));
+    arr.push_back(UniValue(UniValue::VARR));
+    arr.push_back(obj);
+    obj.push_back(Pair("arr", arr));
+
+    // Same text as UniValue::write, in pieces of at least the flush size
+    std::string strOut;
+    std::vector<size_t> vPieces;
+    CJSONStreamWriter writer([&](const std::string& str) { strOut += str; vPieces.push_back(str.size()); return true; }, 16);
+    writer.Value(obj);
+    writer.Flush();
+    BOOST_CHECK_EQUAL(strOut, obj.write());
+    BOOST_CHECK(vPieces.size() > 1);
+    for (size_t i = 0; i + 1 < vPieces.size(); i++)
+        BOOST_CHECK(vPieces[i] >= 16);
+
+    // Built element by element
+    strOut.clear();
+    CJSONStreamWriter writer2([&](const std::string& str) { strOut += str; return true; });
+    JSONRPCReplyStream(writer2, arr, NullUniValue, UniValue(7));
+    writer2.Flush();
+    BOOST_CHECK_EQUAL(strOut, JSONRPCReplyObj(arr, NullUniValue, UniValue(7)).write());
+
+    // Nothing reaches the output once it refused a piece
+    strOut.clear();
+    int nCalls = 0;
+    CJSONStreamWriter writer3([&](const std::string& str) { nCalls++; return false; }, 1);
+    writer3.BeginArray();
+    BOOST_CHECK(!writer3.IsStopped());
+    writer3.Value(obj);
+    BOOST_CHECK(writer3.IsStopped());
+    writer3.Value(obj);
+    writer3.EndArray();
+    writer3.Flush();
+    BOOST_CHECK_EQUAL(nCalls, 1);
+}
+
 BOOST_AUTO_TEST_CASE(rpc_ban)
 {
     BOOST_CHECK_NO_THROW(CallRPC(std::string("clearbanned")));
@@ -265,4 +331,147 @@ BOOST_AUTO_TEST_CASE(rpc_ban)
     BOOST_CHECK_EQUAL(adr.get_str(), "2001:4d48:ac57:400:cacf:e9ff:fe1d:9c63/128");
 }
 
+BOOST_AUTO_TEST_CASE(rpc_response_cache)
+{
+    // A chain of 10 blocks, and a branch of 3 blocks forking off at 5
+    std::vector<CBlockIndex> vBlocks(10);
+    for (unsigned int i = 0; i < vBlocks.size(); i++) {
+        vBlocks[i].nHeight = i;
+        vBlocks[i].pprev = i ? &vBlocks[i - 1] : NULL;
+        vBlocks[i].BuildSkip();
+    }
+    std::vector<CBlockIndex> vFork(3);
+    for (unsigned int i = 0; i < vFork.size(); i++) {
+        vFork[i].nHeight = i + 6;
+        vFork[i].pprev = i ? &vFork[i - 1] : &vBlocks[5];
+        vFork[i].BuildSkip();
+    }
+    CChainTipSnapshot chain;
+    chain.pindexTip = &vBlocks.back();
+    chain.nHeight = 9;
+
+    UniValue obj(UniValue::VOBJ);
+    obj.push_back(Pair("hash", "00ff"));
+    obj.push_back(Pair("confirmations", 1));
+    obj.push_back(Pair("height", 3));
+
+    CResponseCache cache;
+    UniValue value;
+    // Disabled by default
+    cache.Put("a", &vBlocks[3], obj, chain);
+    BOOST_CHECK(!cache.Get("a", value, chain));
+
+    cache.SetMaxSize(1 << 20);
+    cache.Put("a", &vBlocks[3], obj, chain);
+    cache.Put("b", &vBlocks[7], UniValue("00ff"), chain);
+    // Results of blocks outside the chain are not kept
+    cache.Put("fork", &vFork[0], obj, chain);
+    // The tip of an earlier chain
+    CChainTipSnapshot shorter;
+    shorter.pindexTip = &vBlocks[8];
+    shorter.nHeight = 8;
+    cache.Put("tip", &vBlocks[8], obj, shorter);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 3U);
+
+    // The confirmation count follows the tip
+    BOOST_CHECK(cache.Get("a", value, chain));
+    BOOST_CHECK_EQUAL(find_value(value.get_obj(), "confirmations").get_int(), 7);
+    BOOST_CHECK_EQUAL(find_value(value.get_obj(), "hash").get_str(), "00ff");
+    BOOST_CHECK(cache.Get("b", value, chain));
+    BOOST_CHECK_EQUAL(value.get_str(), "00ff");
+    BOOST_CHECK(!cache.Get("c", value, chain));
+
+    // The result of a tip is dropped once the tip has a successor (nextblockhash)
+    BOOST_CHECK(cache.Get("tip", value, shorter));
+    BOOST_CHECK(!cache.Get("tip", value, chain));
+
+    // After a reorganization to the fork, results above the fork point are gone
+    CChainTipSnapshot reorged;
+    reorged.pindexTip = &vFork.back();
+    reorged.nHeight = 8;
+    BOOST_CHECK(cache.Get("a", value, reorged));
+    BOOST_CHECK_EQUAL(find_value(value.get_obj(), "confirmations").get_int(), 6);
+    BOOST_CHECK(!cache.Get("b", value, reorged));
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 1U);
+
+    CResponseCache::Stats stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.nHits, 4U);
+    BOOST_CHECK_EQUAL(stats.nMisses, 3U);
+
+    // The least recently used results are evicted first
+    cache.Clear();
+    cache.Put("k0", &vBlocks[0], obj, chain);
+    const size_t nEntrySize = cache.GetStats().nBytes;
+    cache.SetMaxSize(8 * nEntrySize);
+    for (int i = 1; i < 8; i++)
+        cache.Put(strprintf("k%d", i), &vBlocks[i], obj, chain);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 8U);
+    BOOST_CHECK(cache.Get("k0", value, chain));
+    cache.Put("k8", &vBlocks[8], obj, chain);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 8U);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEvictions, 1U);
+    BOOST_CHECK(cache.Get("k0", value, chain));
+    BOOST_CHECK(!cache.Get("k1", value, chain));
+    BOOST_CHECK(cache.Get("k8", value, chain));
+
+    cache.SetMaxSize(0);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 0U);
+    BOOST_CHECK(!cache.Get("k0", value, chain));
+}
+
+static UniValue BatchRequest(const std::string& strMethod, int nId)
+{
+    UniValue req(UniValue::VOBJ);
+    req.push_back(Pair("method", strMethod));
+    req.push_back(Pair("params", UniValue(UniValue::VARR)));
+    req.push_back(Pair("id", nId));
+    return req;
+}
+
+BOOST_AUTO_TEST_CASE(rpc_batch_parallel)
+{
+    std::vector<std::thread> vThreads;
+    RPCTaskQueueFn fnQueue = [&vThreads](const std::function<void()>& task) {
+        vThreads.emplace_back(task);
+        return true;
+    };
+
+    // Unknown methods only fail their own request
+    UniValue vReq(UniValue::VARR);
+    for (int i = 0; i < 20; i++)
+        vReq.push_back(BatchRequest(i == 7 ? "nosuchmethod" : "getblockcount", i));
+
+    UniValue ret;
+    BOOST_CHECK(ret.read(JSONRPCExecBatch(vReq, fnQueue, 4)));
+    for (std::thread& thread : vThreads)
+        thread.join();
+    BOOST_CHECK_EQUAL(vThreads.size(), 3U);
+    BOOST_CHECK_EQUAL(ret.size(), vReq.size());
+    for (unsigned int i = 0; i < ret.size(); i++) {
+        BOOST_CHECK_EQUAL(find_value(ret[i], "id").get_int(), (int)i);
+        const UniValue& error = find_value(ret[i], "error");
+        if (i == 7)
+            BOOST_CHECK_EQUAL(find_value(error, "code").get_int(), (int)RPC_METHOD_NOT_FOUND);
+        else
+            BOOST_CHECK(error.isNull() && find_value(ret[i], "result").get_int() == chainActive.Height());
+    }
+
+    // A command that is not thread safe makes the whole batch sequential
+    vThreads.clear();
+    vReq.push_back(BatchRequest("addnode", 20));
+    BOOST_CHECK(ret.read(JSONRPCExecBatch(vReq, fnQueue, 4)));
+    BOOST_CHECK(vThreads.empty());
+    BOOST_CHECK_EQUAL(ret.size(), vReq.size());
+    BOOST_CHECK_EQUAL(find_value(ret[20], "id").get_int(), 20);
+    BOOST_CHECK(!find_value(ret[20], "error").isNull());
+
+    // So does a limit of one request at a time
+    vReq = UniValue(UniValue::VARR);
+    vReq.push_back(BatchRequest("getblockcount", 0));
+    vReq.push_back(BatchRequest("getblockcount", 1));
+    BOOST_CHECK(ret.read(JSONRPCExecBatch(vReq, fnQueue, 1)));
+    BOOST_CHECK(vThreads.empty());
+    BOOST_CHECK_EQUAL(ret.size(), 2U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
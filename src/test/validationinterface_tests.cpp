@@ -0,0 +1,93 @@
+// Copyright (c) 2019 The PIVX developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "primitives/block.h"
+#include "validationinterface.h"
+#include "test/test_pivx.h"
+
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(validationinterface_tests, BasicTestingSetup)
+
+namespace {
+/** Records the notifications it receives and the thread they arrive on */
+class CRecordingInterface : public CValidationInterface
+{
+public:
+    std::vector<uint256> vInventory;
+    std::vector<uint256> vSyncedTx;
+    std::vector<uint256> vSyncedBlock;
+    std::thread::id threadLast;
+
+protected:
+    void Inventory(const uint256& hash)
+    {
+        vInventory.push_back(hash);
+        threadLast = std::this_thread::get_id();
+    }
+
+    void SyncTransaction(const CTransaction& tx, const CBlock* pblock)
+    {
+        vSyncedTx.push_back(tx.GetHash());
+        vSyncedBlock.push_back(pblock ? pblock->GetHash() : uint256());
+        threadLast = std::this_thread::get_id();
+    }
+};
+}
+
+BOOST_AUTO_TEST_CASE(validationinterface_queue)
+{
+    CRecordingInterface recorder;
+    RegisterValidationInterface(&recorder);
+
+    // Before the queue is started, notifications are delivered right away
+    GetMainSignals().Inventory(uint256(1));
+    BOOST_CHECK_EQUAL(recorder.vInventory.size(), 1U);
+    BOOST_CHECK(recorder.threadLast == std::this_thread::get_id());
+
+    StartValidationInterfaceQueue();
+
+    // Queued notifications are delivered in order, on the queue thread
+    std::vector<uint256> vExpected(1, uint256(1));
+    for (int i = 2; i < 1000; i++) {
+        GetMainSignals().Inventory(uint256(i));
+        vExpected.push_back(uint256(i));
+    }
+    SyncWithValidationInterfaceQueue();
+    BOOST_CHECK(recorder.vInventory == vExpected);
+    BOOST_CHECK(recorder.threadLast != std::this_thread::get_id());
+
+    // The transactions of a block are delivered with a copy of it, which outlives the original
+    uint256 hashBlock;
+    std::vector<uint256> vTxHashes;
+    {
+        CBlock block;
+        block.nTime = 1234;
+        for (int i = 0; i < 3; i++) {
+            CMutableTransaction mtx;
+            mtx.nLockTime = i;
+            block.vtx.push_back(mtx);
+            vTxHashes.push_back(block.vtx.back().GetHash());
+        }
+        hashBlock = block.GetHash();
+        for (const CTransaction& tx : block.vtx)
+            SyncWithWallets(tx, &block);
+        block.SetNull();
+    }
+    SyncWithValidationInterfaceQueue();
+    BOOST_CHECK(recorder.vSyncedTx == vTxHashes);
+    BOOST_CHECK(recorder.vSyncedBlock == std::vector<uint256>(3, hashBlock));
+
+    // Stopping delivers what is still queued
+    GetMainSignals().Inventory(uint256(1000));
+    StopValidationInterfaceQueue();
+    BOOST_CHECK_EQUAL(recorder.vInventory.size(), 1000U);
+
+    UnregisterValidationInterface(&recorder);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
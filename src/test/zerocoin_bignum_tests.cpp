@@ -87,4 +87,31 @@ BOOST_AUTO_TEST_CASE(bignum_random_generation_tests)
     }
 }
 
+BOOST_AUTO_TEST_CASE(bignum_vartime_pow_mod_tests)
+{
+    CBigNum m;
+    m.SetHex(strHexModulus);
+    std::vector<CBigNum> bases, exps;
+    for (int i = 0; i < 6; i++) {
+        bases.push_back(CBigNum::randBignum(m));
+        CBigNum e = CBigNum::randKBitBignum(256 + 64 * i);
+        exps.push_back(i % 2 ? e * -1 : e);
+    }
+
+    CBigNum expected = 1;
+    for (unsigned int k = 0; k <= bases.size(); k++) {
+        const std::vector<CBigNum> b(bases.begin(), bases.begin() + k);
+        const std::vector<CBigNum> e(exps.begin(), exps.begin() + k);
+        if (k > 0) {
+            BOOST_CHECK(bases[k - 1].pow_mod_vartime(exps[k - 1], m) == bases[k - 1].pow_mod(exps[k - 1], m));
+            expected = expected.mul_mod(bases[k - 1].pow_mod(exps[k - 1], m), m);
+        }
+        BOOST_CHECK_MESSAGE(CBigNum::mul_pow_mod(b, e, m) == expected, strprintf("CBigNum::mul_pow_mod failed with %d bases", k));
+    }
+
+    // zero exponents and bases larger than the modulus
+    BOOST_CHECK(CBigNum::mul_pow_mod({m + 3, m + 5}, {0, 0}, m) == 1);
+    BOOST_CHECK(CBigNum::mul_pow_mod({m + 3, m + 5}, {2, 1}, m) == 45);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
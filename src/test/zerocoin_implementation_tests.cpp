@@ -17,6 +17,8 @@
 #include "wallet/wallet.h"
 #include "zpiv/zpivwallet.h"
 #include "zpivchain.h"
+#include "random.h"
+#include "txdb.h"
 #include "test_pivx.h"
 
 
@@ -507,4 +509,90 @@ BOOST_AUTO_TEST_CASE(deterministic_tests)
 }
 
 
+BOOST_AUTO_TEST_CASE(fixed_base_pow_test)
+{
+    SelectParams(CBaseChainParams::MAIN);
+    libzerocoin::ZerocoinParams* ZCParams = Params().Zerocoin_Params(false);
+    std::vector<const libzerocoin::IntegerGroupParams*> groups = {
+            &ZCParams->coinCommitmentGroup,
+            &ZCParams->serialNumberSoKCommitmentGroup,
+            &ZCParams->accumulatorParams.accumulatorPoKCommitmentGroup};
+
+    for (const libzerocoin::IntegerGroupParams* group : groups) {
+        for (int i = 0; i < 20; i++) {
+            // exponents below, around and above the group order, positive and negative
+            CBigNum e = CBigNum::randKBitBignum(group->groupOrder.bitSize() - 8 + i * 4);
+            if (i % 2)
+                e = 0 - e;
+            BOOST_CHECK(group->pow_g_vartime(e) == group->g.pow_mod(e, group->modulus));
+            BOOST_CHECK(group->pow_h_vartime(e) == group->h.pow_mod(e, group->modulus));
+        }
+        BOOST_CHECK(group->pow_g_vartime(BN_ZERO).isOne());
+        BOOST_CHECK(group->pow_h_vartime(group->groupOrder).isOne());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(accumulator_batch_test)
+{
+    SelectParams(CBaseChainParams::MAIN);
+    libzerocoin::ZerocoinParams* ZCParams = Params().Zerocoin_Params(false);
+
+    // the accumulation only needs the values, they don't have to be valid coins
+    std::list<libzerocoin::PublicCoin> listPubcoins;
+    for (int i = 0; i < 24; i++) {
+        libzerocoin::CoinDenomination denom = libzerocoin::zerocoinDenomList[i % 3 * 2];
+        listPubcoins.emplace_back(ZCParams, CBigNum::randKBitBignum(1024), denom);
+    }
+
+    AccumulatorMap mapSingle(ZCParams);
+    AccumulatorMap mapBatch(ZCParams);
+    std::vector<CBigNum> vValues;
+    libzerocoin::Accumulator accSingle(ZCParams, listPubcoins.front().getDenomination());
+    libzerocoin::Accumulator accBatch(ZCParams, listPubcoins.front().getDenomination());
+    for (const libzerocoin::PublicCoin& pubcoin : listPubcoins) {
+        BOOST_CHECK(mapSingle.Accumulate(pubcoin, true));
+        if (pubcoin.getDenomination() == accSingle.getDenomination()) {
+            accSingle.increment(pubcoin.getValue());
+            vValues.emplace_back(pubcoin.getValue());
+        }
+    }
+    accBatch.increment(vValues);
+    BOOST_CHECK(accSingle == accBatch);
+
+    BOOST_CHECK(mapBatch.AccumulateBatch(listPubcoins));
+    for (auto& denom : libzerocoin::zerocoinDenomList)
+        BOOST_CHECK(mapSingle.GetValue(denom) == mapBatch.GetValue(denom));
+    BOOST_CHECK(mapSingle.GetCheckpoint() == mapBatch.GetCheckpoint());
+}
+
+BOOST_AUTO_TEST_CASE(zerocoin_hash_filter)
+{
+    CZerocoinHashFilter filter;
+    // An unsized filter can't rule anything out
+    BOOST_CHECK(filter.MaybeContains(GetRandHash()));
+
+    filter.Reset(1000);
+    BOOST_CHECK(filter.HasRoomFor(1000));
+    BOOST_CHECK(!filter.HasRoomFor(1001));
+
+    std::vector<uint256> vHashes;
+    for (int i = 0; i < 1000; i++) {
+        vHashes.push_back(GetRandHash());
+        filter.Insert(vHashes.back());
+    }
+    BOOST_CHECK(!filter.HasRoomFor(1));
+    for (const uint256& hash : vHashes)
+        BOOST_CHECK(filter.MaybeContains(hash));
+
+    // About 0.25% false positives are expected at capacity
+    int nFalsePositives = 0;
+    for (int i = 0; i < 10000; i++)
+        if (filter.MaybeContains(GetRandHash()))
+            nFalsePositives++;
+    BOOST_CHECK(nFalsePositives < 100);
+
+    filter.Reset(1000);
+    BOOST_CHECK(!filter.MaybeContains(vHashes[0]));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -6,22 +6,41 @@
 
 #include "txdb.h"
 
+#include "guiinterface.h"
+#include "init.h"
 #include "main.h"
 #include "pow.h"
 #include "uint256.h"
 #include "zpiv/accumulators.h"
 
+#include <algorithm>
 #include <stdint.h>
 
+#include <boost/bind.hpp>
 #include <boost/thread.hpp>
 
 
-void static BatchWriteCoins(CLevelDBBatch& batch, const uint256& hash, const CCoins& coins)
+namespace
 {
-    if (coins.IsPruned())
-        batch.Erase(std::make_pair('c', hash));
-    else
-        batch.Write(std::make_pair('c', hash), coins);
+/** Key of a single unspent output in the coin database: 'C' + txid + VARINT(n) */
+struct CoinEntry {
+    char key;
+    uint256 hash;
+    uint32_t n;
+
+    CoinEntry() : key('C'), hash(0), n(0) {}
+    CoinEntry(const uint256& hashIn, uint32_t nIn) : key('C'), hash(hashIn), n(nIn) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersion)
+    {
+        READWRITE(key);
+        READWRITE(hash);
+        READWRITE(VARINT(n));
+    }
+};
 }
 
 void static BatchWriteHashBestChain(CLevelDBBatch& batch, const uint256& hash)
@@ -33,14 +52,53 @@ CCoinsViewDB::CCoinsViewDB(size_t nCacheSize, bool fMemory, bool fWipe) : db(Get
 {
 }
 
+void CCoinsViewDB::ReadOutputs(const uint256& txid, std::map<uint32_t, CDiskCoin>& mapOutputs) const
+{
+    CDataStream ssPrefix(SER_DISK, CLIENT_VERSION);
+    ssPrefix << std::make_pair('C', txid);
+    leveldb::Slice slPrefix(&ssPrefix[0], ssPrefix.size());
+
+    boost::scoped_ptr<leveldb::Iterator> pcursor(const_cast<CLevelDBWrapper*>(&db)->NewIterator(true));
+    for (pcursor->Seek(slPrefix); pcursor->Valid() && pcursor->key().starts_with(slPrefix); pcursor->Next()) {
+        leveldb::Slice slKey = pcursor->key();
+        leveldb::Slice slValue = pcursor->value();
+        CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
+        CDataStream ssValue(slValue.data(), slValue.data() + slValue.size(), SER_DISK, CLIENT_VERSION);
+        CoinEntry entry;
+        ssKey >> entry;
+        ssValue >> mapOutputs[entry.n];
+    }
+    if (!pcursor->status().ok())
+        HandleError(pcursor->status());
+}
+
 bool CCoinsViewDB::GetCoins(const uint256& txid, CCoins& coins) const
 {
-    return db.Read(std::make_pair('c', txid), coins);
+    std::map<uint32_t, CDiskCoin> mapOutputs;
+    ReadOutputs(txid, mapOutputs);
+    if (mapOutputs.empty())
+        return false;
+
+    const CDiskCoin& coin = mapOutputs.begin()->second;
+    coins.fCoinBase = coin.fCoinBase;
+    coins.fCoinStake = coin.fCoinStake;
+    coins.nHeight = coin.nHeight;
+    coins.nVersion = coin.nVersion;
+    coins.vout.assign(mapOutputs.rbegin()->first + 1, CTxOut());
+    for (const auto& it : mapOutputs)
+        coins.vout[it.first] = it.second.out;
+    return true;
 }
 
 bool CCoinsViewDB::HaveCoins(const uint256& txid) const
 {
-    return db.Exists(std::make_pair('c', txid));
+    CDataStream ssPrefix(SER_DISK, CLIENT_VERSION);
+    ssPrefix << std::make_pair('C', txid);
+    leveldb::Slice slPrefix(&ssPrefix[0], ssPrefix.size());
+
+    boost::scoped_ptr<leveldb::Iterator> pcursor(const_cast<CLevelDBWrapper*>(&db)->NewIterator(true));
+    pcursor->Seek(slPrefix);
+    return pcursor->Valid() && pcursor->key().starts_with(slPrefix);
 }
 
 uint256 CCoinsViewDB::GetBestBlock() const
@@ -52,26 +110,121 @@ uint256 CCoinsViewDB::GetBestBlock() const
 }
 
 bool CCoinsViewDB::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock)
+{
+    bool fOk = WriteCoins(mapCoins, hashBlock);
+    mapCoins.clear();
+    return fOk;
+}
+
+bool CCoinsViewDB::WriteCoins(const CCoinsMap& mapCoins, const uint256& hashBlock)
 {
     CLevelDBBatch batch;
     size_t count = 0;
     size_t changed = 0;
-    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end();) {
+    size_t nWritten = 0;
+    size_t nErased = 0;
+    for (CCoinsMap::const_iterator it = mapCoins.begin(); it != mapCoins.end(); it++) {
         if (it->second.flags & CCoinsCacheEntry::DIRTY) {
-            BatchWriteCoins(batch, it->first, it->second.coins);
+            // Unspent outputs are (re)written and spent ones erased, straight from the
+            // entry. Only the outputs of the version it was fetched as can be on disk,
+            // none for a fresh entry.
+            const CCoins& coins = it->second.coins;
+            const unsigned int nOnDisk = (it->second.flags & CCoinsCacheEntry::FRESH) ? 0 : it->second.nParentOutputs;
+            for (unsigned int i = 0; i < std::max((unsigned int)coins.vout.size(), nOnDisk); i++) {
+                if (i < coins.vout.size() && !coins.vout[i].IsNull()) {
+                    batch.Write(CoinEntry(it->first, i), CDiskCoin(coins, i));
+                    nWritten++;
+                } else if (i < nOnDisk) {
+                    batch.Erase(CoinEntry(it->first, i));
+                    nErased++;
+                }
+            }
             changed++;
         }
         count++;
-        CCoinsMap::iterator itOld = it++;
-        mapCoins.erase(itOld);
     }
+    // The best block marker goes in the same atomic batch as the coins it describes.
     if (hashBlock != uint256(0))
         BatchWriteHashBestChain(batch, hashBlock);
 
-    LogPrint("coindb", "Committing %u changed transactions (out of %u) to coin database...\n", (unsigned int)changed, (unsigned int)count);
+    LogPrint("coindb", "Committing %u changed transactions (out of %u) to coin database: %u outputs written, %u erased...\n",
+        (unsigned int)changed, (unsigned int)count, (unsigned int)nWritten, (unsigned int)nErased);
     return db.WriteBatch(batch);
 }
 
+bool CCoinsViewDB::Upgrade()
+{
+    // Records of the old format are keyed 'c' + txid; seek to the first one left.
+    CDataStream ssPrefix(SER_DISK, CLIENT_VERSION);
+    ssPrefix << 'c';
+    leveldb::Slice slPrefix(&ssPrefix[0], ssPrefix.size());
+
+    boost::scoped_ptr<leveldb::Iterator> pcursor(db.NewIterator());
+    pcursor->Seek(slPrefix);
+    if (!pcursor->Valid() || !pcursor->key().starts_with(slPrefix))
+        return true;
+
+    LogPrintf("Upgrading chainstate database to per-output records...\n");
+    uiInterface.InitMessage(_("Upgrading chainstate database..."));
+    // Each batch converts and erases whole transactions, so an interrupted
+    // upgrade simply carries on from the first record left on the next start.
+    static const size_t UPGRADE_BATCH_TRANSACTIONS = 10000;
+    CLevelDBBatch batch;
+    size_t nBatch = 0;
+    uint64_t nTransactions = 0;
+    uint64_t nOutputs = 0;
+    int nReportedProgress = -1;
+    for (; pcursor->Valid() && pcursor->key().starts_with(slPrefix); pcursor->Next()) {
+        boost::this_thread::interruption_point();
+        if (ShutdownRequested())
+            break;
+        leveldb::Slice slKey = pcursor->key();
+        leveldb::Slice slValue = pcursor->value();
+        CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
+        CDataStream ssValue(slValue.data(), slValue.data() + slValue.size(), SER_DISK, CLIENT_VERSION);
+        char chType;
+        uint256 txid;
+        CCoins coins;
+        try {
+            ssKey >> chType >> txid;
+            ssValue >> coins;
+        } catch (const std::exception& e) {
+            return error("%s : Deserialize or I/O error - %s", __func__, e.what());
+        }
+
+        for (unsigned int i = 0; i < coins.vout.size(); i++) {
+            if (!coins.vout[i].IsNull()) {
+                batch.Write(CoinEntry(txid, i), CDiskCoin(coins, i));
+                nOutputs++;
+            }
+        }
+        batch.Erase(std::make_pair('c', txid));
+        nTransactions++;
+
+        if (++nBatch >= UPGRADE_BATCH_TRANSACTIONS) {
+            if (!db.WriteBatch(batch))
+                return error("%s : failed to write upgraded records", __func__);
+            batch.Clear();
+            nBatch = 0;
+            // Records are ordered by txid, whose first serialized byte tells how far along we are.
+            int nProgress = *txid.begin() * 100 / 256;
+            if (nProgress != nReportedProgress) {
+                uiInterface.InitMessage(strprintf(_("Upgrading chainstate database... %d%%"), nProgress));
+                LogPrintf("Upgrading chainstate database... %d%%\n", nProgress);
+                nReportedProgress = nProgress;
+            }
+        }
+    }
+    if (!db.WriteBatch(batch))
+        return error("%s : failed to write upgraded records", __func__);
+    if (ShutdownRequested()) {
+        LogPrintf("Chainstate upgrade interrupted after %u transactions, it will resume on the next start\n", nTransactions);
+        return false;
+    }
+    LogPrintf("Upgraded %u transactions (%u outputs) to per-output records\n", nTransactions, nOutputs);
+    return true;
+}
+
 CBlockTreeDB::CBlockTreeDB(size_t nCacheSize, bool fMemory, bool fWipe) : CLevelDBWrapper(GetDataDir() / "blocks" / "index", nCacheSize, fMemory, fWipe)
 {
 }
@@ -105,6 +258,179 @@ bool CBlockTreeDB::ReadLastBlockFile(int& nFile)
     return Read('l', nFile);
 }
 
+CCoinsViewBackgroundWriter::CCoinsViewBackgroundWriter(CCoinsViewDB* dbIn) : CCoinsViewBacked(dbIn), db(dbIn), hashPending(0), nPendingUsage(0), fCoinsPending(false), fRunning(false), fBusy(false), fFailed(false)
+{
+}
+
+bool CCoinsViewBackgroundWriter::GetCoins(const uint256& txid, CCoins& coins) const
+{
+    {
+        boost::unique_lock<boost::mutex> lock(cs);
+        CCoinsMap::const_iterator it = mapPending.find(txid);
+        if (it != mapPending.end() && (it->second.flags & CCoinsCacheEntry::DIRTY)) {
+            if (it->second.coins.IsPruned())
+                return false;
+            coins = it->second.coins;
+            return true;
+        }
+    }
+    return base->GetCoins(txid, coins);
+}
+
+bool CCoinsViewBackgroundWriter::HaveCoins(const uint256& txid) const
+{
+    {
+        boost::unique_lock<boost::mutex> lock(cs);
+        CCoinsMap::const_iterator it = mapPending.find(txid);
+        if (it != mapPending.end() && (it->second.flags & CCoinsCacheEntry::DIRTY))
+            return !it->second.coins.IsPruned();
+    }
+    return base->HaveCoins(txid);
+}
+
+uint256 CCoinsViewBackgroundWriter::GetBestBlock() const
+{
+    {
+        boost::unique_lock<boost::mutex> lock(cs);
+        if (fCoinsPending && hashPending != uint256(0))
+            return hashPending;
+    }
+    return base->GetBestBlock();
+}
+
+bool CCoinsViewBackgroundWriter::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock)
+{
+    // Losing a batch halfway through a flush is not an option; hold off interruption.
+    boost::this_thread::disable_interruption di;
+    boost::unique_lock<boost::mutex> lock(cs);
+    // One coins batch in flight at a time: the previous one must reach the disk first.
+    if (!WaitForQueue(lock, true))
+        return false;
+    mapPending.swap(mapCoins);
+    mapCoins.clear();
+    nPendingUsage = memusage::DynamicUsage(mapPending);
+    for (CCoinsMap::const_iterator it = mapPending.begin(); it != mapPending.end(); ++it)
+        nPendingUsage += it->second.coins.DynamicMemoryUsage();
+    hashPending = hashBlock;
+    fCoinsPending = true;
+    queue.push_back(std::make_pair(boost::bind(&CCoinsViewBackgroundWriter::WritePending, this), true));
+    cond.notify_all();
+    return fRunning || WaitForQueue(lock, false);
+}
+
+bool CCoinsViewBackgroundWriter::GetStats(CCoinsStats& stats) const
+{
+    if (!const_cast<CCoinsViewBackgroundWriter*>(this)->Sync())
+        return false;
+    return base->GetStats(stats);
+}
+
+size_t CCoinsViewBackgroundWriter::DynamicMemoryUsage() const
+{
+    boost::unique_lock<boost::mutex> lock(cs);
+    return nPendingUsage;
+}
+
+bool CCoinsViewBackgroundWriter::Queue(const boost::function<bool()>& fn)
+{
+    boost::this_thread::disable_interruption di;
+    boost::unique_lock<boost::mutex> lock(cs);
+    if (fFailed)
+        return false;
+    queue.push_back(std::make_pair(fn, false));
+    cond.notify_all();
+    return fRunning || WaitForQueue(lock, false);
+}
+
+bool CCoinsViewBackgroundWriter::Sync()
+{
+    boost::this_thread::disable_interruption di;
+    boost::unique_lock<boost::mutex> lock(cs);
+    return WaitForQueue(lock, false);
+}
+
+bool CCoinsViewBackgroundWriter::WritePending()
+{
+    // mapPending is left untouched until this returns, so readers may keep using it meanwhile.
+    return db->WriteCoins(mapPending, hashPending);
+}
+
+void CCoinsViewBackgroundWriter::RunFront(boost::unique_lock<boost::mutex>& lock)
+{
+    boost::this_thread::disable_interruption di;
+    std::pair<boost::function<bool()>, bool> task = queue.front();
+    fBusy = true;
+    lock.unlock();
+    bool fOk = false;
+    try {
+        fOk = task.first();
+    } catch (const std::exception& e) {
+        LogPrintf("%s : %s\n", __func__, e.what());
+    }
+    lock.lock();
+    fBusy = false;
+    if (!fOk) {
+        // Leave the failed write queued (and its coins readable); the next flush reports it.
+        error("%s : failed to write chainstate", __func__);
+        fFailed = true;
+    } else {
+        queue.pop_front();
+        if (task.second) {
+            mapPending.clear();
+            nPendingUsage = 0;
+            hashPending = 0;
+            fCoinsPending = false;
+        }
+    }
+    cond.notify_all();
+}
+
+bool CCoinsViewBackgroundWriter::WaitForQueue(boost::unique_lock<boost::mutex>& lock, bool fCoinsOnly)
+{
+    while (!queue.empty() && !fFailed && (!fCoinsOnly || fCoinsPending)) {
+        if (fRunning || fBusy)
+            cond.wait(lock);
+        else
+            RunFront(lock);
+    }
+    return !fFailed;
+}
+
+void CCoinsViewBackgroundWriter::ThreadWrite()
+{
+    boost::unique_lock<boost::mutex> lock(cs);
+    fRunning = true;
+    try {
+        while (true) {
+            while (queue.empty() || fBusy || fFailed)
+                cond.wait(lock);
+            RunFront(lock);
+        }
+    } catch (...) {
+        // Whatever is still queued gets written inline by the next Sync.
+        fRunning = false;
+        cond.notify_all();
+        throw;
+    }
+}
+
+void static ApplyStats(CCoinsStats& stats, CHashWriter& ss, const uint256& txhash, const std::map<uint32_t, CDiskCoin>& mapOutputs)
+{
+    const CDiskCoin& coin = mapOutputs.begin()->second;
+    ss << txhash;
+    ss << VARINT(coin.nVersion);
+    ss << (coin.fCoinBase ? 'c' : 'n');
+    ss << VARINT(coin.nHeight);
+    stats.nTransactions++;
+    for (const auto& it : mapOutputs) {
+        stats.nTransactionOutputs++;
+        ss << VARINT(it.first + 1);
+        ss << it.second.out;
+        stats.nTotalAmount += it.second.out.nValue;
+    }
+    ss << VARINT(0);
+}
+
 bool CCoinsViewDB::GetStats(CCoinsStats& stats) const
 {
     /* It seems that there are no "const iterators" for LevelDB.  Since we
@@ -116,57 +442,48 @@ bool CCoinsViewDB::GetStats(CCoinsStats& stats) const
     CHashWriter ss(SER_GETHASH, PROTOCOL_VERSION);
     stats.hashBlock = GetBestBlock();
     ss << stats.hashBlock;
-    CAmount nTotalAmount = 0;
+    stats.nTotalAmount = 0;
+    // Outputs of one transaction are adjacent; hash them per transaction as before.
+    uint256 prevhash = 0;
+    std::map<uint32_t, CDiskCoin> mapOutputs;
     while (pcursor->Valid()) {
         boost::this_thread::interruption_point();
         try {
             leveldb::Slice slKey = pcursor->key();
-            CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
-            char chType;
-            ssKey >> chType;
-            if (chType == 'c') {
+            if (slKey.size() > 0 && slKey.data()[0] == 'C') {
+                CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
                 leveldb::Slice slValue = pcursor->value();
                 CDataStream ssValue(slValue.data(), slValue.data() + slValue.size(), SER_DISK, CLIENT_VERSION);
-                CCoins coins;
-                ssValue >> coins;
-                uint256 txhash;
-                ssKey >> txhash;
-                ss << txhash;
-                ss << VARINT(coins.nVersion);
-                ss << (coins.fCoinBase ? 'c' : 'n');
-                ss << VARINT(coins.nHeight);
-                stats.nTransactions++;
-                for (unsigned int i = 0; i < coins.vout.size(); i++) {
-                    const CTxOut& out = coins.vout[i];
-                    if (!out.IsNull()) {
-                        stats.nTransactionOutputs++;
-                        ss << VARINT(i + 1);
-                        ss << out;
-                        nTotalAmount += out.nValue;
-                    }
+                CoinEntry entry;
+                ssKey >> entry;
+                if (!mapOutputs.empty() && entry.hash != prevhash) {
+                    ApplyStats(stats, ss, prevhash, mapOutputs);
+                    mapOutputs.clear();
                 }
+                prevhash = entry.hash;
+                ssValue >> mapOutputs[entry.n];
                 stats.nSerializedSize += 32 + slValue.size();
-                ss << VARINT(0);
             }
             pcursor->Next();
         } catch (const std::exception& e) {
             return error("%s : Deserialize or I/O error - %s", __func__, e.what());
         }
     }
+    if (!mapOutputs.empty())
+        ApplyStats(stats, ss, prevhash, mapOutputs);
     stats.nHeight = mapBlockIndex.find(GetBestBlock())->second->nHeight;
     stats.hashSerialized = ss.GetHash();
-    stats.nTotalAmount = nTotalAmount;
     return true;
 }
 
-bool CBlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, const CBlockFileInfo*> >& fileInfo, int nLastFile, const std::vector<const CBlockIndex*>& blockinfo) {
+bool CBlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, CBlockFileInfo> >& fileInfo, int nLastFile, const std::vector<std::pair<uint256, CDiskBlockIndex> >& blockinfo) {
     CLevelDBBatch batch;
-    for (std::vector<std::pair<int, const CBlockFileInfo*> >::const_iterator it=fileInfo.begin(); it != fileInfo.end(); it++) {
-        batch.Write(std::make_pair('f', it->first), *it->second);
+    for (std::vector<std::pair<int, CBlockFileInfo> >::const_iterator it=fileInfo.begin(); it != fileInfo.end(); it++) {
+        batch.Write(std::make_pair('f', it->first), it->second);
     }
     batch.Write('l', nLastFile);
-    for (std::vector<const CBlockIndex*>::const_iterator it=blockinfo.begin(); it != blockinfo.end(); it++) {
-        batch.Write(std::make_pair('b', (*it)->GetBlockHash()), CDiskBlockIndex(*it));
+    for (std::vector<std::pair<uint256, CDiskBlockIndex> >::const_iterator it=blockinfo.begin(); it != blockinfo.end(); it++) {
+        batch.Write(std::make_pair('b', it->first), it->second);
     }
     return WriteBatch(batch, true);
 }
@@ -291,17 +608,122 @@ bool CBlockTreeDB::LoadBlockIndexGuts()
     return true;
 }
 
+void CZerocoinHashFilter::Reset(size_t nCapacityIn)
+{
+    nCapacity = nCapacityIn;
+    nElements = 0;
+    nBits = std::max<uint64_t>(64, (uint64_t)nCapacity * BITS_PER_ELEMENT);
+    vData.assign((nBits + 63) / 64, 0);
+}
+
+void CZerocoinHashFilter::Insert(const uint256& hash)
+{
+    if (vData.empty())
+        return;
+    for (unsigned int i = 0; i < NUM_HASHES; i++) {
+        uint64_t nIndex = hash.Get64(i) % nBits;
+        vData[nIndex >> 6] |= ((uint64_t)1) << (nIndex & 63);
+    }
+    nElements++;
+}
+
+bool CZerocoinHashFilter::MaybeContains(const uint256& hash) const
+{
+    if (vData.empty())
+        return true;
+    for (unsigned int i = 0; i < NUM_HASHES; i++) {
+        uint64_t nIndex = hash.Get64(i) % nBits;
+        if (!(vData[nIndex >> 6] & (((uint64_t)1) << (nIndex & 63))))
+            return false;
+    }
+    return true;
+}
+
 CZerocoinDB::CZerocoinDB(size_t nCacheSize, bool fMemory, bool fWipe) : CLevelDBWrapper(GetDataDir() / "zerocoin", nCacheSize, fMemory, fWipe)
 {
+    fFilterLoaded = false;
+}
+
+bool CZerocoinDB::LoadFilter(char type, size_t nMinCapacity)
+{
+    // Collect the hashes first so the filter can be sized with room to grow
+    std::vector<uint256> vHashes;
+    boost::scoped_ptr<leveldb::Iterator> pcursor(NewIterator());
+    CDataStream ssKeySet(SER_DISK, CLIENT_VERSION);
+    ssKeySet << std::make_pair(type, uint256(0));
+    pcursor->Seek(ssKeySet.str());
+    while (pcursor->Valid()) {
+        try {
+            leveldb::Slice slKey = pcursor->key();
+            CDataStream ssKey(slKey.data(), slKey.data() + slKey.size(), SER_DISK, CLIENT_VERSION);
+            char chType;
+            ssKey >> chType;
+            if (chType != type)
+                break;
+            uint256 hash;
+            ssKey >> hash;
+            vHashes.push_back(hash);
+            pcursor->Next();
+        } catch (const std::exception& e) {
+            return error("%s : Deserialize or I/O error - %s", __func__, e.what());
+        }
+    }
+
+    CZerocoinHashFilter& filter = GetFilter(type);
+    filter.Reset(std::max(nMinCapacity, vHashes.size() * 2));
+    for (const uint256& hash : vHashes)
+        filter.Insert(hash);
+
+    LogPrint("zero", "%s : loaded %u '%c' entries, capacity %u\n", __func__, vHashes.size(), type, filter.GetCapacity());
+    return true;
+}
+
+bool CZerocoinDB::LoadFilters()
+{
+    static const size_t MIN_FILTER_CAPACITY = 100000;
+
+    LOCK(cs_filter);
+    fFilterLoaded = false;
+    if (!LoadFilter('m', MIN_FILTER_CAPACITY) || !LoadFilter('s', MIN_FILTER_CAPACITY))
+        return false;
+    fFilterLoaded = true;
+    return true;
+}
+
+void CZerocoinDB::ReserveFilter(char type, size_t nNewEntries)
+{
+    // Rebuilt from the database before any entry of the batch is added, as those
+    // are not in the database yet. If the rebuild fails the old filter is kept; it
+    // still holds every entry, only with more false positives.
+    CZerocoinHashFilter& filter = GetFilter(type);
+    if (fFilterLoaded && !filter.HasRoomFor(nNewEntries))
+        LoadFilter(type, std::max(filter.GetCapacity() * 2, nNewEntries * 2));
+}
+
+void CZerocoinDB::AddToFilter(char type, const uint256& hash)
+{
+    // Must be called before the entry is written, so that a reader never sees it in
+    // the database while the filter still rules it out.
+    if (fFilterLoaded)
+        GetFilter(type).Insert(hash);
+}
+
+bool CZerocoinDB::MaybeHasCoin(char type, const uint256& hash)
+{
+    LOCK(cs_filter);
+    return !fFilterLoaded || GetFilter(type).MaybeContains(hash);
 }
 
 bool CZerocoinDB::WriteCoinMintBatch(const std::vector<std::pair<libzerocoin::PublicCoin, uint256> >& mintInfo)
 {
     CLevelDBBatch batch;
     size_t count = 0;
+    LOCK(cs_filter);
+    ReserveFilter('m', mintInfo.size());
     for (std::vector<std::pair<libzerocoin::PublicCoin, uint256> >::const_iterator it=mintInfo.begin(); it != mintInfo.end(); it++) {
         libzerocoin::PublicCoin pubCoin = it->first;
         uint256 hash = GetPubCoinHash(pubCoin.getValue());
+        AddToFilter('m', hash);
         batch.Write(std::make_pair('m', hash), it->second);
         ++count;
     }
@@ -317,6 +739,8 @@ bool CZerocoinDB::ReadCoinMint(const CBigNum& bnPubcoin, uint256& hashTx)
 
 bool CZerocoinDB::ReadCoinMint(const uint256& hashPubcoin, uint256& hashTx)
 {
+    if (!MaybeHasCoin('m', hashPubcoin))
+        return false;
     return Read(std::make_pair('m', hashPubcoin), hashTx);
 }
 
@@ -330,11 +754,14 @@ bool CZerocoinDB::WriteCoinSpendBatch(const std::vector<std::pair<libzerocoin::C
 {
     CLevelDBBatch batch;
     size_t count = 0;
+    LOCK(cs_filter);
+    ReserveFilter('s', spendInfo.size());
     for (std::vector<std::pair<libzerocoin::CoinSpend, uint256> >::const_iterator it=spendInfo.begin(); it != spendInfo.end(); it++) {
         CBigNum bnSerial = it->first.getCoinSerialNumber();
         CDataStream ss(SER_GETHASH, 0);
         ss << bnSerial;
         uint256 hash = Hash(ss.begin(), ss.end());
+        AddToFilter('s', hash);
         batch.Write(std::make_pair('s', hash), it->second);
         ++count;
     }
@@ -349,11 +776,13 @@ bool CZerocoinDB::ReadCoinSpend(const CBigNum& bnSerial, uint256& txHash)
     ss << bnSerial;
     uint256 hash = Hash(ss.begin(), ss.end());
 
-    return Read(std::make_pair('s', hash), txHash);
+    return ReadCoinSpend(hash, txHash);
 }
 
 bool CZerocoinDB::ReadCoinSpend(const uint256& hashSerial, uint256 &txHash)
 {
+    if (!MaybeHasCoin('s', hashSerial))
+        return false;
     return Read(std::make_pair('s', hashSerial), txHash);
 }
 
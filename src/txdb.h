@@ -7,15 +7,21 @@
 #ifndef BITCOIN_TXDB_H
 #define BITCOIN_TXDB_H
 
+#include "compressor.h"
 #include "leveldbwrapper.h"
 #include "main.h"
 #include "zpiv/zerocoin.h"
 
+#include <deque>
 #include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
 class CCoins;
 class uint256;
 
@@ -26,7 +32,51 @@ static const int64_t nMaxDbCache = sizeof(void*) > 4 ? 4096 : 1024;
 //! min. -dbcache in (MiB)
 static const int64_t nMinDbCache = 4;
 
-/** CCoinsView backed by the LevelDB coin database (chainstate/) */
+/**
+ * A single unspent output as stored in the coin database, together with the
+ * metadata of the transaction it belongs to.
+ *
+ * Serialized format:
+ * - VARINT(nHeight * 4 + fCoinBase * 2 + fCoinStake)
+ * - VARINT(nVersion)
+ * - the CTxOut (via CTxOutCompressor)
+ */
+class CDiskCoin
+{
+public:
+    CTxOut out;
+    int nHeight;
+    int nVersion;
+    bool fCoinBase;
+    bool fCoinStake;
+
+    CDiskCoin() : nHeight(0), nVersion(0), fCoinBase(false), fCoinStake(false) {}
+    CDiskCoin(const CCoins& coins, unsigned int n) : out(coins.vout[n]), nHeight(coins.nHeight), nVersion(coins.nVersion), fCoinBase(coins.fCoinBase), fCoinStake(coins.fCoinStake) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action, int nType, int nVersionIn)
+    {
+        uint64_t nCode = (uint64_t)nHeight * 4 + (fCoinBase ? 2 : 0) + (fCoinStake ? 1 : 0);
+        READWRITE(VARINT(nCode));
+        if (ser_action.ForRead()) {
+            nHeight = nCode >> 2;
+            fCoinBase = (nCode & 2) != 0;
+            fCoinStake = (nCode & 1) != 0;
+        }
+        READWRITE(VARINT(nVersion));
+        READWRITE(REF(CTxOutCompressor(out)));
+    }
+};
+
+/**
+ * CCoinsView backed by the LevelDB coin database (chainstate/)
+ *
+ * Every unspent output is its own record, keyed by its outpoint, so spending
+ * one output of a transaction only touches that output on disk. Databases in
+ * the older one-record-per-transaction format are converted by Upgrade().
+ */
 class CCoinsViewDB : public CCoinsView
 {
 protected:
@@ -40,6 +90,73 @@ public:
     uint256 GetBestBlock() const;
     bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock);
     bool GetStats(CCoinsStats& stats) const;
+
+    //! Write the dirty entries of mapCoins and the best block marker in one atomic batch
+    bool WriteCoins(const CCoinsMap& mapCoins, const uint256& hashBlock);
+
+    //! Convert per-transaction records to per-output records; resumes an interrupted conversion
+    bool Upgrade();
+
+private:
+    //! Read all outputs of txid currently on disk
+    void ReadOutputs(const uint256& txid, std::map<uint32_t, CDiskCoin>& mapOutputs) const;
+};
+
+/**
+ * Writes chainstate batches to the coin database on a background thread.
+ *
+ * A batch handed over through BatchWrite stays readable here until it is on
+ * disk, so the views on top never see the database lag behind, and validation
+ * carries on filling a fresh cache while it is written. Other writes that must
+ * precede the coins (the block index) are queued with Queue and run in order.
+ * A failed write stops the writer and is reported by the next BatchWrite,
+ * Queue or Sync.
+ */
+class CCoinsViewBackgroundWriter : public CCoinsViewBacked
+{
+private:
+    CCoinsViewDB* db;
+
+    mutable boost::mutex cs;
+    mutable boost::condition_variable cond;
+    //! Pending writes, run in order; the flag marks the coins batch
+    std::deque<std::pair<boost::function<bool()>, bool> > queue;
+    //! Coins batch queued or being written (read-only while a write is in progress)
+    CCoinsMap mapPending;
+    uint256 hashPending;
+    //! Memory held by mapPending
+    size_t nPendingUsage;
+    bool fCoinsPending;
+    //! The background thread is running
+    bool fRunning;
+    //! A write is in progress (with cs released)
+    bool fBusy;
+    bool fFailed;
+
+    bool WritePending();
+    //! Run the front of the queue with cs released
+    void RunFront(boost::unique_lock<boost::mutex>& lock);
+    //! Drive the queue (inline when the thread is not running) until it is empty, or only until the coins batch is written
+    bool WaitForQueue(boost::unique_lock<boost::mutex>& lock, bool fCoinsOnly);
+
+public:
+    CCoinsViewBackgroundWriter(CCoinsViewDB* dbIn);
+
+    bool GetCoins(const uint256& txid, CCoins& coins) const;
+    bool HaveCoins(const uint256& txid) const;
+    uint256 GetBestBlock() const;
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock);
+    bool GetStats(CCoinsStats& stats) const;
+
+    //! Memory held by the coins batch queued or being written, to count along with the cache on top
+    size_t DynamicMemoryUsage() const;
+
+    //! Queue a write to run before any coins batch handed over later
+    bool Queue(const boost::function<bool()>& fn);
+    //! Wait until everything queued is on disk (writing it inline if the thread is not running)
+    bool Sync();
+    //! Background thread body
+    void ThreadWrite();
 };
 
 /** Access to the block database (blocks/index/) */
@@ -54,7 +171,7 @@ private:
 
 public:
     bool WriteBlockIndex(const CDiskBlockIndex& blockindex);
-    bool WriteBatchSync(const std::vector<std::pair<int, const CBlockFileInfo*> >& fileInfo, int nLastFile, const std::vector<const CBlockIndex*>& blockinfo);
+    bool WriteBatchSync(const std::vector<std::pair<int, CBlockFileInfo> >& fileInfo, int nLastFile, const std::vector<std::pair<uint256, CDiskBlockIndex> >& blockinfo);
     bool ReadBlockFileInfo(int nFile, CBlockFileInfo& fileinfo);
     bool ReadLastBlockFile(int& nFile);
     bool WriteReindexing(bool fReindex);
@@ -68,6 +185,34 @@ public:
     bool LoadBlockIndexGuts();
 };
 
+/**
+ * Bloom filter over the hashes of the zerocoin mints or spends kept in the zerocoinDB.
+ * The keys are already uniformly distributed hashes, so the bit positions are taken
+ * directly from their 64 bit words. Entries cannot be removed; erased coins are left
+ * as false positives for the database lookup to settle.
+ */
+class CZerocoinHashFilter
+{
+public:
+    //! bits per element and hash functions, for a false positive rate of about 0.25%
+    static const unsigned int BITS_PER_ELEMENT = 16;
+    static const unsigned int NUM_HASHES = 4;
+
+    CZerocoinHashFilter() : nBits(0), nElements(0), nCapacity(0) {}
+
+    void Reset(size_t nCapacityIn);
+    void Insert(const uint256& hash);
+    bool MaybeContains(const uint256& hash) const;
+    size_t GetCapacity() const { return nCapacity; }
+    bool HasRoomFor(size_t n) const { return nElements + n <= nCapacity; }
+
+private:
+    std::vector<uint64_t> vData;
+    uint64_t nBits;
+    size_t nElements;
+    size_t nCapacity;
+};
+
 /** Zerocoin database (zerocoin/) */
 class CZerocoinDB : public CLevelDBWrapper
 {
@@ -78,7 +223,21 @@ private:
     CZerocoinDB(const CZerocoinDB&);
     void operator=(const CZerocoinDB&);
 
+    //! In memory prefilters answering the common "not in the database" case without a LevelDB read
+    CCriticalSection cs_filter;
+    bool fFilterLoaded;
+    CZerocoinHashFilter mintFilter;
+    CZerocoinHashFilter spendFilter;
+
+    CZerocoinHashFilter& GetFilter(char type) { return type == 'm' ? mintFilter : spendFilter; }
+    bool LoadFilter(char type, size_t nMinCapacity);
+    void ReserveFilter(char type, size_t nNewEntries);
+    void AddToFilter(char type, const uint256& hash);
+    bool MaybeHasCoin(char type, const uint256& hash);
+
 public:
+    /** Build the mint and spend prefilters from the database. Lookups go to LevelDB until this is done. */
+    bool LoadFilters();
     /** Write zPIV mints to the zerocoinDB in a batch */
     bool WriteCoinMintBatch(const std::vector<std::pair<libzerocoin::PublicCoin, uint256> >& mintInfo);
     bool ReadCoinMint(const CBigNum& bnPubcoin, uint256& txHash);
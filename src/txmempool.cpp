@@ -626,6 +626,39 @@ void CTxMemPool::queryHashes(std::vector<uint256>& vtxid)
         vtxid.push_back((*mi).first);
 }
 
+void CTxMemPool::queryEntriesInDependencyOrder(std::vector<CTxMemPoolEntry>& vEntries) const
+{
+    vEntries.clear();
+
+    LOCK(cs);
+    vEntries.reserve(mapTx.size());
+    std::set<uint256> setDone;
+    // Depth-first walk over the in-pool parents, an entry is emitted once all of them are
+    std::vector<std::pair<std::map<uint256, CTxMemPoolEntry>::const_iterator, bool> > vStack;
+    for (std::map<uint256, CTxMemPoolEntry>::const_iterator mi = mapTx.begin(); mi != mapTx.end(); ++mi) {
+        vStack.push_back(std::make_pair(mi, false));
+        while (!vStack.empty()) {
+            std::map<uint256, CTxMemPoolEntry>::const_iterator it = vStack.back().first;
+            if (setDone.count(it->first)) {
+                vStack.pop_back();
+                continue;
+            }
+            if (vStack.back().second) {
+                vStack.pop_back();
+                setDone.insert(it->first);
+                vEntries.push_back(it->second);
+                continue;
+            }
+            vStack.back().second = true;
+            for (const CTxIn& txin : it->second.GetTx().vin) {
+                std::map<uint256, CTxMemPoolEntry>::const_iterator itParent = mapTx.find(txin.prevout.hash);
+                if (itParent != mapTx.end() && !setDone.count(itParent->first))
+                    vStack.push_back(std::make_pair(itParent, false));
+            }
+        }
+    }
+}
+
 void CTxMemPool::getTransactions(std::set<uint256>& setTxid)
 {
     setTxid.clear();
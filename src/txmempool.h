@@ -128,6 +128,8 @@ public:
     void removeForBlock(const std::vector<CTransaction>& vtx, unsigned int nBlockHeight, std::list<CTransaction>& conflicts);
     void clear();
     void queryHashes(std::vector<uint256>& vtxid);
+    /** Get copies of all entries, every transaction after the in-pool transactions it spends */
+    void queryEntriesInDependencyOrder(std::vector<CTxMemPoolEntry>& vEntries) const;
     void getTransactions(std::set<uint256>& setTxid);
     void pruneSpent(const uint256& hash, CCoins& coins);
     unsigned int GetTransactionsUpdated() const;
@@ -6,6 +6,17 @@
 
 #include "validationinterface.h"
 
+#include "primitives/block.h"
+#include "util.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 static CMainSignals g_signals;
 
 CMainSignals& GetMainSignals()
@@ -13,45 +24,239 @@ CMainSignals& GetMainSignals()
     return g_signals;
 }
 
+namespace {
+
+/** Callbacks run one at a time, in the order they were added, by a single thread */
+class CValidationInterfaceQueue
+{
+public:
+    CValidationInterfaceQueue() : fRunning(false), fStopping(false), fBusy(false) {}
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(cs);
+        assert(!fRunning);
+        fRunning = true;
+        fStopping = false;
+        thread = std::thread(&TraceThread<std::function<void()> >, "valqueue", std::function<void()>(std::bind(&CValidationInterfaceQueue::ThreadRun, this)));
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(cs);
+            if (!fRunning)
+                return;
+            fStopping = true;
+        }
+        cond.notify_all();
+        thread.join();
+        std::lock_guard<std::mutex> lock(cs);
+        fRunning = false;
+    }
+
+    bool IsRunning()
+    {
+        std::lock_guard<std::mutex> lock(cs);
+        return fRunning;
+    }
+
+    /** Queue func, or run it right away if the thread isn't running */
+    void Add(std::function<void()> func)
+    {
+        {
+            std::lock_guard<std::mutex> lock(cs);
+            if (fRunning) {
+                queue.push_back(std::move(func));
+                cond.notify_one();
+                return;
+            }
+        }
+        func();
+    }
+
+    void Sync()
+    {
+        std::shared_ptr<std::promise<void> > done = std::make_shared<std::promise<void> >();
+        std::future<void> future = done->get_future();
+        {
+            std::lock_guard<std::mutex> lock(cs);
+            if (!fRunning || (queue.empty() && !fBusy) || std::this_thread::get_id() == thread.get_id())
+                return;
+            queue.push_back([done] { done->set_value(); });
+        }
+        cond.notify_one();
+        future.wait();
+    }
+
+private:
+    std::mutex cs;
+    std::condition_variable cond;
+    std::deque<std::function<void()> > queue;
+    bool fRunning;
+    bool fStopping;
+    //! Whether a callback is being run
+    bool fBusy;
+    std::thread thread;
+
+    void ThreadRun()
+    {
+        while (true) {
+            std::function<void()> func;
+            {
+                std::unique_lock<std::mutex> lock(cs);
+                fBusy = false;
+                while (queue.empty() && !fStopping)
+                    cond.wait(lock);
+                if (queue.empty())
+                    return;
+                func = std::move(queue.front());
+                queue.pop_front();
+                fBusy = true;
+            }
+            try {
+                func();
+            } catch (const std::exception& e) {
+                PrintExceptionContinue(&e, "valqueue");
+            } catch (...) {
+                PrintExceptionContinue(NULL, "valqueue");
+            }
+        }
+    }
+};
+
+CValidationInterfaceQueue validationQueue;
+
+/**
+ * The transactions of a connected block are synced one by one with the same block;
+ * they share a single copy of it while they wait in the queue.
+ */
+std::mutex cs_sharedBlock;
+const CBlock* pSharedBlockSource = NULL;
+std::shared_ptr<const CBlock> sharedBlock;
+
+std::shared_ptr<const CBlock> ShareBlock(const CBlock* pblock)
+{
+    if (!pblock)
+        return std::shared_ptr<const CBlock>();
+    std::lock_guard<std::mutex> lock(cs_sharedBlock);
+    if (pblock != pSharedBlockSource || !sharedBlock || pblock->GetHash() != sharedBlock->GetHash()) {
+        pSharedBlockSource = pblock;
+        sharedBlock = std::make_shared<const CBlock>(*pblock);
+    }
+    return sharedBlock;
+}
+
+} // anon namespace
+
+void StartValidationInterfaceQueue()
+{
+    validationQueue.Start();
+}
+
+void StopValidationInterfaceQueue()
+{
+    validationQueue.Stop();
+    std::lock_guard<std::mutex> lock(cs_sharedBlock);
+    pSharedBlockSource = NULL;
+    sharedBlock.reset();
+}
+
+void SyncWithValidationInterfaceQueue()
+{
+    validationQueue.Sync();
+}
+
+void CMainSignals::UpdatedBlockTip(const CBlockIndex *pindex, const CBlock *pblock)
+{
+    if (!validationQueue.IsRunning())
+        return m_UpdatedBlockTip(pindex, pblock);
+    std::shared_ptr<const CBlock> block = ShareBlock(pblock);
+    validationQueue.Add([this, pindex, block] { m_UpdatedBlockTip(pindex, block.get()); });
+}
+
+void CMainSignals::SyncTransaction(const CTransaction &tx, const CBlock *pblock)
+{
+    if (!validationQueue.IsRunning())
+        return m_SyncTransaction(tx, pblock);
+    std::shared_ptr<const CBlock> block = ShareBlock(pblock);
+    validationQueue.Add([this, tx, block] { m_SyncTransaction(tx, block.get()); });
+}
+
+void CMainSignals::NotifyTransactionLock(const CTransaction &tx)
+{
+    validationQueue.Add([this, tx] { m_NotifyTransactionLock(tx); });
+}
+
+void CMainSignals::UpdatedTransaction(const uint256 &hash)
+{
+    m_UpdatedTransaction(hash);
+}
+
+void CMainSignals::SetBestChain(const CBlockLocator &locator)
+{
+    validationQueue.Add([this, locator] { m_SetBestChain(locator); });
+}
+
+void CMainSignals::Inventory(const uint256 &hash)
+{
+    validationQueue.Add([this, hash] { m_Inventory(hash); });
+}
+
+void CMainSignals::Broadcast()
+{
+    m_Broadcast();
+}
+
+void CMainSignals::BlockChecked(const CBlock &block, const CValidationState &state)
+{
+    m_BlockChecked(block, state);
+}
+
+void CMainSignals::BlockFound(const uint256 &hash)
+{
+    m_BlockFound(hash);
+}
+
 void RegisterValidationInterface(CValidationInterface* pwalletIn) {
 // XX42 g_signals.EraseTransaction.connect(boost::bind(&CValidationInterface::EraseFromWallet, pwalletIn, _1));
-    g_signals.UpdatedBlockTip.connect(boost::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, _1));
-    g_signals.SyncTransaction.connect(boost::bind(&CValidationInterface::SyncTransaction, pwalletIn, _1, _2));
-    g_signals.NotifyTransactionLock.connect(boost::bind(&CValidationInterface::NotifyTransactionLock, pwalletIn, _1));
-    g_signals.UpdatedTransaction.connect(boost::bind(&CValidationInterface::UpdatedTransaction, pwalletIn, _1));
-    g_signals.SetBestChain.connect(boost::bind(&CValidationInterface::SetBestChain, pwalletIn, _1));
-    g_signals.Inventory.connect(boost::bind(&CValidationInterface::Inventory, pwalletIn, _1));
-    g_signals.Broadcast.connect(boost::bind(&CValidationInterface::ResendWalletTransactions, pwalletIn));
-    g_signals.BlockChecked.connect(boost::bind(&CValidationInterface::BlockChecked, pwalletIn, _1, _2));
+    g_signals.m_UpdatedBlockTip.connect(boost::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, _1, _2));
+    g_signals.m_SyncTransaction.connect(boost::bind(&CValidationInterface::SyncTransaction, pwalletIn, _1, _2));
+    g_signals.m_NotifyTransactionLock.connect(boost::bind(&CValidationInterface::NotifyTransactionLock, pwalletIn, _1));
+    g_signals.m_UpdatedTransaction.connect(boost::bind(&CValidationInterface::UpdatedTransaction, pwalletIn, _1));
+    g_signals.m_SetBestChain.connect(boost::bind(&CValidationInterface::SetBestChain, pwalletIn, _1));
+    g_signals.m_Inventory.connect(boost::bind(&CValidationInterface::Inventory, pwalletIn, _1));
+    g_signals.m_Broadcast.connect(boost::bind(&CValidationInterface::ResendWalletTransactions, pwalletIn));
+    g_signals.m_BlockChecked.connect(boost::bind(&CValidationInterface::BlockChecked, pwalletIn, _1, _2));
 // XX42    g_signals.ScriptForMining.connect(boost::bind(&CValidationInterface::GetScriptForMining, pwalletIn, _1));
-    g_signals.BlockFound.connect(boost::bind(&CValidationInterface::ResetRequestCount, pwalletIn, _1));
+    g_signals.m_BlockFound.connect(boost::bind(&CValidationInterface::ResetRequestCount, pwalletIn, _1));
 }
 
 void UnregisterValidationInterface(CValidationInterface* pwalletIn) {
-    g_signals.BlockFound.disconnect(boost::bind(&CValidationInterface::ResetRequestCount, pwalletIn, _1));
+    g_signals.m_BlockFound.disconnect(boost::bind(&CValidationInterface::ResetRequestCount, pwalletIn, _1));
 // XX42    g_signals.ScriptForMining.disconnect(boost::bind(&CValidationInterface::GetScriptForMining, pwalletIn, _1));
-    g_signals.BlockChecked.disconnect(boost::bind(&CValidationInterface::BlockChecked, pwalletIn, _1, _2));
-    g_signals.Broadcast.disconnect(boost::bind(&CValidationInterface::ResendWalletTransactions, pwalletIn));
-    g_signals.Inventory.disconnect(boost::bind(&CValidationInterface::Inventory, pwalletIn, _1));
-    g_signals.SetBestChain.disconnect(boost::bind(&CValidationInterface::SetBestChain, pwalletIn, _1));
-    g_signals.UpdatedTransaction.disconnect(boost::bind(&CValidationInterface::UpdatedTransaction, pwalletIn, _1));
-    g_signals.NotifyTransactionLock.disconnect(boost::bind(&CValidationInterface::NotifyTransactionLock, pwalletIn, _1));
-    g_signals.SyncTransaction.disconnect(boost::bind(&CValidationInterface::SyncTransaction, pwalletIn, _1, _2));
-    g_signals.UpdatedBlockTip.disconnect(boost::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, _1));
+    g_signals.m_BlockChecked.disconnect(boost::bind(&CValidationInterface::BlockChecked, pwalletIn, _1, _2));
+    g_signals.m_Broadcast.disconnect(boost::bind(&CValidationInterface::ResendWalletTransactions, pwalletIn));
+    g_signals.m_Inventory.disconnect(boost::bind(&CValidationInterface::Inventory, pwalletIn, _1));
+    g_signals.m_SetBestChain.disconnect(boost::bind(&CValidationInterface::SetBestChain, pwalletIn, _1));
+    g_signals.m_UpdatedTransaction.disconnect(boost::bind(&CValidationInterface::UpdatedTransaction, pwalletIn, _1));
+    g_signals.m_NotifyTransactionLock.disconnect(boost::bind(&CValidationInterface::NotifyTransactionLock, pwalletIn, _1));
+    g_signals.m_SyncTransaction.disconnect(boost::bind(&CValidationInterface::SyncTransaction, pwalletIn, _1, _2));
+    g_signals.m_UpdatedBlockTip.disconnect(boost::bind(&CValidationInterface::UpdatedBlockTip, pwalletIn, _1, _2));
 // XX42    g_signals.EraseTransaction.disconnect(boost::bind(&CValidationInterface::EraseFromWallet, pwalletIn, _1));
 }
 
 void UnregisterAllValidationInterfaces() {
-    g_signals.BlockFound.disconnect_all_slots();
+    g_signals.m_BlockFound.disconnect_all_slots();
 // XX42    g_signals.ScriptForMining.disconnect_all_slots();
-    g_signals.BlockChecked.disconnect_all_slots();
-    g_signals.Broadcast.disconnect_all_slots();
-    g_signals.Inventory.disconnect_all_slots();
-    g_signals.SetBestChain.disconnect_all_slots();
-    g_signals.UpdatedTransaction.disconnect_all_slots();
-    g_signals.NotifyTransactionLock.disconnect_all_slots();
-    g_signals.SyncTransaction.disconnect_all_slots();
-    g_signals.UpdatedBlockTip.disconnect_all_slots();
+    g_signals.m_BlockChecked.disconnect_all_slots();
+    g_signals.m_Broadcast.disconnect_all_slots();
+    g_signals.m_Inventory.disconnect_all_slots();
+    g_signals.m_SetBestChain.disconnect_all_slots();
+    g_signals.m_UpdatedTransaction.disconnect_all_slots();
+    g_signals.m_NotifyTransactionLock.disconnect_all_slots();
+    g_signals.m_SyncTransaction.disconnect_all_slots();
+    g_signals.m_UpdatedBlockTip.disconnect_all_slots();
 // XX42    g_signals.EraseTransaction.disconnect_all_slots();
 }
 
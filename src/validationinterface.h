@@ -30,10 +30,20 @@ void UnregisterAllValidationInterfaces();
 /** Push an updated transaction to all registered wallets */
 void SyncWithWallets(const CTransaction& tx, const CBlock* pblock);
 
+/** Start the thread delivering the queued notifications. Until then they are delivered right away. */
+void StartValidationInterfaceQueue();
+/** Deliver the notifications still queued and stop the thread */
+void StopValidationInterfaceQueue();
+/**
+ * Wait until the notifications queued so far have been delivered to the registered
+ * interfaces. Must not be called with cs_main (or a lock taken by the handlers) held.
+ */
+void SyncWithValidationInterfaceQueue();
+
 class CValidationInterface {
 protected:
 // XX42    virtual void EraseFromWallet(const uint256& hash){};
-    virtual void UpdatedBlockTip(const CBlockIndex *pindex) {}
+    virtual void UpdatedBlockTip(const CBlockIndex *pindex, const CBlock *pblock) {}
     virtual void SyncTransaction(const CTransaction &tx, const CBlock *pblock) {}
     virtual void NotifyTransactionLock(const CTransaction &tx) {}
     virtual void SetBestChain(const CBlockLocator &locator) {}
@@ -49,29 +59,47 @@ protected:
     friend void ::UnregisterAllValidationInterfaces();
 };
 
-struct CMainSignals {
-// XX42    boost::signals2::signal<void(const uint256&)> EraseTransaction;
-    /** Notifies listeners of updated block chain tip */
-    boost::signals2::signal<void (const CBlockIndex *)> UpdatedBlockTip;
+/**
+ * Dispatches validation events to the registered interfaces. UpdatedBlockTip,
+ * SyncTransaction, NotifyTransactionLock, SetBestChain and Inventory are queued and
+ * delivered in order by a single thread, so the handlers don't run in the validation
+ * code path (and under cs_main). The other events are delivered synchronously.
+ */
+class CMainSignals {
+private:
+    boost::signals2::signal<void (const CBlockIndex *, const CBlock *)> m_UpdatedBlockTip;
+    boost::signals2::signal<void (const CTransaction &, const CBlock *)> m_SyncTransaction;
+    boost::signals2::signal<void (const CTransaction &)> m_NotifyTransactionLock;
+    boost::signals2::signal<bool (const uint256 &)> m_UpdatedTransaction;
+    boost::signals2::signal<void (const CBlockLocator &)> m_SetBestChain;
+    boost::signals2::signal<void (const uint256 &)> m_Inventory;
+    boost::signals2::signal<void ()> m_Broadcast;
+    boost::signals2::signal<void (const CBlock&, const CValidationState&)> m_BlockChecked;
+    boost::signals2::signal<void (const uint256 &)> m_BlockFound;
+
+    friend void ::RegisterValidationInterface(CValidationInterface*);
+    friend void ::UnregisterValidationInterface(CValidationInterface*);
+    friend void ::UnregisterAllValidationInterfaces();
+
+public:
+    /** Notifies listeners of updated block chain tip (and the block, if it is loaded in memory) */
+    void UpdatedBlockTip(const CBlockIndex *pindex, const CBlock *pblock);
     /** Notifies listeners of updated transaction data (transaction, and optionally the block it is found in. */
-    boost::signals2::signal<void (const CTransaction &, const CBlock *)> SyncTransaction;
+    void SyncTransaction(const CTransaction &tx, const CBlock *pblock);
     /** Notifies listeners of an updated transaction lock without new data. */
-    boost::signals2::signal<void (const CTransaction &)> NotifyTransactionLock;
+    void NotifyTransactionLock(const CTransaction &tx);
     /** Notifies listeners of an updated transaction without new data (for now: a coinbase potentially becoming visible). */
-    boost::signals2::signal<bool (const uint256 &)> UpdatedTransaction;
+    void UpdatedTransaction(const uint256 &hash);
     /** Notifies listeners of a new active block chain. */
-    boost::signals2::signal<void (const CBlockLocator &)> SetBestChain;
+    void SetBestChain(const CBlockLocator &locator);
     /** Notifies listeners about an inventory item being seen on the network. */
-    boost::signals2::signal<void (const uint256 &)> Inventory;
+    void Inventory(const uint256 &hash);
     /** Tells listeners to broadcast their data. */
-// XX42    boost::signals2::signal<void (int64_t nBestBlockTime)> Broadcast;
-    boost::signals2::signal<void ()> Broadcast;
+    void Broadcast();
     /** Notifies listeners of a block validation result */
-    boost::signals2::signal<void (const CBlock&, const CValidationState&)> BlockChecked;
-    /** Notifies listeners that a key for mining is required (coinbase) */
-// XX42    boost::signals2::signal<void (boost::shared_ptr<CReserveScript>&)> ScriptForMining;
+    void BlockChecked(const CBlock &block, const CValidationState &state);
     /** Notifies listeners that a block has been successfully mined */
-    boost::signals2::signal<void (const uint256 &)> BlockFound;
+    void BlockFound(const uint256 &hash);
 };
 
 CMainSignals& GetMainSignals();
@@ -15,7 +15,25 @@ void zmqError(const char *str)
     LogPrint("zmq", "zmq: Error: %s, errno=%s\n", str, zmq_strerror(errno));
 }
 
-CZMQNotificationInterface::CZMQNotificationInterface() : pcontext(NULL)
+template <typename T>
+static std::shared_ptr<const std::vector<unsigned char> > SerializeNotificationData(const T& obj)
+{
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << obj;
+    return std::make_shared<const std::vector<unsigned char> >(ss.begin(), ss.end());
+}
+
+CZMQNotificationInterface::CZMQNotificationInterface() : pcontext(NULL),
+                                                         fRawBlock(false),
+                                                         fRawTx(false),
+                                                         fRawTxLock(false),
+                                                         nMaxQueueSize(DEFAULT_ZMQ_QUEUE_SIZE),
+                                                         nQueueBytes(0),
+                                                         nMaxQueueBytes((size_t)DEFAULT_ZMQ_QUEUE_MEM << 20),
+                                                         fStopping(false),
+                                                         nPublished(0),
+                                                         nDropped(0),
+                                                         fDropping(false)
 {
 }
 
@@ -60,6 +78,12 @@ CZMQNotificationInterface* CZMQNotificationInterface::CreateWithArguments(const
     {
         notificationInterface = new CZMQNotificationInterface();
         notificationInterface->notifiers = notifiers;
+        std::map<std::string, std::string>::const_iterator it = args.find("-zmqqueuesize");
+        if (it != args.end())
+            notificationInterface->nMaxQueueSize = std::max(1, atoi(it->second));
+        it = args.find("-zmqqueuemem");
+        if (it != args.end())
+            notificationInterface->nMaxQueueBytes = (size_t)std::max(1, atoi(it->second)) << 20;
 
         if (!notificationInterface->Initialize())
         {
@@ -105,6 +129,16 @@ bool CZMQNotificationInterface::Initialize()
         return false;
     }
 
+    for (i=notifiers.begin(); i!=notifiers.end(); ++i)
+    {
+        const std::string& type = (*i)->GetType();
+        fRawBlock |= (type == "pubrawblock");
+        fRawTx |= (type == "pubrawtx");
+        fRawTxLock |= (type == "pubrawtxlock");
+    }
+
+    threadPublish = std::thread(&TraceThread<std::function<void()> >, "zmqpub", std::function<void()>(std::bind(&CZMQNotificationInterface::ThreadPublish, this)));
+
     return true;
 }
 
@@ -112,6 +146,17 @@ bool CZMQNotificationInterface::Initialize()
 void CZMQNotificationInterface::Shutdown()
 {
     LogPrint("zmq", "zmq: Shutdown notification interface\n");
+    if (threadPublish.joinable())
+    {
+        // The notifications still queued are published before the thread exits
+        {
+            std::lock_guard<std::mutex> lock(csQueue);
+            fStopping = true;
+        }
+        condQueue.notify_all();
+        threadPublish.join();
+        LogPrint("zmq", "zmq: %u notifications published, %u dropped\n", nPublished, nDropped);
+    }
     if (pcontext)
     {
         for (std::list<CZMQAbstractNotifier*>::iterator i=notifiers.begin(); i!=notifiers.end(); ++i)
@@ -126,46 +171,88 @@ void CZMQNotificationInterface::Shutdown()
     }
 }
 
-void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindex)
+/** Memory used by a queued notification */
+static size_t NotificationUsage(const CZMQNotification &notification)
 {
-    for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
+    return sizeof(CZMQNotification) + (notification.data ? notification.data->capacity() : 0);
+}
+
+void CZMQNotificationInterface::Enqueue(CZMQNotification &notification)
+{
+    const size_t nBytes = NotificationUsage(notification);
     {
-        CZMQAbstractNotifier *notifier = *i;
-        if (notifier->NotifyBlock(pindex))
+        std::lock_guard<std::mutex> lock(csQueue);
+        // One notification is queued whatever its size, a block may exceed the limit
+        if (queue.size() >= nMaxQueueSize || (!queue.empty() && nQueueBytes + nBytes > nMaxQueueBytes))
         {
-            i++;
+            if (!fDropping)
+                LogPrintf("zmq: Notification queue full (%u notifications, %u bytes), dropping notifications\n", queue.size(), nQueueBytes);
+            fDropping = true;
+            nDropped++;
+            if (notification.type == CZMQNotification::BLOCK)
+                LogPrintf("zmq: Dropped notification of block %s\n", notification.hash.ToString());
+            else
+                LogPrint("zmq", "zmq: Dropped notification of transaction %s\n", notification.hash.ToString());
+            return;
         }
-        else
+        if (fDropping)
         {
-            notifier->Shutdown();
-            i = notifiers.erase(i);
+            LogPrintf("zmq: Notification queue available again, %u notifications dropped so far\n", nDropped);
+            fDropping = false;
         }
+        queue.push_back(std::move(notification));
+        nQueueBytes += nBytes;
     }
+    condQueue.notify_one();
 }
 
-void CZMQNotificationInterface::SyncTransaction(const CTransaction &tx, const CBlock *pblock)
+void CZMQNotificationInterface::ThreadPublish()
 {
-    for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
+    while (true)
     {
-        CZMQAbstractNotifier *notifier = *i;
-        if (notifier->NotifyTransaction(tx))
+        CZMQNotification notification;
         {
-            i++;
-        }
-        else
-        {
-            notifier->Shutdown();
-            i = notifiers.erase(i);
+            std::unique_lock<std::mutex> lock(csQueue);
+            while (queue.empty() && !fStopping)
+                condQueue.wait(lock);
+            if (queue.empty())
+                return;
+            notification = std::move(queue.front());
+            queue.pop_front();
+            nQueueBytes -= NotificationUsage(notification);
         }
+        Publish(notification);
     }
 }
 
-void CZMQNotificationInterface::NotifyTransactionLock(const CTransaction &tx)
+void CZMQNotificationInterface::Publish(CZMQNotification &notification)
 {
+    if (notification.type == CZMQNotification::BLOCK && fRawBlock && !notification.data)
+    {
+        // The block wasn't in memory when the tip was updated
+        LOCK(cs_main);
+        CBlock block;
+        if (ReadBlockFromDisk(block, notification.pindex))
+            notification.data = SerializeNotificationData(block);
+    }
+
     for (std::list<CZMQAbstractNotifier*>::iterator i = notifiers.begin(); i!=notifiers.end(); )
     {
         CZMQAbstractNotifier *notifier = *i;
-        if (notifier->NotifyTransactionLock(tx))
+        bool fSent = true;
+        switch (notification.type)
+        {
+        case CZMQNotification::BLOCK:
+            fSent = notifier->NotifyBlock(notification);
+            break;
+        case CZMQNotification::TRANSACTION:
+            fSent = notifier->NotifyTransaction(notification);
+            break;
+        case CZMQNotification::TRANSACTION_LOCK:
+            fSent = notifier->NotifyTransactionLock(notification);
+            break;
+        }
+        if (fSent)
         {
             i++;
         }
@@ -175,4 +262,38 @@ void CZMQNotificationInterface::NotifyTransactionLock(const CTransaction &tx)
             i = notifiers.erase(i);
         }
     }
+    nPublished++;
+}
+
+void CZMQNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindex, const CBlock *pblock)
+{
+    CZMQNotification notification;
+    notification.type = CZMQNotification::BLOCK;
+    notification.hash = pindex->GetBlockHash();
+    notification.pindex = pindex;
+    if (fRawBlock && pblock)
+        notification.data = SerializeNotificationData(*pblock);
+    Enqueue(notification);
+}
+
+void CZMQNotificationInterface::SyncTransaction(const CTransaction &tx, const CBlock *pblock)
+{
+    CZMQNotification notification;
+    notification.type = CZMQNotification::TRANSACTION;
+    notification.hash = tx.GetHash();
+    notification.pindex = NULL;
+    if (fRawTx)
+        notification.data = SerializeNotificationData(tx);
+    Enqueue(notification);
+}
+
+void CZMQNotificationInterface::NotifyTransactionLock(const CTransaction &tx)
+{
+    CZMQNotification notification;
+    notification.type = CZMQNotification::TRANSACTION_LOCK;
+    notification.hash = tx.GetHash();
+    notification.pindex = NULL;
+    if (fRawTxLock)
+        notification.data = SerializeNotificationData(tx);
+    Enqueue(notification);
 }
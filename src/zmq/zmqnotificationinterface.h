@@ -5,13 +5,55 @@
 #ifndef BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 #define BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
 
+#include "uint256.h"
 #include "validationinterface.h"
-#include <string>
+
+#include <condition_variable>
+#include <deque>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 class CBlockIndex;
 class CZMQAbstractNotifier;
 
+/** A notification waiting for the publisher thread, with its payload serialized beforehand */
+struct CZMQNotification
+{
+    enum Type {
+        BLOCK,
+        TRANSACTION,
+        TRANSACTION_LOCK
+    };
+
+    Type type;
+    uint256 hash;
+    //! The new tip, for block notifications
+    const CBlockIndex* pindex;
+    //! The serialized block or transaction, NULL if no raw notifier needs it
+    std::shared_ptr<const std::vector<unsigned char> > data;
+};
+
+/**
+ * Default for -zmqqueuesize, the number of notifications waiting to be published. A full
+ * block holds up to MAX_BLOCK_SIZE_CURRENT / 60 (about 33000) transactions, each notified
+ * while the block is connected, so the queue must hold well more than that.
+ */
+static const unsigned int DEFAULT_ZMQ_QUEUE_SIZE = 100000;
+/** Default for -zmqqueuemem, the memory used by the waiting notifications in MiB */
+static const unsigned int DEFAULT_ZMQ_QUEUE_MEM = 64;
+
+/**
+ * Publishes validation events to the ZMQ notifiers. The callbacks only serialize
+ * the payload once and queue it; a dedicated thread sends the messages, so slow
+ * sockets don't delay validation. When more than -zmqqueuesize notifications, or
+ * more than -zmqqueuemem MiB of payloads, are waiting, new ones are dropped and
+ * counted.
+ */
 class CZMQNotificationInterface : public CValidationInterface
 {
 public:
@@ -25,14 +67,37 @@ protected:
 
     // CValidationInterface
     void SyncTransaction(const CTransaction &tx, const CBlock *pblock);
-    void UpdatedBlockTip(const CBlockIndex *pindex);
+    void UpdatedBlockTip(const CBlockIndex *pindex, const CBlock *pblock);
     void NotifyTransactionLock(const CTransaction &tx);
 
 private:
     CZMQNotificationInterface();
 
+    void Enqueue(CZMQNotification &notification);
+    void ThreadPublish();
+    void Publish(CZMQNotification &notification);
+
     void *pcontext;
+    //! Only used by the publisher thread once it is started
     std::list<CZMQAbstractNotifier*> notifiers;
+    //! Whether serialized blocks/transactions/locked transactions are published
+    bool fRawBlock;
+    bool fRawTx;
+    bool fRawTxLock;
+
+    std::mutex csQueue;
+    std::condition_variable condQueue;
+    std::deque<CZMQNotification> queue;
+    size_t nMaxQueueSize;
+    //! Memory used by the queued notifications, and its limit
+    size_t nQueueBytes;
+    size_t nMaxQueueBytes;
+    bool fStopping;
+    uint64_t nPublished;
+    uint64_t nDropped;
+    //! Whether notifications are being dropped since the queue last filled up
+    bool fDropping;
+    std::thread threadPublish;
 };
 
 #endif // BITCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
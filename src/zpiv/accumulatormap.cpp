@@ -8,6 +8,10 @@
 #include "txdb.h"
 #include "libzerocoin/Denominations.h"
 
+#include <atomic>
+
+#include <boost/thread.hpp>
+
 
 //Construct accumulators for all denominations
 AccumulatorMap::AccumulatorMap(libzerocoin::ZerocoinParams* params)
@@ -71,6 +75,39 @@ bool AccumulatorMap::Accumulate(const libzerocoin::PublicCoin& pubCoin, bool fSk
     return true;
 }
 
+//Add a list of zerocoins to the accumulators of their denominations, without validating them.
+//Each accumulator is raised once to the product of its new coins, the denominations in parallel.
+bool AccumulatorMap::AccumulateBatch(const std::list<libzerocoin::PublicCoin>& listPubCoins)
+{
+    std::map<libzerocoin::CoinDenomination, std::vector<CBigNum> > mapValues;
+    for (const libzerocoin::PublicCoin& pubCoin : listPubCoins) {
+        libzerocoin::CoinDenomination denom = pubCoin.getDenomination();
+        if (denom == libzerocoin::CoinDenomination::ZQ_ERROR)
+            return false;
+        mapValues[denom].emplace_back(pubCoin.getValue());
+    }
+
+    std::atomic<bool> fSuccess(true);
+    auto increment = [&](libzerocoin::CoinDenomination denom) {
+        try {
+            mapAccumulators.at(denom)->increment(mapValues.at(denom));
+        } catch (const std::exception& e) {
+            LogPrintf("%s : %s\n", __func__, e.what());
+            fSuccess = false;
+        }
+    };
+
+    if (mapValues.size() == 1) {
+        increment(mapValues.begin()->first);
+    } else {
+        boost::thread_group threads;
+        for (const auto& it : mapValues)
+            threads.create_thread(boost::bind<void>(increment, it.first));
+        threads.join_all();
+    }
+    return fSuccess;
+}
+
 libzerocoin::Accumulator AccumulatorMap::GetAccumulator(libzerocoin::CoinDenomination denom)
 {
     return libzerocoin::Accumulator(params, denom, GetValue(denom));
@@ -245,7 +245,7 @@ bool InitializeAccumulators(const int nHeight, int& nHeightCheckpoint, Accumulat
 
 
 //Get checkpoint value for a specific block height
-bool CalculateAccumulatorCheckpoint(int nHeight, uint256& nCheckpoint, AccumulatorMap& mapAccumulators)
+bool CalculateAccumulatorCheckpoint(int nHeight, uint256& nCheckpoint, AccumulatorMap& mapAccumulators, const PubcoinBlockCache* pPubcoinCache)
 {
     if (nHeight < Params().Zerocoin_Block_V2_Start()) {
         nCheckpoint = 0;
@@ -274,6 +274,7 @@ bool CalculateAccumulatorCheckpoint(int nHeight, uint256& nCheckpoint, Accumulat
 
     //Accumulate all coins over the last ten blocks that havent been accumulated (height - 20 through height - 11)
     int nTotalMintsFound = 0;
+    std::list<libzerocoin::PublicCoin> listPubcoinsRange;
     CBlockIndex *pindex = chainActive[nHeightCheckpoint - 20];
 
     while (pindex && pindex->nHeight < nHeight - 10) {
@@ -287,26 +288,31 @@ bool CalculateAccumulatorCheckpoint(int nHeight, uint256& nCheckpoint, Accumulat
             continue;
         }
 
-        //grab mints from this block
-        CBlock block;
-        if(!ReadBlockFromDisk(block, pindex))
-            return error("%s: failed to read block from disk", __func__);
-
+        //grab mints from this block, unless they were already read
         std::list<libzerocoin::PublicCoin> listPubcoins;
-        if (!BlockToPubcoinList(block, listPubcoins, fFilterInvalid))
-            return error("%s: failed to get zerocoin mintlist from block %d", __func__, pindex->nHeight);
+        PubcoinBlockCache::const_iterator it;
+        if (pPubcoinCache && (it = pPubcoinCache->find(std::make_pair(pindex->nHeight, fFilterInvalid))) != pPubcoinCache->end()) {
+            listPubcoins = it->second;
+        } else {
+            CBlock block;
+            if(!ReadBlockFromDisk(block, pindex))
+                return error("%s: failed to read block from disk", __func__);
+
+            if (!BlockToPubcoinList(block, listPubcoins, fFilterInvalid))
+                return error("%s: failed to get zerocoin mintlist from block %d", __func__, pindex->nHeight);
+        }
 
         nTotalMintsFound += listPubcoins.size();
         LogPrint("zero", "%s found %d mints\n", __func__, listPubcoins.size());
 
-        //add the pubcoins to accumulator
-        for (const libzerocoin::PublicCoin& pubcoin : listPubcoins) {
-            if(!mapAccumulators.Accumulate(pubcoin, true))
-                return error("%s: failed to add pubcoin to accumulator at height %d", __func__, pindex->nHeight);
-        }
+        listPubcoinsRange.splice(listPubcoinsRange.end(), listPubcoins);
         pindex = chainActive.Next(pindex);
     }
 
+    //add the pubcoins to the accumulators, one exponentiation per denomination
+    if (!mapAccumulators.AccumulateBatch(listPubcoinsRange))
+        return error("%s: failed to add pubcoins to accumulator for checkpoint at height %d", __func__, nHeight);
+
     // if there were no new mints found, the accumulator checkpoint will be the same as the last checkpoint
     if (nTotalMintsFound == 0)
         nCheckpoint = chainActive[nHeight - 1]->nAccumulatorCheckpoint;
@@ -389,6 +395,7 @@ int AddBlockMintsToAccumulator(const libzerocoin::CoinDenomination den, const CB
 {
     // if this block contains mints of the denomination that is being spent, then add them to the witness
     int nMintsAdded = 0;
+    std::vector<CBigNum> vValues;
     if (pindex->MintedDenomination(den)) {
         //add the mints to the witness
         for (const libzerocoin::PublicCoin& pubcoin : GetPubcoinFromBlock(pindex)) {
@@ -401,9 +408,10 @@ int AddBlockMintsToAccumulator(const libzerocoin::CoinDenomination den, const CB
                 continue;
             }
 
-            accumulator->increment(pubcoin.getValue());
+            vValues.emplace_back(pubcoin.getValue());
             ++nMintsAdded;
         }
+        accumulator->increment(vValues);
     }
 
     return nMintsAdded;
@@ -414,6 +422,7 @@ int AddBlockMintsToAccumulator(const libzerocoin::PublicCoin& coin, const int nH
 {
     // if this block contains mints of the denomination that is being spent, then add them to the witness
     int nMintsAdded = 0;
+    std::vector<CBigNum> vValues;
     if (pindex->MintedDenomination(coin.getDenomination())) {
         //add the mints to the witness
         for (const libzerocoin::PublicCoin& pubcoin : GetPubcoinFromBlock(pindex)) {
@@ -423,9 +432,10 @@ int AddBlockMintsToAccumulator(const libzerocoin::PublicCoin& coin, const int nH
             if (isWitness && pindex->nHeight == nHeightMintAdded && pubcoin.getValue() == coin.getValue())
                 continue;
 
-            accumulator->increment(pubcoin.getValue());
+            vValues.emplace_back(pubcoin.getValue());
             ++nMintsAdded;
         }
+        accumulator->increment(vValues);
     }
 
     return nMintsAdded;
@@ -265,6 +265,53 @@ class RESTTest (BitcoinTestFramework):
         json_obj = json.loads(response_header_json_str)
         assert_equal(len(json_obj), 5) #now we should have 5 header objects
 
+        # the same headers by height
+        bb_height = rpc_block_json['height']
+        response_header_json = http_get_call(url.hostname, url.port, '/rest/headerrange/%d/5' % bb_height + self.FORMAT_SEPARATOR + "json", True)
+        assert_equal(response_header_json.status, 200)
+        assert_equal(json.loads(response_header_json.read().decode('utf-8')), json_obj)
+
+        #####################
+        # /rest/blockrange/ #
+        #####################
+
+        # a range of blocks is the concatenation of the blocks
+        response_range = http_get_call(url.hostname, url.port, '/rest/blockrange/%d/2' % bb_height + self.FORMAT_SEPARATOR + "bin", True)
+        assert_equal(response_range.status, 200)
+        next_hash = self.nodes[0].getblockhash(bb_height + 1)
+        next_block_str = http_get_call(url.hostname, url.port, '/rest/block/'+next_hash+self.FORMAT_SEPARATOR+"bin", True).read()
+        assert_equal(response_range.read(), response_str + next_block_str)
+
+        response_range_hex = http_get_call(url.hostname, url.port, '/rest/blockrange/%d/1' % bb_height + self.FORMAT_SEPARATOR + "hex", True)
+        assert_equal(response_range_hex.status, 200)
+        assert_equal(response_range_hex.read(), response_hex_str)
+
+        # filtered views hold the block header and the matching transactions
+        response_range = http_get_call(url.hostname, url.port, '/rest/blockrange/%d/1/zerocoin' % bb_height + self.FORMAT_SEPARATOR + "bin", True)
+        assert_equal(response_range.status, 200)
+        assert_equal(response_range.read(), response_header_str + b'\x00')
+
+        coinbase = block_json_obj['tx'][0]
+        coinbase_str = http_get_call(url.hostname, url.port, '/rest/tx/'+coinbase['txid']+self.FORMAT_SEPARATOR+"bin", True).read()
+        script_filter = coinbase['vout'][0]['scriptPubKey']['hex'] + ',51'
+        response_range = http_get_call(url.hostname, url.port, '/rest/blockrange/%d/1/%s' % (bb_height, script_filter) + self.FORMAT_SEPARATOR + "bin", True)
+        assert_equal(response_range.status, 200)
+        range_str = response_range.read()
+        assert_equal(range_str[0:80], response_header_str)
+        assert_greater_than(range_str[80], 0)
+        assert_equal(range_str[81:81+len(coinbase_str)], coinbase_str)
+
+        # ranges must start in the active chain and are cut short at the tip
+        tip_height = self.nodes[0].getblockcount()
+        response_range = http_get_call(url.hostname, url.port, '/rest/blockrange/%d/1' % (tip_height + 1) + self.FORMAT_SEPARATOR + "bin", True)
+        assert_equal(response_range.status, 404)
+        response_range = http_get_call(url.hostname, url.port, '/rest/headerrange/%d/10' % (tip_height - 1) + self.FORMAT_SEPARATOR + "json", True)
+        assert_equal(len(json.loads(response_range.read().decode('utf-8'))), 2)
+        response_range = http_get_call(url.hostname, url.port, '/rest/blockrange/0/1001' + self.FORMAT_SEPARATOR + "bin", True)
+        assert_equal(response_range.status, 400)
+        response_range = http_get_call(url.hostname, url.port, '/rest/blockrange/0/1/zz' + self.FORMAT_SEPARATOR + "bin", True)
+        assert_equal(response_range.status, 400)
+
         # do tx test
         tx_hash = block_json_obj['tx'][0]['txid']
         json_string = http_get_call(url.hostname, url.port, '/rest/tx/'+tx_hash+self.FORMAT_SEPARATOR+"json")
@@ -102,7 +102,7 @@ BASE_SCRIPTS= [
     #'rpc_getchaintips.py',
     'mempool_spend_coinbase.py',
     'mempool_reorg.py',
-    #'mempool_persist.py', # Not yet implemented
+    'mempool_persist.py',
     'interface_http.py',
     #'rpc_users.py',
     'rpc_signrawtransaction.py',